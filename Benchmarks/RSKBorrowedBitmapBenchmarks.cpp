@@ -0,0 +1,92 @@
+//
+// RSKBorrowedBitmapBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKBorrowedBitmap.h"
+
+namespace {
+
+// A 12 MP photo.
+constexpr size_t kImageWidth = 4032;
+constexpr size_t kImageHeight = 3024;
+
+// A square crop of `side` pixels without rotation, centered in the photo.
+RSKCropSpec MakeSquareSpec(size_t side)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.imageRect = CGRectMake((kImageWidth - side) / 2, (kImageHeight - side) / 2, side, side);
+    spec.cropRect = CGRectMake(0, 0, side, side);
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    return spec;
+}
+
+// Crops a square of `state.range(0)` pixels out of the 12 MP photo into new pixels, like every crop used to.
+void BM_CropSquareByCopying(benchmark::State &state)
+{
+    const size_t side = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> pixels(kImageWidth * kImageHeight * 4, 0xFF);
+    RSKBitmap source = RSKBitmapMake(pixels.data(), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888);
+    const RSKCropSpec spec = MakeSquareSpec(side);
+
+    for (auto _ : state) {
+        std::vector<uint8_t> resultPixels(side * side * 4);
+        RSKBitmap destination = RSKBitmapMake(resultPixels.data(), side, side, side * 4, RSKPixelFormatRGBA8888);
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        benchmark::DoNotOptimize(resultPixels.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Crops the same square as a view of the pixels of the photo.
+void BM_CropSquareAsSubview(benchmark::State &state)
+{
+    const size_t side = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> pixels(kImageWidth * kImageHeight * 4, 0xFF);
+    RSKBorrowedBitmap source = RSKBorrowedBitmapMake(RSKBitmapMake(pixels.data(), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888), nullptr);
+    const RSKCropSpec spec = MakeSquareSpec(side);
+
+    for (auto _ : state) {
+        RSKBorrowedBitmap result = {};
+        if (RSKCropEngineCropBorrowedBitmap(&source, &spec, nullptr, &result) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        benchmark::DoNotOptimize(result.bitmap.data);
+        RSKBorrowedBitmapRelease(&result);
+    }
+}
+
+BENCHMARK(BM_CropSquareByCopying)->ArgName("side")->Arg(256)->Arg(1024)->Arg(3024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CropSquareAsSubview)->ArgName("side")->Arg(256)->Arg(1024)->Arg(3024)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,174 @@
+//
+// RSKBufferPoolBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKBufferPool.h"
+
+namespace {
+
+// The number of times that `operator new` was called. The operators below replace the global ones of the whole
+// benchmark executable, which costs every allocation one relaxed increment.
+std::atomic<size_t> gAllocationCount { 0 };
+
+// A photo of a phone camera that was scaled down for display.
+constexpr size_t kImageWidth = 1600;
+constexpr size_t kImageHeight = 1200;
+
+// A round avatar with the size of the ones of a profile screen.
+constexpr size_t kAvatarSize = 512;
+
+// The number of consecutive crops, like the ones of a batch of uploads or of an editor that crops on every gesture.
+constexpr size_t kCropCount = 10000;
+
+// The high-water mark of the shared pool that `RSKBufferPoolGetShared` starts with.
+constexpr size_t kSharedHighWaterMark = 32 * 1024 * 1024;
+
+// The control points of the cubic Bézier curves that approximate a quarter of a circle.
+constexpr double kCircleControlPointDistance = 0.5522847498;
+
+std::vector<RSKPathElement> MakeCirclePath(CGFloat size)
+{
+    const double radius = size / 2;
+    const double control = radius * kCircleControlPointDistance;
+
+    return {
+        { RSKPathElementTypeMoveToPoint, { { radius + radius, radius } } },
+        { RSKPathElementTypeAddCurveToPoint, { { radius + radius, radius + control }, { radius + control, radius + radius }, { radius, radius + radius } } },
+        { RSKPathElementTypeAddCurveToPoint, { { radius - control, radius + radius }, { 0, radius + control }, { 0, radius } } },
+        { RSKPathElementTypeAddCurveToPoint, { { 0, radius - control }, { radius - control, 0 }, { radius, 0 } } },
+        { RSKPathElementTypeAddCurveToPoint, { { radius + control, 0 }, { radius + radius, radius - control }, { radius + radius, radius } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// Crops `kCropCount` rotated round avatars out of a photo one after another, every one into a bitmap of the shared
+// pool that is released right away, and reports the allocations of every crop. With `usesPool` unset the shared pool
+// keeps no idle buffers, so every buffer is allocated and freed like before there was a pool.
+void BM_CropConsecutively(benchmark::State &state, bool usesPool)
+{
+    std::vector<uint8_t> sourcePixels(kImageWidth * kImageHeight * 4, 0xFF);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888);
+    std::vector<RSKPathElement> maskPath = MakeCirclePath(kAvatarSize);
+
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCircle;
+    spec.cropRect = CGRectMake(0, 0, kAvatarSize, kAvatarSize);
+    spec.imageRect = CGRectMake(0, 0, kImageWidth, kImageHeight);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 0.6;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    RSKBufferPool *pool = RSKBufferPoolGetShared();
+    RSKBufferPoolTrim(pool, 0);
+    RSKBufferPoolSetHighWaterMark(pool, usesPool ? kSharedHighWaterMark : 0);
+    const RSKBufferPoolStats initialStats = RSKBufferPoolGetStats(pool);
+    const size_t initialAllocationCount = gAllocationCount.load(std::memory_order_relaxed);
+
+    for (auto _ : state) {
+        RSKBorrowedBitmap avatar;
+        if (RSKBufferPoolMakeBitmap(pool, kAvatarSize, kAvatarSize, RSKPixelFormatRGBA8888, &avatar) != RSKCropStatusSuccess ||
+            RSKCropEngineCropBitmap(&source, &spec, &avatar.bitmap) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        benchmark::DoNotOptimize(avatar.bitmap.data);
+        benchmark::ClobberMemory();
+        RSKBorrowedBitmapRelease(&avatar);
+    }
+
+    // The buffers that the pool allocates itself are counted as its misses.
+    const RSKBufferPoolStats stats = RSKBufferPoolGetStats(pool);
+    const double cropCount = static_cast<double>(state.iterations());
+    const size_t newCount = gAllocationCount.load(std::memory_order_relaxed) - initialAllocationCount;
+    const size_t missCount = stats.missCount - initialStats.missCount;
+    state.counters["allocs/crop"] = (newCount + missCount) / cropCount;
+    state.counters["pool misses/crop"] = missCount / cropCount;
+    state.counters["pool hits/crop"] = (stats.hitCount - initialStats.hitCount) / cropCount;
+    state.counters["resident MB"] = stats.residentBytes / (1024.0 * 1024.0);
+
+    RSKBufferPoolSetHighWaterMark(pool, kSharedHighWaterMark);
+    RSKBufferPoolTrim(pool, 0);
+}
+
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try {
+        return operator new(size);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+BENCHMARK_CAPTURE(BM_CropConsecutively, pooled, true)->Iterations(kCropCount)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CropConsecutively, unpooled, false)->Iterations(kCropCount)->Unit(benchmark::kMicrosecond);
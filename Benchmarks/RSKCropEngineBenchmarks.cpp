@@ -0,0 +1,593 @@
+//
+// RSKCropEngineBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKAnimatedCrop.h"
+#include "RSKBatchCrop.h"
+#include "RSKCropEngine.h"
+#include "RSKMaskCache.h"
+
+namespace {
+
+constexpr size_t kImageSize = 2048;
+
+// A 24 MP source, like the photos of a recent phone camera.
+constexpr size_t kLargeImageWidth = 6000;
+constexpr size_t kLargeImageHeight = 4000;
+
+// A batch of renditions of a photo.
+constexpr size_t kBatchImageCount = 16;
+constexpr size_t kBatchImageWidth = 1600;
+constexpr size_t kBatchImageHeight = 1200;
+
+// An animated avatar of a few seconds.
+constexpr size_t kAnimationFrameCount = 500;
+constexpr size_t kAnimationFrameSize = 320;
+
+// The control points of the cubic Bézier curves that approximate a quarter of a circle.
+constexpr double kCircleControlPointDistance = 0.5522847498;
+
+std::vector<RSKPathElement> MakeOvalPath(CGRect rect)
+{
+    const double midX = CGRectGetMidX(rect);
+    const double midY = CGRectGetMidY(rect);
+    const double radiusX = rect.size.width / 2;
+    const double radiusY = rect.size.height / 2;
+    const double controlX = radiusX * kCircleControlPointDistance;
+    const double controlY = radiusY * kCircleControlPointDistance;
+
+    return {
+        { RSKPathElementTypeMoveToPoint, { { midX + radiusX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + radiusX, midY + controlY }, { midX + controlX, midY + radiusY }, { midX, midY + radiusY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - controlX, midY + radiusY }, { midX - radiusX, midY + controlY }, { midX - radiusX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - radiusX, midY - controlY }, { midX - controlX, midY - radiusY }, { midX, midY - radiusY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + controlX, midY - radiusY }, { midX + radiusX, midY - controlY }, { midX + radiusX, midY } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+std::vector<RSKPathElement> MakeTrianglePath(CGRect rect)
+{
+    return {
+        { RSKPathElementTypeMoveToPoint, { { CGRectGetMidX(rect), CGRectGetMinY(rect) } } },
+        { RSKPathElementTypeAddLineToPoint, { { CGRectGetMaxX(rect), CGRectGetMaxY(rect) } } },
+        { RSKPathElementTypeAddLineToPoint, { { CGRectGetMinX(rect), CGRectGetMaxY(rect) } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// Returns the pixels of an opaque source of `width` x `height` pixels.
+std::vector<uint8_t> MakeSourcePixels(size_t width, size_t height)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i + 0] = static_cast<uint8_t>(i * 7 % 251);
+        pixels[i + 1] = static_cast<uint8_t>(i * 3 % 241);
+        pixels[i + 2] = static_cast<uint8_t>(i % 239);
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+// Crops a 4 MP source with its mask applied, like `applyMaskToCroppedImage`, and reports megapixels per second. With
+// `cached` the mask is rasterized once and then taken from the mask cache, like when the same geometry is cropped again;
+// without it the cache is cleared before every crop.
+void BM_CropWithMask(benchmark::State &state, RSKCropMode cropMode)
+{
+    const bool cached = state.range(0) != 0;
+
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kImageSize, kImageSize);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kImageSize, kImageSize, kImageSize * 4, RSKPixelFormatRGBA8888);
+
+    const CGRect maskRect = CGRectMake(0, 0, kImageSize, kImageSize);
+    std::vector<RSKPathElement> maskPath = cropMode == RSKCropModeCircle ? MakeOvalPath(maskRect) : MakeTrianglePath(maskRect);
+
+    RSKCropSpec spec = {};
+    spec.cropMode = cropMode;
+    spec.cropRect = CGRectMake(0, 0, kImageSize, kImageSize);
+    spec.imageRect = CGRectMake(0, 0, kImageSize, kImageSize);
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    std::vector<uint8_t> destinationPixels(kImageSize * kImageSize * 4);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), kImageSize, kImageSize, kImageSize * 4, RSKPixelFormatRGBA8888);
+
+    RSKMaskCacheClear();
+    for (auto _ : state) {
+        if (!cached) {
+            RSKMaskCacheClear();
+        }
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            return;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double pixels = static_cast<double>(kImageSize * kImageSize);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_CAPTURE(BM_CropWithMask, Circle, RSKCropModeCircle)->ArgName("cached")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_CropWithMask, Custom, RSKCropModeCustom)->ArgName("cached")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Rotates a 4 MP source of `pixelFormat` and masks it with a circle, like a wide-gamut or a deep photo of a phone, and
+// reports megapixels per second. Only the 8-bit components have SIMD kernels.
+void BM_CropPixelFormat(benchmark::State &state, RSKPixelFormat pixelFormat)
+{
+    std::vector<uint8_t> pixels = MakeSourcePixels(kImageSize, kImageSize);
+    RSKBitmap eightBitSource = RSKBitmapMake(pixels.data(), kImageSize, kImageSize, kImageSize * 4, RSKPixelFormatRGBA8888);
+
+    const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(pixelFormat);
+    std::vector<uint64_t> sourcePixels(kImageSize * kImageSize * bytesPerPixel / sizeof(uint64_t));
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kImageSize, kImageSize, kImageSize * bytesPerPixel, pixelFormat);
+    if (RSKCropEngineConvertBitmap(&eightBitSource, &source) != RSKCropStatusSuccess) {
+        state.SkipWithError("The conversion failed.");
+        return;
+    }
+
+    std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0, 0, kImageSize, kImageSize));
+
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCircle;
+    spec.cropRect = CGRectMake(0, 0, kImageSize, kImageSize);
+    spec.imageRect = CGRectMake(0, 0, kImageSize, kImageSize);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    std::vector<uint64_t> destinationPixels(sourcePixels.size());
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), kImageSize, kImageSize, kImageSize * bytesPerPixel, pixelFormat);
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            return;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double pixelCount = static_cast<double>(kImageSize * kImageSize);
+    state.counters["MP/s"] = benchmark::Counter(pixelCount / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_CAPTURE(BM_CropPixelFormat, RGBA8888, RSKPixelFormatRGBA8888)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_CropPixelFormat, RGBA16, RSKPixelFormatRGBA16)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_CropPixelFormat, RGBAHalf, RSKPixelFormatRGBAHalf)->Unit(benchmark::kMillisecond);
+
+// Crops a rotated 24 MP source with a circle mask on a pool of `state.range(0)` threads. The speedup is the time of the
+// same crop without an executor divided by the time on the pool, so it shows how the crop scales.
+void BM_CropConcurrently(benchmark::State &state)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(static_cast<size_t>(state.range(0)));
+    if (!pool) {
+        state.SkipWithError("The thread pool cannot be created.");
+        return;
+    }
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kLargeImageWidth, kLargeImageHeight);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kLargeImageWidth, kLargeImageHeight, kLargeImageWidth * 4, RSKPixelFormatRGBA8888);
+
+    std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0, 0, kLargeImageHeight, kLargeImageHeight));
+
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCircle;
+    spec.cropRect = CGRectMake(0, 0, kLargeImageHeight, kLargeImageHeight);
+    spec.imageRect = CGRectMake(0, 0, kLargeImageWidth, kLargeImageHeight);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    std::vector<uint8_t> destinationPixels(kLargeImageHeight * kLargeImageHeight * 4);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), kLargeImageHeight, kLargeImageHeight, kLargeImageHeight * 4, RSKPixelFormatRGBA8888);
+
+    double sequentialSeconds = 0;
+    for (int i = 0; i < 3; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        RSKCropEngineCropBitmap(&source, &spec, &destination);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        sequentialSeconds = i == 0 ? seconds : std::min(sequentialSeconds, seconds);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmapWithExecutor(&source, &spec, &executor, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    RSKThreadPoolDestroy(pool);
+
+    const double pixels = static_cast<double>(kLargeImageHeight * kLargeImageHeight);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["speedup"] = sequentialSeconds * state.iterations() / seconds;
+}
+
+BENCHMARK(BM_CropConcurrently)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Crops a square out of a 24 MP photo with the EXIF orientation `orientation`, like the ones of a phone held upright.
+// With `state.range(0)` set the square is rotated and masked with a circle, otherwise it is only made upright.
+// Comparing `Up` with `LeftMirrored` shows what an orientation that swaps the axes costs.
+void BM_CropOrientedPhoto(benchmark::State &state, RSKImageOrientation orientation)
+{
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kLargeImageWidth, kLargeImageHeight);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kLargeImageWidth, kLargeImageHeight, kLargeImageWidth * 4, RSKPixelFormatRGBA8888);
+
+    std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0, 0, kLargeImageHeight, kLargeImageHeight));
+
+    const bool isRotated = state.range(0) != 0;
+    RSKCropSpec spec = {};
+    spec.cropMode = isRotated ? RSKCropModeCircle : RSKCropModeSquare;
+    spec.cropRect = CGRectMake(0, 0, kLargeImageHeight, kLargeImageHeight);
+    spec.imageRect = CGRectMake((kLargeImageWidth - kLargeImageHeight) / 2, 0, kLargeImageHeight, kLargeImageHeight);
+    spec.rotationAngle = isRotated ? 0.3 : 0.0;
+    spec.zoomScale = 1;
+    spec.imageOrientation = orientation;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = isRotated;
+
+    std::vector<uint8_t> destinationPixels(kLargeImageHeight * kLargeImageHeight * 4);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), kLargeImageHeight, kLargeImageHeight, kLargeImageHeight * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double pixels = static_cast<double>(kLargeImageHeight * kLargeImageHeight);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_CAPTURE(BM_CropOrientedPhoto, Up, RSKImageOrientationUp)->ArgName("rotated")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_CropOrientedPhoto, LeftMirrored, RSKImageOrientationLeftMirrored)->ArgName("rotated")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Stands in for a codec: decoding copies the source into a new bitmap and encoding sums the cropped pixels, so both
+// stages touch every pixel like a real codec does.
+struct SyntheticCodec {
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kBatchImageWidth, kBatchImageHeight);
+    uint64_t checksum = 0;
+
+    bool Decode(RSKBatchImage *image)
+    {
+        uint8_t *pixels = new uint8_t[sourcePixels.size()];
+        std::memcpy(pixels, sourcePixels.data(), sourcePixels.size());
+        image->bitmap = RSKBitmapMake(pixels, kBatchImageWidth, kBatchImageHeight, kBatchImageWidth * 4, RSKPixelFormatRGBA8888);
+        image->release = [](void *, const RSKBitmap *bitmap) { delete[] static_cast<uint8_t *>(bitmap->data); };
+        return true;
+    }
+
+    bool Encode(const RSKBitmap *bitmap)
+    {
+        const uint8_t *pixels = static_cast<const uint8_t *>(bitmap->data);
+        checksum += std::accumulate(pixels, pixels + bitmap->bytesPerRow * bitmap->height, uint64_t(0));
+        return true;
+    }
+};
+
+RSKCropSpec MakeBatchCropSpec()
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.cropRect = CGRectMake(0, 0, kBatchImageHeight, kBatchImageHeight);
+    spec.imageRect = CGRectMake(0, 0, kBatchImageWidth, kBatchImageHeight);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    return spec;
+}
+
+// Decodes, crops and encodes every image before the next one, which is the baseline for BM_CropBatch.
+void BM_CropBatchSequentially(benchmark::State &state)
+{
+    SyntheticCodec codec;
+    RSKCropSpec spec = MakeBatchCropSpec();
+    CGSize size = RSKCropEngineGetOutputSize(kBatchImageWidth, kBatchImageHeight, &spec);
+    const size_t width = static_cast<size_t>(size.width);
+    const size_t height = static_cast<size_t>(size.height);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatchImageCount; i++) {
+            RSKBatchImage image = {};
+            codec.Decode(&image);
+            std::vector<uint8_t> destinationPixels(width * height * 4);
+            RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+            RSKCropStatus status = RSKCropEngineCropBitmap(&image.bitmap, &spec, &destination);
+            image.release(image.releaseContext, &image.bitmap);
+            if (status != RSKCropStatusSuccess) {
+                state.SkipWithError("The crop failed.");
+                return;
+            }
+            codec.Encode(&destination);
+        }
+    }
+    benchmark::DoNotOptimize(codec.checksum);
+
+    state.counters["images/s"] = benchmark::Counter(kBatchImageCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_CropBatchSequentially)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_CropBatch(benchmark::State &state)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(0);
+    if (!pool) {
+        state.SkipWithError("The thread pool cannot be created.");
+        return;
+    }
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+
+    SyntheticCodec codec;
+    RSKCropSpec spec = MakeBatchCropSpec();
+
+    RSKBatchCallbacks callbacks = {};
+    callbacks.decode = [](void *context, size_t, RSKBatchImage *image) { return static_cast<SyntheticCodec *>(context)->Decode(image); };
+    callbacks.encode = [](void *context, size_t, const RSKBitmap *bitmap) { return static_cast<SyntheticCodec *>(context)->Encode(bitmap); };
+    callbacks.context = &codec;
+
+    RSKBatchOptions options = {};
+    options.decodeThreadCount = static_cast<size_t>(state.range(0));
+    options.encodeThreadCount = 1;
+    options.executor = &executor;
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropBatch(kBatchImageCount, &spec, &callbacks, &options) != RSKCropStatusSuccess) {
+            state.SkipWithError("The batch crop failed.");
+            break;
+        }
+    }
+    benchmark::DoNotOptimize(codec.checksum);
+    RSKThreadPoolDestroy(pool);
+
+    state.counters["images/s"] = benchmark::Counter(kBatchImageCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_CropBatch)->ArgName("decoders")->Arg(1)->Arg(2)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Decodes the frames of an animation and counts the frames between the start of their decoding and the end of their
+// writing, which bounds the memory that a crop holds.
+struct SyntheticAnimation {
+    std::vector<uint8_t> framePixels = MakeSourcePixels(kAnimationFrameSize, kAnimationFrameSize);
+    uint64_t checksum = 0;
+    std::mutex mutex;
+    size_t residentFrameCount = 0;
+    size_t maximumResidentFrameCount = 0;
+
+    bool Decode(RSKBatchImage *frame)
+    {
+        uint8_t *pixels = new uint8_t[framePixels.size()];
+        std::memcpy(pixels, framePixels.data(), framePixels.size());
+        frame->bitmap = RSKBitmapMake(pixels, kAnimationFrameSize, kAnimationFrameSize, kAnimationFrameSize * 4, RSKPixelFormatRGBA8888);
+        frame->release = [](void *, const RSKBitmap *bitmap) { delete[] static_cast<uint8_t *>(bitmap->data); };
+        // Frames are decoded on several threads at once.
+        std::lock_guard<std::mutex> lock(mutex);
+        maximumResidentFrameCount = std::max(maximumResidentFrameCount, ++residentFrameCount);
+        return true;
+    }
+
+    bool Write(const RSKBitmap *frame)
+    {
+        const uint8_t *pixels = static_cast<const uint8_t *>(frame->data);
+        checksum += std::accumulate(pixels, pixels + frame->bytesPerRow * frame->height, uint64_t(0));
+        std::lock_guard<std::mutex> lock(mutex);
+        residentFrameCount--;
+        return true;
+    }
+};
+
+RSKCropSpec MakeAnimationCropSpec()
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCircle;
+    spec.cropRect = CGRectMake(0, 0, kAnimationFrameSize, kAnimationFrameSize);
+    spec.imageRect = CGRectMake(0, 0, kAnimationFrameSize, kAnimationFrameSize);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.applyMaskToCroppedImage = true;
+    return spec;
+}
+
+void SetAnimationCounters(benchmark::State &state, const SyntheticAnimation &animation, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(kAnimationFrameSize, kAnimationFrameSize, &spec);
+    const double frameBytes = kAnimationFrameSize * kAnimationFrameSize * 4 + size.width * size.height * 4;
+    state.counters["frames/s"] = benchmark::Counter(kAnimationFrameCount, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["peak MB"] = animation.maximumResidentFrameCount * frameBytes / 1e6;
+}
+
+// Decodes every frame, crops them one after another and only then writes them, like rebuilding a `UIImage` from an
+// array of cropped frames. It is the baseline for BM_CropAnimation.
+void BM_CropAnimationAtOnce(benchmark::State &state)
+{
+    SyntheticAnimation animation;
+    RSKCropSpec spec = MakeAnimationCropSpec();
+    CGSize size = RSKCropEngineGetOutputSize(kAnimationFrameSize, kAnimationFrameSize, &spec);
+    const size_t width = static_cast<size_t>(size.width);
+    const size_t height = static_cast<size_t>(size.height);
+
+    for (auto _ : state) {
+        std::vector<RSKBatchImage> frames(kAnimationFrameCount);
+        for (RSKBatchImage &frame : frames) {
+            animation.Decode(&frame);
+        }
+        std::vector<std::vector<uint8_t>> croppedFramePixels;
+        for (RSKBatchImage &frame : frames) {
+            croppedFramePixels.emplace_back(width * height * 4);
+            RSKBitmap croppedFrame = RSKBitmapMake(croppedFramePixels.back().data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+            if (RSKCropEngineCropBitmap(&frame.bitmap, &spec, &croppedFrame) != RSKCropStatusSuccess) {
+                state.SkipWithError("The crop failed.");
+                return;
+            }
+        }
+        for (size_t i = 0; i < kAnimationFrameCount; i++) {
+            RSKBitmap croppedFrame = RSKBitmapMake(croppedFramePixels[i].data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+            animation.Write(&croppedFrame);
+            frames[i].release(frames[i].releaseContext, &frames[i].bitmap);
+        }
+    }
+    benchmark::DoNotOptimize(animation.checksum);
+
+    SetAnimationCounters(state, animation, spec);
+}
+
+BENCHMARK(BM_CropAnimationAtOnce)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_CropAnimation(benchmark::State &state)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(0);
+    if (!pool) {
+        state.SkipWithError("The thread pool cannot be created.");
+        return;
+    }
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+
+    SyntheticAnimation animation;
+    RSKCropSpec spec = MakeAnimationCropSpec();
+
+    RSKAnimatedCropCallbacks callbacks = {};
+    callbacks.decode = [](void *context, size_t, RSKBatchImage *frame) { return static_cast<SyntheticAnimation *>(context)->Decode(frame); };
+    callbacks.write = [](void *context, size_t, const RSKBitmap *frame) { return static_cast<SyntheticAnimation *>(context)->Write(frame); };
+    callbacks.context = &animation;
+
+    RSKAnimatedCropOptions options = {};
+    options.residentFrameCount = static_cast<size_t>(state.range(0));
+    options.executor = &executor;
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropAnimated(kAnimationFrameCount, &spec, &callbacks, &options) != RSKCropStatusSuccess) {
+            state.SkipWithError("The animated crop failed.");
+            break;
+        }
+    }
+    benchmark::DoNotOptimize(animation.checksum);
+    RSKThreadPoolDestroy(pool);
+
+    SetAnimationCounters(state, animation, spec);
+}
+
+BENCHMARK(BM_CropAnimation)->ArgName("resident")->Arg(2)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Returns a spec that crops a square of the height of the 24 MP source out of its middle.
+RSKCropSpec MakeAvatarCropSpec()
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.cropRect = CGRectMake(0, 0, kLargeImageHeight, kLargeImageHeight);
+    spec.imageRect = CGRectMake((kLargeImageWidth - kLargeImageHeight) / 2, 0, kLargeImageHeight, kLargeImageHeight);
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    return spec;
+}
+
+// Crops the 24 MP source at full resolution and then scales the crop down to an avatar of `state.range(0)` pixels.
+void BM_CropThenResize(benchmark::State &state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kLargeImageWidth, kLargeImageHeight);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kLargeImageWidth, kLargeImageHeight, kLargeImageWidth * 4, RSKPixelFormatRGBA8888);
+    RSKCropSpec cropSpec = MakeAvatarCropSpec();
+
+    RSKCropSpec resizeSpec = {};
+    resizeSpec.cropMode = RSKCropModeSquare;
+    resizeSpec.cropRect = CGRectMake(0, 0, kLargeImageHeight, kLargeImageHeight);
+    resizeSpec.imageRect = resizeSpec.cropRect;
+    resizeSpec.zoomScale = 1;
+    resizeSpec.imageOrientation = RSKImageOrientationUp;
+    resizeSpec.outputSize = CGSizeMake(size, size);
+
+    std::vector<uint8_t> cropPixels(kLargeImageHeight * kLargeImageHeight * 4);
+    RSKBitmap crop = RSKBitmapMake(cropPixels.data(), kLargeImageHeight, kLargeImageHeight, kLargeImageHeight * 4, RSKPixelFormatRGBA8888);
+    std::vector<uint8_t> destinationPixels(size * size * 4);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), size, size, size * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmap(&source, &cropSpec, &crop) != RSKCropStatusSuccess ||
+            RSKCropEngineCropBitmap(&crop, &resizeSpec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            return;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double pixels = static_cast<double>(kLargeImageHeight * kLargeImageHeight);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_CropThenResize)->ArgName("size")->Arg(512)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
+
+// Crops the 24 MP source straight into an avatar of `state.range(0)` pixels with `outputSize`. Comparing it with
+// `BM_CropThenResize` shows what skipping the crop at full resolution saves.
+void BM_CropToSize(benchmark::State &state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kLargeImageWidth, kLargeImageHeight);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kLargeImageWidth, kLargeImageHeight, kLargeImageWidth * 4, RSKPixelFormatRGBA8888);
+    RSKCropSpec spec = MakeAvatarCropSpec();
+    spec.outputSize = CGSizeMake(size, size);
+
+    std::vector<uint8_t> destinationPixels(size * size * 4);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), size, size, size * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            return;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double pixels = static_cast<double>(kLargeImageHeight * kLargeImageHeight);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_CropToSize)->ArgName("size")->Arg(512)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
+
+} // namespace
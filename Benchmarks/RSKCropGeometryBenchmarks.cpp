@@ -0,0 +1,167 @@
+//
+// RSKCropGeometryBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKCropGeometry.h"
+
+namespace {
+
+constexpr size_t kInputCount = 1024;
+
+// Makes inputs that sweep the rotation, zoom and offset, like the states the controller goes through during a gesture.
+std::vector<RSKCropGeometryInput> MakeInputs(RSKCropMode cropMode)
+{
+    std::vector<RSKCropGeometryInput> inputs(kInputCount);
+    for (size_t i = 0; i < kInputCount; i++) {
+        RSKCropGeometryInput &input = inputs[i];
+        input.cropMode = cropMode;
+        input.maskRect = CGRectMake(20, 180, 335, 335);
+        input.rotationAngle = (i % 64) * M_PI / 32 - M_PI;
+        input.scrollViewSize = RSKCropGeometryGetMovementRect(cropMode, input.maskRect, input.maskRect, input.rotationAngle).size;
+        input.zoomScale = 0.25 + (i % 16) * 0.1;
+        input.imageSize = CGSizeMake(4032, 3024);
+        input.imageScale = 1;
+        input.imageOrientation = static_cast<RSKImageOrientation>(i % 8);
+        input.contentSize = CGSizeMake(input.imageSize.width * input.zoomScale, input.imageSize.height * input.zoomScale);
+        input.contentOffset = CGPointMake(std::fmod(i * 37.5, input.contentSize.width), std::fmod(i * 21.25, input.contentSize.height));
+    }
+    return inputs;
+}
+
+void BM_SolveCropGeometry(benchmark::State &state, RSKCropMode cropMode)
+{
+    const std::vector<RSKCropGeometryInput> inputs = MakeInputs(cropMode);
+
+    for (auto _ : state) {
+        for (const RSKCropGeometryInput &input : inputs) {
+            RSKCropGeometry geometry = RSKCropGeometrySolve(&input);
+            benchmark::DoNotOptimize(geometry);
+        }
+    }
+
+    state.counters["evaluations/s"] = benchmark::Counter(kInputCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_CAPTURE(BM_SolveCropGeometry, Square, RSKCropModeSquare);
+BENCHMARK_CAPTURE(BM_SolveCropGeometry, Circle, RSKCropModeCircle);
+
+constexpr size_t kRotationStepCount = 720;
+
+// The square mode of `-layoutImageScrollView` before the covering scale: it rotated the left edge of the mask and
+// searched for the points where it crosses the edges of the mask.
+CGRect SearchSquareMovementRect(CGRect maskRect, CGFloat rotationAngle)
+{
+    const CGPoint pivot = CGPointMake(CGRectGetMidX(maskRect), CGRectGetMidY(maskRect));
+    CGFloat alpha = std::fabs(rotationAngle);
+    const CGAffineTransform rotation = CGAffineTransformConcat(CGAffineTransformConcat(CGAffineTransformMakeTranslation(-pivot.x, -pivot.y), CGAffineTransformMakeRotation(alpha)), CGAffineTransformMakeTranslation(pivot.x, pivot.y));
+    const CGPoint p3 = CGPointApplyAffineTransform(CGPointMake(CGRectGetMinX(maskRect), CGRectGetMinY(maskRect)), rotation);
+    const CGPoint p4 = CGPointApplyAffineTransform(CGPointMake(CGRectGetMinX(maskRect), CGRectGetMaxY(maskRect)), rotation);
+
+    const CGPoint edges[4][2] = {
+        { { CGRectGetMinX(maskRect), CGRectGetMinY(maskRect) }, { CGRectGetMaxX(maskRect), CGRectGetMinY(maskRect) } },
+        { { CGRectGetMaxX(maskRect), CGRectGetMinY(maskRect) }, { CGRectGetMaxX(maskRect), CGRectGetMaxY(maskRect) } },
+        { { CGRectGetMinX(maskRect), CGRectGetMaxY(maskRect) }, { CGRectGetMaxX(maskRect), CGRectGetMaxY(maskRect) } },
+        { { CGRectGetMinX(maskRect), CGRectGetMinY(maskRect) }, { CGRectGetMinX(maskRect), CGRectGetMaxY(maskRect) } },
+    };
+    std::vector<CGPoint> points;
+    for (const auto &edge : edges) {
+        const CGPoint p1 = edge[0];
+        const CGPoint p2 = edge[1];
+        const CGFloat numeratorA = (p4.x - p3.x) * (p1.y - p3.y) - (p4.y - p3.y) * (p1.x - p3.x);
+        const CGFloat numeratorB = (p2.x - p1.x) * (p1.y - p3.y) - (p2.y - p1.y) * (p1.x - p3.x);
+        const CGFloat denominator = (p4.y - p3.y) * (p2.x - p1.x) - (p4.x - p3.x) * (p2.y - p1.y);
+        if (std::fabs(denominator) < CGFLOAT_EPSILON) {
+            continue;
+        }
+        const CGFloat uA = numeratorA / denominator;
+        const CGFloat uB = numeratorB / denominator;
+        if (uA >= 0 && uA <= 1 && uB >= 0 && uB <= 1) {
+            points.push_back(CGPointMake(p1.x + uA * (p2.x - p1.x), p1.y + uA * (p2.y - p1.y)));
+        }
+    }
+    if (points.size() < 2) {
+        return maskRect;
+    }
+
+    if (alpha > M_PI_2 && alpha < M_PI) {
+        alpha -= M_PI_2;
+    } else if (alpha > M_PI + M_PI_2 && alpha < M_PI + M_PI) {
+        alpha -= M_PI + M_PI_2;
+    }
+    const CGFloat altitude = std::hypot(points[0].x - points[1].x, points[0].y - points[1].y) * std::sin(alpha) * std::cos(alpha);
+    const CGFloat scale = (CGRectGetWidth(maskRect) + altitude * 2) / CGRectGetWidth(maskRect);
+    CGRect frame = CGRectApplyAffineTransform(maskRect, CGAffineTransformConcat(CGAffineTransformConcat(CGAffineTransformMakeTranslation(-pivot.x, -pivot.y), CGAffineTransformMakeScale(scale, scale)), CGAffineTransformMakeTranslation(pivot.x, pivot.y)));
+    frame.origin.x = std::floor(CGRectGetMinX(frame));
+    frame.origin.y = std::floor(CGRectGetMinY(frame));
+    return CGRectIntegral(frame);
+}
+
+// Lays out the image scroll view for every tick of a rotation gesture from `-pi` to `pi`. A tick rotates the transform
+// of the scroll view, which is where the layout finds the rotation.
+template <CGRect (*MovementRect)(CGRect, CGAffineTransform)>
+void BM_LayoutSquareMovementRect(benchmark::State &state)
+{
+    const CGRect maskRect = CGRectMake(20, 180, 335, 335);
+    std::vector<CGAffineTransform> transforms(kRotationStepCount);
+    for (size_t step = 0; step < kRotationStepCount; step++) {
+        transforms[step] = CGAffineTransformMakeRotation(step * 2 * M_PI / kRotationStepCount - M_PI);
+    }
+
+    for (auto _ : state) {
+        for (const CGAffineTransform &transform : transforms) {
+            CGRect movementRect = MovementRect(maskRect, transform);
+            benchmark::DoNotOptimize(movementRect);
+        }
+    }
+
+    state.counters["updates/s"] = benchmark::Counter(kRotationStepCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// The layout before the covering scale, which took the angle of the transform, like `rotationAngle`, and searched.
+CGRect SearchSquareMovementRect(CGRect maskRect, CGAffineTransform transform)
+{
+    return SearchSquareMovementRect(maskRect, std::atan2(transform.b, transform.a));
+}
+
+// The covering scale of the angle of the transform.
+CGRect CoverSquareMovementRect(CGRect maskRect, CGAffineTransform transform)
+{
+    return RSKCropGeometryGetMovementRect(RSKCropModeSquare, maskRect, CGRectNull, std::atan2(transform.b, transform.a));
+}
+
+// The covering scale of the rotation of the transform, which is what the layout does now.
+CGRect CoverSquareMovementRectForRotation(CGRect maskRect, CGAffineTransform transform)
+{
+    return RSKCropGeometryGetMovementRectForRotation(RSKCropModeSquare, maskRect, CGRectNull, { transform.b, transform.a });
+}
+
+BENCHMARK_TEMPLATE(BM_LayoutSquareMovementRect, SearchSquareMovementRect)->Name("BM_LayoutSquareMovementRect/Search");
+BENCHMARK_TEMPLATE(BM_LayoutSquareMovementRect, CoverSquareMovementRect)->Name("BM_LayoutSquareMovementRect/CoveringScale");
+BENCHMARK_TEMPLATE(BM_LayoutSquareMovementRect, CoverSquareMovementRectForRotation)->Name("BM_LayoutSquareMovementRect/CoveringScaleForRotation");
+
+} // namespace
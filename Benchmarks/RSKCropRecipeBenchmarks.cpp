@@ -0,0 +1,177 @@
+//
+// RSKCropRecipeBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKCropEngine.h"
+#include "RSKCropRecipe.h"
+
+namespace {
+
+// A 12 MP photo, like the originals that a server keeps.
+constexpr size_t kImageWidth = 4032;
+constexpr size_t kImageHeight = 3024;
+
+// The control points of the cubic Bézier curves that approximate a quarter of a circle.
+constexpr double kCircleControlPointDistance = 0.5522847498;
+
+std::vector<RSKPathElement> MakeOvalPath(CGRect rect)
+{
+    const double midX = CGRectGetMidX(rect);
+    const double midY = CGRectGetMidY(rect);
+    const double radiusX = rect.size.width / 2;
+    const double radiusY = rect.size.height / 2;
+    const double controlX = radiusX * kCircleControlPointDistance;
+    const double controlY = radiusY * kCircleControlPointDistance;
+
+    return {
+        { RSKPathElementTypeMoveToPoint, { { midX + radiusX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + radiusX, midY + controlY }, { midX + controlX, midY + radiusY }, { midX, midY + radiusY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - controlX, midY + radiusY }, { midX - radiusX, midY + controlY }, { midX - radiusX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - radiusX, midY - controlY }, { midX - controlX, midY - radiusY }, { midX, midY - radiusY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + controlX, midY - radiusY }, { midX + radiusX, midY - controlY }, { midX + radiusX, midY } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// Returns the recipe of a round avatar of the photo, as the image crop view controller makes it: the mask path is in
+// the points of a 375-point wide screen.
+RSKCropRecipe MakeAvatarRecipe(const std::vector<RSKPathElement> &maskPath)
+{
+    RSKCropRecipe recipe = {};
+    recipe.sourceSize = CGSizeMake(kImageWidth, kImageHeight);
+    RSKCropSpec &spec = recipe.spec;
+    spec.cropMode = RSKCropModeCircle;
+    spec.cropRect = CGRectMake(1210.4, 640.8, 1600.5, 1600.5);
+    spec.imageRect = CGRectMake(0, 0, kImageWidth, kImageHeight);
+    spec.rotationAngle = 0.12;
+    spec.zoomScale = 315.0 / 1600.5;
+    spec.imageOrientation = RSKImageOrientationRight;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+    return recipe;
+}
+
+std::vector<uint8_t> WriteRecipe(const RSKCropRecipe &recipe, RSKCropRecipeFormat format)
+{
+    std::vector<uint8_t> data(RSKCropRecipeWrite(&recipe, format, nullptr, 0));
+    RSKCropRecipeWrite(&recipe, format, data.data(), data.size());
+    return data;
+}
+
+// Returns the pixels of an opaque source of `width` x `height` pixels.
+std::vector<uint8_t> MakeSourcePixels(size_t width, size_t height)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i + 0] = static_cast<uint8_t>(i * 7 % 251);
+        pixels[i + 1] = static_cast<uint8_t>(i * 3 % 241);
+        pixels[i + 2] = static_cast<uint8_t>(i % 239);
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+// Writes the recipe of an avatar in `format` and reports its length.
+void BM_WriteCropRecipe(benchmark::State &state, RSKCropRecipeFormat format)
+{
+    const std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(30, 176, 315, 315));
+    const RSKCropRecipe recipe = MakeAvatarRecipe(maskPath);
+    std::vector<uint8_t> data = WriteRecipe(recipe, format);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RSKCropRecipeWrite(&recipe, format, data.data(), data.size()));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.counters["bytes"] = static_cast<double>(data.size());
+}
+
+BENCHMARK_CAPTURE(BM_WriteCropRecipe, Binary, RSKCropRecipeFormatBinary);
+BENCHMARK_CAPTURE(BM_WriteCropRecipe, JSON, RSKCropRecipeFormatJSON);
+
+// Reads the recipe of an avatar in `format` into elements on the stack, like a server that replays a stream of them.
+void BM_ReadCropRecipe(benchmark::State &state, RSKCropRecipeFormat format)
+{
+    const std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(30, 176, 315, 315));
+    const std::vector<uint8_t> data = WriteRecipe(MakeAvatarRecipe(maskPath), format);
+
+    for (auto _ : state) {
+        RSKPathElement elements[16];
+        RSKCropRecipe recipe;
+        if (RSKCropRecipeRead(data.data(), data.size(), elements, 16, &recipe) != RSKCropStatusSuccess) {
+            state.SkipWithError("The recipe cannot be read.");
+            return;
+        }
+        benchmark::DoNotOptimize(recipe);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+    state.counters["recipes/s"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_CAPTURE(BM_ReadCropRecipe, Binary, RSKCropRecipeFormatBinary);
+BENCHMARK_CAPTURE(BM_ReadCropRecipe, JSON, RSKCropRecipeFormatJSON);
+
+// Reads the binary recipe of an avatar and replays it on the photo at an output size of `size` x `size` pixels, or at
+// the size of the crop if `size` is zero.
+void BM_ReplayCropRecipe(benchmark::State &state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    const std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(30, 176, 315, 315));
+    const std::vector<uint8_t> data = WriteRecipe(MakeAvatarRecipe(maskPath), RSKCropRecipeFormatBinary);
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kImageWidth, kImageHeight);
+    const RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888);
+
+    RSKPathElement elements[16];
+    RSKCropRecipe recipe;
+    RSKCropRecipeRead(data.data(), data.size(), elements, 16, &recipe);
+    const CGSize outputSize = CGSizeMake(size, size);
+    const RSKCropSpec spec = RSKCropRecipeGetSpec(&recipe, kImageWidth, kImageHeight, outputSize);
+    const CGSize destinationSize = RSKCropEngineGetOutputSize(kImageWidth, kImageHeight, &spec);
+    const size_t width = static_cast<size_t>(destinationSize.width);
+    const size_t height = static_cast<size_t>(destinationSize.height);
+    std::vector<uint8_t> destinationPixels(width * height * 4);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKCropRecipeRead(data.data(), data.size(), elements, 16, &recipe) != RSKCropStatusSuccess ||
+            RSKCropEngineCropRecipe(&source, &recipe, outputSize, nullptr, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The recipe cannot be replayed.");
+            return;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["recipes/s"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_ReplayCropRecipe)->ArgName("size")->Arg(0)->Arg(512)->Arg(128)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,185 @@
+//
+// RSKEncodedImageBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <jpeglib.h>
+
+#include "RSKCropEngine.h"
+#include "RSKEncodedImage.h"
+
+namespace {
+
+// A 12 MP photo.
+constexpr size_t kImageWidth = 4032;
+constexpr size_t kImageHeight = 3024;
+
+// Returns a 12 MP JPEG of smooth gradients, encoded like a photo of a camera.
+const std::vector<uint8_t> &SourceJPEG()
+{
+    static const std::vector<uint8_t> data = [] {
+        std::vector<uint8_t> row(kImageWidth * 3);
+        jpeg_compress_struct info;
+        jpeg_error_mgr error;
+        info.err = jpeg_std_error(&error);
+        jpeg_create_compress(&info);
+        unsigned char *buffer = nullptr;
+        unsigned long length = 0;
+        jpeg_mem_dest(&info, &buffer, &length);
+        info.image_width = kImageWidth;
+        info.image_height = kImageHeight;
+        info.input_components = 3;
+        info.in_color_space = JCS_RGB;
+        jpeg_set_defaults(&info);
+        jpeg_set_quality(&info, 90, TRUE);
+        jpeg_start_compress(&info, TRUE);
+        while (info.next_scanline < info.image_height) {
+            const size_t y = info.next_scanline;
+            for (size_t x = 0; x < kImageWidth; x++) {
+                row[x * 3] = static_cast<uint8_t>(255 * x / kImageWidth);
+                row[x * 3 + 1] = static_cast<uint8_t>(255 * y / kImageHeight);
+                row[x * 3 + 2] = static_cast<uint8_t>(127.5 + 127.5 * std::sin((x + y) * 0.01));
+            }
+            JSAMPROW rowPointer = row.data();
+            jpeg_write_scanlines(&info, &rowPointer, 1);
+        }
+        jpeg_finish_compress(&info);
+        jpeg_destroy_compress(&info);
+        std::vector<uint8_t> data(buffer, buffer + length);
+        free(buffer);
+        return data;
+    }();
+    return data;
+}
+
+// An avatar: a square of a third of the shorter side of the photo, off its center, shrunk to `outputSize` unless it is
+// zero.
+RSKCropSpec MakeAvatarSpec(size_t outputSize)
+{
+    const CGFloat side = kImageHeight / 3;
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCircle;
+    spec.imageRect = CGRectMake(kImageWidth * 0.55, kImageHeight * 0.2, side, side);
+    spec.cropRect = CGRectMake(0, 0, side, side);
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.outputSize = CGSizeMake(outputSize, outputSize);
+    return spec;
+}
+
+// Decodes the whole 12 MP JPEG and crops an avatar of `state.range(0)` pixels out of it, or at full size for 0.
+void BM_DecodeThenCrop(benchmark::State &state)
+{
+    const std::vector<uint8_t> &data = SourceJPEG();
+    const RSKCropSpec spec = MakeAvatarSpec(static_cast<size_t>(state.range(0)));
+    const CGSize size = RSKCropEngineGetOutputSize(kImageWidth, kImageHeight, &spec);
+    std::vector<uint8_t> pixels(kImageWidth * kImageHeight * 4);
+    std::vector<uint8_t> resultPixels(static_cast<size_t>(size.width * size.height) * 4);
+    RSKBitmap source = RSKBitmapMake(pixels.data(), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888);
+    RSKBitmap destination = RSKBitmapMake(resultPixels.data(), static_cast<size_t>(size.width), static_cast<size_t>(size.height), static_cast<size_t>(size.width) * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        jpeg_decompress_struct info;
+        jpeg_error_mgr error;
+        info.err = jpeg_std_error(&error);
+        jpeg_create_decompress(&info);
+        jpeg_mem_src(&info, data.data(), static_cast<unsigned long>(data.size()));
+        jpeg_read_header(&info, TRUE);
+        info.out_color_space = JCS_EXT_RGBA;
+        jpeg_start_decompress(&info);
+        while (info.output_scanline < info.output_height) {
+            JSAMPROW row = pixels.data() + info.output_scanline * kImageWidth * 4;
+            jpeg_read_scanlines(&info, &row, 1);
+        }
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        benchmark::DoNotOptimize(resultPixels.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Like `BM_DecodeThenCrop`, but decodes only the part of the JPEG that the crop reads.
+void BM_CropEncodedImage(benchmark::State &state)
+{
+    const std::vector<uint8_t> &data = SourceJPEG();
+    const RSKCropSpec spec = MakeAvatarSpec(static_cast<size_t>(state.range(0)));
+    const CGSize size = RSKCropEngineGetOutputSize(kImageWidth, kImageHeight, &spec);
+    std::vector<uint8_t> resultPixels(static_cast<size_t>(size.width * size.height) * 4);
+    RSKBitmap destination = RSKBitmapMake(resultPixels.data(), static_cast<size_t>(size.width), static_cast<size_t>(size.height), static_cast<size_t>(size.width) * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropEncodedImage(data.data(), data.size(), &spec, nullptr, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        benchmark::DoNotOptimize(resultPixels.data());
+        benchmark::ClobberMemory();
+    }
+}
+
+// Crops a square of a third of the shorter side of the photo out of the 12 MP JPEG into another JPEG, rotated by
+// `state.range(1)` quarter turns. A square that starts on an MCU, for `state.range(0)` = 1, moves the coefficients of
+// the blocks; one that starts 8 pixels further decodes, crops and encodes the pixels again.
+void BM_CropEncodedImageToJPEG(benchmark::State &state)
+{
+    const std::vector<uint8_t> &data = SourceJPEG();
+    const CGFloat side = 1008;
+    const CGFloat offset = state.range(0) ? 0 : 8;
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.imageRect = CGRectMake(2048 + offset, 1008 + offset, side, side);
+    spec.cropRect = CGRectMake(0, 0, side, side);
+    spec.zoomScale = 1;
+    spec.rotationAngle = state.range(1) * M_PI_2;
+    spec.imageOrientation = RSKImageOrientationUp;
+
+    bool isLossless = false;
+    for (auto _ : state) {
+        RSKEncodedData result = {};
+        if (RSKCropEngineCropEncodedImageToJPEG(data.data(), data.size(), &spec, nullptr, &result) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        isLossless = result.isLossless;
+        benchmark::DoNotOptimize(result.data);
+        RSKEncodedDataFree(&result);
+    }
+    state.counters["lossless"] = isLossless;
+}
+
+BENCHMARK(BM_DecodeThenCrop)->ArgName("outputSize")->Arg(0)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CropEncodedImage)->ArgName("outputSize")->Arg(0)->Arg(256)->Arg(128)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CropEncodedImageToJPEG)->ArgNames({ "aligned", "quarterTurns" })->Args({ 1, 0 })->Args({ 0, 0 })->Args({ 1, 1 })->Args({ 0, 1 })->Unit(benchmark::kMillisecond);
+
+} // namespace
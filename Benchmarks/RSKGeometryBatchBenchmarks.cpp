@@ -0,0 +1,150 @@
+//
+// RSKGeometryBatchBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKGeometryBatch.hpp"
+
+using rsk::SimdInstructionSet;
+
+namespace {
+
+constexpr size_t kElementCount = 4096;
+
+// Arrays of `kElementCount` values that stay in the L1 and L2 caches, so that the benchmarks measure arithmetic.
+struct Arrays {
+    std::vector<double> values[8];
+
+    Arrays()
+    {
+        for (size_t i = 0; i < 8; i++) {
+            values[i].resize(kElementCount);
+            for (size_t j = 0; j < kElementCount; j++) {
+                values[i][j] = std::fmod((j + 1) * (i + 3) * 12.345, 800.0) - 400.0;
+            }
+        }
+    }
+
+    rsk::PointArray<double> Points(size_t index) { return { values[index].data(), values[index + 1].data() }; }
+
+    rsk::RectArray<double> Rects(size_t index)
+    {
+        return { values[index].data(), values[index + 1].data(), values[index + 2].data(), values[index + 3].data() };
+    }
+};
+
+const rsk::AffineTransform<double> kTransform = { 0.8, 0.6, -0.6, 0.8, 12.5, -7.25 };
+
+bool SkipUnsupported(benchmark::State &state, SimdInstructionSet instructionSet)
+{
+    if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+        state.SkipWithError("The instruction set is not supported.");
+        return true;
+    }
+    return false;
+}
+
+void BM_TransformPoints(benchmark::State &state, SimdInstructionSet instructionSet)
+{
+    if (SkipUnsupported(state, instructionSet)) {
+        return;
+    }
+    const rsk::GeometryKernels &kernels = rsk::GetGeometryKernels(instructionSet);
+    Arrays arrays;
+
+    for (auto _ : state) {
+        kernels.transformPoints(arrays.Points(0), kElementCount, kTransform, arrays.Points(2));
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["points/s"] = benchmark::Counter(kElementCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_TransformRects(benchmark::State &state, SimdInstructionSet instructionSet)
+{
+    if (SkipUnsupported(state, instructionSet)) {
+        return;
+    }
+    const rsk::GeometryKernels &kernels = rsk::GetGeometryKernels(instructionSet);
+    Arrays arrays;
+
+    for (auto _ : state) {
+        kernels.transformRects(arrays.Rects(0), kElementCount, kTransform, arrays.Rects(4));
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["rects/s"] = benchmark::Counter(kElementCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_NormalizeRects(benchmark::State &state, SimdInstructionSet instructionSet)
+{
+    if (SkipUnsupported(state, instructionSet)) {
+        return;
+    }
+    const rsk::GeometryKernels &kernels = rsk::GetGeometryKernels(instructionSet);
+    Arrays arrays;
+
+    for (auto _ : state) {
+        kernels.normalizeRects(arrays.Rects(0), kElementCount, arrays.Rects(4));
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["rects/s"] = benchmark::Counter(kElementCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_IntersectSegments(benchmark::State &state, SimdInstructionSet instructionSet)
+{
+    if (SkipUnsupported(state, instructionSet)) {
+        return;
+    }
+    const rsk::GeometryKernels &kernels = rsk::GetGeometryKernels(instructionSet);
+    Arrays arrays;
+    std::vector<double> x(kElementCount);
+    std::vector<double> y(kElementCount);
+
+    for (auto _ : state) {
+        kernels.intersectSegments({ arrays.Points(0), arrays.Points(2) }, { arrays.Points(4), arrays.Points(6) }, kElementCount, { x.data(), y.data() });
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["intersections/s"] = benchmark::Counter(kElementCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_CAPTURE(BM_TransformPoints, Scalar, SimdInstructionSet::Scalar);
+BENCHMARK_CAPTURE(BM_TransformPoints, AVX2, SimdInstructionSet::AVX2);
+BENCHMARK_CAPTURE(BM_TransformPoints, NEON, SimdInstructionSet::NEON);
+BENCHMARK_CAPTURE(BM_TransformRects, Scalar, SimdInstructionSet::Scalar);
+BENCHMARK_CAPTURE(BM_TransformRects, AVX2, SimdInstructionSet::AVX2);
+BENCHMARK_CAPTURE(BM_TransformRects, NEON, SimdInstructionSet::NEON);
+BENCHMARK_CAPTURE(BM_NormalizeRects, Scalar, SimdInstructionSet::Scalar);
+BENCHMARK_CAPTURE(BM_NormalizeRects, AVX2, SimdInstructionSet::AVX2);
+BENCHMARK_CAPTURE(BM_NormalizeRects, NEON, SimdInstructionSet::NEON);
+BENCHMARK_CAPTURE(BM_IntersectSegments, Scalar, SimdInstructionSet::Scalar);
+BENCHMARK_CAPTURE(BM_IntersectSegments, AVX2, SimdInstructionSet::AVX2);
+BENCHMARK_CAPTURE(BM_IntersectSegments, NEON, SimdInstructionSet::NEON);
+
+} // namespace
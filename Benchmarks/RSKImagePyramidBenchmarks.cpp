@@ -0,0 +1,87 @@
+//
+// RSKImagePyramidBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKImagePyramid.h"
+
+namespace {
+
+// A 48 MP source, like the photos of the main camera of a recent phone.
+constexpr size_t kImageWidth = 8064;
+constexpr size_t kImageHeight = 6048;
+
+std::vector<uint8_t> MakeSourcePixels(size_t width, size_t height)
+{
+    std::vector<uint8_t> pixels(width * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = static_cast<uint8_t>(i * 7);
+        pixels[i + 1] = static_cast<uint8_t>(i * 13);
+        pixels[i + 2] = static_cast<uint8_t>(i * 29);
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+// Makes the level `state.range(0)` of the pyramid of the 48 MP source on a pool of `state.range(1)` threads, like the
+// preview of a zoomed out photo, and reports the megapixels of the source read per second.
+void BM_MakePyramidLevel(benchmark::State &state)
+{
+    const size_t level = static_cast<size_t>(state.range(0));
+    RSKThreadPool *pool = RSKThreadPoolCreate(static_cast<size_t>(state.range(1)));
+    if (!pool) {
+        state.SkipWithError("The thread pool cannot be created.");
+        return;
+    }
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+
+    std::vector<uint8_t> sourcePixels = MakeSourcePixels(kImageWidth, kImageHeight);
+    RSKBitmap source = RSKBitmapMake(sourcePixels.data(), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888);
+
+    CGSize size = RSKImagePyramidGetLevelSize(kImageWidth, kImageHeight, level);
+    const size_t width = static_cast<size_t>(size.width);
+    const size_t height = static_cast<size_t>(size.height);
+    std::vector<uint8_t> levelPixels(width * height * 4);
+    RSKBitmap destination = RSKBitmapMake(levelPixels.data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKImagePyramidMakeLevel(&source, level, &executor, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The level cannot be made.");
+            break;
+        }
+        benchmark::DoNotOptimize(levelPixels.data());
+        benchmark::ClobberMemory();
+    }
+    RSKThreadPoolDestroy(pool);
+
+    const double pixels = static_cast<double>(kImageWidth * kImageHeight);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_MakePyramidLevel)->ArgNames({ "level", "threads" })->Args({ 1, 1 })->Args({ 2, 1 })->Args({ 3, 1 })->Args({ 2, 4 })->UseRealTime()->Unit(benchmark::kMillisecond);
+
+} // namespace
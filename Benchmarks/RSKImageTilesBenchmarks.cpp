@@ -0,0 +1,110 @@
+//
+// RSKImageTilesBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKImageTiles.h"
+
+namespace {
+
+// A 48 MP photo shown on a phone screen.
+constexpr size_t kImageWidth = 8064;
+constexpr size_t kImageHeight = 6048;
+constexpr CGFloat kScreenWidth = 390;
+constexpr CGFloat kScreenHeight = 844;
+constexpr CGFloat kScreenScale = 3;
+
+constexpr size_t kTileSize = 256;
+constexpr size_t kTraceLength = 10000;
+
+// Returns the viewports of a session of zooming and panning: the photo is zoomed in from fitting the screen to its
+// pixels and out again, while it is panned around in a circle.
+std::vector<RSKTileViewport> MakePanAndZoomTrace()
+{
+    const CGSize imageSize = CGSizeMake(kImageWidth / kScreenScale, kImageHeight / kScreenScale);
+    const CGFloat minimumZoomScale = kScreenWidth / imageSize.width;
+
+    std::vector<RSKTileViewport> trace(kTraceLength);
+    for (size_t i = 0; i < kTraceLength; i++) {
+        const double phase = static_cast<double>(i) / kTraceLength;
+        const CGFloat zoomScale = minimumZoomScale * std::pow(1 / minimumZoomScale, 0.5 - 0.5 * std::cos(phase * 4 * M_PI));
+        const CGSize contentSize = CGSizeMake(imageSize.width * zoomScale, imageSize.height * zoomScale);
+        const CGFloat centerX = contentSize.width * (0.5 + 0.3 * std::cos(phase * 40 * M_PI));
+        const CGFloat centerY = contentSize.height * (0.5 + 0.3 * std::sin(phase * 40 * M_PI));
+
+        RSKTileViewport &viewport = trace[i];
+        viewport.contentOffset = CGPointMake(centerX - kScreenWidth / 2, centerY - kScreenHeight / 2);
+        viewport.boundsSize = CGSizeMake(kScreenWidth, kScreenHeight);
+        viewport.zoomScale = zoomScale;
+        viewport.imageSize = imageSize;
+        viewport.screenScale = kScreenScale;
+    }
+    return trace;
+}
+
+// Replays a pan and zoom trace through a tile cache of `state.range(0)` MB: every viewport looks up its visible tiles
+// and makes the missing ones. Reports the viewports per second, the tiles made per viewport and the hit rate.
+void BM_ReplayPanAndZoomTrace(benchmark::State &state)
+{
+    const size_t byteBudget = static_cast<size_t>(state.range(0)) * 1024 * 1024;
+    const size_t tileByteCount = kTileSize * kTileSize * 4;
+    const std::vector<RSKTileViewport> trace = MakePanAndZoomTrace();
+    const RSKTileGrid grid = RSKTileGridMake(kImageWidth, kImageHeight, kTileSize, kTileSize);
+    std::vector<RSKTileKey> tiles(1024);
+
+    // The tiles are stand-ins, so that the benchmark measures the bookkeeping rather than the pixels.
+    static uint8_t tile;
+    RSKTileReleaseFunction release = [](void *, void *) {};
+
+    size_t lookupCount = 0;
+    size_t missCount = 0;
+    for (auto _ : state) {
+        RSKTileCache *cache = RSKTileCacheCreate(byteBudget, release, nullptr);
+        for (const RSKTileViewport &viewport : trace) {
+            const size_t tileCount = RSKTileGridGetVisibleTiles(&grid, &viewport, tiles.data(), tiles.size());
+            for (size_t i = 0; i < std::min(tileCount, tiles.size()); i++) {
+                const RSKTileKey key = tiles[i];
+                lookupCount++;
+                if (!RSKTileCacheGetTile(cache, key)) {
+                    missCount++;
+                    RSKTileCacheInsertTile(cache, key, &tile, tileByteCount);
+                }
+            }
+        }
+        RSKTileCacheDestroy(cache);
+    }
+
+    state.counters["viewports/s"] = benchmark::Counter(static_cast<double>(kTraceLength), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["misses/viewport"] = static_cast<double>(missCount) / (state.iterations() * kTraceLength);
+    state.counters["hit rate"] = 1 - static_cast<double>(missCount) / lookupCount;
+}
+
+BENCHMARK(BM_ReplayPanAndZoomTrace)->ArgName("MB")->Arg(8)->Arg(32)->Arg(128)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,163 @@
+//
+// RSKOpaqueImageBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <png.h>
+
+#include "RSKCropEngine.h"
+#include "RSKEncodedImage.h"
+
+namespace {
+
+// A 6 MP screenshot.
+constexpr size_t kImageWidth = 3000;
+constexpr size_t kImageHeight = 2000;
+
+// Returns the RGBA `pixels` encoded as a PNG, with an alpha channel if `hasAlpha` is true and without one otherwise,
+// like an encoder that takes the opaque path.
+std::vector<uint8_t> EncodePNG(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, bool hasAlpha)
+{
+    std::vector<png_bytep> rows(height);
+    for (size_t y = 0; y < height; y++) {
+        rows[y] = const_cast<uint8_t *>(pixels + y * bytesPerRow);
+    }
+
+    std::vector<uint8_t> data;
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png_create_info_struct(png);
+    png_set_write_fn(png, &data, [](png_structp png, png_bytep bytes, png_size_t count) {
+        std::vector<uint8_t> &data = *static_cast<std::vector<uint8_t> *>(png_get_io_ptr(png));
+        data.insert(data.end(), bytes, bytes + count);
+    }, nullptr);
+    png_set_IHDR(png, info, static_cast<png_uint_32>(width), static_cast<png_uint_32>(height), 8, hasAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_set_compression_level(png, 1);
+    png_set_rows(png, info, rows.data());
+    png_write_png(png, info, hasAlpha ? PNG_TRANSFORM_IDENTITY : PNG_TRANSFORM_STRIP_FILLER_AFTER, nullptr);
+    png_destroy_write_struct(&png, &info);
+    return data;
+}
+
+// Returns the opaque pixels of the 6 MP screenshot, which are smooth gradients.
+const std::vector<uint8_t> &SourcePixels()
+{
+    static const std::vector<uint8_t> pixels = [] {
+        std::vector<uint8_t> pixels(kImageWidth * kImageHeight * 4);
+        for (size_t y = 0; y < kImageHeight; y++) {
+            uint8_t *pixel = &pixels[y * kImageWidth * 4];
+            for (size_t x = 0; x < kImageWidth; x++, pixel += 4) {
+                pixel[0] = static_cast<uint8_t>(255 * x / kImageWidth);
+                pixel[1] = static_cast<uint8_t>(255 * y / kImageHeight);
+                pixel[2] = static_cast<uint8_t>(127.5 + 127.5 * std::sin((x + y) * 0.01));
+                pixel[3] = 255;
+            }
+        }
+        return pixels;
+    }();
+    return pixels;
+}
+
+// Returns the 6 MP screenshot as a PNG with an alpha channel of opaque pixels if `hasAlpha` is true, like one that is
+// saved with alpha, and without one otherwise.
+const std::vector<uint8_t> &SourcePNG(bool hasAlpha)
+{
+    static const std::vector<uint8_t> opaqueData = EncodePNG(SourcePixels().data(), kImageWidth, kImageHeight, kImageWidth * 4, false);
+    static const std::vector<uint8_t> data = EncodePNG(SourcePixels().data(), kImageWidth, kImageHeight, kImageWidth * 4, true);
+    return hasAlpha ? data : opaqueData;
+}
+
+// The middle 1600 x 1200 pixels of the screenshot, rotated by `rotationAngle`. A rotated crop is drawn from a larger
+// image rect, which covers its corners, so it stays opaque.
+RSKCropSpec MakeMiddleSpec(CGFloat rotationAngle)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.imageRect = rotationAngle == 0.0 ? CGRectMake(700, 400, 1600, 1200) : CGRectMake(500, 300, 2000, 1400);
+    spec.cropRect = CGRectMake(0, 0, 1600, 1200);
+    spec.zoomScale = 1;
+    spec.rotationAngle = rotationAngle;
+    spec.imageOrientation = RSKImageOrientationUp;
+    return spec;
+}
+
+// Crops the middle of the 6 MP PNG, which has an alpha channel unless `state.range(0)` is 1. An opaque PNG inflates a
+// quarter fewer bytes for every pixel and skips the premultiplication of its colors, and its crop is opaque.
+void BM_CropOpaquePNG(benchmark::State &state)
+{
+    const bool isOpaque = state.range(0);
+    const std::vector<uint8_t> &data = SourcePNG(!isOpaque);
+    const RSKCropSpec spec = MakeMiddleSpec(0);
+    const CGSize size = RSKCropEngineGetOutputSize(kImageWidth, kImageHeight, &spec);
+    std::vector<uint8_t> resultPixels(static_cast<size_t>(size.width * size.height) * 4);
+    RSKBitmap destination = RSKBitmapMake(resultPixels.data(), static_cast<size_t>(size.width), static_cast<size_t>(size.height), static_cast<size_t>(size.width) * 4, RSKPixelFormatRGBA8888);
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropEncodedImage(data.data(), data.size(), &spec, nullptr, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        benchmark::DoNotOptimize(resultPixels.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["opaqueResult"] = RSKEncodedImageIsOpaque(data.data(), data.size()) && RSKCropEngineIsOutputOpaque(kImageWidth, kImageHeight, &spec);
+    state.counters["encodedBytes"] = static_cast<double>(data.size());
+    state.counters["inflatedBytesPerPixel"] = isOpaque ? 3 : 4;
+}
+
+// Crops the middle of the screenshot, slightly rotated, and encodes the result as a PNG, which skips the alpha channel
+// if the result is opaque, unless `state.range(0)` is 0, like the encoder of a result that is always translucent.
+void BM_EncodeOpaqueCropAsPNG(benchmark::State &state)
+{
+    const std::vector<uint8_t> &pixels = SourcePixels();
+    const RSKCropSpec spec = MakeMiddleSpec(0.05);
+    const CGSize size = RSKCropEngineGetOutputSize(kImageWidth, kImageHeight, &spec);
+    const size_t width = static_cast<size_t>(size.width);
+    const size_t height = static_cast<size_t>(size.height);
+    std::vector<uint8_t> resultPixels(width * height * 4);
+    RSKBitmap source = RSKBitmapMake(const_cast<uint8_t *>(pixels.data()), kImageWidth, kImageHeight, kImageWidth * 4, RSKPixelFormatRGBA8888);
+    RSKBitmap destination = RSKBitmapMake(resultPixels.data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+
+    size_t encodedBytes = 0;
+    const bool isOpaque = state.range(0) && RSKCropEngineIsOutputOpaque(kImageWidth, kImageHeight, &spec);
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmap(&source, &spec, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The image cannot be cropped.");
+            break;
+        }
+        const std::vector<uint8_t> data = EncodePNG(resultPixels.data(), width, height, width * 4, !isOpaque);
+        encodedBytes = data.size();
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.counters["opaqueResult"] = isOpaque;
+    state.counters["encodedBytes"] = static_cast<double>(encodedBytes);
+}
+
+BENCHMARK(BM_CropOpaquePNG)->ArgName("opaque")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncodeOpaqueCropAsPNG)->ArgName("opaque")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,114 @@
+//
+// RSKOrientKernelsBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKOrientKernels.hpp"
+
+namespace {
+
+using rsk::SimdInstructionSet;
+
+// A 24 MP photo, like the ones of a phone.
+constexpr size_t kSourceWidth = 6000;
+constexpr size_t kSourceHeight = 4000;
+
+struct QuarterTurnBitmaps {
+    std::vector<uint8_t> sourcePixels = std::vector<uint8_t>(kSourceWidth * kSourceHeight * rsk::kBytesPerPixel);
+    std::vector<uint8_t> destinationPixels = std::vector<uint8_t>(kSourceWidth * kSourceHeight * rsk::kBytesPerPixel);
+    rsk::BitmapView source;
+    rsk::BitmapView destination;
+
+    explicit QuarterTurnBitmaps(RSKImageOrientation orientation)
+    {
+        for (size_t i = 0; i < sourcePixels.size(); i++) {
+            sourcePixels[i] = static_cast<uint8_t>(i * 7 % 251);
+        }
+        source.data = sourcePixels.data();
+        source.width = kSourceWidth;
+        source.height = kSourceHeight;
+        source.bytesPerRow = kSourceWidth * rsk::kBytesPerPixel;
+
+        const bool swapsDimensions = rsk::OrientationSwapsDimensions(orientation);
+        destination.data = destinationPixels.data();
+        destination.width = swapsDimensions ? kSourceHeight : kSourceWidth;
+        destination.height = swapsDimensions ? kSourceWidth : kSourceHeight;
+        destination.bytesPerRow = destination.width * rsk::kBytesPerPixel;
+    }
+};
+
+// Reports the bytes that are read and written per second, every pixel of the photo once each.
+void SetBytesPerSecond(benchmark::State &state)
+{
+    const double bytes = 2.0 * kSourceWidth * kSourceHeight * rsk::kBytesPerPixel;
+    state.counters["GB/s"] = benchmark::Counter(bytes / 1e9, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Turns the photo by a right angle, or flips it, by moving its pixels with the kernels of `instructionSet`, like a crop
+// rotated by a multiple of a right angle.
+void BM_OrientPixels(benchmark::State &state, RSKImageOrientation orientation, SimdInstructionSet instructionSet)
+{
+    if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+        state.SkipWithError("The instruction set is not supported.");
+        return;
+    }
+
+    QuarterTurnBitmaps bitmaps(orientation);
+    const rsk::OrientKernels &kernels = rsk::GetOrientKernels(instructionSet, rsk::ComponentType::UInt8);
+    for (auto _ : state) {
+        rsk::OrientPixels(bitmaps.source, orientation, kernels, bitmaps.destination);
+        benchmark::DoNotOptimize(bitmaps.destination.data);
+        benchmark::ClobberMemory();
+    }
+    SetBytesPerSecond(state);
+}
+
+// Turns the photo like `BM_OrientPixels`, but samples every pixel with the generic warp, which is what a right angle
+// cost before it was copied.
+void BM_WarpPixels(benchmark::State &state, RSKImageOrientation orientation)
+{
+    QuarterTurnBitmaps bitmaps(orientation);
+    const CGAffineTransform transform = rsk::OrientationTransform(orientation, kSourceWidth, kSourceHeight);
+    for (auto _ : state) {
+        rsk::WarpBitmap(bitmaps.source, transform, RSKResamplingFilterBilinear, nullptr, bitmaps.destination);
+        benchmark::DoNotOptimize(bitmaps.destination.data);
+        benchmark::ClobberMemory();
+    }
+    SetBytesPerSecond(state);
+}
+
+BENCHMARK_CAPTURE(BM_OrientPixels, Right/Scalar, RSKImageOrientationRight, SimdInstructionSet::Scalar)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Right/SSE41, RSKImageOrientationRight, SimdInstructionSet::SSE41)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Right/AVX2, RSKImageOrientationRight, SimdInstructionSet::AVX2)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Right/NEON, RSKImageOrientationRight, SimdInstructionSet::NEON)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Down/Scalar, RSKImageOrientationDown, SimdInstructionSet::Scalar)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Down/SSE41, RSKImageOrientationDown, SimdInstructionSet::SSE41)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Down/AVX2, RSKImageOrientationDown, SimdInstructionSet::AVX2)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_OrientPixels, Down/NEON, RSKImageOrientationDown, SimdInstructionSet::NEON)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_WarpPixels, Right, RSKImageOrientationRight)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_WarpPixels, Down, RSKImageOrientationDown)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,444 @@
+//
+// RSKSweepBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKCropEngine.h"
+#include "RSKCropGeometry.h"
+#include "RSKGeometryBatch.h"
+#include "RSKThreadPool.h"
+
+// Sweeps of the crop and of the geometry of the image crop view controller, whose names spell out every parameter, so
+// that the results of two runs can be compared benchmark by benchmark.
+//
+// By default the crop sweep varies one parameter at a time around a tilted, masked circle crop of a 12 MP photo on one
+// thread. Setting `RSK_BENCHMARK_SWEEP=full` in the environment registers every combination of the parameters instead,
+// which takes hours; select a part of it with `--benchmark_filter`.
+
+namespace {
+
+enum class Rotation {
+    Upright,
+    QuarterTurn,
+    Tilted
+};
+
+struct CropSweepParameters {
+    RSKCropMode cropMode;
+    Rotation rotation;
+    RSKImageOrientation imageOrientation;
+    bool appliesMask;
+    size_t megapixels;
+    RSKPixelFormat pixelFormat;
+    size_t threadCount;
+};
+
+// The values of every parameter of the sweep, and the ones of the baseline that the default sweep varies.
+constexpr RSKCropMode kCropModes[] = { RSKCropModeCircle, RSKCropModeSquare, RSKCropModeCustom };
+constexpr Rotation kRotations[] = { Rotation::Upright, Rotation::QuarterTurn, Rotation::Tilted };
+constexpr RSKImageOrientation kImageOrientations[] = {
+    RSKImageOrientationUp, RSKImageOrientationDown, RSKImageOrientationLeft, RSKImageOrientationRight,
+    RSKImageOrientationUpMirrored, RSKImageOrientationDownMirrored, RSKImageOrientationLeftMirrored, RSKImageOrientationRightMirrored,
+};
+constexpr bool kAppliesMasks[] = { false, true };
+constexpr size_t kMegapixels[] = { 1, 12, 24, 48, 100 };
+constexpr RSKPixelFormat kPixelFormats[] = { RSKPixelFormatRGBA8888, RSKPixelFormatRGBA16, RSKPixelFormatRGBAHalf };
+constexpr size_t kThreadCounts[] = { 1, 2, 4, 8 };
+
+constexpr CropSweepParameters kBaseline = { RSKCropModeCircle, Rotation::Tilted, RSKImageOrientationUp, true, 12, RSKPixelFormatRGBA8888, 1 };
+
+// The angle of a tilted crop, about 17 degrees.
+constexpr double kTiltAngle = 0.3;
+
+// The crop takes a square of this fraction of the shorter side of the oriented source.
+constexpr double kCropFraction = 0.6;
+
+// The control points of the cubic Bézier curves that approximate a quarter of a circle.
+constexpr double kCircleControlPointDistance = 0.5522847498;
+
+const char *CropModeName(RSKCropMode cropMode)
+{
+    static const char *const names[] = { "Circle", "Square", "Custom" };
+    return names[cropMode];
+}
+
+const char *RotationName(Rotation rotation)
+{
+    static const char *const names[] = { "Upright", "QuarterTurn", "Tilted" };
+    return names[static_cast<int>(rotation)];
+}
+
+const char *ImageOrientationName(RSKImageOrientation imageOrientation)
+{
+    static const char *const names[] = { "Up", "Down", "Left", "Right", "UpMirrored", "DownMirrored", "LeftMirrored", "RightMirrored" };
+    return names[imageOrientation];
+}
+
+const char *PixelFormatName(RSKPixelFormat pixelFormat)
+{
+    switch (pixelFormat) {
+        case RSKPixelFormatRGBA16:
+            return "RGBA16";
+        case RSKPixelFormatRGBAHalf:
+            return "RGBAHalf";
+        default:
+            return "RGBA8888";
+    }
+}
+
+std::string CropSweepName(const CropSweepParameters &parameters)
+{
+    return std::string("BM_CropSweep/") + CropModeName(parameters.cropMode) + "/" + RotationName(parameters.rotation) + "/" +
+           ImageOrientationName(parameters.imageOrientation) + "/" + (parameters.appliesMask ? "Masked" : "Unmasked") + "/" +
+           std::to_string(parameters.megapixels) + "MP/" + PixelFormatName(parameters.pixelFormat) + "/threads:" + std::to_string(parameters.threadCount);
+}
+
+std::vector<RSKPathElement> MakeMaskPath(RSKCropMode cropMode, CGRect rect)
+{
+    if (cropMode == RSKCropModeSquare) {
+        return {
+            { RSKPathElementTypeMoveToPoint, { { CGRectGetMinX(rect), CGRectGetMinY(rect) } } },
+            { RSKPathElementTypeAddLineToPoint, { { CGRectGetMaxX(rect), CGRectGetMinY(rect) } } },
+            { RSKPathElementTypeAddLineToPoint, { { CGRectGetMaxX(rect), CGRectGetMaxY(rect) } } },
+            { RSKPathElementTypeAddLineToPoint, { { CGRectGetMinX(rect), CGRectGetMaxY(rect) } } },
+            { RSKPathElementTypeCloseSubpath, {} },
+        };
+    }
+    if (cropMode == RSKCropModeCustom) {
+        return {
+            { RSKPathElementTypeMoveToPoint, { { CGRectGetMidX(rect), CGRectGetMinY(rect) } } },
+            { RSKPathElementTypeAddLineToPoint, { { CGRectGetMaxX(rect), CGRectGetMaxY(rect) } } },
+            { RSKPathElementTypeAddLineToPoint, { { CGRectGetMinX(rect), CGRectGetMaxY(rect) } } },
+            { RSKPathElementTypeCloseSubpath, {} },
+        };
+    }
+
+    const double midX = CGRectGetMidX(rect);
+    const double midY = CGRectGetMidY(rect);
+    const double radiusX = rect.size.width / 2;
+    const double radiusY = rect.size.height / 2;
+    const double controlX = radiusX * kCircleControlPointDistance;
+    const double controlY = radiusY * kCircleControlPointDistance;
+    return {
+        { RSKPathElementTypeMoveToPoint, { { midX + radiusX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + radiusX, midY + controlY }, { midX + controlX, midY + radiusY }, { midX, midY + radiusY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - controlX, midY + radiusY }, { midX - radiusX, midY + controlY }, { midX - radiusX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - radiusX, midY - controlY }, { midX - controlX, midY - radiusY }, { midX, midY - radiusY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + controlX, midY - radiusY }, { midX + radiusX, midY - controlY }, { midX + radiusX, midY } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// The source of the crops of the sweep. Only the last one is kept, since one of 100 MP with 16-bit components takes
+// 800 MB, and the sweep is registered so that crops of the same source follow each other.
+class SweepSource {
+public:
+    static const RSKBitmap &Get(size_t megapixels, RSKPixelFormat pixelFormat)
+    {
+        static SweepSource source;
+        if (source.megapixels_ != megapixels || source.pixelFormat_ != pixelFormat) {
+            source.Make(megapixels, pixelFormat);
+        }
+        return source.bitmap_;
+    }
+
+private:
+    // Makes a photo of 4:3 with opaque pixels that change from one to the next, converted from 8-bit components to
+    // `pixelFormat`.
+    void Make(size_t megapixels, RSKPixelFormat pixelFormat)
+    {
+        pixels_ = std::vector<uint8_t>();
+        const size_t width = static_cast<size_t>(std::lround(std::sqrt(megapixels * 1e6 * 4 / 3)));
+        const size_t height = width * 3 / 4;
+        std::vector<uint8_t> pixels(width * height * 4);
+        for (size_t i = 0; i < pixels.size(); i += 4) {
+            pixels[i + 0] = static_cast<uint8_t>(i * 7 % 251);
+            pixels[i + 1] = static_cast<uint8_t>(i * 3 % 241);
+            pixels[i + 2] = static_cast<uint8_t>(i % 239);
+            pixels[i + 3] = 255;
+        }
+        RSKBitmap bitmap = RSKBitmapMake(pixels.data(), width, height, width * 4, RSKPixelFormatRGBA8888);
+        if (pixelFormat != RSKPixelFormatRGBA8888) {
+            const size_t bytesPerRow = width * RSKPixelFormatGetBytesPerPixel(pixelFormat);
+            std::vector<uint8_t> convertedPixels(bytesPerRow * height);
+            RSKBitmap convertedBitmap = RSKBitmapMake(convertedPixels.data(), width, height, bytesPerRow, pixelFormat);
+            RSKCropEngineConvertBitmap(&bitmap, &convertedBitmap);
+            pixels.swap(convertedPixels);
+            bitmap = convertedBitmap;
+        }
+        pixels_ = std::move(pixels);
+        bitmap_ = bitmap;
+        megapixels_ = megapixels;
+        pixelFormat_ = pixelFormat;
+    }
+
+    std::vector<uint8_t> pixels_;
+    RSKBitmap bitmap_ = {};
+    size_t megapixels_ = 0;
+    RSKPixelFormat pixelFormat_ = RSKPixelFormatRGBA8888;
+};
+
+// Crops a centered square of the oriented source with the parameters of the sweep and reports megapixels of the result
+// per second.
+void BM_CropSweep(benchmark::State &state, CropSweepParameters parameters)
+{
+    const RSKBitmap &source = SweepSource::Get(parameters.megapixels, parameters.pixelFormat);
+    const bool swapsAxes = parameters.imageOrientation == RSKImageOrientationLeft || parameters.imageOrientation == RSKImageOrientationRight ||
+                           parameters.imageOrientation == RSKImageOrientationLeftMirrored || parameters.imageOrientation == RSKImageOrientationRightMirrored;
+    const double orientedWidth = static_cast<double>(swapsAxes ? source.height : source.width);
+    const double orientedHeight = static_cast<double>(swapsAxes ? source.width : source.height);
+    const double side = std::floor(std::fmin(orientedWidth, orientedHeight) * kCropFraction);
+
+    // The mask path is in the pixels of the crop, so the zoom scale is 1.
+    const std::vector<RSKPathElement> maskPath = MakeMaskPath(parameters.cropMode, CGRectMake(0, 0, side, side));
+    RSKCropSpec spec = {};
+    spec.cropMode = parameters.cropMode;
+    spec.cropRect = CGRectMake(std::floor((orientedWidth - side) / 2), std::floor((orientedHeight - side) / 2), side, side);
+    spec.imageRect = CGRectMake(0, 0, source.width, source.height);
+    spec.rotationAngle = parameters.rotation == Rotation::Tilted ? kTiltAngle : parameters.rotation == Rotation::QuarterTurn ? M_PI_2 : 0;
+    spec.zoomScale = 1;
+    spec.imageOrientation = parameters.imageOrientation;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = parameters.appliesMask;
+
+    const CGSize outputSize = RSKCropEngineGetOutputSize(source.width, source.height, &spec);
+    const size_t width = static_cast<size_t>(outputSize.width);
+    const size_t height = static_cast<size_t>(outputSize.height);
+    const size_t bytesPerRow = width * RSKPixelFormatGetBytesPerPixel(parameters.pixelFormat);
+    std::vector<uint8_t> destinationPixels(bytesPerRow * height);
+    RSKBitmap destination = RSKBitmapMake(destinationPixels.data(), width, height, bytesPerRow, parameters.pixelFormat);
+
+    RSKThreadPool *pool = parameters.threadCount > 1 ? RSKThreadPoolCreate(parameters.threadCount) : nullptr;
+    if (parameters.threadCount > 1 && !pool) {
+        state.SkipWithError("The thread pool cannot be created.");
+        return;
+    }
+    const RSKExecutor executor = pool ? RSKThreadPoolGetExecutor(pool) : RSKExecutor{};
+
+    for (auto _ : state) {
+        if (RSKCropEngineCropBitmapWithExecutor(&source, &spec, pool ? &executor : nullptr, &destination) != RSKCropStatusSuccess) {
+            state.SkipWithError("The crop failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(destinationPixels.data());
+        benchmark::ClobberMemory();
+    }
+    if (pool) {
+        RSKThreadPoolDestroy(pool);
+    }
+
+    state.counters["MP/s"] = benchmark::Counter(width * height / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void RegisterCropSweepBenchmark(const CropSweepParameters &parameters)
+{
+    benchmark::RegisterBenchmark(CropSweepName(parameters).c_str(), BM_CropSweep, parameters)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+// Registers every combination of the parameters, grouped by source.
+void RegisterFullCropSweep()
+{
+    for (size_t megapixels : kMegapixels) {
+        for (RSKPixelFormat pixelFormat : kPixelFormats) {
+            for (RSKCropMode cropMode : kCropModes) {
+                for (Rotation rotation : kRotations) {
+                    for (RSKImageOrientation imageOrientation : kImageOrientations) {
+                        for (bool appliesMask : kAppliesMasks) {
+                            for (size_t threadCount : kThreadCounts) {
+                                RegisterCropSweepBenchmark({ cropMode, rotation, imageOrientation, appliesMask, megapixels, pixelFormat, threadCount });
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Registers the baseline and every variation of one of its parameters, grouped by source.
+void RegisterCropSweep()
+{
+    RegisterCropSweepBenchmark(kBaseline);
+    for (RSKCropMode cropMode : kCropModes) {
+        if (cropMode != kBaseline.cropMode) {
+            RegisterCropSweepBenchmark({ cropMode, kBaseline.rotation, kBaseline.imageOrientation, kBaseline.appliesMask, kBaseline.megapixels, kBaseline.pixelFormat, kBaseline.threadCount });
+        }
+    }
+    for (Rotation rotation : kRotations) {
+        if (rotation != kBaseline.rotation) {
+            RegisterCropSweepBenchmark({ kBaseline.cropMode, rotation, kBaseline.imageOrientation, kBaseline.appliesMask, kBaseline.megapixels, kBaseline.pixelFormat, kBaseline.threadCount });
+        }
+    }
+    for (RSKImageOrientation imageOrientation : kImageOrientations) {
+        if (imageOrientation != kBaseline.imageOrientation) {
+            RegisterCropSweepBenchmark({ kBaseline.cropMode, kBaseline.rotation, imageOrientation, kBaseline.appliesMask, kBaseline.megapixels, kBaseline.pixelFormat, kBaseline.threadCount });
+        }
+    }
+    for (bool appliesMask : kAppliesMasks) {
+        if (appliesMask != kBaseline.appliesMask) {
+            RegisterCropSweepBenchmark({ kBaseline.cropMode, kBaseline.rotation, kBaseline.imageOrientation, appliesMask, kBaseline.megapixels, kBaseline.pixelFormat, kBaseline.threadCount });
+        }
+    }
+    for (size_t threadCount : kThreadCounts) {
+        if (threadCount != kBaseline.threadCount) {
+            RegisterCropSweepBenchmark({ kBaseline.cropMode, kBaseline.rotation, kBaseline.imageOrientation, kBaseline.appliesMask, kBaseline.megapixels, kBaseline.pixelFormat, threadCount });
+        }
+    }
+    for (RSKPixelFormat pixelFormat : kPixelFormats) {
+        if (pixelFormat != kBaseline.pixelFormat) {
+            RegisterCropSweepBenchmark({ kBaseline.cropMode, kBaseline.rotation, kBaseline.imageOrientation, kBaseline.appliesMask, kBaseline.megapixels, pixelFormat, kBaseline.threadCount });
+        }
+    }
+    for (size_t megapixels : kMegapixels) {
+        if (megapixels != kBaseline.megapixels) {
+            RegisterCropSweepBenchmark({ kBaseline.cropMode, kBaseline.rotation, kBaseline.imageOrientation, kBaseline.appliesMask, megapixels, kBaseline.pixelFormat, kBaseline.threadCount });
+        }
+    }
+}
+
+// The functions of `CGGeometry+RSKImageCropper` that have a portable counterpart in the core, which is what the sweep
+// measures on every platform.
+enum class GeometryFunction {
+    RectNormalize,
+    RectScaleAroundPoint,
+    RectCoveringScale,
+    PointRotateAroundPoint,
+    LineSegmentRotateAroundPoint,
+    LineSegmentIntersection
+};
+
+constexpr GeometryFunction kGeometryFunctions[] = {
+    GeometryFunction::RectNormalize, GeometryFunction::RectScaleAroundPoint, GeometryFunction::RectCoveringScale,
+    GeometryFunction::PointRotateAroundPoint, GeometryFunction::LineSegmentRotateAroundPoint, GeometryFunction::LineSegmentIntersection,
+};
+
+// The numbers of elements, from a single one, like a call of the function, to the points of a detailed mask path.
+constexpr size_t kGeometryCounts[] = { 1, 64, 4096 };
+
+const char *GeometryFunctionName(GeometryFunction function)
+{
+    static const char *const names[] = {
+        "RSKRectNormalize", "RSKRectScaleAroundPoint", "RSKRectCoveringScale", "RSKPointRotateAroundPoint", "RSKLineSegmentRotateAroundPoint", "RSKLineSegmentIntersection",
+    };
+    return names[static_cast<int>(function)];
+}
+
+// Coordinates of rects and of the ends of segments that do not repeat, like the ones of a gesture.
+std::vector<CGFloat> MakeCoordinates(size_t count, double offset)
+{
+    std::vector<CGFloat> coordinates(count);
+    for (size_t i = 0; i < count; i++) {
+        coordinates[i] = static_cast<CGFloat>(offset + std::fmod(i * 37.37, 400.0) + 0.25 * (i % 7));
+    }
+    return coordinates;
+}
+
+// Applies `function` to `state.range(0)` elements and reports elements per second.
+void BM_GeometrySweep(benchmark::State &state, GeometryFunction function)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<CGFloat> x = MakeCoordinates(count, 0.1);
+    std::vector<CGFloat> y = MakeCoordinates(count, 20.3);
+    std::vector<CGFloat> width = MakeCoordinates(count, 100.7);
+    std::vector<CGFloat> height = MakeCoordinates(count, 50.9);
+    std::vector<CGFloat> resultX(count);
+    std::vector<CGFloat> resultY(count);
+    std::vector<CGFloat> resultWidth(count);
+    std::vector<CGFloat> resultHeight(count);
+    const RSKRectArray rects = { x.data(), y.data(), width.data(), height.data() };
+    const RSKRectArray resultRects = { resultX.data(), resultY.data(), resultWidth.data(), resultHeight.data() };
+    const RSKPointArray points = { x.data(), y.data() };
+    const RSKPointArray otherPoints = { width.data(), height.data() };
+    const RSKPointArray resultPoints = { resultX.data(), resultY.data() };
+    const RSKPointArray otherResultPoints = { resultWidth.data(), resultHeight.data() };
+    const CGPoint pivot = CGPointMake(187.5, 333.5);
+    const CGFloat angle = static_cast<CGFloat>(kTiltAngle);
+
+    // Like `RSKRectScaleAroundPoint`: translate the point to the origin, scale, and translate it back.
+    const CGAffineTransform scaleTransform = CGAffineTransformMake(1.5, 0, 0, 0.75, pivot.x - 1.5 * pivot.x, pivot.y - 0.75 * pivot.y);
+
+    for (auto _ : state) {
+        switch (function) {
+            case GeometryFunction::RectNormalize:
+                RSKRectArrayNormalize(rects, count, resultRects);
+                break;
+            case GeometryFunction::RectScaleAroundPoint:
+                RSKRectArrayApplyAffineTransform(rects, count, scaleTransform, resultRects);
+                break;
+            case GeometryFunction::RectCoveringScale:
+                for (size_t i = 0; i < count; i++) {
+                    resultX[i] = RSKCropGeometryGetCoveringScale(CGSizeMake(width[i], height[i]), x[i]);
+                }
+                break;
+            case GeometryFunction::PointRotateAroundPoint:
+                RSKPointArrayRotateAroundPoint(points, count, pivot, angle, resultPoints);
+                break;
+            case GeometryFunction::LineSegmentRotateAroundPoint:
+                RSKPointArrayRotateAroundPoint(points, count, pivot, angle, resultPoints);
+                RSKPointArrayRotateAroundPoint(otherPoints, count, pivot, angle, otherResultPoints);
+                break;
+            case GeometryFunction::LineSegmentIntersection:
+                RSKLineSegmentArrayIntersect({ points, otherPoints }, { otherPoints, points }, count, resultPoints);
+                break;
+        }
+        benchmark::DoNotOptimize(resultX.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["elements/s"] = benchmark::Counter(static_cast<double>(count), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void RegisterGeometrySweep()
+{
+    for (GeometryFunction function : kGeometryFunctions) {
+        auto *benchmark = benchmark::RegisterBenchmark((std::string("BM_GeometrySweep/") + GeometryFunctionName(function)).c_str(), BM_GeometrySweep, function)->ArgName("count");
+        for (size_t count : kGeometryCounts) {
+            benchmark->Arg(static_cast<int64_t>(count));
+        }
+    }
+}
+
+bool RegisterSweeps()
+{
+    const char *sweep = std::getenv("RSK_BENCHMARK_SWEEP");
+    if (sweep && std::strcmp(sweep, "full") == 0) {
+        RegisterFullCropSweep();
+    } else {
+        RegisterCropSweep();
+    }
+    RegisterGeometrySweep();
+    return true;
+}
+
+// Registers the sweeps before `main` runs, like the `BENCHMARK` macros do.
+const bool kAreSweepsRegistered = RegisterSweeps();
+
+} // namespace
@@ -0,0 +1,108 @@
+//
+// RSKWarpKernelsBenchmarks.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "RSKWarpKernels.hpp"
+
+namespace {
+
+using rsk::SimdInstructionSet;
+
+constexpr size_t kSourceSize = 2048;
+constexpr size_t kDestinationSize = 2048;
+
+// Rotates a 4 MP source by a small angle, like a crop with a custom rotation angle, and reports megapixels per second.
+void BM_WarpRow(benchmark::State &state, RSKResamplingFilter filter, SimdInstructionSet instructionSet)
+{
+    if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+        state.SkipWithError("The instruction set is not supported.");
+        return;
+    }
+
+    std::vector<uint8_t> sourcePixels(kSourceSize * kSourceSize * rsk::kBytesPerPixel);
+    for (size_t i = 0; i < sourcePixels.size(); i++) {
+        sourcePixels[i] = static_cast<uint8_t>(i * 7 % 251);
+    }
+    rsk::BitmapView source;
+    source.data = sourcePixels.data();
+    source.width = kSourceSize;
+    source.height = kSourceSize;
+    source.bytesPerRow = kSourceSize * rsk::kBytesPerPixel;
+
+    std::vector<uint8_t> row(kDestinationSize * rsk::kBytesPerPixel);
+    const rsk::WarpRowKernel kernel = rsk::GetWarpRowKernel(filter, instructionSet);
+    const double angle = 0.3;
+    const double cosine = std::cos(angle);
+    const double sine = std::sin(angle);
+    const double center = kSourceSize * 0.5;
+
+    for (auto _ : state) {
+        for (size_t y = 0; y < kDestinationSize; y++) {
+            const double dx = -center;
+            const double dy = y - center;
+            kernel(source, cosine * dx + sine * dy + center, -sine * dx + cosine * dy + center, cosine, -sine, kDestinationSize, row.data());
+        }
+        benchmark::DoNotOptimize(row.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double pixels = static_cast<double>(kDestinationSize * kDestinationSize);
+    state.counters["MP/s"] = benchmark::Counter(pixels / 1e6, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void RegisterWarpRowBenchmarks()
+{
+    const RSKResamplingFilter filters[] = { RSKResamplingFilterNearest, RSKResamplingFilterBilinear, RSKResamplingFilterBicubic, RSKResamplingFilterLanczos3 };
+    const char *filterNames[] = { "Nearest", "Bilinear", "Bicubic", "Lanczos3" };
+    const SimdInstructionSet instructionSets[] = { SimdInstructionSet::Scalar, SimdInstructionSet::SSE41, SimdInstructionSet::AVX2, SimdInstructionSet::NEON };
+
+    for (SimdInstructionSet instructionSet : instructionSets) {
+        if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+            continue;
+        }
+        for (size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++) {
+            std::string name = std::string("BM_WarpRow/") + filterNames[i] + "/" + rsk::SimdInstructionSetName(instructionSet);
+            benchmark::RegisterBenchmark(name.c_str(), BM_WarpRow, filters[i], instructionSet)->Unit(benchmark::kMillisecond);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    RegisterWarpRowBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# compare_benchmarks.py
+#
+# Copyright © 2026-present Ruslan Skorb. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+"""Compares the JSON results of RSKImageCropperCoreBenchmarks with a stored baseline.
+
+Every benchmark is judged by the fastest of its repetitions, which is the one least disturbed by the rest of the
+machine. A benchmark that takes longer than the baseline by more than the threshold is a regression, and makes the
+script exit with status 1. Benchmarks that are only in one of the files are listed but do not fail the comparison.
+
+    RSKImageCropperCoreBenchmarks --benchmark_repetitions=5 --benchmark_out=results.json --benchmark_out_format=json
+    compare_benchmarks.py Baselines/Linux-x86_64.json results.json
+
+With --update, the results replace the baseline instead, keeping only the times and a description of the machine.
+Benchmarks that run on more threads than the machine has cores are left out of a baseline, since they only measure
+threads taking turns on the same cores.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+# The factors that convert the time units of Google Benchmark to nanoseconds.
+NANOSECONDS_PER_UNIT = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+# The fields of the context of the results that describe the machine, which are kept in a baseline.
+MACHINE_FIELDS = ("num_cpus", "mhz_per_cpu", "cpu_scaling_enabled", "caches", "library_build_type")
+
+
+def read_times(path):
+    """Returns the context of the results in `path` and the fastest time, in nanoseconds, of every benchmark."""
+    with open(path, encoding="utf-8") as file:
+        results = json.load(file)
+
+    times = {}
+    for benchmark in results.get("benchmarks", []):
+        # Aggregates, like the mean of the repetitions, are skipped in favor of the repetitions themselves.
+        if benchmark.get("run_type") == "aggregate" or benchmark.get("error_occurred") or benchmark.get("skipped"):
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        time = benchmark["real_time"] * NANOSECONDS_PER_UNIT[benchmark.get("time_unit", "ns")]
+        times[name] = min(time, times.get(name, time))
+    return results.get("context", {}), times
+
+
+def thread_count(name):
+    """Returns the number of threads in the name of a benchmark, like "threads:4", or 1 if it has none."""
+    match = re.search(r"/threads:(\d+)", name)
+    return int(match.group(1)) if match else 1
+
+
+def write_baseline(path, context, times):
+    core_count = context.get("num_cpus", 1)
+    benchmarks = [{"name": name, "real_time": time, "time_unit": "ns"} for name, time in times.items() if thread_count(name) <= core_count]
+    baseline = {"context": {field: context[field] for field in MACHINE_FIELDS if field in context}, "benchmarks": benchmarks}
+    with open(path, "w", encoding="utf-8") as file:
+        json.dump(baseline, file, indent=2)
+        file.write("\n")
+    return len(benchmarks)
+
+
+def format_time(nanoseconds):
+    for unit in ("s", "ms", "us"):
+        if nanoseconds >= NANOSECONDS_PER_UNIT[unit]:
+            return "%.3g %s" % (nanoseconds / NANOSECONDS_PER_UNIT[unit], unit)
+    return "%.3g ns" % nanoseconds
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="the stored baseline, or any earlier results")
+    parser.add_argument("results", help="the JSON written by --benchmark_out")
+    parser.add_argument("--threshold", type=float, default=0.10, help="the slowdown that is a regression (default: 0.10, that is 10%%)")
+    parser.add_argument("--update", action="store_true", help="write the results into the baseline instead of comparing them")
+    arguments = parser.parse_args()
+
+    context, times = read_times(arguments.results)
+    if arguments.update:
+        written_count = write_baseline(arguments.baseline, context, times)
+        print("Wrote %d benchmarks to %s." % (written_count, arguments.baseline))
+        if written_count < len(times):
+            print("Left out %d benchmarks that run on more threads than the machine has cores (%d)." % (len(times) - written_count, context.get("num_cpus", 1)))
+        return 0
+
+    _, baseline_times = read_times(arguments.baseline)
+    regressions = []
+    improvements = []
+    for name in sorted(set(times) & set(baseline_times)):
+        change = times[name] / baseline_times[name] - 1
+        line = "%-100s %10s -> %10s %+7.1f%%" % (name, format_time(baseline_times[name]), format_time(times[name]), change * 100)
+        if change > arguments.threshold:
+            regressions.append(line)
+        elif change < -arguments.threshold:
+            improvements.append(line)
+
+    for title, names in (("Not in the baseline", set(times) - set(baseline_times)), ("Not in the results", set(baseline_times) - set(times))):
+        if names:
+            print("%s:" % title)
+            for name in sorted(names):
+                print("  " + name)
+    if improvements:
+        print("Faster by more than %.0f%%:" % (arguments.threshold * 100))
+        for line in improvements:
+            print("  " + line)
+    if regressions:
+        print("Regressions, slower by more than %.0f%%:" % (arguments.threshold * 100))
+        for line in regressions:
+            print("  " + line)
+        return 1
+
+    print("No regressions in %d benchmarks." % len(set(times) & set(baseline_times)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -10,15 +10,25 @@ let package = Package(
         .library(
             name: "RSKImageCropper",
             targets: ["RSKImageCropper"]),
+        .library(
+            name: "RSKImageCropperCore",
+            targets: ["RSKImageCropperCore"]),
     ],
     targets: [
+        .target(
+            name: "RSKImageCropperCore",
+            path: "RSKImageCropperCore",
+            publicHeadersPath: "include"
+        ),
         .target(
             name: "RSKImageCropper",
+            dependencies: ["RSKImageCropperCore"],
             path: "RSKImageCropper",
             resources: [
                 .copy("RSKImageCropperStrings.bundle")
             ],
             publicHeadersPath: "include"
         ),
-    ]
+    ],
+    cxxLanguageStandard: .cxx17
 )
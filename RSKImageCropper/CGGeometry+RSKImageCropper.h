@@ -95,10 +95,15 @@ CGRect RSKRectNormalize(CGRect rect);
 // Returns the `rect` scaled around the `point` by `sx` and `sy`.
 CGRect RSKRectScaleAroundPoint(CGRect rect, CGPoint point, CGFloat sx, CGFloat sy);
 
+// Returns the factor by which the `rect` must be scaled around its center so that,
+// rotated by `angle` around its center, it still covers the unscaled `rect`.
+CGFloat RSKRectCoveringScale(CGRect rect, CGFloat angle);
+
 // Returns true if `point' is the null point, false otherwise.
 bool RSKPointIsNull(CGPoint point);
 
 // Returns the `point` rotated around the `pivot` by `angle`.
+// To rotate many points, use `RSKPointArrayRotateAroundPoint`.
 CGPoint RSKPointRotateAroundPoint(CGPoint point, CGPoint pivot, CGFloat angle);
 
 // Returns the distance between two points.
@@ -23,6 +23,7 @@
 //
 
 #import "CGGeometry+RSKImageCropper.h"
+#import <RSKImageCropperCore/RSKCropGeometry.h>
 
 // K is a constant such that the accumulated error of our floating-point computations is definitely bounded by K units in the last place.
 #ifdef CGFLOAT_IS_DOUBLE
@@ -90,6 +91,11 @@ CGRect RSKRectScaleAroundPoint(CGRect rect, CGPoint point, CGFloat sx, CGFloat s
     return rect;
 }
 
+CGFloat RSKRectCoveringScale(CGRect rect, CGFloat angle)
+{
+    return RSKCropGeometryGetCoveringScale(rect.size, angle);
+}
+
 bool RSKPointIsNull(CGPoint point)
 {
     return CGPointEqualToPoint(point, RSKPointNull);
@@ -97,21 +103,18 @@ bool RSKPointIsNull(CGPoint point)
 
 CGPoint RSKPointRotateAroundPoint(CGPoint point, CGPoint pivot, CGFloat angle)
 {
-    CGAffineTransform translationTransform, rotationTransform;
-    translationTransform = CGAffineTransformMakeTranslation(-pivot.x, -pivot.y);
-    point = CGPointApplyAffineTransform(point, translationTransform);
-    rotationTransform = CGAffineTransformMakeRotation(angle);
-    point = CGPointApplyAffineTransform(point, rotationTransform);
-    translationTransform = CGAffineTransformMakeTranslation(pivot.x, pivot.y);
-    point = CGPointApplyAffineTransform(point, translationTransform);
-    return point;
+    CGFloat sine = sin(angle);
+    CGFloat cosine = cos(angle);
+    CGFloat dx = point.x - pivot.x;
+    CGFloat dy = point.y - pivot.y;
+    return CGPointMake(pivot.x + cosine * dx - sine * dy, pivot.y + sine * dx + cosine * dy);
 }
 
 CGFloat RSKPointDistance(CGPoint p1, CGPoint p2)
 {
     CGFloat dx = p1.x - p2.x;
     CGFloat dy = p1.y - p2.y;
-    return sqrt(pow(dx, 2) + pow(dy, 2));
+    return sqrt(dx * dx + dy * dy);
 }
 
 RSKLineSegment RSKLineSegmentMake(CGPoint start, CGPoint end)
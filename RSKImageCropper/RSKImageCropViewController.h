@@ -154,6 +154,13 @@ NS_SWIFT_UI_ACTOR
  */
 @property (readonly, nonatomic) CGFloat zoomScale;
 
+/**
+ The crop recipe of the last cropped image in the binary format of `RSKCropRecipeWrite`, or `nil` if no image has been cropped yet.
+ 
+ @discussion The value is set before `imageCropViewController:didCropImage:usingCropRect:rotationAngle:` is sent. `RSKCropEngineCropRecipe` replays it on the pixels of the original image without a view controller, at any output size.
+ */
+@property (copy, readonly, nonatomic, nullable) NSData *cropRecipe;
+
 /**
  A Boolean value that determines whether the image will always fill the mask space. Default value is `NO`.
  */
@@ -174,6 +181,11 @@ NS_SWIFT_UI_ACTOR
  */
 @property (assign, nonatomic) BOOL applyMaskToCroppedImage;
 
+/**
+ The size, in points, that the cropped image is scaled to, like the size of an avatar. The image is cropped straight into that size without cropping it at full resolution first. Default value is `CGSizeZero`, which keeps the full resolution of the crop.
+ */
+@property (assign, nonatomic) CGSize croppedImageSize;
+
 /**
  A Boolean value that controls whether the image bounces past the edge of the movement rect and back again. Default value is `YES`.
  */
@@ -184,6 +196,16 @@ NS_SWIFT_UI_ACTOR
  */
 @property (assign, nonatomic) BOOL bouncesZoom;
 
+/**
+ A Boolean value that determines whether a smaller copy of the original image is shown while it is zoomed out, which keeps zooming a large photo smooth. Default value is `NO`.
+ */
+@property (assign, nonatomic) BOOL usesImagePyramid;
+
+/**
+ A Boolean value that determines whether only the tiles of the original image that are on the screen are drawn while it is zoomed in, which keeps zooming into a large photo sharp without drawing it as a whole. Default value is `NO`.
+ */
+@property (assign, nonatomic) BOOL usesTiledRendering;
+
 /**
  A Boolean value that controls whether the rotaion gesture is enabled. Default value is `NO`.
  
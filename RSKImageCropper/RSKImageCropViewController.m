@@ -27,12 +27,242 @@
 #import "RSKImageScrollView.h"
 #import "RSKImageScrollViewDelegate.h"
 #import "RSKInternalUtility.h"
-#import "UIImage+RSKImageCropper.h"
 #import "CGGeometry+RSKImageCropper.h"
+#import <RSKImageCropperCore/RSKImageCropperCore.h>
 
 static const CGFloat kResetAnimationDuration = 0.4;
 static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
 
+static const CGBitmapInfo kRSKBitmapInfo = kCGBitmapByteOrder32Big | kCGImageAlphaPremultipliedLast;
+
+// Runs a parallel loop of the crop engine on the concurrent queues of GCD.
+static void RSKDispatchParallelFor(void *executorContext, size_t count, void *context, RSKWorkFunction work)
+{
+    dispatch_apply_f(count, DISPATCH_APPLY_AUTO, context, work);
+}
+
+static void RSKPathElementsApply(void *info, const CGPathElement *element)
+{
+    NSMutableData *elements = (__bridge NSMutableData *)info;
+    
+    RSKPathElement pathElement = {};
+    pathElement.type = (RSKPathElementType)element->type;
+    switch (element->type) {
+        case kCGPathElementAddCurveToPoint:
+            pathElement.points[2] = element->points[2];
+        case kCGPathElementAddQuadCurveToPoint:
+            pathElement.points[1] = element->points[1];
+        case kCGPathElementMoveToPoint:
+        case kCGPathElementAddLineToPoint:
+            pathElement.points[0] = element->points[0];
+        case kCGPathElementCloseSubpath:
+            break;
+    }
+    [elements appendBytes:&pathElement length:sizeof(pathElement)];
+}
+
+// Returns the elements of `path` in the form the crop engine understands.
+static NSMutableData *RSKPathElementsCreate(UIBezierPath *path)
+{
+    NSMutableData *elements = [NSMutableData data];
+    if (path) {
+        CGPathApply(path.CGPath, (__bridge void *)elements, RSKPathElementsApply);
+    }
+    return elements;
+}
+
+// The pixels of a bitmap of the crop engine that an image is drawn into.
+typedef struct RSKBitmapLayout {
+    RSKPixelFormat pixelFormat;
+    size_t bitsPerComponent;
+    CGBitmapInfo bitmapInfo;
+    CGColorSpaceRef colorSpace;
+    // Whether the pixels are opaque, so that their alpha is skipped and they are drawn without blending.
+    BOOL isOpaque;
+} RSKBitmapLayout;
+
+// Returns the layout that keeps the depth and the color space of `imageRef`, so that a wide-gamut or a deep photo is
+// cropped without losing colors. Images with more than 8 bits per component are drawn with 16-bit components, or half
+// floats if theirs are floats, and images in any RGB color space, like Display P3, keep it. Release the color space of
+// the layout with `CGColorSpaceRelease`. The layout of an image without alpha is opaque.
+static RSKBitmapLayout RSKBitmapLayoutMakeWithImage(CGImageRef imageRef)
+{
+    RSKBitmapLayout layout = { RSKPixelFormatRGBA8888, 8, kRSKBitmapInfo, NULL };
+    if (CGImageGetBitmapInfo(imageRef) & kCGBitmapFloatComponents) {
+        layout = (RSKBitmapLayout){ RSKPixelFormatRGBAHalf, 16, kCGBitmapByteOrder16Host | kCGImageAlphaPremultipliedLast | kCGBitmapFloatComponents, NULL };
+    } else if (CGImageGetBitsPerComponent(imageRef) > 8) {
+        layout = (RSKBitmapLayout){ RSKPixelFormatRGBA16, 16, kCGBitmapByteOrder16Host | kCGImageAlphaPremultipliedLast, NULL };
+    }
+    
+    CGColorSpaceRef colorSpace = CGImageGetColorSpace(imageRef);
+    if (colorSpace && CGColorSpaceGetModel(colorSpace) == kCGColorSpaceModelRGB) {
+        layout.colorSpace = CGColorSpaceRetain(colorSpace);
+    } else {
+        layout.colorSpace = CGColorSpaceCreateDeviceRGB();
+    }
+    
+    CGImageAlphaInfo alphaInfo = CGImageGetAlphaInfo(imageRef);
+    layout.isOpaque = alphaInfo == kCGImageAlphaNone || alphaInfo == kCGImageAlphaNoneSkipFirst || alphaInfo == kCGImageAlphaNoneSkipLast;
+    return layout;
+}
+
+// Releases the pixels of an image created by `RSKImageCreateWithPooledBitmap`.
+static void RSKPooledBitmapRelease(void *info, __unused const void *data, __unused size_t size)
+{
+    RSKPixelOwnerRelease((RSKPixelOwner *)info);
+}
+
+// Returns an image of a bitmap of the shared buffer pool with `layout`, which takes over its reference to the owner and
+// returns the pixels to the pool once the image is freed. An opaque image skips the alpha of the pixels, so it is
+// composited and encoded without it.
+static CGImageRef RSKImageCreateWithPooledBitmap(RSKBorrowedBitmap *bitmap, RSKBitmapLayout layout)
+{
+    RSKBitmap pixels = bitmap->bitmap;
+    CGDataProviderRef dataProvider = CGDataProviderCreateWithData(bitmap->owner, pixels.data, pixels.bytesPerRow * pixels.height, RSKPooledBitmapRelease);
+    if (!dataProvider) {
+        RSKBorrowedBitmapRelease(bitmap);
+        return NULL;
+    }
+    *bitmap = (RSKBorrowedBitmap){};
+    CGBitmapInfo bitmapInfo = layout.bitmapInfo;
+    if (layout.isOpaque) {
+        bitmapInfo = (bitmapInfo & ~kCGBitmapAlphaInfoMask) | kCGImageAlphaNoneSkipLast;
+    }
+    CGImageRef image = CGImageCreate(pixels.width, pixels.height, layout.bitsPerComponent, 4 * layout.bitsPerComponent, pixels.bytesPerRow, layout.colorSpace, bitmapInfo, dataProvider, NULL, false, kCGRenderingIntentDefault);
+    CGDataProviderRelease(dataProvider);
+    return image;
+}
+
+// Draws `imageRef` into a bitmap of the shared buffer pool with `layout`. Returns false if there are no pixels or not
+// enough memory.
+static BOOL RSKPooledBitmapMakeWithImage(CGImageRef imageRef, size_t width, size_t height, RSKBitmapLayout layout, RSKBorrowedBitmap *bitmap)
+{
+    if (RSKBufferPoolMakeBitmap(RSKBufferPoolGetShared(), width, height, layout.pixelFormat, bitmap) != RSKCropStatusSuccess) {
+        return NO;
+    }
+    CGContextRef context = CGBitmapContextCreate(bitmap->bitmap.data, width, height, layout.bitsPerComponent, bitmap->bitmap.bytesPerRow, layout.colorSpace, layout.bitmapInfo);
+    if (!context) {
+        RSKBorrowedBitmapRelease(bitmap);
+        return NO;
+    }
+    // The pixels of the pool are not cleared, and transparent parts of the image are drawn over them. An opaque image
+    // covers all of them, so it replaces them without clearing and blending.
+    if (layout.isOpaque) {
+        CGContextSetBlendMode(context, kCGBlendModeCopy);
+    } else {
+        CGContextClearRect(context, CGRectMake(0.0, 0.0, width, height));
+    }
+    CGContextDrawImage(context, CGRectMake(0.0, 0.0, width, height), imageRef);
+    CGContextRelease(context);
+    return YES;
+}
+
+// Returns the crop of a source of `width` x `height` pixels drawn from `image`. The mask path is described by
+// `maskPathElements`, which must outlive the crop.
+static RSKCropSpec RSKCropSpecMake(RSKImageCropMode cropMode, CGRect cropRect, size_t width, size_t height, CGFloat rotationAngle, CGFloat zoomScale, UIImage *image, UIBezierPath *maskPath, NSData *maskPathElements, BOOL applyMaskToCroppedImage)
+{
+    // The engine works in pixels, so the zoom scale must also map the mask path to pixels.
+    RSKCropSpec spec = {};
+    spec.cropMode = (RSKCropMode)cropMode;
+    spec.cropRect = cropRect;
+    spec.imageRect = CGRectMake(0.0, 0.0, width, height);
+    spec.rotationAngle = rotationAngle;
+    spec.zoomScale = zoomScale / image.scale;
+    spec.imageOrientation = (RSKImageOrientation)image.imageOrientation;
+    spec.maskPath.elements = maskPathElements.bytes;
+    spec.maskPath.elementCount = maskPathElements.length / sizeof(RSKPathElement);
+    spec.maskPath.usesEvenOddFillRule = maskPath.usesEvenOddFillRule;
+    spec.applyMaskToCroppedImage = applyMaskToCroppedImage;
+    return spec;
+}
+
+// Returns the recipe of a crop of `image`, or of its first frame if it is animated, in the binary format. The image rect
+// of the recipe is in the pixels of the whole image, so that the recipe replays the crop on the original image.
+static NSData *RSKCropRecipeDataCreate(RSKImageCropMode cropMode, CGRect cropRect, CGRect imageRect, CGFloat rotationAngle, CGFloat zoomScale, UIImage *image, UIBezierPath *maskPath, BOOL applyMaskToCroppedImage, CGSize croppedImageSize)
+{
+    UIImage *frame = image.images.firstObject ?: image;
+    size_t width = CGImageGetWidth(frame.CGImage);
+    size_t height = CGImageGetHeight(frame.CGImage);
+    
+    NSMutableData *maskPathElements = RSKPathElementsCreate(maskPath);
+    RSKCropRecipe recipe = {};
+    recipe.sourceSize = CGSizeMake(width, height);
+    recipe.spec = RSKCropSpecMake(cropMode, cropRect, width, height, rotationAngle, zoomScale, frame, maskPath, maskPathElements, applyMaskToCroppedImage);
+    recipe.spec.imageRect = imageRect;
+    recipe.spec.outputSize = CGSizeMake(round(croppedImageSize.width * frame.scale), round(croppedImageSize.height * frame.scale));
+    
+    NSMutableData *data = [NSMutableData dataWithLength:RSKCropRecipeWrite(&recipe, RSKCropRecipeFormatBinary, NULL, 0)];
+    if (data.length == 0) {
+        return nil;
+    }
+    RSKCropRecipeWrite(&recipe, RSKCropRecipeFormatBinary, data.mutableBytes, data.length);
+    return data;
+}
+
+// The frames of an animated image that is being cropped.
+typedef struct RSKAnimatedImageCrop {
+    __unsafe_unretained NSArray<UIImage *> *frames;
+    __unsafe_unretained NSMutableArray<UIImage *> *croppedFrames;
+    CGRect imageRect;
+    CGFloat scale;
+    // The layout that the frames are drawn with, and the one of the cropped frames, which may not be opaque.
+    RSKBitmapLayout layout;
+    RSKBitmapLayout croppedLayout;
+} RSKAnimatedImageCrop;
+
+// Returns the pixels of a frame to the pool once it is cropped.
+static void RSKPooledFrameRelease(void *releaseContext, __unused const RSKBitmap *bitmap)
+{
+    RSKPixelOwnerRelease((RSKPixelOwner *)releaseContext);
+}
+
+// Draws a frame of an animated image into a bitmap of the shared buffer pool. Called on the threads of the executor.
+static bool RSKAnimatedImageCropDecode(void *context, size_t index, RSKBatchImage *frame)
+{
+    @autoreleasepool {
+        RSKAnimatedImageCrop *crop = context;
+        CGImageRef imageRef = CGImageCreateWithImageInRect(crop->frames[index].CGImage, crop->imageRect);
+        if (!imageRef) {
+            return false;
+        }
+        RSKBorrowedBitmap bitmap;
+        BOOL hasBitmap = RSKPooledBitmapMakeWithImage(imageRef, CGImageGetWidth(imageRef), CGImageGetHeight(imageRef), crop->layout, &bitmap);
+        CGImageRelease(imageRef);
+        if (!hasBitmap) {
+            return false;
+        }
+        frame->bitmap = bitmap.bitmap;
+        frame->release = RSKPooledFrameRelease;
+        frame->releaseContext = bitmap.owner;
+        return true;
+    }
+}
+
+// Appends a cropped frame to the frames of the cropped animated image. Frames are appended one at a time and in order.
+static bool RSKAnimatedImageCropWrite(void *context, size_t index, const RSKBitmap *croppedFrame)
+{
+    @autoreleasepool {
+        RSKAnimatedImageCrop *crop = context;
+        // The pixels of the cropped frame are only valid during the call, so they are copied into a bitmap of the pool,
+        // which the image of the frame returns once it is freed.
+        RSKBorrowedBitmap bitmap;
+        if (RSKBufferPoolMakeBitmap(RSKBufferPoolGetShared(), croppedFrame->width, croppedFrame->height, croppedFrame->pixelFormat, &bitmap) != RSKCropStatusSuccess) {
+            return false;
+        }
+        size_t rowLength = croppedFrame->width * RSKPixelFormatGetBytesPerPixel(croppedFrame->pixelFormat);
+        for (size_t y = 0; y < croppedFrame->height; y++) {
+            memcpy((uint8_t *)bitmap.bitmap.data + y * bitmap.bitmap.bytesPerRow, (const uint8_t *)croppedFrame->data + y * croppedFrame->bytesPerRow, rowLength);
+        }
+        CGImageRef imageRef = RSKImageCreateWithPooledBitmap(&bitmap, crop->croppedLayout);
+        if (!imageRef) {
+            return false;
+        }
+        [crop->croppedFrames addObject:[UIImage imageWithCGImage:imageRef scale:crop->scale orientation:UIImageOrientationUp]];
+        CGImageRelease(imageRef);
+        return true;
+    }
+}
+
 @interface RSKImageCropViewController () <RSKImageScrollViewDelegate, UIGestureRecognizerDelegate>
 
 @property (assign, nonatomic) BOOL originalNavigationControllerNavigationBarHidden;
@@ -50,6 +280,9 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
 @property (readonly, nonatomic) CGRect rectForClipPath;
 
 @property (readonly, nonatomic) CGRect imageRect;
+@property (readonly, nonatomic) RSKCropGeometryInput cropGeometryInput;
+
+@property (copy, nonatomic, nullable) NSData *cropRecipe;
 
 @property (strong, nonatomic) UILabel *moveAndScaleLabel;
 @property (strong, nonatomic) UIButton *cancelButton;
@@ -81,6 +314,8 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
         _applyMaskToCroppedImage = NO;
         _bounces = YES;
         _bouncesZoom = YES;
+        _usesImagePyramid = NO;
+        _usesTiledRendering = NO;
         _maskLayerLineWidth = 1.0;
         _rotationEnabled = NO;
         _cropMode = RSKImageCropModeCircle;
@@ -199,6 +434,15 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
     }
 }
 
+- (void)didReceiveMemoryWarning
+{
+    [super didReceiveMemoryWarning];
+    
+    // Free the buffers and the masks that earlier crops left for the next ones.
+    RSKBufferPoolTrim(RSKBufferPoolGetShared(), 0);
+    RSKMaskCacheClear();
+}
+
 - (void)updateViewConstraints
 {
     [super updateViewConstraints];
@@ -281,6 +525,8 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
         _imageScrollView.alwaysBounceVertical = self.alwaysBounceVertical;
         _imageScrollView.bounces = self.bounces;
         _imageScrollView.bouncesZoom = self.bouncesZoom;
+        _imageScrollView.usesImagePyramid = self.usesImagePyramid;
+        _imageScrollView.usesTiledRendering = self.usesTiledRendering;
         _imageScrollView.imageScrollViewDelegate = self;
     }
     return _imageScrollView;
@@ -377,99 +623,32 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
     return _rotationGestureRecognizer;
 }
 
+- (RSKCropGeometryInput)cropGeometryInput
+{
+    RSKCropGeometryInput input = {};
+    input.cropMode = (RSKCropMode)self.cropMode;
+    input.maskRect = self.maskRect;
+    input.scrollViewSize = self.imageScrollView.bounds.size;
+    input.contentOffset = self.imageScrollView.contentOffset;
+    input.contentSize = self.imageScrollView.contentSize;
+    input.zoomScale = self.imageScrollView.zoomScale;
+    input.rotationAngle = self.rotationAngle;
+    input.imageSize = self.originalImage.size;
+    input.imageScale = self.originalImage.scale;
+    input.imageOrientation = (RSKImageOrientation)self.originalImage.imageOrientation;
+    return input;
+}
+
 - (CGRect)imageRect
 {
-    float zoomScale = 1.0 / self.imageScrollView.zoomScale;
-    
-    CGRect imageRect = CGRectZero;
-    
-    imageRect.origin.x = self.imageScrollView.contentOffset.x * zoomScale;
-    imageRect.origin.y = self.imageScrollView.contentOffset.y * zoomScale;
-    imageRect.size.width = CGRectGetWidth(self.imageScrollView.bounds) * zoomScale;
-    imageRect.size.height = CGRectGetHeight(self.imageScrollView.bounds) * zoomScale;
-    
-    imageRect = RSKRectNormalize(imageRect);
-    
-    CGSize imageSize = self.originalImage.size;
-    CGFloat x = CGRectGetMinX(imageRect);
-    CGFloat y = CGRectGetMinY(imageRect);
-    CGFloat width = CGRectGetWidth(imageRect);
-    CGFloat height = CGRectGetHeight(imageRect);
-    
-    UIImageOrientation imageOrientation = self.originalImage.imageOrientation;
-    if (imageOrientation == UIImageOrientationRight || imageOrientation == UIImageOrientationRightMirrored) {
-        imageRect.origin.x = y;
-        imageRect.origin.y = floor(imageSize.width - CGRectGetWidth(imageRect) - x);
-        imageRect.size.width = height;
-        imageRect.size.height = width;
-    } else if (imageOrientation == UIImageOrientationLeft || imageOrientation == UIImageOrientationLeftMirrored) {
-        imageRect.origin.x = floor(imageSize.height - CGRectGetHeight(imageRect) - y);
-        imageRect.origin.y = x;
-        imageRect.size.width = height;
-        imageRect.size.height = width;
-    } else if (imageOrientation == UIImageOrientationDown || imageOrientation == UIImageOrientationDownMirrored) {
-        imageRect.origin.x = floor(imageSize.width - CGRectGetWidth(imageRect) - x);
-        imageRect.origin.y = floor(imageSize.height - CGRectGetHeight(imageRect) - y);
-    }
-    
-    CGFloat imageScale = self.originalImage.scale;
-    imageRect = CGRectApplyAffineTransform(imageRect, CGAffineTransformMakeScale(imageScale, imageScale));
-    
-    return imageRect;
+    RSKCropGeometryInput input = self.cropGeometryInput;
+    return RSKCropGeometrySolve(&input).imageRect;
 }
 
 - (CGRect)cropRect
 {
-    CGRect maskRect = self.maskRect;
-    CGFloat rotationAngle = self.rotationAngle;
-    CGRect rotatedImageScrollViewFrame = self.imageScrollView.frame;
-    float zoomScale = 1.0 / self.imageScrollView.zoomScale;
-    
-    CGAffineTransform imageScrollViewTransform = self.imageScrollView.transform;
-    self.imageScrollView.transform = CGAffineTransformIdentity;
-    
-    CGPoint imageScrollViewContentOffset = self.imageScrollView.contentOffset;
-    CGRect imageScrollViewFrame = self.imageScrollView.frame;
-    self.imageScrollView.frame = self.maskRect;
-    
-    CGRect imageFrame = CGRectZero;
-    imageFrame.origin.x = CGRectGetMinX(maskRect) - self.imageScrollView.contentOffset.x;
-    imageFrame.origin.y = CGRectGetMinY(maskRect) - self.imageScrollView.contentOffset.y;
-    imageFrame.size = self.imageScrollView.contentSize;
-    
-    CGFloat tx = CGRectGetMinX(imageFrame) + self.imageScrollView.contentOffset.x + CGRectGetWidth(maskRect) * 0.5f;
-    CGFloat ty = CGRectGetMinY(imageFrame) + self.imageScrollView.contentOffset.y + CGRectGetHeight(maskRect) * 0.5f;
-    
-    CGFloat sx = CGRectGetWidth(rotatedImageScrollViewFrame) / CGRectGetWidth(imageScrollViewFrame);
-    CGFloat sy = CGRectGetHeight(rotatedImageScrollViewFrame) / CGRectGetHeight(imageScrollViewFrame);
-    
-    CGAffineTransform t1 = CGAffineTransformMakeTranslation(-tx, -ty);
-    CGAffineTransform t2 = CGAffineTransformMakeRotation(rotationAngle);
-    CGAffineTransform t3 = CGAffineTransformMakeScale(sx, sy);
-    CGAffineTransform t4 = CGAffineTransformMakeTranslation(tx, ty);
-    CGAffineTransform t1t2 = CGAffineTransformConcat(t1, t2);
-    CGAffineTransform t1t2t3 = CGAffineTransformConcat(t1t2, t3);
-    CGAffineTransform t1t2t3t4 = CGAffineTransformConcat(t1t2t3, t4);
-    
-    imageFrame = CGRectApplyAffineTransform(imageFrame, t1t2t3t4);
-    
-    CGRect cropRect = CGRectMake(0.0, 0.0, CGRectGetWidth(maskRect), CGRectGetHeight(maskRect));
-    
-    cropRect.origin.x = -CGRectGetMinX(imageFrame) + CGRectGetMinX(maskRect);
-    cropRect.origin.y = -CGRectGetMinY(imageFrame) + CGRectGetMinY(maskRect);
-    
-    cropRect = CGRectApplyAffineTransform(cropRect, CGAffineTransformMakeScale(zoomScale, zoomScale));
-    
-    cropRect = RSKRectNormalize(cropRect);
-    
-    CGFloat imageScale = self.originalImage.scale;
-    cropRect = CGRectApplyAffineTransform(cropRect, CGAffineTransformMakeScale(imageScale, imageScale));
-    
-    self.imageScrollView.frame = imageScrollViewFrame;
-    self.imageScrollView.contentOffset = imageScrollViewContentOffset;
-    self.imageScrollView.transform = imageScrollViewTransform;
-    
-    return cropRect;
+    RSKCropGeometryInput input = self.cropGeometryInput;
+    return RSKCropGeometrySolve(&input).cropRect;
 }
 
 - (CGRect)rectForClipPath
@@ -549,6 +728,24 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
     }
 }
 
+- (void)setUsesImagePyramid:(BOOL)usesImagePyramid
+{
+    if (_usesImagePyramid != usesImagePyramid) {
+        _usesImagePyramid = usesImagePyramid;
+        
+        self.imageScrollView.usesImagePyramid = usesImagePyramid;
+    }
+}
+
+- (void)setUsesTiledRendering:(BOOL)usesTiledRendering
+{
+    if (_usesTiledRendering != usesTiledRendering) {
+        _usesTiledRendering = usesTiledRendering;
+        
+        self.imageScrollView.usesTiledRendering = usesTiledRendering;
+    }
+}
+
 - (void)setCropMode:(RSKImageCropMode)cropMode
 {
     if (_cropMode != cropMode) {
@@ -735,42 +932,6 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
     return zoomScale;
 }
 
-- (NSArray *)intersectionPointsOfLineSegment:(RSKLineSegment)lineSegment withRect:(CGRect)rect
-{
-    RSKLineSegment top = RSKLineSegmentMake(CGPointMake(CGRectGetMinX(rect), CGRectGetMinY(rect)),
-                                            CGPointMake(CGRectGetMaxX(rect), CGRectGetMinY(rect)));
-    
-    RSKLineSegment right = RSKLineSegmentMake(CGPointMake(CGRectGetMaxX(rect), CGRectGetMinY(rect)),
-                                              CGPointMake(CGRectGetMaxX(rect), CGRectGetMaxY(rect)));
-    
-    RSKLineSegment bottom = RSKLineSegmentMake(CGPointMake(CGRectGetMinX(rect), CGRectGetMaxY(rect)),
-                                               CGPointMake(CGRectGetMaxX(rect), CGRectGetMaxY(rect)));
-    
-    RSKLineSegment left = RSKLineSegmentMake(CGPointMake(CGRectGetMinX(rect), CGRectGetMinY(rect)),
-                                             CGPointMake(CGRectGetMinX(rect), CGRectGetMaxY(rect)));
-    
-    CGPoint p0 = RSKLineSegmentIntersection(top, lineSegment);
-    CGPoint p1 = RSKLineSegmentIntersection(right, lineSegment);
-    CGPoint p2 = RSKLineSegmentIntersection(bottom, lineSegment);
-    CGPoint p3 = RSKLineSegmentIntersection(left, lineSegment);
-    
-    NSMutableArray *intersectionPoints = [@[] mutableCopy];
-    if (!RSKPointIsNull(p0)) {
-        [intersectionPoints addObject:[NSValue valueWithCGPoint:p0]];
-    }
-    if (!RSKPointIsNull(p1)) {
-        [intersectionPoints addObject:[NSValue valueWithCGPoint:p1]];
-    }
-    if (!RSKPointIsNull(p2)) {
-        [intersectionPoints addObject:[NSValue valueWithCGPoint:p2]];
-    }
-    if (!RSKPointIsNull(p3)) {
-        [intersectionPoints addObject:[NSValue valueWithCGPoint:p3]];
-    }
-    
-    return [intersectionPoints copy];
-}
-
 - (void)displayImage
 {
     if (self.originalImage) {
@@ -804,79 +965,16 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
 
 - (void)layoutImageScrollView
 {
-    CGRect frame = CGRectZero;
-    
     // The bounds of the image scroll view should always fill the mask area.
-    switch (self.cropMode) {
-        case RSKImageCropModeSquare: {
-            if (self.rotationAngle == 0.0) {
-                frame = self.maskRect;
-            } else {
-                // Step 1: Rotate the left edge of the initial rect of the image scroll view clockwise around the center by `rotationAngle`.
-                CGRect initialRect = self.maskRect;
-                CGFloat rotationAngle = self.rotationAngle;
-                
-                CGPoint leftTopPoint = CGPointMake(initialRect.origin.x, initialRect.origin.y);
-                CGPoint leftBottomPoint = CGPointMake(initialRect.origin.x, initialRect.origin.y + initialRect.size.height);
-                RSKLineSegment leftLineSegment = RSKLineSegmentMake(leftTopPoint, leftBottomPoint);
-                
-                CGPoint pivot = RSKRectCenterPoint(initialRect);
-                
-                CGFloat alpha = fabs(rotationAngle);
-                RSKLineSegment rotatedLeftLineSegment = RSKLineSegmentRotateAroundPoint(leftLineSegment, pivot, alpha);
-                
-                // Step 2: Find the points of intersection of the rotated edge with the initial rect.
-                NSArray *points = [self intersectionPointsOfLineSegment:rotatedLeftLineSegment withRect:initialRect];
-                
-                // Step 3: If the number of intersection points more than one
-                // then the bounds of the rotated image scroll view does not completely fill the mask area.
-                // Therefore, we need to update the frame of the image scroll view.
-                // Otherwise, we can use the initial rect.
-                if (points.count > 1) {
-                    // We have a right triangle.
-                    
-                    // Step 4: Calculate the altitude of the right triangle.
-                    if ((alpha > M_PI_2) && (alpha < M_PI)) {
-                        alpha = alpha - M_PI_2;
-                    } else if ((alpha > (M_PI + M_PI_2)) && (alpha < (M_PI + M_PI))) {
-                        alpha = alpha - (M_PI + M_PI_2);
-                    }
-                    CGFloat sinAlpha = sin(alpha);
-                    CGFloat cosAlpha = cos(alpha);
-                    CGFloat hypotenuse = RSKPointDistance([points[0] CGPointValue], [points[1] CGPointValue]);
-                    CGFloat altitude = hypotenuse * sinAlpha * cosAlpha;
-                    
-                    // Step 5: Calculate the target width.
-                    CGFloat initialWidth = CGRectGetWidth(initialRect);
-                    CGFloat targetWidth = initialWidth + altitude * 2;
-                    
-                    // Step 6: Calculate the target frame.
-                    CGFloat scale = targetWidth / initialWidth;
-                    CGPoint center = RSKRectCenterPoint(initialRect);
-                    frame = RSKRectScaleAroundPoint(initialRect, center, scale, scale);
-                    
-                    // Step 7: Avoid floats.
-                    frame.origin.x = floor(CGRectGetMinX(frame));
-                    frame.origin.y = floor(CGRectGetMinY(frame));
-                    frame = CGRectIntegral(frame);
-                } else {
-                    // Step 4: Use the initial rect.
-                    frame = initialRect;
-                }
-            }
-            break;
-        }
-        case RSKImageCropModeCircle: {
-            frame = self.maskRect;
-            break;
-        }
-        case RSKImageCropModeCustom: {
-            frame = [self.dataSource imageCropViewControllerCustomMovementRect:self];
-            break;
-        }
+    CGRect customMovementRect = CGRectNull;
+    if (self.cropMode == RSKImageCropModeCustom) {
+        customMovementRect = [self.dataSource imageCropViewControllerCustomMovementRect:self];
     }
-    
+    // The transform of the image scroll view only rotates it, so it holds the sine and cosine of the rotation.
     CGAffineTransform transform = self.imageScrollView.transform;
+    RSKRotation rotation = { transform.b, transform.a };
+    CGRect frame = RSKCropGeometryGetMovementRectForRotation((RSKCropMode)self.cropMode, self.maskRect, customMovementRect, rotation);
+    
     self.imageScrollView.transform = CGAffineTransformIdentity;
     
     self.imageScrollView.frame = frame;
@@ -959,81 +1057,125 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
     }
 }
 
-- (UIImage *)imageWithImage:(UIImage *)image inRect:(CGRect)rect scale:(CGFloat)scale imageOrientation:(UIImageOrientation)imageOrientation
+- (UIImage *)croppedImage:(UIImage *)originalImage cropMode:(RSKImageCropMode)cropMode cropRect:(CGRect)cropRect imageRect:(CGRect)imageRect rotationAngle:(CGFloat)rotationAngle zoomScale:(CGFloat)zoomScale maskPath:(UIBezierPath *)maskPath applyMaskToCroppedImage:(BOOL)applyMaskToCroppedImage
 {
-    if (!image.images) {
-        CGImageRef cgImage = CGImageCreateWithImageInRect(image.CGImage, rect);
-        UIImage *image = [UIImage imageWithCGImage:cgImage scale:scale orientation:imageOrientation];
-        CGImageRelease(cgImage);
-        return image;
-    } else {
-        UIImage *animatedImage = image;
-        NSMutableArray *images = [NSMutableArray array];
-        for (UIImage *animatedImageImage in animatedImage.images) {
-            UIImage *image = [self imageWithImage:animatedImageImage inRect:rect scale:scale imageOrientation:imageOrientation];
-            [images addObject:image];
-        }
-        return [UIImage animatedImageWithImages:images duration:image.duration];
-    }
+    return [self croppedImage:originalImage cropMode:cropMode cropRect:cropRect imageRect:imageRect rotationAngle:rotationAngle zoomScale:zoomScale maskPath:maskPath applyMaskToCroppedImage:applyMaskToCroppedImage croppedImageSize:CGSizeZero];
 }
 
-- (UIImage *)croppedImage:(UIImage *)originalImage cropMode:(RSKImageCropMode)cropMode cropRect:(CGRect)cropRect imageRect:(CGRect)imageRect rotationAngle:(CGFloat)rotationAngle zoomScale:(CGFloat)zoomScale maskPath:(UIBezierPath *)maskPath applyMaskToCroppedImage:(BOOL)applyMaskToCroppedImage
+- (UIImage *)croppedImage:(UIImage *)originalImage cropMode:(RSKImageCropMode)cropMode cropRect:(CGRect)cropRect imageRect:(CGRect)imageRect rotationAngle:(CGFloat)rotationAngle zoomScale:(CGFloat)zoomScale maskPath:(UIBezierPath *)maskPath applyMaskToCroppedImage:(BOOL)applyMaskToCroppedImage croppedImageSize:(CGSize)croppedImageSize
 {
-    // Step 1: create an image using the data contained within the specified rect.
-    UIImage *image = [self imageWithImage:originalImage inRect:imageRect scale:originalImage.scale imageOrientation:originalImage.imageOrientation];
+    if (originalImage.images) {
+        return [self croppedAnimatedImage:originalImage cropMode:cropMode cropRect:cropRect imageRect:imageRect rotationAngle:rotationAngle zoomScale:zoomScale maskPath:maskPath applyMaskToCroppedImage:applyMaskToCroppedImage croppedImageSize:croppedImageSize];
+    }
     
-    // Step 2: fix orientation of the image.
-    image = [image fixOrientation];
+    // Step 1: describe the crop of the image within the specified rect.
+    CGImageRef imageRef = CGImageCreateWithImageInRect(originalImage.CGImage, imageRect);
+    if (!imageRef) {
+        return nil;
+    }
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
     
-    // Step 3: If current mode is `RSKImageCropModeSquare` and the original image is not rotated
-    // or mask should not be applied to the image after cropping and the original image is not rotated,
-    // we can return the image immediately.
-    // Otherwise, we must further process the image.
-    if ((cropMode == RSKImageCropModeSquare || !applyMaskToCroppedImage) && rotationAngle == 0.0) {
-        // Step 4: return the image immediately.
-        return image;
-    } else {
-        // Step 4: create a new context.
-        CGSize contextSize = cropRect.size;
-        UIGraphicsBeginImageContextWithOptions(contextSize, NO, originalImage.scale);
-        
-        // Step 5: apply the mask if needed.
-        if (applyMaskToCroppedImage) {
-            // 5a: scale the mask to the size of the crop rect.
-            UIBezierPath *maskPathCopy = [maskPath copy];
-            CGFloat scale = 1.0 / zoomScale;
-            [maskPathCopy applyTransform:CGAffineTransformMakeScale(scale, scale)];
-            
-            // 5b: center the mask.
-            CGPoint translation = CGPointMake(-CGRectGetMinX(maskPathCopy.bounds) + (CGRectGetWidth(cropRect) - CGRectGetWidth(maskPathCopy.bounds)) * 0.5f,
-                                              -CGRectGetMinY(maskPathCopy.bounds) + (CGRectGetHeight(cropRect) - CGRectGetHeight(maskPathCopy.bounds)) * 0.5f);
-            [maskPathCopy applyTransform:CGAffineTransformMakeTranslation(translation.x, translation.y)];
-            
-            // 5c: apply the mask.
-            [maskPathCopy addClip];
-        }
-        
-        // Step 6: rotate the image if needed.
-        if (rotationAngle != 0) {
-            image = [image rotateByAngle:rotationAngle];
+    NSMutableData *maskPathElements = RSKPathElementsCreate(maskPath);
+    RSKCropSpec spec = RSKCropSpecMake(cropMode, cropRect, width, height, rotationAngle, zoomScale, originalImage, maskPath, maskPathElements, applyMaskToCroppedImage);
+    spec.outputSize = CGSizeMake(round(croppedImageSize.width * originalImage.scale), round(croppedImageSize.height * originalImage.scale));
+    
+    // Step 2: a crop that only selects a rect of the image shares the pixels of the image instead of drawing them.
+    CGRect subimageRect = CGRectZero;
+    if (RSKCropEngineGetSubviewRect(width, height, &spec, &subimageRect)) {
+        CGImageRef croppedImageRef = CGImageCreateWithImageInRect(imageRef, subimageRect);
+        CGImageRelease(imageRef);
+        if (!croppedImageRef) {
+            return nil;
         }
-        
-        // Step 7: draw the image.
-        CGPoint point = CGPointMake(floor((contextSize.width - image.size.width) * 0.5f),
-                                    floor((contextSize.height - image.size.height) * 0.5f));
-        [image drawAtPoint:point];
-        
-        // Step 8: get the cropped image affter processing from the context.
-        UIImage *croppedImage = UIGraphicsGetImageFromCurrentImageContext();
-        
-        // Step 9: remove the context.
-        UIGraphicsEndImageContext();
-        
-        croppedImage = [UIImage imageWithCGImage:croppedImage.CGImage scale:originalImage.scale orientation:image.imageOrientation];
-        
-        // Step 10: return the cropped image affter processing.
+        UIImage *croppedImage = [UIImage imageWithCGImage:croppedImageRef scale:originalImage.scale orientation:UIImageOrientationUp];
+        CGImageRelease(croppedImageRef);
         return croppedImage;
     }
+    
+    // Step 3: otherwise draw the image into a bitmap the crop engine understands and crop it on every core. Both
+    // bitmaps come from the shared buffer pool, so repeated crops reuse the memory of the previous ones, and keep the
+    // depth and the color space of the image.
+    RSKBitmapLayout layout = RSKBitmapLayoutMakeWithImage(imageRef);
+    RSKBorrowedBitmap source;
+    BOOL hasSource = RSKPooledBitmapMakeWithImage(imageRef, width, height, layout, &source);
+    CGImageRelease(imageRef);
+    if (!hasSource) {
+        CGColorSpaceRelease(layout.colorSpace);
+        return nil;
+    }
+    
+    CGSize outputSize = RSKCropEngineGetOutputSize(width, height, &spec);
+    RSKBorrowedBitmap destination;
+    if (RSKBufferPoolMakeBitmap(RSKBufferPoolGetShared(), (size_t)outputSize.width, (size_t)outputSize.height, layout.pixelFormat, &destination) != RSKCropStatusSuccess) {
+        RSKBorrowedBitmapRelease(&source);
+        CGColorSpaceRelease(layout.colorSpace);
+        return nil;
+    }
+    
+    RSKExecutor executor = { RSKDispatchParallelFor, NULL, (size_t)[NSProcessInfo processInfo].activeProcessorCount };
+    RSKCropStatus status = RSKCropEngineCropBitmapWithExecutor(&source.bitmap, &spec, &executor, &destination.bitmap);
+    RSKBorrowedBitmapRelease(&source);
+    if (status != RSKCropStatusSuccess) {
+        RSKBorrowedBitmapRelease(&destination);
+        CGColorSpaceRelease(layout.colorSpace);
+        return nil;
+    }
+    
+    // Step 4: create the cropped image, which returns its pixels to the pool once it is freed. The engine has already
+    // applied the orientation. The crop of an opaque image is opaque too, unless it is masked or leaves parts of the
+    // result clear, like the corners that a rotation exposes.
+    layout.isOpaque = layout.isOpaque && RSKCropEngineIsOutputOpaque(width, height, &spec);
+    CGImageRef croppedImageRef = RSKImageCreateWithPooledBitmap(&destination, layout);
+    CGColorSpaceRelease(layout.colorSpace);
+    if (!croppedImageRef) {
+        return nil;
+    }
+    UIImage *croppedImage = [UIImage imageWithCGImage:croppedImageRef scale:originalImage.scale orientation:UIImageOrientationUp];
+    CGImageRelease(croppedImageRef);
+    
+    // Step 5: return the cropped image.
+    return croppedImage;
+}
+
+- (UIImage *)croppedAnimatedImage:(UIImage *)animatedImage cropMode:(RSKImageCropMode)cropMode cropRect:(CGRect)cropRect imageRect:(CGRect)imageRect rotationAngle:(CGFloat)rotationAngle zoomScale:(CGFloat)zoomScale maskPath:(UIBezierPath *)maskPath applyMaskToCroppedImage:(BOOL)applyMaskToCroppedImage croppedImageSize:(CGSize)croppedImageSize
+{
+    NSArray<UIImage *> *frames = animatedImage.images;
+    UIImage *firstFrame = frames.firstObject;
+    
+    // Step 1: describe the crop of every frame. The frames of an animated image share their size, orientation, depth
+    // and color space, so they are all drawn with the layout of the first one.
+    CGImageRef firstFrameRef = CGImageCreateWithImageInRect(firstFrame.CGImage, imageRect);
+    if (!firstFrameRef) {
+        return nil;
+    }
+    size_t width = CGImageGetWidth(firstFrameRef);
+    size_t height = CGImageGetHeight(firstFrameRef);
+    RSKBitmapLayout layout = RSKBitmapLayoutMakeWithImage(firstFrameRef);
+    CGImageRelease(firstFrameRef);
+    
+    NSMutableData *maskPathElements = RSKPathElementsCreate(maskPath);
+    RSKCropSpec spec = RSKCropSpecMake(cropMode, cropRect, width, height, rotationAngle, zoomScale, firstFrame, maskPath, maskPathElements, applyMaskToCroppedImage);
+    spec.outputSize = CGSizeMake(round(croppedImageSize.width * firstFrame.scale), round(croppedImageSize.height * firstFrame.scale));
+    RSKBitmapLayout croppedLayout = layout;
+    croppedLayout.isOpaque = layout.isOpaque && RSKCropEngineIsOutputOpaque(width, height, &spec);
+    
+    // Step 2: crop several frames at once on every core, but only keep a few of them in memory, and collect the cropped
+    // frames in order. Like the pixels of a still image, the pixels of the frames come from the shared buffer pool.
+    NSMutableArray<UIImage *> *croppedFrames = [NSMutableArray arrayWithCapacity:frames.count];
+    RSKAnimatedImageCrop crop = { frames, croppedFrames, imageRect, firstFrame.scale, layout, croppedLayout };
+    RSKAnimatedCropCallbacks callbacks = { RSKAnimatedImageCropDecode, RSKAnimatedImageCropWrite, &crop };
+    RSKExecutor executor = { RSKDispatchParallelFor, NULL, (size_t)[NSProcessInfo processInfo].activeProcessorCount };
+    RSKAnimatedCropOptions options = {};
+    options.executor = &executor;
+    RSKCropStatus status = RSKCropEngineCropAnimated(frames.count, &spec, &callbacks, &options);
+    CGColorSpaceRelease(layout.colorSpace);
+    if (status != RSKCropStatusSuccess) {
+        return nil;
+    }
+    
+    // Step 3: return the cropped animated image.
+    return [UIImage animatedImageWithImages:croppedFrames duration:animatedImage.duration];
 }
 
 - (void)cropImage
@@ -1050,12 +1192,15 @@ static const CGFloat kLayoutImageScrollViewAnimationDuration = 0.25;
     CGFloat zoomScale = self.imageScrollView.zoomScale;
     UIBezierPath *maskPath = self.maskPath;
     BOOL applyMaskToCroppedImage = self.applyMaskToCroppedImage;
+    CGSize croppedImageSize = self.croppedImageSize;
     
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
         
-        UIImage *croppedImage = [self croppedImage:originalImage cropMode:cropMode cropRect:cropRect imageRect:imageRect rotationAngle:rotationAngle zoomScale:zoomScale maskPath:maskPath applyMaskToCroppedImage:applyMaskToCroppedImage];
+        UIImage *croppedImage = [self croppedImage:originalImage cropMode:cropMode cropRect:cropRect imageRect:imageRect rotationAngle:rotationAngle zoomScale:zoomScale maskPath:maskPath applyMaskToCroppedImage:applyMaskToCroppedImage croppedImageSize:croppedImageSize];
+        NSData *cropRecipe = RSKCropRecipeDataCreate(cropMode, cropRect, imageRect, rotationAngle, zoomScale, originalImage, maskPath, applyMaskToCroppedImage, croppedImageSize);
         
         dispatch_async(dispatch_get_main_queue(), ^{
+            self.cropRecipe = cropRecipe;
             [self.delegate imageCropViewController:self didCropImage:croppedImage usingCropRect:cropRect rotationAngle:rotationAngle];
         });
     });
@@ -68,6 +68,16 @@ NS_SWIFT_UI_ACTOR
  */
 @property (nonatomic, nullable, strong) UIImage *image;
 
+/**
+ A Boolean value that determines whether a smaller copy of the image is shown while the image is zoomed out, so that a large photo is not scaled as a whole on every frame of a zoom. The copies are halved in size level by level, made in the background as the zoom scale changes from the next larger copy, and kept until memory is low. The image itself is only drawn once, in bands of rows, for the largest copy. Default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL usesImagePyramid;
+
+/**
+ A Boolean value that determines whether only the tiles of the image that are on the screen are drawn, from the level of the pyramid of the image that matches the zoom scale, while the smallest level is shown underneath. The tiles are drawn in the background and the ones that were used least recently are dropped when they cost more than a budget of memory. Takes precedence over `usesImagePyramid`. Default value is `NO`.
+ */
+@property (nonatomic, assign) BOOL usesTiledRendering;
+
 /**
  The delegate of the image scroll view.
  
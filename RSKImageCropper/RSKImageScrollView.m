@@ -50,14 +50,243 @@
 
 #import "RSKImageScrollView.h"
 #import "RSKImageScrollViewDelegate.h"
+#import <RSKImageCropperCore/RSKImageCropperCore.h>
+
+static const size_t kRSKImagePyramidSmallestLevelSize = 256;
+static const size_t kRSKTileCacheByteBudget = 32 * 1024 * 1024;
+
+static const size_t kRSKImagePyramidBandHeight = 256;
+static const CGBitmapInfo kRSKImagePyramidBitmapInfo = kCGBitmapByteOrder32Big | kCGImageAlphaPremultipliedLast;
+
+// Returns the pixels of the level `level` of the pyramid of `imageRef`. The image is drawn in bands of rows, so that only
+// a band of it is ever drawn at full resolution.
+static NSData *RSKPyramidLevelDataCreateWithImage(CGImageRef imageRef, size_t level)
+{
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    CGSize levelSize = RSKImagePyramidGetLevelSize(width, height, level);
+    size_t levelWidth = (size_t)levelSize.width;
+    size_t levelHeight = (size_t)levelSize.height;
+    size_t bandHeight = MIN(MAX(kRSKImagePyramidBandHeight >> level, (size_t)1) << level, height);
+    NSMutableData *levelData = [NSMutableData dataWithLength:levelWidth * levelHeight * 4];
+    NSMutableData *bandData = [NSMutableData dataWithLength:width * bandHeight * 4];
+    if (!levelData || !bandData) {
+        return nil;
+    }
+    
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(bandData.mutableBytes, width, bandHeight, 8, width * 4, colorSpace, kRSKImagePyramidBitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+    if (!context) {
+        return nil;
+    }
+    
+    // Every band covers whole blocks of the level but the last one, so the rows of the level that it makes are the
+    // same as if they were made from the whole image.
+    for (size_t y = 0; y < height; y += bandHeight) {
+        size_t rowCount = MIN(bandHeight, height - y);
+        size_t levelY = y >> level;
+        size_t levelRowCount = (rowCount + ((size_t)1 << level) - 1) >> level;
+        
+        // The origin of Core Graphics is at the bottom, so the image is moved down until the row `y` is at the top.
+        CGContextClearRect(context, CGRectMake(0.0f, 0.0f, width, bandHeight));
+        CGContextDrawImage(context, CGRectMake(0.0f, (CGFloat)bandHeight - height + y, width, height), imageRef);
+        
+        RSKBitmap source = RSKBitmapMake(bandData.mutableBytes, width, rowCount, width * 4, RSKPixelFormatRGBA8888);
+        RSKBitmap destination = RSKBitmapMake((uint8_t *)levelData.mutableBytes + levelY * levelWidth * 4, levelWidth, levelRowCount, levelWidth * 4, RSKPixelFormatRGBA8888);
+        if (RSKImagePyramidMakeLevel(&source, level, NULL, &destination) != RSKCropStatusSuccess) {
+            CGContextRelease(context);
+            return nil;
+        }
+    }
+    CGContextRelease(context);
+    
+    return levelData;
+}
+
+// Returns an image of the pixels of a level of a pyramid that is `width` x `height` pixels large.
+static CGImageRef RSKImageCreateWithPyramidLevelData(NSData *levelData, size_t width, size_t height)
+{
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)levelData);
+    CGImageRef imageRef = CGImageCreate(width, height, 8, 32, width * 4, colorSpace, kRSKImagePyramidBitmapInfo, provider, NULL, false, kCGRenderingIntentDefault);
+    CGDataProviderRelease(provider);
+    CGColorSpaceRelease(colorSpace);
+    return imageRef;
+}
+
+// Returns the transform that maps a point of the upright image to the matching point of its `width` x `height` pixels
+// with `orientation`, like the crop engine does.
+static CGAffineTransform RSKImageOrientationTransform(UIImageOrientation orientation, CGFloat width, CGFloat height)
+{
+    switch (orientation) {
+        case UIImageOrientationUp:
+            return CGAffineTransformIdentity;
+        case UIImageOrientationDown:
+            return CGAffineTransformMake(-1.0f, 0.0f, 0.0f, -1.0f, width, height);
+        case UIImageOrientationLeft:
+            return CGAffineTransformMake(0.0f, 1.0f, -1.0f, 0.0f, width, 0.0f);
+        case UIImageOrientationRight:
+            return CGAffineTransformMake(0.0f, -1.0f, 1.0f, 0.0f, 0.0f, height);
+        case UIImageOrientationUpMirrored:
+            return CGAffineTransformMake(-1.0f, 0.0f, 0.0f, 1.0f, width, 0.0f);
+        case UIImageOrientationDownMirrored:
+            return CGAffineTransformMake(1.0f, 0.0f, 0.0f, -1.0f, 0.0f, height);
+        case UIImageOrientationLeftMirrored:
+            return CGAffineTransformMake(0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+        case UIImageOrientationRightMirrored:
+            return CGAffineTransformMake(0.0f, -1.0f, -1.0f, 0.0f, width, height);
+    }
+    return CGAffineTransformIdentity;
+}
+
+#pragma mark -
+
+// The levels of the pyramid of an image, which are made the first time they are asked for and kept until memory is low.
+// The image itself is drawn only for the level 1, in bands of rows, and every other level is reduced from the nearest
+// larger level that is kept, so that no level needs a copy of the whole image. It is thread-safe.
+@interface RSKImagePyramidLevels : NSObject
+
+- (instancetype)initWithImage:(UIImage *)image;
+
+// Returns the level `level` in pixels without the orientation of the image, or `NULL` if there is not enough memory.
+// The level 0 is the image itself.
+- (CGImageRef)copyLevelImage:(size_t)level CF_RETURNS_RETAINED;
+
+// Returns the level `level` with the scale and the orientation of the image, or `nil` if there is not enough memory.
+- (UIImage *)levelImage:(size_t)level;
+
+// Drops the levels that are kept, like when memory is low.
+- (void)removeAllLevels;
+
+@end
+
+@implementation RSKImagePyramidLevels
+{
+    UIImage *_image;
+    NSMutableDictionary<NSNumber *, NSData *> *_levelData;
+}
+
+- (instancetype)initWithImage:(UIImage *)image
+{
+    self = [super init];
+    if (self) {
+        _image = image;
+        _levelData = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (CGImageRef)copyLevelImage:(size_t)level
+{
+    CGImageRef imageRef = _image.CGImage;
+    if (level == 0) {
+        return CGImageRetain(imageRef);
+    }
+    
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    CGSize levelSize = RSKImagePyramidGetLevelSize(width, height, level);
+    NSData *levelData = [self levelData:level];
+    if (!levelData) {
+        return NULL;
+    }
+    return RSKImageCreateWithPyramidLevelData(levelData, (size_t)levelSize.width, (size_t)levelSize.height);
+}
+
+- (UIImage *)levelImage:(size_t)level
+{
+    CGImageRef levelImageRef = [self copyLevelImage:level];
+    if (!levelImageRef) {
+        return nil;
+    }
+    UIImage *levelImage = [UIImage imageWithCGImage:levelImageRef scale:_image.scale / (CGFloat)((size_t)1 << level) orientation:_image.imageOrientation];
+    CGImageRelease(levelImageRef);
+    return levelImage;
+}
+
+- (void)removeAllLevels
+{
+    @synchronized (self) {
+        [_levelData removeAllObjects];
+    }
+}
+
+- (NSData *)levelData:(size_t)level
+{
+    @synchronized (self) {
+        NSData *levelData = _levelData[@(level)];
+        if (levelData) {
+            return levelData;
+        }
+        
+        // Step 1: draw the level 1 from the image.
+        CGImageRef imageRef = _image.CGImage;
+        if (level == 1) {
+            levelData = RSKPyramidLevelDataCreateWithImage(imageRef, 1);
+            _levelData[@(level)] = levelData;
+            return levelData;
+        }
+        
+        // Step 2: find the nearest larger level that is kept, or the level 1, and reduce it to the level.
+        size_t baseLevel = level - 1;
+        while (baseLevel > 1 && !_levelData[@(baseLevel)]) {
+            baseLevel -= 1;
+        }
+        NSData *baseData = [self levelData:baseLevel];
+        if (!baseData) {
+            return nil;
+        }
+        CGSize baseSize = RSKImagePyramidGetLevelSize(CGImageGetWidth(imageRef), CGImageGetHeight(imageRef), baseLevel);
+        CGSize levelSize = RSKImagePyramidGetLevelSize((size_t)baseSize.width, (size_t)baseSize.height, level - baseLevel);
+        NSMutableData *reducedData = [NSMutableData dataWithLength:(size_t)levelSize.width * (size_t)levelSize.height * 4];
+        if (!reducedData) {
+            return nil;
+        }
+        RSKBitmap source = RSKBitmapMake((void *)baseData.bytes, (size_t)baseSize.width, (size_t)baseSize.height, (size_t)baseSize.width * 4, RSKPixelFormatRGBA8888);
+        RSKBitmap destination = RSKBitmapMake(reducedData.mutableBytes, (size_t)levelSize.width, (size_t)levelSize.height, (size_t)levelSize.width * 4, RSKPixelFormatRGBA8888);
+        if (RSKImagePyramidMakeLevel(&source, level - baseLevel, NULL, &destination) != RSKCropStatusSuccess) {
+            return nil;
+        }
+        _levelData[@(level)] = reducedData;
+        return reducedData;
+    }
+}
+
+@end
+
+static void RSKTileCacheReleaseTile(__unused void *context, void *tile)
+{
+    CGImageRelease((CGImageRef)tile);
+}
+
+static NSIndexPath *RSKTileKeyIndexPath(RSKTileKey key)
+{
+    NSUInteger indexes[] = { key.level, key.column, key.row };
+    return [NSIndexPath indexPathWithIndexes:indexes length:3];
+}
 
 #pragma mark -
 
 @interface RSKImageScrollView () <UIScrollViewDelegate>
 {
     CGSize _imageSize;
+    UIImage *_image;
     UIImageView *_imageView;
     
+    RSKImagePyramidLevels *_pyramidLevels;
+    size_t _pyramidLevelCount;
+    size_t _pyramidLevel;
+    NSUInteger _pyramidGeneration;
+    
+    UIView *_tileView;
+    RSKTileGrid _tileGrid;
+    RSKTileCache *_tileCache;
+    NSMutableDictionary<NSIndexPath *, CALayer *> *_tileLayers;
+    NSMutableSet<NSIndexPath *> *_pendingTiles;
+    dispatch_queue_t _tileQueue;
+    NSUInteger _tileGeneration;
+    
     CGPoint _pointToCenterAfterResize;
     CGFloat _scaleToRestoreAfterResize;
 }
@@ -73,17 +302,40 @@
     {
         _aspectFill = NO;
         _imageView = [[UIImageView alloc] init];
+        _tileView = [[UIView alloc] init];
+        _tileView.userInteractionEnabled = NO;
+        _tileLayers = [[NSMutableDictionary alloc] init];
+        _pendingTiles = [[NSMutableSet alloc] init];
+        _tileQueue = dispatch_queue_create("com.ruslanskorb.RSKImageScrollView.tiles", DISPATCH_QUEUE_SERIAL);
         self.showsVerticalScrollIndicator = NO;
         self.showsHorizontalScrollIndicator = NO;
         self.scrollsToTop = NO;
         self.decelerationRate = UIScrollViewDecelerationRateFast;
         self.delegate = self;
         
+        [_imageView addSubview:_tileView];
         [self addSubview:_imageView];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning:) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
     }
     return self;
 }
 
+- (void)dealloc
+{
+    if (_tileCache) {
+        RSKTileCacheDestroy(_tileCache);
+    }
+}
+
+- (void)didReceiveMemoryWarning:(__unused NSNotification *)notification
+{
+    [_pyramidLevels removeAllLevels];
+    if (_tileCache) {
+        RSKTileCacheTrim(_tileCache, 0);
+    }
+}
+
 - (void)didAddSubview:(UIView *)subview
 {
     [super didAddSubview:subview];
@@ -110,15 +362,46 @@
 
 - (UIImage *)image
 {
-    return _imageView.image;
+    return _image;
 }
 
 - (void)setImage:(UIImage *)image
 {
+    _image = image;
     _imageView.image = image;
+    _pyramidLevels = image.CGImage ? [[RSKImagePyramidLevels alloc] initWithImage:image] : nil;
+    [self resetImagePyramid];
+    [self resetTiles];
     
     if (CGSizeEqualToSize(_imageSize, CGSizeZero)) {
         self.imageSize = image.size;
+    } else {
+        [self updateImagePyramidLevel];
+        [self updateTiles];
+    }
+}
+
+- (void)setUsesImagePyramid:(BOOL)usesImagePyramid
+{
+    if (_usesImagePyramid != usesImagePyramid) {
+        _usesImagePyramid = usesImagePyramid;
+        
+        _imageView.image = _image;
+        [self resetImagePyramid];
+        [self updateImagePyramidLevel];
+    }
+}
+
+- (void)setUsesTiledRendering:(BOOL)usesTiledRendering
+{
+    if (_usesTiledRendering != usesTiledRendering) {
+        _usesTiledRendering = usesTiledRendering;
+        
+        _imageView.image = _image;
+        [self resetImagePyramid];
+        [self resetTiles];
+        [self updateImagePyramidLevel];
+        [self updateTiles];
     }
 }
 
@@ -148,11 +431,14 @@
     
     self.zoomScale = 1.0f;
     _imageView.frame = CGRectMake(0.0f, 0.0f, imageSize.width, imageSize.height);
+    _tileView.frame = _imageView.bounds;
     self.contentSize = imageSize;
     [self setMaxMinZoomScalesForCurrentBounds];
     [self setInitialZoomScale];
     [self setInitialContentOffset];
     [self centerImageView];
+    [self updateImagePyramidLevel];
+    [self updateTiles];
 }
 
 - (void)setInitialZoomScaleAndContentOffsetAndCenterImageView
@@ -217,6 +503,8 @@
 
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView
 {
+    [self updateTiles];
+    
     if ([self.imageScrollViewDelegate respondsToSelector:@selector(imageScrollViewDidScroll)]) {
         [self.imageScrollViewDelegate imageScrollViewDidScroll];
     }
@@ -225,6 +513,8 @@
 - (void)scrollViewDidZoom:(__unused UIScrollView *)scrollView
 {
     [self centerImageView];
+    [self updateImagePyramidLevel];
+    [self updateTiles];
 }
 
 - (void)scrollViewWillBeginDragging:(UIScrollView *)scrollView
@@ -288,6 +578,229 @@
     }
 }
 
+#pragma mark - Image pyramid
+
+- (void)resetImagePyramid
+{
+    // Levels that are still being made for the previous image are dropped when they are done.
+    _pyramidGeneration += 1;
+    _pyramidLevel = 0;
+    _pyramidLevelCount = 0;
+    
+    CGImageRef imageRef = _image.CGImage;
+    if (_usesImagePyramid && !_usesTiledRendering && imageRef) {
+        _pyramidLevelCount = RSKImagePyramidGetLevelCount(CGImageGetWidth(imageRef), CGImageGetHeight(imageRef), kRSKImagePyramidSmallestLevelSize);
+    }
+}
+
+- (void)updateImagePyramidLevel
+{
+    if (_pyramidLevelCount <= 1) {
+        return;
+    }
+    
+    // Step 1: find the smallest level that still has a pixel for every pixel of the screen.
+    CGFloat screenScale = self.traitCollection.displayScale > 0.0f ? self.traitCollection.displayScale : 1.0f;
+    CGFloat displayScale = CGRectGetWidth(_imageView.frame) * screenScale / CGImageGetWidth(_image.CGImage);
+    size_t level = RSKImagePyramidSelectLevel(_pyramidLevelCount, displayScale);
+    if (level == _pyramidLevel) {
+        return;
+    }
+    _pyramidLevel = level;
+    
+    // Step 2: show the image itself right away.
+    if (level == 0) {
+        _imageView.image = _image;
+        return;
+    }
+    
+    // Step 3: make the level in the background, from a larger level that is kept, and show it unless another level or
+    // image is wanted by then.
+    RSKImagePyramidLevels *pyramidLevels = _pyramidLevels;
+    NSUInteger generation = _pyramidGeneration;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        
+        UIImage *levelImage = [pyramidLevels levelImage:level];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (levelImage && generation == self->_pyramidGeneration && level == self->_pyramidLevel) {
+                self->_imageView.image = levelImage;
+            }
+        });
+    });
+}
+
+#pragma mark - Tiled rendering
+
+- (void)resetTiles
+{
+    // Tiles that are still being drawn for the previous image are dropped when they are done.
+    _tileGeneration += 1;
+    [_pendingTiles removeAllObjects];
+    for (CALayer *tileLayer in _tileLayers.allValues) {
+        [tileLayer removeFromSuperlayer];
+    }
+    [_tileLayers removeAllObjects];
+    if (_tileCache) {
+        RSKTileCacheDestroy(_tileCache);
+        _tileCache = NULL;
+    }
+    
+    if (!_usesTiledRendering || !_image.CGImage) {
+        return;
+    }
+    
+    // Step 1: cut the image, in pixels with its orientation applied, into tiles level by level.
+    size_t width = (size_t)round(_image.size.width * _image.scale);
+    size_t height = (size_t)round(_image.size.height * _image.scale);
+    _tileGrid = RSKTileGridMake(width, height, 0, kRSKImagePyramidSmallestLevelSize);
+    _tileCache = RSKTileCacheCreate(kRSKTileCacheByteBudget, RSKTileCacheReleaseTile, NULL);
+    if (!_tileCache || _tileGrid.levelCount <= 1) {
+        return;
+    }
+    
+    // Step 2: show the smallest level underneath the tiles, so that there is something to see where they are not
+    // drawn yet.
+    RSKImagePyramidLevels *pyramidLevels = _pyramidLevels;
+    size_t level = _tileGrid.levelCount - 1;
+    NSUInteger generation = _tileGeneration;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        
+        UIImage *levelImage = [pyramidLevels levelImage:level];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (levelImage && generation == self->_tileGeneration) {
+                self->_imageView.image = levelImage;
+            }
+        });
+    });
+}
+
+- (void)updateTiles
+{
+    if (!_tileCache || CGSizeEqualToSize(_imageView.bounds.size, CGSizeZero)) {
+        return;
+    }
+    
+    // Step 1: find the tiles of the part of the image that is on the screen. The scroll view does not clip its image,
+    // so the part is bounded by the window rather than by the scroll view.
+    CGRect visibleRect = self.window ? [self.window convertRect:self.window.bounds toView:_imageView] : [self convertRect:self.bounds toView:_imageView];
+    CGFloat zoomScale = self.zoomScale;
+    RSKTileViewport viewport;
+    viewport.contentOffset = CGPointMake(CGRectGetMinX(visibleRect) * zoomScale, CGRectGetMinY(visibleRect) * zoomScale);
+    viewport.boundsSize = CGSizeMake(CGRectGetWidth(visibleRect) * zoomScale, CGRectGetHeight(visibleRect) * zoomScale);
+    viewport.zoomScale = zoomScale;
+    viewport.imageSize = _imageView.bounds.size;
+    viewport.screenScale = self.traitCollection.displayScale > 0.0f ? self.traitCollection.displayScale : 1.0f;
+    
+    size_t tileCount = RSKTileGridGetVisibleTiles(&_tileGrid, &viewport, NULL, 0);
+    NSMutableData *tilesData = [NSMutableData dataWithLength:tileCount * sizeof(RSKTileKey)];
+    if (!tilesData) {
+        return;
+    }
+    RSKTileKey *tiles = tilesData.mutableBytes;
+    RSKTileGridGetVisibleTiles(&_tileGrid, &viewport, tiles, tileCount);
+    
+    // Step 2: keep the layers of the tiles that are still on the screen, and draw the tiles that are not cached.
+    NSMutableDictionary<NSIndexPath *, CALayer *> *tileLayers = [NSMutableDictionary dictionaryWithCapacity:tileCount];
+    NSMutableArray<NSIndexPath *> *shownTiles = [NSMutableArray arrayWithCapacity:tileCount];
+    for (size_t i = 0; i < tileCount; i++) {
+        NSIndexPath *indexPath = RSKTileKeyIndexPath(tiles[i]);
+        CALayer *tileLayer = _tileLayers[indexPath];
+        if (tileLayer) {
+            tileLayers[indexPath] = tileLayer;
+            [_tileLayers removeObjectForKey:indexPath];
+        }
+        if (RSKTileCacheGetTile(_tileCache, tiles[i])) {
+            [shownTiles addObject:indexPath];
+        } else {
+            [self drawTile:tiles[i]];
+        }
+    }
+    
+    // Step 3: show the cached tiles in the layers of the tiles that went off the screen, without animations.
+    NSMutableArray<CALayer *> *reusableTileLayers = [_tileLayers.allValues mutableCopy];
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    CGFloat pointsPerPixel = CGRectGetWidth(_imageView.bounds) / _tileGrid.imageWidth;
+    for (NSIndexPath *indexPath in shownTiles) {
+        RSKTileKey key = { [indexPath indexAtPosition:0], [indexPath indexAtPosition:1], [indexPath indexAtPosition:2] };
+        CALayer *tileLayer = tileLayers[indexPath];
+        if (!tileLayer) {
+            tileLayer = reusableTileLayers.lastObject;
+            if (tileLayer) {
+                [reusableTileLayers removeLastObject];
+            } else {
+                tileLayer = [CALayer layer];
+                [_tileView.layer addSublayer:tileLayer];
+            }
+            tileLayers[indexPath] = tileLayer;
+        }
+        CGRect imageRect = RSKTileGridGetTileImageRect(&_tileGrid, key);
+        tileLayer.contents = (__bridge id)RSKTileCacheGetTile(_tileCache, key);
+        tileLayer.frame = CGRectMake(CGRectGetMinX(imageRect) * pointsPerPixel, CGRectGetMinY(imageRect) * pointsPerPixel,
+                                     CGRectGetWidth(imageRect) * pointsPerPixel, CGRectGetHeight(imageRect) * pointsPerPixel);
+    }
+    for (CALayer *tileLayer in reusableTileLayers) {
+        [tileLayer removeFromSuperlayer];
+    }
+    [CATransaction commit];
+    _tileLayers = tileLayers;
+}
+
+- (void)drawTile:(RSKTileKey)key
+{
+    NSIndexPath *indexPath = RSKTileKeyIndexPath(key);
+    if ([_pendingTiles containsObject:indexPath]) {
+        return;
+    }
+    [_pendingTiles addObject:indexPath];
+    
+    // Step 1: draw the tile in the background, one at a time. Only the pixels of the tile are cut out of the level of
+    // the tile, in the pixels of the level without the orientation of the image, and drawn upright.
+    RSKImagePyramidLevels *pyramidLevels = _pyramidLevels;
+    UIImageOrientation orientation = _image.imageOrientation;
+    NSUInteger generation = _tileGeneration;
+    CGRect tileRect = RSKTileGridGetTileRect(&_tileGrid, key);
+    dispatch_async(_tileQueue, ^{
+        
+        CGImageRef tileImageRef = NULL;
+        CGImageRef levelImageRef = [pyramidLevels copyLevelImage:key.level];
+        if (levelImageRef) {
+            CGAffineTransform transform = RSKImageOrientationTransform(orientation, CGImageGetWidth(levelImageRef), CGImageGetHeight(levelImageRef));
+            CGImageRef regionImageRef = CGImageCreateWithImageInRect(levelImageRef, CGRectApplyAffineTransform(tileRect, transform));
+            CGImageRelease(levelImageRef);
+            
+            // The tile is drawn into pixels of its own, so that it does not keep the level alive in the cache.
+            UIImage *regionImage = [UIImage imageWithCGImage:regionImageRef scale:1.0f orientation:orientation];
+            CGImageRelease(regionImageRef);
+            UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+            format.scale = 1.0f;
+            UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:tileRect.size format:format];
+            UIImage *tileImage = [renderer imageWithActions:^(__unused UIGraphicsImageRendererContext *context) {
+                [regionImage drawInRect:CGRectMake(0.0f, 0.0f, CGRectGetWidth(tileRect), CGRectGetHeight(tileRect))];
+            }];
+            tileImageRef = CGImageRetain(tileImage.CGImage);
+        }
+        
+        // Step 2: cache the tile and show it unless another image is wanted by then.
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (generation != self->_tileGeneration) {
+                CGImageRelease(tileImageRef);
+                return;
+            }
+            [self->_pendingTiles removeObject:indexPath];
+            if (!tileImageRef) {
+                return;
+            }
+            size_t byteCount = CGImageGetBytesPerRow(tileImageRef) * CGImageGetHeight(tileImageRef);
+            if (RSKTileCacheInsertTile(self->_tileCache, key, (void *)tileImageRef, byteCount)) {
+                [self updateTiles];
+            }
+        });
+    });
+}
+
 #pragma mark - Configure scrollView to display new image
 
 - (void)setMaxMinZoomScalesForCurrentBounds
@@ -0,0 +1,203 @@
+//
+// RSKAnimatedCrop.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKAnimatedCrop.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "RSKThreadPool.hpp"
+
+namespace {
+
+using namespace rsk;
+
+// A cropped frame that waits for the frames before it to be written.
+struct CroppedFrame {
+    bool isReady = false;
+    RSKCropStatus status = RSKCropStatusSuccess;
+    std::vector<uint8_t> pixels;
+    RSKBitmap bitmap = {};
+};
+
+// Crops the frames of an animation on the threads of an executor and writes them in order.
+//
+// A worker takes the next frame only while fewer than `residentFrameCount` frames are taken and not yet written. The
+// cropped frames wait in a ring of that many slots, and whichever worker fills the slot of the next frame to write
+// becomes the writer until it reaches a frame that is not ready, so no thread is set aside for writing.
+class AnimatedCrop {
+public:
+    AnimatedCrop(size_t frameCount, const RSKCropSpec &spec, const RSKAnimatedCropCallbacks &callbacks, size_t residentFrameCount)
+        : frameCount_(frameCount),
+          spec_(spec),
+          callbacks_(callbacks),
+          frames_(residentFrameCount)
+    {
+    }
+
+    RSKCropStatus Run(const RSKExecutor *executor, size_t workerCount);
+
+private:
+    static void RunWorker(void *context, size_t index);
+    bool TakeFrame(size_t &index);
+    void CropFrame(size_t index, CroppedFrame &frame);
+    void FinishFrame(size_t index, CroppedFrame &frame);
+
+    const size_t frameCount_;
+    const RSKCropSpec spec_;
+    const RSKAnimatedCropCallbacks callbacks_;
+
+    // Guards everything below.
+    std::mutex mutex_;
+    std::condition_variable frameWritten_;
+    std::vector<CroppedFrame> frames_;
+    size_t nextFrame_ = 0;
+    size_t writtenFrameCount_ = 0;
+    bool isWriting_ = false;
+    RSKCropStatus status_ = RSKCropStatusSuccess;
+};
+
+RSKCropStatus AnimatedCrop::Run(const RSKExecutor *executor, size_t workerCount)
+{
+    ParallelFor(executor, workerCount, this, RunWorker);
+    return status_;
+}
+
+void AnimatedCrop::RunWorker(void *context, size_t)
+{
+    AnimatedCrop &crop = *static_cast<AnimatedCrop *>(context);
+    size_t index = 0;
+    while (crop.TakeFrame(index)) {
+        CroppedFrame frame;
+        crop.CropFrame(index, frame);
+        crop.FinishFrame(index, frame);
+    }
+}
+
+bool AnimatedCrop::TakeFrame(size_t &index)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    frameWritten_.wait(lock, [this] {
+        return nextFrame_ < writtenFrameCount_ + frames_.size() || nextFrame_ == frameCount_ || status_ != RSKCropStatusSuccess;
+    });
+    if (nextFrame_ == frameCount_ || status_ != RSKCropStatusSuccess) {
+        return false;
+    }
+    index = nextFrame_++;
+    return true;
+}
+
+void AnimatedCrop::CropFrame(size_t index, CroppedFrame &frame)
+{
+    RSKBatchImage image = {};
+    if (!callbacks_.decode(callbacks_.context, index, &image)) {
+        frame.status = RSKCropStatusReadFailed;
+        return;
+    }
+
+    const RSKBitmap &source = image.bitmap;
+    const CGSize size = RSKCropEngineGetOutputSize(source.width, source.height, &spec_);
+    const size_t width = static_cast<size_t>(size.width);
+    const size_t height = static_cast<size_t>(size.height);
+    if (width == 0 || height == 0) {
+        frame.status = RSKCropStatusInvalidArgument;
+    } else {
+        try {
+            const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(source.pixelFormat);
+            frame.pixels.resize(width * height * bytesPerPixel);
+            frame.bitmap = RSKBitmapMake(frame.pixels.data(), width, height, width * bytesPerPixel, source.pixelFormat);
+            frame.status = RSKCropEngineCropBitmap(&source, &spec_, &frame.bitmap);
+        } catch (const std::bad_alloc &) {
+            frame.status = RSKCropStatusOutOfMemory;
+        }
+    }
+
+    // The source is freed as soon as it is cropped, so a frame that waits to be written only holds its result.
+    if (image.release) {
+        image.release(image.releaseContext, &image.bitmap);
+    }
+}
+
+void AnimatedCrop::FinishFrame(size_t index, CroppedFrame &frame)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    frame.isReady = true;
+    frames_[index % frames_.size()] = std::move(frame);
+    if (isWriting_) {
+        return;
+    }
+
+    // Write every frame that is ready, in order, without holding the lock while the sink runs.
+    isWriting_ = true;
+    while (status_ == RSKCropStatusSuccess && writtenFrameCount_ < frameCount_) {
+        CroppedFrame &nextFrame = frames_[writtenFrameCount_ % frames_.size()];
+        if (!nextFrame.isReady) {
+            break;
+        }
+        CroppedFrame readyFrame = std::move(nextFrame);
+        nextFrame = CroppedFrame();
+        const size_t readyIndex = writtenFrameCount_;
+        lock.unlock();
+
+        RSKCropStatus status = readyFrame.status;
+        if (status == RSKCropStatusSuccess && !callbacks_.write(callbacks_.context, readyIndex, &readyFrame.bitmap)) {
+            status = RSKCropStatusWriteFailed;
+        }
+        readyFrame = CroppedFrame();
+
+        lock.lock();
+        status_ = status;
+        writtenFrameCount_++;
+        frameWritten_.notify_all();
+    }
+    isWriting_ = false;
+}
+
+} // namespace
+
+RSKCropStatus RSKCropEngineCropAnimated(size_t frameCount, const RSKCropSpec *spec, const RSKAnimatedCropCallbacks *callbacks, const RSKAnimatedCropOptions *options)
+{
+    if (!spec || !callbacks || !callbacks->decode || !callbacks->write) {
+        return RSKCropStatusInvalidArgument;
+    }
+    if (frameCount == 0) {
+        return RSKCropStatusSuccess;
+    }
+
+    const RSKExecutor *executor = options ? options->executor : nullptr;
+    const size_t concurrency = executor ? std::max<size_t>(executor->concurrency, 1) : 1;
+    size_t residentFrameCount = options && options->residentFrameCount > 0 ? options->residentFrameCount : concurrency * 2;
+    residentFrameCount = std::min(residentFrameCount, frameCount);
+    const size_t workerCount = std::min(concurrency, residentFrameCount);
+
+    try {
+        AnimatedCrop animatedCrop(frameCount, *spec, *callbacks, residentFrameCount);
+        return animatedCrop.Run(executor, workerCount);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
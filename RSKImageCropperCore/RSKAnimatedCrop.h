@@ -0,0 +1,79 @@
+//
+// RSKAnimatedCrop.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKAnimatedCrop_h
+#define RSKAnimatedCrop_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "RSKBatchCrop.h"
+#include "RSKBitmap.h"
+#include "RSKCropEngine.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Decodes the frame `index` of an animation into `frame`. Returns false if the frame cannot be decoded.
+typedef bool (*RSKAnimatedCropDecodeFunction)(void *context, size_t index, RSKBatchImage *frame);
+
+// Hands over `croppedFrame`, the result of the frame `index`, to an encoder or any other sink. Frames are handed over
+// one at a time and in order. The pixels are only valid during the call. Returns false if the frame cannot be written,
+// which stops the crop.
+typedef bool (*RSKAnimatedCropWriteFunction)(void *context, size_t index, const RSKBitmap *croppedFrame);
+
+// The ends of an animated crop that are supplied by the caller. Several frames may be decoded at once, on the threads
+// of the executor.
+struct RSKAnimatedCropCallbacks {
+    RSKAnimatedCropDecodeFunction decode;
+    RSKAnimatedCropWriteFunction write;
+    void *context;
+};
+typedef struct RSKAnimatedCropCallbacks RSKAnimatedCropCallbacks;
+
+// Options of an animated crop. Zero values select the defaults.
+struct RSKAnimatedCropOptions {
+    // The number of frames that may be in memory at once, from the start of their decoding until they are written.
+    // Defaults to twice the concurrency of `executor`.
+    size_t residentFrameCount;
+    // The executor that crops several frames at once. Defaults to cropping one frame at a time on the calling thread.
+    const RSKExecutor *executor;
+};
+typedef struct RSKAnimatedCropOptions RSKAnimatedCropOptions;
+
+// Crops the `frameCount` frames that `callbacks` decode according to `spec` and writes the results in order. Every
+// frame is cropped, rotated and masked in one pass like `RSKCropEngineCropBitmap`, and frames are cropped concurrently
+// on `executor`, but no more than `residentFrameCount` of them are in memory at once, so the memory of a crop does not
+// grow with the length of the animation. `options` may be null.
+// Returns `RSKCropStatusSuccess` once every frame is written. Otherwise returns the status of the first frame that
+// could not be decoded, cropped or written; the frames after it are not written.
+RSKCropStatus RSKCropEngineCropAnimated(size_t frameCount, const RSKCropSpec *spec, const RSKAnimatedCropCallbacks *callbacks, const RSKAnimatedCropOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKAnimatedCrop_h */
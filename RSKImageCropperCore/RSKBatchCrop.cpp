@@ -0,0 +1,238 @@
+//
+// RSKBatchCrop.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKBatchCrop.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "RSKBoundedQueue.hpp"
+#include "RSKCropEngine.hpp"
+
+namespace {
+
+using namespace rsk;
+
+constexpr size_t kDefaultQueueCapacity = 4;
+
+// A decoded source on its way to be cropped.
+struct DecodedImage {
+    size_t index = 0;
+    RSKCropStatus status = RSKCropStatusSuccess;
+    RSKBatchImage image = {};
+};
+
+// A cropped source on its way to be encoded.
+struct CroppedImage {
+    size_t index = 0;
+    RSKCropStatus status = RSKCropStatusSuccess;
+    std::vector<uint8_t> pixels;
+    RSKBitmap bitmap = {};
+};
+
+void ReleaseImage(RSKBatchImage &image)
+{
+    if (image.release) {
+        image.release(image.releaseContext, &image.bitmap);
+    }
+}
+
+class BatchCrop {
+public:
+    BatchCrop(size_t count, const RSKCropSpec &spec, const RSKBatchCallbacks &callbacks, const RSKBatchOptions &options)
+        : count_(count),
+          spec_(spec),
+          callbacks_(callbacks),
+          options_(options),
+          decodedImages_(options.queueCapacity > 0 ? options.queueCapacity : kDefaultQueueCapacity),
+          croppedImages_(options.queueCapacity > 0 ? options.queueCapacity : kDefaultQueueCapacity)
+    {
+    }
+
+    RSKCropStatus Run();
+
+private:
+    void Decode();
+    void FinishDecoding();
+    void Crop();
+    void Encode();
+    CroppedImage CropImage(DecodedImage &decodedImage);
+
+    const size_t count_;
+    const RSKCropSpec spec_;
+    const RSKBatchCallbacks callbacks_;
+    const RSKBatchOptions options_;
+
+    std::atomic<size_t> nextIndex_{ 0 };
+    std::atomic<size_t> runningDecoderCount_{ 0 };
+    BoundedQueue<DecodedImage> decodedImages_;
+    BoundedQueue<CroppedImage> croppedImages_;
+};
+
+RSKCropStatus BatchCrop::Run()
+{
+    const size_t decodeThreadCount = std::max<size_t>(options_.decodeThreadCount, 1);
+    const size_t encodeThreadCount = std::max<size_t>(options_.encodeThreadCount, 1);
+    std::vector<std::thread> decoders;
+    std::vector<std::thread> encoders;
+    decoders.reserve(decodeThreadCount);
+    encoders.reserve(encodeThreadCount);
+
+    // Step 1: start the stages that encode and decode. The calling thread counts as a decoder until every decoder has
+    // started, so the crop stage does not stop early. If a thread cannot be started, either because the system refuses
+    // it or because its state cannot be allocated, the sources that are left are skipped and the threads that did start
+    // finish their work. Nothing below throws, so they are always joined.
+    RSKCropStatus status = RSKCropStatusSuccess;
+    runningDecoderCount_ = 1;
+    try {
+        for (size_t i = 0; i < encodeThreadCount; i++) {
+            encoders.emplace_back(&BatchCrop::Encode, this);
+        }
+        for (size_t i = 0; i < decodeThreadCount; i++) {
+            runningDecoderCount_++;
+            decoders.emplace_back(&BatchCrop::Decode, this);
+        }
+    } catch (const std::exception &) {
+        status = RSKCropStatusOutOfMemory;
+        nextIndex_ = count_;
+        if (encoders.size() == encodeThreadCount) {
+            // The decoder that did not start was counted already.
+            runningDecoderCount_--;
+        }
+    }
+    FinishDecoding();
+
+    // Step 2: crop on the calling thread until every decoded source is cropped.
+    Crop();
+
+    // Step 3: wait for the results to be encoded.
+    croppedImages_.Close();
+    for (std::thread &decoder : decoders) {
+        decoder.join();
+    }
+    for (std::thread &encoder : encoders) {
+        encoder.join();
+    }
+    return status;
+}
+
+void BatchCrop::Decode()
+{
+    for (size_t index = nextIndex_++; index < count_; index = nextIndex_++) {
+        DecodedImage decodedImage;
+        decodedImage.index = index;
+        if (!callbacks_.decode(callbacks_.context, index, &decodedImage.image)) {
+            decodedImage.status = RSKCropStatusReadFailed;
+        }
+        decodedImages_.Push(decodedImage);
+    }
+
+    FinishDecoding();
+}
+
+void BatchCrop::FinishDecoding()
+{
+    // The last decoder tells the crop stage that no more sources are coming.
+    if (--runningDecoderCount_ == 0) {
+        decodedImages_.Close();
+    }
+}
+
+void BatchCrop::Crop()
+{
+    DecodedImage decodedImage;
+    while (decodedImages_.Pop(decodedImage)) {
+        CroppedImage croppedImage;
+        if (decodedImage.status == RSKCropStatusSuccess) {
+            // Running out of memory fails this source only; the next ones may be smaller.
+            try {
+                croppedImage = CropImage(decodedImage);
+            } catch (const std::bad_alloc &) {
+                croppedImage.status = RSKCropStatusOutOfMemory;
+            }
+            ReleaseImage(decodedImage.image);
+        }
+        croppedImage.index = decodedImage.index;
+        if (croppedImage.status == RSKCropStatusSuccess) {
+            croppedImage.status = decodedImage.status;
+        }
+        croppedImages_.Push(std::move(croppedImage));
+    }
+}
+
+CroppedImage BatchCrop::CropImage(DecodedImage &decodedImage)
+{
+    CroppedImage croppedImage;
+    const RSKBitmap &source = decodedImage.image.bitmap;
+    const RSKCropSpec spec = ScaleCropSpec(spec_, options_.referenceSize, source.width, source.height);
+
+    CGSize size = RSKCropEngineGetOutputSize(source.width, source.height, &spec);
+    const size_t width = static_cast<size_t>(size.width);
+    const size_t height = static_cast<size_t>(size.height);
+    if (width == 0 || height == 0) {
+        croppedImage.status = RSKCropStatusInvalidArgument;
+        return croppedImage;
+    }
+
+    const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(source.pixelFormat);
+    croppedImage.pixels.resize(width * height * bytesPerPixel);
+    croppedImage.bitmap = RSKBitmapMake(croppedImage.pixels.data(), width, height, width * bytesPerPixel, source.pixelFormat);
+    croppedImage.status = RSKCropEngineCropBitmapWithExecutor(&source, &spec, options_.executor, &croppedImage.bitmap);
+    return croppedImage;
+}
+
+void BatchCrop::Encode()
+{
+    CroppedImage croppedImage;
+    while (croppedImages_.Pop(croppedImage)) {
+        RSKCropStatus status = croppedImage.status;
+        if (status == RSKCropStatusSuccess && !callbacks_.encode(callbacks_.context, croppedImage.index, &croppedImage.bitmap)) {
+            status = RSKCropStatusWriteFailed;
+        }
+        if (callbacks_.complete) {
+            callbacks_.complete(callbacks_.context, croppedImage.index, status);
+        }
+        croppedImage = CroppedImage();
+    }
+}
+
+} // namespace
+
+RSKCropStatus RSKCropEngineCropBatch(size_t count, const RSKCropSpec *spec, const RSKBatchCallbacks *callbacks, const RSKBatchOptions *options)
+{
+    if (!spec || !callbacks || !callbacks->decode || !callbacks->encode) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    try {
+        BatchCrop batchCrop(count, *spec, *callbacks, options ? *options : RSKBatchOptions());
+        return batchCrop.Run();
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
@@ -0,0 +1,98 @@
+//
+// RSKBatchCrop.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBatchCrop_h
+#define RSKBatchCrop_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKCoreGraphics.h"
+#include "RSKCropEngine.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A source of a batch crop, decoded into pixels that are owned by the decoder.
+struct RSKBatchImage {
+    RSKBitmap bitmap;
+    // Frees the pixels of `bitmap` once they have been cropped. May be null.
+    void (*release)(void *releaseContext, const RSKBitmap *bitmap);
+    void *releaseContext;
+};
+typedef struct RSKBatchImage RSKBatchImage;
+
+// Decodes the source `index` into `image`. Returns false if the source cannot be decoded.
+typedef bool (*RSKBatchDecodeFunction)(void *context, size_t index, RSKBatchImage *image);
+
+// Encodes `croppedImage`, the result of the source `index`. The pixels are only valid during the call. Returns false
+// if the result cannot be encoded.
+typedef bool (*RSKBatchEncodeFunction)(void *context, size_t index, const RSKBitmap *croppedImage);
+
+// Reports that the source `index` is done: `RSKCropStatusSuccess` once its result is encoded, otherwise
+// `RSKCropStatusReadFailed` if it could not be decoded, `RSKCropStatusWriteFailed` if its result could not be
+// encoded, or the status of its crop.
+typedef void (*RSKBatchCompletionFunction)(void *context, size_t index, RSKCropStatus status);
+
+// The stages of a batch crop that are supplied by the caller. Every function is called from the threads of its stage,
+// so several calls of the same function may run at once if the stage has several threads.
+struct RSKBatchCallbacks {
+    RSKBatchDecodeFunction decode;
+    RSKBatchEncodeFunction encode;
+    // Called from the threads that encode. May be null.
+    RSKBatchCompletionFunction complete;
+    void *context;
+};
+typedef struct RSKBatchCallbacks RSKBatchCallbacks;
+
+// Options of a batch crop. Zero values select the defaults.
+struct RSKBatchOptions {
+    // The size, in pixels, of the source that the spec was made for. The rects of the spec and the scale of its mask
+    // are scaled to every source of another size, like renditions of the same photo. Defaults to using the spec as is.
+    CGSize referenceSize;
+    // The number of images that may wait between two stages. Defaults to 4.
+    size_t queueCapacity;
+    // The number of threads that decode and that encode. Default to 1.
+    size_t decodeThreadCount;
+    size_t encodeThreadCount;
+    // The executor that crops the bands of every image concurrently. Defaults to cropping on a single thread.
+    const RSKExecutor *executor;
+};
+typedef struct RSKBatchOptions RSKBatchOptions;
+
+// Crops the `count` sources that `callbacks` decode according to `spec` and hands the results to `callbacks` to be
+// encoded. Decoding, cropping and encoding run at the same time on different images, each stage on its own threads,
+// with bounded queues between them, so at most a few images are in memory at once. Cropping runs on the calling thread,
+// which returns once every source is done. `options` may be null.
+// Returns `RSKCropStatusSuccess` once every source is done, whatever their own statuses are.
+RSKCropStatus RSKCropEngineCropBatch(size_t count, const RSKCropSpec *spec, const RSKBatchCallbacks *callbacks, const RSKBatchOptions *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKBatchCrop_h */
@@ -0,0 +1,49 @@
+//
+// RSKBitmap.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKBitmap.h"
+
+RSKBitmap RSKBitmapMake(void *data, size_t width, size_t height, size_t bytesPerRow, RSKPixelFormat pixelFormat)
+{
+    RSKBitmap bitmap;
+    bitmap.data = data;
+    bitmap.width = width;
+    bitmap.height = height;
+    bitmap.bytesPerRow = bytesPerRow;
+    bitmap.pixelFormat = pixelFormat;
+    return bitmap;
+}
+
+size_t RSKPixelFormatGetBytesPerPixel(RSKPixelFormat pixelFormat)
+{
+    switch (pixelFormat) {
+        case RSKPixelFormatRGBA8888:
+        case RSKPixelFormatBGRA8888:
+            return 4;
+        case RSKPixelFormatRGBA16:
+        case RSKPixelFormatRGBAHalf:
+            return 8;
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+//
+// RSKBitmap.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBitmap_h
+#define RSKBitmap_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pixel formats understood by the crop core. Color components are premultiplied by alpha and alpha is always the last
+// component, so the crop kernels never need to know the color order. The components are in the color space of the
+// source, which the crop core never converts, so wide-gamut and extended-range pixels stay as they are.
+typedef enum RSKPixelFormat {
+    RSKPixelFormatRGBA8888,
+    RSKPixelFormatBGRA8888,
+    // 16-bit unsigned components in the byte order of the host, like `kCGBitmapByteOrder16Host`.
+    RSKPixelFormatRGBA16,
+    // 16-bit IEEE half floats in the byte order of the host, like `kCGBitmapFloatComponents`. Components may lie
+    // outside of 0 to 1, as extended-range colors do, only alpha is kept within it.
+    RSKPixelFormatRGBAHalf
+} RSKPixelFormat;
+
+// A pixel buffer that is owned by the caller.
+struct RSKBitmap {
+    void *data;
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    RSKPixelFormat pixelFormat;
+};
+typedef struct RSKBitmap RSKBitmap;
+
+// Make a bitmap that describes the caller-owned `data`.
+RSKBitmap RSKBitmapMake(void *data, size_t width, size_t height, size_t bytesPerRow, RSKPixelFormat pixelFormat);
+
+// Returns the number of bytes used by one pixel of `pixelFormat`.
+size_t RSKPixelFormatGetBytesPerPixel(RSKPixelFormat pixelFormat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKBitmap_h */
@@ -0,0 +1,200 @@
+//
+// RSKBorrowedBitmap.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKBorrowedBitmap.hpp"
+
+#include <memory>
+#include <new>
+
+#include "RSKBufferPool.h"
+#include "RSKCropEngine.hpp"
+#include "RSKImageTransforms.hpp"
+#include "RSKMappedFile.hpp"
+
+namespace {
+
+using namespace rsk;
+
+void DeleteMappedFile(void *context)
+{
+    delete static_cast<MappedFile *>(context);
+}
+
+// Returns whether `bitmap` is a valid view of `length` bytes at `offset` of its data.
+bool FitsIntoLength(const RSKBitmap &bitmap, size_t offset, size_t length)
+{
+    if (!IsValidBitmap(&bitmap) || offset > length) {
+        return false;
+    }
+    const size_t available = length - offset;
+    const size_t lastRowLength = bitmap.width * RSKPixelFormatGetBytesPerPixel(bitmap.pixelFormat);
+    return lastRowLength <= available && bitmap.height - 1 <= (available - lastRowLength) / bitmap.bytesPerRow;
+}
+
+// Returns whether `spec` only selects the pixels of a rect of a source of `sourceWidth` x `sourceHeight` pixels, and
+// which rect it is.
+bool GetSubviewMapping(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropPixelMapping &mapping)
+{
+    return GetCropPixelMapping(sourceWidth, sourceHeight, spec, mapping) && !mapping.swapsAxes && !mapping.flipsHorizontally && !mapping.flipsVertically;
+}
+
+RSKCropStatus CropBorrowedBitmap(const RSKBorrowedBitmap &source, const RSKCropSpec &spec, const RSKExecutor *executor, RSKBorrowedBitmap &result)
+{
+    const RSKBitmap &bitmap = source.bitmap;
+
+    // Step 1: a crop that only selects a rect of the source is a view of its pixels.
+    CropPixelMapping mapping;
+    if (GetSubviewMapping(bitmap.width, bitmap.height, spec, mapping)) {
+        uint8_t *data = static_cast<uint8_t *>(bitmap.data) + mapping.y * bitmap.bytesPerRow + mapping.x * RSKPixelFormatGetBytesPerPixel(bitmap.pixelFormat);
+        result = RSKBorrowedBitmapMake(RSKBitmapMake(data, mapping.width, mapping.height, bitmap.bytesPerRow, bitmap.pixelFormat), source.owner);
+        return RSKCropStatusSuccess;
+    }
+
+    // Step 2: any other crop draws new pixels.
+    const CGSize outputSize = RSKCropEngineGetOutputSize(bitmap.width, bitmap.height, &spec);
+    const size_t width = static_cast<size_t>(outputSize.width);
+    const size_t height = static_cast<size_t>(outputSize.height);
+    if (width == 0 || height == 0) {
+        return RSKCropStatusInvalidArgument;
+    }
+    RSKBorrowedBitmap pixels;
+    RSKCropStatus status = RSKBufferPoolMakeBitmap(RSKBufferPoolGetShared(), width, height, bitmap.pixelFormat, &pixels);
+    if (status != RSKCropStatusSuccess) {
+        return status;
+    }
+    status = RSKCropEngineCropBitmapWithExecutor(&bitmap, &spec, executor, &pixels.bitmap);
+    if (status != RSKCropStatusSuccess) {
+        RSKBorrowedBitmapRelease(&pixels);
+        return status;
+    }
+    result = pixels;
+    return RSKCropStatusSuccess;
+}
+
+} // namespace
+
+RSKPixelOwner *RSKPixelOwnerCreate(void *context, RSKPixelOwnerReleaseFunction release)
+{
+    RSKPixelOwner *owner = new (std::nothrow) RSKPixelOwner;
+    if (owner) {
+        owner->context = context;
+        owner->release = release;
+    }
+    return owner;
+}
+
+RSKPixelOwner *RSKPixelOwnerRetain(RSKPixelOwner *owner)
+{
+    if (owner) {
+        owner->referenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return owner;
+}
+
+void RSKPixelOwnerRelease(RSKPixelOwner *owner)
+{
+    if (!owner || owner->referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    // An embedded owner is freed by its release function, so read it first.
+    const RSKPixelOwnerReleaseFunction release = owner->release;
+    void *context = owner->context;
+    if (!owner->isEmbedded) {
+        delete owner;
+    }
+    if (release) {
+        release(context);
+    }
+}
+
+RSKBorrowedBitmap RSKBorrowedBitmapMake(RSKBitmap bitmap, RSKPixelOwner *owner)
+{
+    RSKBorrowedBitmap borrowedBitmap;
+    borrowedBitmap.bitmap = bitmap;
+    borrowedBitmap.owner = RSKPixelOwnerRetain(owner);
+    return borrowedBitmap;
+}
+
+RSKCropStatus RSKBorrowedBitmapMapFile(const char *path, size_t offset, size_t width, size_t height, size_t bytesPerRow, RSKPixelFormat pixelFormat, RSKBorrowedBitmap *result)
+{
+    if (!path || !result) {
+        return RSKCropStatusInvalidArgument;
+    }
+    *result = {};
+
+    std::unique_ptr<MappedFile> file(new (std::nothrow) MappedFile(path));
+    if (!file) {
+        return RSKCropStatusOutOfMemory;
+    }
+    if (!file->Data()) {
+        return RSKCropStatusReadFailed;
+    }
+    // The pixels are mapped read-only, and the crop engine never writes to its source. They are only pointed to past
+    // the offset once the bitmap is known to fit into the file, since a pointer past the mapping is undefined.
+    RSKBitmap bitmap = RSKBitmapMake(const_cast<void *>(file->Data()), width, height, bytesPerRow, pixelFormat);
+    if (!FitsIntoLength(bitmap, offset, file->Length())) {
+        return RSKCropStatusInvalidArgument;
+    }
+    bitmap.data = static_cast<uint8_t *>(bitmap.data) + offset;
+    RSKPixelOwner *owner = RSKPixelOwnerCreate(file.get(), DeleteMappedFile);
+    if (!owner) {
+        return RSKCropStatusOutOfMemory;
+    }
+    file.release();
+    result->bitmap = bitmap;
+    result->owner = owner;
+    return RSKCropStatusSuccess;
+}
+
+void RSKBorrowedBitmapRelease(RSKBorrowedBitmap *bitmap)
+{
+    if (bitmap) {
+        RSKPixelOwnerRelease(bitmap->owner);
+        *bitmap = {};
+    }
+}
+
+bool RSKCropEngineGetSubviewRect(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec *spec, CGRect *rect)
+{
+    CropPixelMapping mapping;
+    if (!spec || !rect || !GetSubviewMapping(sourceWidth, sourceHeight, *spec, mapping)) {
+        return false;
+    }
+    *rect = CGRectMake(mapping.x, mapping.y, mapping.width, mapping.height);
+    return true;
+}
+
+RSKCropStatus RSKCropEngineCropBorrowedBitmap(const RSKBorrowedBitmap *source, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBorrowedBitmap *result)
+{
+    if (!source || !IsValidBitmap(&source->bitmap) || !spec || !result) {
+        return RSKCropStatusInvalidArgument;
+    }
+    *result = {};
+
+    try {
+        return CropBorrowedBitmap(*source, *spec, executor, *result);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
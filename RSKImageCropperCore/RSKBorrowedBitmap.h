@@ -0,0 +1,93 @@
+//
+// RSKBorrowedBitmap.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBorrowedBitmap_h
+#define RSKBorrowedBitmap_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKCoreGraphics.h"
+#include "RSKCropEngine.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A reference-counted owner of pixels that the crop engine borrows, such as a mapped file, the output buffer of a
+// decoder or a locked `CVPixelBuffer`. It is safe to retain and release from any thread.
+typedef struct RSKPixelOwner RSKPixelOwner;
+
+// Called with `context` when the last reference to an owner is released, to free the pixels.
+typedef void (*RSKPixelOwnerReleaseFunction)(void *context);
+
+// Creates an owner with one reference that calls `release`, which may be null, with `context` once it is no longer
+// referenced. Returns null if there is not enough memory, in which case `release` is not called.
+RSKPixelOwner *RSKPixelOwnerCreate(void *context, RSKPixelOwnerReleaseFunction release);
+
+// Adds a reference to `owner` and returns it. `owner` may be null.
+RSKPixelOwner *RSKPixelOwnerRetain(RSKPixelOwner *owner);
+
+// Removes a reference from `owner`. `owner` may be null.
+void RSKPixelOwnerRelease(RSKPixelOwner *owner);
+
+// A bitmap whose pixels are kept alive by `owner`. Several bitmaps may share the pixels of one owner, every one of
+// them with its own reference to it.
+typedef struct RSKBorrowedBitmap {
+    RSKBitmap bitmap;
+    RSKPixelOwner *owner;
+} RSKBorrowedBitmap;
+
+// Returns a bitmap of `bitmap` that holds a new reference to `owner`.
+RSKBorrowedBitmap RSKBorrowedBitmapMake(RSKBitmap bitmap, RSKPixelOwner *owner);
+
+// Maps the raw pixels of the file at `path`, starting `offset` bytes into it, into memory without reading them, so
+// only the pages that are touched are loaded. The pixels are read-only. Returns `RSKCropStatusReadFailed` if the file
+// cannot be mapped, and `RSKCropStatusInvalidArgument` if it is too short for the described bitmap.
+RSKCropStatus RSKBorrowedBitmapMapFile(const char *path, size_t offset, size_t width, size_t height, size_t bytesPerRow, RSKPixelFormat pixelFormat, RSKBorrowedBitmap *result);
+
+// Releases the reference of `bitmap` to its owner and clears it.
+void RSKBorrowedBitmapRelease(RSKBorrowedBitmap *bitmap);
+
+// Returns true if cropping a source of `sourceWidth` x `sourceHeight` pixels according to `spec` produces the pixels
+// of the source inside of `rect` as they are. That is the case when the result is neither scaled, rotated, flipped nor
+// masked and lies inside of the image, like the crops that `croppedImage:` of `RSKImageCropViewController` used to
+// return without drawing them.
+bool RSKCropEngineGetSubviewRect(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec *spec, CGRect *rect);
+
+// Crops `source` according to `spec` into `result`, which the caller releases with `RSKBorrowedBitmapRelease`.
+//
+// If the crop only selects a rect of the source, see `RSKCropEngineGetSubviewRect`, the result is a view of the pixels
+// of the source that shares its owner, and no pixel is copied. Otherwise the result owns new pixels of the pixel format
+// of the source that are cropped like `RSKCropEngineCropBitmapWithExecutor` does, in a buffer of the shared pool of
+// `RSKBufferPoolGetShared` that goes back to the pool once the result is released. `executor` may be null.
+RSKCropStatus RSKCropEngineCropBorrowedBitmap(const RSKBorrowedBitmap *source, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBorrowedBitmap *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKBorrowedBitmap_h */
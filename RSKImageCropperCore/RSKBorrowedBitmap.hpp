@@ -0,0 +1,42 @@
+//
+// RSKBorrowedBitmap.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBorrowedBitmap_hpp
+#define RSKBorrowedBitmap_hpp
+
+#include <atomic>
+#include <cstddef>
+
+#include "RSKBorrowedBitmap.h"
+
+// The owner behind `RSKPixelOwner`. It is defined here so that an owner can live inside of the memory it frees.
+struct RSKPixelOwner {
+    std::atomic<size_t> referenceCount { 1 };
+    void *context = nullptr;
+    RSKPixelOwnerReleaseFunction release = nullptr;
+    // Whether `release` frees the owner along with the pixels, instead of it having come from `RSKPixelOwnerCreate`.
+    bool isEmbedded = false;
+};
+
+#endif /* RSKBorrowedBitmap_hpp */
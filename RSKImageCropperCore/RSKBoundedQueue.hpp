@@ -0,0 +1,97 @@
+//
+// RSKBoundedQueue.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBoundedQueue_hpp
+#define RSKBoundedQueue_hpp
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rsk {
+
+// A queue between the threads of two stages of a pipeline that holds at most `capacity` items, so a fast stage waits
+// for a slow one instead of piling up its results. The room for the items is allocated up front, so once the stages
+// are running, passing an item on never runs out of memory.
+template <typename T>
+class BoundedQueue {
+    static_assert(std::is_nothrow_move_assignable<T>::value, "Moving an item into the queue must not throw.");
+
+public:
+    explicit BoundedQueue(size_t capacity) : items_(capacity > 0 ? capacity : 1) {}
+
+    // Waits until there is room and adds `item`.
+    void Push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        hasRoom_.wait(lock, [this] { return count_ < items_.size(); });
+        items_[(first_ + count_) % items_.size()] = std::move(item);
+        count_++;
+        lock.unlock();
+        hasItems_.notify_one();
+    }
+
+    // Waits until there is an item and removes it into `item`. Returns false once the queue is closed and empty.
+    bool Pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        hasItems_.wait(lock, [this] { return count_ > 0 || isClosed_; });
+        if (count_ == 0) {
+            return false;
+        }
+        item = std::move(items_[first_]);
+        first_ = (first_ + 1) % items_.size();
+        count_--;
+        lock.unlock();
+        hasRoom_.notify_one();
+        return true;
+    }
+
+    // Tells the consumers that no more items are added.
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            isClosed_ = true;
+        }
+        hasItems_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable hasItems_;
+    std::condition_variable hasRoom_;
+    // A ring of items, of which `count_` starting at `first_` are in the queue.
+    std::vector<T> items_;
+    size_t first_ = 0;
+    size_t count_ = 0;
+    bool isClosed_ = false;
+};
+
+} // namespace rsk
+
+#endif /* RSKBoundedQueue_hpp */
@@ -0,0 +1,329 @@
+//
+// RSKBufferPool.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKBufferPool.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "RSKBorrowedBitmap.hpp"
+
+struct RSKBufferPool {
+    explicit RSKBufferPool(size_t highWaterMark) : pool(highWaterMark) {}
+
+    rsk::BufferPool pool;
+};
+
+namespace rsk {
+
+namespace {
+
+// The bytes of idle buffers a pool keeps unless it is told otherwise.
+constexpr size_t kDefaultHighWaterMark = 32 * 1024 * 1024;
+
+// The capacity of the smallest size class, and its base-2 logarithm.
+constexpr unsigned kMinimumCapacityShift = 12;
+constexpr size_t kMinimumCapacity = size_t(1) << kMinimumCapacityShift;
+
+// Every power of two is split into this many size classes.
+constexpr unsigned kClassesPerPowerOfTwo = 4;
+
+constexpr size_t kSizeClassCount = (sizeof(size_t) * 8 - kMinimumCapacityShift) * kClassesPerPowerOfTwo + 1;
+
+// Returns the index of the most significant bit of `value`, which must not be zero.
+unsigned GetHighestBit(size_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Returns the size class of a buffer of `size` bytes, and sets `capacity` to the size of the buffers of that class.
+// Throws `std::bad_alloc` if the class would not fit into `size_t`.
+size_t GetSizeClass(size_t size, size_t &capacity)
+{
+    if (size <= kMinimumCapacity) {
+        capacity = kMinimumCapacity;
+        return 0;
+    }
+    if (size > (SIZE_MAX >> 1)) {
+        throw std::bad_alloc();
+    }
+    // Split the powers of two into quarters: a size between 2^n and 2^(n+1) takes the next quarter step of 2^n.
+    const unsigned shift = GetHighestBit(size - 1);
+    const size_t step = size_t(1) << (shift - 2);
+    const size_t quarters = (size - 1) >> (shift - 2);
+    capacity = (quarters + 1) * step;
+    return (shift - kMinimumCapacityShift) * kClassesPerPowerOfTwo + (quarters - kClassesPerPowerOfTwo) + 1;
+}
+
+// Returns the size of the buffers of `sizeClass`, which is the inverse of `GetSizeClass`.
+size_t GetSizeClassCapacity(size_t sizeClass)
+{
+    if (sizeClass == 0) {
+        return kMinimumCapacity;
+    }
+    const size_t shift = (sizeClass - 1) / kClassesPerPowerOfTwo + kMinimumCapacityShift;
+    const size_t quarters = (sizeClass - 1) % kClassesPerPowerOfTwo + kClassesPerPowerOfTwo;
+    return (quarters + 1) << (shift - 2);
+}
+
+// The start of a bitmap of `RSKBufferPoolMakeBitmap`, whose owner returns it to its pool.
+struct PooledBitmapHeader {
+    BufferPool *pool;
+    size_t capacity;
+    RSKPixelOwner owner;
+};
+
+// The pixels follow the header at a cache line.
+constexpr size_t kPooledBitmapHeaderSize = (sizeof(PooledBitmapHeader) + 63) / 64 * 64;
+
+void ReturnPooledBitmap(void *context)
+{
+    PooledBitmapHeader *header = static_cast<PooledBitmapHeader *>(context);
+    BufferPool *pool = header->pool;
+    const size_t capacity = header->capacity;
+    header->~PooledBitmapHeader();
+    pool->Return(header, capacity);
+}
+
+} // namespace
+
+BufferPool::BufferPool(size_t highWaterMark)
+    : idleBuffers_(kSizeClassCount),
+      highWaterMark_(highWaterMark > 0 ? highWaterMark : kDefaultHighWaterMark)
+{
+}
+
+BufferPool::~BufferPool()
+{
+    TrimLocked(0);
+}
+
+void *BufferPool::Take(size_t size, size_t &capacity)
+{
+    const size_t sizeClass = GetSizeClass(size, capacity);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<void *> &buffers = idleBuffers_[sizeClass];
+        if (!buffers.empty()) {
+            void *data = buffers.back();
+            buffers.pop_back();
+            stats_.hitCount++;
+            stats_.idleBytes -= capacity;
+            return data;
+        }
+    }
+
+    // Step 1: allocate a new buffer outside of the lock.
+    void *data = std::malloc(capacity);
+    if (!data) {
+        // Step 2: the idle buffers of other classes may be what keeps the allocation from succeeding.
+        Trim(0);
+        data = std::malloc(capacity);
+        if (!data) {
+            throw std::bad_alloc();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.missCount++;
+    stats_.residentBytes += capacity;
+    return data;
+}
+
+void BufferPool::Return(void *data, size_t size)
+{
+    size_t capacity;
+    const size_t sizeClass = GetSizeClass(size, capacity);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stats_.idleBytes + capacity <= highWaterMark_) {
+            try {
+                idleBuffers_[sizeClass].push_back(data);
+                stats_.idleBytes += capacity;
+                return;
+            } catch (const std::bad_alloc &) {
+            }
+        }
+        stats_.residentBytes -= capacity;
+    }
+    std::free(data);
+}
+
+void BufferPool::SetHighWaterMark(size_t highWaterMark)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    highWaterMark_ = highWaterMark;
+    TrimLocked(highWaterMark);
+}
+
+void BufferPool::Trim(size_t idleBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked(idleBytes);
+}
+
+void BufferPool::TrimLocked(size_t idleBytes)
+{
+    for (size_t sizeClass = idleBuffers_.size(); sizeClass > 0 && stats_.idleBytes > idleBytes; sizeClass--) {
+        std::vector<void *> &buffers = idleBuffers_[sizeClass - 1];
+        const size_t capacity = GetSizeClassCapacity(sizeClass - 1);
+        while (!buffers.empty() && stats_.idleBytes > idleBytes) {
+            std::free(buffers.back());
+            buffers.pop_back();
+            stats_.idleBytes -= capacity;
+            stats_.residentBytes -= capacity;
+        }
+    }
+}
+
+RSKBufferPoolStats BufferPool::Stats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+BufferPool &SharedBufferPool()
+{
+    return RSKBufferPoolGetShared()->pool;
+}
+
+PooledBuffer::PooledBuffer(BufferPool &pool, size_t size)
+    : pool_(&pool),
+      size_(size)
+{
+    data_ = pool.Take(size, capacity_);
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer &&other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)),
+      data_(std::exchange(other.data_, nullptr)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      size_(std::exchange(other.size_, 0))
+{
+}
+
+PooledBuffer &PooledBuffer::operator=(PooledBuffer &&other) noexcept
+{
+    if (this != &other) {
+        Reset();
+        pool_ = std::exchange(other.pool_, nullptr);
+        data_ = std::exchange(other.data_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void PooledBuffer::Reset()
+{
+    if (data_) {
+        pool_->Return(data_, capacity_);
+    }
+    pool_ = nullptr;
+    data_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+}
+
+} // namespace rsk
+
+RSKBufferPool *RSKBufferPoolCreate(size_t highWaterMark)
+{
+    return new (std::nothrow) RSKBufferPool(highWaterMark);
+}
+
+void RSKBufferPoolDestroy(RSKBufferPool *pool)
+{
+    delete pool;
+}
+
+RSKBufferPool *RSKBufferPoolGetShared(void)
+{
+    // Never destroyed, so that buffers may still be returned while the process exits.
+    static RSKBufferPool *pool = new RSKBufferPool(0);
+    return pool;
+}
+
+void RSKBufferPoolSetHighWaterMark(RSKBufferPool *pool, size_t highWaterMark)
+{
+    if (pool) {
+        pool->pool.SetHighWaterMark(highWaterMark);
+    }
+}
+
+void RSKBufferPoolTrim(RSKBufferPool *pool, size_t idleBytes)
+{
+    if (pool) {
+        pool->pool.Trim(idleBytes);
+    }
+}
+
+RSKBufferPoolStats RSKBufferPoolGetStats(RSKBufferPool *pool)
+{
+    return pool ? pool->pool.Stats() : RSKBufferPoolStats {};
+}
+
+RSKCropStatus RSKBufferPoolMakeBitmap(RSKBufferPool *pool, size_t width, size_t height, RSKPixelFormat pixelFormat, RSKBorrowedBitmap *result)
+{
+    using namespace rsk;
+
+    if (!result) {
+        return RSKCropStatusInvalidArgument;
+    }
+    *result = {};
+    const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(pixelFormat);
+    if (!pool || width == 0 || height == 0 || bytesPerPixel == 0) {
+        return RSKCropStatusInvalidArgument;
+    }
+    const size_t bytesPerRow = width * bytesPerPixel;
+    if (bytesPerRow / bytesPerPixel != width || height > (SIZE_MAX - kPooledBitmapHeaderSize) / bytesPerRow) {
+        return RSKCropStatusOutOfMemory;
+    }
+
+    // The owner lives in front of the pixels, so that neither of them is allocated once the pool is warm.
+    size_t capacity;
+    void *data;
+    try {
+        data = pool->pool.Take(kPooledBitmapHeaderSize + height * bytesPerRow, capacity);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+    PooledBitmapHeader *header = new (data) PooledBitmapHeader { &pool->pool, capacity, {} };
+    header->owner.context = header;
+    header->owner.release = ReturnPooledBitmap;
+    header->owner.isEmbedded = true;
+    result->bitmap = RSKBitmapMake(static_cast<uint8_t *>(data) + kPooledBitmapHeaderSize, width, height, bytesPerRow, pixelFormat);
+    result->owner = &header->owner;
+    return RSKCropStatusSuccess;
+}
@@ -0,0 +1,85 @@
+//
+// RSKBufferPool.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBufferPool_h
+#define RSKBufferPool_h
+
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKBorrowedBitmap.h"
+#include "RSKCropEngine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A pool of pixel buffers that are reused instead of being freed, so that repeated crops neither go to the allocator
+// nor fault in fresh pages. Buffers are sorted into size classes of a quarter of a power of two, and a request takes
+// the smallest idle buffer of its class. It is safe to use from any thread.
+typedef struct RSKBufferPool RSKBufferPool;
+
+// Counters of a pool.
+typedef struct RSKBufferPoolStats {
+    // The number of buffers that were taken from the idle buffers of the pool.
+    size_t hitCount;
+    // The number of buffers that had to be allocated.
+    size_t missCount;
+    // The bytes of the buffers that the pool has allocated and not freed, in use or idle.
+    size_t residentBytes;
+    // The bytes of the idle buffers that the pool keeps for reuse.
+    size_t idleBytes;
+} RSKBufferPoolStats;
+
+// Creates a pool that keeps up to `highWaterMark` bytes of idle buffers. Zero selects 32 MB. Returns null if there is
+// not enough memory.
+RSKBufferPool *RSKBufferPoolCreate(size_t highWaterMark);
+
+// Destroys `pool` and frees its idle buffers. No buffer of the pool may be in use.
+void RSKBufferPoolDestroy(RSKBufferPool *pool);
+
+// Returns the pool that the crop engine draws its scratch buffers from. It keeps up to 32 MB of idle buffers, and is
+// never destroyed.
+RSKBufferPool *RSKBufferPoolGetShared(void);
+
+// Sets the bytes of idle buffers that `pool` keeps at most, and frees the idle buffers above it. Zero keeps none, so
+// every buffer is allocated and freed as if there was no pool.
+void RSKBufferPoolSetHighWaterMark(RSKBufferPool *pool, size_t highWaterMark);
+
+// Frees idle buffers of `pool`, the largest first, until at most `idleBytes` of them are left. Zero frees them all,
+// which is what an app does on a memory warning.
+void RSKBufferPoolTrim(RSKBufferPool *pool, size_t idleBytes);
+
+// Returns the counters of `pool`.
+RSKBufferPoolStats RSKBufferPoolGetStats(RSKBufferPool *pool);
+
+// Takes a tightly packed bitmap of `width` x `height` pixels from `pool` into `result`, whose owner returns it to the
+// pool once it is released. Its pixels are not cleared. Returns `RSKCropStatusOutOfMemory` if it cannot be allocated.
+RSKCropStatus RSKBufferPoolMakeBitmap(RSKBufferPool *pool, size_t width, size_t height, RSKPixelFormat pixelFormat, RSKBorrowedBitmap *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKBufferPool_h */
@@ -0,0 +1,176 @@
+//
+// RSKBufferPool.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKBufferPool_hpp
+#define RSKBufferPool_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "RSKBufferPool.h"
+
+namespace rsk {
+
+// The pool behind `RSKBufferPool`.
+class BufferPool {
+public:
+    explicit BufferPool(size_t highWaterMark);
+    ~BufferPool();
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    // Returns a buffer of at least `size` bytes and sets `capacity` to its size. Throws `std::bad_alloc` if it cannot
+    // be allocated.
+    void *Take(size_t size, size_t &capacity);
+
+    // Returns the buffer `data` to the pool. `size` is the size it was taken with, or its capacity.
+    void Return(void *data, size_t size);
+
+    void SetHighWaterMark(size_t highWaterMark);
+    void Trim(size_t idleBytes);
+    RSKBufferPoolStats Stats();
+
+private:
+    // Frees idle buffers, the largest first, until at most `idleBytes` of them are left. Must be called with the mutex
+    // locked.
+    void TrimLocked(size_t idleBytes);
+
+    std::mutex mutex_;
+    std::vector<std::vector<void *>> idleBuffers_;
+    size_t highWaterMark_;
+    RSKBufferPoolStats stats_ = {};
+};
+
+// Returns the pool of `RSKBufferPoolGetShared`.
+BufferPool &SharedBufferPool();
+
+// A buffer of a pool that goes back to the pool when it is destroyed. An empty buffer has no pool.
+class PooledBuffer {
+public:
+    PooledBuffer() = default;
+
+    // Takes a buffer of `size` bytes from `pool`. Throws `std::bad_alloc` if it cannot be allocated.
+    PooledBuffer(BufferPool &pool, size_t size);
+
+    ~PooledBuffer() { Reset(); }
+
+    PooledBuffer(PooledBuffer &&other) noexcept;
+    PooledBuffer &operator=(PooledBuffer &&other) noexcept;
+
+    uint8_t *Data() const { return static_cast<uint8_t *>(data_); }
+    size_t Size() const { return size_; }
+
+    // Returns the buffer to its pool and empties it.
+    void Reset();
+
+private:
+    BufferPool *pool_ = nullptr;
+    void *data_ = nullptr;
+    size_t capacity_ = 0;
+    size_t size_ = 0;
+};
+
+// A buffer of `count` values of `T` of the shared pool. The values are not initialized.
+template <typename T>
+class ScratchArray {
+public:
+    explicit ScratchArray(size_t count)
+        : buffer_(count > 0 ? PooledBuffer(SharedBufferPool(), count * sizeof(T)) : PooledBuffer()),
+          count_(count)
+    {
+    }
+
+    T *Data() const { return reinterpret_cast<T *>(buffer_.Data()); }
+    size_t Size() const { return count_; }
+    T &operator[](size_t index) const { return Data()[index]; }
+
+private:
+    PooledBuffer buffer_;
+    size_t count_;
+};
+
+// An allocator of the shared pool, for the containers of the crop engine that are made for every crop.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *allocate(size_t count)
+    {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        size_t capacity;
+        return static_cast<T *>(SharedBufferPool().Take(count * sizeof(T), capacity));
+    }
+
+    void deallocate(T *data, size_t count) { SharedBufferPool().Return(data, count * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
+
+template <typename T>
+using PooledVector = std::vector<T, PoolAllocator<T>>;
+
+// An object of the shared pool, which may be owned through a pointer to one of its bases.
+template <typename T>
+using PooledPointer = std::unique_ptr<T, void (*)(T *)>;
+
+// Makes a `Derived` of `arguments` in a buffer of the shared pool, owned through a pointer to `T`.
+template <typename T, typename Derived = T, typename... Arguments>
+PooledPointer<T> MakePooled(Arguments &&...arguments)
+{
+    PoolAllocator<Derived> allocator;
+    Derived *object = allocator.allocate(1);
+    try {
+        new (object) Derived(std::forward<Arguments>(arguments)...);
+    } catch (...) {
+        allocator.deallocate(object, 1);
+        throw;
+    }
+    return PooledPointer<T>(object, [](T *pointer) {
+        Derived *object = static_cast<Derived *>(pointer);
+        object->~Derived();
+        PoolAllocator<Derived>().deallocate(object, 1);
+    });
+}
+
+} // namespace rsk
+
+#endif /* RSKBufferPool_hpp */
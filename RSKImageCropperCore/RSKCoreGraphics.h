@@ -0,0 +1,321 @@
+//
+// RSKCoreGraphics.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKCoreGraphics_h
+#define RSKCoreGraphics_h
+
+// The crop core is written against the CoreGraphics geometry types so that the view controller can hand its values
+// over unchanged. On platforms without CoreGraphics we declare the small subset of it that the core relies on.
+
+#if __has_include(<CoreGraphics/CoreGraphics.h>)
+
+    #include <CoreGraphics/CoreGraphics.h>
+
+#else
+
+    #include <float.h>
+    #include <math.h>
+    #include <stdbool.h>
+
+    #ifdef __cplusplus
+        #define CG_EXTERN extern "C"
+    #else
+        #define CG_EXTERN extern
+    #endif
+
+    #define CG_INLINE static inline
+
+    // `RSK_CGFLOAT_IS_FLOAT` builds the core with the single precision `CGFloat` of 32-bit Apple platforms.
+    #if defined(RSK_CGFLOAT_IS_FLOAT) && RSK_CGFLOAT_IS_FLOAT
+        #define CGFLOAT_IS_DOUBLE 0
+        #define CGFLOAT_MIN FLT_MIN
+        #define CGFLOAT_MAX FLT_MAX
+        #define CGFLOAT_EPSILON FLT_EPSILON
+
+        typedef float CGFloat;
+    #else
+        #define CGFLOAT_IS_DOUBLE 1
+        #define CGFLOAT_MIN DBL_MIN
+        #define CGFLOAT_MAX DBL_MAX
+        #define CGFLOAT_EPSILON DBL_EPSILON
+
+        typedef double CGFloat;
+    #endif
+
+    struct CGPoint {
+        CGFloat x;
+        CGFloat y;
+    };
+    typedef struct CGPoint CGPoint;
+
+    struct CGSize {
+        CGFloat width;
+        CGFloat height;
+    };
+    typedef struct CGSize CGSize;
+
+    struct CGRect {
+        CGPoint origin;
+        CGSize size;
+    };
+    typedef struct CGRect CGRect;
+
+    struct CGAffineTransform {
+        CGFloat a, b, c, d;
+        CGFloat tx, ty;
+    };
+    typedef struct CGAffineTransform CGAffineTransform;
+
+    static const CGPoint CGPointZero = { 0, 0 };
+    static const CGSize CGSizeZero = { 0, 0 };
+    static const CGRect CGRectZero = { { 0, 0 }, { 0, 0 } };
+    static const CGRect CGRectNull = { { INFINITY, INFINITY }, { 0, 0 } };
+    static const CGAffineTransform CGAffineTransformIdentity = { 1, 0, 0, 1, 0, 0 };
+
+    CG_INLINE CGPoint CGPointMake(CGFloat x, CGFloat y)
+    {
+        CGPoint p; p.x = x; p.y = y; return p;
+    }
+
+    CG_INLINE CGSize CGSizeMake(CGFloat width, CGFloat height)
+    {
+        CGSize size; size.width = width; size.height = height; return size;
+    }
+
+    CG_INLINE CGRect CGRectMake(CGFloat x, CGFloat y, CGFloat width, CGFloat height)
+    {
+        CGRect rect;
+        rect.origin.x = x; rect.origin.y = y;
+        rect.size.width = width; rect.size.height = height;
+        return rect;
+    }
+
+    CG_INLINE bool CGPointEqualToPoint(CGPoint point1, CGPoint point2)
+    {
+        return point1.x == point2.x && point1.y == point2.y;
+    }
+
+    CG_INLINE bool CGSizeEqualToSize(CGSize size1, CGSize size2)
+    {
+        return size1.width == size2.width && size1.height == size2.height;
+    }
+
+    CG_INLINE bool CGRectIsNull(CGRect rect)
+    {
+        return isinf(rect.origin.x) || isinf(rect.origin.y);
+    }
+
+    CG_INLINE CGRect CGRectStandardize(CGRect rect)
+    {
+        if (CGRectIsNull(rect)) {
+            return rect;
+        }
+        if (rect.size.width < 0) {
+            rect.origin.x += rect.size.width;
+            rect.size.width = -rect.size.width;
+        }
+        if (rect.size.height < 0) {
+            rect.origin.y += rect.size.height;
+            rect.size.height = -rect.size.height;
+        }
+        return rect;
+    }
+
+    CG_INLINE CGFloat CGRectGetMinX(CGRect rect) { return CGRectStandardize(rect).origin.x; }
+    CG_INLINE CGFloat CGRectGetMinY(CGRect rect) { return CGRectStandardize(rect).origin.y; }
+    CG_INLINE CGFloat CGRectGetWidth(CGRect rect) { return fabs(rect.size.width); }
+    CG_INLINE CGFloat CGRectGetHeight(CGRect rect) { return fabs(rect.size.height); }
+    CG_INLINE CGFloat CGRectGetMaxX(CGRect rect) { return CGRectGetMinX(rect) + CGRectGetWidth(rect); }
+    CG_INLINE CGFloat CGRectGetMaxY(CGRect rect) { return CGRectGetMinY(rect) + CGRectGetHeight(rect); }
+    CG_INLINE CGFloat CGRectGetMidX(CGRect rect) { return CGRectGetMinX(rect) + CGRectGetWidth(rect) * 0.5; }
+    CG_INLINE CGFloat CGRectGetMidY(CGRect rect) { return CGRectGetMinY(rect) + CGRectGetHeight(rect) * 0.5; }
+
+    CG_INLINE bool CGRectIsEmpty(CGRect rect)
+    {
+        return CGRectIsNull(rect) || rect.size.width == 0 || rect.size.height == 0;
+    }
+
+    CG_INLINE bool CGRectEqualToRect(CGRect rect1, CGRect rect2)
+    {
+        rect1 = CGRectStandardize(rect1);
+        rect2 = CGRectStandardize(rect2);
+        return CGPointEqualToPoint(rect1.origin, rect2.origin) && CGSizeEqualToSize(rect1.size, rect2.size);
+    }
+
+    CG_INLINE CGRect CGRectOffset(CGRect rect, CGFloat dx, CGFloat dy)
+    {
+        if (CGRectIsNull(rect)) {
+            return rect;
+        }
+        rect = CGRectStandardize(rect);
+        rect.origin.x += dx;
+        rect.origin.y += dy;
+        return rect;
+    }
+
+    CG_INLINE CGRect CGRectInset(CGRect rect, CGFloat dx, CGFloat dy)
+    {
+        rect = CGRectStandardize(rect);
+        rect.origin.x += dx;
+        rect.origin.y += dy;
+        rect.size.width -= dx * 2;
+        rect.size.height -= dy * 2;
+        if (rect.size.width < 0 || rect.size.height < 0) {
+            return CGRectNull;
+        }
+        return rect;
+    }
+
+    CG_INLINE CGRect CGRectIntegral(CGRect rect)
+    {
+        if (CGRectIsNull(rect)) {
+            return rect;
+        }
+        rect = CGRectStandardize(rect);
+        CGFloat minX = floor(rect.origin.x);
+        CGFloat minY = floor(rect.origin.y);
+        CGFloat maxX = ceil(rect.origin.x + rect.size.width);
+        CGFloat maxY = ceil(rect.origin.y + rect.size.height);
+        return CGRectMake(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    CG_INLINE CGRect CGRectIntersection(CGRect rect1, CGRect rect2)
+    {
+        if (CGRectIsNull(rect1) || CGRectIsNull(rect2)) {
+            return CGRectNull;
+        }
+        CGFloat minX = fmax(CGRectGetMinX(rect1), CGRectGetMinX(rect2));
+        CGFloat minY = fmax(CGRectGetMinY(rect1), CGRectGetMinY(rect2));
+        CGFloat maxX = fmin(CGRectGetMaxX(rect1), CGRectGetMaxX(rect2));
+        CGFloat maxY = fmin(CGRectGetMaxY(rect1), CGRectGetMaxY(rect2));
+        if (maxX < minX || maxY < minY) {
+            return CGRectNull;
+        }
+        return CGRectMake(minX, minY, maxX - minX, maxY - minY);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformMake(CGFloat a, CGFloat b, CGFloat c, CGFloat d, CGFloat tx, CGFloat ty)
+    {
+        CGAffineTransform t;
+        t.a = a; t.b = b; t.c = c; t.d = d; t.tx = tx; t.ty = ty;
+        return t;
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformMakeTranslation(CGFloat tx, CGFloat ty)
+    {
+        return CGAffineTransformMake(1, 0, 0, 1, tx, ty);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformMakeScale(CGFloat sx, CGFloat sy)
+    {
+        return CGAffineTransformMake(sx, 0, 0, sy, 0, 0);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformMakeRotation(CGFloat angle)
+    {
+        CGFloat sine = sin(angle);
+        CGFloat cosine = cos(angle);
+        return CGAffineTransformMake(cosine, sine, -sine, cosine, 0, 0);
+    }
+
+    CG_INLINE bool CGAffineTransformIsIdentity(CGAffineTransform t)
+    {
+        return t.a == 1 && t.b == 0 && t.c == 0 && t.d == 1 && t.tx == 0 && t.ty == 0;
+    }
+
+    // Returns the transform that applies `t1` and then `t2`.
+    CG_INLINE CGAffineTransform CGAffineTransformConcat(CGAffineTransform t1, CGAffineTransform t2)
+    {
+        return CGAffineTransformMake(t1.a * t2.a + t1.b * t2.c,
+                                     t1.a * t2.b + t1.b * t2.d,
+                                     t1.c * t2.a + t1.d * t2.c,
+                                     t1.c * t2.b + t1.d * t2.d,
+                                     t1.tx * t2.a + t1.ty * t2.c + t2.tx,
+                                     t1.tx * t2.b + t1.ty * t2.d + t2.ty);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformTranslate(CGAffineTransform t, CGFloat tx, CGFloat ty)
+    {
+        return CGAffineTransformConcat(CGAffineTransformMakeTranslation(tx, ty), t);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformScale(CGAffineTransform t, CGFloat sx, CGFloat sy)
+    {
+        return CGAffineTransformConcat(CGAffineTransformMakeScale(sx, sy), t);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformRotate(CGAffineTransform t, CGFloat angle)
+    {
+        return CGAffineTransformConcat(CGAffineTransformMakeRotation(angle), t);
+    }
+
+    CG_INLINE CGAffineTransform CGAffineTransformInvert(CGAffineTransform t)
+    {
+        CGFloat determinant = t.a * t.d - t.b * t.c;
+        if (determinant == 0) {
+            return t;
+        }
+        return CGAffineTransformMake(t.d / determinant,
+                                     -t.b / determinant,
+                                     -t.c / determinant,
+                                     t.a / determinant,
+                                     (t.c * t.ty - t.d * t.tx) / determinant,
+                                     (t.b * t.tx - t.a * t.ty) / determinant);
+    }
+
+    CG_INLINE CGPoint CGPointApplyAffineTransform(CGPoint point, CGAffineTransform t)
+    {
+        return CGPointMake(t.a * point.x + t.c * point.y + t.tx,
+                           t.b * point.x + t.d * point.y + t.ty);
+    }
+
+    CG_INLINE CGSize CGSizeApplyAffineTransform(CGSize size, CGAffineTransform t)
+    {
+        return CGSizeMake(t.a * size.width + t.c * size.height,
+                          t.b * size.width + t.d * size.height);
+    }
+
+    CG_INLINE CGRect CGRectApplyAffineTransform(CGRect rect, CGAffineTransform t)
+    {
+        if (CGRectIsNull(rect)) {
+            return rect;
+        }
+        CGFloat minX = CGRectGetMinX(rect);
+        CGFloat minY = CGRectGetMinY(rect);
+        CGFloat maxX = CGRectGetMaxX(rect);
+        CGFloat maxY = CGRectGetMaxY(rect);
+        CGPoint p1 = CGPointApplyAffineTransform(CGPointMake(minX, minY), t);
+        CGPoint p2 = CGPointApplyAffineTransform(CGPointMake(maxX, minY), t);
+        CGPoint p3 = CGPointApplyAffineTransform(CGPointMake(minX, maxY), t);
+        CGPoint p4 = CGPointApplyAffineTransform(CGPointMake(maxX, maxY), t);
+        CGFloat x1 = fmin(fmin(p1.x, p2.x), fmin(p3.x, p4.x));
+        CGFloat y1 = fmin(fmin(p1.y, p2.y), fmin(p3.y, p4.y));
+        CGFloat x2 = fmax(fmax(p1.x, p2.x), fmax(p3.x, p4.x));
+        CGFloat y2 = fmax(fmax(p1.y, p2.y), fmax(p3.y, p4.y));
+        return CGRectMake(x1, y1, x2 - x1, y2 - y1);
+    }
+
+#endif /* __has_include(<CoreGraphics/CoreGraphics.h>) */
+
+#endif /* RSKCoreGraphics_h */
@@ -0,0 +1,1040 @@
+//
+// RSKCropEngine.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKCropEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "RSKCropEngine.hpp"
+#include "RSKImageTransforms.hpp"
+#include "RSKMaskCache.hpp"
+#include "RSKMaskRasterizer.hpp"
+#include "RSKThreadPool.hpp"
+#include "RSKWarpKernels.hpp"
+
+namespace {
+
+using namespace rsk;
+
+// The maximum distance, in pixels, between a flattened curve of the mask and the curve itself.
+constexpr CGFloat kMaskFlatteningTolerance = 0.1;
+
+// The default size of the tiles of a tiled crop, and the size below which tiles are not made smaller to fit the memory
+// budget.
+constexpr size_t kDefaultTileSize = 256;
+constexpr size_t kMinimumTileSize = 16;
+
+// The number of rows of the bands of the result that are cropped concurrently. Small enough to balance the bands that
+// are mostly transparent in a rotated crop, large enough to keep the sampling of a band efficient.
+constexpr size_t kRowBandHeight = 32;
+
+// Sizes that are within this distance of a whole number of pixels are considered to be whole.
+constexpr CGFloat kPixelSizeTolerance = 0.001;
+
+// The maximum number of samples that are averaged along either axis of a pixel of a scaled result. The box filter
+// reduces the source first, so only results that are reduced much more along one axis than along the other use many.
+constexpr size_t kMaximumSamplesPerAxis = 8;
+
+// The largest magnitude of the coordinates and sizes of a spec, in pixels. It leaves room for the sums of coordinates
+// and for the rounding of the sizes to whole pixels, and is exact in single precision.
+constexpr CGFloat kMaximumCropCoordinate = 1 << 24;
+
+size_t PixelCount(CGFloat length)
+{
+    return static_cast<size_t>(std::max<CGFloat>(std::ceil(length - kPixelSizeTolerance), 0));
+}
+
+// Describes which pixels are read and written by a crop.
+struct CropLayout {
+    // The part of the source inside of the image rect.
+    size_t imageX = 0;
+    size_t imageY = 0;
+    size_t imageWidth = 0;
+    size_t imageHeight = 0;
+
+    // The size of the image rect after fixing its orientation.
+    size_t orientedWidth = 0;
+    size_t orientedHeight = 0;
+
+    // Whether the upright image rect is the result, so it does not need to be drawn into a crop rect sized canvas.
+    bool producesOrientedImage = false;
+
+    // The size of the crop at full resolution.
+    size_t canvasWidth = 0;
+    size_t canvasHeight = 0;
+
+    // The size of the result, which is the canvas scaled to the output size of the spec.
+    size_t outputWidth = 0;
+    size_t outputHeight = 0;
+
+    bool IsScaled() const { return outputWidth != canvasWidth || outputHeight != canvasHeight; }
+};
+
+// A rect of whole pixels.
+struct PixelRect {
+    size_t x = 0;
+    size_t y = 0;
+    size_t width = 0;
+    size_t height = 0;
+};
+
+// Returns the pixels of `rect`, whose edges are on whole pixels, or an empty rect if it is null or empty.
+PixelRect MakePixelRect(CGRect rect)
+{
+    PixelRect pixelRect;
+    if (!CGRectIsNull(rect) && !CGRectIsEmpty(rect)) {
+        pixelRect.x = static_cast<size_t>(CGRectGetMinX(rect));
+        pixelRect.y = static_cast<size_t>(CGRectGetMinY(rect));
+        pixelRect.width = static_cast<size_t>(CGRectGetWidth(rect));
+        pixelRect.height = static_cast<size_t>(CGRectGetHeight(rect));
+    }
+    return pixelRect;
+}
+
+bool IsValidRect(CGRect rect)
+{
+    return IsValidCoordinate(rect.origin.x) && IsValidCoordinate(rect.origin.y) && IsValidCoordinate(rect.size.width) && IsValidCoordinate(rect.size.height);
+}
+
+bool MakeCropLayout(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropLayout &layout)
+{
+    // Step 1: clip the image rect to the source. Like `CGImageCreateWithImageInRect`.
+    CGRect sourceRect = CGRectMake(0, 0, sourceWidth, sourceHeight);
+    CGRect imageRect = CGRectIntersection(CGRectIntegral(spec.imageRect), sourceRect);
+    if (CGRectIsNull(imageRect) || CGRectIsEmpty(imageRect)) {
+        return false;
+    }
+
+    layout.imageX = static_cast<size_t>(CGRectGetMinX(imageRect));
+    layout.imageY = static_cast<size_t>(CGRectGetMinY(imageRect));
+    layout.imageWidth = static_cast<size_t>(CGRectGetWidth(imageRect));
+    layout.imageHeight = static_cast<size_t>(CGRectGetHeight(imageRect));
+
+    // Step 2: fix the orientation of the image rect.
+    if (OrientationSwapsDimensions(spec.imageOrientation)) {
+        layout.orientedWidth = layout.imageHeight;
+        layout.orientedHeight = layout.imageWidth;
+    } else {
+        layout.orientedWidth = layout.imageWidth;
+        layout.orientedHeight = layout.imageHeight;
+    }
+
+    // Step 3: if the crop mode is `RSKCropModeCircle` or `RSKCropModeCustom`, the mask should not be applied,
+    // or the crop mode is `RSKCropModeSquare`, and the image is not rotated, the upright image rect is the result.
+    // Otherwise, the image is drawn into a canvas of the size of the crop rect.
+    layout.producesOrientedImage = (spec.cropMode == RSKCropModeSquare || !spec.applyMaskToCroppedImage) && spec.rotationAngle == 0.0;
+    if (layout.producesOrientedImage) {
+        layout.canvasWidth = layout.orientedWidth;
+        layout.canvasHeight = layout.orientedHeight;
+    } else {
+        layout.canvasWidth = PixelCount(CGRectGetWidth(spec.cropRect));
+        layout.canvasHeight = PixelCount(CGRectGetHeight(spec.cropRect));
+    }
+
+    // Step 4: scale the canvas to the output size, if there is one.
+    if (spec.outputSize.width > 0 || spec.outputSize.height > 0) {
+        layout.outputWidth = PixelCount(spec.outputSize.width);
+        layout.outputHeight = PixelCount(spec.outputSize.height);
+    } else {
+        layout.outputWidth = layout.canvasWidth;
+        layout.outputHeight = layout.canvasHeight;
+    }
+
+    return layout.canvasWidth > 0 && layout.canvasHeight > 0 && layout.outputWidth > 0 && layout.outputHeight > 0;
+}
+
+// Returns the mask path scaled to the image and centered in the canvas, like the clip of the crop, and scaled to the
+// result if the canvas is. The mask covers the part of the result inside of `rect`.
+//
+// In `RSKCropModeCircle` the mask path is the ellipse inscribed in its bounding box, so its coverage is computed
+// analytically. Other mask paths are rasterized.
+PooledPointer<CoverageMask> MakeCoverageMask(const RSKCropSpec &spec, const CropLayout &layout, const PixelRect &rect)
+{
+    // Step 1: scale the mask to the size of the crop rect.
+    CGFloat scale = 1.0 / spec.zoomScale;
+    CGRect bounds = CGRectApplyAffineTransform(PathBoundingBox(spec.maskPath), CGAffineTransformMakeScale(scale, scale));
+    if (CGRectIsNull(bounds)) {
+        return MakePooled<CoverageMask, PolygonCoverageMask>(std::vector<Contour>(), false, rect.width, rect.height);
+    }
+
+    // Step 2: center the mask, and scale it along with the canvas.
+    CGAffineTransform transform = CGAffineTransformMakeScale(scale, scale);
+    CGRect ellipse;
+    if (!layout.IsScaled()) {
+        CGPoint translation = CGPointMake(-CGRectGetMinX(bounds) + (layout.canvasWidth - CGRectGetWidth(bounds)) * 0.5 - rect.x,
+                                          -CGRectGetMinY(bounds) + (layout.canvasHeight - CGRectGetHeight(bounds)) * 0.5 - rect.y);
+        transform = CGAffineTransformConcat(transform, CGAffineTransformMakeTranslation(translation.x, translation.y));
+        ellipse = CGRectOffset(bounds, translation.x, translation.y);
+    } else {
+        CGPoint translation = CGPointMake(-CGRectGetMinX(bounds) + (layout.canvasWidth - CGRectGetWidth(bounds)) * 0.5,
+                                          -CGRectGetMinY(bounds) + (layout.canvasHeight - CGRectGetHeight(bounds)) * 0.5);
+        CGAffineTransform canvasTransform = CGAffineTransformMakeScale(static_cast<CGFloat>(layout.outputWidth) / layout.canvasWidth,
+                                                                       static_cast<CGFloat>(layout.outputHeight) / layout.canvasHeight);
+        canvasTransform = CGAffineTransformConcat(canvasTransform, CGAffineTransformMakeTranslation(-static_cast<CGFloat>(rect.x), -static_cast<CGFloat>(rect.y)));
+        transform = CGAffineTransformConcat(CGAffineTransformConcat(transform, CGAffineTransformMakeTranslation(translation.x, translation.y)), canvasTransform);
+        ellipse = CGRectApplyAffineTransform(CGRectOffset(bounds, translation.x, translation.y), canvasTransform);
+    }
+
+    if (spec.cropMode == RSKCropModeCircle) {
+        return MakePooled<CoverageMask, EllipseCoverageMask>(ellipse, rect.width, rect.height);
+    }
+
+    // Step 3: flatten the mask.
+    std::vector<Contour> contours = FlattenPath(spec.maskPath, transform, kMaskFlatteningTolerance);
+    return MakePooled<CoverageMask, PolygonCoverageMask>(contours, spec.maskPath.usesEvenOddFillRule, rect.width, rect.height);
+}
+
+// Returns the size of the image that is drawn into the canvas.
+CGSize DrawnImageSize(const RSKCropSpec &spec, const CropLayout &layout)
+{
+    if (spec.rotationAngle == 0.0) {
+        return CGSizeMake(layout.orientedWidth, layout.orientedHeight);
+    }
+    CGSize rotatedSize = RotatedSize(CGSizeMake(layout.orientedWidth, layout.orientedHeight), spec.rotationAngle);
+    return CGSizeMake(PixelCount(rotatedSize.width), PixelCount(rotatedSize.height));
+}
+
+// Returns the part of the canvas that the image is drawn into, clipped to the canvas.
+PixelRect DrawnImageRect(const RSKCropSpec &spec, const CropLayout &layout)
+{
+    CGSize drawnSize = DrawnImageSize(spec, layout);
+    CGFloat x = std::floor((static_cast<CGFloat>(layout.canvasWidth) - drawnSize.width) * 0.5);
+    CGFloat y = std::floor((static_cast<CGFloat>(layout.canvasHeight) - drawnSize.height) * 0.5);
+
+    CGRect canvasRect = CGRectMake(0, 0, layout.canvasWidth, layout.canvasHeight);
+    return MakePixelRect(CGRectIntersection(CGRectMake(x, y, drawnSize.width, drawnSize.height), canvasRect));
+}
+
+// Returns the transform that maps a point of the canvas to the matching point of the image rect.
+//
+// It undoes the steps that draw the image rect into the canvas in reverse order: the image is drawn in the center of
+// the canvas, rotated clockwise around its center and made upright.
+CGAffineTransform MakeSamplingTransform(const RSKCropSpec &spec, const CropLayout &layout)
+{
+    CGSize orientedSize = CGSizeMake(layout.orientedWidth, layout.orientedHeight);
+    CGSize drawnSize = DrawnImageSize(spec, layout);
+
+    // Step 1: move the origin to the top-left corner of the drawn image.
+    CGFloat x = std::floor((static_cast<CGFloat>(layout.canvasWidth) - drawnSize.width) * 0.5);
+    CGFloat y = std::floor((static_cast<CGFloat>(layout.canvasHeight) - drawnSize.height) * 0.5);
+    CGAffineTransform transform = CGAffineTransformMakeTranslation(-x, -y);
+
+    // Step 2: rotate counterclockwise around the center of the image.
+    if (spec.rotationAngle != 0.0) {
+        CGSize rotatedSize = RotatedSize(orientedSize, spec.rotationAngle);
+        transform = CGAffineTransformConcat(transform, CGAffineTransformMakeTranslation(-rotatedSize.width * 0.5, -rotatedSize.height * 0.5));
+        transform = CGAffineTransformConcat(transform, CGAffineTransformMakeRotation(-spec.rotationAngle));
+        transform = CGAffineTransformConcat(transform, CGAffineTransformMakeTranslation(orientedSize.width * 0.5, orientedSize.height * 0.5));
+    }
+
+    // Step 3: undo the orientation.
+    return CGAffineTransformConcat(transform, OrientationTransform(spec.imageOrientation, layout.imageWidth, layout.imageHeight));
+}
+
+bool IsValidTiledSource(const RSKTiledSource *source)
+{
+    return source && source->read && source->width > 0 && source->height > 0 &&
+           RSKPixelFormatGetBytesPerPixel(source->pixelFormat) > 0;
+}
+
+// Returns the pixels that are read to sample the pixels of the canvas inside of `rect` with `transform`, which may reach
+// past the image rect. Every pixel that `filter` may read is included.
+CGRect SampledFootprint(CGAffineTransform transform, RSKResamplingFilter filter, const PixelRect &rect)
+{
+    // The samples are taken at the centers of the pixels, which are at half pixels of the canvas and are shifted to
+    // whole indices of the image.
+    CGRect centers = CGRectMake(rect.x + 0.5, rect.y + 0.5, rect.width - 1.0, rect.height - 1.0);
+    CGRect samples = CGRectOffset(CGRectApplyAffineTransform(centers, transform), -0.5, -0.5);
+
+    // One more pixel on either side absorbs the rounding of the sample points along the rows.
+    const CGFloat radius = FilterRadius(filter) + 1;
+    CGRect footprint = CGRectMake(std::floor(CGRectGetMinX(samples)) - radius, std::floor(CGRectGetMinY(samples)) - radius, 0, 0);
+    footprint.size.width = std::floor(CGRectGetMaxX(samples)) + radius + 1 - footprint.origin.x;
+    footprint.size.height = std::floor(CGRectGetMaxY(samples)) + radius + 1 - footprint.origin.y;
+    return footprint;
+}
+
+// Returns the part of the image rect that is read to sample the pixels of the canvas inside of `rect` with `transform`,
+// clipped to the image rect.
+PixelRect SampledImageRect(const CropLayout &layout, CGAffineTransform transform, RSKResamplingFilter filter, const PixelRect &rect)
+{
+    const CGRect footprint = SampledFootprint(transform, filter, rect);
+    return MakePixelRect(CGRectIntersection(footprint, CGRectMake(0, 0, layout.imageWidth, layout.imageHeight)));
+}
+
+// Returns the pixels that are read to sample the pixels of a scaled result inside of `rect` with `transform`, which may
+// reach past the image rect. The samples are spread over the whole area of every pixel, and are taken from the image
+// reduced by `reductionFactor`, so the footprint is made of whole blocks of the reduction.
+CGRect ReducedFootprint(CGAffineTransform transform, RSKResamplingFilter filter, size_t reductionFactor, const PixelRect &rect)
+{
+    CGRect area = CGRectApplyAffineTransform(CGRectMake(rect.x, rect.y, rect.width, rect.height), transform);
+
+    // The filter reads pixels of the reduced image, which are `reductionFactor` pixels of the image apart.
+    const CGFloat factor = reductionFactor;
+    const CGFloat radius = (FilterRadius(filter) + 1) * factor;
+    const CGFloat minX = std::floor((std::floor(CGRectGetMinX(area)) - radius) / factor) * factor;
+    const CGFloat minY = std::floor((std::floor(CGRectGetMinY(area)) - radius) / factor) * factor;
+    const CGFloat maxX = std::ceil((std::ceil(CGRectGetMaxX(area)) + radius) / factor) * factor;
+    const CGFloat maxY = std::ceil((std::ceil(CGRectGetMaxY(area)) + radius) / factor) * factor;
+    return CGRectMake(minX, minY, maxX - minX, maxY - minY);
+}
+
+// Returns the part of the image rect that is read to sample the pixels of a scaled result inside of `rect` with
+// `transform`, clipped to the image rect.
+PixelRect ReducedImageRect(const CropLayout &layout, CGAffineTransform transform, RSKResamplingFilter filter, size_t reductionFactor, const PixelRect &rect)
+{
+    const CGRect footprint = ReducedFootprint(transform, filter, reductionFactor, rect);
+    return MakePixelRect(CGRectIntersection(footprint, CGRectMake(0, 0, layout.imageWidth, layout.imageHeight)));
+}
+
+// Returns the number of bytes of the pixel buffers of a tiled crop with tiles of `tileSize` and pixels of
+// `bytesPerPixel`. The part of the image that a tile samples is at most the size of the tile mapped by `transform`, plus
+// the radius of `filter` in pixels of the image reduced by `reductionFactor`.
+size_t TileBufferSize(size_t tileSize, size_t bytesPerPixel, CGAffineTransform transform, RSKResamplingFilter filter, size_t reductionFactor)
+{
+    const CGFloat size = tileSize;
+    const size_t margin = (2 * static_cast<size_t>(FilterRadius(filter)) + 4) * reductionFactor;
+    const size_t footprintWidth = static_cast<size_t>(std::ceil((std::fabs(transform.a) + std::fabs(transform.c)) * size)) + margin;
+    const size_t footprintHeight = static_cast<size_t>(std::ceil((std::fabs(transform.b) + std::fabs(transform.d)) * size)) + margin;
+    size_t footprintSize = footprintWidth * footprintHeight;
+    if (reductionFactor > 1) {
+        footprintSize += (footprintWidth / reductionFactor + 1) * (footprintHeight / reductionFactor + 1);
+    }
+
+    // The rows of the mask take a coverage byte and a sample count for every pixel of a tile.
+    return (tileSize * tileSize + footprintSize) * bytesPerPixel + tileSize * (1 + sizeof(int));
+}
+
+// Snaps `transform` to a quarter turn or a flip and a translation by whole pixels, which a rotation by a multiple of a
+// right angle only makes up to rounding errors. Returns false if it is not one.
+bool SnapToWholePixels(const CGAffineTransform &transform, CGAffineTransform &snappedTransform)
+{
+    const auto snap = [](CGFloat value, CGFloat &snappedValue) {
+        snappedValue = std::round(value);
+        return std::fabs(value - snappedValue) < kPixelSizeTolerance;
+    };
+    if (!snap(transform.a, snappedTransform.a) || !snap(transform.b, snappedTransform.b) || !snap(transform.c, snappedTransform.c) ||
+        !snap(transform.d, snappedTransform.d) || !snap(transform.tx, snappedTransform.tx) || !snap(transform.ty, snappedTransform.ty)) {
+        return false;
+    }
+    const CGAffineTransform &t = snappedTransform;
+    const bool keepsAxes = t.b == 0 && t.c == 0 && std::fabs(t.a) == 1 && std::fabs(t.d) == 1;
+    const bool swapsAxes = t.a == 0 && t.d == 0 && std::fabs(t.b) == 1 && std::fabs(t.c) == 1;
+    return keepsAxes || swapsAxes;
+}
+
+// Returns the orientation that `OrientBitmap` reads the pixels of a part of the image with that the snapped `transform`
+// maps a part of the result to.
+RSKImageOrientation OrientationOfTransform(const CGAffineTransform &transform)
+{
+    if (transform.a != 0) {
+        if (transform.a > 0) {
+            return transform.d > 0 ? RSKImageOrientationUp : RSKImageOrientationDownMirrored;
+        }
+        return transform.d > 0 ? RSKImageOrientationUpMirrored : RSKImageOrientationDown;
+    }
+    if (transform.c > 0) {
+        return transform.b > 0 ? RSKImageOrientationLeftMirrored : RSKImageOrientationRight;
+    }
+    return transform.b > 0 ? RSKImageOrientationLeft : RSKImageOrientationRightMirrored;
+}
+
+// Everything that is needed to crop any part of the result.
+struct CropPlan {
+    const RSKCropSpec *spec = nullptr;
+    CropLayout layout;
+    // Maps a point of the result to the matching point of the image rect.
+    CGAffineTransform transform = CGAffineTransformIdentity;
+    // The part of the result that the image is drawn into. The rest of the result is clear.
+    PixelRect drawnRect;
+
+    // A scaled result is sampled from the image rect reduced by a box filter of `reductionFactor` x `reductionFactor`
+    // pixels, averaging `samplesX` x `samplesY` samples for every pixel.
+    size_t reductionFactor = 1;
+    size_t samplesX = 1;
+    size_t samplesY = 1;
+    // Whether the edges of the image rect are extended rather than blended with the transparent outside, which is the
+    // case when a scaled result is not rotated, like drawing the image rect scaled.
+    bool clampsEdges = false;
+
+    // Whether the result is not scaled and `transform` is a quarter turn or a flip and a translation by whole pixels, in
+    // which case the pixels of the image rect are copied in `copyOrientation` rather than sampled. `copyTransform` is
+    // `transform` snapped to whole pixels.
+    bool copiesPixels = false;
+    CGAffineTransform copyTransform = CGAffineTransformIdentity;
+    RSKImageOrientation copyOrientation = RSKImageOrientationUp;
+
+    // The coverage of the whole mask of the result, which the parts share, or null if every part makes its own.
+    std::shared_ptr<const RasterizedMask> mask;
+};
+
+// Returns the number of samples along an axis of a pixel of the result that spans `length` pixels of the reduced image.
+size_t SamplesPerAxis(CGFloat length)
+{
+    const CGFloat samples = std::ceil(length - kPixelSizeTolerance);
+    return std::min(kMaximumSamplesPerAxis, static_cast<size_t>(std::max<CGFloat>(samples, 1)));
+}
+
+bool MakeCropPlan(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropPlan &plan)
+{
+    if (!MakeCropLayout(sourceWidth, sourceHeight, spec, plan.layout)) {
+        return false;
+    }
+
+    const CropLayout &layout = plan.layout;
+    plan.spec = &spec;
+    if (layout.producesOrientedImage) {
+        plan.transform = OrientationTransform(spec.imageOrientation, layout.imageWidth, layout.imageHeight);
+        plan.drawnRect.width = layout.canvasWidth;
+        plan.drawnRect.height = layout.canvasHeight;
+    } else {
+        plan.transform = MakeSamplingTransform(spec, layout);
+        plan.drawnRect = DrawnImageRect(spec, layout);
+    }
+    if (!layout.IsScaled()) {
+        CGAffineTransform copyTransform;
+        if (!layout.producesOrientedImage && SnapToWholePixels(plan.transform, copyTransform)) {
+            plan.copiesPixels = true;
+            plan.copyTransform = copyTransform;
+            plan.copyOrientation = OrientationOfTransform(copyTransform);
+        }
+        return true;
+    }
+
+    // A scaled result maps its pixels onto the canvas first. Pixels that the drawn image covers only in part are drawn.
+    const CGFloat scaleX = static_cast<CGFloat>(layout.canvasWidth) / layout.outputWidth;
+    const CGFloat scaleY = static_cast<CGFloat>(layout.canvasHeight) / layout.outputHeight;
+    plan.transform = CGAffineTransformConcat(CGAffineTransformMakeScale(scaleX, scaleY), plan.transform);
+    const CGRect drawnRect = CGRectMake(std::floor(plan.drawnRect.x / scaleX), std::floor(plan.drawnRect.y / scaleY), 0, 0);
+    const CGFloat maxX = std::min<CGFloat>(std::ceil((plan.drawnRect.x + plan.drawnRect.width) / scaleX), layout.outputWidth);
+    const CGFloat maxY = std::min<CGFloat>(std::ceil((plan.drawnRect.y + plan.drawnRect.height) / scaleY), layout.outputHeight);
+    plan.drawnRect = MakePixelRect(CGRectMake(drawnRect.origin.x, drawnRect.origin.y, maxX - drawnRect.origin.x, maxY - drawnRect.origin.y));
+
+    // The canvas is the image rotated and oriented, so a pixel of the result spans `scaleX` x `scaleY` pixels of the
+    // image. The box filter averages whole blocks of pixels cheaply and leaves a reduction of less than 2 along the
+    // shorter side of that area to the samples.
+    const CGFloat reduction = std::min(scaleX, scaleY);
+    plan.reductionFactor = reduction >= 2 ? static_cast<size_t>(reduction + kPixelSizeTolerance) : 1;
+    plan.samplesX = SamplesPerAxis(scaleX / plan.reductionFactor);
+    plan.samplesY = SamplesPerAxis(scaleY / plan.reductionFactor);
+    const CGAffineTransform &transform = plan.transform;
+    plan.clampsEdges = (transform.b == 0 && transform.c == 0) || (transform.a == 0 && transform.d == 0);
+    return true;
+}
+
+// Returns the part of `rect` that the image is drawn into.
+PixelRect DrawnPartOfRect(const CropPlan &plan, const PixelRect &rect)
+{
+    const size_t minX = std::max(rect.x, plan.drawnRect.x);
+    const size_t minY = std::max(rect.y, plan.drawnRect.y);
+    const size_t maxX = std::min(rect.x + rect.width, plan.drawnRect.x + plan.drawnRect.width);
+    const size_t maxY = std::min(rect.y + rect.height, plan.drawnRect.y + plan.drawnRect.height);
+
+    PixelRect drawnPart;
+    if (minX < maxX && minY < maxY) {
+        drawnPart.x = minX;
+        drawnPart.y = minY;
+        drawnPart.width = maxX - minX;
+        drawnPart.height = maxY - minY;
+    }
+    return drawnPart;
+}
+
+// Returns the part of the image rect that is read to crop the part `rect` of the canvas.
+PixelRect ImageRectOfRect(const CropPlan &plan, const PixelRect &rect)
+{
+    if (plan.layout.IsScaled()) {
+        PixelRect drawnPart = DrawnPartOfRect(plan, rect);
+        if (drawnPart.width == 0) {
+            return PixelRect();
+        }
+        return ReducedImageRect(plan.layout, plan.transform, plan.spec->resamplingFilter, plan.reductionFactor, drawnPart);
+    }
+
+    // The orientation maps whole pixels to whole pixels, so an upright part of the canvas reads exactly its own pixels.
+    if (plan.layout.producesOrientedImage) {
+        return MakePixelRect(CGRectApplyAffineTransform(CGRectMake(rect.x, rect.y, rect.width, rect.height), plan.transform));
+    }
+
+    PixelRect drawnPart = DrawnPartOfRect(plan, rect);
+    if (drawnPart.width == 0) {
+        return PixelRect();
+    }
+    return SampledImageRect(plan.layout, plan.transform, plan.spec->resamplingFilter, drawnPart);
+}
+
+// Returns whether `rect`, in the coordinate space of the image rect, lies inside of it.
+bool IsInsideOfImageRect(const CropLayout &layout, const CGRect &rect)
+{
+    return CGRectGetMinX(rect) >= 0 && CGRectGetMinY(rect) >= 0 && CGRectGetMaxX(rect) <= layout.imageWidth && CGRectGetMaxY(rect) <= layout.imageHeight;
+}
+
+// Returns whether the result of an opaque image rect is opaque: it is not masked, the image is drawn into all of it,
+// and no pixel blends the image with the transparent outside of the image rect.
+bool IsOpaqueResult(const CropPlan &plan)
+{
+    const CropLayout &layout = plan.layout;
+    if (plan.spec->applyMaskToCroppedImage && !layout.producesOrientedImage) {
+        return false;
+    }
+    const PixelRect &drawnRect = plan.drawnRect;
+    if (drawnRect.x != 0 || drawnRect.y != 0 || drawnRect.width != layout.outputWidth || drawnRect.height != layout.outputHeight) {
+        return false;
+    }
+
+    // An upright image rect and a scaled one that is not rotated extend their edges rather than blend them.
+    if (layout.producesOrientedImage || plan.clampsEdges) {
+        return true;
+    }
+    const PixelRect rect{ 0, 0, layout.outputWidth, layout.outputHeight };
+    if (plan.copiesPixels && IsInsideOfImageRect(layout, CGRectApplyAffineTransform(CGRectMake(0, 0, rect.width, rect.height), plan.copyTransform))) {
+        return true;
+    }
+    const RSKResamplingFilter filter = plan.spec->resamplingFilter;
+    return IsInsideOfImageRect(layout, layout.IsScaled() ? ReducedFootprint(plan.transform, filter, plan.reductionFactor, rect) : SampledFootprint(plan.transform, filter, rect));
+}
+
+// Crops the part `rect` of the canvas into `destination`, which has its size. `image` holds the pixels of the image
+// rect inside of `imageRect`, as returned by `ImageRectOfRect`.
+void CropRect(const CropPlan &plan, const PixelRect &rect, const BitmapView &image, const PixelRect &imageRect, const BitmapView &destination)
+{
+    // Step 1: if the upright image rect is the result, write it straight into the destination.
+    if (plan.layout.producesOrientedImage && !plan.layout.IsScaled()) {
+        OrientBitmap(image, plan.spec->imageOrientation, destination);
+        return;
+    }
+
+    // Step 2: find the part of the rect that the image is drawn into. The rest of the rect stays clear.
+    PixelRect drawnPart = DrawnPartOfRect(plan, rect);
+    if (drawnPart.width != rect.width || drawnPart.height != rect.height || imageRect.width == 0) {
+        ClearBitmap(destination);
+    }
+    if (drawnPart.width == 0 || imageRect.width == 0) {
+        return;
+    }
+
+    // Step 3: make the mask if needed. An upright image rect is never masked.
+    PooledPointer<CoverageMask> mask(nullptr, nullptr);
+    if (plan.mask) {
+        mask = MakePooled<CoverageMask, RasterizedCoverageMask>(plan.mask, drawnPart.x, drawnPart.y, drawnPart.width, drawnPart.height);
+    } else if (plan.spec->applyMaskToCroppedImage && !plan.layout.producesOrientedImage) {
+        mask = MakeCoverageMask(*plan.spec, plan.layout, drawnPart);
+    }
+
+    // Step 4: if the pixels of the image rect are only moved, copy the ones of the drawn part in their orientation, which
+    // is exact and needs no sampling. A part that reaches past the edges of the image rect is sampled to blend them.
+    if (plan.copiesPixels) {
+        CGAffineTransform transform = CGAffineTransformConcat(CGAffineTransformMakeTranslation(drawnPart.x, drawnPart.y), plan.copyTransform);
+        transform = CGAffineTransformConcat(transform, CGAffineTransformMakeTranslation(-static_cast<CGFloat>(imageRect.x), -static_cast<CGFloat>(imageRect.y)));
+        const CGRect area = CGRectApplyAffineTransform(CGRectMake(0, 0, drawnPart.width, drawnPart.height), transform);
+        if (CGRectGetMinX(area) >= 0 && CGRectGetMinY(area) >= 0 && CGRectGetMaxX(area) <= image.width && CGRectGetMaxY(area) <= image.height) {
+            const PixelRect part = MakePixelRect(area);
+            BitmapView drawnView = MakeSubview(destination, drawnPart.x - rect.x, drawnPart.y - rect.y, drawnPart.width, drawnPart.height);
+            OrientBitmap(MakeSubview(image, part.x, part.y, part.width, part.height), plan.copyOrientation, drawnView);
+            if (mask) {
+                MaskBitmap(*mask, drawnView);
+            }
+            return;
+        }
+    }
+
+    // Step 5: reduce the image rect with the box filter if the result is much smaller.
+    BitmapView sampledImage = image;
+    PixelBuffer reducedImage;
+    if (plan.reductionFactor > 1) {
+        const size_t factor = plan.reductionFactor;
+        reducedImage = PixelBuffer((image.width + factor - 1) / factor, (image.height + factor - 1) / factor, image.componentType);
+        BoxReduceBitmap(image, factor, plan.clampsEdges, reducedImage.View());
+        sampledImage = reducedImage.View();
+    }
+
+    // Step 6: extend the edges of the image rect that this part reads past the filter and the samples of a pixel.
+    size_t extensionX = 0, extensionY = 0;
+    PixelBuffer extendedImage;
+    if (plan.clampsEdges) {
+        const CGAffineTransform &transform = plan.transform;
+        const CGFloat pixelLength = std::max(std::fabs(transform.a) + std::fabs(transform.c), std::fabs(transform.b) + std::fabs(transform.d));
+        const size_t margin = FilterRadius(plan.spec->resamplingFilter) + 1 + static_cast<size_t>(std::ceil(pixelLength / plan.reductionFactor));
+        extensionX = imageRect.x == 0 ? margin : 0;
+        extensionY = imageRect.y == 0 ? margin : 0;
+        const size_t width = sampledImage.width + extensionX + (imageRect.x + imageRect.width == plan.layout.imageWidth ? margin : 0);
+        const size_t height = sampledImage.height + extensionY + (imageRect.y + imageRect.height == plan.layout.imageHeight ? margin : 0);
+        extendedImage = PixelBuffer(width, height, image.componentType);
+        ExtendBitmap(sampledImage, extensionX, extensionY, extendedImage.View());
+        sampledImage = extendedImage.View();
+    }
+
+    // Step 7: sample the image rect for every drawn pixel. The transform moves the drawn part and the image rect of this
+    // part to the origin, shrinks it by the reduction and moves it past the extension. It is composed in double
+    // precision, so that a part samples the same points as the whole crop would.
+    const CGAffineTransform &t = plan.transform;
+    const double scale = 1.0 / plan.reductionFactor;
+    const WarpTransform transform = {
+        t.a * scale,
+        t.b * scale,
+        t.c * scale,
+        t.d * scale,
+        (t.a * static_cast<double>(drawnPart.x) + t.c * static_cast<double>(drawnPart.y) + t.tx - static_cast<double>(imageRect.x)) * scale + extensionX,
+        (t.b * static_cast<double>(drawnPart.x) + t.d * static_cast<double>(drawnPart.y) + t.ty - static_cast<double>(imageRect.y)) * scale + extensionY,
+    };
+    BitmapView drawnView = MakeSubview(destination, drawnPart.x - rect.x, drawnPart.y - rect.y, drawnPart.width, drawnPart.height);
+    WarpBitmapSupersampled(sampledImage, transform, plan.spec->resamplingFilter, plan.samplesX, plan.samplesY, mask.get(), drawnView);
+}
+
+// Returns the coverage of the whole mask of the result of `plan` from the shared mask cache, rasterizing it if no crop
+// with the same mask geometry did before. Returns null if the result is not masked or the cache keeps no masks.
+std::shared_ptr<const RasterizedMask> FindOrMakeMask(const CropPlan &plan)
+{
+    const RSKCropSpec &spec = *plan.spec;
+    const CropLayout &layout = plan.layout;
+    if (!spec.applyMaskToCroppedImage || layout.producesOrientedImage) {
+        return nullptr;
+    }
+    const MaskKey key(spec, layout.canvasWidth, layout.canvasHeight, layout.outputWidth, layout.outputHeight);
+    return SharedMaskCache().FindOrMake(key, [&] {
+        PooledPointer<CoverageMask> mask = MakeCoverageMask(spec, layout, PixelRect{ 0, 0, layout.outputWidth, layout.outputHeight });
+        return std::make_shared<const RasterizedMask>(*mask);
+    });
+}
+
+// Keeps the first failure of the parts of a crop that run concurrently.
+class CropStatus {
+public:
+    RSKCropStatus Get() const { return status_.load(); }
+    bool Failed() const { return Get() != RSKCropStatusSuccess; }
+
+    void Fail(RSKCropStatus status)
+    {
+        RSKCropStatus expected = RSKCropStatusSuccess;
+        status_.compare_exchange_strong(expected, status);
+    }
+
+private:
+    std::atomic<RSKCropStatus> status_{ RSKCropStatusSuccess };
+};
+
+// Returns whether `part`, at `partX` and `partY` of the source, contains the pixels of the image rect inside of `rect`.
+bool PartContainsRect(const BitmapView &part, size_t partX, size_t partY, const CropLayout &layout, const PixelRect &rect)
+{
+    if (rect.width == 0 || rect.height == 0) {
+        return true;
+    }
+    const size_t x = layout.imageX + rect.x;
+    const size_t y = layout.imageY + rect.y;
+    return x >= partX && y >= partY && x + rect.width <= partX + part.width && y + rect.height <= partY + part.height;
+}
+
+RSKCropStatus CropPart(const BitmapView &part, size_t partX, size_t partY, size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, const RSKExecutor *executor, const BitmapView &destination)
+{
+    struct CropContext {
+        CropPlan plan;
+        BitmapView part;
+        size_t partX;
+        size_t partY;
+        BitmapView destination;
+        size_t bandHeight;
+        CropStatus status;
+    } context;
+
+    if (!MakeCropPlan(sourceWidth, sourceHeight, spec, context.plan)) {
+        return RSKCropStatusInvalidArgument;
+    }
+    const CropLayout &layout = context.plan.layout;
+    if (destination.width != layout.outputWidth || destination.height != layout.outputHeight) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    // Step 1: make sure that the part holds every pixel that the crop reads.
+    const PixelRect footprint = ImageRectOfRect(context.plan, PixelRect{ 0, 0, layout.outputWidth, layout.outputHeight });
+    if (!PartContainsRect(part, partX, partY, layout, footprint)) {
+        return RSKCropStatusInvalidArgument;
+    }
+    context.part = part;
+    context.partX = partX;
+    context.partY = partY;
+    context.destination = destination;
+
+    // Step 2: take the mask from the cache, or rasterize it once for all of the bands.
+    context.plan.mask = FindOrMakeMask(context.plan);
+
+    // Step 3: crop bands of rows of the result concurrently, or the whole result at once without an executor.
+    context.bandHeight = executor ? kRowBandHeight : layout.outputHeight;
+    const size_t bandCount = (layout.outputHeight + context.bandHeight - 1) / context.bandHeight;
+
+    ParallelFor(executor, bandCount, &context, [](void *contextPointer, size_t index) {
+        CropContext &context = *static_cast<CropContext *>(contextPointer);
+        if (context.status.Failed()) {
+            return;
+        }
+
+        PixelRect rect;
+        rect.y = index * context.bandHeight;
+        rect.width = context.plan.layout.outputWidth;
+        rect.height = std::min(context.bandHeight, context.plan.layout.outputHeight - rect.y);
+
+        PixelRect imageRect = ImageRectOfRect(context.plan, rect);
+        BitmapView image;
+        if (imageRect.width > 0 && imageRect.height > 0) {
+            const CropLayout &layout = context.plan.layout;
+            image = MakeSubview(context.part, layout.imageX + imageRect.x - context.partX, layout.imageY + imageRect.y - context.partY, imageRect.width, imageRect.height);
+        }
+        BitmapView destination = MakeSubview(context.destination, rect.x, rect.y, rect.width, rect.height);
+
+        try {
+            CropRect(context.plan, rect, image, imageRect, destination);
+        } catch (const std::bad_alloc &) {
+            context.status.Fail(RSKCropStatusOutOfMemory);
+        }
+    });
+
+    return context.status.Get();
+}
+
+// Buffers of a tile of a tiled crop, which are reused by the tiles that run one after another.
+struct TileBuffers {
+    std::vector<uint8_t> tilePixels;
+    std::vector<uint8_t> imagePixels;
+};
+
+// The buffers of the tiles that are not running, shared by the tiles that run concurrently.
+class TileBufferPool {
+public:
+    std::unique_ptr<TileBuffers> Take()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (buffers_.empty()) {
+            return std::make_unique<TileBuffers>();
+        }
+        std::unique_ptr<TileBuffers> buffers = std::move(buffers_.back());
+        buffers_.pop_back();
+        return buffers;
+    }
+
+    void Return(std::unique_ptr<TileBuffers> buffers)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.push_back(std::move(buffers));
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<TileBuffers>> buffers_;
+};
+
+RSKCropStatus CropTiled(const RSKTiledSource &source, const RSKCropSpec &spec, const RSKTilingOptions &options, const RSKTiledDestination &destination)
+{
+    struct CropContext {
+        const RSKTiledSource *source;
+        const RSKTiledDestination *destination;
+        CropPlan plan;
+        size_t tileSize;
+        size_t columnCount;
+        TileBufferPool bufferPool;
+        CropStatus status;
+    } context;
+    context.source = &source;
+    context.destination = &destination;
+
+    if (!MakeCropPlan(source.width, source.height, spec, context.plan)) {
+        return RSKCropStatusInvalidArgument;
+    }
+    const CropLayout &layout = context.plan.layout;
+
+    // Step 1: make the tiles smaller until the buffers of the tiles that run at once fit into the memory budget.
+    const size_t concurrency = options.executor ? std::max<size_t>(options.executor->concurrency, 1) : 1;
+    const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(source.pixelFormat);
+    context.tileSize = options.tileSize > 0 ? options.tileSize : kDefaultTileSize;
+    if (options.memoryBudget > 0) {
+        while (TileBufferSize(context.tileSize, bytesPerPixel, context.plan.transform, spec.resamplingFilter, context.plan.reductionFactor) * concurrency > options.memoryBudget) {
+            if (context.tileSize <= kMinimumTileSize) {
+                return RSKCropStatusOutOfMemory;
+            }
+            context.tileSize = std::max(context.tileSize / 2, kMinimumTileSize);
+        }
+    }
+
+    // Step 2: crop every tile from the part of the image rect that it reads.
+    context.columnCount = (layout.outputWidth + context.tileSize - 1) / context.tileSize;
+    const size_t rowCount = (layout.outputHeight + context.tileSize - 1) / context.tileSize;
+
+    ParallelFor(options.executor, context.columnCount * rowCount, &context, [](void *contextPointer, size_t index) {
+        CropContext &context = *static_cast<CropContext *>(contextPointer);
+        if (context.status.Failed()) {
+            return;
+        }
+        const RSKPixelFormat pixelFormat = context.source->pixelFormat;
+        const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(pixelFormat);
+
+        PixelRect tileRect;
+        tileRect.x = index % context.columnCount * context.tileSize;
+        tileRect.y = index / context.columnCount * context.tileSize;
+        tileRect.width = std::min(context.tileSize, context.plan.layout.outputWidth - tileRect.x);
+        tileRect.height = std::min(context.tileSize, context.plan.layout.outputHeight - tileRect.y);
+
+        try {
+            std::unique_ptr<TileBuffers> buffers = context.bufferPool.Take();
+            buffers->tilePixels.resize(context.tileSize * context.tileSize * bytesPerPixel);
+
+            RSKBitmap tileBitmap = RSKBitmapMake(buffers->tilePixels.data(), tileRect.width, tileRect.height, tileRect.width * bytesPerPixel, pixelFormat);
+            BitmapView image;
+            PixelRect imageRect = ImageRectOfRect(context.plan, tileRect);
+            if (imageRect.width > 0 && imageRect.height > 0) {
+                buffers->imagePixels.resize(std::max(buffers->imagePixels.size(), imageRect.width * imageRect.height * bytesPerPixel));
+                RSKBitmap imageBitmap = RSKBitmapMake(buffers->imagePixels.data(), imageRect.width, imageRect.height, imageRect.width * bytesPerPixel, pixelFormat);
+                if (!context.source->read(context.source->context, context.plan.layout.imageX + imageRect.x, context.plan.layout.imageY + imageRect.y, &imageBitmap)) {
+                    context.status.Fail(RSKCropStatusReadFailed);
+                    return;
+                }
+                image = MakeBitmapView(imageBitmap);
+            }
+
+            CropRect(context.plan, tileRect, image, imageRect, MakeBitmapView(tileBitmap));
+            if (!context.destination->write(context.destination->context, tileRect.x, tileRect.y, &tileBitmap)) {
+                context.status.Fail(RSKCropStatusWriteFailed);
+                return;
+            }
+            context.bufferPool.Return(std::move(buffers));
+        } catch (const std::bad_alloc &) {
+            context.status.Fail(RSKCropStatusOutOfMemory);
+        }
+    });
+
+    return context.status.Get();
+}
+
+} // namespace
+
+namespace rsk {
+
+bool IsValidCoordinate(CGFloat value)
+{
+    return std::fabs(value) <= kMaximumCropCoordinate;
+}
+
+bool IsValidSpec(const RSKCropSpec *spec)
+{
+    if (!spec) {
+        return false;
+    }
+    // Null rects are infinite, so they are rejected along with the rects whose coordinates are not finite.
+    if (!std::isfinite(spec->rotationAngle) || !IsValidRect(spec->imageRect) || !IsValidRect(spec->cropRect)) {
+        return false;
+    }
+    if (!(spec->zoomScale > 0) || !std::isfinite(spec->zoomScale)) {
+        return false;
+    }
+    if (spec->maskPath.elementCount > 0 && !spec->maskPath.elements) {
+        return false;
+    }
+    for (size_t index = 0; index < spec->maskPath.elementCount; index++) {
+        const RSKPathElement &element = spec->maskPath.elements[index];
+        for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+            if (!IsValidCoordinate(element.points[i].x) || !IsValidCoordinate(element.points[i].y)) {
+                return false;
+            }
+        }
+    }
+    if (!IsEnumValueInRange(spec->resamplingFilter, RSKResamplingFilterBilinear, RSKResamplingFilterLanczos3)) {
+        return false;
+    }
+    if (!(spec->outputSize.width >= 0 && spec->outputSize.height >= 0) || !IsValidCoordinate(spec->outputSize.width) || !IsValidCoordinate(spec->outputSize.height)) {
+        return false;
+    }
+    return true;
+}
+
+bool GetCropFootprint(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropFootprint &footprint)
+{
+    CropPlan plan;
+    if (!IsValidSpec(&spec) || !MakeCropPlan(sourceWidth, sourceHeight, spec, plan)) {
+        return false;
+    }
+    const CropLayout &layout = plan.layout;
+    const PixelRect rect = ImageRectOfRect(plan, PixelRect{ 0, 0, layout.outputWidth, layout.outputHeight });
+    footprint.x = layout.imageX + rect.x;
+    footprint.y = layout.imageY + rect.y;
+    footprint.width = rect.width;
+    footprint.height = rect.height;
+    footprint.reductionFactor = plan.reductionFactor;
+    return true;
+}
+
+bool GetCropPixelMapping(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropPixelMapping &mapping)
+{
+    CropPlan plan;
+    if (!IsValidSpec(&spec) || !MakeCropPlan(sourceWidth, sourceHeight, spec, plan)) {
+        return false;
+    }
+    const CropLayout &layout = plan.layout;
+    if (layout.IsScaled() || (spec.applyMaskToCroppedImage && !layout.producesOrientedImage)) {
+        return false;
+    }
+    if (plan.drawnRect.x != 0 || plan.drawnRect.y != 0 || plan.drawnRect.width != layout.outputWidth || plan.drawnRect.height != layout.outputHeight) {
+        return false;
+    }
+
+    // Step 1: the transform must be a quarter turn or a flip, which the rotation only makes up to rounding errors, and a
+    // translation by whole pixels.
+    CGAffineTransform transform;
+    if (!SnapToWholePixels(plan.transform, transform)) {
+        return false;
+    }
+    const bool swapsAxes = transform.a == 0;
+
+    // Step 2: the result must be made of pixels of the image rect.
+    const CGRect area = CGRectApplyAffineTransform(CGRectMake(0, 0, layout.outputWidth, layout.outputHeight), transform);
+    if (CGRectGetMinX(area) < 0 || CGRectGetMinY(area) < 0 || CGRectGetMaxX(area) > layout.imageWidth || CGRectGetMaxY(area) > layout.imageHeight) {
+        return false;
+    }
+    mapping.x = layout.imageX + static_cast<size_t>(CGRectGetMinX(area));
+    mapping.y = layout.imageY + static_cast<size_t>(CGRectGetMinY(area));
+    mapping.width = static_cast<size_t>(CGRectGetWidth(area));
+    mapping.height = static_cast<size_t>(CGRectGetHeight(area));
+    mapping.swapsAxes = swapsAxes;
+    mapping.flipsHorizontally = swapsAxes ? transform.c < 0 : transform.a < 0;
+    mapping.flipsVertically = swapsAxes ? transform.b < 0 : transform.d < 0;
+    return true;
+}
+
+RSKCropStatus CropBitmapPart(const BitmapView &part, size_t partX, size_t partY, size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, const RSKExecutor *executor, const BitmapView &destination)
+{
+    if (!IsValidSpec(&spec)) {
+        return RSKCropStatusInvalidArgument;
+    }
+    return CropPart(part, partX, partY, sourceWidth, sourceHeight, spec, executor, destination);
+}
+
+// Returns `spec` for a source of `width` x `height` pixels, scaled from one of `referenceSize`.
+RSKCropSpec ScaleCropSpec(const RSKCropSpec &spec, CGSize referenceSize, size_t width, size_t height)
+{
+    if (!(referenceSize.width > 0 && referenceSize.height > 0)) {
+        return spec;
+    }
+    const CGFloat scaleX = width / referenceSize.width;
+    const CGFloat scaleY = height / referenceSize.height;
+    if (scaleX == 1.0 && scaleY == 1.0) {
+        return spec;
+    }
+
+    // The image rect is in the coordinate space of the source, the crop rect in the one of the oriented image.
+    RSKCropSpec scaledSpec = spec;
+    scaledSpec.imageRect = CGRectApplyAffineTransform(spec.imageRect, CGAffineTransformMakeScale(scaleX, scaleY));
+    const bool swapsDimensions = OrientationSwapsDimensions(spec.imageOrientation);
+    const CGFloat orientedScaleX = swapsDimensions ? scaleY : scaleX;
+    const CGFloat orientedScaleY = swapsDimensions ? scaleX : scaleY;
+    scaledSpec.cropRect = CGRectApplyAffineTransform(spec.cropRect, CGAffineTransformMakeScale(orientedScaleX, orientedScaleY));
+
+    // The mask path is mapped to pixels by `1 / zoomScale`, so a larger source needs a smaller zoom scale.
+    scaledSpec.zoomScale = spec.zoomScale / orientedScaleX;
+    return scaledSpec;
+}
+
+} // namespace rsk
+
+CGSize RSKCropEngineGetOutputSize(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec *spec)
+{
+    CropLayout layout;
+    if (!IsValidSpec(spec) || !MakeCropLayout(sourceWidth, sourceHeight, *spec, layout)) {
+        return CGSizeZero;
+    }
+    return CGSizeMake(layout.outputWidth, layout.outputHeight);
+}
+
+bool RSKCropEngineIsOutputOpaque(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec *spec)
+{
+    CropPlan plan;
+    if (!IsValidSpec(spec) || !MakeCropPlan(sourceWidth, sourceHeight, *spec, plan)) {
+        return false;
+    }
+    return IsOpaqueResult(plan);
+}
+
+RSKCropStatus RSKCropEngineCropBitmap(const RSKBitmap *source, const RSKCropSpec *spec, RSKBitmap *destination)
+{
+    return RSKCropEngineCropBitmapWithExecutor(source, spec, nullptr, destination);
+}
+
+RSKCropStatus RSKCropEngineCropBitmapWithExecutor(const RSKBitmap *source, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destination)
+{
+    if (!IsValidBitmap(source) || !IsValidBitmap(destination) || !IsValidSpec(spec)) {
+        return RSKCropStatusInvalidArgument;
+    }
+    if (source->pixelFormat != destination->pixelFormat) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    try {
+        return CropPart(MakeBitmapView(*source), 0, 0, source->width, source->height, *spec, executor, MakeBitmapView(*destination));
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
+
+RSKCropStatus RSKCropEngineCropBitmapToSizes(const RSKBitmap *source, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destinations, size_t destinationCount)
+{
+    if (!IsValidSpec(spec) || (destinationCount > 0 && !destinations)) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    RSKCropSpec sizedSpec = *spec;
+    for (size_t index = 0; index < destinationCount; ++index) {
+        sizedSpec.outputSize = CGSizeMake(destinations[index].width, destinations[index].height);
+        const RSKCropStatus status = RSKCropEngineCropBitmapWithExecutor(source, &sizedSpec, executor, &destinations[index]);
+        if (status != RSKCropStatusSuccess) {
+            return status;
+        }
+    }
+    return RSKCropStatusSuccess;
+}
+
+RSKCropStatus RSKCropEngineConvertBitmap(const RSKBitmap *source, RSKBitmap *destination)
+{
+    if (!IsValidBitmap(source) || !IsValidBitmap(destination) || source->width != destination->width || source->height != destination->height) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    // Only the 8-bit formats come in both orders of the colors.
+    const bool swapsColors = (source->pixelFormat == RSKPixelFormatBGRA8888) != (destination->pixelFormat == RSKPixelFormatBGRA8888);
+    ConvertBitmap(MakeBitmapView(*source), swapsColors, MakeBitmapView(*destination));
+    return RSKCropStatusSuccess;
+}
+
+RSKCropStatus RSKCropEngineCropTiled(const RSKTiledSource *source, const RSKCropSpec *spec, const RSKTilingOptions *options, const RSKTiledDestination *destination)
+{
+    if (!IsValidTiledSource(source) || !IsValidSpec(spec) || !destination || !destination->write) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    try {
+        return CropTiled(*source, *spec, options ? *options : RSKTilingOptions(), *destination);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
@@ -0,0 +1,205 @@
+//
+// RSKCropEngine.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKCropEngine_h
+#define RSKCropEngine_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKCoreGraphics.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Types of supported crop modes. The values match `RSKImageCropMode`.
+typedef enum RSKCropMode {
+    RSKCropModeCircle,
+    RSKCropModeSquare,
+    RSKCropModeCustom
+} RSKCropMode;
+
+// Orientations of the source pixels. The values match `UIImageOrientation`.
+typedef enum RSKImageOrientation {
+    RSKImageOrientationUp,
+    RSKImageOrientationDown,
+    RSKImageOrientationLeft,
+    RSKImageOrientationRight,
+    RSKImageOrientationUpMirrored,
+    RSKImageOrientationDownMirrored,
+    RSKImageOrientationLeftMirrored,
+    RSKImageOrientationRightMirrored
+} RSKImageOrientation;
+
+// Filters used to sample the source when it is rotated. The default, `RSKResamplingFilterBilinear`, matches the
+// interpolation of `CGContextDrawImage`.
+typedef enum RSKResamplingFilter {
+    RSKResamplingFilterBilinear,
+    RSKResamplingFilterNearest,
+    RSKResamplingFilterBicubic,
+    RSKResamplingFilterLanczos3
+} RSKResamplingFilter;
+
+// Types of path elements. The values match `CGPathElementType`.
+typedef enum RSKPathElementType {
+    RSKPathElementTypeMoveToPoint,
+    RSKPathElementTypeAddLineToPoint,
+    RSKPathElementTypeAddQuadCurveToPoint,
+    RSKPathElementTypeAddCurveToPoint,
+    RSKPathElementTypeCloseSubpath
+} RSKPathElementType;
+
+// Path elements. Only as many points as the type requires are used.
+struct RSKPathElement {
+    RSKPathElementType type;
+    CGPoint points[3];
+};
+typedef struct RSKPathElement RSKPathElement;
+
+// A path that is owned by the caller.
+struct RSKPath {
+    const RSKPathElement *elements;
+    size_t elementCount;
+    bool usesEvenOddFillRule;
+};
+typedef struct RSKPath RSKPath;
+
+// Everything that is needed to reproduce a crop of the image crop view controller.
+//
+// All rects are in pixels. `imageRect` is in the coordinate space of the unoriented source pixels, `cropRect` is in the
+// coordinate space of the oriented image. `maskPath` is in the coordinate space of the view that displayed the mask;
+// it is scaled by `1 / zoomScale` to map it to pixels.
+//
+// If `outputSize` is not zero, the result is scaled to that many pixels, like a thumbnail of the crop. It is sampled
+// straight from the source rather than from a crop at full resolution, with an area average when it is reduced.
+struct RSKCropSpec {
+    RSKCropMode cropMode;
+    CGRect cropRect;
+    CGRect imageRect;
+    CGFloat rotationAngle;
+    CGFloat zoomScale;
+    RSKImageOrientation imageOrientation;
+    RSKPath maskPath;
+    bool applyMaskToCroppedImage;
+    RSKResamplingFilter resamplingFilter;
+    CGSize outputSize;
+};
+typedef struct RSKCropSpec RSKCropSpec;
+
+// Results of the crop engine.
+typedef enum RSKCropStatus {
+    RSKCropStatusSuccess,
+    RSKCropStatusInvalidArgument,
+    RSKCropStatusOutOfMemory,
+    RSKCropStatusReadFailed,
+    RSKCropStatusWriteFailed,
+    RSKCropStatusUnsupportedFormat
+} RSKCropStatus;
+
+// Returns the size, in pixels, of the image produced by cropping a source of `sourceWidth` x `sourceHeight` pixels
+// according to `spec`. Returns `CGSizeZero` if nothing would be produced.
+CGSize RSKCropEngineGetOutputSize(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec *spec);
+
+// Returns whether the image produced by cropping an opaque source of `sourceWidth` x `sourceHeight` pixels according to
+// `spec` is opaque as well: the crop does not mask it, and covers it with the image without blending the edges of the
+// image with the transparent outside, like the corners that a rotation exposes. Such a result needs no alpha channel,
+// so it may be stored and encoded without one. Returns false if nothing would be produced.
+bool RSKCropEngineIsOutputOpaque(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec *spec);
+
+// Crops `source` according to `spec` and writes the result into `destination`.
+//
+// The destination must have the pixel format of the source and the size returned by `RSKCropEngineGetOutputSize`.
+// Pixels of the destination that are not covered by the image are cleared. The pixels are filtered with components of
+// the type of the format, so a 16-bit or half float source keeps its precision and its extended range.
+RSKCropStatus RSKCropEngineCropBitmap(const RSKBitmap *source, const RSKCropSpec *spec, RSKBitmap *destination);
+
+// Like `RSKCropEngineCropBitmap`, but crops bands of rows of the result concurrently on `executor`. The result is
+// identical. `executor` may be null.
+RSKCropStatus RSKCropEngineCropBitmapWithExecutor(const RSKBitmap *source, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destination);
+
+// Crops `source` according to `spec` once for every destination, scaling each result to the size of its destination,
+// like the renditions of an avatar. Every result is sampled straight from the source. The `outputSize` of `spec` is
+// ignored. `executor` may be null.
+RSKCropStatus RSKCropEngineCropBitmapToSizes(const RSKBitmap *source, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destinations, size_t destinationCount);
+
+// Copies `source` into `destination`, which must have its size, converting the pixels to the pixel format of the
+// destination, like a crop of 16-bit pixels that is shown by an 8-bit view. The components are only rescaled, so the
+// colors stay in the color space of the source. Colors of half floats outside of 0 to 1 are clamped by an integer
+// format.
+RSKCropStatus RSKCropEngineConvertBitmap(const RSKBitmap *source, RSKBitmap *destination);
+
+// Reads the pixels of the source inside of the rect at `x` and `y` with the size of `destination` into `destination`.
+// Returns false if the pixels cannot be read.
+typedef bool (*RSKTileReadFunction)(void *context, size_t x, size_t y, const RSKBitmap *destination);
+
+// Receives the pixels of the result inside of the rect at `x` and `y` with the size of `tile`. The pixels are only valid
+// during the call. Returns false to stop the crop.
+typedef bool (*RSKTileWriteFunction)(void *context, size_t x, size_t y, const RSKBitmap *tile);
+
+// A source that is read one region at a time, so that it never has to be in memory as a whole.
+struct RSKTiledSource {
+    size_t width;
+    size_t height;
+    RSKPixelFormat pixelFormat;
+    RSKTileReadFunction read;
+    void *context;
+};
+typedef struct RSKTiledSource RSKTiledSource;
+
+// A destination that receives the result one tile at a time, row by row and from left to right. If the crop has an
+// executor, the tiles are written in any order and several of them may be written at once from different threads.
+struct RSKTiledDestination {
+    RSKTileWriteFunction write;
+    void *context;
+};
+typedef struct RSKTiledDestination RSKTiledDestination;
+
+// Options of the tiled crop. Zero values select the defaults.
+struct RSKTilingOptions {
+    // The width and the height, in pixels, of the tiles of the result. Defaults to 256.
+    size_t tileSize;
+    // The maximum number of bytes that the pixel buffers of the crop may take. The tiles are made smaller until their
+    // buffers fit. Defaults to no limit.
+    size_t memoryBudget;
+    // The executor that crops tiles concurrently. The memory budget is shared by the tiles that run at once. Defaults
+    // to cropping one tile after another on the calling thread.
+    const RSKExecutor *executor;
+};
+typedef struct RSKTilingOptions RSKTilingOptions;
+
+// Crops `source` according to `spec` one tile of the result at a time and passes every tile to `destination`.
+// Only the part of the source that a tile samples is read for it, so the memory that is used depends on the size of
+// the tiles and not on the size of the source. The tiles have the pixel format of the source and together are identical
+// to the result of `RSKCropEngineCropBitmap`. `options` may be null.
+// Returns `RSKCropStatusOutOfMemory` if even the smallest tiles do not fit into the memory budget.
+RSKCropStatus RSKCropEngineCropTiled(const RSKTiledSource *source, const RSKCropSpec *spec, const RSKTilingOptions *options, const RSKTiledDestination *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKCropEngine_h */
@@ -0,0 +1,87 @@
+//
+// RSKCropEngine.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKCropEngine_hpp
+#define RSKCropEngine_hpp
+
+#include <cstddef>
+
+#include "RSKCropEngine.h"
+#include "RSKImageTransforms.hpp"
+
+namespace rsk {
+
+// Returns whether `value` is finite and small enough for the number of pixels it spans to be counted. Every coordinate
+// and size of a valid spec is.
+bool IsValidCoordinate(CGFloat value);
+
+// Returns whether `spec` can be cropped: its coordinates and sizes are valid, its rotation angle is finite, its zoom
+// scale is positive and its resampling filter is known.
+bool IsValidSpec(const RSKCropSpec *spec);
+
+// The part of a source that a crop reads.
+struct CropFootprint {
+    size_t x = 0;
+    size_t y = 0;
+    size_t width = 0;
+    size_t height = 0;
+    // The factor by which the crop reduces the image rect with a box filter before sampling it, which is 1 unless the
+    // result is scaled down by 2 or more.
+    size_t reductionFactor = 1;
+};
+
+// Finds the part of a source of `sourceWidth` x `sourceHeight` pixels that cropping it according to `spec` reads.
+// Returns false if the spec is invalid or nothing would be produced.
+bool GetCropFootprint(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropFootprint &footprint);
+
+// Describes a crop that only moves whole pixels of the source. The result is the part of the source at `x` and `y` of
+// `width` x `height` pixels with its axes swapped if `swapsAxes`, flipped along the x axis of the source if
+// `flipsHorizontally` and along its y axis if `flipsVertically`. That is, the pixel of the result at `resultX` and
+// `resultY` is the pixel of the part at `flipsHorizontally ? width - 1 - a : a` and `flipsVertically ? height - 1 - b : b`,
+// where `a` and `b` are `resultY` and `resultX` if `swapsAxes`, and `resultX` and `resultY` otherwise.
+struct CropPixelMapping {
+    size_t x = 0;
+    size_t y = 0;
+    size_t width = 0;
+    size_t height = 0;
+    bool swapsAxes = false;
+    bool flipsHorizontally = false;
+    bool flipsVertically = false;
+};
+
+// Finds whether cropping a source of `sourceWidth` x `sourceHeight` pixels according to `spec` only moves whole pixels,
+// which is the case when the result is not scaled, not masked, rotated by quarter turns and covered by the image.
+// Returns false otherwise.
+bool GetCropPixelMapping(size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, CropPixelMapping &mapping);
+
+// Crops a source of `sourceWidth` x `sourceHeight` pixels of which only `part`, at `partX` and `partY`, is in memory.
+// The part must contain the footprint of the crop. The result is identical to cropping the whole source.
+RSKCropStatus CropBitmapPart(const BitmapView &part, size_t partX, size_t partY, size_t sourceWidth, size_t sourceHeight, const RSKCropSpec &spec, const RSKExecutor *executor, const BitmapView &destination);
+
+// Returns `spec` for a source of `width` x `height` pixels, scaled from one of `referenceSize`.
+RSKCropSpec ScaleCropSpec(const RSKCropSpec &spec, CGSize referenceSize, size_t width, size_t height);
+
+} // namespace rsk
+
+#endif /* RSKCropEngine_hpp */
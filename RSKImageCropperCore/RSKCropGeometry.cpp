@@ -0,0 +1,195 @@
+//
+// RSKCropGeometry.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKCropGeometry.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "RSKGeometryBatch.hpp"
+
+namespace {
+
+using rsk::IsNearlyCeil;
+
+// Rounds the origin and the size of `rect` to integers like `RSKRectNormalize`: down, unless one of the coordinates
+// only misses the next integer because of the accumulated floating-point error.
+CGRect NormalizeRect(CGRect rect)
+{
+    if (IsNearlyCeil(rect.origin.x) || IsNearlyCeil(rect.origin.y)) {
+        rect.origin.x = std::ceil(rect.origin.x);
+        rect.origin.y = std::ceil(rect.origin.y);
+    } else {
+        rect.origin.x = std::floor(rect.origin.x);
+        rect.origin.y = std::floor(rect.origin.y);
+    }
+    if (IsNearlyCeil(rect.size.width) || IsNearlyCeil(rect.size.height)) {
+        rect.size.width = std::ceil(rect.size.width);
+        rect.size.height = std::ceil(rect.size.height);
+    } else {
+        rect.size.width = std::floor(rect.size.width);
+        rect.size.height = std::floor(rect.size.height);
+    }
+    return rect;
+}
+
+CGRect ScaleRect(CGRect rect, CGFloat scale)
+{
+    return CGRectMake(rect.origin.x * scale, rect.origin.y * scale, rect.size.width * scale, rect.size.height * scale);
+}
+
+CGRect SquareMovementRect(CGRect maskRect, RSKRotation rotation)
+{
+    // Grow the mask rect around its center until the rotated rect covers it, and avoid floats.
+    const CGFloat scale = RSKCropGeometryGetCoveringScaleForRotation(maskRect.size, rotation);
+    const CGFloat width = maskRect.size.width * scale;
+    const CGFloat height = maskRect.size.height * scale;
+    const CGFloat minX = std::floor(maskRect.origin.x + (maskRect.size.width - width) * 0.5);
+    const CGFloat minY = std::floor(maskRect.origin.y + (maskRect.size.height - height) * 0.5);
+    return CGRectMake(minX, minY, std::ceil(minX + width) - minX, std::ceil(minY + height) - minY);
+}
+
+// Returns the part of the image, in points of the oriented image, that is visible in the mask.
+//
+// The image scroll view is rotated around the center of the mask and, like its transform did, stretched by the ratio
+// of the bounding box of the rotated scroll view to its bounds. The crop rect is the offset of the mask from the
+// bounding box of the image frame transformed that way, which is found from the extremes of the rotated corners.
+CGRect CropRect(const RSKCropGeometryInput &input, RSKRotation rotation)
+{
+    const CGFloat sine = rotation.sine;
+    const CGFloat cosine = rotation.cosine;
+    const CGSize &scrollViewSize = input.scrollViewSize;
+    const CGFloat sx = (std::fabs(cosine) * scrollViewSize.width + std::fabs(sine) * scrollViewSize.height) / scrollViewSize.width;
+    const CGFloat sy = (std::fabs(sine) * scrollViewSize.width + std::fabs(cosine) * scrollViewSize.height) / scrollViewSize.height;
+
+    const CGFloat halfMaskWidth = CGRectGetWidth(input.maskRect) * 0.5;
+    const CGFloat halfMaskHeight = CGRectGetHeight(input.maskRect) * 0.5;
+    const CGFloat x = -halfMaskWidth - input.contentOffset.x;
+    const CGFloat y = -halfMaskHeight - input.contentOffset.y;
+    const CGFloat width = input.contentSize.width;
+    const CGFloat height = input.contentSize.height;
+    const CGFloat minX = sx * (cosine * x - sine * y + std::fmin(0, cosine * width) + std::fmin(0, -sine * height));
+    const CGFloat minY = sy * (sine * x + cosine * y + std::fmin(0, sine * width) + std::fmin(0, cosine * height));
+
+    const CGRect cropRect = CGRectMake(-halfMaskWidth - minX, -halfMaskHeight - minY, halfMaskWidth * 2, halfMaskHeight * 2);
+    return ScaleRect(NormalizeRect(ScaleRect(cropRect, 1 / input.zoomScale)), input.imageScale);
+}
+
+// Returns the part of the image, in points of the unoriented image, that is visible in the image scroll view.
+CGRect ImageRect(const RSKCropGeometryInput &input)
+{
+    const CGFloat scale = 1 / input.zoomScale;
+    CGRect imageRect = NormalizeRect(CGRectMake(input.contentOffset.x * scale, input.contentOffset.y * scale, input.scrollViewSize.width * scale, input.scrollViewSize.height * scale));
+
+    const CGSize &imageSize = input.imageSize;
+    const CGFloat x = imageRect.origin.x;
+    const CGFloat y = imageRect.origin.y;
+    const CGFloat width = imageRect.size.width;
+    const CGFloat height = imageRect.size.height;
+    switch (input.imageOrientation) {
+        case RSKImageOrientationRight:
+        case RSKImageOrientationRightMirrored:
+            imageRect = CGRectMake(y, std::floor(imageSize.width - width - x), height, width);
+            break;
+        case RSKImageOrientationLeft:
+        case RSKImageOrientationLeftMirrored:
+            imageRect = CGRectMake(std::floor(imageSize.height - height - y), x, height, width);
+            break;
+        case RSKImageOrientationDown:
+        case RSKImageOrientationDownMirrored:
+            imageRect.origin.x = std::floor(imageSize.width - width - x);
+            imageRect.origin.y = std::floor(imageSize.height - height - y);
+            break;
+        case RSKImageOrientationUp:
+        case RSKImageOrientationUpMirrored:
+            break;
+    }
+    return ScaleRect(imageRect, input.imageScale);
+}
+
+} // namespace
+
+RSKRotation RSKRotationMake(CGFloat rotationAngle)
+{
+    return { std::sin(rotationAngle), std::cos(rotationAngle) };
+}
+
+CGFloat RSKCropGeometryGetCoveringScale(CGSize size, CGFloat rotationAngle)
+{
+    return RSKCropGeometryGetCoveringScaleForRotation(size, RSKRotationMake(rotationAngle));
+}
+
+CGFloat RSKCropGeometryGetCoveringScaleForRotation(CGSize size, RSKRotation rotation)
+{
+    if (!(size.width > 0 && size.height > 0)) {
+        return 1;
+    }
+
+    // In the coordinate space of the rotated rect, the corners of the rect are at `R(-angle) (±w/2, ±h/2)`. They are
+    // covered once the half extents of the scaled rect reach the largest projections of the corners on its axes, which
+    // are `|cos| + |sin| h / w` along the x axis and `|cos| + |sin| w / h` along the y axis. The larger of the two has
+    // the larger ratio of the sides.
+    const CGFloat aspectRatio = std::max(size.width, size.height) / std::min(size.width, size.height);
+    return std::fabs(rotation.cosine) + std::fabs(rotation.sine) * aspectRatio;
+}
+
+CGRect RSKCropGeometryGetMovementRect(RSKCropMode cropMode, CGRect maskRect, CGRect customMovementRect, CGFloat rotationAngle)
+{
+    // The rotation is only needed to grow a square mask, so the other modes do not compute it.
+    if (cropMode != RSKCropModeSquare || rotationAngle == 0) {
+        return RSKCropGeometryGetMovementRectForRotation(cropMode, maskRect, customMovementRect, { 0, 1 });
+    }
+    return RSKCropGeometryGetMovementRectForRotation(cropMode, maskRect, customMovementRect, RSKRotationMake(rotationAngle));
+}
+
+CGRect RSKCropGeometryGetMovementRectForRotation(RSKCropMode cropMode, CGRect maskRect, CGRect customMovementRect, RSKRotation rotation)
+{
+    switch (cropMode) {
+        case RSKCropModeSquare:
+            // Like an angle of 0, which `atan2` only returns for these.
+            return rotation.sine == 0 && rotation.cosine > 0 ? maskRect : SquareMovementRect(maskRect, rotation);
+        case RSKCropModeCircle:
+            return maskRect;
+        case RSKCropModeCustom:
+            return customMovementRect;
+    }
+    return maskRect;
+}
+
+RSKCropGeometry RSKCropGeometrySolve(const RSKCropGeometryInput *input)
+{
+    RSKCropGeometry geometry = {};
+    if (!input) {
+        return geometry;
+    }
+    // The sine and cosine of the rotation are computed once for the movement rect and the crop rect.
+    const RSKRotation rotation = RSKRotationMake(input->rotationAngle);
+    geometry.movementRect = RSKCropGeometryGetMovementRectForRotation(input->cropMode, input->maskRect, input->customMovementRect, rotation);
+    if (!(input->scrollViewSize.width > 0 && input->scrollViewSize.height > 0 && input->zoomScale > 0)) {
+        return geometry;
+    }
+    geometry.cropRect = CropRect(*input, rotation);
+    geometry.imageRect = ImageRect(*input);
+    return geometry;
+}
@@ -0,0 +1,100 @@
+//
+// RSKCropGeometry.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKCropGeometry_h
+#define RSKCropGeometry_h
+
+#include "RSKCoreGraphics.h"
+#include "RSKCropEngine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The state of the image crop view controller that the geometry of a crop depends on.
+//
+// `maskRect` and `customMovementRect` are in the coordinate space of the view of the controller. `scrollViewSize`,
+// `contentOffset` and `contentSize` describe the image scroll view without its rotation. `imageSize` is the size of
+// the oriented image in points, like `UIImage.size`.
+struct RSKCropGeometryInput {
+    RSKCropMode cropMode;
+    CGRect maskRect;
+    CGRect customMovementRect;
+    CGSize scrollViewSize;
+    CGPoint contentOffset;
+    CGSize contentSize;
+    CGFloat zoomScale;
+    CGFloat rotationAngle;
+    CGSize imageSize;
+    CGFloat imageScale;
+    RSKImageOrientation imageOrientation;
+};
+typedef struct RSKCropGeometryInput RSKCropGeometryInput;
+
+// The geometry of a crop.
+//
+// `cropRect` and `imageRect` are in pixels and can be used as `RSKCropSpec.cropRect` and `RSKCropSpec.imageRect`.
+// `movementRect` is the frame of the image scroll view without its rotation.
+struct RSKCropGeometry {
+    CGRect cropRect;
+    CGRect imageRect;
+    CGRect movementRect;
+};
+typedef struct RSKCropGeometry RSKCropGeometry;
+
+// A rotation given by the sine and cosine of its angle. A rotation transform holds them as its `b` and `a`, so a
+// rotation that is already known as a transform, like the one of the image scroll view during a rotation gesture, can
+// be used without going through trigonometric functions again.
+struct RSKRotation {
+    CGFloat sine;
+    CGFloat cosine;
+};
+typedef struct RSKRotation RSKRotation;
+
+// Returns the rotation by `rotationAngle`.
+RSKRotation RSKRotationMake(CGFloat rotationAngle);
+
+// Returns the factor by which a rect of `size` must be scaled around its center so that, rotated by `rotationAngle`
+// around its center, it still covers the unscaled rect. The result is exact for every angle.
+CGFloat RSKCropGeometryGetCoveringScale(CGSize size, CGFloat rotationAngle);
+
+// Like `RSKCropGeometryGetCoveringScale`, for a rect rotated by `rotation`.
+CGFloat RSKCropGeometryGetCoveringScaleForRotation(CGSize size, RSKRotation rotation);
+
+// Returns the frame of the image scroll view without its rotation, so that its bounds always fill the mask area.
+// `customMovementRect` is returned in `RSKCropModeCustom`.
+CGRect RSKCropGeometryGetMovementRect(RSKCropMode cropMode, CGRect maskRect, CGRect customMovementRect, CGFloat rotationAngle);
+
+// Like `RSKCropGeometryGetMovementRect`, for an image scroll view rotated by `rotation`.
+CGRect RSKCropGeometryGetMovementRectForRotation(RSKCropMode cropMode, CGRect maskRect, CGRect customMovementRect, RSKRotation rotation);
+
+// Returns the geometry of the crop described by `input`. Returns zero rects if the scroll view or the zoom scale is
+// empty.
+RSKCropGeometry RSKCropGeometrySolve(const RSKCropGeometryInput *input);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKCropGeometry_h */
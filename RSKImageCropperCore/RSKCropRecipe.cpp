@@ -0,0 +1,789 @@
+//
+// RSKCropRecipe.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKCropRecipe.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <string_view>
+
+#include "RSKCropEngine.hpp"
+#include "RSKMaskRasterizer.hpp"
+
+namespace {
+
+using namespace rsk;
+
+// The first bytes of a binary recipe.
+constexpr char kSignature[4] = { 'R', 'S', 'K', 'R' };
+
+// The bits of the flags byte of a binary recipe.
+constexpr uint8_t kUsesEvenOddFillRuleFlag = 1 << 0;
+constexpr uint8_t kAppliesMaskFlag = 1 << 1;
+constexpr uint8_t kKnownFlags = kUsesEvenOddFillRuleFlag | kAppliesMaskFlag;
+
+// The longest number of a JSON recipe. The shortest representation of a double that keeps every bit takes at most 24
+// characters.
+constexpr size_t kMaximumNumberLength = 64;
+
+// JSON values that nest deeper than this are rejected instead of being skipped, so that the recursion stays bounded.
+constexpr int kMaximumDepth = 32;
+
+// The names of the enums in a JSON recipe, in the order of their values.
+constexpr std::string_view kCropModeNames[] = { "circle", "square", "custom" };
+constexpr std::string_view kImageOrientationNames[] = { "up", "down", "left", "right", "upMirrored", "downMirrored", "leftMirrored", "rightMirrored" };
+constexpr std::string_view kResamplingFilterNames[] = { "bilinear", "nearest", "bicubic", "lanczos3" };
+constexpr std::string_view kPathElementTypeNames[] = { "move", "line", "quad", "curve", "close" };
+
+// Returns the value of the enum whose name is `name`, or -1 if there is none.
+template <size_t Count>
+int FindName(const std::string_view (&names)[Count], std::string_view name)
+{
+    for (size_t i = 0; i < Count; i++) {
+        if (names[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Returns whether `recipe` can be written and cropped: its enums have known values, its numbers are finite, which JSON
+// requires, and small enough to be counted in pixels, its sizes are not negative and its zoom scale is positive. A
+// recipe is checked both when it is written and when it is read, so that no recipe that is handed out fails to crop.
+bool IsValidRecipe(const RSKCropRecipe &recipe)
+{
+    const RSKCropSpec &spec = recipe.spec;
+    if (!IsEnumValueInRange(spec.cropMode, RSKCropModeCircle, RSKCropModeCustom) ||
+        !IsEnumValueInRange(spec.imageOrientation, RSKImageOrientationUp, RSKImageOrientationRightMirrored)) {
+        return false;
+    }
+    const CGSize &sourceSize = recipe.sourceSize;
+    if (!(sourceSize.width >= 0 && sourceSize.height >= 0) || !IsValidCoordinate(sourceSize.width) || !IsValidCoordinate(sourceSize.height)) {
+        return false;
+    }
+    if (spec.maskPath.elementCount > UINT32_MAX || (spec.maskPath.elementCount > 0 && !spec.maskPath.elements)) {
+        return false;
+    }
+    for (size_t index = 0; index < spec.maskPath.elementCount; index++) {
+        if (!IsEnumValueInRange(spec.maskPath.elements[index].type, RSKPathElementTypeMoveToPoint, RSKPathElementTypeCloseSubpath)) {
+            return false;
+        }
+    }
+    return IsValidSpec(&spec);
+}
+
+// Writes bytes into a buffer of a fixed capacity and counts them all, including the ones that do not fit.
+class RecipeWriter {
+public:
+    RecipeWriter(void *buffer, size_t capacity) : buffer_(static_cast<char *>(buffer)), capacity_(buffer ? capacity : 0) {}
+
+    size_t Length() const { return length_; }
+
+    void Write(const void *bytes, size_t count)
+    {
+        if (length_ < capacity_) {
+            std::memcpy(buffer_ + length_, bytes, std::min(count, capacity_ - length_));
+        }
+        length_ += count;
+    }
+
+    void Write(std::string_view text) { Write(text.data(), text.size()); }
+
+    void WriteByte(uint8_t value) { Write(&value, 1); }
+
+    void WriteUInt32(uint32_t value)
+    {
+        const uint8_t bytes[4] = { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24) };
+        Write(bytes, sizeof(bytes));
+    }
+
+    // Writes the bits of `value` as a little-endian 64-bit float.
+    void WriteFloat64(double value)
+    {
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint8_t bytes[8];
+        for (size_t i = 0; i < 8; i++) {
+            bytes[i] = static_cast<uint8_t>(bits >> (8 * i));
+        }
+        Write(bytes, sizeof(bytes));
+    }
+
+    // Writes `value` as a JSON number that reads back as the same `CGFloat`. A single precision one is written with the
+    // digits of a float, so that -0.3 stays -0.3 instead of the 17 digits of the double it widens to.
+    void WriteNumber(CGFloat value)
+    {
+        char text[kMaximumNumberLength];
+#if defined(__cpp_lib_to_chars)
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        Write(text, static_cast<size_t>(result.ptr - text));
+#else
+        // `max_digits10` significant digits keep every bit of a `CGFloat`. Like `std::strtod` when it is read,
+        // `snprintf` follows the C locale, which a process keeps unless it changes it.
+        const int length = std::snprintf(text, sizeof(text), "%.*g", std::numeric_limits<CGFloat>::max_digits10, static_cast<double>(value));
+        Write(text, static_cast<size_t>(length));
+#endif
+    }
+
+private:
+    char *buffer_;
+    size_t capacity_;
+    size_t length_ = 0;
+};
+
+void WriteBinaryRecipe(const RSKCropRecipe &recipe, RecipeWriter &writer)
+{
+    const RSKCropSpec &spec = recipe.spec;
+    writer.Write(kSignature, sizeof(kSignature));
+    writer.WriteByte(RSK_CROP_RECIPE_VERSION);
+    writer.WriteByte(static_cast<uint8_t>(spec.cropMode));
+    writer.WriteByte(static_cast<uint8_t>(spec.imageOrientation));
+    writer.WriteByte(static_cast<uint8_t>(spec.resamplingFilter));
+    writer.WriteByte((spec.maskPath.usesEvenOddFillRule ? kUsesEvenOddFillRuleFlag : 0) | (spec.applyMaskToCroppedImage ? kAppliesMaskFlag : 0));
+
+    const CGFloat numbers[] = {
+        recipe.sourceSize.width, recipe.sourceSize.height,
+        spec.cropRect.origin.x, spec.cropRect.origin.y, spec.cropRect.size.width, spec.cropRect.size.height,
+        spec.imageRect.origin.x, spec.imageRect.origin.y, spec.imageRect.size.width, spec.imageRect.size.height,
+        spec.rotationAngle, spec.zoomScale,
+        spec.outputSize.width, spec.outputSize.height,
+    };
+    for (CGFloat number : numbers) {
+        writer.WriteFloat64(number);
+    }
+
+    writer.WriteUInt32(static_cast<uint32_t>(spec.maskPath.elementCount));
+    for (size_t index = 0; index < spec.maskPath.elementCount; index++) {
+        const RSKPathElement &element = spec.maskPath.elements[index];
+        writer.WriteByte(static_cast<uint8_t>(element.type));
+        for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+            writer.WriteFloat64(element.points[i].x);
+            writer.WriteFloat64(element.points[i].y);
+        }
+    }
+}
+
+void WriteJSONNumbers(RecipeWriter &writer, std::initializer_list<CGFloat> numbers)
+{
+    writer.Write("[");
+    bool isFirst = true;
+    for (CGFloat number : numbers) {
+        if (!isFirst) {
+            writer.Write(",");
+        }
+        writer.WriteNumber(number);
+        isFirst = false;
+    }
+    writer.Write("]");
+}
+
+void WriteJSONRecipe(const RSKCropRecipe &recipe, RecipeWriter &writer)
+{
+    const RSKCropSpec &spec = recipe.spec;
+    writer.Write("{\"version\":");
+    writer.WriteNumber(RSK_CROP_RECIPE_VERSION);
+    writer.Write(",\"sourceSize\":");
+    WriteJSONNumbers(writer, { recipe.sourceSize.width, recipe.sourceSize.height });
+    writer.Write(",\"cropMode\":\"");
+    writer.Write(kCropModeNames[spec.cropMode]);
+    writer.Write("\",\"cropRect\":");
+    WriteJSONNumbers(writer, { spec.cropRect.origin.x, spec.cropRect.origin.y, spec.cropRect.size.width, spec.cropRect.size.height });
+    writer.Write(",\"imageRect\":");
+    WriteJSONNumbers(writer, { spec.imageRect.origin.x, spec.imageRect.origin.y, spec.imageRect.size.width, spec.imageRect.size.height });
+    writer.Write(",\"rotationAngle\":");
+    writer.WriteNumber(spec.rotationAngle);
+    writer.Write(",\"zoomScale\":");
+    writer.WriteNumber(spec.zoomScale);
+    writer.Write(",\"imageOrientation\":\"");
+    writer.Write(kImageOrientationNames[spec.imageOrientation]);
+    writer.Write("\",\"maskPath\":{\"usesEvenOddFillRule\":");
+    writer.Write(spec.maskPath.usesEvenOddFillRule ? "true" : "false");
+    writer.Write(",\"elements\":[");
+    for (size_t index = 0; index < spec.maskPath.elementCount; index++) {
+        const RSKPathElement &element = spec.maskPath.elements[index];
+        writer.Write(index > 0 ? ",[\"" : "[\"");
+        writer.Write(kPathElementTypeNames[element.type]);
+        writer.Write("\"");
+        for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+            writer.Write(",");
+            writer.WriteNumber(element.points[i].x);
+            writer.Write(",");
+            writer.WriteNumber(element.points[i].y);
+        }
+        writer.Write("]");
+    }
+    writer.Write("]},\"applyMaskToCroppedImage\":");
+    writer.Write(spec.applyMaskToCroppedImage ? "true" : "false");
+    writer.Write(",\"resamplingFilter\":\"");
+    writer.Write(kResamplingFilterNames[spec.resamplingFilter]);
+    writer.Write("\",\"outputSize\":");
+    WriteJSONNumbers(writer, { spec.outputSize.width, spec.outputSize.height });
+    writer.Write("}");
+}
+
+// Collects the elements of a path that is being read into the room that the caller has for them, and counts the ones
+// that do not fit.
+class PathElementSink {
+public:
+    PathElementSink(RSKPathElement *elements, size_t capacity) : elements_(elements), capacity_(elements ? capacity : 0) {}
+
+    size_t Count() const { return count_; }
+    bool Fits() const { return count_ <= capacity_; }
+
+    // Returns the next element, or a scratch element if it does not fit.
+    RSKPathElement &Next()
+    {
+        RSKPathElement &element = count_ < capacity_ ? elements_[count_] : overflow_;
+        element = {};
+        count_++;
+        return element;
+    }
+
+private:
+    RSKPathElement *elements_;
+    size_t capacity_;
+    size_t count_ = 0;
+    RSKPathElement overflow_ = {};
+};
+
+// Reads the fields of a binary recipe in order.
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t *data, size_t length) : data_(data), end_(data + length) {}
+
+    bool IsAtEnd() const { return data_ == end_; }
+    size_t Remaining() const { return static_cast<size_t>(end_ - data_); }
+
+    bool ReadByte(uint8_t &value)
+    {
+        if (Remaining() < 1) {
+            return false;
+        }
+        value = *data_++;
+        return true;
+    }
+
+    bool ReadUInt32(uint32_t &value)
+    {
+        if (Remaining() < 4) {
+            return false;
+        }
+        value = static_cast<uint32_t>(data_[0]) | static_cast<uint32_t>(data_[1]) << 8 | static_cast<uint32_t>(data_[2]) << 16 | static_cast<uint32_t>(data_[3]) << 24;
+        data_ += 4;
+        return true;
+    }
+
+    bool ReadFloat64(CGFloat &value)
+    {
+        if (Remaining() < 8) {
+            return false;
+        }
+        uint64_t bits = 0;
+        for (size_t i = 0; i < 8; i++) {
+            bits |= static_cast<uint64_t>(data_[i]) << (8 * i);
+        }
+        data_ += 8;
+        double number = 0;
+        std::memcpy(&number, &bits, sizeof(number));
+        value = static_cast<CGFloat>(number);
+        return true;
+    }
+
+private:
+    const uint8_t *data_;
+    const uint8_t *end_;
+};
+
+RSKCropStatus ReadBinaryRecipe(const uint8_t *data, size_t length, PathElementSink &elements, RSKCropRecipe &recipe)
+{
+    // Step 1: check the signature and the version.
+    BinaryReader reader(data + sizeof(kSignature), length - sizeof(kSignature));
+    uint8_t version = 0;
+    if (!reader.ReadByte(version)) {
+        return RSKCropStatusReadFailed;
+    }
+    if (version == 0 || version > RSK_CROP_RECIPE_VERSION) {
+        return RSKCropStatusUnsupportedFormat;
+    }
+
+    // Step 2: read the enums and the flags.
+    uint8_t cropMode = 0;
+    uint8_t imageOrientation = 0;
+    uint8_t resamplingFilter = 0;
+    uint8_t flags = 0;
+    if (!reader.ReadByte(cropMode) || !reader.ReadByte(imageOrientation) || !reader.ReadByte(resamplingFilter) || !reader.ReadByte(flags)) {
+        return RSKCropStatusReadFailed;
+    }
+    if (cropMode > RSKCropModeCustom || imageOrientation > RSKImageOrientationRightMirrored || resamplingFilter > RSKResamplingFilterLanczos3 || (flags & ~kKnownFlags) != 0) {
+        return RSKCropStatusReadFailed;
+    }
+    RSKCropSpec &spec = recipe.spec;
+    spec.cropMode = static_cast<RSKCropMode>(cropMode);
+    spec.imageOrientation = static_cast<RSKImageOrientation>(imageOrientation);
+    spec.resamplingFilter = static_cast<RSKResamplingFilter>(resamplingFilter);
+    spec.maskPath.usesEvenOddFillRule = (flags & kUsesEvenOddFillRuleFlag) != 0;
+    spec.applyMaskToCroppedImage = (flags & kAppliesMaskFlag) != 0;
+
+    // Step 3: read the numbers.
+    CGFloat *numbers[] = {
+        &recipe.sourceSize.width, &recipe.sourceSize.height,
+        &spec.cropRect.origin.x, &spec.cropRect.origin.y, &spec.cropRect.size.width, &spec.cropRect.size.height,
+        &spec.imageRect.origin.x, &spec.imageRect.origin.y, &spec.imageRect.size.width, &spec.imageRect.size.height,
+        &spec.rotationAngle, &spec.zoomScale,
+        &spec.outputSize.width, &spec.outputSize.height,
+    };
+    for (CGFloat *number : numbers) {
+        if (!reader.ReadFloat64(*number)) {
+            return RSKCropStatusReadFailed;
+        }
+    }
+
+    // Step 4: read the path. Every element takes at least its type byte, so a count that the data cannot hold is
+    // rejected before it is looped over.
+    uint32_t elementCount = 0;
+    if (!reader.ReadUInt32(elementCount) || elementCount > reader.Remaining()) {
+        return RSKCropStatusReadFailed;
+    }
+    for (uint32_t index = 0; index < elementCount; index++) {
+        uint8_t type = 0;
+        if (!reader.ReadByte(type) || type > RSKPathElementTypeCloseSubpath) {
+            return RSKCropStatusReadFailed;
+        }
+        RSKPathElement &element = elements.Next();
+        element.type = static_cast<RSKPathElementType>(type);
+        for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+            if (!reader.ReadFloat64(element.points[i].x) || !reader.ReadFloat64(element.points[i].y)) {
+                return RSKCropStatusReadFailed;
+            }
+        }
+    }
+    return reader.IsAtEnd() ? RSKCropStatusSuccess : RSKCropStatusReadFailed;
+}
+
+// Reads the tokens of a JSON recipe in place.
+class JSONReader {
+public:
+    JSONReader(const char *data, size_t length) : data_(data), end_(data + length) {}
+
+    // Skips the whitespace and returns whether nothing else is left.
+    bool IsAtEnd()
+    {
+        SkipWhitespace();
+        return data_ == end_;
+    }
+
+    // Skips the whitespace and returns whether the next character is `character`, consuming it if it is.
+    bool Consume(char character)
+    {
+        SkipWhitespace();
+        if (data_ == end_ || *data_ != character) {
+            return false;
+        }
+        data_++;
+        return true;
+    }
+
+    // Reads a string. Its escape sequences are kept as they are, since the names of a recipe have none.
+    bool ReadString(std::string_view &value)
+    {
+        if (!Consume('"')) {
+            return false;
+        }
+        const char *begin = data_;
+        while (data_ != end_ && *data_ != '"') {
+            if (static_cast<unsigned char>(*data_) < 0x20) {
+                return false;
+            }
+            if (*data_ == '\\' && ++data_ == end_) {
+                return false;
+            }
+            data_++;
+        }
+        if (data_ == end_) {
+            return false;
+        }
+        value = std::string_view(begin, static_cast<size_t>(data_ - begin));
+        data_++;
+        return true;
+    }
+
+    bool ReadDouble(double &value)
+    {
+        SkipWhitespace();
+        const char *begin = data_;
+        while (data_ != end_ && IsNumberCharacter(*data_)) {
+            data_++;
+        }
+        const size_t length = static_cast<size_t>(data_ - begin);
+        if (length == 0 || length >= kMaximumNumberLength || *begin == '+') {
+            return false;
+        }
+#if defined(__cpp_lib_to_chars)
+        const std::from_chars_result result = std::from_chars(begin, data_, value);
+        return result.ec == std::errc() && result.ptr == data_;
+#else
+        // The data does not have to end with a null character, so the number is copied into one that does.
+        char text[kMaximumNumberLength];
+        std::memcpy(text, begin, length);
+        text[length] = '\0';
+        char *end = nullptr;
+        value = std::strtod(text, &end);
+        return end == text + length && std::isfinite(value);
+#endif
+    }
+
+    bool ReadNumber(CGFloat &value)
+    {
+        double number = 0;
+        if (!ReadDouble(number)) {
+            return false;
+        }
+        value = static_cast<CGFloat>(number);
+        return true;
+    }
+
+    bool ReadBool(bool &value)
+    {
+        SkipWhitespace();
+        if (ConsumeWord("true")) {
+            value = true;
+            return true;
+        }
+        if (ConsumeWord("false")) {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    // Reads an array of exactly `count` numbers.
+    bool ReadNumbers(CGFloat *const *numbers, size_t count)
+    {
+        if (!Consume('[')) {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if ((i > 0 && !Consume(',')) || !ReadNumber(*numbers[i])) {
+                return false;
+            }
+        }
+        return Consume(']');
+    }
+
+    // Reads the name of an enum of `names` into `value`.
+    template <typename Enum, size_t Count>
+    bool ReadName(const std::string_view (&names)[Count], Enum &value)
+    {
+        std::string_view name;
+        if (!ReadString(name)) {
+            return false;
+        }
+        const int index = FindName(names, name);
+        if (index < 0) {
+            return false;
+        }
+        value = static_cast<Enum>(index);
+        return true;
+    }
+
+    // Skips a value of any type, like a field that a later version added.
+    bool SkipValue(int depth = 0)
+    {
+        if (depth > kMaximumDepth) {
+            return false;
+        }
+        SkipWhitespace();
+        if (data_ == end_) {
+            return false;
+        }
+        std::string_view string;
+        double number = 0;
+        bool boolean = false;
+        switch (*data_) {
+            case '"':
+                return ReadString(string);
+            case 't':
+            case 'f':
+                return ReadBool(boolean);
+            case 'n':
+                return ConsumeWord("null");
+            case '[':
+                data_++;
+                if (Consume(']')) {
+                    return true;
+                }
+                do {
+                    if (!SkipValue(depth + 1)) {
+                        return false;
+                    }
+                } while (Consume(','));
+                return Consume(']');
+            case '{':
+                data_++;
+                if (Consume('}')) {
+                    return true;
+                }
+                do {
+                    if (!ReadString(string) || !Consume(':') || !SkipValue(depth + 1)) {
+                        return false;
+                    }
+                } while (Consume(','));
+                return Consume('}');
+            default:
+                return ReadDouble(number);
+        }
+    }
+
+private:
+    static bool IsNumberCharacter(char character)
+    {
+        return (character >= '0' && character <= '9') || character == '-' || character == '+' || character == '.' || character == 'e' || character == 'E';
+    }
+
+    void SkipWhitespace()
+    {
+        while (data_ != end_ && (*data_ == ' ' || *data_ == '\t' || *data_ == '\n' || *data_ == '\r')) {
+            data_++;
+        }
+    }
+
+    bool ConsumeWord(std::string_view word)
+    {
+        if (static_cast<size_t>(end_ - data_) < word.size() || std::string_view(data_, word.size()) != word) {
+            return false;
+        }
+        data_ += word.size();
+        return true;
+    }
+
+    const char *data_;
+    const char *end_;
+};
+
+// Calls `readField` with the name of every field of the object that is next, which must read or skip its value.
+template <typename ReadField>
+bool ReadJSONObject(JSONReader &reader, ReadField readField)
+{
+    if (!reader.Consume('{')) {
+        return false;
+    }
+    if (reader.Consume('}')) {
+        return true;
+    }
+    do {
+        std::string_view name;
+        if (!reader.ReadString(name) || !reader.Consume(':') || !readField(name)) {
+            return false;
+        }
+    } while (reader.Consume(','));
+    return reader.Consume('}');
+}
+
+// Reads a path element like `["curve", x1, y1, x2, y2, x, y]`.
+bool ReadJSONPathElement(JSONReader &reader, RSKPathElement &element)
+{
+    if (!reader.Consume('[') || !reader.ReadName(kPathElementTypeNames, element.type)) {
+        return false;
+    }
+    for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+        if (!reader.Consume(',') || !reader.ReadNumber(element.points[i].x) || !reader.Consume(',') || !reader.ReadNumber(element.points[i].y)) {
+            return false;
+        }
+    }
+    return reader.Consume(']');
+}
+
+bool ReadJSONPath(JSONReader &reader, PathElementSink &elements, RSKPath &path)
+{
+    return ReadJSONObject(reader, [&](std::string_view name) {
+        if (name == "usesEvenOddFillRule") {
+            return reader.ReadBool(path.usesEvenOddFillRule);
+        }
+        if (name == "elements") {
+            if (!reader.Consume('[')) {
+                return false;
+            }
+            if (reader.Consume(']')) {
+                return true;
+            }
+            do {
+                if (!ReadJSONPathElement(reader, elements.Next())) {
+                    return false;
+                }
+            } while (reader.Consume(','));
+            return reader.Consume(']');
+        }
+        return reader.SkipValue();
+    });
+}
+
+RSKCropStatus ReadJSONRecipe(const char *data, size_t length, PathElementSink &elements, RSKCropRecipe &recipe)
+{
+    JSONReader reader(data, length);
+    RSKCropSpec &spec = recipe.spec;
+    double version = 0;
+    const bool isRead = ReadJSONObject(reader, [&](std::string_view name) {
+        if (name == "version") {
+            return reader.ReadDouble(version);
+        }
+        if (name == "sourceSize") {
+            CGFloat *const numbers[] = { &recipe.sourceSize.width, &recipe.sourceSize.height };
+            return reader.ReadNumbers(numbers, 2);
+        }
+        if (name == "cropMode") {
+            return reader.ReadName(kCropModeNames, spec.cropMode);
+        }
+        if (name == "cropRect" || name == "imageRect") {
+            CGRect &rect = name == "cropRect" ? spec.cropRect : spec.imageRect;
+            CGFloat *const numbers[] = { &rect.origin.x, &rect.origin.y, &rect.size.width, &rect.size.height };
+            return reader.ReadNumbers(numbers, 4);
+        }
+        if (name == "rotationAngle") {
+            return reader.ReadNumber(spec.rotationAngle);
+        }
+        if (name == "zoomScale") {
+            return reader.ReadNumber(spec.zoomScale);
+        }
+        if (name == "imageOrientation") {
+            return reader.ReadName(kImageOrientationNames, spec.imageOrientation);
+        }
+        if (name == "maskPath") {
+            return ReadJSONPath(reader, elements, spec.maskPath);
+        }
+        if (name == "applyMaskToCroppedImage") {
+            return reader.ReadBool(spec.applyMaskToCroppedImage);
+        }
+        if (name == "resamplingFilter") {
+            return reader.ReadName(kResamplingFilterNames, spec.resamplingFilter);
+        }
+        if (name == "outputSize") {
+            CGFloat *const numbers[] = { &spec.outputSize.width, &spec.outputSize.height };
+            return reader.ReadNumbers(numbers, 2);
+        }
+        return reader.SkipValue();
+    });
+
+    // A later version may be malformed for this reader, so its version decides before the rest of the data does.
+    if (version > RSK_CROP_RECIPE_VERSION) {
+        return RSKCropStatusUnsupportedFormat;
+    }
+    if (!isRead || !reader.IsAtEnd()) {
+        return RSKCropStatusReadFailed;
+    }
+    if (version < 1 || version != std::floor(version)) {
+        return RSKCropStatusUnsupportedFormat;
+    }
+    return RSKCropStatusSuccess;
+}
+
+} // namespace
+
+size_t RSKCropRecipeWrite(const RSKCropRecipe *recipe, RSKCropRecipeFormat format, void *buffer, size_t capacity)
+{
+    if (!recipe || !IsValidRecipe(*recipe)) {
+        return 0;
+    }
+    RecipeWriter writer(buffer, capacity);
+    switch (format) {
+        case RSKCropRecipeFormatBinary:
+            WriteBinaryRecipe(*recipe, writer);
+            break;
+        case RSKCropRecipeFormatJSON:
+            WriteJSONRecipe(*recipe, writer);
+            break;
+        default:
+            return 0;
+    }
+    return writer.Length();
+}
+
+RSKCropStatus RSKCropRecipeRead(const void *data, size_t length, RSKPathElement *elements, size_t elementCapacity, RSKCropRecipe *recipe)
+{
+    if (!data || !recipe) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    // Step 1: tell the format by the first bytes of the data.
+    const char *bytes = static_cast<const char *>(data);
+    size_t start = 0;
+    while (start < length && (bytes[start] == ' ' || bytes[start] == '\t' || bytes[start] == '\n' || bytes[start] == '\r')) {
+        start++;
+    }
+    const bool isBinary = length >= sizeof(kSignature) && std::memcmp(bytes, kSignature, sizeof(kSignature)) == 0;
+    const bool isJSON = start < length && bytes[start] == '{';
+    if (!isBinary && !isJSON) {
+        return RSKCropStatusUnsupportedFormat;
+    }
+
+    // Step 2: read it into a recipe of zero values, so that fields a JSON recipe leaves out select the defaults.
+    RSKCropRecipe readRecipe = {};
+    PathElementSink sink(elements, elementCapacity);
+    const RSKCropStatus status = isBinary ? ReadBinaryRecipe(static_cast<const uint8_t *>(data), length, sink, readRecipe) : ReadJSONRecipe(bytes, length, sink, readRecipe);
+    if (status != RSKCropStatusSuccess) {
+        return status;
+    }
+
+    // Step 3: hand out the recipe with the path in the elements of the caller, if they have room for it and the recipe
+    // is one that can be cropped. Numbers that are well-formed but not finite, too large or negative where they cannot
+    // be are rejected like malformed data.
+    if (!sink.Fits()) {
+        recipe->spec.maskPath.elementCount = sink.Count();
+        return RSKCropStatusInvalidArgument;
+    }
+    readRecipe.spec.maskPath.elements = sink.Count() > 0 ? elements : nullptr;
+    readRecipe.spec.maskPath.elementCount = sink.Count();
+    if (!IsValidRecipe(readRecipe)) {
+        return RSKCropStatusReadFailed;
+    }
+    *recipe = readRecipe;
+    return RSKCropStatusSuccess;
+}
+
+RSKCropSpec RSKCropRecipeGetSpec(const RSKCropRecipe *recipe, size_t sourceWidth, size_t sourceHeight, CGSize outputSize)
+{
+    if (!recipe) {
+        return RSKCropSpec{};
+    }
+    RSKCropSpec spec = ScaleCropSpec(recipe->spec, recipe->sourceSize, sourceWidth, sourceHeight);
+    if (outputSize.width > 0 || outputSize.height > 0) {
+        spec.outputSize = outputSize;
+    }
+    return spec;
+}
+
+RSKCropStatus RSKCropEngineCropRecipe(const RSKBitmap *source, const RSKCropRecipe *recipe, CGSize outputSize, const RSKExecutor *executor, RSKBitmap *destination)
+{
+    if (!source || !recipe) {
+        return RSKCropStatusInvalidArgument;
+    }
+    const RSKCropSpec spec = RSKCropRecipeGetSpec(recipe, source->width, source->height, outputSize);
+    return RSKCropEngineCropBitmapWithExecutor(source, &spec, executor, destination);
+}
@@ -0,0 +1,101 @@
+//
+// RSKCropRecipe.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKCropRecipe_h
+#define RSKCropRecipe_h
+
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKCoreGraphics.h"
+#include "RSKCropEngine.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A crop recipe is everything that is needed to make a crop again without the view that made it, like on a server that
+// keeps the original image rather than the cropped one: the spec of the crop and the size of the source it was made
+// for. Replaying it on the same source produces the same pixels.
+//
+// A recipe is stored in one of two formats. The binary format is compact: a 4-byte signature, "RSKR", a version byte,
+// the enums and the flags of the spec in one byte each, every number as a little-endian 64-bit float, the number of
+// path elements as a little-endian 32-bit integer, and every element as a type byte followed by the points it uses.
+// The JSON format is an object with the fields of `RSKCropRecipe` and `RSKCropSpec`, whose enums are strings, rects,
+// sizes and points are arrays of numbers, and path elements are arrays of a type followed by the coordinates of their
+// points, like `["line", 10, 20]`. The numbers of both formats keep every bit of the spec.
+//
+// Both formats start with the version of the format. A reader accepts every version up to its own; a later version
+// only adds to the format, and the JSON fields that a reader does not know are skipped.
+
+// The version of the format that the library writes.
+#define RSK_CROP_RECIPE_VERSION 1
+
+// Formats of crop recipes.
+typedef enum RSKCropRecipeFormat {
+    RSKCropRecipeFormatBinary,
+    RSKCropRecipeFormatJSON
+} RSKCropRecipeFormat;
+
+// A crop and the source it was made for. The mask path is owned by the caller.
+typedef struct RSKCropRecipe {
+    // The size, in pixels, of the unoriented source that the spec was made for.
+    CGSize sourceSize;
+    RSKCropSpec spec;
+} RSKCropRecipe;
+
+// Writes `recipe` in `format` into `buffer`, which has room for `capacity` bytes, and returns the length of the recipe,
+// like `snprintf`: if the length is larger than `capacity`, only the bytes that fit are written, and the length tells
+// how large the buffer must be. `buffer` may be null if `capacity` is zero. The JSON is not terminated by a null
+// character. Returns zero if the recipe could not be cropped, like one with a number that is not finite, a coordinate
+// too large to be counted in pixels, a negative size or a zoom scale that is not positive.
+size_t RSKCropRecipeWrite(const RSKCropRecipe *recipe, RSKCropRecipeFormat format, void *buffer, size_t capacity);
+
+// Reads the recipe in `data` in either format, which is told by its first bytes, into `recipe` without allocating any
+// memory. The mask path is read into `elements`, which has room for `elementCapacity` elements and becomes the path of
+// the spec.
+//
+// Returns `RSKCropStatusUnsupportedFormat` if the data is not a recipe or is of a later version, and
+// `RSKCropStatusReadFailed` if it is truncated or malformed, or holds a recipe that `RSKCropRecipeWrite` would not
+// write. If the path has more elements than `elements` has room for, returns `RSKCropStatusInvalidArgument` and sets
+// only the element count of the path, so that it can be read again with enough room.
+RSKCropStatus RSKCropRecipeRead(const void *data, size_t length, RSKPathElement *elements, size_t elementCapacity, RSKCropRecipe *recipe);
+
+// Returns the spec of `recipe` for a source of `sourceWidth` x `sourceHeight` pixels, scaled from the size of the
+// source it was made for, like a rendition of the same photo with more or fewer pixels. If `outputSize` is not zero,
+// the result is scaled to it instead of the output size of the recipe.
+RSKCropSpec RSKCropRecipeGetSpec(const RSKCropRecipe *recipe, size_t sourceWidth, size_t sourceHeight, CGSize outputSize);
+
+// Crops `source` according to `recipe`, with the spec of `RSKCropRecipeGetSpec` for its size and `outputSize`, and
+// writes the result into `destination`, which must have the size that `RSKCropEngineGetOutputSize` returns for that
+// spec. On the source the recipe was made for, the result is identical to the crop that was made. `executor` may be
+// null.
+RSKCropStatus RSKCropEngineCropRecipe(const RSKBitmap *source, const RSKCropRecipe *recipe, CGSize outputSize, const RSKExecutor *executor, RSKBitmap *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKCropRecipe_h */
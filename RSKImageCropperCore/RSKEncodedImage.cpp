@@ -0,0 +1,1037 @@
+//
+// RSKEncodedImage.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKEncodedImage.h"
+
+#include <algorithm>
+#include <csetjmp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// `RSK_HAS_LIBJPEG` and `RSK_HAS_LIBPNG` build the decoders, which need libjpeg-turbo and libpng. Without them, only
+// the formats of encoded images are recognized.
+#if defined(RSK_HAS_LIBJPEG) && RSK_HAS_LIBJPEG
+#include <jpeglib.h>
+#endif
+#if defined(RSK_HAS_LIBPNG) && RSK_HAS_LIBPNG
+#include <png.h>
+#endif
+
+#include "RSKCropEngine.hpp"
+#include "RSKImageTransforms.hpp"
+#include "RSKMappedFile.hpp"
+
+namespace {
+
+using namespace rsk;
+
+const uint8_t kJpegSignature[] = { 0xFF, 0xD8, 0xFF };
+const uint8_t kPngSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+template <size_t Length>
+bool HasSignature(const void *data, size_t length, const uint8_t (&signature)[Length])
+{
+    return length >= Length && std::memcmp(data, signature, Length) == 0;
+}
+
+// Returns whether `destination` has the size of the result of cropping a `width` x `height` image according to `spec`.
+[[maybe_unused]] bool IsValidDestination(size_t width, size_t height, const RSKCropSpec &spec, const RSKBitmap &destination)
+{
+    const CGSize outputSize = RSKCropEngineGetOutputSize(width, height, &spec);
+    return outputSize.width == destination.width && outputSize.height == destination.height;
+}
+
+#if defined(RSK_HAS_LIBJPEG) && RSK_HAS_LIBJPEG
+
+// The largest factor by which libjpeg scales an image down while it decodes it.
+constexpr size_t kMaximumJpegScaleDenominator = 8;
+
+struct JpegErrorManager {
+    jpeg_error_mgr manager;
+    std::jmp_buf jump;
+};
+
+void ExitWithJpegError(j_common_ptr info)
+{
+    std::longjmp(reinterpret_cast<JpegErrorManager *>(info->err)->jump, 1);
+}
+
+void IgnoreJpegMessage(j_common_ptr)
+{
+}
+
+// The number of bytes of the data that a JPEG source hands to libjpeg at a time while it may stop early.
+constexpr size_t kJpegSourceWindowSize = 64 * 1024;
+
+// A libjpeg source of data in memory, like the one of `jpeg_mem_src`, that can end the data early once libjpeg has
+// read `stopMcuRow` iMCU rows. Until then it may hand the data over in windows, so that it sees how far libjpeg is.
+struct JpegMemorySource {
+    jpeg_source_mgr manager;
+    const JOCTET *limit = nullptr;
+    const JOCTET *end = nullptr;
+    JDIMENSION stopMcuRow = 0;
+};
+
+const JOCTET kJpegEndOfImage[] = { 0xFF, JPEG_EOI };
+
+void InitJpegSource(j_decompress_ptr)
+{
+}
+
+boolean FillJpegSource(j_decompress_ptr info)
+{
+    JpegMemorySource &source = *reinterpret_cast<JpegMemorySource *>(info->src);
+    if (source.limit < source.end && info->input_iMCU_row < source.stopMcuRow) {
+        source.manager.next_input_byte = source.limit;
+        source.limit += std::min(kJpegSourceWindowSize, static_cast<size_t>(source.end - source.limit));
+        source.manager.bytes_in_buffer = static_cast<size_t>(source.limit - source.manager.next_input_byte);
+        return TRUE;
+    }
+
+    // Like `jpeg_mem_src`, end truncated data with a marker, so that the rest of the blocks are left empty.
+    source.manager.next_input_byte = kJpegEndOfImage;
+    source.manager.bytes_in_buffer = sizeof(kJpegEndOfImage);
+    return TRUE;
+}
+
+void SkipJpegSource(j_decompress_ptr info, long byteCount)
+{
+    jpeg_source_mgr &manager = *info->src;
+    while (byteCount > static_cast<long>(manager.bytes_in_buffer)) {
+        byteCount -= static_cast<long>(manager.bytes_in_buffer);
+        FillJpegSource(info);
+    }
+    if (byteCount > 0) {
+        manager.next_input_byte += byteCount;
+        manager.bytes_in_buffer -= static_cast<size_t>(byteCount);
+    }
+}
+
+void TermJpegSource(j_decompress_ptr)
+{
+}
+
+// A JPEG decompressor of data in memory.
+//
+// libjpeg reports errors by jumping out of its calls, so every method that calls it sets the jump itself and keeps
+// no objects with destructors on the stack.
+class JpegDecoder {
+public:
+    JpegDecoder()
+    {
+        std::memset(&info_, 0, sizeof(info_));
+        info_.err = jpeg_std_error(&error_.manager);
+        error_.manager.error_exit = ExitWithJpegError;
+        error_.manager.output_message = IgnoreJpegMessage;
+        source_.manager.init_source = InitJpegSource;
+        source_.manager.fill_input_buffer = FillJpegSource;
+        source_.manager.skip_input_data = SkipJpegSource;
+        source_.manager.resync_to_restart = jpeg_resync_to_restart;
+        source_.manager.term_source = TermJpegSource;
+    }
+
+    ~JpegDecoder()
+    {
+        if (created_) {
+            jpeg_destroy_decompress(&info_);
+        }
+    }
+
+    JpegDecoder(const JpegDecoder &) = delete;
+    JpegDecoder &operator=(const JpegDecoder &) = delete;
+
+    // Reads the header of the JPEG in `data`.
+    bool ReadHeader(const void *data, size_t length)
+    {
+        if (setjmp(error_.jump)) {
+            return false;
+        }
+        jpeg_create_decompress(&info_);
+        created_ = true;
+        source_.manager.next_input_byte = static_cast<const JOCTET *>(data);
+        source_.manager.bytes_in_buffer = length;
+        source_.limit = source_.manager.next_input_byte + length;
+        source_.end = source_.limit;
+        info_.src = &source_.manager;
+        return jpeg_read_header(&info_, TRUE) == JPEG_HEADER_OK;
+    }
+
+    size_t ImageWidth() const { return info_.image_width; }
+    size_t ImageHeight() const { return info_.image_height; }
+    size_t OutputWidth() const { return info_.output_width; }
+    size_t OutputHeight() const { return info_.output_height; }
+
+    // Starts decoding the image scaled down by `scaleDenominator` into pixels of `pixelFormat`.
+    bool Start(size_t scaleDenominator, RSKPixelFormat pixelFormat)
+    {
+        if (setjmp(error_.jump)) {
+            return false;
+        }
+        if (info_.jpeg_color_space == JCS_CMYK || info_.jpeg_color_space == JCS_YCCK) {
+            return false;
+        }
+        info_.scale_num = 1;
+        info_.scale_denom = static_cast<unsigned int>(scaleDenominator);
+        info_.out_color_space = pixelFormat == RSKPixelFormatBGRA8888 ? JCS_EXT_BGRA : JCS_EXT_RGBA;
+        return jpeg_start_decompress(&info_);
+    }
+
+    // Decodes only the columns of blocks that contain the `width` columns at `x`. Moves `x` and `width` out to the edges
+    // of the blocks.
+    bool CropColumns(size_t &x, size_t &width)
+    {
+        if (setjmp(error_.jump)) {
+            return false;
+        }
+        JDIMENSION croppedX = static_cast<JDIMENSION>(x);
+        JDIMENSION croppedWidth = static_cast<JDIMENSION>(width);
+        jpeg_crop_scanline(&info_, &croppedX, &croppedWidth);
+        x = croppedX;
+        width = croppedWidth;
+        return true;
+    }
+
+    // Skips the rows above `y` and decodes the rows of `destination`, which has the width of the decoded columns.
+    bool ReadRows(size_t y, const BitmapView &destination)
+    {
+        if (setjmp(error_.jump)) {
+            return false;
+        }
+        if (y > 0 && jpeg_skip_scanlines(&info_, static_cast<JDIMENSION>(y)) != y) {
+            return false;
+        }
+        while (info_.output_scanline < y + destination.height) {
+            JSAMPROW row = destination.Row(info_.output_scanline - y);
+            if (jpeg_read_scanlines(&info_, &row, 1) != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Reads the blocks of coefficients of every component instead of decoding the image. Returns null if they cannot
+    // be read.
+    //
+    // If the image is coded in a single scan, whose blocks are all read in order, only the iMCU rows that hold the
+    // first `rowCount` rows of pixels are read, and the image is cut to them: the height of the image and of its
+    // components shrinks, so libjpeg neither reads nor stores the blocks below, and the data ends after them.
+    jvirt_barray_ptr *ReadCoefficients(size_t rowCount)
+    {
+        if (setjmp(error_.jump)) {
+            return nullptr;
+        }
+        const size_t mcuHeight = static_cast<size_t>(info_.max_v_samp_factor) * DCTSIZE;
+        const JDIMENSION mcuRowCount = static_cast<JDIMENSION>((rowCount + mcuHeight - 1) / mcuHeight);
+        if (!info_.progressive_mode && info_.comps_in_scan == info_.num_components && mcuRowCount < info_.total_iMCU_rows) {
+            info_.image_height = static_cast<JDIMENSION>(mcuRowCount * mcuHeight);
+            info_.total_iMCU_rows = mcuRowCount;
+            for (int c = 0; c < info_.num_components; c++) {
+                jpeg_component_info &component = info_.comp_info[c];
+                component.height_in_blocks = mcuRowCount * static_cast<JDIMENSION>(component.v_samp_factor);
+                component.downsampled_height = component.height_in_blocks * DCTSIZE;
+            }
+            source_.limit = source_.manager.next_input_byte + std::min(kJpegSourceWindowSize, source_.manager.bytes_in_buffer);
+            source_.manager.bytes_in_buffer = static_cast<size_t>(source_.limit - source_.manager.next_input_byte);
+        }
+        source_.stopMcuRow = info_.total_iMCU_rows;
+        return jpeg_read_coefficients(&info_);
+    }
+
+    jpeg_decompress_struct *Info() { return &info_; }
+
+private:
+    jpeg_decompress_struct info_;
+    JpegErrorManager error_;
+    JpegMemorySource source_;
+    bool created_ = false;
+};
+
+RSKCropStatus GetJpegSize(const void *data, size_t length, size_t &width, size_t &height)
+{
+    JpegDecoder decoder;
+    if (!decoder.ReadHeader(data, length)) {
+        return RSKCropStatusReadFailed;
+    }
+    width = decoder.ImageWidth();
+    height = decoder.ImageHeight();
+    return RSKCropStatusSuccess;
+}
+
+bool IsJpegOpaque(const void *data, size_t length)
+{
+    JpegDecoder decoder;
+    return decoder.ReadHeader(data, length);
+}
+
+RSKCropStatus CropJpeg(const void *data, size_t length, const RSKCropSpec &spec, const RSKExecutor *executor, const RSKBitmap &destination)
+{
+    JpegDecoder decoder;
+    if (!decoder.ReadHeader(data, length)) {
+        return RSKCropStatusReadFailed;
+    }
+    const size_t width = decoder.ImageWidth();
+    const size_t height = decoder.ImageHeight();
+    CropFootprint footprint;
+    if (!IsValidDestination(width, height, spec, destination) || !GetCropFootprint(width, height, spec, footprint)) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    // Step 1: let the decoder take the largest share of the reduction of the crop that it can, which saves the
+    // inverse DCT of most of the coefficients.
+    size_t scaleDenominator = 1;
+    while (scaleDenominator * 2 <= std::min(footprint.reductionFactor, kMaximumJpegScaleDenominator)) {
+        scaleDenominator *= 2;
+    }
+    if (!decoder.Start(scaleDenominator, destination.pixelFormat)) {
+        return RSKCropStatusReadFailed;
+    }
+
+    // Step 2: map the crop onto the scaled image.
+    const size_t scaledWidth = decoder.OutputWidth();
+    const size_t scaledHeight = decoder.OutputHeight();
+    const RSKCropSpec scaledSpec = ScaleCropSpec(spec, CGSizeMake(width, height), scaledWidth, scaledHeight);
+    if (!GetCropFootprint(scaledWidth, scaledHeight, scaledSpec, footprint)) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    // Step 3: decode the blocks that hold the footprint of the crop and nothing below them.
+    size_t partX = footprint.x;
+    size_t partWidth = footprint.width;
+    PixelBuffer part;
+    if (footprint.width > 0 && footprint.height > 0) {
+        if (!decoder.CropColumns(partX, partWidth)) {
+            return RSKCropStatusReadFailed;
+        }
+        part = PixelBuffer(partWidth, footprint.height);
+        if (!decoder.ReadRows(footprint.y, part.View())) {
+            return RSKCropStatusReadFailed;
+        }
+    }
+
+    // Step 4: crop the decoded part.
+    return CropBitmapPart(part.View(), partX, footprint.y, scaledWidth, scaledHeight, scaledSpec, executor, MakeBitmapView(destination));
+}
+
+// The size of the first buffer of encoded data, which doubles whenever it fills up.
+constexpr size_t kInitialJpegBufferSize = 64 * 1024;
+
+// The quality of the JPEG that `RSKCropEngineCropEncodedImageToJPEG` encodes by default.
+constexpr int kDefaultJpegQuality = 90;
+
+// A libjpeg destination that encodes into a growing buffer of `malloc`.
+struct JpegMemoryDestination {
+    jpeg_destination_mgr manager;
+    unsigned char *data = nullptr;
+    size_t capacity = 0;
+    size_t length = 0;
+    bool outOfMemory = false;
+};
+
+// Jumps out of the encoder of `info` because the buffer of the destination cannot grow.
+void ExitWithJpegOutOfMemory(j_compress_ptr info)
+{
+    reinterpret_cast<JpegMemoryDestination *>(info->dest)->outOfMemory = true;
+    info->err->error_exit(reinterpret_cast<j_common_ptr>(info));
+}
+
+void InitJpegDestination(j_compress_ptr info)
+{
+    JpegMemoryDestination &destination = *reinterpret_cast<JpegMemoryDestination *>(info->dest);
+    if (!destination.data) {
+        destination.data = static_cast<unsigned char *>(std::malloc(kInitialJpegBufferSize));
+        if (!destination.data) {
+            ExitWithJpegOutOfMemory(info);
+        }
+        destination.capacity = kInitialJpegBufferSize;
+    }
+    destination.manager.next_output_byte = destination.data;
+    destination.manager.free_in_buffer = destination.capacity;
+}
+
+boolean EmptyJpegDestination(j_compress_ptr info)
+{
+    JpegMemoryDestination &destination = *reinterpret_cast<JpegMemoryDestination *>(info->dest);
+    unsigned char *data = static_cast<unsigned char *>(std::realloc(destination.data, destination.capacity * 2));
+    if (!data) {
+        ExitWithJpegOutOfMemory(info);
+    }
+    destination.data = data;
+    destination.manager.next_output_byte = data + destination.capacity;
+    destination.manager.free_in_buffer = destination.capacity;
+    destination.capacity *= 2;
+    return TRUE;
+}
+
+void TermJpegDestination(j_compress_ptr info)
+{
+    JpegMemoryDestination &destination = *reinterpret_cast<JpegMemoryDestination *>(info->dest);
+    destination.length = destination.capacity - destination.manager.free_in_buffer;
+}
+
+// A JPEG compressor into memory, which encodes either pixels or the coefficients of a decompressor.
+//
+// Like `JpegDecoder`, every method that calls libjpeg sets the jump itself.
+class JpegEncoder {
+public:
+    JpegEncoder()
+    {
+        std::memset(&info_, 0, sizeof(info_));
+        info_.err = jpeg_std_error(&error_.manager);
+        error_.manager.error_exit = ExitWithJpegError;
+        error_.manager.output_message = IgnoreJpegMessage;
+        destination_.manager.init_destination = InitJpegDestination;
+        destination_.manager.empty_output_buffer = EmptyJpegDestination;
+        destination_.manager.term_destination = TermJpegDestination;
+    }
+
+    ~JpegEncoder()
+    {
+        if (created_) {
+            jpeg_destroy_compress(&info_);
+        }
+        std::free(destination_.data);
+    }
+
+    JpegEncoder(const JpegEncoder &) = delete;
+    JpegEncoder &operator=(const JpegEncoder &) = delete;
+
+    bool IsOutOfMemory() const { return destination_.outOfMemory; }
+
+    // Encodes the pixels of `source`, ignoring their alpha, with `quality`.
+    bool EncodePixels(const BitmapView &source, RSKPixelFormat pixelFormat, int quality)
+    {
+        if (setjmp(error_.jump)) {
+            return false;
+        }
+        Create();
+        info_.image_width = static_cast<JDIMENSION>(source.width);
+        info_.image_height = static_cast<JDIMENSION>(source.height);
+        info_.input_components = static_cast<int>(kBytesPerPixel);
+        info_.in_color_space = pixelFormat == RSKPixelFormatBGRA8888 ? JCS_EXT_BGRA : JCS_EXT_RGBA;
+        jpeg_set_defaults(&info_);
+        jpeg_set_quality(&info_, quality, TRUE);
+        jpeg_start_compress(&info_, TRUE);
+        while (info_.next_scanline < info_.image_height) {
+            JSAMPROW row = source.Row(info_.next_scanline);
+            jpeg_write_scanlines(&info_, &row, 1);
+        }
+        jpeg_finish_compress(&info_);
+        return true;
+    }
+
+    // Encodes the `mapping.width` x `mapping.height` blocks of coefficients of `decoder` at `mapping.x` and
+    // `mapping.y`, moved as `mapping` moves pixels. The origin of the mapping must be on the edges of the iMCUs of the
+    // decoder, and so must the far edges that it flips.
+    bool EncodeCoefficients(JpegDecoder &decoder, const CropPixelMapping &mapping)
+    {
+        jvirt_barray_ptr *sourceArrays = decoder.ReadCoefficients(mapping.y + mapping.height);
+        if (!sourceArrays) {
+            return false;
+        }
+        if (setjmp(error_.jump)) {
+            return false;
+        }
+        Create();
+        jpeg_copy_critical_parameters(decoder.Info(), &info_);
+        info_.image_width = static_cast<JDIMENSION>(mapping.swapsAxes ? mapping.height : mapping.width);
+        info_.image_height = static_cast<JDIMENSION>(mapping.swapsAxes ? mapping.width : mapping.height);
+        if (mapping.swapsAxes) {
+            TransposeCriticalParameters();
+        }
+
+        // Step 1: ask for arrays of the blocks of the result, rounded out to whole MCUs. The largest sampling factors
+        // are only set by `jpeg_write_coefficients`, which needs the arrays.
+        int maxHorizontalFactor = 1;
+        int maxVerticalFactor = 1;
+        for (int c = 0; c < info_.num_components; c++) {
+            maxHorizontalFactor = std::max(maxHorizontalFactor, info_.comp_info[c].h_samp_factor);
+            maxVerticalFactor = std::max(maxVerticalFactor, info_.comp_info[c].v_samp_factor);
+        }
+        jvirt_barray_ptr arrays[MAX_COMPONENTS];
+        for (int c = 0; c < info_.num_components; c++) {
+            const jpeg_component_info &component = info_.comp_info[c];
+            const size_t width = DivideRoundingUp(info_.image_width * static_cast<size_t>(component.h_samp_factor), static_cast<size_t>(maxHorizontalFactor) * DCTSIZE);
+            const size_t height = DivideRoundingUp(info_.image_height * static_cast<size_t>(component.v_samp_factor), static_cast<size_t>(maxVerticalFactor) * DCTSIZE);
+            arrays[c] = info_.mem->request_virt_barray(reinterpret_cast<j_common_ptr>(&info_), JPOOL_IMAGE, FALSE,
+                static_cast<JDIMENSION>(RoundUp(width, component.h_samp_factor)), static_cast<JDIMENSION>(RoundUp(height, component.v_samp_factor)),
+                static_cast<JDIMENSION>(component.v_samp_factor));
+        }
+        jpeg_write_coefficients(&info_, arrays);
+
+        // Step 2: move the blocks of every component.
+        const jpeg_decompress_struct &source = *decoder.Info();
+        for (int c = 0; c < info_.num_components; c++) {
+            MoveBlocks(source, source.comp_info[c], sourceArrays[c], info_.comp_info[c], arrays[c], mapping);
+        }
+        jpeg_finish_compress(&info_);
+        return true;
+    }
+
+    // Hands the encoded data over to `result`.
+    void TakeData(RSKEncodedData &result)
+    {
+        result.data = destination_.data;
+        result.length = destination_.length;
+        destination_.data = nullptr;
+        destination_.capacity = 0;
+    }
+
+private:
+    static size_t DivideRoundingUp(size_t dividend, size_t divisor)
+    {
+        return (dividend + divisor - 1) / divisor;
+    }
+
+    static size_t RoundUp(size_t value, int multiple)
+    {
+        return DivideRoundingUp(value, static_cast<size_t>(multiple)) * static_cast<size_t>(multiple);
+    }
+
+    void Create()
+    {
+        jpeg_create_compress(&info_);
+        created_ = true;
+        info_.dest = &destination_.manager;
+    }
+
+    // Swaps the sampling factors of the components and transposes the quantization tables, so that they match
+    // transposed blocks.
+    void TransposeCriticalParameters()
+    {
+        for (int c = 0; c < info_.num_components; c++) {
+            jpeg_component_info &component = info_.comp_info[c];
+            std::swap(component.h_samp_factor, component.v_samp_factor);
+        }
+        for (JQUANT_TBL *table : info_.quant_tbl_ptrs) {
+            if (!table) {
+                continue;
+            }
+            for (int v = 0; v < DCTSIZE; v++) {
+                for (int u = v + 1; u < DCTSIZE; u++) {
+                    std::swap(table->quantval[v * DCTSIZE + u], table->quantval[u * DCTSIZE + v]);
+                }
+            }
+        }
+    }
+
+    // Fills the blocks of `destinationArray` with the blocks of `sourceArray` that `mapping` moves there. A block of
+    // the result that lies in the padding of the last MCU and has no block of the source is cleared.
+    void MoveBlocks(const jpeg_decompress_struct &source, const jpeg_component_info &sourceComponent, jvirt_barray_ptr sourceArray,
+        const jpeg_component_info &destinationComponent, jvirt_barray_ptr destinationArray, const CropPixelMapping &mapping)
+    {
+        j_common_ptr sourceInfo = reinterpret_cast<j_common_ptr>(const_cast<jpeg_decompress_struct *>(&source));
+        j_common_ptr destinationInfo = reinterpret_cast<j_common_ptr>(&info_);
+
+        // The blocks of the source that the mapping reads, in the blocks of this component.
+        const size_t blockWidth = static_cast<size_t>(source.max_h_samp_factor) * DCTSIZE / sourceComponent.h_samp_factor;
+        const size_t blockHeight = static_cast<size_t>(source.max_v_samp_factor) * DCTSIZE / sourceComponent.v_samp_factor;
+        const size_t blockX = mapping.x / blockWidth;
+        const size_t blockY = mapping.y / blockHeight;
+        const size_t blockCountX = mapping.width / blockWidth;
+        const size_t blockCountY = mapping.height / blockHeight;
+        const size_t sourceColumns = RoundUp(sourceComponent.width_in_blocks, sourceComponent.h_samp_factor);
+        const size_t sourceRows = RoundUp(sourceComponent.height_in_blocks, sourceComponent.v_samp_factor);
+
+        const size_t columns = RoundUp(destinationComponent.width_in_blocks, destinationComponent.h_samp_factor);
+        const size_t rows = RoundUp(destinationComponent.height_in_blocks, destinationComponent.v_samp_factor);
+        for (size_t y = 0; y < rows; y++) {
+            JBLOCKROW destinationRow = info_.mem->access_virt_barray(destinationInfo, destinationArray, static_cast<JDIMENSION>(y), 1, TRUE)[0];
+            for (size_t x = 0; x < columns; x++) {
+                const size_t a = mapping.swapsAxes ? y : x;
+                const size_t b = mapping.swapsAxes ? x : y;
+                const size_t sourceX = blockX + (mapping.flipsHorizontally ? blockCountX - 1 - a : a);
+                const size_t sourceY = blockY + (mapping.flipsVertically ? blockCountY - 1 - b : b);
+                if (sourceX >= sourceColumns || sourceY >= sourceRows) {
+                    std::memset(destinationRow[x], 0, sizeof(JBLOCK));
+                    continue;
+                }
+                JBLOCKROW sourceRow = source.mem->access_virt_barray(sourceInfo, sourceArray, static_cast<JDIMENSION>(sourceY), 1, FALSE)[0];
+                MoveCoefficients(sourceRow[sourceX], mapping, destinationRow[x]);
+            }
+        }
+    }
+
+    // Moves the coefficients of one block. Flipping a block negates its odd frequencies along the flipped axis, and
+    // swapping its axes transposes it.
+    static void MoveCoefficients(const JBLOCK &source, const CropPixelMapping &mapping, JBLOCK &destination)
+    {
+        if (!mapping.swapsAxes && !mapping.flipsHorizontally && !mapping.flipsVertically) {
+            std::memcpy(destination, source, sizeof(JBLOCK));
+            return;
+        }
+        for (int v = 0; v < DCTSIZE; v++) {
+            for (int u = 0; u < DCTSIZE; u++) {
+                const int sourceU = mapping.swapsAxes ? v : u;
+                const int sourceV = mapping.swapsAxes ? u : v;
+                const bool negates = (mapping.flipsHorizontally && (sourceU & 1)) != (mapping.flipsVertically && (sourceV & 1));
+                const JCOEF coefficient = source[sourceV * DCTSIZE + sourceU];
+                destination[v * DCTSIZE + u] = static_cast<JCOEF>(negates ? -coefficient : coefficient);
+            }
+        }
+    }
+
+    jpeg_compress_struct info_;
+    JpegErrorManager error_;
+    JpegMemoryDestination destination_;
+    bool created_ = false;
+};
+
+// Returns the width and the height, in pixels, of the iMCUs of the JPEG of `info`. The coefficients of a JPEG can
+// only be moved by whole iMCUs.
+void GetJpegMcuSize(const jpeg_decompress_struct &info, size_t &width, size_t &height)
+{
+    width = info.num_components == 1 ? DCTSIZE : static_cast<size_t>(info.max_h_samp_factor) * DCTSIZE;
+    height = info.num_components == 1 ? DCTSIZE : static_cast<size_t>(info.max_v_samp_factor) * DCTSIZE;
+}
+
+// Returns whether the edges of `mapping` that its coefficients are moved by are on the edges of the iMCUs. If
+// `snapsToBlocks` is set, moves the edges out to the iMCUs first, as long as they stay inside of the image.
+bool AlignMappingToMcus(size_t imageWidth, size_t imageHeight, size_t mcuWidth, size_t mcuHeight, bool snapsToBlocks, CropPixelMapping &mapping)
+{
+    const auto alignAxis = [snapsToBlocks](size_t imageLength, size_t mcuLength, bool flips, size_t &origin, size_t &length) {
+        if (snapsToBlocks) {
+            length += origin % mcuLength;
+            origin -= origin % mcuLength;
+            if (flips && length % mcuLength != 0) {
+                length += mcuLength - length % mcuLength;
+            }
+        }
+        return origin % mcuLength == 0 && (!flips || length % mcuLength == 0) && origin + length <= imageLength;
+    };
+    return alignAxis(imageWidth, mcuWidth, mapping.flipsHorizontally, mapping.x, mapping.width) &&
+           alignAxis(imageHeight, mcuHeight, mapping.flipsVertically, mapping.y, mapping.height);
+}
+
+RSKCropStatus CropJpegToJpeg(const void *data, size_t length, const RSKCropSpec &spec, const RSKJPEGCropOptions &options, RSKEncodedData &result)
+{
+    JpegDecoder decoder;
+    if (!decoder.ReadHeader(data, length)) {
+        return RSKCropStatusReadFailed;
+    }
+    const size_t width = decoder.ImageWidth();
+    const size_t height = decoder.ImageHeight();
+
+    // Step 1: move the coefficients of the crop if it only moves whole pixels by whole iMCUs.
+    CropPixelMapping mapping;
+    size_t mcuWidth = 0;
+    size_t mcuHeight = 0;
+    GetJpegMcuSize(*decoder.Info(), mcuWidth, mcuHeight);
+    if (GetCropPixelMapping(width, height, spec, mapping) && AlignMappingToMcus(width, height, mcuWidth, mcuHeight, options.snapsToBlocks, mapping)) {
+        JpegEncoder encoder;
+        if (!encoder.EncodeCoefficients(decoder, mapping)) {
+            return encoder.IsOutOfMemory() ? RSKCropStatusOutOfMemory : RSKCropStatusReadFailed;
+        }
+        encoder.TakeData(result);
+        result.isLossless = true;
+        return RSKCropStatusSuccess;
+    }
+
+    // Step 2: otherwise decode the crop and encode its pixels.
+    const CGSize outputSize = RSKCropEngineGetOutputSize(width, height, &spec);
+    PixelBuffer pixels(static_cast<size_t>(outputSize.width), static_cast<size_t>(outputSize.height));
+    const BitmapView &view = pixels.View();
+    if (view.width == 0 || view.height == 0) {
+        return RSKCropStatusInvalidArgument;
+    }
+    RSKBitmap destination = RSKBitmapMake(view.data, view.width, view.height, view.bytesPerRow, RSKPixelFormatRGBA8888);
+    const RSKCropStatus status = CropJpeg(data, length, spec, options.executor, destination);
+    if (status != RSKCropStatusSuccess) {
+        return status;
+    }
+    JpegEncoder encoder;
+    if (!encoder.EncodePixels(view, RSKPixelFormatRGBA8888, options.quality > 0 ? options.quality : kDefaultJpegQuality)) {
+        return encoder.IsOutOfMemory() ? RSKCropStatusOutOfMemory : RSKCropStatusWriteFailed;
+    }
+    encoder.TakeData(result);
+    result.isLossless = false;
+    return RSKCropStatusSuccess;
+}
+
+#endif
+
+#if defined(RSK_HAS_LIBPNG) && RSK_HAS_LIBPNG
+
+[[noreturn]] void ExitWithPngError(png_structp png, png_const_charp)
+{
+    png_longjmp(png, 1);
+}
+
+void IgnorePngWarning(png_structp, png_const_charp)
+{
+}
+
+// A PNG decompressor of data in memory.
+//
+// libpng reports errors by jumping out of its calls, so every method that calls it sets the jump itself and keeps
+// no objects with destructors on the stack.
+class PngDecoder {
+public:
+    PngDecoder(const void *data, size_t length)
+        : data_(static_cast<const uint8_t *>(data)),
+          length_(length)
+    {
+    }
+
+    ~PngDecoder()
+    {
+        if (png_) {
+            png_destroy_read_struct(&png_, info_ ? &info_ : nullptr, nullptr);
+        }
+    }
+
+    PngDecoder(const PngDecoder &) = delete;
+    PngDecoder &operator=(const PngDecoder &) = delete;
+
+    bool ReadHeader()
+    {
+        png_ = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, ExitWithPngError, IgnorePngWarning);
+        if (!png_) {
+            return false;
+        }
+        info_ = png_create_info_struct(png_);
+        if (!info_) {
+            return false;
+        }
+        if (setjmp(png_jmpbuf(png_))) {
+            return false;
+        }
+        png_set_read_fn(png_, this, ReadData);
+        png_read_info(png_, info_);
+        return true;
+    }
+
+    size_t ImageWidth() const { return png_get_image_width(png_, info_); }
+    size_t ImageHeight() const { return png_get_image_height(png_, info_); }
+
+    // Returns whether the image has an alpha channel or a transparent color, judged by its header, so that its pixels may
+    // not be opaque. `Start` turns the color type into the decoded one, so this is asked before it.
+    bool HasAlpha() const { return (png_get_color_type(png_, info_) & PNG_COLOR_MASK_ALPHA) || png_get_valid(png_, info_, PNG_INFO_tRNS); }
+
+    // Returns whether the rows of the image are interlaced, so that every row is decoded in several passes.
+    bool IsInterlaced() const { return passCount_ > 1; }
+
+    // Starts decoding the image into 8-bit pixels of `pixelFormat` with straight alpha.
+    bool Start(RSKPixelFormat pixelFormat)
+    {
+        if (setjmp(png_jmpbuf(png_))) {
+            return false;
+        }
+        png_set_expand(png_);
+        png_set_strip_16(png_);
+        png_set_gray_to_rgb(png_);
+        png_set_add_alpha(png_, 0xFF, PNG_FILLER_AFTER);
+        if (pixelFormat == RSKPixelFormatBGRA8888) {
+            png_set_bgr(png_);
+        }
+        passCount_ = png_set_interlace_handling(png_);
+        png_read_update_info(png_, info_);
+        return png_get_rowbytes(png_, info_) == ImageWidth() * kBytesPerPixel;
+    }
+
+    // Decodes the next row of an image that is not interlaced into `row`.
+    bool ReadRow(uint8_t *row)
+    {
+        if (setjmp(png_jmpbuf(png_))) {
+            return false;
+        }
+        png_read_row(png_, row, nullptr);
+        return true;
+    }
+
+    // Decodes the rows of an interlaced image down to the last row of `rows`, which are the whole rows at `y`, pass by
+    // pass. The other rows are decoded into `scratchRow`.
+    bool ReadInterlacedRows(size_t y, const BitmapView &rows, uint8_t *scratchRow)
+    {
+        if (setjmp(png_jmpbuf(png_))) {
+            return false;
+        }
+        const size_t height = ImageHeight();
+        for (int pass = 0; pass < passCount_; pass++) {
+            const size_t endRow = pass + 1 < passCount_ ? height : y + rows.height;
+            for (size_t row = 0; row < endRow; row++) {
+                png_read_row(png_, row >= y && row < y + rows.height ? rows.Row(row - y) : scratchRow, nullptr);
+            }
+        }
+        return true;
+    }
+
+private:
+    static void ReadData(png_structp png, png_bytep bytes, png_size_t count)
+    {
+        PngDecoder &decoder = *static_cast<PngDecoder *>(png_get_io_ptr(png));
+        if (count > decoder.length_ - decoder.offset_) {
+            png_error(png, "The PNG data is truncated.");
+        }
+        std::memcpy(bytes, decoder.data_ + decoder.offset_, count);
+        decoder.offset_ += count;
+    }
+
+    const uint8_t *data_;
+    size_t length_;
+    size_t offset_ = 0;
+    png_structp png_ = nullptr;
+    png_infop info_ = nullptr;
+    int passCount_ = 1;
+};
+
+// Multiplies the colors of every pixel of `view` by its alpha.
+void PremultiplyBitmap(const BitmapView &view)
+{
+    for (size_t y = 0; y < view.height; y++) {
+        uint8_t *pixel = view.Row(y);
+        for (size_t x = 0; x < view.width; x++, pixel += kBytesPerPixel) {
+            const unsigned alpha = pixel[3];
+            if (alpha != 255) {
+                for (size_t c = 0; c < 3; c++) {
+                    pixel[c] = static_cast<uint8_t>((pixel[c] * alpha + 127) / 255);
+                }
+            }
+        }
+    }
+}
+
+RSKCropStatus GetPngSize(const void *data, size_t length, size_t &width, size_t &height)
+{
+    PngDecoder decoder(data, length);
+    if (!decoder.ReadHeader()) {
+        return RSKCropStatusReadFailed;
+    }
+    width = decoder.ImageWidth();
+    height = decoder.ImageHeight();
+    return RSKCropStatusSuccess;
+}
+
+bool IsPngOpaque(const void *data, size_t length)
+{
+    PngDecoder decoder(data, length);
+    return decoder.ReadHeader() && !decoder.HasAlpha();
+}
+
+RSKCropStatus CropPng(const void *data, size_t length, const RSKCropSpec &spec, const RSKExecutor *executor, const RSKBitmap &destination)
+{
+    PngDecoder decoder(data, length);
+    if (!decoder.ReadHeader()) {
+        return RSKCropStatusReadFailed;
+    }
+    const size_t width = decoder.ImageWidth();
+    const size_t height = decoder.ImageHeight();
+    CropFootprint footprint;
+    if (!IsValidDestination(width, height, spec, destination) || !GetCropFootprint(width, height, spec, footprint)) {
+        return RSKCropStatusInvalidArgument;
+    }
+    const bool isOpaque = !decoder.HasAlpha();
+    if (!decoder.Start(destination.pixelFormat)) {
+        return RSKCropStatusReadFailed;
+    }
+
+    // Step 1: decode the rows down to the last row of the footprint of the crop. A row is decoded as a whole, so only
+    // the footprint is kept of it, unless the image is interlaced and the whole rows are needed for every pass.
+    PixelBuffer part;
+    size_t partX = 0;
+    if (footprint.width > 0 && footprint.height > 0) {
+        std::vector<uint8_t> row(width * kBytesPerPixel);
+        if (decoder.IsInterlaced()) {
+            part = PixelBuffer(width, footprint.height);
+            if (!decoder.ReadInterlacedRows(footprint.y, part.View(), row.data())) {
+                return RSKCropStatusReadFailed;
+            }
+        } else {
+            part = PixelBuffer(footprint.width, footprint.height);
+            partX = footprint.x;
+            for (size_t y = 0; y < footprint.y + footprint.height; y++) {
+                if (!decoder.ReadRow(row.data())) {
+                    return RSKCropStatusReadFailed;
+                }
+                if (y >= footprint.y) {
+                    std::memcpy(part.View().Row(y - footprint.y), &row[footprint.x * kBytesPerPixel], footprint.width * kBytesPerPixel);
+                }
+            }
+        }
+        // The alpha of an opaque image is filled in as 255, so its colors need no premultiplication.
+        if (!isOpaque) {
+            PremultiplyBitmap(part.View());
+        }
+    }
+
+    // Step 2: crop the decoded part.
+    return CropBitmapPart(part.View(), partX, footprint.y, width, height, spec, executor, MakeBitmapView(destination));
+}
+
+#endif
+
+RSKCropStatus GetEncodedImageSize(const void *data, size_t length, size_t &width, size_t &height)
+{
+    switch (RSKEncodedImageGetFormat(data, length)) {
+#if defined(RSK_HAS_LIBJPEG) && RSK_HAS_LIBJPEG
+        case RSKImageFormatJPEG:
+            return GetJpegSize(data, length, width, height);
+#endif
+#if defined(RSK_HAS_LIBPNG) && RSK_HAS_LIBPNG
+        case RSKImageFormatPNG:
+            return GetPngSize(data, length, width, height);
+#endif
+        default:
+            return RSKCropStatusUnsupportedFormat;
+    }
+}
+
+// Returns whether the encoded image in `data` has no alpha, so that it decodes into opaque pixels.
+bool IsEncodedImageOpaque(const void *data, size_t length)
+{
+    switch (RSKEncodedImageGetFormat(data, length)) {
+#if defined(RSK_HAS_LIBJPEG) && RSK_HAS_LIBJPEG
+        case RSKImageFormatJPEG:
+            return IsJpegOpaque(data, length);
+#endif
+#if defined(RSK_HAS_LIBPNG) && RSK_HAS_LIBPNG
+        case RSKImageFormatPNG:
+            return IsPngOpaque(data, length);
+#endif
+        default:
+            return false;
+    }
+}
+
+RSKCropStatus CropEncodedImage(const void *data, size_t length, const RSKCropSpec &spec, const RSKExecutor *executor, const RSKBitmap &destination)
+{
+    switch (RSKEncodedImageGetFormat(data, length)) {
+#if defined(RSK_HAS_LIBJPEG) && RSK_HAS_LIBJPEG
+        case RSKImageFormatJPEG:
+            return CropJpeg(data, length, spec, executor, destination);
+#endif
+#if defined(RSK_HAS_LIBPNG) && RSK_HAS_LIBPNG
+        case RSKImageFormatPNG:
+            return CropPng(data, length, spec, executor, destination);
+#endif
+        default:
+            (void)spec;
+            (void)executor;
+            (void)destination;
+            return RSKCropStatusUnsupportedFormat;
+    }
+}
+
+} // namespace
+
+RSKImageFormat RSKEncodedImageGetFormat(const void *data, size_t length)
+{
+    if (!data) {
+        return RSKImageFormatUnknown;
+    }
+    if (HasSignature(data, length, kJpegSignature)) {
+        return RSKImageFormatJPEG;
+    }
+    if (HasSignature(data, length, kPngSignature)) {
+        return RSKImageFormatPNG;
+    }
+    return RSKImageFormatUnknown;
+}
+
+RSKCropStatus RSKEncodedImageGetSize(const void *data, size_t length, size_t *width, size_t *height)
+{
+    if (!data || !width || !height) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    try {
+        return GetEncodedImageSize(data, length, *width, *height);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
+
+bool RSKEncodedImageIsOpaque(const void *data, size_t length)
+{
+    if (!data) {
+        return false;
+    }
+
+    try {
+        return IsEncodedImageOpaque(data, length);
+    } catch (const std::bad_alloc &) {
+        return false;
+    }
+}
+
+RSKCropStatus RSKCropEngineCropEncodedImage(const void *data, size_t length, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destination)
+{
+    if (!data || !spec || !IsValidBitmap(destination) || RSKPixelFormatGetBytesPerPixel(destination->pixelFormat) != kBytesPerPixel) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    try {
+        return CropEncodedImage(data, length, *spec, executor, *destination);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+}
+
+RSKCropStatus RSKCropEngineCropEncodedFile(const char *path, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destination)
+{
+    if (!path || !spec || !IsValidBitmap(destination) || RSKPixelFormatGetBytesPerPixel(destination->pixelFormat) != kBytesPerPixel) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    MappedFile file(path);
+    if (!file.Data()) {
+        return RSKCropStatusReadFailed;
+    }
+    return RSKCropEngineCropEncodedImage(file.Data(), file.Length(), spec, executor, destination);
+}
+
+RSKCropStatus RSKCropEngineCropEncodedImageToJPEG(const void *data, size_t length, const RSKCropSpec *spec, const RSKJPEGCropOptions *options, RSKEncodedData *result)
+{
+    const RSKJPEGCropOptions defaultOptions = {};
+    if (!options) {
+        options = &defaultOptions;
+    }
+    if (!data || !spec || !result || options->quality < 0 || options->quality > 100) {
+        return RSKCropStatusInvalidArgument;
+    }
+    *result = {};
+    if (RSKEncodedImageGetFormat(data, length) != RSKImageFormatJPEG) {
+        return RSKCropStatusUnsupportedFormat;
+    }
+
+#if defined(RSK_HAS_LIBJPEG) && RSK_HAS_LIBJPEG
+    try {
+        return CropJpegToJpeg(data, length, *spec, *options, *result);
+    } catch (const std::bad_alloc &) {
+        return RSKCropStatusOutOfMemory;
+    }
+#else
+    return RSKCropStatusUnsupportedFormat;
+#endif
+}
+
+void RSKEncodedDataFree(RSKEncodedData *data)
+{
+    if (data) {
+        std::free(data->data);
+        *data = {};
+    }
+}
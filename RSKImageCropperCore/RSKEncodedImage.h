@@ -0,0 +1,117 @@
+//
+// RSKEncodedImage.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKEncodedImage_h
+#define RSKEncodedImage_h
+
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKCropEngine.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Formats of encoded images.
+typedef enum RSKImageFormat {
+    RSKImageFormatUnknown,
+    RSKImageFormatJPEG,
+    RSKImageFormatPNG
+} RSKImageFormat;
+
+// Returns the format of the encoded image in `data`, judged by its signature.
+RSKImageFormat RSKEncodedImageGetFormat(const void *data, size_t length);
+
+// Reads the size, in pixels, of the encoded image in `data` from its header.
+//
+// Returns `RSKCropStatusUnsupportedFormat` if the format is unknown or the library is built without its decoder, and
+// `RSKCropStatusReadFailed` if the header cannot be read.
+RSKCropStatus RSKEncodedImageGetSize(const void *data, size_t length, size_t *width, size_t *height);
+
+// Returns whether the encoded image in `data` is opaque, judged by its header: a JPEG always is, and a PNG is if it has
+// neither an alpha channel nor a transparent color. Its crop is opaque if `RSKCropEngineIsOutputOpaque` says so, and
+// decoding it skips the premultiplication of the colors by the alpha. Returns false if the format is unknown, the
+// library is built without its decoder or the header cannot be read.
+bool RSKEncodedImageIsOpaque(const void *data, size_t length);
+
+// Crops the encoded image in `data` according to `spec` and writes the result into `destination`, decoding only the
+// part of the image that the crop reads.
+//
+// The pixels of the image are the source of the crop, so the destination must have the size returned by
+// `RSKCropEngineGetOutputSize` for the size of the image. Its pixel format selects the order of the decoded colors and
+// must have 8-bit components, like the decoded pixels. The orientation of the image is taken from `spec`; metadata of
+// the data, such as EXIF, is ignored.
+//
+// A JPEG is decoded only inside of the columns and the rows of blocks that the crop reads, and when the crop reduces
+// it by 2 or more, it is decoded at 1/2, 1/4 or 1/8 of its size straight from its coefficients. The rows of a PNG are
+// decoded in order up to the last row that the crop reads, but only the part that it reads is kept. `executor` may be
+// null.
+RSKCropStatus RSKCropEngineCropEncodedImage(const void *data, size_t length, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destination);
+
+// Like `RSKCropEngineCropEncodedImage`, but maps the file at `path` into memory rather than reading it, so only the
+// pages of the file that the decoder touches are loaded. Returns `RSKCropStatusReadFailed` if the file cannot be mapped.
+RSKCropStatus RSKCropEngineCropEncodedFile(const char *path, const RSKCropSpec *spec, const RSKExecutor *executor, RSKBitmap *destination);
+
+// Options of `RSKCropEngineCropEncodedImageToJPEG`. Zero values select the defaults.
+typedef struct RSKJPEGCropOptions {
+    // The quality, from 1 to 100, of the JPEG that is encoded when the crop cannot be made without decoding the image.
+    // Defaults to 90.
+    int quality;
+    // Lets a crop whose edges are not on the edges of the blocks of the JPEG grow out to them, by up to one block on
+    // every side, so that it can be made without decoding the image.
+    bool snapsToBlocks;
+    // Runs the crop when it decodes the image. May be null.
+    const RSKExecutor *executor;
+} RSKJPEGCropOptions;
+
+// Encoded data that the library allocates. Free it with `RSKEncodedDataFree`.
+typedef struct RSKEncodedData {
+    void *data;
+    size_t length;
+    // Whether the data was made from the coefficients of the source without decoding it, so no quality was lost.
+    bool isLossless;
+} RSKEncodedData;
+
+// Crops the JPEG in `data` according to `spec` and encodes the result as a JPEG into `result`.
+//
+// When the crop only moves whole pixels, that is, it neither scales nor masks the image, it is rotated by a multiple
+// of 90 degrees and its rect lies inside of the image, and its edges fall on the edges of the blocks of the JPEG, the
+// blocks of coefficients are cropped, rotated and flipped as they are and no quality is lost. The right and bottom
+// edges only need to be on the edges of the blocks if the crop flips them. Otherwise the image is decoded, cropped
+// like `RSKCropEngineCropEncodedImage` does, and encoded again with `options->quality`; transparent pixels of the
+// result become black. Metadata of the data, such as EXIF, is not copied. `options` may be null.
+//
+// Returns `RSKCropStatusUnsupportedFormat` if `data` is not a JPEG or the library is built without libjpeg.
+RSKCropStatus RSKCropEngineCropEncodedImageToJPEG(const void *data, size_t length, const RSKCropSpec *spec, const RSKJPEGCropOptions *options, RSKEncodedData *result);
+
+// Frees the memory of `data` and clears it.
+void RSKEncodedDataFree(RSKEncodedData *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKEncodedImage_h */
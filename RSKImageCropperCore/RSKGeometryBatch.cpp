@@ -0,0 +1,157 @@
+//
+// RSKGeometryBatch.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKGeometryBatch.h"
+#include "RSKGeometryBatch.hpp"
+
+namespace rsk {
+
+namespace {
+
+const GeometryKernels kScalarKernels = {
+    scalar::TransformPoints<double>,
+    scalar::TransformRects<double>,
+    scalar::NormalizeRects<double>,
+    scalar::IntersectSegments<double>,
+};
+
+#if RSK_X86_KERNELS
+const GeometryKernels kAVX2Kernels = {
+    avx2::TransformPoints,
+    avx2::TransformRects,
+    avx2::NormalizeRects,
+    avx2::IntersectSegments,
+};
+#endif
+
+#if RSK_NEON_KERNELS
+const GeometryKernels kNEONKernels = {
+    neon::TransformPoints,
+    neon::TransformRects,
+    neon::NormalizeRects,
+    neon::IntersectSegments,
+};
+#endif
+
+} // namespace
+
+const GeometryKernels &GetGeometryKernels(SimdInstructionSet instructionSet)
+{
+    switch (instructionSet) {
+#if RSK_X86_KERNELS
+        case SimdInstructionSet::AVX2:
+            return kAVX2Kernels;
+#endif
+#if RSK_NEON_KERNELS
+        case SimdInstructionSet::NEON:
+            return kNEONKernels;
+#endif
+        default:
+            return kScalarKernels;
+    }
+}
+
+} // namespace rsk
+
+namespace {
+
+using namespace rsk;
+
+AffineTransform<CGFloat> MakeTransform(CGAffineTransform transform)
+{
+    return { transform.a, transform.b, transform.c, transform.d, transform.tx, transform.ty };
+}
+
+PointArray<CGFloat> MakePointArray(RSKPointArray points)
+{
+    return { points.x, points.y };
+}
+
+RectArray<CGFloat> MakeRectArray(RSKRectArray rects)
+{
+    return { rects.x, rects.y, rects.width, rects.height };
+}
+
+LineSegmentArray<CGFloat> MakeLineSegmentArray(RSKLineSegmentArray segments)
+{
+    return { MakePointArray(segments.start), MakePointArray(segments.end) };
+}
+
+// The SIMD kernels are written for double precision, so a single precision `CGFloat` always uses the scalar ones.
+#if CGFLOAT_IS_DOUBLE
+const GeometryKernels &Kernels()
+{
+    static const GeometryKernels &kernels = GetGeometryKernels(BestSimdInstructionSet());
+    return kernels;
+}
+#endif
+
+} // namespace
+
+void RSKPointArrayApplyAffineTransform(RSKPointArray points, size_t count, CGAffineTransform transform, RSKPointArray transformedPoints)
+{
+#if CGFLOAT_IS_DOUBLE
+    Kernels().transformPoints(MakePointArray(points), count, MakeTransform(transform), MakePointArray(transformedPoints));
+#else
+    scalar::TransformPoints(MakePointArray(points), count, MakeTransform(transform), MakePointArray(transformedPoints));
+#endif
+}
+
+void RSKPointArrayRotateAroundPoint(RSKPointArray points, size_t count, CGPoint pivot, CGFloat angle, RSKPointArray rotatedPoints)
+{
+    // Translating to the pivot, rotating and translating back is one transform.
+    const CGFloat sine = std::sin(angle);
+    const CGFloat cosine = std::cos(angle);
+    const CGAffineTransform transform = CGAffineTransformMake(cosine, sine, -sine, cosine,
+                                                              pivot.x - cosine * pivot.x + sine * pivot.y,
+                                                              pivot.y - sine * pivot.x - cosine * pivot.y);
+    RSKPointArrayApplyAffineTransform(points, count, transform, rotatedPoints);
+}
+
+void RSKRectArrayApplyAffineTransform(RSKRectArray rects, size_t count, CGAffineTransform transform, RSKRectArray transformedRects)
+{
+#if CGFLOAT_IS_DOUBLE
+    Kernels().transformRects(MakeRectArray(rects), count, MakeTransform(transform), MakeRectArray(transformedRects));
+#else
+    scalar::TransformRects(MakeRectArray(rects), count, MakeTransform(transform), MakeRectArray(transformedRects));
+#endif
+}
+
+void RSKRectArrayNormalize(RSKRectArray rects, size_t count, RSKRectArray normalizedRects)
+{
+#if CGFLOAT_IS_DOUBLE
+    Kernels().normalizeRects(MakeRectArray(rects), count, MakeRectArray(normalizedRects));
+#else
+    scalar::NormalizeRects(MakeRectArray(rects), count, MakeRectArray(normalizedRects));
+#endif
+}
+
+void RSKLineSegmentArrayIntersect(RSKLineSegmentArray segments, RSKLineSegmentArray otherSegments, size_t count, RSKPointArray intersections)
+{
+#if CGFLOAT_IS_DOUBLE
+    Kernels().intersectSegments(MakeLineSegmentArray(segments), MakeLineSegmentArray(otherSegments), count, MakePointArray(intersections));
+#else
+    scalar::IntersectSegments(MakeLineSegmentArray(segments), MakeLineSegmentArray(otherSegments), count, MakePointArray(intersections));
+#endif
+}
@@ -0,0 +1,82 @@
+//
+// RSKGeometryBatch.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKGeometryBatch_h
+#define RSKGeometryBatch_h
+
+#include <stddef.h>
+
+#include "RSKCoreGraphics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Points in structure-of-arrays layout: point `i` is `x[i]`, `y[i]`.
+struct RSKPointArray {
+    CGFloat *x;
+    CGFloat *y;
+};
+typedef struct RSKPointArray RSKPointArray;
+
+// Rects in structure-of-arrays layout: rect `i` is `x[i]`, `y[i]`, `width[i]`, `height[i]`.
+struct RSKRectArray {
+    CGFloat *x;
+    CGFloat *y;
+    CGFloat *width;
+    CGFloat *height;
+};
+typedef struct RSKRectArray RSKRectArray;
+
+// Line segments in structure-of-arrays layout.
+struct RSKLineSegmentArray {
+    RSKPointArray start;
+    RSKPointArray end;
+};
+typedef struct RSKLineSegmentArray RSKLineSegmentArray;
+
+// The functions below read `count` elements of their input arrays and write `count` results, using SIMD instructions
+// where the CPU has them. The results may be written over the input.
+
+// Applies `transform` to every point, like `CGPointApplyAffineTransform`.
+void RSKPointArrayApplyAffineTransform(RSKPointArray points, size_t count, CGAffineTransform transform, RSKPointArray transformedPoints);
+
+// Rotates every point around `pivot` by `angle`, like `RSKPointRotateAroundPoint`.
+void RSKPointArrayRotateAroundPoint(RSKPointArray points, size_t count, CGPoint pivot, CGFloat angle, RSKPointArray rotatedPoints);
+
+// Replaces every rect by the bounding box of the rect transformed by `transform`, like `CGRectApplyAffineTransform`.
+void RSKRectArrayApplyAffineTransform(RSKRectArray rects, size_t count, CGAffineTransform transform, RSKRectArray transformedRects);
+
+// Rounds the origin and the size of every rect to integers, like `RSKRectNormalize`.
+void RSKRectArrayNormalize(RSKRectArray rects, size_t count, RSKRectArray normalizedRects);
+
+// Intersects segment `i` of `segments` with segment `i` of `otherSegments`, like `RSKLineSegmentIntersection`. The
+// intersection of segments that do not intersect is `RSKPointNull`, which is infinite.
+void RSKLineSegmentArrayIntersect(RSKLineSegmentArray segments, RSKLineSegmentArray otherSegments, size_t count, RSKPointArray intersections);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKGeometryBatch_h */
@@ -0,0 +1,228 @@
+//
+// RSKGeometryBatch.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKGeometryBatch_hpp
+#define RSKGeometryBatch_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "RSKSimd.hpp"
+
+namespace rsk {
+
+template <typename T>
+struct AffineTransform {
+    T a, b, c, d, tx, ty;
+};
+
+template <typename T>
+struct PointArray {
+    T *x;
+    T *y;
+};
+
+template <typename T>
+struct RectArray {
+    T *x;
+    T *y;
+    T *width;
+    T *height;
+};
+
+template <typename T>
+struct LineSegmentArray {
+    PointArray<T> start;
+    PointArray<T> end;
+};
+
+// Returns the arrays that start `offset` elements later.
+template <typename T>
+PointArray<T> Offset(PointArray<T> points, size_t offset)
+{
+    return { points.x + offset, points.y + offset };
+}
+
+template <typename T>
+RectArray<T> Offset(RectArray<T> rects, size_t offset)
+{
+    return { rects.x + offset, rects.y + offset, rects.width + offset, rects.height + offset };
+}
+
+template <typename T>
+LineSegmentArray<T> Offset(LineSegmentArray<T> segments, size_t offset)
+{
+    return { Offset(segments.start, offset), Offset(segments.end, offset) };
+}
+
+// Values closer than this to the next integer, relative to their magnitude, are rounded up by `NormalizeRects`. It
+// allows for a few units in the last place of accumulated error, like `RSKRectNormalize`.
+template <typename T>
+constexpr T NormalizationTolerance()
+{
+    return (std::numeric_limits<T>::digits > 24 ? T(1e9) : T(1)) * std::numeric_limits<T>::epsilon();
+}
+
+template <typename T>
+bool IsNearlyCeil(T value)
+{
+    const T ceilValue = std::ceil(value);
+    const T difference = std::fabs(ceilValue - value);
+    return difference < NormalizationTolerance<T>() * std::fabs(ceilValue + value) || difference < std::numeric_limits<T>::min();
+}
+
+// Kernels that process arrays of double precision geometry with one instruction set.
+struct GeometryKernels {
+    void (*transformPoints)(PointArray<double> points, size_t count, const AffineTransform<double> &transform, PointArray<double> transformedPoints);
+    void (*transformRects)(RectArray<double> rects, size_t count, const AffineTransform<double> &transform, RectArray<double> transformedRects);
+    void (*normalizeRects)(RectArray<double> rects, size_t count, RectArray<double> normalizedRects);
+    void (*intersectSegments)(LineSegmentArray<double> segments, LineSegmentArray<double> otherSegments, size_t count, PointArray<double> intersections);
+};
+
+// Returns the kernels of `instructionSet`, which must be supported. Instruction sets without geometry kernels get the
+// scalar ones.
+const GeometryKernels &GetGeometryKernels(SimdInstructionSet instructionSet);
+
+namespace scalar {
+
+template <typename T>
+void TransformPoints(PointArray<T> points, size_t count, const AffineTransform<T> &transform, PointArray<T> transformedPoints)
+{
+    for (size_t i = 0; i < count; i++) {
+        const T x = points.x[i];
+        const T y = points.y[i];
+        transformedPoints.x[i] = transform.a * x + transform.c * y + transform.tx;
+        transformedPoints.y[i] = transform.b * x + transform.d * y + transform.ty;
+    }
+}
+
+template <typename T>
+void TransformRects(RectArray<T> rects, size_t count, const AffineTransform<T> &transform, RectArray<T> transformedRects)
+{
+    for (size_t i = 0; i < count; i++) {
+        T x = rects.x[i];
+        T y = rects.y[i];
+        T width = rects.width[i];
+        T height = rects.height[i];
+        if (std::isinf(x) || std::isinf(y)) {
+            // Null rects stay null.
+            transformedRects.x[i] = x;
+            transformedRects.y[i] = y;
+            transformedRects.width[i] = width;
+            transformedRects.height[i] = height;
+            continue;
+        }
+        const T minX = width < 0 ? x + width : x;
+        const T minY = height < 0 ? y + height : y;
+        const T maxX = minX + std::fabs(width);
+        const T maxY = minY + std::fabs(height);
+        const T x1 = transform.a * minX + transform.c * minY + transform.tx;
+        const T y1 = transform.b * minX + transform.d * minY + transform.ty;
+        const T x2 = transform.a * maxX + transform.c * minY + transform.tx;
+        const T y2 = transform.b * maxX + transform.d * minY + transform.ty;
+        const T x3 = transform.a * minX + transform.c * maxY + transform.tx;
+        const T y3 = transform.b * minX + transform.d * maxY + transform.ty;
+        const T x4 = transform.a * maxX + transform.c * maxY + transform.tx;
+        const T y4 = transform.b * maxX + transform.d * maxY + transform.ty;
+        x = std::fmin(std::fmin(x1, x2), std::fmin(x3, x4));
+        y = std::fmin(std::fmin(y1, y2), std::fmin(y3, y4));
+        transformedRects.x[i] = x;
+        transformedRects.y[i] = y;
+        transformedRects.width[i] = std::fmax(std::fmax(x1, x2), std::fmax(x3, x4)) - x;
+        transformedRects.height[i] = std::fmax(std::fmax(y1, y2), std::fmax(y3, y4)) - y;
+    }
+}
+
+template <typename T>
+void NormalizeRects(RectArray<T> rects, size_t count, RectArray<T> normalizedRects)
+{
+    for (size_t i = 0; i < count; i++) {
+        const T x = rects.x[i];
+        const T y = rects.y[i];
+        const T width = rects.width[i];
+        const T height = rects.height[i];
+        const bool roundsOriginUp = IsNearlyCeil(x) || IsNearlyCeil(y);
+        const bool roundsSizeUp = IsNearlyCeil(width) || IsNearlyCeil(height);
+        normalizedRects.x[i] = roundsOriginUp ? std::ceil(x) : std::floor(x);
+        normalizedRects.y[i] = roundsOriginUp ? std::ceil(y) : std::floor(y);
+        normalizedRects.width[i] = roundsSizeUp ? std::ceil(width) : std::floor(width);
+        normalizedRects.height[i] = roundsSizeUp ? std::ceil(height) : std::floor(height);
+    }
+}
+
+template <typename T>
+void IntersectSegments(LineSegmentArray<T> segments, LineSegmentArray<T> otherSegments, size_t count, PointArray<T> intersections)
+{
+    const T epsilon = std::numeric_limits<T>::epsilon();
+    for (size_t i = 0; i < count; i++) {
+        const T x1 = segments.start.x[i];
+        const T y1 = segments.start.y[i];
+        const T x2 = segments.end.x[i];
+        const T y2 = segments.end.y[i];
+        const T x3 = otherSegments.start.x[i];
+        const T y3 = otherSegments.start.y[i];
+        const T x4 = otherSegments.end.x[i];
+        const T y4 = otherSegments.end.y[i];
+
+        const T numeratorA = (x4 - x3) * (y1 - y3) - (y4 - y3) * (x1 - x3);
+        const T numeratorB = (x2 - x1) * (y1 - y3) - (y2 - y1) * (x1 - x3);
+        const T denominator = (y4 - y3) * (x2 - x1) - (x4 - x3) * (y2 - y1);
+        const T uA = numeratorA / denominator;
+        const T uB = numeratorB / denominator;
+
+        T x = std::numeric_limits<T>::infinity();
+        T y = std::numeric_limits<T>::infinity();
+        if (std::fabs(numeratorA) < epsilon && std::fabs(numeratorB) < epsilon && std::fabs(denominator) < epsilon) {
+            // The segments are coincident.
+            x = (x1 + x2) * T(0.5);
+            y = (y1 + y2) * T(0.5);
+        } else if (!(std::fabs(denominator) < epsilon) && uA >= 0 && uA <= 1 && uB >= 0 && uB <= 1) {
+            x = x1 + uA * (x2 - x1);
+            y = y1 + uA * (y2 - y1);
+        }
+        intersections.x[i] = x;
+        intersections.y[i] = y;
+    }
+}
+
+} // namespace scalar
+
+namespace avx2 {
+void TransformPoints(PointArray<double> points, size_t count, const AffineTransform<double> &transform, PointArray<double> transformedPoints);
+void TransformRects(RectArray<double> rects, size_t count, const AffineTransform<double> &transform, RectArray<double> transformedRects);
+void NormalizeRects(RectArray<double> rects, size_t count, RectArray<double> normalizedRects);
+void IntersectSegments(LineSegmentArray<double> segments, LineSegmentArray<double> otherSegments, size_t count, PointArray<double> intersections);
+} // namespace avx2
+
+namespace neon {
+void TransformPoints(PointArray<double> points, size_t count, const AffineTransform<double> &transform, PointArray<double> transformedPoints);
+void TransformRects(RectArray<double> rects, size_t count, const AffineTransform<double> &transform, RectArray<double> transformedRects);
+void NormalizeRects(RectArray<double> rects, size_t count, RectArray<double> normalizedRects);
+void IntersectSegments(LineSegmentArray<double> segments, LineSegmentArray<double> otherSegments, size_t count, PointArray<double> intersections);
+} // namespace neon
+
+} // namespace rsk
+
+#endif /* RSKGeometryBatch_hpp */
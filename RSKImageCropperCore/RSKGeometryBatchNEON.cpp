@@ -0,0 +1,203 @@
+//
+// RSKGeometryBatchNEON.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKGeometryBatch.hpp"
+
+#if RSK_NEON_KERNELS
+
+#include <cfloat>
+
+#include <arm_neon.h>
+
+namespace rsk {
+
+namespace {
+
+// The kernels process two elements per iteration and do the arithmetic of the scalar kernels in the same order. The
+// elements that are left are processed by the scalar kernels.
+constexpr size_t kLaneCount = 2;
+
+inline float64x2_t Transform(float64x2_t m1, float64x2_t x, float64x2_t m2, float64x2_t y, float64x2_t t)
+{
+    return vaddq_f64(vaddq_f64(vmulq_f64(m1, x), vmulq_f64(m2, y)), t);
+}
+
+inline float64x2_t Min(float64x2_t v1, float64x2_t v2, float64x2_t v3, float64x2_t v4)
+{
+    return vminq_f64(vminq_f64(v1, v2), vminq_f64(v3, v4));
+}
+
+inline float64x2_t Max(float64x2_t v1, float64x2_t v2, float64x2_t v3, float64x2_t v4)
+{
+    return vmaxq_f64(vmaxq_f64(v1, v2), vmaxq_f64(v3, v4));
+}
+
+inline uint64x2_t IsNearlyCeil(float64x2_t value, float64x2_t ceilValue)
+{
+    const float64x2_t difference = vabsq_f64(vsubq_f64(ceilValue, value));
+    const float64x2_t tolerance = vmulq_f64(vdupq_n_f64(NormalizationTolerance<double>()), vabsq_f64(vaddq_f64(ceilValue, value)));
+    return vorrq_u64(vcltq_f64(difference, tolerance), vcltq_f64(difference, vdupq_n_f64(DBL_MIN)));
+}
+
+} // namespace
+
+namespace neon {
+
+void TransformPoints(PointArray<double> points, size_t count, const AffineTransform<double> &transform, PointArray<double> transformedPoints)
+{
+    const float64x2_t a = vdupq_n_f64(transform.a);
+    const float64x2_t b = vdupq_n_f64(transform.b);
+    const float64x2_t c = vdupq_n_f64(transform.c);
+    const float64x2_t d = vdupq_n_f64(transform.d);
+    const float64x2_t tx = vdupq_n_f64(transform.tx);
+    const float64x2_t ty = vdupq_n_f64(transform.ty);
+
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const float64x2_t x = vld1q_f64(points.x + i);
+        const float64x2_t y = vld1q_f64(points.y + i);
+        vst1q_f64(transformedPoints.x + i, Transform(a, x, c, y, tx));
+        vst1q_f64(transformedPoints.y + i, Transform(b, x, d, y, ty));
+    }
+    scalar::TransformPoints(Offset(points, i), count - i, transform, Offset(transformedPoints, i));
+}
+
+void TransformRects(RectArray<double> rects, size_t count, const AffineTransform<double> &transform, RectArray<double> transformedRects)
+{
+    const float64x2_t a = vdupq_n_f64(transform.a);
+    const float64x2_t b = vdupq_n_f64(transform.b);
+    const float64x2_t c = vdupq_n_f64(transform.c);
+    const float64x2_t d = vdupq_n_f64(transform.d);
+    const float64x2_t tx = vdupq_n_f64(transform.tx);
+    const float64x2_t ty = vdupq_n_f64(transform.ty);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t infinity = vdupq_n_f64(INFINITY);
+
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const float64x2_t x = vld1q_f64(rects.x + i);
+        const float64x2_t y = vld1q_f64(rects.y + i);
+        const float64x2_t width = vld1q_f64(rects.width + i);
+        const float64x2_t height = vld1q_f64(rects.height + i);
+        const uint64x2_t isNull = vorrq_u64(vceqq_f64(vabsq_f64(x), infinity), vceqq_f64(vabsq_f64(y), infinity));
+
+        const float64x2_t minX = vbslq_f64(vcltq_f64(width, zero), vaddq_f64(x, width), x);
+        const float64x2_t minY = vbslq_f64(vcltq_f64(height, zero), vaddq_f64(y, height), y);
+        const float64x2_t maxX = vaddq_f64(minX, vabsq_f64(width));
+        const float64x2_t maxY = vaddq_f64(minY, vabsq_f64(height));
+        const float64x2_t x1 = Transform(a, minX, c, minY, tx);
+        const float64x2_t y1 = Transform(b, minX, d, minY, ty);
+        const float64x2_t x2 = Transform(a, maxX, c, minY, tx);
+        const float64x2_t y2 = Transform(b, maxX, d, minY, ty);
+        const float64x2_t x3 = Transform(a, minX, c, maxY, tx);
+        const float64x2_t y3 = Transform(b, minX, d, maxY, ty);
+        const float64x2_t x4 = Transform(a, maxX, c, maxY, tx);
+        const float64x2_t y4 = Transform(b, maxX, d, maxY, ty);
+        const float64x2_t transformedX = Min(x1, x2, x3, x4);
+        const float64x2_t transformedY = Min(y1, y2, y3, y4);
+        const float64x2_t transformedWidth = vsubq_f64(Max(x1, x2, x3, x4), transformedX);
+        const float64x2_t transformedHeight = vsubq_f64(Max(y1, y2, y3, y4), transformedY);
+
+        vst1q_f64(transformedRects.x + i, vbslq_f64(isNull, x, transformedX));
+        vst1q_f64(transformedRects.y + i, vbslq_f64(isNull, y, transformedY));
+        vst1q_f64(transformedRects.width + i, vbslq_f64(isNull, width, transformedWidth));
+        vst1q_f64(transformedRects.height + i, vbslq_f64(isNull, height, transformedHeight));
+    }
+    scalar::TransformRects(Offset(rects, i), count - i, transform, Offset(transformedRects, i));
+}
+
+void NormalizeRects(RectArray<double> rects, size_t count, RectArray<double> normalizedRects)
+{
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const float64x2_t x = vld1q_f64(rects.x + i);
+        const float64x2_t y = vld1q_f64(rects.y + i);
+        const float64x2_t width = vld1q_f64(rects.width + i);
+        const float64x2_t height = vld1q_f64(rects.height + i);
+        const float64x2_t ceilX = vrndpq_f64(x);
+        const float64x2_t ceilY = vrndpq_f64(y);
+        const float64x2_t ceilWidth = vrndpq_f64(width);
+        const float64x2_t ceilHeight = vrndpq_f64(height);
+        const uint64x2_t roundsOriginUp = vorrq_u64(IsNearlyCeil(x, ceilX), IsNearlyCeil(y, ceilY));
+        const uint64x2_t roundsSizeUp = vorrq_u64(IsNearlyCeil(width, ceilWidth), IsNearlyCeil(height, ceilHeight));
+
+        vst1q_f64(normalizedRects.x + i, vbslq_f64(roundsOriginUp, ceilX, vrndmq_f64(x)));
+        vst1q_f64(normalizedRects.y + i, vbslq_f64(roundsOriginUp, ceilY, vrndmq_f64(y)));
+        vst1q_f64(normalizedRects.width + i, vbslq_f64(roundsSizeUp, ceilWidth, vrndmq_f64(width)));
+        vst1q_f64(normalizedRects.height + i, vbslq_f64(roundsSizeUp, ceilHeight, vrndmq_f64(height)));
+    }
+    scalar::NormalizeRects(Offset(rects, i), count - i, Offset(normalizedRects, i));
+}
+
+void IntersectSegments(LineSegmentArray<double> segments, LineSegmentArray<double> otherSegments, size_t count, PointArray<double> intersections)
+{
+    const float64x2_t epsilon = vdupq_n_f64(DBL_EPSILON);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t one = vdupq_n_f64(1.0);
+    const float64x2_t half = vdupq_n_f64(0.5);
+    const float64x2_t infinity = vdupq_n_f64(INFINITY);
+
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const float64x2_t x1 = vld1q_f64(segments.start.x + i);
+        const float64x2_t y1 = vld1q_f64(segments.start.y + i);
+        const float64x2_t x2 = vld1q_f64(segments.end.x + i);
+        const float64x2_t y2 = vld1q_f64(segments.end.y + i);
+        const float64x2_t x3 = vld1q_f64(otherSegments.start.x + i);
+        const float64x2_t y3 = vld1q_f64(otherSegments.start.y + i);
+        const float64x2_t x4 = vld1q_f64(otherSegments.end.x + i);
+        const float64x2_t y4 = vld1q_f64(otherSegments.end.y + i);
+
+        const float64x2_t dx12 = vsubq_f64(x2, x1);
+        const float64x2_t dy12 = vsubq_f64(y2, y1);
+        const float64x2_t dx34 = vsubq_f64(x4, x3);
+        const float64x2_t dy34 = vsubq_f64(y4, y3);
+        const float64x2_t dx31 = vsubq_f64(x1, x3);
+        const float64x2_t dy31 = vsubq_f64(y1, y3);
+        const float64x2_t numeratorA = vsubq_f64(vmulq_f64(dx34, dy31), vmulq_f64(dy34, dx31));
+        const float64x2_t numeratorB = vsubq_f64(vmulq_f64(dx12, dy31), vmulq_f64(dy12, dx31));
+        const float64x2_t denominator = vsubq_f64(vmulq_f64(dy34, dx12), vmulq_f64(dx34, dy12));
+        const float64x2_t uA = vdivq_f64(numeratorA, denominator);
+        const float64x2_t uB = vdivq_f64(numeratorB, denominator);
+
+        const uint64x2_t isParallel = vcltq_f64(vabsq_f64(denominator), epsilon);
+        const uint64x2_t isCoincident = vandq_u64(isParallel, vandq_u64(vcltq_f64(vabsq_f64(numeratorA), epsilon), vcltq_f64(vabsq_f64(numeratorB), epsilon)));
+        uint64x2_t intersects = vbicq_u64(vandq_u64(vcgeq_f64(uA, zero), vcleq_f64(uA, one)), isParallel);
+        intersects = vandq_u64(intersects, vandq_u64(vcgeq_f64(uB, zero), vcleq_f64(uB, one)));
+
+        float64x2_t x = vbslq_f64(intersects, vaddq_f64(x1, vmulq_f64(uA, dx12)), infinity);
+        float64x2_t y = vbslq_f64(intersects, vaddq_f64(y1, vmulq_f64(uA, dy12)), infinity);
+        x = vbslq_f64(isCoincident, vmulq_f64(vaddq_f64(x1, x2), half), x);
+        y = vbslq_f64(isCoincident, vmulq_f64(vaddq_f64(y1, y2), half), y);
+        vst1q_f64(intersections.x + i, x);
+        vst1q_f64(intersections.y + i, y);
+    }
+    scalar::IntersectSegments(Offset(segments, i), Offset(otherSegments, i), count - i, Offset(intersections, i));
+}
+
+} // namespace neon
+
+} // namespace rsk
+
+#endif /* RSK_NEON_KERNELS */
@@ -0,0 +1,220 @@
+//
+// RSKGeometryBatchX86.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKGeometryBatch.hpp"
+
+#if RSK_X86_KERNELS
+
+#include <cfloat>
+
+#include <immintrin.h>
+
+#define RSK_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace rsk {
+
+namespace {
+
+// The kernels process four elements per iteration and do the arithmetic of the scalar kernels in the same order, so
+// the results are identical. The elements that are left are processed by the scalar kernels.
+constexpr size_t kLaneCount = 4;
+
+RSK_TARGET_AVX2 inline __m256d Abs(__m256d value)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), value);
+}
+
+RSK_TARGET_AVX2 inline __m256d Transform(__m256d m1, __m256d x, __m256d m2, __m256d y, __m256d t)
+{
+    return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m1, x), _mm256_mul_pd(m2, y)), t);
+}
+
+RSK_TARGET_AVX2 inline __m256d Min(__m256d v1, __m256d v2, __m256d v3, __m256d v4)
+{
+    return _mm256_min_pd(_mm256_min_pd(v1, v2), _mm256_min_pd(v3, v4));
+}
+
+RSK_TARGET_AVX2 inline __m256d Max(__m256d v1, __m256d v2, __m256d v3, __m256d v4)
+{
+    return _mm256_max_pd(_mm256_max_pd(v1, v2), _mm256_max_pd(v3, v4));
+}
+
+RSK_TARGET_AVX2 inline __m256d IsNearlyCeil(__m256d value, __m256d ceilValue)
+{
+    const __m256d difference = Abs(_mm256_sub_pd(ceilValue, value));
+    const __m256d tolerance = _mm256_mul_pd(_mm256_set1_pd(NormalizationTolerance<double>()), Abs(_mm256_add_pd(ceilValue, value)));
+    return _mm256_or_pd(_mm256_cmp_pd(difference, tolerance, _CMP_LT_OQ), _mm256_cmp_pd(difference, _mm256_set1_pd(DBL_MIN), _CMP_LT_OQ));
+}
+
+RSK_TARGET_AVX2 inline __m256d Ceil(__m256d value)
+{
+    return _mm256_round_pd(value, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+}
+
+RSK_TARGET_AVX2 inline __m256d Floor(__m256d value)
+{
+    return _mm256_round_pd(value, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+}
+
+} // namespace
+
+namespace avx2 {
+
+RSK_TARGET_AVX2 void TransformPoints(PointArray<double> points, size_t count, const AffineTransform<double> &transform, PointArray<double> transformedPoints)
+{
+    const __m256d a = _mm256_set1_pd(transform.a);
+    const __m256d b = _mm256_set1_pd(transform.b);
+    const __m256d c = _mm256_set1_pd(transform.c);
+    const __m256d d = _mm256_set1_pd(transform.d);
+    const __m256d tx = _mm256_set1_pd(transform.tx);
+    const __m256d ty = _mm256_set1_pd(transform.ty);
+
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const __m256d x = _mm256_loadu_pd(points.x + i);
+        const __m256d y = _mm256_loadu_pd(points.y + i);
+        _mm256_storeu_pd(transformedPoints.x + i, Transform(a, x, c, y, tx));
+        _mm256_storeu_pd(transformedPoints.y + i, Transform(b, x, d, y, ty));
+    }
+    scalar::TransformPoints(Offset(points, i), count - i, transform, Offset(transformedPoints, i));
+}
+
+RSK_TARGET_AVX2 void TransformRects(RectArray<double> rects, size_t count, const AffineTransform<double> &transform, RectArray<double> transformedRects)
+{
+    const __m256d a = _mm256_set1_pd(transform.a);
+    const __m256d b = _mm256_set1_pd(transform.b);
+    const __m256d c = _mm256_set1_pd(transform.c);
+    const __m256d d = _mm256_set1_pd(transform.d);
+    const __m256d tx = _mm256_set1_pd(transform.tx);
+    const __m256d ty = _mm256_set1_pd(transform.ty);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d infinity = _mm256_set1_pd(INFINITY);
+
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const __m256d x = _mm256_loadu_pd(rects.x + i);
+        const __m256d y = _mm256_loadu_pd(rects.y + i);
+        const __m256d width = _mm256_loadu_pd(rects.width + i);
+        const __m256d height = _mm256_loadu_pd(rects.height + i);
+        const __m256d isNull = _mm256_or_pd(_mm256_cmp_pd(Abs(x), infinity, _CMP_EQ_OQ), _mm256_cmp_pd(Abs(y), infinity, _CMP_EQ_OQ));
+
+        const __m256d minX = _mm256_blendv_pd(x, _mm256_add_pd(x, width), _mm256_cmp_pd(width, zero, _CMP_LT_OQ));
+        const __m256d minY = _mm256_blendv_pd(y, _mm256_add_pd(y, height), _mm256_cmp_pd(height, zero, _CMP_LT_OQ));
+        const __m256d maxX = _mm256_add_pd(minX, Abs(width));
+        const __m256d maxY = _mm256_add_pd(minY, Abs(height));
+        const __m256d x1 = Transform(a, minX, c, minY, tx);
+        const __m256d y1 = Transform(b, minX, d, minY, ty);
+        const __m256d x2 = Transform(a, maxX, c, minY, tx);
+        const __m256d y2 = Transform(b, maxX, d, minY, ty);
+        const __m256d x3 = Transform(a, minX, c, maxY, tx);
+        const __m256d y3 = Transform(b, minX, d, maxY, ty);
+        const __m256d x4 = Transform(a, maxX, c, maxY, tx);
+        const __m256d y4 = Transform(b, maxX, d, maxY, ty);
+        const __m256d transformedX = Min(x1, x2, x3, x4);
+        const __m256d transformedY = Min(y1, y2, y3, y4);
+        const __m256d transformedWidth = _mm256_sub_pd(Max(x1, x2, x3, x4), transformedX);
+        const __m256d transformedHeight = _mm256_sub_pd(Max(y1, y2, y3, y4), transformedY);
+
+        _mm256_storeu_pd(transformedRects.x + i, _mm256_blendv_pd(transformedX, x, isNull));
+        _mm256_storeu_pd(transformedRects.y + i, _mm256_blendv_pd(transformedY, y, isNull));
+        _mm256_storeu_pd(transformedRects.width + i, _mm256_blendv_pd(transformedWidth, width, isNull));
+        _mm256_storeu_pd(transformedRects.height + i, _mm256_blendv_pd(transformedHeight, height, isNull));
+    }
+    scalar::TransformRects(Offset(rects, i), count - i, transform, Offset(transformedRects, i));
+}
+
+RSK_TARGET_AVX2 void NormalizeRects(RectArray<double> rects, size_t count, RectArray<double> normalizedRects)
+{
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const __m256d x = _mm256_loadu_pd(rects.x + i);
+        const __m256d y = _mm256_loadu_pd(rects.y + i);
+        const __m256d width = _mm256_loadu_pd(rects.width + i);
+        const __m256d height = _mm256_loadu_pd(rects.height + i);
+        const __m256d ceilX = Ceil(x);
+        const __m256d ceilY = Ceil(y);
+        const __m256d ceilWidth = Ceil(width);
+        const __m256d ceilHeight = Ceil(height);
+        const __m256d roundsOriginUp = _mm256_or_pd(IsNearlyCeil(x, ceilX), IsNearlyCeil(y, ceilY));
+        const __m256d roundsSizeUp = _mm256_or_pd(IsNearlyCeil(width, ceilWidth), IsNearlyCeil(height, ceilHeight));
+
+        _mm256_storeu_pd(normalizedRects.x + i, _mm256_blendv_pd(Floor(x), ceilX, roundsOriginUp));
+        _mm256_storeu_pd(normalizedRects.y + i, _mm256_blendv_pd(Floor(y), ceilY, roundsOriginUp));
+        _mm256_storeu_pd(normalizedRects.width + i, _mm256_blendv_pd(Floor(width), ceilWidth, roundsSizeUp));
+        _mm256_storeu_pd(normalizedRects.height + i, _mm256_blendv_pd(Floor(height), ceilHeight, roundsSizeUp));
+    }
+    scalar::NormalizeRects(Offset(rects, i), count - i, Offset(normalizedRects, i));
+}
+
+RSK_TARGET_AVX2 void IntersectSegments(LineSegmentArray<double> segments, LineSegmentArray<double> otherSegments, size_t count, PointArray<double> intersections)
+{
+    const __m256d epsilon = _mm256_set1_pd(DBL_EPSILON);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d infinity = _mm256_set1_pd(INFINITY);
+
+    size_t i = 0;
+    for (; i + kLaneCount <= count; i += kLaneCount) {
+        const __m256d x1 = _mm256_loadu_pd(segments.start.x + i);
+        const __m256d y1 = _mm256_loadu_pd(segments.start.y + i);
+        const __m256d x2 = _mm256_loadu_pd(segments.end.x + i);
+        const __m256d y2 = _mm256_loadu_pd(segments.end.y + i);
+        const __m256d x3 = _mm256_loadu_pd(otherSegments.start.x + i);
+        const __m256d y3 = _mm256_loadu_pd(otherSegments.start.y + i);
+        const __m256d x4 = _mm256_loadu_pd(otherSegments.end.x + i);
+        const __m256d y4 = _mm256_loadu_pd(otherSegments.end.y + i);
+
+        const __m256d dx12 = _mm256_sub_pd(x2, x1);
+        const __m256d dy12 = _mm256_sub_pd(y2, y1);
+        const __m256d dx34 = _mm256_sub_pd(x4, x3);
+        const __m256d dy34 = _mm256_sub_pd(y4, y3);
+        const __m256d dx31 = _mm256_sub_pd(x1, x3);
+        const __m256d dy31 = _mm256_sub_pd(y1, y3);
+        const __m256d numeratorA = _mm256_sub_pd(_mm256_mul_pd(dx34, dy31), _mm256_mul_pd(dy34, dx31));
+        const __m256d numeratorB = _mm256_sub_pd(_mm256_mul_pd(dx12, dy31), _mm256_mul_pd(dy12, dx31));
+        const __m256d denominator = _mm256_sub_pd(_mm256_mul_pd(dy34, dx12), _mm256_mul_pd(dx34, dy12));
+        const __m256d uA = _mm256_div_pd(numeratorA, denominator);
+        const __m256d uB = _mm256_div_pd(numeratorB, denominator);
+
+        const __m256d isParallel = _mm256_cmp_pd(Abs(denominator), epsilon, _CMP_LT_OQ);
+        const __m256d isCoincident = _mm256_and_pd(isParallel, _mm256_and_pd(_mm256_cmp_pd(Abs(numeratorA), epsilon, _CMP_LT_OQ), _mm256_cmp_pd(Abs(numeratorB), epsilon, _CMP_LT_OQ)));
+        __m256d intersects = _mm256_andnot_pd(isParallel, _mm256_and_pd(_mm256_cmp_pd(uA, zero, _CMP_GE_OQ), _mm256_cmp_pd(uA, one, _CMP_LE_OQ)));
+        intersects = _mm256_and_pd(intersects, _mm256_and_pd(_mm256_cmp_pd(uB, zero, _CMP_GE_OQ), _mm256_cmp_pd(uB, one, _CMP_LE_OQ)));
+
+        __m256d x = _mm256_blendv_pd(infinity, _mm256_add_pd(x1, _mm256_mul_pd(uA, dx12)), intersects);
+        __m256d y = _mm256_blendv_pd(infinity, _mm256_add_pd(y1, _mm256_mul_pd(uA, dy12)), intersects);
+        x = _mm256_blendv_pd(x, _mm256_mul_pd(_mm256_add_pd(x1, x2), half), isCoincident);
+        y = _mm256_blendv_pd(y, _mm256_mul_pd(_mm256_add_pd(y1, y2), half), isCoincident);
+        _mm256_storeu_pd(intersections.x + i, x);
+        _mm256_storeu_pd(intersections.y + i, y);
+    }
+    scalar::IntersectSegments(Offset(segments, i), Offset(otherSegments, i), count - i, Offset(intersections, i));
+}
+
+} // namespace avx2
+
+} // namespace rsk
+
+#endif /* RSK_X86_KERNELS */
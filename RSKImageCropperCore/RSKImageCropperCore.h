@@ -0,0 +1,47 @@
+//
+// RSKImageCropperCore.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKImageCropperCore_h
+#define RSKImageCropperCore_h
+
+// `RSKImageCropperCore` is the portable crop engine behind `RSKImageCropper`. It has no dependency on UIKit and
+// builds on every platform with a C++17 compiler.
+
+#include <RSKImageCropperCore/RSKAnimatedCrop.h>
+#include <RSKImageCropperCore/RSKBatchCrop.h>
+#include <RSKImageCropperCore/RSKBitmap.h>
+#include <RSKImageCropperCore/RSKBorrowedBitmap.h>
+#include <RSKImageCropperCore/RSKBufferPool.h>
+#include <RSKImageCropperCore/RSKCoreGraphics.h>
+#include <RSKImageCropperCore/RSKCropEngine.h>
+#include <RSKImageCropperCore/RSKCropGeometry.h>
+#include <RSKImageCropperCore/RSKCropRecipe.h>
+#include <RSKImageCropperCore/RSKEncodedImage.h>
+#include <RSKImageCropperCore/RSKGeometryBatch.h>
+#include <RSKImageCropperCore/RSKImagePyramid.h>
+#include <RSKImageCropperCore/RSKImageTiles.h>
+#include <RSKImageCropperCore/RSKMaskCache.h>
+#include <RSKImageCropperCore/RSKThreadPool.h>
+
+#endif /* RSKImageCropperCore_h */
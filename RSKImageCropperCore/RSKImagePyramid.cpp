@@ -0,0 +1,136 @@
+//
+// RSKImagePyramid.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKImagePyramid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include "RSKImageTransforms.hpp"
+#include "RSKThreadPool.hpp"
+
+namespace {
+
+using namespace rsk;
+
+// The number of rows of a level that are made at once. The rows of the source that they cover are read in order.
+constexpr size_t kRowBandHeight = 16;
+
+// Returns `length` divided by 2 `level` times, rounded up.
+size_t LevelLength(size_t length, size_t level)
+{
+    if (level >= sizeof(size_t) * CHAR_BIT) {
+        return length > 0 ? 1 : 0;
+    }
+    const size_t factor = static_cast<size_t>(1) << level;
+    return length / factor + (length % factor != 0 ? 1 : 0);
+}
+
+} // namespace
+
+size_t RSKImagePyramidGetLevelCount(size_t width, size_t height, size_t smallestLevelSize)
+{
+    if (width == 0 || height == 0) {
+        return 0;
+    }
+
+    size_t levelCount = 1;
+    size_t length = std::max(width, height);
+    while (length > std::max<size_t>(smallestLevelSize, 1)) {
+        length = LevelLength(length, 1);
+        levelCount++;
+    }
+    return levelCount;
+}
+
+CGSize RSKImagePyramidGetLevelSize(size_t width, size_t height, size_t level)
+{
+    return CGSizeMake(LevelLength(width, level), LevelLength(height, level));
+}
+
+size_t RSKImagePyramidSelectLevel(size_t levelCount, CGFloat displayScale)
+{
+    if (levelCount == 0 || !(displayScale > 0) || displayScale >= 1) {
+        return 0;
+    }
+
+    // The level `n` has 2^-n pixels for every pixel of the image, which must not be fewer than `displayScale`. The
+    // tolerance keeps a scale of exactly 2^-n from falling to the level before it.
+    const CGFloat level = std::floor(-std::log2(displayScale) + 1e-6);
+    return level < levelCount - 1 ? static_cast<size_t>(level) : levelCount - 1;
+}
+
+RSKCropStatus RSKImagePyramidMakeLevel(const RSKBitmap *source, size_t level, const RSKExecutor *executor, RSKBitmap *destination)
+{
+    if (!IsValidBitmap(source) || !IsValidBitmap(destination) || source->pixelFormat != destination->pixelFormat) {
+        return RSKCropStatusInvalidArgument;
+    }
+    if (level >= sizeof(size_t) * CHAR_BIT - 1 || destination->width != LevelLength(source->width, level) ||
+        destination->height != LevelLength(source->height, level)) {
+        return RSKCropStatusInvalidArgument;
+    }
+
+    struct LevelContext {
+        BitmapView source;
+        BitmapView destination;
+        size_t factor;
+        std::atomic<bool> failed{ false };
+    } context;
+    context.source = MakeBitmapView(*source);
+    context.destination = MakeBitmapView(*destination);
+    context.factor = static_cast<size_t>(1) << level;
+
+    const size_t bandCount = (destination->height + kRowBandHeight - 1) / kRowBandHeight;
+    ParallelFor(executor, bandCount, &context, [](void *contextPointer, size_t index) {
+        LevelContext &context = *static_cast<LevelContext *>(contextPointer);
+        const size_t y = index * kRowBandHeight;
+        const size_t height = std::min(kRowBandHeight, context.destination.height - y);
+        BitmapView destination = MakeSubview(context.destination, 0, y, context.destination.width, height);
+
+        // The level 0 is a copy of the source.
+        if (context.factor == 1) {
+            for (size_t row = 0; row < height; row++) {
+                std::memcpy(destination.Row(row), context.source.Row(y + row), destination.width * destination.BytesPerPixel());
+            }
+            return;
+        }
+
+        // The blocks on the right and bottom edges average only their pixels inside of the source, so that the edges
+        // of a level stay as opaque as the source.
+        const size_t sourceY = y * context.factor;
+        const size_t sourceHeight = std::min(height * context.factor, context.source.height - sourceY);
+        BitmapView source = MakeSubview(context.source, 0, sourceY, context.source.width, sourceHeight);
+        try {
+            BoxReduceBitmap(source, context.factor, true, destination);
+        } catch (const std::bad_alloc &) {
+            context.failed = true;
+        }
+    });
+
+    return context.failed.load() ? RSKCropStatusOutOfMemory : RSKCropStatusSuccess;
+}
@@ -0,0 +1,63 @@
+//
+// RSKImagePyramid.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKImagePyramid_h
+#define RSKImagePyramid_h
+
+#include <stddef.h>
+
+#include "RSKBitmap.h"
+#include "RSKCoreGraphics.h"
+#include "RSKCropEngine.h"
+#include "RSKThreadPool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A pyramid of an image is made of levels for previews of the image at smaller scales. Level 0 is the image itself,
+// and every next level is half as large as the one before it, rounded up.
+
+// Returns the number of levels of the pyramid of a `width` x `height` image. The last level is the first one whose
+// longer side is at most `smallestLevelSize` pixels. Returns 0 for an empty image.
+size_t RSKImagePyramidGetLevelCount(size_t width, size_t height, size_t smallestLevelSize);
+
+// Returns the size, in pixels, of the level `level` of the pyramid of a `width` x `height` image.
+CGSize RSKImagePyramidGetLevelSize(size_t width, size_t height, size_t level);
+
+// Returns the level of a pyramid of `levelCount` levels that shows the image at `displayScale` pixels of the screen for
+// every pixel of the image. That is the smallest level that still has a pixel for every pixel of the screen.
+size_t RSKImagePyramidSelectLevel(size_t levelCount, CGFloat displayScale);
+
+// Makes the level `level` of the pyramid of `source` in `destination`, which must have the pixel format of the source
+// and the size returned by `RSKImagePyramidGetLevelSize`. Every pixel is the average of the block of pixels of the
+// source that it covers, so a level is made straight from the source, without the levels before it. Bands of rows are
+// made concurrently on `executor`, which may be null.
+RSKCropStatus RSKImagePyramidMakeLevel(const RSKBitmap *source, size_t level, const RSKExecutor *executor, RSKBitmap *destination);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKImagePyramid_h */
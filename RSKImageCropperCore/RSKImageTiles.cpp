@@ -0,0 +1,199 @@
+//
+// RSKImageTiles.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKImageTiles.h"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+#include "RSKImagePyramid.h"
+#include "RSKLruCache.hpp"
+
+namespace {
+
+// The tile size of a grid made with a tile size of 0.
+constexpr size_t kDefaultTileSize = 256;
+
+struct TileKeyHash {
+    size_t operator()(const RSKTileKey &key) const
+    {
+        size_t hash = key.level;
+        hash = hash * 31 + key.column;
+        hash = hash * 1000003 + key.row;
+        return hash;
+    }
+};
+
+struct TileKeyEqual {
+    bool operator()(const RSKTileKey &key1, const RSKTileKey &key2) const
+    {
+        return key1.level == key2.level && key1.column == key2.column && key1.row == key2.row;
+    }
+};
+
+// Returns the length, in pixels of the image, of the side of a tile of `level`.
+CGFloat TileSpan(const RSKTileGrid &grid, size_t level)
+{
+    return std::ldexp(static_cast<CGFloat>(grid.tileSize), static_cast<int>(std::min<size_t>(level, 1024)));
+}
+
+} // namespace
+
+struct RSKTileCache {
+    RSKTileCache(size_t byteBudget, RSKTileReleaseFunction release, void *releaseContext)
+        : tiles(byteBudget), release(release), releaseContext(releaseContext)
+    {
+    }
+
+    // Returns the function that releases the tiles that the cache evicts.
+    auto Evict()
+    {
+        return [this](void *tile) { release(releaseContext, tile); };
+    }
+
+    rsk::LruCache<RSKTileKey, void *, TileKeyHash, TileKeyEqual> tiles;
+    const RSKTileReleaseFunction release;
+    void *const releaseContext;
+};
+
+RSKTileGrid RSKTileGridMake(size_t width, size_t height, size_t tileSize, size_t smallestLevelSize)
+{
+    RSKTileGrid grid;
+    grid.imageWidth = width;
+    grid.imageHeight = height;
+    grid.tileSize = tileSize > 0 ? tileSize : kDefaultTileSize;
+    grid.levelCount = RSKImagePyramidGetLevelCount(width, height, smallestLevelSize);
+    return grid;
+}
+
+CGRect RSKTileGridGetTileRect(const RSKTileGrid *grid, RSKTileKey key)
+{
+    const CGSize levelSize = RSKImagePyramidGetLevelSize(grid->imageWidth, grid->imageHeight, key.level);
+    const CGRect tileRect = CGRectMake(static_cast<CGFloat>(key.column) * grid->tileSize, static_cast<CGFloat>(key.row) * grid->tileSize, grid->tileSize, grid->tileSize);
+    const CGRect rect = CGRectIntersection(tileRect, CGRectMake(0, 0, levelSize.width, levelSize.height));
+    return CGRectIsNull(rect) ? CGRectZero : rect;
+}
+
+CGRect RSKTileGridGetTileImageRect(const RSKTileGrid *grid, RSKTileKey key)
+{
+    const CGFloat span = TileSpan(*grid, key.level);
+    const CGRect tileRect = CGRectMake(key.column * span, key.row * span, span, span);
+    const CGRect rect = CGRectIntersection(tileRect, CGRectMake(0, 0, grid->imageWidth, grid->imageHeight));
+    return CGRectIsNull(rect) ? CGRectZero : rect;
+}
+
+CGRect RSKTileGridGetVisibleImageRect(const RSKTileGrid *grid, const RSKTileViewport *viewport)
+{
+    if (!(viewport->zoomScale > 0) || !(viewport->imageSize.width > 0) || !(viewport->imageSize.height > 0)) {
+        return CGRectZero;
+    }
+
+    // The bounds of the scroll view are scaled by the zoom scale into points of the image view, and then into pixels.
+    const CGFloat scaleX = grid->imageWidth / viewport->imageSize.width / viewport->zoomScale;
+    const CGFloat scaleY = grid->imageHeight / viewport->imageSize.height / viewport->zoomScale;
+    const CGRect rect = CGRectMake(viewport->contentOffset.x * scaleX, viewport->contentOffset.y * scaleY,
+                                   viewport->boundsSize.width * scaleX, viewport->boundsSize.height * scaleY);
+    const CGRect visibleRect = CGRectIntersection(rect, CGRectMake(0, 0, grid->imageWidth, grid->imageHeight));
+    return CGRectIsNull(visibleRect) || CGRectIsEmpty(visibleRect) ? CGRectZero : visibleRect;
+}
+
+size_t RSKTileGridGetVisibleTiles(const RSKTileGrid *grid, const RSKTileViewport *viewport, RSKTileKey *tiles, size_t tileCapacity)
+{
+    const CGRect visibleRect = RSKTileGridGetVisibleImageRect(grid, viewport);
+    if (CGRectIsEmpty(visibleRect) || grid->levelCount == 0) {
+        return 0;
+    }
+
+    // Step 1: pick the level like a pyramid preview would.
+    const CGFloat screenScale = viewport->screenScale > 0 ? viewport->screenScale : 1;
+    const CGFloat displayScale = viewport->zoomScale * screenScale * viewport->imageSize.width / grid->imageWidth;
+    const size_t level = RSKImagePyramidSelectLevel(grid->levelCount, displayScale);
+
+    // Step 2: find the columns and rows of the tiles of the level that the visible rect touches.
+    const CGFloat span = TileSpan(*grid, level);
+    const size_t firstColumn = static_cast<size_t>(std::floor(CGRectGetMinX(visibleRect) / span));
+    const size_t firstRow = static_cast<size_t>(std::floor(CGRectGetMinY(visibleRect) / span));
+    const size_t endColumn = static_cast<size_t>(std::ceil(CGRectGetMaxX(visibleRect) / span));
+    const size_t endRow = static_cast<size_t>(std::ceil(CGRectGetMaxY(visibleRect) / span));
+
+    // Step 3: list them row by row.
+    size_t count = 0;
+    for (size_t row = firstRow; row < endRow; row++) {
+        for (size_t column = firstColumn; column < endColumn; column++, count++) {
+            if (count < tileCapacity) {
+                tiles[count] = { level, column, row };
+            }
+        }
+    }
+    return count;
+}
+
+RSKTileCache *RSKTileCacheCreate(size_t byteBudget, RSKTileReleaseFunction release, void *releaseContext)
+{
+    if (!release) {
+        return nullptr;
+    }
+    return new (std::nothrow) RSKTileCache(byteBudget, release, releaseContext);
+}
+
+void RSKTileCacheDestroy(RSKTileCache *cache)
+{
+    if (cache) {
+        cache->tiles.Clear(cache->Evict());
+        delete cache;
+    }
+}
+
+void *RSKTileCacheGetTile(RSKTileCache *cache, RSKTileKey key)
+{
+    void **tile = cache->tiles.Find(key);
+    return tile ? *tile : nullptr;
+}
+
+bool RSKTileCacheInsertTile(RSKTileCache *cache, RSKTileKey key, void *tile, size_t byteCount)
+{
+    try {
+        cache->tiles.Insert(key, tile, byteCount, cache->Evict());
+        return true;
+    } catch (const std::bad_alloc &) {
+        cache->release(cache->releaseContext, tile);
+        return false;
+    }
+}
+
+void RSKTileCacheTrim(RSKTileCache *cache, size_t byteBudget)
+{
+    cache->tiles.Trim(byteBudget, 0, cache->Evict());
+}
+
+size_t RSKTileCacheGetTileCount(const RSKTileCache *cache)
+{
+    return cache->tiles.Count();
+}
+
+size_t RSKTileCacheGetByteCount(const RSKTileCache *cache)
+{
+    return cache->tiles.ByteCount();
+}
@@ -0,0 +1,118 @@
+//
+// RSKImageTiles.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKImageTiles_h
+#define RSKImageTiles_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "RSKCoreGraphics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A tile of a level of the pyramid of an image, as in `RSKImagePyramid.h`.
+struct RSKTileKey {
+    size_t level;
+    size_t column;
+    size_t row;
+};
+typedef struct RSKTileKey RSKTileKey;
+
+// The square tiles of every level of the pyramid of an image. The tiles of the last column and row of a level are cut
+// off at the edges of the level.
+struct RSKTileGrid {
+    // The size, in pixels, of the image, which is the level 0.
+    size_t imageWidth;
+    size_t imageHeight;
+    // The length, in pixels of its level, of a side of a tile.
+    size_t tileSize;
+    size_t levelCount;
+};
+typedef struct RSKTileGrid RSKTileGrid;
+
+// What a scroll view shows of an image view of `imageSize` points that displays the image.
+struct RSKTileViewport {
+    CGPoint contentOffset;
+    CGSize boundsSize;
+    CGFloat zoomScale;
+    CGSize imageSize;
+    // The number of pixels of the screen in a point.
+    CGFloat screenScale;
+};
+typedef struct RSKTileViewport RSKTileViewport;
+
+// Returns the grid of tiles of `tileSize` pixels of a `width` x `height` image, with the levels of its pyramid down to
+// a level whose longer side is at most `smallestLevelSize` pixels.
+RSKTileGrid RSKTileGridMake(size_t width, size_t height, size_t tileSize, size_t smallestLevelSize);
+
+// Returns the rect of the tile `key` in pixels of its level.
+CGRect RSKTileGridGetTileRect(const RSKTileGrid *grid, RSKTileKey key);
+
+// Returns the rect of the tile `key` in pixels of the image, cut off at the edges of the image.
+CGRect RSKTileGridGetTileImageRect(const RSKTileGrid *grid, RSKTileKey key);
+
+// Returns the part of the image, in pixels, that `viewport` shows.
+CGRect RSKTileGridGetVisibleImageRect(const RSKTileGrid *grid, const RSKTileViewport *viewport);
+
+// Finds the tiles that cover the part of the image that `viewport` shows, from the smallest level that still has a
+// pixel for every pixel of the screen, and writes up to `tileCapacity` of them into `tiles`, row by row. Returns the
+// number of tiles that cover the part, which may be more than `tileCapacity`.
+size_t RSKTileGridGetVisibleTiles(const RSKTileGrid *grid, const RSKTileViewport *viewport, RSKTileKey *tiles, size_t tileCapacity);
+
+// Frees a tile that is evicted from a tile cache.
+typedef void (*RSKTileReleaseFunction)(void *context, void *tile);
+
+// A cache of tiles that costs up to a budget of bytes. When it is over the budget, the tiles that were used least
+// recently are released first. It is not thread-safe.
+typedef struct RSKTileCache RSKTileCache;
+
+// Returns a cache of up to `byteBudget` bytes that frees its tiles with `release`. Returns null if it cannot be made.
+RSKTileCache *RSKTileCacheCreate(size_t byteBudget, RSKTileReleaseFunction release, void *releaseContext);
+
+// Releases every tile of `cache` and frees it.
+void RSKTileCacheDestroy(RSKTileCache *cache);
+
+// Returns the tile `key` and makes it the most recently used one, or null if it is not cached.
+void *RSKTileCacheGetTile(RSKTileCache *cache, RSKTileKey key);
+
+// Caches `tile` under `key` at a cost of `byteCount` bytes, releasing the tile cached under it, and releases the least
+// recently used tiles until the cache fits into its budget. The new tile is kept even if it does not fit alone.
+// Returns false, and releases `tile`, if it cannot be cached.
+bool RSKTileCacheInsertTile(RSKTileCache *cache, RSKTileKey key, void *tile, size_t byteCount);
+
+// Releases the least recently used tiles until the cache costs at most `byteBudget` bytes, like when memory is low.
+void RSKTileCacheTrim(RSKTileCache *cache, size_t byteBudget);
+
+// Returns the number of tiles of `cache` and the bytes that they cost.
+size_t RSKTileCacheGetTileCount(const RSKTileCache *cache);
+size_t RSKTileCacheGetByteCount(const RSKTileCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKImageTiles_h */
@@ -0,0 +1,447 @@
+//
+// RSKImageTransforms.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKImageTransforms.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "RSKOrientKernels.hpp"
+#include "RSKWarpKernels.hpp"
+
+namespace rsk {
+
+namespace {
+
+// The tiles of a destination whose rows walk down the columns of the source. A band of 16 rows reads the 16 pixels of
+// the cache lines of a source column, and a tile of 128 pixels keeps the lines of its rows within the first-level cache.
+constexpr size_t kWarpTileHeight = 16;
+constexpr size_t kWarpTileWidth = 64;
+
+// Clears the pixels of `row`, which has `width` pixels of `bytesPerPixel` bytes, that are outside of `spans`.
+void ClearOutsideOfSpans(uint8_t *row, size_t width, size_t bytesPerPixel, const CoverageSpans &spans)
+{
+    size_t x = 0;
+    for (const CoverageSpan &span : spans) {
+        std::memset(row + x * bytesPerPixel, 0, (span.begin - x) * bytesPerPixel);
+        x = span.end;
+    }
+    std::memset(row + x * bytesPerPixel, 0, (width - x) * bytesPerPixel);
+}
+
+} // namespace
+
+PixelBuffer::PixelBuffer(size_t width, size_t height, ComponentType componentType)
+    : storage_(SharedBufferPool(), width * height * BytesPerPixel(componentType))
+{
+    view_.data = storage_.Data();
+    view_.width = width;
+    view_.height = height;
+    view_.bytesPerRow = width * BytesPerPixel(componentType);
+    view_.componentType = componentType;
+}
+
+bool IsValidBitmap(const RSKBitmap *bitmap)
+{
+    if (!bitmap || !bitmap->data || bitmap->width == 0 || bitmap->height == 0) {
+        return false;
+    }
+    const size_t bytesPerPixel = RSKPixelFormatGetBytesPerPixel(bitmap->pixelFormat);
+    return bytesPerPixel > 0 && bitmap->bytesPerRow >= bitmap->width * bytesPerPixel;
+}
+
+BitmapView MakeBitmapView(const RSKBitmap &bitmap)
+{
+    BitmapView view;
+    view.data = static_cast<uint8_t *>(bitmap.data);
+    view.width = bitmap.width;
+    view.height = bitmap.height;
+    view.bytesPerRow = bitmap.bytesPerRow;
+    view.componentType = GetComponentType(bitmap.pixelFormat);
+    return view;
+}
+
+BitmapView MakeSubview(const BitmapView &view, size_t x, size_t y, size_t width, size_t height)
+{
+    BitmapView subview;
+    subview.data = view.Pixel(x, y);
+    subview.width = width;
+    subview.height = height;
+    subview.bytesPerRow = view.bytesPerRow;
+    subview.componentType = view.componentType;
+    return subview;
+}
+
+void ClearBitmap(const BitmapView &view)
+{
+    for (size_t y = 0; y < view.height; y++) {
+        std::memset(view.Row(y), 0, view.width * view.BytesPerPixel());
+    }
+}
+
+void ConvertBitmap(const BitmapView &source, bool swapsColors, const BitmapView &destination)
+{
+    // Every component is scaled from the range of the source to the one of the destination, through the range 0 to 1.
+    VisitComponentType(source.componentType, [&](auto sourceTraits) {
+        VisitComponentType(destination.componentType, [&](auto destinationTraits) {
+            using SourceTraits = decltype(sourceTraits);
+            using DestinationTraits = decltype(destinationTraits);
+            const float scale = DestinationTraits::kMaximum / SourceTraits::kMaximum;
+
+            for (size_t y = 0; y < destination.height; y++) {
+                const auto *sourcePixel = reinterpret_cast<const typename SourceTraits::Component *>(source.Row(y));
+                auto *pixel = reinterpret_cast<typename DestinationTraits::Component *>(destination.Row(y));
+                for (size_t x = 0; x < destination.width; x++, sourcePixel += 4, pixel += 4) {
+                    const auto alpha = DestinationTraits::Alpha(SourceTraits::Load(sourcePixel[3]) * scale);
+                    for (size_t c = 0; c < 3; c++) {
+                        const size_t sourceComponent = swapsColors ? 2 - c : c;
+                        pixel[c] = DestinationTraits::Color(SourceTraits::Load(sourcePixel[sourceComponent]) * scale, alpha);
+                    }
+                    pixel[3] = alpha;
+                }
+            }
+        });
+    });
+}
+
+bool OrientationSwapsDimensions(RSKImageOrientation orientation)
+{
+    switch (orientation) {
+        case RSKImageOrientationLeft:
+        case RSKImageOrientationRight:
+        case RSKImageOrientationLeftMirrored:
+        case RSKImageOrientationRightMirrored:
+            return true;
+        case RSKImageOrientationUp:
+        case RSKImageOrientationDown:
+        case RSKImageOrientationUpMirrored:
+        case RSKImageOrientationDownMirrored:
+            return false;
+    }
+    return false;
+}
+
+void OrientBitmap(const BitmapView &source, RSKImageOrientation orientation, const BitmapView &destination)
+{
+    OrientPixels(source, orientation, GetOrientKernels(BestSimdInstructionSet(), source.componentType), destination);
+}
+
+CGAffineTransform OrientationTransform(RSKImageOrientation orientation, size_t sourceWidth, size_t sourceHeight)
+{
+    const CGFloat width = sourceWidth;
+    const CGFloat height = sourceHeight;
+
+    switch (orientation) {
+        case RSKImageOrientationUp:
+            return CGAffineTransformIdentity;
+        case RSKImageOrientationDown:
+            return CGAffineTransformMake(-1, 0, 0, -1, width, height);
+        case RSKImageOrientationLeft:
+            return CGAffineTransformMake(0, 1, -1, 0, width, 0);
+        case RSKImageOrientationRight:
+            return CGAffineTransformMake(0, -1, 1, 0, 0, height);
+        case RSKImageOrientationUpMirrored:
+            return CGAffineTransformMake(-1, 0, 0, 1, width, 0);
+        case RSKImageOrientationDownMirrored:
+            return CGAffineTransformMake(1, 0, 0, -1, 0, height);
+        case RSKImageOrientationLeftMirrored:
+            return CGAffineTransformMake(0, 1, 1, 0, 0, 0);
+        case RSKImageOrientationRightMirrored:
+            return CGAffineTransformMake(0, -1, -1, 0, width, height);
+    }
+    return CGAffineTransformIdentity;
+}
+
+CGSize RotatedSize(CGSize size, CGFloat angle)
+{
+    CGFloat cosine = std::fabs(std::cos(angle));
+    CGFloat sine = std::fabs(std::sin(angle));
+    return CGSizeMake(size.width * cosine + size.height * sine,
+                      size.width * sine + size.height * cosine);
+}
+
+void RotateBitmap(const BitmapView &source, CGFloat angle, CGSize rotatedSize, const BitmapView &destination)
+{
+    // Map the destination back into the source by rotating it counterclockwise around the centers.
+    CGAffineTransform transform = CGAffineTransformMakeTranslation(-rotatedSize.width * 0.5, -rotatedSize.height * 0.5);
+    transform = CGAffineTransformConcat(transform, CGAffineTransformMakeRotation(-angle));
+    transform = CGAffineTransformConcat(transform, CGAffineTransformMakeTranslation(source.width * 0.5, source.height * 0.5));
+
+    WarpBitmap(source, transform, RSKResamplingFilterBilinear, nullptr, destination);
+}
+
+void DrawBitmap(const BitmapView &source, ptrdiff_t x, ptrdiff_t y, const uint8_t *coverage, const BitmapView &destination)
+{
+    const ptrdiff_t minX = std::max<ptrdiff_t>(x, 0);
+    const ptrdiff_t minY = std::max<ptrdiff_t>(y, 0);
+    const ptrdiff_t maxX = std::min<ptrdiff_t>(x + static_cast<ptrdiff_t>(source.width), static_cast<ptrdiff_t>(destination.width));
+    const ptrdiff_t maxY = std::min<ptrdiff_t>(y + static_cast<ptrdiff_t>(source.height), static_cast<ptrdiff_t>(destination.height));
+
+    for (ptrdiff_t dy = minY; dy < maxY; dy++) {
+        const uint8_t *sourcePixel = source.Pixel(static_cast<size_t>(minX - x), static_cast<size_t>(dy - y));
+        uint8_t *destinationPixel = destination.Pixel(static_cast<size_t>(minX), static_cast<size_t>(dy));
+        if (!coverage) {
+            std::memcpy(destinationPixel, sourcePixel, static_cast<size_t>(maxX - minX) * source.BytesPerPixel());
+            continue;
+        }
+        const uint8_t *coverageRow = coverage + static_cast<size_t>(dy) * destination.width;
+        VisitComponentType(source.componentType, [&](auto traits) {
+            using Traits = decltype(traits);
+            using Component = typename Traits::Component;
+            const Component *sourceComponents = reinterpret_cast<const Component *>(sourcePixel);
+            Component *destinationComponents = reinterpret_cast<Component *>(destinationPixel);
+            for (ptrdiff_t dx = minX; dx < maxX; dx++, sourceComponents += 4, destinationComponents += 4) {
+                const unsigned alpha = coverageRow[dx];
+                for (size_t c = 0; c < 4; c++) {
+                    destinationComponents[c] = Traits::Cover(sourceComponents[c], alpha);
+                }
+            }
+        });
+    }
+}
+
+void WarpBitmap(const BitmapView &source, CGAffineTransform transform, RSKResamplingFilter filter, CoverageMask *mask, const BitmapView &destination)
+{
+    WarpBitmapSupersampled(source, transform, filter, 1, 1, mask, destination);
+}
+
+namespace {
+
+template <typename Traits>
+void WarpComponentsSupersampled(const BitmapView &source, const WarpTransform &transform, RSKResamplingFilter filter, size_t samplesX, size_t samplesY, CoverageMask *mask, const BitmapView &destination)
+{
+    using Component = typename Traits::Component;
+    const WarpRowKernel kernel = GetWarpRowKernel(filter, BestSimdInstructionSet(), source.componentType);
+
+    // The transform is affine, so the sample point moves by a constant step along every row. The pixel centers of the
+    // source are at half pixels, so they are shifted to whole indices once up front.
+    const double stepX = transform.a;
+    const double stepY = transform.b;
+
+    // A row that walks down the columns of the source, like the ones of an orientation that swaps the axes, reads a
+    // new cache line for every pixel. The next rows read the neighboring columns, which lie in the same cache lines, so
+    // such a destination is sampled in tiles of a band of rows that is narrow enough for their lines to stay cached.
+    const bool walksColumns = std::fabs(stepY) > std::fabs(stepX);
+    const size_t bandHeight = walksColumns ? kWarpTileHeight : 1;
+    const size_t tileWidth = walksColumns ? kWarpTileWidth : destination.width;
+
+    CoverageSpans bandSpans[kWarpTileHeight];
+    ScratchArray<uint8_t> coverage(mask ? destination.width * bandHeight : 0);
+
+    // The samples of a pixel are summed up one row of samples at a time.
+    const size_t sampleCount = samplesX * samplesY;
+    ScratchArray<Component> samples(sampleCount > 1 ? destination.width * 4 : 0);
+    ScratchArray<typename Traits::Sum> sums(samples.Size());
+
+    // Samples `count` pixels of row `y` from pixel `x` on into `pixels`.
+    auto sampleRow = [&](size_t y, size_t x, size_t count, Component *pixels) {
+        if (sampleCount == 1) {
+            const double rowX = transform.c * (y + 0.5) + transform.tx - 0.5 + stepX * 0.5;
+            const double rowY = transform.d * (y + 0.5) + transform.ty - 0.5 + stepY * 0.5;
+            kernel(source, rowX + stepX * x, rowY + stepY * x, stepX, stepY, count, reinterpret_cast<uint8_t *>(pixels));
+            return;
+        }
+
+        std::fill(sums.Data(), sums.Data() + count * 4, 0);
+        for (size_t j = 0; j < samplesY; j++) {
+            const double sampleY = y + (j + 0.5) / samplesY;
+            for (size_t i = 0; i < samplesX; i++) {
+                const double sampleX = x + (i + 0.5) / samplesX;
+                kernel(source, transform.a * sampleX + transform.c * sampleY + transform.tx - 0.5,
+                       transform.b * sampleX + transform.d * sampleY + transform.ty - 0.5, stepX, stepY, count,
+                       reinterpret_cast<uint8_t *>(samples.Data()));
+                for (size_t k = 0; k < count * 4; k++) {
+                    sums[k] += Traits::Widen(samples[k]);
+                }
+            }
+        }
+        for (size_t k = 0; k < count * 4; k++) {
+            pixels[k] = Traits::Average(sums[k], static_cast<uint32_t>(sampleCount));
+        }
+    };
+
+    const size_t bytesPerPixel = Traits::kBytesPerPixel;
+    for (size_t bandY = 0; bandY < destination.height; bandY += bandHeight) {
+        const size_t bandEndY = std::min(destination.height, bandY + bandHeight);
+
+        // Step 1: find the spans of the rows of the band, and clear the pixels between them. Without a mask every row
+        // is one opaque span.
+        for (size_t y = bandY; y < bandEndY; y++) {
+            CoverageSpans &spans = bandSpans[y - bandY];
+            if (!mask) {
+                spans.assign(1, { 0, destination.width, true });
+                continue;
+            }
+            mask->GetRowSpans(y, spans, coverage.Data() + (y - bandY) * destination.width);
+            ClearOutsideOfSpans(destination.Row(y), destination.width, bytesPerPixel, spans);
+        }
+
+        // Step 2: sample the spans one tile of the band at a time.
+        for (size_t tileX = 0; tileX < destination.width; tileX += tileWidth) {
+            const size_t tileEndX = std::min(destination.width, tileX + tileWidth);
+            for (size_t y = bandY; y < bandEndY; y++) {
+                const uint8_t *rowCoverage = coverage.Data() + (y - bandY) * destination.width;
+                for (const CoverageSpan &span : bandSpans[y - bandY]) {
+                    const size_t begin = std::max(span.begin, tileX);
+                    const size_t end = std::min(span.end, tileEndX);
+                    if (begin >= end) {
+                        continue;
+                    }
+                    Component *pixel = reinterpret_cast<Component *>(destination.Row(y) + begin * bytesPerPixel);
+                    sampleRow(y, begin, end - begin, pixel);
+                    if (!span.isOpaque) {
+                        for (size_t i = begin; i < end; i++, pixel += 4) {
+                            const unsigned alpha = rowCoverage[i];
+                            for (size_t c = 0; c < 4; c++) {
+                                pixel[c] = Traits::Cover(pixel[c], alpha);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename Traits>
+void BoxReduceComponents(const BitmapView &source, size_t factor, bool clampEdges, const BitmapView &destination)
+{
+    using Component = typename Traits::Component;
+    using Sum = typename Traits::Sum;
+
+    // Every row of blocks is summed up row by row first, which reads the source in order, and then block by block.
+    const size_t rowLength = source.width * 4;
+    ScratchArray<Sum> sums(rowLength);
+
+    // Whole blocks of a power of two pixels, like the ones of the levels of a pyramid, are divided by shifting.
+    const uint32_t fullBlockSize = static_cast<uint32_t>(factor * factor);
+    int fullBlockShift = -1;
+    if ((fullBlockSize & (fullBlockSize - 1)) == 0) {
+        for (fullBlockShift = 0; (1u << fullBlockShift) < fullBlockSize; fullBlockShift++) {
+        }
+    }
+
+    for (size_t y = 0; y < destination.height; y++) {
+        std::fill(sums.Data(), sums.Data() + rowLength, 0);
+        const size_t endY = std::min(source.height, (y + 1) * factor);
+        for (size_t sourceY = y * factor; sourceY < endY; sourceY++) {
+            const Component *sourceRow = reinterpret_cast<const Component *>(source.Row(sourceY));
+            for (size_t i = 0; i < rowLength; i++) {
+                sums[i] += Traits::Widen(sourceRow[i]);
+            }
+        }
+
+        Component *pixel = reinterpret_cast<Component *>(destination.Row(y));
+        for (size_t x = 0; x < destination.width; x++, pixel += 4) {
+            const size_t endX = std::min(source.width, (x + 1) * factor);
+            Sum sum[4] = {};
+            for (const Sum *columnSums = &sums[x * factor * 4]; columnSums < &sums[endX * 4]; columnSums += 4) {
+                for (size_t c = 0; c < 4; c++) {
+                    sum[c] += columnSums[c];
+                }
+            }
+
+            const uint32_t blockSize = static_cast<uint32_t>(clampEdges ? (endX - x * factor) * (endY - y * factor) : fullBlockSize);
+            if (blockSize == fullBlockSize && fullBlockShift >= 0) {
+                for (size_t c = 0; c < 4; c++) {
+                    pixel[c] = Traits::AverageShifted(sum[c], fullBlockShift);
+                }
+            } else {
+                for (size_t c = 0; c < 4; c++) {
+                    pixel[c] = Traits::Average(sum[c], blockSize);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void WarpBitmapSupersampled(const BitmapView &source, CGAffineTransform transform, RSKResamplingFilter filter, size_t samplesX, size_t samplesY, CoverageMask *mask, const BitmapView &destination)
+{
+    const WarpTransform warpTransform = { transform.a, transform.b, transform.c, transform.d, transform.tx, transform.ty };
+    WarpBitmapSupersampled(source, warpTransform, filter, samplesX, samplesY, mask, destination);
+}
+
+void WarpBitmapSupersampled(const BitmapView &source, const WarpTransform &transform, RSKResamplingFilter filter, size_t samplesX, size_t samplesY, CoverageMask *mask, const BitmapView &destination)
+{
+    VisitComponentType(source.componentType, [&](auto traits) {
+        WarpComponentsSupersampled<decltype(traits)>(source, transform, filter, samplesX, samplesY, mask, destination);
+    });
+}
+
+void MaskBitmap(CoverageMask &mask, const BitmapView &view)
+{
+    CoverageSpans spans;
+    ScratchArray<uint8_t> coverage(view.width);
+    VisitComponentType(view.componentType, [&](auto traits) {
+        using Traits = decltype(traits);
+        using Component = typename Traits::Component;
+        for (size_t y = 0; y < view.height; y++) {
+            mask.GetRowSpans(y, spans, coverage.Data());
+            ClearOutsideOfSpans(view.Row(y), view.width, Traits::kBytesPerPixel, spans);
+            for (const CoverageSpan &span : spans) {
+                if (span.isOpaque) {
+                    continue;
+                }
+                Component *pixel = reinterpret_cast<Component *>(view.Pixel(span.begin, y));
+                for (size_t x = span.begin; x < span.end; x++, pixel += 4) {
+                    const unsigned alpha = coverage[x];
+                    for (size_t c = 0; c < 4; c++) {
+                        pixel[c] = Traits::Cover(pixel[c], alpha);
+                    }
+                }
+            }
+        }
+    });
+}
+
+void BoxReduceBitmap(const BitmapView &source, size_t factor, bool clampEdges, const BitmapView &destination)
+{
+    VisitComponentType(source.componentType, [&](auto traits) {
+        BoxReduceComponents<decltype(traits)>(source, factor, clampEdges, destination);
+    });
+}
+
+void ExtendBitmap(const BitmapView &source, size_t x, size_t y, const BitmapView &destination)
+{
+    const size_t bytesPerPixel = source.BytesPerPixel();
+    for (size_t destinationY = 0; destinationY < destination.height; destinationY++) {
+        const size_t sourceY = std::min(destinationY - std::min(destinationY, y), source.height - 1);
+        const uint8_t *sourceRow = source.Row(sourceY);
+        uint8_t *row = destination.Row(destinationY);
+
+        for (size_t i = 0; i < x; i++) {
+            std::memcpy(row + i * bytesPerPixel, sourceRow, bytesPerPixel);
+        }
+        std::memcpy(row + x * bytesPerPixel, sourceRow, source.width * bytesPerPixel);
+        const uint8_t *lastPixel = sourceRow + (source.width - 1) * bytesPerPixel;
+        for (size_t i = x + source.width; i < destination.width; i++) {
+            std::memcpy(row + i * bytesPerPixel, lastPixel, bytesPerPixel);
+        }
+    }
+}
+
+} // namespace rsk
@@ -0,0 +1,153 @@
+//
+// RSKImageTransforms.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKImageTransforms_hpp
+#define RSKImageTransforms_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "RSKBitmap.h"
+#include "RSKBufferPool.hpp"
+#include "RSKCropEngine.h"
+#include "RSKMaskRasterizer.hpp"
+#include "RSKPixelComponents.hpp"
+
+namespace rsk {
+
+// Number of bytes in a pixel of 8-bit components, the only kind that the SIMD kernels and the codecs work with.
+constexpr size_t kBytesPerPixel = 4;
+
+// A view of pixels that does not own its memory. The transforms that read one view and write another require both to
+// have the same type of components.
+struct BitmapView {
+    uint8_t *data = nullptr;
+    size_t width = 0;
+    size_t height = 0;
+    size_t bytesPerRow = 0;
+    ComponentType componentType = ComponentType::UInt8;
+
+    size_t BytesPerPixel() const { return rsk::BytesPerPixel(componentType); }
+    uint8_t *Row(size_t y) const { return data + y * bytesPerRow; }
+    uint8_t *Pixel(size_t x, size_t y) const { return Row(y) + x * BytesPerPixel(); }
+};
+
+// A tightly packed pixel buffer of the shared pool. Its pixels are not cleared.
+class PixelBuffer {
+public:
+    PixelBuffer() = default;
+    PixelBuffer(size_t width, size_t height, ComponentType componentType = ComponentType::UInt8);
+
+    const BitmapView &View() const { return view_; }
+
+private:
+    PooledBuffer storage_;
+    BitmapView view_;
+};
+
+// Returns whether `value` is one of the values from `first` to `last`. A C caller may store any integer in an enum, which
+// is outside of the range of values of the enum in C++, so `value` is read as an integer instead of as an enum.
+template <typename Enum>
+bool IsEnumValueInRange(const Enum &value, Enum first, Enum last)
+{
+    using Integer = std::underlying_type_t<Enum>;
+    Integer integer;
+    std::memcpy(&integer, &value, sizeof(integer));
+    return integer >= static_cast<Integer>(first) && integer <= static_cast<Integer>(last);
+}
+
+// Returns whether `bitmap` is not null and has pixels of a known format in rows that fit into its bytes per row.
+bool IsValidBitmap(const RSKBitmap *bitmap);
+
+// Returns the view of the caller-owned `bitmap`.
+BitmapView MakeBitmapView(const RSKBitmap &bitmap);
+
+// Returns the view of the pixels of `view` inside of `x`, `y`, `width` and `height`. The rect must lie inside the view.
+BitmapView MakeSubview(const BitmapView &view, size_t x, size_t y, size_t width, size_t height);
+
+// Clears every pixel of `view`.
+void ClearBitmap(const BitmapView &view);
+
+// Copies `source` into `destination`, which has its size, converting the components to the type of the destination and
+// swapping the first and the third component if `swapsColors` is true.
+void ConvertBitmap(const BitmapView &source, bool swapsColors, const BitmapView &destination);
+
+// Returns true if `orientation` swaps the width and the height of the image.
+bool OrientationSwapsDimensions(RSKImageOrientation orientation);
+
+// Copies `source` to `destination` so that the pixels of `destination` are upright. Like `-[UIImage fixOrientation]`.
+// The destination must have the oriented size of the source.
+void OrientBitmap(const BitmapView &source, RSKImageOrientation orientation, const BitmapView &destination);
+
+// Returns the transform that maps a point of the upright image to the matching point of a source of `sourceWidth` x
+// `sourceHeight` pixels with `orientation`.
+CGAffineTransform OrientationTransform(RSKImageOrientation orientation, size_t sourceWidth, size_t sourceHeight);
+
+// Returns the size of the bounding box of an image of `size` rotated by `angle`.
+CGSize RotatedSize(CGSize size, CGFloat angle);
+
+// Draws `source` rotated clockwise around its center by `angle` into `destination` with bilinear filtering.
+// Like `-[UIImage rotateByAngle:]`, the center of the source lands in the center of `rotatedSize`.
+void RotateBitmap(const BitmapView &source, CGFloat angle, CGSize rotatedSize, const BitmapView &destination);
+
+// Copies `source` into `destination` with its top-left corner at `x` and `y`, multiplying every pixel by the
+// matching value of `coverage` unless it is null. `coverage` has one byte for every pixel of the destination.
+void DrawBitmap(const BitmapView &source, ptrdiff_t x, ptrdiff_t y, const uint8_t *coverage, const BitmapView &destination);
+
+// An affine transform in double precision, which is what the warp kernels sample in. The parts of a crop compose their
+// transforms in it, so that they sample the same points as the whole crop even when `CGFloat` is single precision.
+struct WarpTransform {
+    double a, b, c, d, tx, ty;
+};
+
+// Fills every pixel of `destination` with the sample of `source` at the point that `transform` maps the center of the
+// pixel to. Samples outside of the source are transparent. If `mask` is not null, only the pixels that it covers are
+// sampled and its coverage is applied to them in place; it must have the size of the destination.
+void WarpBitmap(const BitmapView &source, CGAffineTransform transform, RSKResamplingFilter filter, CoverageMask *mask, const BitmapView &destination);
+
+// Like `WarpBitmap`, but fills every pixel with the average of `samplesX` x `samplesY` samples spread evenly over the
+// area of the source that `transform` maps the pixel to, which keeps a reduced source from aliasing.
+void WarpBitmapSupersampled(const BitmapView &source, CGAffineTransform transform, RSKResamplingFilter filter, size_t samplesX, size_t samplesY, CoverageMask *mask, const BitmapView &destination);
+void WarpBitmapSupersampled(const BitmapView &source, const WarpTransform &transform, RSKResamplingFilter filter, size_t samplesX, size_t samplesY, CoverageMask *mask, const BitmapView &destination);
+
+// Applies the coverage of `mask`, which has the size of `view`, to the pixels of `view` in place. The pixels are the same
+// as the ones of `WarpBitmap` with `mask` when the view holds the pixels it samples without one.
+void MaskBitmap(CoverageMask &mask, const BitmapView &view);
+
+// Fills every pixel of `destination` with the average of a block of `factor` x `factor` pixels of `source`. Parts of the
+// blocks on the right and bottom edges that are outside of the source count as transparent, unless `clampEdges` is
+// true, in which case those blocks average only their pixels inside of the source. The destination must be `factor`
+// times smaller than the source, rounded up.
+void BoxReduceBitmap(const BitmapView &source, size_t factor, bool clampEdges, const BitmapView &destination);
+
+// Copies `source` into `destination` with its top-left corner at `x` and `y`, and fills the rest of the destination
+// with the nearest edge pixels of the source, so that samples near the edges do not blend with the transparent outside.
+void ExtendBitmap(const BitmapView &source, size_t x, size_t y, const BitmapView &destination);
+
+} // namespace rsk
+
+#endif /* RSKImageTransforms_hpp */
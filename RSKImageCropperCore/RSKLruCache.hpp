@@ -0,0 +1,132 @@
+//
+// RSKLruCache.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKLruCache_hpp
+#define RSKLruCache_hpp
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace rsk {
+
+// A cache of values that costs up to a budget of bytes. When it is over the budget, the values that were used least
+// recently are evicted first. It is not thread-safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t byteBudget) : byteBudget_(byteBudget) {}
+
+    LruCache(const LruCache &) = delete;
+    LruCache &operator=(const LruCache &) = delete;
+
+    // Returns the number of values and the bytes that they cost.
+    size_t Count() const { return entries_.size(); }
+    size_t ByteCount() const { return byteCount_; }
+    size_t ByteBudget() const { return byteBudget_; }
+
+    // Returns the value of `key` and makes it the most recently used one, or null if it is not cached.
+    Value *Find(const Key &key)
+    {
+        auto found = index_.find(key);
+        if (found == index_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return &found->second->value;
+    }
+
+    // Caches `value` under `key` at a cost of `byteCount` bytes, replacing the value cached under it, and evicts the
+    // least recently used values until the cache fits into its budget. The new value is never evicted, even if it does
+    // not fit alone. `evict` is called with every value that is replaced or evicted.
+    template <typename Evict>
+    void Insert(const Key &key, Value value, size_t byteCount, Evict evict)
+    {
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            byteCount_ -= found->second->byteCount;
+            evict(std::move(found->second->value));
+            entries_.erase(found->second);
+            index_.erase(found);
+        }
+
+        entries_.push_front({ key, std::move(value), byteCount });
+        try {
+            index_.emplace(key, entries_.begin());
+        } catch (...) {
+            entries_.pop_front();
+            throw;
+        }
+        byteCount_ += byteCount;
+        Trim(byteBudget_, 1, evict);
+    }
+
+    // Evicts the least recently used values until the cache costs at most `byteBudget` bytes, keeping at least the
+    // `keptCount` most recently used ones.
+    template <typename Evict>
+    void Trim(size_t byteBudget, size_t keptCount, Evict evict)
+    {
+        while (byteCount_ > byteBudget && entries_.size() > keptCount) {
+            Entry &entry = entries_.back();
+            byteCount_ -= entry.byteCount;
+            index_.erase(entry.key);
+            evict(std::move(entry.value));
+            entries_.pop_back();
+        }
+    }
+
+    // Sets the bytes that the cache costs at most, and evicts the least recently used values above it.
+    template <typename Evict>
+    void SetByteBudget(size_t byteBudget, Evict evict)
+    {
+        byteBudget_ = byteBudget;
+        Trim(byteBudget, 0, evict);
+    }
+
+    // Evicts every value.
+    template <typename Evict>
+    void Clear(Evict evict)
+    {
+        Trim(0, 0, evict);
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t byteCount;
+    };
+
+    // The most recently used entries come first.
+    std::list<Entry> entries_;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash, KeyEqual> index_;
+    size_t byteBudget_;
+    size_t byteCount_ = 0;
+};
+
+} // namespace rsk
+
+#endif /* RSKLruCache_hpp */
@@ -0,0 +1,52 @@
+//
+// RSKMappedFile.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKMappedFile_hpp
+#define RSKMappedFile_hpp
+
+#include <cstddef>
+
+namespace rsk {
+
+// A file that is mapped into memory for reading, so only the pages of the file that are touched are loaded.
+class MappedFile {
+public:
+    // Maps the whole file at `path`. `Data` is null if the file cannot be opened or mapped, or if it is empty.
+    explicit MappedFile(const char *path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const void *Data() const { return data_; }
+    size_t Length() const { return length_; }
+
+private:
+    void *data_ = nullptr;
+    size_t length_ = 0;
+};
+
+} // namespace rsk
+
+#endif /* RSKMappedFile_hpp */
@@ -0,0 +1,194 @@
+//
+// RSKMaskCache.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKMaskCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace rsk {
+
+namespace {
+
+// The bytes of masks that the shared cache keeps unless it is told otherwise.
+constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+
+// Mixes `value` into the FNV-1a hash `hash`.
+template <typename T>
+void HashValue(size_t &hash, T value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only plain values are hashed by their bytes.");
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (unsigned char byte : bytes) {
+        hash = (hash ^ byte) * 1099511628211ULL;
+    }
+}
+
+} // namespace
+
+RasterizedMask::RasterizedMask(CoverageMask &mask)
+    : width_(mask.Width()),
+      height_(mask.Height())
+{
+    rowStarts_.reserve(height_ + 1);
+    CoverageSpans rowSpans;
+    ScratchArray<uint8_t> rowCoverage(width_);
+    for (size_t y = 0; y < height_; y++) {
+        rowStarts_.push_back(spans_.size());
+        mask.GetRowSpans(y, rowSpans, rowCoverage.Data());
+        for (const CoverageSpan &span : rowSpans) {
+            if (span.isOpaque) {
+                spans_.push_back({ span.begin, span.end, kOpaque });
+            } else {
+                spans_.push_back({ span.begin, span.end, coverage_.size() });
+                coverage_.insert(coverage_.end(), rowCoverage.Data() + span.begin, rowCoverage.Data() + span.end);
+            }
+        }
+    }
+    rowStarts_.push_back(spans_.size());
+    rowStarts_.shrink_to_fit();
+    spans_.shrink_to_fit();
+    coverage_.shrink_to_fit();
+}
+
+size_t RasterizedMask::ByteCount() const
+{
+    return sizeof(*this) + rowStarts_.capacity() * sizeof(size_t) + spans_.capacity() * sizeof(Span) + coverage_.capacity();
+}
+
+void RasterizedMask::GetRowSpans(size_t y, size_t x, size_t width, CoverageSpans &spans, uint8_t *coverage) const
+{
+    spans.clear();
+    const size_t endX = x + width;
+    for (size_t index = rowStarts_[y]; index < rowStarts_[y + 1]; index++) {
+        const Span &span = spans_[index];
+        const size_t begin = std::max(span.begin, x);
+        const size_t end = std::min(span.end, endX);
+        if (begin >= end) {
+            continue;
+        }
+        const bool isOpaque = span.coverageOffset == kOpaque;
+        if (!isOpaque) {
+            std::memcpy(coverage + begin - x, &coverage_[span.coverageOffset + begin - span.begin], end - begin);
+        }
+        spans.push_back({ begin - x, end - x, isOpaque });
+    }
+}
+
+MaskKey::MaskKey(const RSKCropSpec &spec, size_t canvasWidth, size_t canvasHeight, size_t outputWidth, size_t outputHeight)
+    : elements(spec.maskPath.elements, spec.maskPath.elements + spec.maskPath.elementCount),
+      usesEvenOddFillRule(spec.maskPath.usesEvenOddFillRule),
+      isEllipse(spec.cropMode == RSKCropModeCircle),
+      zoomScale(spec.zoomScale),
+      canvasWidth(canvasWidth),
+      canvasHeight(canvasHeight),
+      outputWidth(outputWidth),
+      outputHeight(outputHeight),
+      hash(14695981039346656037ULL)
+{
+    // The points that a type does not use are not part of the path, so they are neither hashed nor compared.
+    for (const RSKPathElement &element : elements) {
+        HashValue(hash, element.type);
+        for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+            HashValue(hash, element.points[i].x);
+            HashValue(hash, element.points[i].y);
+        }
+    }
+    HashValue(hash, usesEvenOddFillRule);
+    HashValue(hash, isEllipse);
+    HashValue(hash, zoomScale);
+    HashValue(hash, canvasWidth);
+    HashValue(hash, canvasHeight);
+    HashValue(hash, outputWidth);
+    HashValue(hash, outputHeight);
+}
+
+bool MaskKey::operator==(const MaskKey &other) const
+{
+    if (hash != other.hash || usesEvenOddFillRule != other.usesEvenOddFillRule || isEllipse != other.isEllipse || zoomScale != other.zoomScale ||
+        canvasWidth != other.canvasWidth || canvasHeight != other.canvasHeight || outputWidth != other.outputWidth || outputHeight != other.outputHeight ||
+        elements.size() != other.elements.size()) {
+        return false;
+    }
+    for (size_t index = 0; index < elements.size(); index++) {
+        const RSKPathElement &element = elements[index];
+        const RSKPathElement &otherElement = other.elements[index];
+        if (element.type != otherElement.type) {
+            return false;
+        }
+        for (size_t i = 0; i < PathElementPointCount(element.type); i++) {
+            if (element.points[i].x != otherElement.points[i].x || element.points[i].y != otherElement.points[i].y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void MaskCache::SetByteBudget(size_t byteBudget)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    masks_.SetByteBudget(byteBudget, [this](std::shared_ptr<const RasterizedMask>) { stats_.evictionCount++; });
+}
+
+void MaskCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    masks_.Clear([](std::shared_ptr<const RasterizedMask>) {});
+}
+
+RSKMaskCacheStats MaskCache::Stats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    RSKMaskCacheStats stats = stats_;
+    stats.maskCount = masks_.Count();
+    stats.byteCount = masks_.ByteCount();
+    return stats;
+}
+
+MaskCache &SharedMaskCache()
+{
+    // Never destroyed, so that crops may still run while the process exits.
+    static MaskCache *cache = new MaskCache(kDefaultByteBudget);
+    return *cache;
+}
+
+} // namespace rsk
+
+void RSKMaskCacheSetByteBudget(size_t byteBudget)
+{
+    rsk::SharedMaskCache().SetByteBudget(byteBudget);
+}
+
+void RSKMaskCacheClear(void)
+{
+    rsk::SharedMaskCache().Clear();
+}
+
+RSKMaskCacheStats RSKMaskCacheGetStats(void)
+{
+    return rsk::SharedMaskCache().Stats();
+}
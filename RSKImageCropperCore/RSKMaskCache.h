@@ -0,0 +1,68 @@
+//
+// RSKMaskCache.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKMaskCache_h
+#define RSKMaskCache_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The crop engine keeps the coverage of the masks of recent crops in a shared cache, so that crops with the same mask
+// geometry, like a batch of avatars or the same crop made again, rasterize the mask only once. A mask is identified by
+// its path, its scale, its crop mode, which selects how its edges are anti-aliased, and the size of the result. The
+// coverage of every row is kept as runs of covered pixels, with coverage bytes only for the ones on the edges. When the
+// cache is over its budget of bytes, the masks that were used least recently are evicted first. It is safe to use from
+// any thread.
+
+// Counters of the mask cache.
+typedef struct RSKMaskCacheStats {
+    // The number of masked crops whose mask was found in the cache.
+    size_t hitCount;
+    // The number of masked crops whose mask had to be rasterized.
+    size_t missCount;
+    // The number of masks that were evicted to stay within the budget.
+    size_t evictionCount;
+    // The number of masks that the cache keeps, and the bytes that they cost.
+    size_t maskCount;
+    size_t byteCount;
+} RSKMaskCacheStats;
+
+// Sets the bytes that the masks of the cache cost at most, 4 MB unless it is set, and evicts the masks above it. Zero
+// keeps none, so every crop rasterizes its mask one band of rows at a time as if there was no cache.
+void RSKMaskCacheSetByteBudget(size_t byteBudget);
+
+// Evicts every mask of the cache, which is what an app does on a memory warning. The counters are kept.
+void RSKMaskCacheClear(void);
+
+// Returns the counters of the cache.
+RSKMaskCacheStats RSKMaskCacheGetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKMaskCache_h */
@@ -0,0 +1,167 @@
+//
+// RSKMaskCache.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKMaskCache_hpp
+#define RSKMaskCache_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "RSKBufferPool.hpp"
+#include "RSKCropEngine.h"
+#include "RSKLruCache.hpp"
+#include "RSKMaskCache.h"
+#include "RSKMaskRasterizer.hpp"
+
+namespace rsk {
+
+// The coverage of a whole mask, kept as the spans of every row and the coverage bytes of the spans that are not opaque.
+class RasterizedMask {
+public:
+    // Rasterizes every row of `mask`.
+    explicit RasterizedMask(CoverageMask &mask);
+
+    size_t Width() const { return width_; }
+    size_t Height() const { return height_; }
+
+    // Returns the bytes that the mask costs.
+    size_t ByteCount() const;
+
+    // Writes the spans of the part of row `y` from `x` up to `x + width` into `spans`, relative to `x`, and their
+    // coverage into `coverage`, like `CoverageMask::GetRowSpans` does for a mask of that part.
+    void GetRowSpans(size_t y, size_t x, size_t width, CoverageSpans &spans, uint8_t *coverage) const;
+
+private:
+    struct Span {
+        size_t begin;
+        size_t end;
+        // The offset of the coverage of the span in `coverage_`, or `kOpaque` if every pixel of it is fully covered.
+        size_t coverageOffset;
+    };
+
+    static constexpr size_t kOpaque = SIZE_MAX;
+
+    size_t width_;
+    size_t height_;
+    // The spans of row `y` are the ones from `rowStarts_[y]` up to `rowStarts_[y + 1]`.
+    std::vector<size_t> rowStarts_;
+    std::vector<Span> spans_;
+    std::vector<uint8_t> coverage_;
+};
+
+// The part of a rasterized mask at `x` and `y` of `width` x `height` pixels.
+class RasterizedCoverageMask : public CoverageMask {
+public:
+    RasterizedCoverageMask(std::shared_ptr<const RasterizedMask> mask, size_t x, size_t y, size_t width, size_t height)
+        : CoverageMask(width, height),
+          mask_(std::move(mask)),
+          x_(x),
+          y_(y)
+    {
+    }
+
+    void GetRowSpans(size_t y, CoverageSpans &spans, uint8_t *coverage) override { mask_->GetRowSpans(y_ + y, x_, Width(), spans, coverage); }
+
+private:
+    std::shared_ptr<const RasterizedMask> mask_;
+    size_t x_;
+    size_t y_;
+};
+
+// Everything that the coverage of the mask of a crop depends on.
+struct MaskKey {
+    MaskKey(const RSKCropSpec &spec, size_t canvasWidth, size_t canvasHeight, size_t outputWidth, size_t outputHeight);
+
+    bool operator==(const MaskKey &other) const;
+
+    PooledVector<RSKPathElement> elements;
+    bool usesEvenOddFillRule;
+    // The ellipse of `RSKCropModeCircle` is covered analytically, other paths on a grid of samples.
+    bool isEllipse;
+    CGFloat zoomScale;
+    size_t canvasWidth;
+    size_t canvasHeight;
+    size_t outputWidth;
+    size_t outputHeight;
+    size_t hash;
+};
+
+struct MaskKeyHash {
+    size_t operator()(const MaskKey &key) const { return key.hash; }
+};
+
+// The cache behind `RSKMaskCache.h`.
+class MaskCache {
+public:
+    explicit MaskCache(size_t byteBudget) : masks_(byteBudget) {}
+
+    MaskCache(const MaskCache &) = delete;
+    MaskCache &operator=(const MaskCache &) = delete;
+
+    // Returns the mask of `key`, made by `make` and cached unless it costs more than the budget if it is not cached yet.
+    // Returns null without calling `make` if the budget is zero. `make` runs without the lock, so concurrent crops of
+    // the same mask may both make it.
+    template <typename Make>
+    std::shared_ptr<const RasterizedMask> FindOrMake(const MaskKey &key, Make make)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (masks_.ByteBudget() == 0) {
+                return nullptr;
+            }
+            if (const std::shared_ptr<const RasterizedMask> *mask = masks_.Find(key)) {
+                stats_.hitCount++;
+                return *mask;
+            }
+        }
+
+        std::shared_ptr<const RasterizedMask> mask = make();
+        const size_t byteCount = mask->ByteCount();
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.missCount++;
+        if (byteCount <= masks_.ByteBudget()) {
+            masks_.Insert(key, mask, byteCount, [this](std::shared_ptr<const RasterizedMask>) { stats_.evictionCount++; });
+        }
+        return mask;
+    }
+
+    void SetByteBudget(size_t byteBudget);
+    void Clear();
+    RSKMaskCacheStats Stats();
+
+private:
+    std::mutex mutex_;
+    LruCache<MaskKey, std::shared_ptr<const RasterizedMask>, MaskKeyHash> masks_;
+    RSKMaskCacheStats stats_ = {};
+};
+
+// Returns the cache that the crop engine keeps the masks of crops in.
+MaskCache &SharedMaskCache();
+
+} // namespace rsk
+
+#endif /* RSKMaskCache_hpp */
@@ -0,0 +1,394 @@
+//
+// RSKMaskRasterizer.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKMaskRasterizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "RSKGeometryBatch.h"
+
+namespace rsk {
+
+namespace {
+
+constexpr int kSamplesPerAxis = 4;
+constexpr int kMaximumCurveSegments = 256;
+
+CGFloat Length(CGFloat x, CGFloat y)
+{
+    return std::sqrt(x * x + y * y);
+}
+
+int CurveSegmentCount(CGFloat deviation, CGFloat tolerance)
+{
+    int count = static_cast<int>(std::ceil(std::sqrt(deviation / tolerance)));
+    return std::min(std::max(count, 1), kMaximumCurveSegments);
+}
+
+} // namespace
+
+size_t PathElementPointCount(RSKPathElementType type)
+{
+    switch (type) {
+        case RSKPathElementTypeMoveToPoint:
+        case RSKPathElementTypeAddLineToPoint:
+            return 1;
+        case RSKPathElementTypeAddQuadCurveToPoint:
+            return 2;
+        case RSKPathElementTypeAddCurveToPoint:
+            return 3;
+        case RSKPathElementTypeCloseSubpath:
+            return 0;
+    }
+    return 0;
+}
+
+CGRect PathBoundingBox(const RSKPath &path)
+{
+    CGFloat minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (size_t i = 0; i < path.elementCount; i++) {
+        const RSKPathElement &element = path.elements[i];
+        for (size_t j = 0; j < PathElementPointCount(element.type); j++) {
+            minX = std::min(minX, element.points[j].x);
+            minY = std::min(minY, element.points[j].y);
+            maxX = std::max(maxX, element.points[j].x);
+            maxY = std::max(maxY, element.points[j].y);
+        }
+    }
+    if (minX > maxX) {
+        return CGRectNull;
+    }
+    return CGRectMake(minX, minY, maxX - minX, maxY - minY);
+}
+
+std::vector<Contour> FlattenPath(const RSKPath &path, CGAffineTransform transform, CGFloat tolerance)
+{
+    std::vector<Contour> contours;
+    CGPoint currentPoint = CGPointZero;
+    CGPoint subpathStart = CGPointZero;
+
+    auto lineTo = [&](CGPoint point) {
+        if (contours.empty()) {
+            contours.push_back({ currentPoint });
+        }
+        contours.back().push_back(point);
+        currentPoint = point;
+    };
+
+    // Step 1: transform every control point of the path at once.
+    std::vector<CGFloat> x;
+    std::vector<CGFloat> y;
+    for (size_t i = 0; i < path.elementCount; i++) {
+        const RSKPathElement &element = path.elements[i];
+        for (size_t j = 0; j < PathElementPointCount(element.type); j++) {
+            x.push_back(element.points[j].x);
+            y.push_back(element.points[j].y);
+        }
+    }
+    RSKPointArrayApplyAffineTransform({ x.data(), y.data() }, x.size(), transform, { x.data(), y.data() });
+
+    // Step 2: flatten the transformed elements.
+    size_t pointIndex = 0;
+    for (size_t i = 0; i < path.elementCount; i++) {
+        const RSKPathElement &element = path.elements[i];
+        CGPoint p[3];
+        for (size_t j = 0; j < PathElementPointCount(element.type); j++, pointIndex++) {
+            p[j] = CGPointMake(x[pointIndex], y[pointIndex]);
+        }
+        switch (element.type) {
+            case RSKPathElementTypeMoveToPoint: {
+                contours.push_back({ p[0] });
+                currentPoint = subpathStart = p[0];
+                break;
+            }
+            case RSKPathElementTypeAddLineToPoint: {
+                lineTo(p[0]);
+                break;
+            }
+            case RSKPathElementTypeAddQuadCurveToPoint: {
+                CGPoint p0 = currentPoint;
+                CGFloat deviation = Length(p0.x - 2 * p[0].x + p[1].x, p0.y - 2 * p[0].y + p[1].y) * 0.25;
+                int count = CurveSegmentCount(deviation, tolerance);
+                for (int k = 1; k <= count; k++) {
+                    CGFloat t = static_cast<CGFloat>(k) / count;
+                    CGFloat u = 1 - t;
+                    lineTo(CGPointMake(u * u * p0.x + 2 * u * t * p[0].x + t * t * p[1].x,
+                                       u * u * p0.y + 2 * u * t * p[0].y + t * t * p[1].y));
+                }
+                break;
+            }
+            case RSKPathElementTypeAddCurveToPoint: {
+                CGPoint p0 = currentPoint;
+                CGFloat deviation = std::max(Length(p0.x - 2 * p[0].x + p[1].x, p0.y - 2 * p[0].y + p[1].y),
+                                             Length(p[0].x - 2 * p[1].x + p[2].x, p[0].y - 2 * p[1].y + p[2].y)) * 0.75;
+                int count = CurveSegmentCount(deviation, tolerance);
+                for (int k = 1; k <= count; k++) {
+                    CGFloat t = static_cast<CGFloat>(k) / count;
+                    CGFloat u = 1 - t;
+                    CGFloat a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, d = t * t * t;
+                    lineTo(CGPointMake(a * p0.x + b * p[0].x + c * p[1].x + d * p[2].x,
+                                       a * p0.y + b * p[0].y + c * p[1].y + d * p[2].y));
+                }
+                break;
+            }
+            case RSKPathElementTypeCloseSubpath: {
+                currentPoint = subpathStart;
+                break;
+            }
+        }
+    }
+
+    // Polygons are implicitly closed, so the contours only need to have an area.
+    contours.erase(std::remove_if(contours.begin(), contours.end(), [](const Contour &contour) {
+        return contour.size() < 3;
+    }), contours.end());
+
+    return contours;
+}
+
+EllipseCoverageMask::EllipseCoverageMask(CGRect rect, size_t width, size_t height)
+    : CoverageMask(width, height),
+      centerX_(CGRectGetMidX(rect)),
+      centerY_(CGRectGetMidY(rect)),
+      radiusX_(CGRectGetWidth(rect) * 0.5),
+      radiusY_(CGRectGetHeight(rect) * 0.5)
+{
+}
+
+uint8_t EllipseCoverageMask::Coverage(double dx, double dy) const
+{
+    // The distance to the ellipse is approximated by the first order expansion of `rho - 1`, where
+    // `rho = sqrt((dx / rx)^2 + (dy / ry)^2)`, which is exact for circles. The coverage is the part of the pixel on the
+    // inside of the tangent at that distance.
+    const double u = dx / radiusX_;
+    const double v = dy / radiusY_;
+    const double rho = std::sqrt(u * u + v * v);
+    const double gradientX = u / radiusX_;
+    const double gradientY = v / radiusY_;
+    const double gradientLength = std::sqrt(gradientX * gradientX + gradientY * gradientY);
+    if (gradientLength == 0) {
+        return 255;
+    }
+    const double distance = (rho - 1) * rho / gradientLength;
+    const double coverage = std::min(std::max(0.5 - distance, 0.0), 1.0);
+    return static_cast<uint8_t>(coverage * 255 + 0.5);
+}
+
+void EllipseCoverageMask::GetRowSpans(size_t y, CoverageSpans &spans, uint8_t *coverage)
+{
+    spans.clear();
+    if (!(radiusX_ > 0) || !(radiusY_ > 0)) {
+        return;
+    }
+
+    // Returns the half width of the ellipse with radii grown by `outset` at the center of the row, or a negative value if
+    // the row does not cross it.
+    const double dy = y + 0.5 - centerY_;
+    auto halfWidth = [&](double outset) {
+        const double radiusX = radiusX_ + outset;
+        const double radiusY = radiusY_ + outset;
+        if (radiusX <= 0 || radiusY <= 0 || std::fabs(dy) >= radiusY) {
+            return -1.0;
+        }
+        return radiusX * std::sqrt(1 - (dy * dy) / (radiusY * radiusY));
+    };
+
+    // Pixels more than a pixel outside of the ellipse are not covered, pixels more than one and a half pixels inside
+    // of it are fully covered.
+    const double outerHalfWidth = halfWidth(1.0);
+    if (outerHalfWidth < 0) {
+        return;
+    }
+    const double width = static_cast<double>(Width());
+    const size_t outerBegin = static_cast<size_t>(std::min(std::max(std::floor(centerX_ - outerHalfWidth - 0.5), 0.0), width));
+    const size_t outerEnd = static_cast<size_t>(std::min(std::max(std::ceil(centerX_ + outerHalfWidth + 0.5), 0.0), width));
+    if (outerBegin >= outerEnd) {
+        return;
+    }
+
+    size_t innerBegin = outerEnd;
+    size_t innerEnd = outerEnd;
+    const double innerHalfWidth = halfWidth(-1.5);
+    if (innerHalfWidth >= 0) {
+        innerBegin = static_cast<size_t>(std::min(std::max(std::ceil(centerX_ - innerHalfWidth - 0.5), static_cast<double>(outerBegin)), static_cast<double>(outerEnd)));
+        innerEnd = static_cast<size_t>(std::min(std::max(std::floor(centerX_ + innerHalfWidth - 0.5) + 1, static_cast<double>(innerBegin)), static_cast<double>(outerEnd)));
+    }
+
+    for (size_t x = outerBegin; x < innerBegin; x++) {
+        coverage[x] = Coverage(x + 0.5 - centerX_, dy);
+    }
+    for (size_t x = innerEnd; x < outerEnd; x++) {
+        coverage[x] = Coverage(x + 0.5 - centerX_, dy);
+    }
+
+    if (outerBegin < innerBegin) {
+        spans.push_back({ outerBegin, innerBegin, false });
+    }
+    if (innerBegin < innerEnd) {
+        spans.push_back({ innerBegin, innerEnd, true });
+    }
+    if (innerEnd < outerEnd) {
+        spans.push_back({ innerEnd, outerEnd, false });
+    }
+}
+
+PolygonCoverageMask::PolygonCoverageMask(const std::vector<Contour> &contours, bool usesEvenOddFillRule, size_t width, size_t height)
+    : CoverageMask(width, height), usesEvenOddFillRule_(usesEvenOddFillRule), samples_(width + 1)
+{
+    for (const Contour &contour : contours) {
+        for (size_t i = 0; i < contour.size(); i++) {
+            const CGPoint &a = contour[i];
+            const CGPoint &b = contour[(i + 1) % contour.size()];
+            if (a.y == b.y) {
+                continue;
+            }
+            const CGPoint &top = a.y < b.y ? a : b;
+            const CGPoint &bottom = a.y < b.y ? b : a;
+            edges_.push_back({ top.x, top.y, bottom.y, (bottom.x - top.x) / (bottom.y - top.y), b.y > a.y ? 1 : -1 });
+        }
+    }
+    std::sort(edges_.begin(), edges_.end(), [](const Edge &edge1, const Edge &edge2) {
+        return edge1.topY < edge2.topY;
+    });
+}
+
+void PolygonCoverageMask::UpdateActiveEdges(double sampleY)
+{
+    if (sampleY < lastSampleY_) {
+        nextEdge_ = 0;
+        activeEdges_.clear();
+    }
+    lastSampleY_ = sampleY;
+
+    // An edge crosses the sample row if its top is at or above the row and its bottom is below the row.
+    while (nextEdge_ < edges_.size() && edges_[nextEdge_].topY <= sampleY) {
+        activeEdges_.push_back(&edges_[nextEdge_]);
+        nextEdge_++;
+    }
+    activeEdges_.erase(std::remove_if(activeEdges_.begin(), activeEdges_.end(), [sampleY](const Edge *edge) {
+        return edge->bottomY <= sampleY;
+    }), activeEdges_.end());
+}
+
+void PolygonCoverageMask::GetRowSpans(size_t y, CoverageSpans &spans, uint8_t *coverage)
+{
+    spans.clear();
+
+    // `samples_` accumulates the differences of the number of covered samples between neighboring pixels, so every run
+    // of samples costs two additions however long it is.
+    const ptrdiff_t sampleCount = static_cast<ptrdiff_t>(Width() * kSamplesPerAxis);
+    size_t minX = Width();
+    size_t maxX = 0;
+
+    for (int row = 0; row < kSamplesPerAxis; row++) {
+        const double sampleY = y + (row + 0.5) / kSamplesPerAxis;
+
+        // Step 1: find where the sample row crosses the edges of the polygons.
+        UpdateActiveEdges(sampleY);
+        crossings_.clear();
+        for (const Edge *edge : activeEdges_) {
+            crossings_.push_back({ edge->topX + (sampleY - edge->topY) * edge->slope, edge->winding });
+        }
+        std::sort(crossings_.begin(), crossings_.end());
+
+        // Step 2: count the samples of the row that lie inside of the spans between the crossings.
+        int winding = 0;
+        for (size_t i = 0; i + 1 < crossings_.size(); i++) {
+            winding += crossings_[i].winding;
+            bool inside = usesEvenOddFillRule_ ? ((i + 1) % 2 == 1) : (winding != 0);
+            if (!inside) {
+                continue;
+            }
+            double first = std::ceil(crossings_[i].x * kSamplesPerAxis - 0.5);
+            double last = std::ceil(crossings_[i + 1].x * kSamplesPerAxis - 0.5);
+            ptrdiff_t begin = static_cast<ptrdiff_t>(std::min(std::max(first, 0.0), static_cast<double>(sampleCount)));
+            ptrdiff_t end = static_cast<ptrdiff_t>(std::min(std::max(last, 0.0), static_cast<double>(sampleCount)));
+            if (begin >= end) {
+                continue;
+            }
+
+            // Samples of the pixels at both ends are added one by one, the whole pixels in between as a run.
+            size_t firstPixel = static_cast<size_t>(begin / kSamplesPerAxis);
+            size_t lastPixel = static_cast<size_t>((end - 1) / kSamplesPerAxis);
+            if (firstPixel == lastPixel) {
+                samples_[firstPixel] += static_cast<int>(end - begin);
+                samples_[firstPixel + 1] -= static_cast<int>(end - begin);
+            } else {
+                int firstSamples = static_cast<int>((firstPixel + 1) * kSamplesPerAxis - begin);
+                int lastSamples = static_cast<int>(end - lastPixel * kSamplesPerAxis);
+                samples_[firstPixel] += firstSamples;
+                samples_[firstPixel + 1] += kSamplesPerAxis - firstSamples;
+                samples_[lastPixel] += lastSamples - kSamplesPerAxis;
+                samples_[lastPixel + 1] -= lastSamples;
+            }
+            minX = std::min(minX, firstPixel);
+            maxX = std::max(maxX, lastPixel + 1);
+        }
+    }
+
+    // Step 3: turn the samples of the pixels into spans.
+    constexpr int kFullCoverage = kSamplesPerAxis * kSamplesPerAxis;
+    int samples = 0;
+    for (size_t x = minX; x < maxX; x++) {
+        samples += samples_[x];
+        samples_[x] = 0;
+        if (samples == 0) {
+            continue;
+        }
+        const bool isOpaque = samples == kFullCoverage;
+        if (!isOpaque) {
+            coverage[x] = static_cast<uint8_t>((samples * 255 + 8) / kFullCoverage);
+        }
+        if (!spans.empty() && spans.back().end == x && spans.back().isOpaque == isOpaque) {
+            spans.back().end = x + 1;
+        } else {
+            spans.push_back({ x, x + 1, isOpaque });
+        }
+    }
+    if (minX < maxX) {
+        samples_[maxX] = 0;
+    }
+}
+
+void RasterizeContours(const std::vector<Contour> &contours, bool usesEvenOddFillRule, size_t width, size_t height, uint8_t *coverage)
+{
+    std::memset(coverage, 0, width * height);
+
+    PolygonCoverageMask mask(contours, usesEvenOddFillRule, width, height);
+    CoverageSpans spans;
+    for (size_t y = 0; y < height; y++) {
+        uint8_t *coverageRow = coverage + y * width;
+        mask.GetRowSpans(y, spans, coverageRow);
+        for (const CoverageSpan &span : spans) {
+            if (span.isOpaque) {
+                std::memset(coverageRow + span.begin, 255, span.end - span.begin);
+            }
+        }
+    }
+}
+
+} // namespace rsk
@@ -0,0 +1,139 @@
+//
+// RSKMaskRasterizer.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKMaskRasterizer_hpp
+#define RSKMaskRasterizer_hpp
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RSKBufferPool.hpp"
+#include "RSKCropEngine.h"
+
+namespace rsk {
+
+// A closed polygon.
+using Contour = std::vector<CGPoint>;
+
+// Returns the number of points that an element of `type` uses.
+size_t PathElementPointCount(RSKPathElementType type);
+
+// Returns the bounding box of `path`, control points included. Like `CGPathGetBoundingBox`.
+CGRect PathBoundingBox(const RSKPath &path);
+
+// Returns the closed polygons that approximate `path` transformed by `transform`, with curves subdivided until they
+// deviate from the chord by less than `tolerance`.
+std::vector<Contour> FlattenPath(const RSKPath &path, CGAffineTransform transform, CGFloat tolerance);
+
+// A run of pixels of one row of a mask, from `begin` up to but not including `end`, that are at least partly covered.
+struct CoverageSpan {
+    size_t begin;
+    size_t end;
+    // Whether every pixel of the span is fully covered, so its coverage does not need to be applied.
+    bool isOpaque;
+};
+
+// The spans of a row, in a buffer of the shared pool since they are collected for every crop.
+using CoverageSpans = PooledVector<CoverageSpan>;
+
+// A mask of `width` x `height` pixels that produces its anti-aliased coverage one row at a time.
+class CoverageMask {
+public:
+    CoverageMask(size_t width, size_t height) : width_(width), height_(height) {}
+    virtual ~CoverageMask() = default;
+
+    size_t Width() const { return width_; }
+    size_t Height() const { return height_; }
+
+    // Writes the spans of row `y` into `spans`, sorted and not overlapping, and the coverage of the pixels of the spans
+    // that are not opaque into `coverage`, which has one byte for every pixel of the row. Pixels outside of the spans
+    // are not covered.
+    virtual void GetRowSpans(size_t y, CoverageSpans &spans, uint8_t *coverage) = 0;
+
+private:
+    size_t width_;
+    size_t height_;
+};
+
+// The mask of the ellipse inscribed in `rect`, with the coverage of every pixel computed from the distance of its
+// center to the ellipse.
+class EllipseCoverageMask : public CoverageMask {
+public:
+    EllipseCoverageMask(CGRect rect, size_t width, size_t height);
+
+    void GetRowSpans(size_t y, CoverageSpans &spans, uint8_t *coverage) override;
+
+private:
+    uint8_t Coverage(double dx, double dy) const;
+
+    double centerX_;
+    double centerY_;
+    double radiusX_;
+    double radiusY_;
+};
+
+// The mask of `contours`, with the coverage of every pixel sampled on a 4 x 4 grid. The edges are walked from top to
+// bottom, so rows are fastest to produce in increasing order.
+class PolygonCoverageMask : public CoverageMask {
+public:
+    PolygonCoverageMask(const std::vector<Contour> &contours, bool usesEvenOddFillRule, size_t width, size_t height);
+
+    void GetRowSpans(size_t y, CoverageSpans &spans, uint8_t *coverage) override;
+
+private:
+    struct Edge {
+        double topX;
+        double topY;
+        double bottomY;
+        double slope;
+        int winding;
+    };
+
+    struct Crossing {
+        double x;
+        int winding;
+
+        bool operator<(const Crossing &other) const { return x < other.x; }
+    };
+
+    void UpdateActiveEdges(double sampleY);
+
+    bool usesEvenOddFillRule_;
+    PooledVector<Edge> edges_;
+    size_t nextEdge_ = 0;
+    double lastSampleY_ = -INFINITY;
+    PooledVector<const Edge *> activeEdges_;
+    PooledVector<Crossing> crossings_;
+    PooledVector<int> samples_;
+};
+
+// Writes the anti-aliased coverage of `contours` into `coverage`, one byte for every pixel of a `width` x `height`
+// mask, by sampling every pixel on a 4 x 4 grid.
+void RasterizeContours(const std::vector<Contour> &contours, bool usesEvenOddFillRule, size_t width, size_t height, uint8_t *coverage);
+
+} // namespace rsk
+
+#endif /* RSKMaskRasterizer_hpp */
@@ -0,0 +1,185 @@
+//
+// RSKOrientKernels.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKOrientKernels.hpp"
+
+#include <algorithm>
+
+namespace rsk {
+
+namespace {
+
+// The side of the tiles of an orientation that swaps the axes, in bytes of a row of a tile. A tile of pixels of 8-bit
+// components reads 256 rows of 256 pixels of the source and writes as many of the destination, which together fit into
+// the second-level cache, so every cache line of a source column is read from memory once.
+constexpr size_t kTileRowBytes = 1024;
+
+const OrientKernels kScalarKernels = {
+    4,
+    scalar::TransposeBlock<uint32_t, 4>,
+    scalar::ReverseRow<uint32_t>,
+};
+
+const OrientKernels kWideScalarKernels = {
+    4,
+    scalar::TransposeBlock<uint64_t, 4>,
+    scalar::ReverseRow<uint64_t>,
+};
+
+#if RSK_X86_KERNELS
+const OrientKernels kSSE41Kernels = {
+    4,
+    sse41::TransposeBlock,
+    sse41::ReverseRow,
+};
+
+// Blocks of 8 x 8 pixels in 256-bit vectors read twice as many rows of the source at a time, which is slower than
+// transposing blocks of 4 x 4 pixels, so only the rows are reversed with 256-bit vectors.
+const OrientKernels kAVX2Kernels = {
+    4,
+    sse41::TransposeBlock,
+    avx2::ReverseRow,
+};
+#endif
+
+#if RSK_NEON_KERNELS
+const OrientKernels kNEONKernels = {
+    4,
+    neon::TransposeBlock,
+    neon::ReverseRow,
+};
+#endif
+
+} // namespace
+
+const OrientKernels &GetOrientKernels(SimdInstructionSet instructionSet, ComponentType componentType)
+{
+    if (BytesPerPixel(componentType) != kBytesPerPixel) {
+        return kWideScalarKernels;
+    }
+    switch (instructionSet) {
+#if RSK_X86_KERNELS
+        case SimdInstructionSet::SSE41:
+            return kSSE41Kernels;
+        case SimdInstructionSet::AVX2:
+            return kAVX2Kernels;
+#endif
+#if RSK_NEON_KERNELS
+        case SimdInstructionSet::NEON:
+            return kNEONKernels;
+#endif
+        default:
+            return kScalarKernels;
+    }
+}
+
+void OrientPixels(const BitmapView &source, RSKImageOrientation orientation, const OrientKernels &kernels, const BitmapView &destination)
+{
+    // Step 1: find the source pixel of the top-left pixel of the destination, and the number of bytes that the source
+    // pixel moves by for every pixel along a row (`stepX`) and a column (`stepY`) of the destination.
+    const size_t bytesPerPixel = source.BytesPerPixel();
+    const ptrdiff_t pixelStep = static_cast<ptrdiff_t>(bytesPerPixel);
+    const ptrdiff_t rowStep = static_cast<ptrdiff_t>(source.bytesPerRow);
+    const size_t lastX = source.width - 1;
+    const size_t lastY = source.height - 1;
+
+    size_t originX = 0, originY = 0;
+    ptrdiff_t stepX = pixelStep, stepY = rowStep;
+    switch (orientation) {
+        case RSKImageOrientationUp:
+            break;
+        case RSKImageOrientationDown:
+            originX = lastX, originY = lastY, stepX = -pixelStep, stepY = -rowStep;
+            break;
+        case RSKImageOrientationLeft:
+            originX = lastX, stepX = rowStep, stepY = -pixelStep;
+            break;
+        case RSKImageOrientationRight:
+            originY = lastY, stepX = -rowStep, stepY = pixelStep;
+            break;
+        case RSKImageOrientationUpMirrored:
+            originX = lastX, stepX = -pixelStep;
+            break;
+        case RSKImageOrientationDownMirrored:
+            originY = lastY, stepY = -rowStep;
+            break;
+        case RSKImageOrientationLeftMirrored:
+            stepX = rowStep, stepY = pixelStep;
+            break;
+        case RSKImageOrientationRightMirrored:
+            originX = lastX, originY = lastY, stepX = -rowStep, stepY = -pixelStep;
+            break;
+    }
+    const uint8_t *origin = source.Pixel(originX, originY);
+    auto sourcePixel = [&](size_t x, size_t y) {
+        return origin + static_cast<ptrdiff_t>(x) * stepX + static_cast<ptrdiff_t>(y) * stepY;
+    };
+
+    // Step 2: an orientation that keeps the axes copies every row, reversed if it is flipped horizontally.
+    if (!OrientationSwapsDimensions(orientation)) {
+        for (size_t y = 0; y < destination.height; y++) {
+            if (stepX > 0) {
+                std::memcpy(destination.Row(y), sourcePixel(0, y), destination.width * bytesPerPixel);
+            } else {
+                kernels.reverseRow(sourcePixel(destination.width - 1, y), destination.width, destination.Row(y));
+            }
+        }
+        return;
+    }
+
+    // Step 3: an orientation that swaps the axes reads every row of the destination from a column of the source, so the
+    // whole blocks of the destination are transposed one tile at a time. The rows of a block are read from the source
+    // bottom to top if its columns are walked right to left, which writes the rows of the block bottom to top.
+    const size_t blockSize = kernels.blockSize;
+    const size_t tileSize = kTileRowBytes / bytesPerPixel;
+    const size_t blocksWidth = destination.width - destination.width % blockSize;
+    const size_t blocksHeight = destination.height - destination.height % blockSize;
+    const ptrdiff_t destinationStride = stepY > 0 ? static_cast<ptrdiff_t>(destination.bytesPerRow) : -static_cast<ptrdiff_t>(destination.bytesPerRow);
+
+    for (size_t tileY = 0; tileY < blocksHeight; tileY += tileSize) {
+        const size_t tileEndY = std::min(blocksHeight, tileY + tileSize);
+        for (size_t tileX = 0; tileX < blocksWidth; tileX += tileSize) {
+            const size_t tileEndX = std::min(blocksWidth, tileX + tileSize);
+            for (size_t y = tileY; y < tileEndY; y += blockSize) {
+                const size_t firstY = stepY > 0 ? y : y + blockSize - 1;
+                for (size_t x = tileX; x < tileEndX; x += blockSize) {
+                    kernels.transposeBlock(sourcePixel(x, firstY), stepX, destination.Pixel(x, firstY), destinationStride);
+                }
+            }
+        }
+    }
+
+    // Step 4: copy the pixels right of and below the whole blocks one at a time.
+    auto copyPixels = [&](size_t y, size_t beginX) {
+        uint8_t *pixel = destination.Pixel(beginX, y);
+        for (size_t x = beginX; x < destination.width; x++, pixel += bytesPerPixel) {
+            std::memcpy(pixel, sourcePixel(x, y), bytesPerPixel);
+        }
+    };
+    for (size_t y = 0; y < destination.height; y++) {
+        copyPixels(y, y < blocksHeight ? blocksWidth : 0);
+    }
+}
+
+} // namespace rsk
@@ -0,0 +1,99 @@
+//
+// RSKOrientKernels.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKOrientKernels_hpp
+#define RSKOrientKernels_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "RSKBitmap.h"
+#include "RSKImageTransforms.hpp"
+#include "RSKSimd.hpp"
+
+namespace rsk {
+
+// Kernels that move whole pixels of one size with one instruction set.
+struct OrientKernels {
+    // The number of pixels along either side of the blocks that `transposeBlock` moves.
+    size_t blockSize;
+    // Writes pixel `j` of row `k` of the block at `source` to pixel `k` of row `j` of the block at `destination`. The
+    // rows of either block are `sourceStride` or `destinationStride` bytes apart, which may be negative.
+    void (*transposeBlock)(const uint8_t *source, ptrdiff_t sourceStride, uint8_t *destination, ptrdiff_t destinationStride);
+    // Writes the `count` pixels of `source` to `destination` in reverse order.
+    void (*reverseRow)(const uint8_t *source, size_t count, uint8_t *destination);
+};
+
+// Returns the kernels that move pixels with components of `componentType` using `instructionSet`, which must be
+// supported. Only 8-bit components have SIMD kernels; wider pixels are moved by the scalar kernels.
+const OrientKernels &GetOrientKernels(SimdInstructionSet instructionSet, ComponentType componentType);
+
+// Copies `source` to `destination` so that the pixels of `destination` are upright, like `OrientBitmap`, with `kernels`.
+// An orientation that swaps the axes is transposed in tiles that keep the cache lines of the source columns they read
+// cached, one block of pixels at a time.
+void OrientPixels(const BitmapView &source, RSKImageOrientation orientation, const OrientKernels &kernels, const BitmapView &destination);
+
+namespace scalar {
+
+template <typename Pixel, size_t kBlockSize>
+void TransposeBlock(const uint8_t *source, ptrdiff_t sourceStride, uint8_t *destination, ptrdiff_t destinationStride)
+{
+    for (size_t k = 0; k < kBlockSize; k++) {
+        const uint8_t *sourceRow = source + static_cast<ptrdiff_t>(k) * sourceStride;
+        for (size_t j = 0; j < kBlockSize; j++) {
+            std::memcpy(destination + static_cast<ptrdiff_t>(j) * destinationStride + k * sizeof(Pixel), sourceRow + j * sizeof(Pixel), sizeof(Pixel));
+        }
+    }
+}
+
+template <typename Pixel>
+void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination)
+{
+    for (size_t i = 0; i < count; i++) {
+        std::memcpy(destination + i * sizeof(Pixel), source + (count - 1 - i) * sizeof(Pixel), sizeof(Pixel));
+    }
+}
+
+} // namespace scalar
+
+// Kernels of every instruction set that move pixels of 8-bit components. Only the ones of the instruction sets that are
+// built in are defined.
+namespace sse41 {
+void TransposeBlock(const uint8_t *source, ptrdiff_t sourceStride, uint8_t *destination, ptrdiff_t destinationStride);
+void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination);
+} // namespace sse41
+
+namespace avx2 {
+void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination);
+} // namespace avx2
+
+namespace neon {
+void TransposeBlock(const uint8_t *source, ptrdiff_t sourceStride, uint8_t *destination, ptrdiff_t destinationStride);
+void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination);
+} // namespace neon
+
+} // namespace rsk
+
+#endif /* RSKOrientKernels_hpp */
@@ -0,0 +1,77 @@
+//
+// RSKOrientKernelsNEON.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKOrientKernels.hpp"
+
+#if RSK_NEON_KERNELS
+
+#include <arm_neon.h>
+
+namespace rsk {
+
+namespace {
+
+// NEON keeps one pixel in every 32-bit lane. The rows are loaded as bytes, which have no alignment requirement.
+
+inline uint32x4_t LoadPixels(const uint8_t *pixels)
+{
+    return vreinterpretq_u32_u8(vld1q_u8(pixels));
+}
+
+inline void StorePixels(uint8_t *pixels, uint32x4_t value)
+{
+    vst1q_u8(pixels, vreinterpretq_u8_u32(value));
+}
+
+} // namespace
+
+namespace neon {
+
+void TransposeBlock(const uint8_t *source, ptrdiff_t sourceStride, uint8_t *destination, ptrdiff_t destinationStride)
+{
+    // Transposing the pairs of lanes of the rows 0 and 1, and 2 and 3, leaves every column in the halves of two vectors.
+    const uint32x4x2_t rows01 = vtrnq_u32(LoadPixels(source), LoadPixels(source + sourceStride));
+    const uint32x4x2_t rows23 = vtrnq_u32(LoadPixels(source + 2 * sourceStride), LoadPixels(source + 3 * sourceStride));
+
+    StorePixels(destination, vcombine_u32(vget_low_u32(rows01.val[0]), vget_low_u32(rows23.val[0])));
+    StorePixels(destination + destinationStride, vcombine_u32(vget_low_u32(rows01.val[1]), vget_low_u32(rows23.val[1])));
+    StorePixels(destination + 2 * destinationStride, vcombine_u32(vget_high_u32(rows01.val[0]), vget_high_u32(rows23.val[0])));
+    StorePixels(destination + 3 * destinationStride, vcombine_u32(vget_high_u32(rows01.val[1]), vget_high_u32(rows23.val[1])));
+}
+
+void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t pixels = vrev64q_u32(LoadPixels(source + (count - i - 4) * kBytesPerPixel));
+        StorePixels(destination + i * kBytesPerPixel, vextq_u32(pixels, pixels, 2));
+    }
+    scalar::ReverseRow<uint32_t>(source, count - i, destination + i * kBytesPerPixel);
+}
+
+} // namespace neon
+
+} // namespace rsk
+
+#endif
@@ -0,0 +1,89 @@
+//
+// RSKOrientKernelsX86.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKOrientKernels.hpp"
+
+#if RSK_X86_KERNELS
+
+#include <immintrin.h>
+
+#define RSK_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define RSK_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace rsk {
+
+// The kernels keep one pixel in every 32-bit lane, so a block is transposed with the unpack instructions that
+// interleave the lanes of two vectors, and a row is reversed by reversing the lanes.
+
+namespace sse41 {
+
+RSK_TARGET_SSE41 void TransposeBlock(const uint8_t *source, ptrdiff_t sourceStride, uint8_t *destination, ptrdiff_t destinationStride)
+{
+    const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+    const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + sourceStride));
+    const __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 2 * sourceStride));
+    const __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 3 * sourceStride));
+
+    // Pairs of the pixels 0 and 1, and 2 and 3, of the rows 0 and 1, and 2 and 3.
+    const __m128i pairs01Low = _mm_unpacklo_epi32(row0, row1);
+    const __m128i pairs01High = _mm_unpackhi_epi32(row0, row1);
+    const __m128i pairs23Low = _mm_unpacklo_epi32(row2, row3);
+    const __m128i pairs23High = _mm_unpackhi_epi32(row2, row3);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(destination), _mm_unpacklo_epi64(pairs01Low, pairs23Low));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + destinationStride), _mm_unpackhi_epi64(pairs01Low, pairs23Low));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 2 * destinationStride), _mm_unpacklo_epi64(pairs01High, pairs23High));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + 3 * destinationStride), _mm_unpackhi_epi64(pairs01High, pairs23High));
+}
+
+RSK_TARGET_SSE41 void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + (count - i - 4) * kBytesPerPixel));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(destination + i * kBytesPerPixel), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+    }
+    scalar::ReverseRow<uint32_t>(source, count - i, destination + i * kBytesPerPixel);
+}
+
+} // namespace sse41
+
+namespace avx2 {
+
+RSK_TARGET_AVX2 void ReverseRow(const uint8_t *source, size_t count, uint8_t *destination)
+{
+    const __m256i reversedLanes = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source + (count - i - 8) * kBytesPerPixel));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination + i * kBytesPerPixel), _mm256_permutevar8x32_epi32(pixels, reversedLanes));
+    }
+    scalar::ReverseRow<uint32_t>(source, count - i, destination + i * kBytesPerPixel);
+}
+
+} // namespace avx2
+
+} // namespace rsk
+
+#endif
@@ -0,0 +1,201 @@
+//
+// RSKPixelComponents.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKPixelComponents_hpp
+#define RSKPixelComponents_hpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "RSKBitmap.h"
+
+namespace rsk {
+
+// The type of the four components of a pixel. The order of the colors does not matter to the transforms, so every pixel
+// format maps to one of these.
+enum class ComponentType : uint8_t {
+    UInt8,
+    UInt16,
+    Float16
+};
+
+// Returns the type of the components of `pixelFormat`.
+inline ComponentType GetComponentType(RSKPixelFormat pixelFormat)
+{
+    switch (pixelFormat) {
+        case RSKPixelFormatRGBA16:
+            return ComponentType::UInt16;
+        case RSKPixelFormatRGBAHalf:
+            return ComponentType::Float16;
+        case RSKPixelFormatRGBA8888:
+        case RSKPixelFormatBGRA8888:
+            break;
+    }
+    return ComponentType::UInt8;
+}
+
+// Returns the number of bytes of a pixel with components of `type`.
+inline size_t BytesPerPixel(ComponentType type)
+{
+    return type == ComponentType::UInt8 ? 4 : 8;
+}
+
+// Returns the value of the IEEE half float `half`.
+inline float HalfToFloat(uint16_t half)
+{
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+
+    if (exponent == 0) {
+        // Zero or a subnormal, which is the mantissa in units of 2^-24.
+        const float value = static_cast<float>(mantissa) * 5.9604645e-8f;
+        return sign ? -value : value;
+    }
+
+    uint32_t bits;
+    if (exponent == 0x1F) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Returns the IEEE half float nearest to `value`, rounding ties to even. Values beyond the range of a half float become
+// infinite.
+inline uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    bits &= 0x7FFFFFFF;
+
+    if (bits >= 0x7F800000) {
+        // Infinity stays infinite and NaN stays NaN.
+        return sign | 0x7C00 | (bits > 0x7F800000 ? 0x200 : 0);
+    }
+    if (bits >= 0x477FF000) {
+        // 65520 and above round past the largest half float, 65504.
+        return sign | 0x7C00;
+    }
+    if (bits < 0x38800000) {
+        // Below 2^-14 the half float is a subnormal, which is the value in units of 2^-24.
+        float magnitude;
+        std::memcpy(&magnitude, &bits, sizeof(magnitude));
+        return sign | static_cast<uint16_t>(std::nearbyint(magnitude * 16777216.0f));
+    }
+
+    // Round the mantissa to 10 bits, which may carry into the exponent, and move the exponent from a bias of 127 to 15.
+    const uint32_t rounded = bits + 0xFFF + ((bits >> 13) & 1);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+}
+
+// The arithmetic of the transforms on components of an unsigned integer type, which go from 0 to its maximum. The
+// filters overshoot, so the colors are clamped to alpha to keep the pixels premultiplied.
+template <typename ComponentT, typename SumT>
+struct IntegerComponentTraits {
+    using Component = ComponentT;
+    // Holds the sum of the components of a block of pixels that is reduced.
+    using Sum = SumT;
+
+    static constexpr size_t kBytesPerPixel = 4 * sizeof(Component);
+    static constexpr float kMaximum = static_cast<float>(static_cast<Component>(~Component(0)));
+
+    static float Load(Component component) { return component; }
+    static Sum Widen(Component component) { return component; }
+
+    // Returns the component of a `value` that needs no clamping but to the range of the type.
+    static Component Round(float value) { return static_cast<Component>(std::min(kMaximum, std::max(0.0f, value)) + 0.5f); }
+    static Component Alpha(float value) { return Round(value); }
+    static Component Color(float value, Component alpha) { return static_cast<Component>(std::min(static_cast<float>(alpha), std::max(0.0f, value)) + 0.5f); }
+
+    // Returns the average of `count` components that add up to `sum`, or of `1 << shift` of them.
+    static Component Average(Sum sum, uint32_t count) { return static_cast<Component>((sum + count / 2) / count); }
+    static Component AverageShifted(Sum sum, int shift) { return static_cast<Component>((sum + (Sum(1) << shift) / 2) >> shift); }
+
+    // Returns `component` multiplied by the 8-bit `coverage`.
+    static Component Cover(Component component, unsigned coverage) { return static_cast<Component>((component * static_cast<uint32_t>(coverage) + 127) / 255); }
+};
+
+template <ComponentType Type>
+struct ComponentTraits;
+
+template <>
+struct ComponentTraits<ComponentType::UInt8> : IntegerComponentTraits<uint8_t, uint32_t> {
+};
+
+// A block of up to 256 x 256 pixels of 16 bits overflows 32 bits, so they are summed up in 64 bits.
+template <>
+struct ComponentTraits<ComponentType::UInt16> : IntegerComponentTraits<uint16_t, uint64_t> {
+};
+
+// The arithmetic of the transforms on half float components, which go from 0 to 1. Colors may go past alpha and below
+// 0, as the ones of extended-range images do, so only alpha is clamped.
+template <>
+struct ComponentTraits<ComponentType::Float16> {
+    using Component = uint16_t;
+    using Sum = float;
+
+    static constexpr size_t kBytesPerPixel = 4 * sizeof(Component);
+    static constexpr float kMaximum = 1.0f;
+
+    static float Load(Component component) { return HalfToFloat(component); }
+    static Sum Widen(Component component) { return HalfToFloat(component); }
+
+    static Component Round(float value) { return FloatToHalf(value); }
+    static Component Alpha(float value) { return FloatToHalf(std::min(kMaximum, std::max(0.0f, value))); }
+    static Component Color(float value, Component) { return FloatToHalf(value); }
+
+    static Component Average(Sum sum, uint32_t count) { return FloatToHalf(sum / static_cast<float>(count)); }
+    static Component AverageShifted(Sum sum, int shift) { return FloatToHalf(std::ldexp(sum, -shift)); }
+
+    static Component Cover(Component component, unsigned coverage) { return FloatToHalf(HalfToFloat(component) * static_cast<float>(coverage) * (1.0f / 255.0f)); }
+};
+
+// Calls `visitor` with the `ComponentTraits` of `type`, so that a transform is compiled once for every type.
+template <typename Visitor>
+void VisitComponentType(ComponentType type, Visitor &&visitor)
+{
+    switch (type) {
+        case ComponentType::UInt8:
+            visitor(ComponentTraits<ComponentType::UInt8>());
+            return;
+        case ComponentType::UInt16:
+            visitor(ComponentTraits<ComponentType::UInt16>());
+            return;
+        case ComponentType::Float16:
+            visitor(ComponentTraits<ComponentType::Float16>());
+            return;
+    }
+}
+
+} // namespace rsk
+
+#endif /* RSKPixelComponents_hpp */
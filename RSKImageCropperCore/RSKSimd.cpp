@@ -0,0 +1,86 @@
+//
+// RSKSimd.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKSimd.hpp"
+
+#include <initializer_list>
+
+namespace rsk {
+
+const char *SimdInstructionSetName(SimdInstructionSet instructionSet)
+{
+    switch (instructionSet) {
+        case SimdInstructionSet::Scalar:
+            return "Scalar";
+        case SimdInstructionSet::SSE41:
+            return "SSE4.1";
+        case SimdInstructionSet::AVX2:
+            return "AVX2";
+        case SimdInstructionSet::NEON:
+            return "NEON";
+    }
+    return "Unknown";
+}
+
+bool IsSimdInstructionSetSupported(SimdInstructionSet instructionSet)
+{
+    switch (instructionSet) {
+        case SimdInstructionSet::Scalar:
+            return true;
+        case SimdInstructionSet::SSE41:
+#if RSK_X86_KERNELS
+            return __builtin_cpu_supports("sse4.1");
+#else
+            return false;
+#endif
+        case SimdInstructionSet::AVX2:
+#if RSK_X86_KERNELS
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+        case SimdInstructionSet::NEON:
+#if RSK_NEON_KERNELS
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+SimdInstructionSet BestSimdInstructionSet()
+{
+    static const SimdInstructionSet instructionSet = [] {
+        for (SimdInstructionSet candidate : { SimdInstructionSet::AVX2, SimdInstructionSet::SSE41, SimdInstructionSet::NEON }) {
+            if (IsSimdInstructionSetSupported(candidate)) {
+                return candidate;
+            }
+        }
+        return SimdInstructionSet::Scalar;
+    }();
+    return instructionSet;
+}
+
+} // namespace rsk
@@ -0,0 +1,59 @@
+//
+// RSKSimd.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKSimd_hpp
+#define RSKSimd_hpp
+
+// The x86 kernels use function attributes to enable their instruction sets, so they build without special compiler flags.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define RSK_X86_KERNELS 1
+#endif
+
+// The NEON kernels round sample points in double precision, which needs AArch64.
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define RSK_NEON_KERNELS 1
+#endif
+
+namespace rsk {
+
+// Instruction sets the SIMD kernels are written for.
+enum class SimdInstructionSet {
+    Scalar,
+    SSE41,
+    AVX2,
+    NEON,
+};
+
+// Returns the name of `instructionSet`, for benchmarks and test output.
+const char *SimdInstructionSetName(SimdInstructionSet instructionSet);
+
+// Returns true if the kernels of `instructionSet` are built in and the CPU can run them.
+bool IsSimdInstructionSetSupported(SimdInstructionSet instructionSet);
+
+// Returns the fastest instruction set that is supported.
+SimdInstructionSet BestSimdInstructionSet();
+
+} // namespace rsk
+
+#endif /* RSKSimd_hpp */
@@ -0,0 +1,242 @@
+//
+// RSKThreadPool.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKThreadPool.hpp"
+
+#include <algorithm>
+#include <new>
+#include <system_error>
+
+struct RSKThreadPool {
+    explicit RSKThreadPool(size_t threadCount) : pool(threadCount) {}
+
+    rsk::ThreadPool pool;
+};
+
+namespace rsk {
+
+namespace {
+
+// The pool whose loop the current thread is running, if any.
+thread_local const ThreadPool *currentPool = nullptr;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    try {
+        for (size_t i = 1; i < threadCount; i++) {
+            workers_.emplace_back(&ThreadPool::RunWorker, this, i);
+        }
+    } catch (...) {
+        StopWorkers();
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    StopWorkers();
+}
+
+void ThreadPool::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+    loopStarted_.notify_all();
+    for (std::thread &worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, void *context, RSKWorkFunction work)
+{
+    if (count == 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1 || currentPool == this) {
+        for (size_t i = 0; i < count; i++) {
+            work(context, i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> loopLock(loopMutex_);
+
+    // Step 1: give every thread an equal share of the indices.
+    const size_t shareCount = ThreadCount();
+    Loop loop;
+    loop.context = context;
+    loop.work = work;
+    loop.shares.reset(new Share[shareCount]);
+    for (size_t i = 0; i < shareCount; i++) {
+        loop.shares[i].begin = count * i / shareCount;
+        loop.shares[i].end = count * (i + 1) / shareCount;
+    }
+
+    // Step 2: wake the workers up and take part in the loop.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loop_ = &loop;
+        loopGeneration_++;
+    }
+    loopStarted_.notify_all();
+
+    const ThreadPool *previousPool = currentPool;
+    currentPool = this;
+    RunLoop(loop, 0);
+    currentPool = previousPool;
+
+    // Step 3: once no index is left, wait for the workers that are still running the last ones.
+    std::unique_lock<std::mutex> lock(mutex_);
+    loop_ = nullptr;
+    workerFinished_.wait(lock, [&loop] { return loop.activeWorkerCount == 0; });
+}
+
+void ThreadPool::RunWorker(size_t shareIndex)
+{
+    currentPool = this;
+    uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        loopStarted_.wait(lock, [this, generation] { return isStopping_ || loopGeneration_ != generation; });
+        if (isStopping_) {
+            return;
+        }
+        generation = loopGeneration_;
+
+        // The loop may already be over when a worker wakes up late.
+        Loop *loop = loop_;
+        if (!loop) {
+            continue;
+        }
+        loop->activeWorkerCount++;
+        lock.unlock();
+
+        RunLoop(*loop, shareIndex);
+
+        lock.lock();
+        if (--loop->activeWorkerCount == 0) {
+            workerFinished_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::RunLoop(Loop &loop, size_t shareIndex)
+{
+    size_t index;
+    while (TakeIndex(loop, shareIndex, index)) {
+        loop.work(loop.context, index);
+    }
+}
+
+bool ThreadPool::TakeIndex(Loop &loop, size_t shareIndex, size_t &index)
+{
+    // Step 1: take the next index of the own share.
+    Share &share = loop.shares[shareIndex];
+    {
+        std::lock_guard<std::mutex> lock(share.mutex);
+        if (share.begin < share.end) {
+            index = share.begin++;
+            return true;
+        }
+    }
+
+    // Step 2: steal the back half of the share of another thread, starting with the next one.
+    const size_t shareCount = ThreadCount();
+    for (size_t i = 1; i < shareCount; i++) {
+        Share &victim = loop.shares[(shareIndex + i) % shareCount];
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin == victim.end) {
+                continue;
+            }
+            end = victim.end;
+            begin = end - (end - victim.begin + 1) / 2;
+            victim.end = begin;
+        }
+
+        std::lock_guard<std::mutex> lock(share.mutex);
+        index = begin;
+        share.begin = begin + 1;
+        share.end = end;
+        return true;
+    }
+
+    return false;
+}
+
+RSKExecutor MakeExecutor(ThreadPool &pool)
+{
+    RSKExecutor executor;
+    executor.parallelFor = [](void *executorContext, size_t count, void *context, RSKWorkFunction work) {
+        static_cast<ThreadPool *>(executorContext)->ParallelFor(count, context, work);
+    };
+    executor.context = &pool;
+    executor.concurrency = pool.ThreadCount();
+    return executor;
+}
+
+void ParallelFor(const RSKExecutor *executor, size_t count, void *context, RSKWorkFunction work)
+{
+    if (executor && executor->parallelFor) {
+        executor->parallelFor(executor->context, count, context, work);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        work(context, i);
+    }
+}
+
+} // namespace rsk
+
+RSKThreadPool *RSKThreadPoolCreate(size_t threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    try {
+        return new RSKThreadPool(threadCount);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    } catch (const std::system_error &) {
+        return nullptr;
+    }
+}
+
+void RSKThreadPoolDestroy(RSKThreadPool *pool)
+{
+    delete pool;
+}
+
+RSKExecutor RSKThreadPoolGetExecutor(RSKThreadPool *pool)
+{
+    return rsk::MakeExecutor(pool->pool);
+}
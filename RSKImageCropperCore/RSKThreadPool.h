@@ -0,0 +1,68 @@
+//
+// RSKThreadPool.h
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKThreadPool_h
+#define RSKThreadPool_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A unit of work that is called once for every index of a parallel loop.
+typedef void (*RSKWorkFunction)(void *context, size_t index);
+
+// Calls `work` with `context` and every index from 0 to `count - 1`, possibly on several threads at once, and returns
+// when every call has returned. Like `dispatch_apply_f`.
+typedef void (*RSKParallelForFunction)(void *executorContext, size_t count, void *context, RSKWorkFunction work);
+
+// Runs the parallel loops of the crop engine. On Apple platforms it can be backed by `dispatch_apply_f`, elsewhere by
+// an `RSKThreadPool`.
+struct RSKExecutor {
+    RSKParallelForFunction parallelFor;
+    void *context;
+    // The maximum number of calls of a work function that run at once.
+    size_t concurrency;
+};
+typedef struct RSKExecutor RSKExecutor;
+
+// A portable pool of threads that balances the work of a parallel loop by stealing it from each other.
+typedef struct RSKThreadPool RSKThreadPool;
+
+// Returns a pool that runs parallel loops on `threadCount` threads, the calling thread included. A `threadCount` of 0
+// uses one thread for every hardware thread. Returns null if the threads cannot be started.
+RSKThreadPool *RSKThreadPoolCreate(size_t threadCount);
+
+// Stops the threads of `pool` and frees it. It must not be running a parallel loop.
+void RSKThreadPoolDestroy(RSKThreadPool *pool);
+
+// Returns the executor that runs parallel loops on `pool`. It is valid until the pool is destroyed.
+RSKExecutor RSKThreadPoolGetExecutor(RSKThreadPool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RSKThreadPool_h */
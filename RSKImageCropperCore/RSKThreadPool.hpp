@@ -0,0 +1,108 @@
+//
+// RSKThreadPool.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKThreadPool_hpp
+#define RSKThreadPool_hpp
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RSKThreadPool.h"
+
+namespace rsk {
+
+// A pool of threads that run the indices of a parallel loop.
+//
+// Every thread starts with a contiguous share of the indices and takes them from the front. A thread that runs out of
+// indices steals the back half of the share of another thread, so uneven work, such as the tiles of a rotated image
+// that are mostly transparent, is balanced without a shared queue.
+class ThreadPool {
+public:
+    // Starts `threadCount - 1` threads; the thread that runs a parallel loop takes part in it.
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Returns the number of threads that run a parallel loop, the calling thread included.
+    size_t ThreadCount() const { return workers_.size() + 1; }
+
+    // Calls `work` with `context` and every index from 0 to `count - 1` and returns when every call has returned.
+    // Loops started from several threads run one after another. A loop started from inside a loop of the same pool
+    // runs on the calling thread. `work` must not throw.
+    void ParallelFor(size_t count, void *context, RSKWorkFunction work);
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    // The indices of a loop that are left to one thread. Every share has a cache line of its own, so that a thread
+    // taking its next index does not take the line of its neighbors away from them.
+    struct alignas(kCacheLineSize) Share {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    struct Loop {
+        void *context = nullptr;
+        RSKWorkFunction work = nullptr;
+        std::unique_ptr<Share[]> shares;
+        // The number of threads of the pool, the calling thread excluded, that are running the loop.
+        size_t activeWorkerCount = 0;
+    };
+
+    void StopWorkers();
+    void RunWorker(size_t shareIndex);
+    void RunLoop(Loop &loop, size_t shareIndex);
+    bool TakeIndex(Loop &loop, size_t shareIndex, size_t &index);
+
+    std::vector<std::thread> workers_;
+
+    // Serializes the loops of the pool.
+    std::mutex loopMutex_;
+
+    // Guards everything below.
+    std::mutex mutex_;
+    std::condition_variable loopStarted_;
+    std::condition_variable workerFinished_;
+    Loop *loop_ = nullptr;
+    uint64_t loopGeneration_ = 0;
+    bool isStopping_ = false;
+};
+
+// Returns the executor that runs parallel loops on `pool`.
+RSKExecutor MakeExecutor(ThreadPool &pool);
+
+// Runs a parallel loop on `executor`, or on the calling thread if it is null.
+void ParallelFor(const RSKExecutor *executor, size_t count, void *context, RSKWorkFunction work);
+
+} // namespace rsk
+
+#endif /* RSKThreadPool_hpp */
@@ -0,0 +1,293 @@
+//
+// RSKWarpKernels.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKWarpKernels.hpp"
+
+#include <cstring>
+
+namespace rsk {
+
+namespace scalar {
+namespace {
+
+template <typename Traits>
+WarpRowKernel GetComponentKernel(RSKResamplingFilter filter);
+
+} // namespace
+} // namespace scalar
+
+WarpRowKernel GetWarpRowKernel(RSKResamplingFilter filter, SimdInstructionSet instructionSet, ComponentType componentType)
+{
+    switch (componentType) {
+        case ComponentType::UInt8:
+            break;
+        case ComponentType::UInt16:
+            return scalar::GetComponentKernel<ComponentTraits<ComponentType::UInt16>>(filter);
+        case ComponentType::Float16:
+            return scalar::GetComponentKernel<ComponentTraits<ComponentType::Float16>>(filter);
+    }
+
+    switch (instructionSet) {
+        case SimdInstructionSet::Scalar:
+            break;
+#if RSK_X86_KERNELS
+        case SimdInstructionSet::AVX2:
+            // The separable filters spend their time on the weights and the taps of one pixel, which AVX2 does not
+            // widen, so they share the SSE4.1 kernels.
+            switch (filter) {
+                case RSKResamplingFilterBilinear:
+                    return avx2::WarpRowBilinear;
+                case RSKResamplingFilterNearest:
+                    return avx2::WarpRowNearest;
+                case RSKResamplingFilterBicubic:
+                    return sse41::WarpRowBicubic;
+                case RSKResamplingFilterLanczos3:
+                    return sse41::WarpRowLanczos3;
+            }
+            break;
+        case SimdInstructionSet::SSE41:
+            // Without a gather, copying one pixel at a time is as fast as it gets for the nearest filter.
+            switch (filter) {
+                case RSKResamplingFilterBilinear:
+                    return sse41::WarpRowBilinear;
+                case RSKResamplingFilterNearest:
+                    return scalar::WarpRowNearest;
+                case RSKResamplingFilterBicubic:
+                    return sse41::WarpRowBicubic;
+                case RSKResamplingFilterLanczos3:
+                    return sse41::WarpRowLanczos3;
+            }
+            break;
+#endif
+#if RSK_NEON_KERNELS
+        case SimdInstructionSet::NEON:
+            switch (filter) {
+                case RSKResamplingFilterBilinear:
+                    return neon::WarpRowBilinear;
+                case RSKResamplingFilterNearest:
+                    return neon::WarpRowNearest;
+                case RSKResamplingFilterBicubic:
+                    return neon::WarpRowBicubic;
+                case RSKResamplingFilterLanczos3:
+                    return neon::WarpRowLanczos3;
+            }
+            break;
+#endif
+        default:
+            break;
+    }
+
+    return scalar::GetComponentKernel<ComponentTraits<ComponentType::UInt8>>(filter);
+}
+
+int FilterRadius(RSKResamplingFilter filter)
+{
+    switch (filter) {
+        case RSKResamplingFilterBilinear:
+        case RSKResamplingFilterNearest:
+            return 1;
+        case RSKResamplingFilterBicubic:
+            return kBicubicTapCount + kBicubicFirstTap - 1;
+        case RSKResamplingFilterLanczos3:
+            return kLanczos3TapCount + kLanczos3FirstTap - 1;
+    }
+    return 1;
+}
+
+namespace scalar {
+
+namespace {
+
+// Returns the pixel of `view` at `x` and `y`, which has components of `Traits`, or null if it is outside of the view.
+template <typename Traits>
+inline const typename Traits::Component *PixelOrNull(const BitmapView &view, ptrdiff_t x, ptrdiff_t y)
+{
+    if (x < 0 || y < 0 || x >= static_cast<ptrdiff_t>(view.width) || y >= static_cast<ptrdiff_t>(view.height)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const typename Traits::Component *>(view.Row(static_cast<size_t>(y)) + static_cast<size_t>(x) * Traits::kBytesPerPixel);
+}
+
+template <typename Traits>
+void WarpRowNearestOf(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    for (size_t i = 0; i < count; i++, destination += Traits::kBytesPerPixel) {
+        const ptrdiff_t ix = static_cast<ptrdiff_t>(std::floor(x + stepX * i + 0.5));
+        const ptrdiff_t iy = static_cast<ptrdiff_t>(std::floor(y + stepY * i + 0.5));
+        const typename Traits::Component *pixel = PixelOrNull<Traits>(source, ix, iy);
+        if (pixel) {
+            std::memcpy(destination, pixel, Traits::kBytesPerPixel);
+        } else {
+            std::memset(destination, 0, Traits::kBytesPerPixel);
+        }
+    }
+}
+
+template <typename Traits>
+void WarpRowBilinearOf(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    using Component = typename Traits::Component;
+
+    for (size_t i = 0; i < count; i++, destination += Traits::kBytesPerPixel) {
+        Component *pixel = reinterpret_cast<Component *>(destination);
+        const double sx = x + stepX * i;
+        const double sy = y + stepY * i;
+        const double x0 = std::floor(sx);
+        const double y0 = std::floor(sy);
+        const float fx = static_cast<float>(sx - x0);
+        const float fy = static_cast<float>(sy - y0);
+        const ptrdiff_t ix = static_cast<ptrdiff_t>(x0);
+        const ptrdiff_t iy = static_cast<ptrdiff_t>(y0);
+
+        const float w00 = (1.0f - fx) * (1.0f - fy);
+        const float w10 = fx * (1.0f - fy);
+        const float w01 = (1.0f - fx) * fy;
+        const float w11 = fx * fy;
+
+        // Most samples lie inside of the source, so they skip the bounds checks of the edges.
+        if (ix >= 0 && iy >= 0 && ix + 1 < static_cast<ptrdiff_t>(source.width) && iy + 1 < static_cast<ptrdiff_t>(source.height)) {
+            const uint8_t *row = source.Row(static_cast<size_t>(iy)) + static_cast<size_t>(ix) * Traits::kBytesPerPixel;
+            const Component *p00 = reinterpret_cast<const Component *>(row);
+            const Component *p01 = reinterpret_cast<const Component *>(row + source.bytesPerRow);
+            for (size_t c = 0; c < 4; c++) {
+                float value = w00 * Traits::Load(p00[c]) + w10 * Traits::Load(p00[c + 4]) + w01 * Traits::Load(p01[c]) + w11 * Traits::Load(p01[c + 4]);
+                pixel[c] = Traits::Round(value);
+            }
+            continue;
+        }
+
+        const Component *p00 = PixelOrNull<Traits>(source, ix, iy);
+        const Component *p10 = PixelOrNull<Traits>(source, ix + 1, iy);
+        const Component *p01 = PixelOrNull<Traits>(source, ix, iy + 1);
+        const Component *p11 = PixelOrNull<Traits>(source, ix + 1, iy + 1);
+
+        for (size_t c = 0; c < 4; c++) {
+            float value = 0.0f;
+            if (p00) value += w00 * Traits::Load(p00[c]);
+            if (p10) value += w10 * Traits::Load(p10[c]);
+            if (p01) value += w01 * Traits::Load(p01[c]);
+            if (p11) value += w11 * Traits::Load(p11[c]);
+            pixel[c] = Traits::Round(value);
+        }
+    }
+}
+
+// Samples with a separable filter of `TapCount` taps along each axis, the first `FirstTap` pixels from the pixel at
+// the floor of the sample point.
+template <typename Traits, int TapCount, int FirstTap, void (*Weights)(float, float *)>
+void WarpRowSeparable(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    using Component = typename Traits::Component;
+    const ptrdiff_t width = static_cast<ptrdiff_t>(source.width);
+    const ptrdiff_t height = static_cast<ptrdiff_t>(source.height);
+
+    for (size_t i = 0; i < count; i++, destination += Traits::kBytesPerPixel) {
+        const double sx = x + stepX * i;
+        const double sy = y + stepY * i;
+        const double x0 = std::floor(sx);
+        const double y0 = std::floor(sy);
+        const ptrdiff_t tapX = static_cast<ptrdiff_t>(x0) + FirstTap;
+        const ptrdiff_t tapY = static_cast<ptrdiff_t>(y0) + FirstTap;
+
+        // Only the taps inside of the source contribute.
+        const int firstColumn = static_cast<int>(std::max<ptrdiff_t>(0, -tapX));
+        const int lastColumn = static_cast<int>(std::min<ptrdiff_t>(TapCount, width - tapX));
+        const int firstRow = static_cast<int>(std::max<ptrdiff_t>(0, -tapY));
+        const int lastRow = static_cast<int>(std::min<ptrdiff_t>(TapCount, height - tapY));
+        if (firstColumn >= lastColumn || firstRow >= lastRow) {
+            std::memset(destination, 0, Traits::kBytesPerPixel);
+            continue;
+        }
+
+        float weightsX[TapCount];
+        float weightsY[TapCount];
+        Weights(static_cast<float>(sx - x0), weightsX);
+        Weights(static_cast<float>(sy - y0), weightsY);
+
+        float sum[4] = {};
+        for (int row = firstRow; row < lastRow; row++) {
+            const Component *pixel = PixelOrNull<Traits>(source, tapX + firstColumn, tapY + row);
+            float rowSum[4] = {};
+            for (int column = firstColumn; column < lastColumn; column++, pixel += 4) {
+                for (size_t c = 0; c < 4; c++) {
+                    rowSum[c] += weightsX[column] * Traits::Load(pixel[c]);
+                }
+            }
+            for (size_t c = 0; c < 4; c++) {
+                sum[c] += weightsY[row] * rowSum[c];
+            }
+        }
+
+        Component *result = reinterpret_cast<Component *>(destination);
+        const Component alpha = Traits::Alpha(sum[3]);
+        for (size_t c = 0; c < 3; c++) {
+            result[c] = Traits::Color(sum[c], alpha);
+        }
+        result[3] = alpha;
+    }
+}
+
+template <typename Traits>
+WarpRowKernel GetComponentKernel(RSKResamplingFilter filter)
+{
+    switch (filter) {
+        case RSKResamplingFilterBilinear:
+            return WarpRowBilinearOf<Traits>;
+        case RSKResamplingFilterNearest:
+            return WarpRowNearestOf<Traits>;
+        case RSKResamplingFilterBicubic:
+            return WarpRowSeparable<Traits, kBicubicTapCount, kBicubicFirstTap, BicubicWeights>;
+        case RSKResamplingFilterLanczos3:
+            return WarpRowSeparable<Traits, kLanczos3TapCount, kLanczos3FirstTap, Lanczos3Weights>;
+    }
+    return WarpRowBilinearOf<Traits>;
+}
+
+using EightBitTraits = ComponentTraits<ComponentType::UInt8>;
+
+} // namespace
+
+void WarpRowNearest(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowNearestOf<EightBitTraits>(source, x, y, stepX, stepY, count, destination);
+}
+
+void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowBilinearOf<EightBitTraits>(source, x, y, stepX, stepY, count, destination);
+}
+
+void WarpRowBicubic(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowSeparable<EightBitTraits, kBicubicTapCount, kBicubicFirstTap, BicubicWeights>(source, x, y, stepX, stepY, count, destination);
+}
+
+void WarpRowLanczos3(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowSeparable<EightBitTraits, kLanczos3TapCount, kLanczos3FirstTap, Lanczos3Weights>(source, x, y, stepX, stepY, count, destination);
+}
+
+} // namespace scalar
+
+} // namespace rsk
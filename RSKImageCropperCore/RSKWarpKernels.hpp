@@ -0,0 +1,162 @@
+//
+// RSKWarpKernels.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKWarpKernels_hpp
+#define RSKWarpKernels_hpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "RSKCropEngine.h"
+#include "RSKImageTransforms.hpp"
+#include "RSKSimd.hpp"
+
+namespace rsk {
+
+// Writes `count` pixels to `destination`. Pixel `i` is the sample of `source` at `x + i * stepX` and `y + i * stepY`,
+// in pixel indices, so the center of the top-left pixel of the source is at 0, 0. Samples outside of the source are
+// transparent.
+using WarpRowKernel = void (*)(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+
+// Returns the kernel that samples pixels with components of `componentType` with `filter` using `instructionSet`, which
+// must be supported. Only 8-bit components have SIMD kernels; the others are sampled by the scalar kernels in floats.
+WarpRowKernel GetWarpRowKernel(RSKResamplingFilter filter, SimdInstructionSet instructionSet, ComponentType componentType = ComponentType::UInt8);
+
+// Returns the number of pixels on either side of the pixel at the floor of a sample point that `filter` may read.
+int FilterRadius(RSKResamplingFilter filter);
+
+// Kernels of every instruction set. Only the ones of the instruction sets that are built in are defined.
+namespace scalar {
+void WarpRowNearest(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowBicubic(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowLanczos3(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+} // namespace scalar
+
+namespace sse41 {
+void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowBicubic(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowLanczos3(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+} // namespace sse41
+
+namespace avx2 {
+void WarpRowNearest(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+} // namespace avx2
+
+namespace neon {
+void WarpRowNearest(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowBicubic(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+void WarpRowLanczos3(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination);
+} // namespace neon
+
+// Filter weights shared by the kernels of every instruction set.
+
+// Number of taps of the separable filters along each axis, and the offset of the first tap from the pixel at the floor
+// of the sample point.
+constexpr int kBicubicTapCount = 4;
+constexpr int kBicubicFirstTap = -1;
+constexpr int kLanczos3TapCount = 6;
+constexpr int kLanczos3FirstTap = -2;
+
+// Writes the weights of the Catmull-Rom cubic for a sample `t` pixels to the right of the pixel at the floor of the
+// sample point, `0 <= t < 1`.
+inline void BicubicWeights(float t, float weights[kBicubicTapCount])
+{
+    const float t2 = t * t;
+    const float t3 = t2 * t;
+    weights[0] = -0.5f * t3 + t2 - 0.5f * t;
+    weights[1] = 1.5f * t3 - 2.5f * t2 + 1.0f;
+    weights[2] = -1.5f * t3 + 2.0f * t2 + 0.5f * t;
+    weights[3] = 0.5f * t3 - 0.5f * t2;
+}
+
+// Number of sample positions between two pixels that the weights of the Lanczos window are tabulated for.
+constexpr int kLanczos3PhaseCount = 1024;
+
+// Writes the normalized weights of the Lanczos window of radius 3 for a sample `t` pixels to the right of the pixel at
+// the floor of the sample point, `0 <= t <= 1`.
+//
+// The taps are whole pixels apart, so `sin(pi * (t - k))` and `sin(pi * (t - k) / 3)` follow from a single `sin` and a
+// single `sincos` of `t` with the angle addition formulas.
+inline void ComputeLanczos3Weights(float t, float weights[kLanczos3TapCount])
+{
+    // cos(pi * k / 3) and sin(pi * k / 3) for k = -2 ... 3.
+    static const float kCosines[kLanczos3TapCount] = { -0.5f, 0.5f, 1.0f, 0.5f, -0.5f, -1.0f };
+    static const float kSines[kLanczos3TapCount] = { -0.8660254f, -0.8660254f, 0.0f, 0.8660254f, 0.8660254f, 0.0f };
+    const float kPi = 3.14159265f;
+
+    const float sine = std::sin(kPi * t);
+    const float thirdSine = std::sin(kPi * t / 3.0f);
+    const float thirdCosine = std::cos(kPi * t / 3.0f);
+
+    float sum = 0.0f;
+    for (int i = 0; i < kLanczos3TapCount; i++) {
+        const int k = i + kLanczos3FirstTap;
+        const float x = t - k;
+        if (std::fabs(x) < 1e-6f) {
+            // The sample point is on a pixel, which is the only one that contributes.
+            for (int j = 0; j < kLanczos3TapCount; j++) {
+                weights[j] = j == i ? 1.0f : 0.0f;
+            }
+            return;
+        }
+        const float sineOfX = (k & 1) ? -sine : sine;
+        const float sineOfThirdX = thirdSine * kCosines[i] - thirdCosine * kSines[i];
+        weights[i] = 3.0f * sineOfX * sineOfThirdX / (kPi * kPi * x * x);
+        sum += weights[i];
+    }
+    for (int i = 0; i < kLanczos3TapCount; i++) {
+        weights[i] /= sum;
+    }
+}
+
+// Writes the weights of `ComputeLanczos3Weights` for the nearest tabulated sample position to `t`, `0 <= t < 1`. The
+// sines dominate the cost of the filter otherwise.
+inline void Lanczos3Weights(float t, float weights[kLanczos3TapCount])
+{
+    struct Table {
+        float weights[kLanczos3PhaseCount + 1][kLanczos3TapCount];
+
+        Table()
+        {
+            for (int phase = 0; phase <= kLanczos3PhaseCount; phase++) {
+                ComputeLanczos3Weights(static_cast<float>(phase) / kLanczos3PhaseCount, weights[phase]);
+            }
+        }
+    };
+    static const Table table;
+
+    const int phase = std::min(kLanczos3PhaseCount, std::max(0, static_cast<int>(t * kLanczos3PhaseCount + 0.5f)));
+    for (int i = 0; i < kLanczos3TapCount; i++) {
+        weights[i] = table.weights[phase][i];
+    }
+}
+
+} // namespace rsk
+
+#endif /* RSKWarpKernels_hpp */
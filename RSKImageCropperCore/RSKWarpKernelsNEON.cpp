@@ -0,0 +1,188 @@
+//
+// RSKWarpKernelsNEON.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKWarpKernels.hpp"
+
+#if RSK_NEON_KERNELS
+
+#include <cstring>
+
+#include <arm_neon.h>
+
+namespace rsk {
+
+namespace {
+
+// NEON keeps the four components of one pixel in the lanes of a vector.
+
+inline float32x4_t LoadPixel(const uint8_t *pixel)
+{
+    uint32_t value;
+    std::memcpy(&value, pixel, kBytesPerPixel);
+    const uint16x8_t widened = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value)));
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(widened)));
+}
+
+inline void StorePixel(uint32x4_t value, uint8_t *destination)
+{
+    const uint16x4_t narrowed = vmovn_u32(value);
+    const uint8x8_t packed = vmovn_u16(vcombine_u16(narrowed, narrowed));
+    const uint32_t result = vget_lane_u32(vreinterpret_u32_u8(packed), 0);
+    std::memcpy(destination, &result, kBytesPerPixel);
+}
+
+// Rounds like the scalar bilinear kernel.
+inline void StoreBilinearPixel(float32x4_t value, uint8_t *destination)
+{
+    value = vminq_f32(vaddq_f32(value, vdupq_n_f32(0.5f)), vdupq_n_f32(255.0f));
+    StorePixel(vcvtq_u32_f32(value), destination);
+}
+
+// Clamps and rounds like the `Alpha` and `Color` of `IntegerComponentTraits`.
+inline void StoreFilteredPixel(float32x4_t value, uint8_t *destination)
+{
+    value = vmaxq_f32(value, vdupq_n_f32(0.0f));
+    const float alpha = std::min(vgetq_lane_f32(value, 3), 255.0f);
+    const float roundedAlpha = static_cast<float>(static_cast<int>(alpha + 0.5f));
+    const float32x4_t maximum = vsetq_lane_f32(255.0f, vdupq_n_f32(roundedAlpha), 3);
+    value = vaddq_f32(vminq_f32(value, maximum), vdupq_n_f32(0.5f));
+    StorePixel(vcvtq_u32_f32(value), destination);
+}
+
+// Samples with a separable filter, like `scalar::WarpRowSeparable`. Samples whose taps cross the edges of the source
+// fall back to the scalar kernel.
+template <int TapCount, int FirstTap, void (*Weights)(float, float *), WarpRowKernel EdgeKernel>
+void WarpRowSeparable(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    const ptrdiff_t width = static_cast<ptrdiff_t>(source.width);
+    const ptrdiff_t height = static_cast<ptrdiff_t>(source.height);
+
+    for (size_t i = 0; i < count; i++, destination += kBytesPerPixel) {
+        const double sx = x + stepX * i;
+        const double sy = y + stepY * i;
+        const double x0 = std::floor(sx);
+        const double y0 = std::floor(sy);
+        const ptrdiff_t tapX = static_cast<ptrdiff_t>(x0) + FirstTap;
+        const ptrdiff_t tapY = static_cast<ptrdiff_t>(y0) + FirstTap;
+        if (tapX < 0 || tapY < 0 || tapX + TapCount > width || tapY + TapCount > height) {
+            EdgeKernel(source, sx, sy, 0.0, 0.0, 1, destination);
+            continue;
+        }
+
+        float weightsX[TapCount];
+        float weightsY[TapCount];
+        Weights(static_cast<float>(sx - x0), weightsX);
+        Weights(static_cast<float>(sy - y0), weightsY);
+
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (int row = 0; row < TapCount; row++) {
+            const uint8_t *pixel = source.Pixel(static_cast<size_t>(tapX), static_cast<size_t>(tapY + row));
+            float32x4_t rowSum = vdupq_n_f32(0.0f);
+            for (int column = 0; column < TapCount; column++, pixel += kBytesPerPixel) {
+                rowSum = vaddq_f32(rowSum, vmulq_n_f32(LoadPixel(pixel), weightsX[column]));
+            }
+            sum = vaddq_f32(sum, vmulq_n_f32(rowSum, weightsY[row]));
+        }
+        StoreFilteredPixel(sum, destination);
+    }
+}
+
+} // namespace
+
+namespace neon {
+
+void WarpRowNearest(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    // Two sample points at a time, in double precision, so they round to the same pixels as the scalar kernel.
+    const float64x2_t half = vdupq_n_f64(0.5);
+    const float64x2_t width = vdupq_n_f64(static_cast<double>(source.width));
+    const float64x2_t height = vdupq_n_f64(static_cast<double>(source.height));
+    const float64x2_t zero = vdupq_n_f64(0.0);
+
+    for (size_t i = 0; i < count; i += 2) {
+        const double indexValues[2] = { static_cast<double>(i), static_cast<double>(i + 1) };
+        const float64x2_t indices = vld1q_f64(indexValues);
+        const float64x2_t sx = vrndmq_f64(vaddq_f64(vaddq_f64(vdupq_n_f64(x), vmulq_n_f64(indices, stepX)), half));
+        const float64x2_t sy = vrndmq_f64(vaddq_f64(vaddq_f64(vdupq_n_f64(y), vmulq_n_f64(indices, stepY)), half));
+        const uint64x2_t inside = vandq_u64(vandq_u64(vcgeq_f64(sx, zero), vcltq_f64(sx, width)),
+                                            vandq_u64(vcgeq_f64(sy, zero), vcltq_f64(sy, height)));
+
+        for (size_t lane = 0; lane < 2 && i + lane < count; lane++) {
+            uint8_t *pixel = destination + (i + lane) * kBytesPerPixel;
+            const bool isInside = (lane == 0 ? vgetq_lane_u64(inside, 0) : vgetq_lane_u64(inside, 1)) != 0;
+            if (isInside) {
+                const double column = lane == 0 ? vgetq_lane_f64(sx, 0) : vgetq_lane_f64(sx, 1);
+                const double row = lane == 0 ? vgetq_lane_f64(sy, 0) : vgetq_lane_f64(sy, 1);
+                std::memcpy(pixel, source.Pixel(static_cast<size_t>(column), static_cast<size_t>(row)), kBytesPerPixel);
+            } else {
+                std::memset(pixel, 0, kBytesPerPixel);
+            }
+        }
+    }
+}
+
+void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    const ptrdiff_t lastX = static_cast<ptrdiff_t>(source.width) - 1;
+    const ptrdiff_t lastY = static_cast<ptrdiff_t>(source.height) - 1;
+
+    for (size_t i = 0; i < count; i++, destination += kBytesPerPixel) {
+        const double sx = x + stepX * i;
+        const double sy = y + stepY * i;
+        const double x0 = std::floor(sx);
+        const double y0 = std::floor(sy);
+        const ptrdiff_t ix = static_cast<ptrdiff_t>(x0);
+        const ptrdiff_t iy = static_cast<ptrdiff_t>(y0);
+        if (ix < 0 || iy < 0 || ix >= lastX || iy >= lastY) {
+            scalar::WarpRowBilinear(source, sx, sy, 0.0, 0.0, 1, destination);
+            continue;
+        }
+
+        const float fx = static_cast<float>(sx - x0);
+        const float fy = static_cast<float>(sy - y0);
+        const uint8_t *p00 = source.Pixel(static_cast<size_t>(ix), static_cast<size_t>(iy));
+        const uint8_t *p01 = p00 + source.bytesPerRow;
+        float32x4_t value = vmulq_n_f32(LoadPixel(p00), (1.0f - fx) * (1.0f - fy));
+        value = vaddq_f32(value, vmulq_n_f32(LoadPixel(p00 + kBytesPerPixel), fx * (1.0f - fy)));
+        value = vaddq_f32(value, vmulq_n_f32(LoadPixel(p01), (1.0f - fx) * fy));
+        value = vaddq_f32(value, vmulq_n_f32(LoadPixel(p01 + kBytesPerPixel), fx * fy));
+        StoreBilinearPixel(value, destination);
+    }
+}
+
+void WarpRowBicubic(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowSeparable<kBicubicTapCount, kBicubicFirstTap, BicubicWeights, scalar::WarpRowBicubic>(source, x, y, stepX, stepY, count, destination);
+}
+
+void WarpRowLanczos3(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowSeparable<kLanczos3TapCount, kLanczos3FirstTap, Lanczos3Weights, scalar::WarpRowLanczos3>(source, x, y, stepX, stepY, count, destination);
+}
+
+} // namespace neon
+
+} // namespace rsk
+
+#endif
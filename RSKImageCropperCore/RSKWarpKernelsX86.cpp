@@ -0,0 +1,318 @@
+//
+// RSKWarpKernelsX86.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKWarpKernels.hpp"
+
+#if RSK_X86_KERNELS
+
+#include <climits>
+#include <cstring>
+
+#include <immintrin.h>
+
+#define RSK_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define RSK_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace rsk {
+
+namespace {
+
+// SSE4.1 keeps the four components of one pixel in the lanes of a vector.
+
+RSK_TARGET_SSE41 inline __m128 LoadPixel(const uint8_t *pixel)
+{
+    int32_t value;
+    std::memcpy(&value, pixel, kBytesPerPixel);
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(value)));
+}
+
+RSK_TARGET_SSE41 inline void StorePixel(__m128i value, uint8_t *destination)
+{
+    __m128i packed = _mm_packus_epi16(_mm_packus_epi32(value, value), value);
+    int32_t result = _mm_cvtsi128_si32(packed);
+    std::memcpy(destination, &result, kBytesPerPixel);
+}
+
+// Rounds like the scalar bilinear kernel.
+RSK_TARGET_SSE41 inline void StoreBilinearPixel(__m128 value, uint8_t *destination)
+{
+    value = _mm_min_ps(_mm_add_ps(value, _mm_set1_ps(0.5f)), _mm_set1_ps(255.0f));
+    StorePixel(_mm_cvttps_epi32(value), destination);
+}
+
+// Clamps and rounds like the `Alpha` and `Color` of `IntegerComponentTraits`.
+RSK_TARGET_SSE41 inline void StoreFilteredPixel(__m128 value, uint8_t *destination)
+{
+    value = _mm_max_ps(value, _mm_setzero_ps());
+    const float alpha = std::min(_mm_cvtss_f32(_mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3))), 255.0f);
+    const float roundedAlpha = static_cast<float>(static_cast<int>(alpha + 0.5f));
+    const __m128 maximum = _mm_set_ps(255.0f, roundedAlpha, roundedAlpha, roundedAlpha);
+    value = _mm_add_ps(_mm_min_ps(value, maximum), _mm_set1_ps(0.5f));
+    StorePixel(_mm_cvttps_epi32(value), destination);
+}
+
+// Samples with a separable filter, like `scalar::WarpRowSeparable`. Samples whose taps cross the edges of the source
+// fall back to the scalar kernel.
+template <int TapCount, int FirstTap, void (*Weights)(float, float *), WarpRowKernel EdgeKernel>
+RSK_TARGET_SSE41 void WarpRowSeparable(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    const ptrdiff_t width = static_cast<ptrdiff_t>(source.width);
+    const ptrdiff_t height = static_cast<ptrdiff_t>(source.height);
+
+    for (size_t i = 0; i < count; i++, destination += kBytesPerPixel) {
+        const double sx = x + stepX * i;
+        const double sy = y + stepY * i;
+        const double x0 = std::floor(sx);
+        const double y0 = std::floor(sy);
+        const ptrdiff_t tapX = static_cast<ptrdiff_t>(x0) + FirstTap;
+        const ptrdiff_t tapY = static_cast<ptrdiff_t>(y0) + FirstTap;
+        if (tapX < 0 || tapY < 0 || tapX + TapCount > width || tapY + TapCount > height) {
+            EdgeKernel(source, sx, sy, 0.0, 0.0, 1, destination);
+            continue;
+        }
+
+        float weightsX[TapCount];
+        float weightsY[TapCount];
+        Weights(static_cast<float>(sx - x0), weightsX);
+        Weights(static_cast<float>(sy - y0), weightsY);
+
+        __m128 sum = _mm_setzero_ps();
+        for (int row = 0; row < TapCount; row++) {
+            const uint8_t *pixel = source.Pixel(static_cast<size_t>(tapX), static_cast<size_t>(tapY + row));
+            __m128 rowSum = _mm_setzero_ps();
+            for (int column = 0; column < TapCount; column++, pixel += kBytesPerPixel) {
+                rowSum = _mm_add_ps(rowSum, _mm_mul_ps(_mm_set1_ps(weightsX[column]), LoadPixel(pixel)));
+            }
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weightsY[row]), rowSum));
+        }
+        StoreFilteredPixel(sum, destination);
+    }
+}
+
+// The AVX2 kernels gather eight pixels at a time with 32-bit byte offsets, which limits them to sources of less than
+// 2 GB.
+bool HasInt32Offsets(const BitmapView &source)
+{
+    return source.height * source.bytesPerRow + kBytesPerPixel <= static_cast<size_t>(INT_MAX);
+}
+
+// Returns the sample points of the eight pixels of a row starting at `i`, computed like the scalar kernels.
+RSK_TARGET_AVX2 inline void SamplePoints(double start, double step, size_t i, __m256d &low, __m256d &high)
+{
+    const __m256d indices = _mm256_add_pd(_mm256_set1_pd(static_cast<double>(i)), _mm256_set_pd(3.0, 2.0, 1.0, 0.0));
+    low = _mm256_add_pd(_mm256_set1_pd(start), _mm256_mul_pd(_mm256_set1_pd(step), indices));
+    high = _mm256_add_pd(_mm256_set1_pd(start), _mm256_mul_pd(_mm256_set1_pd(step), _mm256_add_pd(indices, _mm256_set1_pd(4.0))));
+}
+
+// Returns all ones in the lanes of `index` that are at least zero and less than `limit`.
+RSK_TARGET_AVX2 inline __m256i IndexInRange(__m256i index, __m256i limit)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi32(index, _mm256_set1_epi32(-1)), _mm256_cmpgt_epi32(limit, index));
+}
+
+// Returns the byte offsets of the pixels at `ix` and `iy`, or zero where `mask` is clear.
+RSK_TARGET_AVX2 inline __m256i PixelOffsets(__m256i ix, __m256i iy, __m256i bytesPerRow, __m256i mask)
+{
+    __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(iy, bytesPerRow), _mm256_slli_epi32(ix, 2));
+    return _mm256_and_si256(offsets, mask);
+}
+
+// Writes `count` of the eight pixels of `value`, which is at most eight.
+RSK_TARGET_AVX2 inline void StorePixels(__m256i value, size_t count, uint8_t *destination)
+{
+    if (count == 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination), value);
+        return;
+    }
+    alignas(32) uint8_t pixels[8 * kBytesPerPixel];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(pixels), value);
+    std::memcpy(destination, pixels, count * kBytesPerPixel);
+}
+
+} // namespace
+
+namespace sse41 {
+
+RSK_TARGET_SSE41 void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    const ptrdiff_t lastX = static_cast<ptrdiff_t>(source.width) - 1;
+    const ptrdiff_t lastY = static_cast<ptrdiff_t>(source.height) - 1;
+
+    for (size_t i = 0; i < count; i++, destination += kBytesPerPixel) {
+        const double sx = x + stepX * i;
+        const double sy = y + stepY * i;
+        const double x0 = std::floor(sx);
+        const double y0 = std::floor(sy);
+        const ptrdiff_t ix = static_cast<ptrdiff_t>(x0);
+        const ptrdiff_t iy = static_cast<ptrdiff_t>(y0);
+        if (ix < 0 || iy < 0 || ix >= lastX || iy >= lastY) {
+            scalar::WarpRowBilinear(source, sx, sy, 0.0, 0.0, 1, destination);
+            continue;
+        }
+
+        const float fx = static_cast<float>(sx - x0);
+        const float fy = static_cast<float>(sy - y0);
+        const __m128 w00 = _mm_set1_ps((1.0f - fx) * (1.0f - fy));
+        const __m128 w10 = _mm_set1_ps(fx * (1.0f - fy));
+        const __m128 w01 = _mm_set1_ps((1.0f - fx) * fy);
+        const __m128 w11 = _mm_set1_ps(fx * fy);
+
+        const uint8_t *p00 = source.Pixel(static_cast<size_t>(ix), static_cast<size_t>(iy));
+        const uint8_t *p01 = p00 + source.bytesPerRow;
+        __m128 value = _mm_mul_ps(w00, LoadPixel(p00));
+        value = _mm_add_ps(value, _mm_mul_ps(w10, LoadPixel(p00 + kBytesPerPixel)));
+        value = _mm_add_ps(value, _mm_mul_ps(w01, LoadPixel(p01)));
+        value = _mm_add_ps(value, _mm_mul_ps(w11, LoadPixel(p01 + kBytesPerPixel)));
+        StoreBilinearPixel(value, destination);
+    }
+}
+
+RSK_TARGET_SSE41 void WarpRowBicubic(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowSeparable<kBicubicTapCount, kBicubicFirstTap, BicubicWeights, scalar::WarpRowBicubic>(source, x, y, stepX, stepY, count, destination);
+}
+
+RSK_TARGET_SSE41 void WarpRowLanczos3(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    WarpRowSeparable<kLanczos3TapCount, kLanczos3FirstTap, Lanczos3Weights, scalar::WarpRowLanczos3>(source, x, y, stepX, stepY, count, destination);
+}
+
+} // namespace sse41
+
+namespace avx2 {
+
+RSK_TARGET_AVX2 void WarpRowNearest(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    if (!HasInt32Offsets(source)) {
+        scalar::WarpRowNearest(source, x, y, stepX, stepY, count, destination);
+        return;
+    }
+
+    const int *data = reinterpret_cast<const int *>(source.data);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256i width = _mm256_set1_epi32(static_cast<int>(source.width));
+    const __m256i height = _mm256_set1_epi32(static_cast<int>(source.height));
+    const __m256i bytesPerRow = _mm256_set1_epi32(static_cast<int>(source.bytesPerRow));
+
+    for (size_t i = 0; i < count; i += 8) {
+        __m256d sxLow, sxHigh, syLow, syHigh;
+        SamplePoints(x, stepX, i, sxLow, sxHigh);
+        SamplePoints(y, stepY, i, syLow, syHigh);
+
+        // Points too far away to fit into 32 bits convert to INT_MIN, which is out of range.
+        const __m256i ix = _mm256_set_m128i(_mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_add_pd(sxHigh, half))),
+                                            _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_add_pd(sxLow, half))));
+        const __m256i iy = _mm256_set_m128i(_mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_add_pd(syHigh, half))),
+                                            _mm256_cvttpd_epi32(_mm256_floor_pd(_mm256_add_pd(syLow, half))));
+
+        const __m256i inside = _mm256_and_si256(IndexInRange(ix, width), IndexInRange(iy, height));
+        const __m256i offsets = PixelOffsets(ix, iy, bytesPerRow, inside);
+        const __m256i pixels = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), data, offsets, inside, 1);
+
+        StorePixels(pixels, std::min<size_t>(8, count - i), destination + i * kBytesPerPixel);
+    }
+}
+
+RSK_TARGET_AVX2 void WarpRowBilinear(const BitmapView &source, double x, double y, double stepX, double stepY, size_t count, uint8_t *destination)
+{
+    if (!HasInt32Offsets(source)) {
+        sse41::WarpRowBilinear(source, x, y, stepX, stepY, count, destination);
+        return;
+    }
+
+    // Eight pixels at a time with their components in separate vectors. The neighbors outside of the source are
+    // masked out of the gathers, so they add nothing, like in the scalar kernel.
+    const int *data = reinterpret_cast<const int *>(source.data);
+    const __m256i width = _mm256_set1_epi32(static_cast<int>(source.width));
+    const __m256i height = _mm256_set1_epi32(static_cast<int>(source.height));
+    const __m256i bytesPerRow = _mm256_set1_epi32(static_cast<int>(source.bytesPerRow));
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i componentMask = _mm256_set1_epi32(0xff);
+    const __m256 oneFloat = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 maximum = _mm256_set1_ps(255.0f);
+
+    for (size_t i = 0; i < count; i += 8) {
+        __m256d sxLow, sxHigh, syLow, syHigh;
+        SamplePoints(x, stepX, i, sxLow, sxHigh);
+        SamplePoints(y, stepY, i, syLow, syHigh);
+
+        const __m256d x0Low = _mm256_floor_pd(sxLow);
+        const __m256d x0High = _mm256_floor_pd(sxHigh);
+        const __m256d y0Low = _mm256_floor_pd(syLow);
+        const __m256d y0High = _mm256_floor_pd(syHigh);
+
+        const __m256 fx = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_sub_pd(sxHigh, x0High)), _mm256_cvtpd_ps(_mm256_sub_pd(sxLow, x0Low)));
+        const __m256 fy = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_sub_pd(syHigh, y0High)), _mm256_cvtpd_ps(_mm256_sub_pd(syLow, y0Low)));
+        const __m256i ix = _mm256_set_m128i(_mm256_cvttpd_epi32(x0High), _mm256_cvttpd_epi32(x0Low));
+        const __m256i iy = _mm256_set_m128i(_mm256_cvttpd_epi32(y0High), _mm256_cvttpd_epi32(y0Low));
+
+        const __m256i insideX0 = IndexInRange(ix, width);
+        const __m256i insideX1 = IndexInRange(_mm256_add_epi32(ix, one), width);
+        const __m256i insideY0 = IndexInRange(iy, height);
+        const __m256i insideY1 = IndexInRange(_mm256_add_epi32(iy, one), height);
+        const __m256i inside00 = _mm256_and_si256(insideX0, insideY0);
+        const __m256i inside10 = _mm256_and_si256(insideX1, insideY0);
+        const __m256i inside01 = _mm256_and_si256(insideX0, insideY1);
+        const __m256i inside11 = _mm256_and_si256(insideX1, insideY1);
+
+        const __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(iy, bytesPerRow), _mm256_slli_epi32(ix, 2));
+        const __m256i right = _mm256_set1_epi32(static_cast<int>(kBytesPerPixel));
+        const __m256i below = bytesPerRow;
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i p00 = _mm256_mask_i32gather_epi32(zero, data, _mm256_and_si256(offsets, inside00), inside00, 1);
+        const __m256i p10 = _mm256_mask_i32gather_epi32(zero, data, _mm256_and_si256(_mm256_add_epi32(offsets, right), inside10), inside10, 1);
+        const __m256i p01 = _mm256_mask_i32gather_epi32(zero, data, _mm256_and_si256(_mm256_add_epi32(offsets, below), inside01), inside01, 1);
+        const __m256i p11 = _mm256_mask_i32gather_epi32(zero, data, _mm256_and_si256(_mm256_add_epi32(_mm256_add_epi32(offsets, below), right), inside11), inside11, 1);
+
+        const __m256 w00 = _mm256_mul_ps(_mm256_sub_ps(oneFloat, fx), _mm256_sub_ps(oneFloat, fy));
+        const __m256 w10 = _mm256_mul_ps(fx, _mm256_sub_ps(oneFloat, fy));
+        const __m256 w01 = _mm256_mul_ps(_mm256_sub_ps(oneFloat, fx), fy);
+        const __m256 w11 = _mm256_mul_ps(fx, fy);
+
+        __m256i result = _mm256_setzero_si256();
+        for (int c = 0; c < static_cast<int>(kBytesPerPixel); c++) {
+            const __m128i shift = _mm_cvtsi32_si128(8 * c);
+            const __m256 c00 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(p00, shift), componentMask));
+            const __m256 c10 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(p10, shift), componentMask));
+            const __m256 c01 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(p01, shift), componentMask));
+            const __m256 c11 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(p11, shift), componentMask));
+
+            __m256 value = _mm256_mul_ps(w00, c00);
+            value = _mm256_add_ps(value, _mm256_mul_ps(w10, c10));
+            value = _mm256_add_ps(value, _mm256_mul_ps(w01, c01));
+            value = _mm256_add_ps(value, _mm256_mul_ps(w11, c11));
+            value = _mm256_min_ps(_mm256_add_ps(value, half), maximum);
+            result = _mm256_or_si256(result, _mm256_sll_epi32(_mm256_cvttps_epi32(value), shift));
+        }
+
+        StorePixels(result, std::min<size_t>(8, count - i), destination + i * kBytesPerPixel);
+    }
+}
+
+} // namespace avx2
+
+} // namespace rsk
+
+#endif
@@ -0,0 +1 @@
+../../RSKAnimatedCrop.h
\ No newline at end of file
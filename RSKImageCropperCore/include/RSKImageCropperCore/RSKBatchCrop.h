@@ -0,0 +1 @@
+../../RSKBatchCrop.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKBitmap.h
\ No newline at end of file
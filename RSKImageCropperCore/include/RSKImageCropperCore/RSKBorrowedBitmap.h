@@ -0,0 +1 @@
+../../RSKBorrowedBitmap.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKBufferPool.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKCoreGraphics.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKCropEngine.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKCropGeometry.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKCropRecipe.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKEncodedImage.h
\ No newline at end of file
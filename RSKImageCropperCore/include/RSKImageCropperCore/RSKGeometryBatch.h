@@ -0,0 +1 @@
+../../RSKGeometryBatch.h
\ No newline at end of file
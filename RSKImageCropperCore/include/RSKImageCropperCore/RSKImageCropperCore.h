@@ -0,0 +1 @@
+../../RSKImageCropperCore.h
\ No newline at end of file
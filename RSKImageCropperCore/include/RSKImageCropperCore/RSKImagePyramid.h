@@ -0,0 +1 @@
+../../RSKImagePyramid.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKImageTiles.h
\ No newline at end of file
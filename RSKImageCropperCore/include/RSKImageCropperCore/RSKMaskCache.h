@@ -0,0 +1 @@
+../../RSKMaskCache.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../RSKThreadPool.h
\ No newline at end of file
@@ -0,0 +1,227 @@
+//
+// RSKAnimatedCropTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKAnimatedCrop.h>
+
+#include "RSKTestImage.hpp"
+
+using rsk::test::CompareImages;
+using rsk::test::TestImage;
+
+namespace {
+
+// Decodes the frames from test images and keeps the written results, like a GIF encoder.
+struct Animation {
+    std::vector<TestImage> frames;
+    std::vector<TestImage> results;
+    std::vector<size_t> writtenIndices;
+
+    // The frame that cannot be decoded and the one that cannot be written, if any.
+    size_t undecodableIndex = SIZE_MAX;
+    size_t unwritableIndex = SIZE_MAX;
+
+    // Frames between the start of their decoding and the end of their writing.
+    std::atomic<int> residentFrameCount{ 0 };
+    std::atomic<int> maximumResidentFrameCount{ 0 };
+    std::atomic<bool> isWriting{ false };
+    std::atomic<bool> wroteConcurrently{ false };
+
+    explicit Animation(size_t frameCount)
+    {
+        // Every frame has its own colors in the middle, so a frame written in place of another one shows.
+        for (size_t i = 0; i < frameCount; i++) {
+            TestImage frame = TestImage::MakePattern(64, 48);
+            for (size_t y = 16; y < 32; y++) {
+                for (size_t x = 16; x < 48; x++) {
+                    uint8_t *pixel = frame.Pixel(x, y);
+                    pixel[0] = static_cast<uint8_t>(i * 5);
+                    pixel[1] = static_cast<uint8_t>(255 - i * 5);
+                    pixel[2] = static_cast<uint8_t>(i);
+                    pixel[3] = 255;
+                }
+            }
+            frames.push_back(std::move(frame));
+        }
+    }
+
+    RSKAnimatedCropCallbacks Callbacks()
+    {
+        RSKAnimatedCropCallbacks callbacks;
+        callbacks.decode = [](void *context, size_t index, RSKBatchImage *frame) {
+            Animation &animation = *static_cast<Animation *>(context);
+            // Uneven decoding times let later frames finish first.
+            std::this_thread::sleep_for(std::chrono::microseconds((index * 7919) % 5 * 200));
+            if (index == animation.undecodableIndex) {
+                return false;
+            }
+            int residentFrameCount = ++animation.residentFrameCount;
+            int maximum = animation.maximumResidentFrameCount;
+            while (residentFrameCount > maximum && !animation.maximumResidentFrameCount.compare_exchange_weak(maximum, residentFrameCount)) {
+            }
+            frame->bitmap = animation.frames[index].Bitmap();
+            return true;
+        };
+        callbacks.write = [](void *context, size_t index, const RSKBitmap *croppedFrame) {
+            Animation &animation = *static_cast<Animation *>(context);
+            if (animation.isWriting.exchange(true)) {
+                animation.wroteConcurrently = true;
+            }
+            animation.residentFrameCount--;
+            bool isWritten = index != animation.unwritableIndex;
+            if (isWritten) {
+                TestImage result(croppedFrame->width, croppedFrame->height);
+                for (size_t y = 0; y < croppedFrame->height; y++) {
+                    std::memcpy(result.Pixel(0, y), static_cast<const uint8_t *>(croppedFrame->data) + y * croppedFrame->bytesPerRow, croppedFrame->width * 4);
+                }
+                animation.results.push_back(std::move(result));
+                animation.writtenIndices.push_back(index);
+            }
+            animation.isWriting = false;
+            return isWritten;
+        };
+        callbacks.context = this;
+        return callbacks;
+    }
+};
+
+RSKCropSpec MakeCircleCropSpec()
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCircle;
+    spec.cropRect = CGRectMake(4, 4, 40, 40);
+    spec.imageRect = CGRectMake(0, 0, 64, 48);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.applyMaskToCroppedImage = true;
+    return spec;
+}
+
+TestImage Crop(TestImage &source, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+std::vector<size_t> Indices(size_t count)
+{
+    std::vector<size_t> indices(count);
+    for (size_t i = 0; i < count; i++) {
+        indices[i] = i;
+    }
+    return indices;
+}
+
+} // namespace
+
+TEST(RSKAnimatedCrop, WritesFramesInOrderLikeCroppingEachAlone)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(4);
+    ASSERT_NE(pool, nullptr);
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+    const RSKCropSpec spec = MakeCircleCropSpec();
+
+    for (const RSKExecutor *frameExecutor : { static_cast<const RSKExecutor *>(nullptr), static_cast<const RSKExecutor *>(&executor) }) {
+        Animation animation(37);
+        RSKAnimatedCropCallbacks callbacks = animation.Callbacks();
+        RSKAnimatedCropOptions options = {};
+        options.executor = frameExecutor;
+        EXPECT_EQ(RSKCropEngineCropAnimated(animation.frames.size(), &spec, &callbacks, &options), RSKCropStatusSuccess);
+
+        EXPECT_EQ(animation.writtenIndices, Indices(animation.frames.size()));
+        EXPECT_FALSE(animation.wroteConcurrently);
+        for (size_t i = 0; i < animation.results.size(); i++) {
+            EXPECT_EQ(CompareImages(animation.results[i], Crop(animation.frames[i], spec)).maximumColorDifference, 0) << "at " << i;
+        }
+    }
+
+    RSKThreadPoolDestroy(pool);
+}
+
+TEST(RSKAnimatedCrop, KeepsAtMostResidentFramesInMemory)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(4);
+    ASSERT_NE(pool, nullptr);
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+    const RSKCropSpec spec = MakeCircleCropSpec();
+
+    for (size_t residentFrameCount : { 1, 3, 6 }) {
+        Animation animation(40);
+        RSKAnimatedCropCallbacks callbacks = animation.Callbacks();
+        RSKAnimatedCropOptions options = {};
+        options.residentFrameCount = residentFrameCount;
+        options.executor = &executor;
+        EXPECT_EQ(RSKCropEngineCropAnimated(animation.frames.size(), &spec, &callbacks, &options), RSKCropStatusSuccess);
+
+        EXPECT_EQ(animation.writtenIndices, Indices(animation.frames.size()));
+        EXPECT_LE(animation.maximumResidentFrameCount, static_cast<int>(residentFrameCount));
+    }
+
+    RSKThreadPoolDestroy(pool);
+}
+
+TEST(RSKAnimatedCrop, StopsAtFirstFrameThatFails)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(4);
+    ASSERT_NE(pool, nullptr);
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+    const RSKCropSpec spec = MakeCircleCropSpec();
+    RSKAnimatedCropOptions options = {};
+    options.executor = &executor;
+
+    Animation undecodableAnimation(20);
+    undecodableAnimation.undecodableIndex = 7;
+    RSKAnimatedCropCallbacks callbacks = undecodableAnimation.Callbacks();
+    EXPECT_EQ(RSKCropEngineCropAnimated(undecodableAnimation.frames.size(), &spec, &callbacks, &options), RSKCropStatusReadFailed);
+    EXPECT_EQ(undecodableAnimation.writtenIndices, Indices(7));
+
+    Animation unwritableAnimation(20);
+    unwritableAnimation.unwritableIndex = 12;
+    callbacks = unwritableAnimation.Callbacks();
+    EXPECT_EQ(RSKCropEngineCropAnimated(unwritableAnimation.frames.size(), &spec, &callbacks, &options), RSKCropStatusWriteFailed);
+    EXPECT_EQ(unwritableAnimation.writtenIndices, Indices(12));
+
+    RSKThreadPoolDestroy(pool);
+}
+
+TEST(RSKAnimatedCrop, RejectsMissingCallbacks)
+{
+    const RSKCropSpec spec = MakeCircleCropSpec();
+    RSKAnimatedCropCallbacks callbacks = {};
+    EXPECT_EQ(RSKCropEngineCropAnimated(1, &spec, &callbacks, nullptr), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKCropEngineCropAnimated(1, nullptr, &callbacks, nullptr), RSKCropStatusInvalidArgument);
+}
@@ -0,0 +1,251 @@
+//
+// RSKBatchCropTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKBatchCrop.h>
+
+#include "RSKTestAllocations.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::test::AllocationFailure;
+using rsk::test::CompareImages;
+using rsk::test::ImageDifference;
+using rsk::test::TestImage;
+
+namespace {
+
+// Decodes the sources from test images and keeps the encoded results, like a backend that crops renditions.
+struct Batch {
+    std::vector<TestImage> sources;
+    std::vector<TestImage> results;
+    std::vector<RSKCropStatus> statuses;
+    std::mutex mutex;
+
+    // The source that cannot be decoded and the one whose result cannot be encoded, if any.
+    size_t undecodableIndex = SIZE_MAX;
+    size_t unencodableIndex = SIZE_MAX;
+    std::chrono::milliseconds encodeDuration{ 0 };
+
+    std::atomic<int> decodedImageCount{ 0 };
+    std::atomic<int> maximumDecodedImageCount{ 0 };
+    std::atomic<int> completionCount{ 0 };
+
+    explicit Batch(std::vector<TestImage> sources)
+        : sources(std::move(sources)), results(this->sources.size()), statuses(this->sources.size(), RSKCropStatusInvalidArgument)
+    {
+    }
+
+    RSKBatchCallbacks Callbacks()
+    {
+        RSKBatchCallbacks callbacks;
+        callbacks.decode = [](void *context, size_t index, RSKBatchImage *image) {
+            Batch &batch = *static_cast<Batch *>(context);
+            if (index == batch.undecodableIndex) {
+                return false;
+            }
+            int decodedImageCount = ++batch.decodedImageCount;
+            int maximum = batch.maximumDecodedImageCount;
+            while (decodedImageCount > maximum && !batch.maximumDecodedImageCount.compare_exchange_weak(maximum, decodedImageCount)) {
+            }
+
+            image->bitmap = batch.sources[index].Bitmap();
+            image->release = [](void *releaseContext, const RSKBitmap *) {
+                static_cast<Batch *>(releaseContext)->decodedImageCount--;
+            };
+            image->releaseContext = &batch;
+            return true;
+        };
+        callbacks.encode = [](void *context, size_t index, const RSKBitmap *croppedImage) {
+            Batch &batch = *static_cast<Batch *>(context);
+            std::this_thread::sleep_for(batch.encodeDuration);
+            if (index == batch.unencodableIndex) {
+                return false;
+            }
+            TestImage result(croppedImage->width, croppedImage->height);
+            for (size_t y = 0; y < croppedImage->height; y++) {
+                std::memcpy(result.Pixel(0, y), static_cast<const uint8_t *>(croppedImage->data) + y * croppedImage->bytesPerRow, croppedImage->width * 4);
+            }
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            batch.results[index] = std::move(result);
+            return true;
+        };
+        callbacks.complete = [](void *context, size_t index, RSKCropStatus status) {
+            Batch &batch = *static_cast<Batch *>(context);
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            batch.statuses[index] = status;
+            batch.completionCount++;
+        };
+        callbacks.context = this;
+        return callbacks;
+    }
+};
+
+RSKCropSpec MakeRotatedCropSpec(size_t width, size_t height)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.cropRect = CGRectMake(0, 0, width / 2, height / 2);
+    spec.imageRect = CGRectMake(width / 4, height / 4, width / 2, height / 2);
+    spec.rotationAngle = 0.4;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationRight;
+    return spec;
+}
+
+TestImage Crop(TestImage &source, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+} // namespace
+
+TEST(RSKBatchCrop, CropsEverySourceLikeCroppingItAlone)
+{
+    std::vector<TestImage> sources;
+    for (size_t i = 0; i < 24; i++) {
+        sources.push_back(TestImage::MakePattern(64 + i, 48 + i));
+    }
+    Batch batch(sources);
+    RSKCropSpec spec = MakeRotatedCropSpec(64, 48);
+
+    RSKThreadPool *pool = RSKThreadPoolCreate(3);
+    ASSERT_NE(pool, nullptr);
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+
+    RSKBatchCallbacks callbacks = batch.Callbacks();
+    RSKBatchOptions options = {};
+    options.queueCapacity = 2;
+    options.decodeThreadCount = 2;
+    options.encodeThreadCount = 2;
+    options.executor = &executor;
+    EXPECT_EQ(RSKCropEngineCropBatch(sources.size(), &spec, &callbacks, &options), RSKCropStatusSuccess);
+    RSKThreadPoolDestroy(pool);
+
+    EXPECT_EQ(batch.completionCount, 24);
+    EXPECT_EQ(batch.decodedImageCount, 0);
+    for (size_t i = 0; i < sources.size(); i++) {
+        EXPECT_EQ(batch.statuses[i], RSKCropStatusSuccess) << i;
+        ImageDifference difference = CompareImages(batch.results[i], Crop(sources[i], spec));
+        EXPECT_EQ(difference.maximumColorDifference, 0) << i;
+        EXPECT_EQ(difference.maximumAlphaDifference, 0) << i;
+    }
+}
+
+TEST(RSKBatchCrop, ScalesCropSpecToEverySource)
+{
+    // The spec was made for a 64 x 48 source; the second source is a rendition at twice the size.
+    std::vector<TestImage> sources = { TestImage::MakePattern(64, 48), TestImage::MakePattern(128, 96) };
+    Batch batch(sources);
+    RSKCropSpec spec = MakeRotatedCropSpec(64, 48);
+
+    RSKBatchCallbacks callbacks = batch.Callbacks();
+    RSKBatchOptions options = {};
+    options.referenceSize = CGSizeMake(64, 48);
+    EXPECT_EQ(RSKCropEngineCropBatch(sources.size(), &spec, &callbacks, &options), RSKCropStatusSuccess);
+
+    RSKCropSpec renditionSpec = MakeRotatedCropSpec(128, 96);
+    renditionSpec.zoomScale = 0.5;
+    ASSERT_EQ(batch.results[1].Width(), batch.results[0].Width() * 2);
+    ASSERT_EQ(batch.results[1].Height(), batch.results[0].Height() * 2);
+    EXPECT_EQ(CompareImages(batch.results[0], Crop(sources[0], spec)).maximumColorDifference, 0);
+    EXPECT_EQ(CompareImages(batch.results[1], Crop(sources[1], renditionSpec)).maximumColorDifference, 0);
+}
+
+TEST(RSKBatchCrop, ReportsSourcesThatCannotBeDecodedOrEncoded)
+{
+    std::vector<TestImage> sources(5, TestImage::MakePattern(32, 32));
+    Batch batch(sources);
+    batch.undecodableIndex = 1;
+    batch.unencodableIndex = 3;
+    RSKCropSpec spec = MakeRotatedCropSpec(32, 32);
+
+    RSKBatchCallbacks callbacks = batch.Callbacks();
+    EXPECT_EQ(RSKCropEngineCropBatch(sources.size(), &spec, &callbacks, nullptr), RSKCropStatusSuccess);
+
+    const RSKCropStatus expectedStatuses[] = { RSKCropStatusSuccess, RSKCropStatusReadFailed, RSKCropStatusSuccess, RSKCropStatusWriteFailed, RSKCropStatusSuccess };
+    for (size_t i = 0; i < sources.size(); i++) {
+        EXPECT_EQ(batch.statuses[i], expectedStatuses[i]) << i;
+    }
+    EXPECT_EQ(batch.decodedImageCount, 0);
+
+    callbacks.encode = nullptr;
+    EXPECT_EQ(RSKCropEngineCropBatch(sources.size(), &spec, &callbacks, nullptr), RSKCropStatusInvalidArgument);
+}
+
+TEST(RSKBatchCrop, ReportsSourcesThatRunOutOfMemory)
+{
+    // The results of the large sources take 64 KB each, which cannot be allocated, while the small ones take 1 KB.
+    std::vector<TestImage> sources;
+    for (size_t i = 0; i < 6; i++) {
+        sources.push_back(i % 2 == 0 ? TestImage::MakePattern(32, 32) : TestImage::MakePattern(256, 256));
+    }
+    Batch batch(sources);
+    RSKCropSpec spec = MakeRotatedCropSpec(32, 32);
+
+    RSKBatchCallbacks callbacks = batch.Callbacks();
+    RSKBatchOptions options = {};
+    options.referenceSize = CGSizeMake(32, 32);
+    {
+        AllocationFailure failure(32 * 1024);
+        EXPECT_EQ(RSKCropEngineCropBatch(sources.size(), &spec, &callbacks, &options), RSKCropStatusSuccess);
+    }
+
+    EXPECT_EQ(batch.completionCount, 6);
+    EXPECT_EQ(batch.decodedImageCount, 0);
+    for (size_t i = 0; i < sources.size(); i++) {
+        EXPECT_EQ(batch.statuses[i], i % 2 == 0 ? RSKCropStatusSuccess : RSKCropStatusOutOfMemory) << i;
+    }
+    EXPECT_EQ(CompareImages(batch.results[0], Crop(sources[0], spec)).maximumColorDifference, 0);
+}
+
+TEST(RSKBatchCrop, KeepsFewImagesInMemoryWhenEncodingIsSlow)
+{
+    std::vector<TestImage> sources(16, TestImage::MakePattern(32, 32));
+    Batch batch(sources);
+    batch.encodeDuration = std::chrono::milliseconds(2);
+    RSKCropSpec spec = MakeRotatedCropSpec(32, 32);
+
+    RSKBatchCallbacks callbacks = batch.Callbacks();
+    RSKBatchOptions options = {};
+    options.queueCapacity = 2;
+    EXPECT_EQ(RSKCropEngineCropBatch(sources.size(), &spec, &callbacks, &options), RSKCropStatusSuccess);
+
+    // One image being decoded, the ones waiting to be cropped and the one being cropped.
+    EXPECT_LE(batch.maximumDecodedImageCount, 1 + 2 + 1);
+    EXPECT_EQ(batch.completionCount, 16);
+}
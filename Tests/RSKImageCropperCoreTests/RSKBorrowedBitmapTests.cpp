@@ -0,0 +1,173 @@
+//
+// RSKBorrowedBitmapTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKBorrowedBitmap.h>
+
+#include "RSKTestAllocations.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::test::AllocationCounter;
+using rsk::test::TestImage;
+
+namespace {
+
+// Counts how many times the pixels of a test are released.
+void CountRelease(void *context)
+{
+    ++*static_cast<int *>(context);
+}
+
+RSKCropSpec MakeCropSpec(CGRect imageRect)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.imageRect = imageRect;
+    spec.cropRect = CGRectMake(0, 0, imageRect.size.width, imageRect.size.height);
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    return spec;
+}
+
+} // namespace
+
+TEST(RSKBorrowedBitmap, CropsSubviewWithoutCopyingPixels)
+{
+    TestImage image = TestImage::MakePattern(2000, 1500);
+    int releaseCount = 0;
+    RSKPixelOwner *owner = RSKPixelOwnerCreate(&releaseCount, CountRelease);
+    RSKBorrowedBitmap source = RSKBorrowedBitmapMake(image.Bitmap(), owner);
+    RSKPixelOwnerRelease(owner);
+
+    // The result of a square crop without rotation points into the pixels of the source, and allocating it takes no
+    // memory at all, let alone memory proportional to the size of the image.
+    const RSKCropSpec spec = MakeCropSpec(CGRectMake(100, 50, 800, 600));
+    RSKBorrowedBitmap result = {};
+    size_t allocatedBytes = 0;
+    {
+        AllocationCounter counter;
+        ASSERT_EQ(RSKCropEngineCropBorrowedBitmap(&source, &spec, nullptr, &result), RSKCropStatusSuccess);
+        allocatedBytes = counter.AllocatedBytes();
+    }
+    EXPECT_EQ(allocatedBytes, 0u);
+    EXPECT_EQ(result.bitmap.data, image.Pixel(100, 50));
+    EXPECT_EQ(result.bitmap.width, 800u);
+    EXPECT_EQ(result.bitmap.height, 600u);
+    EXPECT_EQ(result.bitmap.bytesPerRow, source.bitmap.bytesPerRow);
+    EXPECT_EQ(result.owner, source.owner);
+
+    // The result keeps the pixels alive after the source lets go of them.
+    RSKBorrowedBitmapRelease(&source);
+    EXPECT_EQ(releaseCount, 0);
+    RSKBorrowedBitmapRelease(&result);
+    EXPECT_EQ(releaseCount, 1);
+    EXPECT_EQ(result.owner, nullptr);
+}
+
+TEST(RSKBorrowedBitmap, CopiesCropsThatMovePixels)
+{
+    TestImage image = TestImage::MakePattern(120, 90);
+    RSKBorrowedBitmap source = RSKBorrowedBitmapMake(image.Bitmap(), nullptr);
+
+    RSKCropSpec spec = MakeCropSpec(CGRectMake(10, 20, 60, 40));
+    spec.imageOrientation = RSKImageOrientationUpMirrored;
+    EXPECT_FALSE(RSKCropEngineGetSubviewRect(120, 90, &spec, nullptr));
+
+    RSKBorrowedBitmap result = {};
+    ASSERT_EQ(RSKCropEngineCropBorrowedBitmap(&source, &spec, nullptr, &result), RSKCropStatusSuccess);
+    ASSERT_NE(result.owner, nullptr);
+    TestImage expected(60, 40);
+    RSKBitmap sourceBitmap = image.Bitmap();
+    RSKBitmap expectedBitmap = expected.Bitmap();
+    ASSERT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &expectedBitmap), RSKCropStatusSuccess);
+    for (size_t y = 0; y < 40; y++) {
+        const uint8_t *row = static_cast<const uint8_t *>(result.bitmap.data) + y * result.bitmap.bytesPerRow;
+        ASSERT_EQ(std::memcmp(row, expected.Pixel(0, y), 60 * 4), 0) << y;
+    }
+    RSKBorrowedBitmapRelease(&result);
+
+    // Only crops that select the pixels as they are have a subview rect.
+    CGRect rect = CGRectZero;
+    spec.imageOrientation = RSKImageOrientationUp;
+    EXPECT_TRUE(RSKCropEngineGetSubviewRect(120, 90, &spec, &rect));
+    EXPECT_TRUE(CGRectEqualToRect(rect, CGRectMake(10, 20, 60, 40)));
+    spec.rotationAngle = M_PI_2;
+    spec.cropRect = CGRectMake(0, 0, 40, 60);
+    EXPECT_FALSE(RSKCropEngineGetSubviewRect(120, 90, &spec, &rect));
+    spec.rotationAngle = 2 * M_PI;
+    spec.cropRect = CGRectMake(0, 0, 60, 40);
+    EXPECT_TRUE(RSKCropEngineGetSubviewRect(120, 90, &spec, &rect));
+}
+
+TEST(RSKBorrowedBitmap, MapsRawPixelsOfFile)
+{
+    // A file of 4 MB of pixels behind a header of 64 bytes.
+    const size_t width = 1024;
+    const size_t height = 1024;
+    const size_t headerLength = 64;
+    TestImage image = TestImage::MakePattern(width, height);
+    const std::string path = testing::TempDir() + "RSKBorrowedBitmapTests.raw";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(std::string(headerLength, '\0').data(), headerLength);
+        file.write(reinterpret_cast<const char *>(image.Pixel(0, 0)), static_cast<std::streamsize>(width * height * 4));
+    }
+
+    // Neither mapping the file nor cropping it allocates memory for its pixels.
+    RSKBorrowedBitmap source = {};
+    RSKBorrowedBitmap result = {};
+    const RSKCropSpec spec = MakeCropSpec(CGRectMake(256, 512, 300, 200));
+    size_t allocatedBytes = 0;
+    {
+        AllocationCounter counter;
+        ASSERT_EQ(RSKBorrowedBitmapMapFile(path.c_str(), headerLength, width, height, width * 4, RSKPixelFormatRGBA8888, &source), RSKCropStatusSuccess);
+        ASSERT_EQ(RSKCropEngineCropBorrowedBitmap(&source, &spec, nullptr, &result), RSKCropStatusSuccess);
+        allocatedBytes = counter.AllocatedBytes();
+    }
+    EXPECT_LT(allocatedBytes, 1024u);
+    for (size_t y = 0; y < 200; y++) {
+        const uint8_t *row = static_cast<const uint8_t *>(result.bitmap.data) + y * result.bitmap.bytesPerRow;
+        ASSERT_EQ(std::memcmp(row, image.Pixel(256, 512 + y), 300 * 4), 0) << y;
+    }
+
+    // The mapping outlives the source as long as the result needs it.
+    RSKBorrowedBitmapRelease(&source);
+    EXPECT_EQ(std::memcmp(result.bitmap.data, image.Pixel(256, 512), 4), 0);
+    RSKBorrowedBitmapRelease(&result);
+
+    EXPECT_EQ(RSKBorrowedBitmapMapFile(path.c_str(), headerLength + 1, width, height, width * 4, RSKPixelFormatRGBA8888, &source), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKBorrowedBitmapMapFile(path.c_str(), SIZE_MAX, width, height, width * 4, RSKPixelFormatRGBA8888, &source), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKBorrowedBitmapMapFile(path.c_str(), headerLength, width, height, width * 3, RSKPixelFormatRGBA8888, &source), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(source.owner, nullptr);
+    std::remove(path.c_str());
+    EXPECT_EQ(RSKBorrowedBitmapMapFile(path.c_str(), headerLength, width, height, width * 4, RSKPixelFormatRGBA8888, &source), RSKCropStatusReadFailed);
+}
@@ -0,0 +1,180 @@
+//
+// RSKBufferPoolTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKBufferPool.h>
+
+#include "RSKBufferPool.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::test::TestImage;
+
+TEST(RSKBufferPool, ReusesBuffersOfTheSameSizeClass)
+{
+    rsk::BufferPool pool(0);
+    {
+        rsk::PooledBuffer buffer(pool, 5000);
+        EXPECT_EQ(buffer.Size(), 5000u);
+        std::memset(buffer.Data(), 0xFF, buffer.Size());
+    }
+    RSKBufferPoolStats stats = pool.Stats();
+    EXPECT_EQ(stats.hitCount, 0u);
+    EXPECT_EQ(stats.missCount, 1u);
+    EXPECT_EQ(stats.residentBytes, 5120u);
+    EXPECT_EQ(stats.idleBytes, 5120u);
+
+    // A size of the same class takes the idle buffer, any other size allocates one.
+    {
+        rsk::PooledBuffer buffer(pool, 4500);
+        rsk::PooledBuffer otherBuffer(pool, 4000);
+        stats = pool.Stats();
+        EXPECT_EQ(stats.hitCount, 1u);
+        EXPECT_EQ(stats.missCount, 2u);
+        EXPECT_EQ(stats.residentBytes, 5120u + 4096u);
+        EXPECT_EQ(stats.idleBytes, 0u);
+    }
+    EXPECT_EQ(pool.Stats().idleBytes, 5120u + 4096u);
+}
+
+TEST(RSKBufferPool, KeepsIdleBuffersUpToTheHighWaterMark)
+{
+    rsk::BufferPool pool(8192);
+    {
+        rsk::PooledBuffer buffer(pool, 5000);
+        rsk::PooledBuffer otherBuffer(pool, 5000);
+    }
+    RSKBufferPoolStats stats = pool.Stats();
+    EXPECT_EQ(stats.residentBytes, 5120u);
+    EXPECT_EQ(stats.idleBytes, 5120u);
+
+    // Without a high-water mark every buffer is freed once it is returned.
+    pool.SetHighWaterMark(0);
+    EXPECT_EQ(pool.Stats().residentBytes, 0u);
+    {
+        rsk::PooledBuffer buffer(pool, 5000);
+    }
+    stats = pool.Stats();
+    EXPECT_EQ(stats.missCount, 3u);
+    EXPECT_EQ(stats.residentBytes, 0u);
+}
+
+TEST(RSKBufferPool, TrimsTheLargestBuffersFirst)
+{
+    RSKBufferPool *pool = RSKBufferPoolCreate(0);
+    ASSERT_NE(pool, nullptr);
+    std::vector<RSKBorrowedBitmap> bitmaps(3);
+    ASSERT_EQ(RSKBufferPoolMakeBitmap(pool, 10, 10, RSKPixelFormatRGBA8888, &bitmaps[0]), RSKCropStatusSuccess);
+    ASSERT_EQ(RSKBufferPoolMakeBitmap(pool, 50, 50, RSKPixelFormatRGBA8888, &bitmaps[1]), RSKCropStatusSuccess);
+    ASSERT_EQ(RSKBufferPoolMakeBitmap(pool, 200, 200, RSKPixelFormatRGBA8888, &bitmaps[2]), RSKCropStatusSuccess);
+    for (RSKBorrowedBitmap &bitmap : bitmaps) {
+        RSKBorrowedBitmapRelease(&bitmap);
+    }
+    const RSKBufferPoolStats stats = RSKBufferPoolGetStats(pool);
+    EXPECT_EQ(stats.missCount, 3u);
+    EXPECT_EQ(stats.idleBytes, stats.residentBytes);
+    EXPECT_GT(stats.idleBytes, 160000u);
+
+    // The 4 KB buffer of the smallest bitmap and the 10 KB one of the next are kept.
+    RSKBufferPoolTrim(pool, 20000);
+    EXPECT_EQ(RSKBufferPoolGetStats(pool).idleBytes, 4096u + 10240u);
+    RSKBufferPoolTrim(pool, 0);
+    EXPECT_EQ(RSKBufferPoolGetStats(pool).residentBytes, 0u);
+    RSKBufferPoolDestroy(pool);
+}
+
+TEST(RSKBufferPool, ReturnsBitmapsOnceTheirOwnerIsReleased)
+{
+    RSKBufferPool *pool = RSKBufferPoolCreate(0);
+    ASSERT_NE(pool, nullptr);
+    RSKBorrowedBitmap bitmap;
+    ASSERT_EQ(RSKBufferPoolMakeBitmap(pool, 64, 48, RSKPixelFormatBGRA8888, &bitmap), RSKCropStatusSuccess);
+    EXPECT_EQ(bitmap.bitmap.width, 64u);
+    EXPECT_EQ(bitmap.bitmap.height, 48u);
+    EXPECT_EQ(bitmap.bitmap.bytesPerRow, 64u * 4);
+    EXPECT_EQ(bitmap.bitmap.pixelFormat, RSKPixelFormatBGRA8888);
+    std::memset(bitmap.bitmap.data, 0xFF, bitmap.bitmap.bytesPerRow * bitmap.bitmap.height);
+
+    RSKPixelOwner *owner = RSKPixelOwnerRetain(bitmap.owner);
+    RSKBorrowedBitmapRelease(&bitmap);
+    EXPECT_EQ(RSKBufferPoolGetStats(pool).idleBytes, 0u);
+    RSKPixelOwnerRelease(owner);
+    EXPECT_GT(RSKBufferPoolGetStats(pool).idleBytes, 64u * 48 * 4);
+
+    ASSERT_EQ(RSKBufferPoolMakeBitmap(pool, 48, 64, RSKPixelFormatRGBA8888, &bitmap), RSKCropStatusSuccess);
+    EXPECT_EQ(RSKBufferPoolGetStats(pool).hitCount, 1u);
+    RSKBorrowedBitmapRelease(&bitmap);
+
+    EXPECT_EQ(RSKBufferPoolMakeBitmap(pool, 0, 64, RSKPixelFormatRGBA8888, &bitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKBufferPoolMakeBitmap(nullptr, 48, 64, RSKPixelFormatRGBA8888, &bitmap), RSKCropStatusInvalidArgument);
+    RSKBufferPoolDestroy(pool);
+}
+
+TEST(RSKBufferPool, CropsWithoutAllocatingOnceThePoolIsWarm)
+{
+    TestImage source = TestImage::MakePattern(300, 200);
+    RSKBitmap sourceBitmap = source.Bitmap();
+    const RSKPathElement maskPath[] = {
+        { RSKPathElementTypeMoveToPoint, { { 50, 0 } } },
+        { RSKPathElementTypeAddLineToPoint, { { 100, 100 } } },
+        { RSKPathElementTypeAddLineToPoint, { { 0, 100 } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+
+    // A rotated, masked crop that is scaled down by more than half uses every scratch buffer of the engine.
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCustom;
+    spec.cropRect = CGRectMake(0, 0, 100, 100);
+    spec.imageRect = CGRectMake(0, 0, 300, 200);
+    spec.rotationAngle = 0.3;
+    spec.zoomScale = 0.3;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.maskPath = { maskPath, 4, false };
+    spec.applyMaskToCroppedImage = true;
+
+    RSKBufferPool *pool = RSKBufferPoolGetShared();
+    std::vector<TestImage> results;
+    std::vector<RSKBufferPoolStats> stats;
+    for (int i = 0; i < 3; i++) {
+        RSKBorrowedBitmap result;
+        ASSERT_EQ(RSKBufferPoolMakeBitmap(pool, 100, 100, RSKPixelFormatRGBA8888, &result), RSKCropStatusSuccess);
+        // The pixels of a pooled bitmap are not cleared, so dirty them to show that the crop writes all of them.
+        std::memset(result.bitmap.data, i * 100, result.bitmap.bytesPerRow * result.bitmap.height);
+        ASSERT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &result.bitmap), RSKCropStatusSuccess);
+        TestImage image(100, 100);
+        std::memcpy(image.Pixel(0, 0), result.bitmap.data, result.bitmap.bytesPerRow * result.bitmap.height);
+        results.push_back(image);
+        RSKBorrowedBitmapRelease(&result);
+        stats.push_back(RSKBufferPoolGetStats(pool));
+    }
+
+    EXPECT_GT(stats[1].hitCount, stats[0].hitCount + 1);
+    EXPECT_EQ(stats[1].missCount, stats[0].missCount);
+    EXPECT_EQ(stats[2].missCount, stats[0].missCount);
+    EXPECT_EQ(std::memcmp(results[0].Pixel(0, 0), results[1].Pixel(0, 0), 100 * 100 * 4), 0);
+    EXPECT_EQ(std::memcmp(results[0].Pixel(0, 0), results[2].Pixel(0, 0), 100 * 100 * 4), 0);
+}
@@ -0,0 +1,865 @@
+//
+// RSKCropEngineTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKCropEngine.h>
+
+#include "RSKCropEngine.hpp"
+#include "RSKImageTransforms.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::test::CompareImages;
+using rsk::test::ImageDifference;
+using rsk::test::ReferenceImagePath;
+using rsk::test::TestImage;
+
+namespace {
+
+#if RSK_HAS_LIBPNG
+
+const char *const kSpec = "RSKImageCropViewControllerSpec";
+
+TestImage LoadReferenceImage(const std::string &name)
+{
+    TestImage image = TestImage::LoadPNG(ReferenceImagePath(kSpec, name));
+    EXPECT_FALSE(image.IsEmpty()) << name;
+    return image;
+}
+
+#endif
+
+// Returns a spec that crops the whole of a `width` x `height` source.
+RSKCropSpec MakeCropSpec(RSKCropMode cropMode, size_t width, size_t height)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = cropMode;
+    spec.cropRect = CGRectMake(0, 0, width, height);
+    spec.imageRect = CGRectMake(0, 0, width, height);
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    return spec;
+}
+
+// Like `+[UIBezierPath bezierPathWithOvalInRect:]`.
+std::vector<RSKPathElement> MakeOvalPath(CGRect rect)
+{
+    const CGFloat kappa = 0.5522847498;
+    CGFloat minX = CGRectGetMinX(rect), midX = CGRectGetMidX(rect), maxX = CGRectGetMaxX(rect);
+    CGFloat minY = CGRectGetMinY(rect), midY = CGRectGetMidY(rect), maxY = CGRectGetMaxY(rect);
+    CGFloat ox = CGRectGetWidth(rect) * 0.5 * kappa;
+    CGFloat oy = CGRectGetHeight(rect) * 0.5 * kappa;
+
+    return {
+        { RSKPathElementTypeMoveToPoint, { { maxX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { maxX, midY + oy }, { midX + ox, maxY }, { midX, maxY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - ox, maxY }, { minX, midY + oy }, { minX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { minX, midY - oy }, { midX - ox, minY }, { midX, minY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + ox, minY }, { maxX, midY - oy }, { maxX, midY } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// Like the triangle of the custom mask of the snapshot tests.
+std::vector<RSKPathElement> MakeTrianglePath(CGRect rect)
+{
+    return {
+        { RSKPathElementTypeMoveToPoint, { { CGRectGetMinX(rect), CGRectGetMaxY(rect) } } },
+        { RSKPathElementTypeAddLineToPoint, { { CGRectGetMaxX(rect), CGRectGetMaxY(rect) } } },
+        { RSKPathElementTypeAddLineToPoint, { { CGRectGetMidX(rect), CGRectGetMinY(rect) } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+TestImage Crop(TestImage &source, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    if (result.IsEmpty()) {
+        ADD_FAILURE() << "The crop does not produce any pixels.";
+        return result;
+    }
+
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+bool ReadTestImage(void *context, size_t x, size_t y, const RSKBitmap *destination)
+{
+    const TestImage &image = *static_cast<const TestImage *>(context);
+    for (size_t row = 0; row < destination->height; row++) {
+        std::memcpy(static_cast<uint8_t *>(destination->data) + row * destination->bytesPerRow, image.Pixel(x, y + row), destination->width * 4);
+    }
+    return true;
+}
+
+bool WriteTestImage(void *context, size_t x, size_t y, const RSKBitmap *tile)
+{
+    TestImage &image = *static_cast<TestImage *>(context);
+    for (size_t row = 0; row < tile->height; row++) {
+        std::memcpy(image.Pixel(x, y + row), static_cast<const uint8_t *>(tile->data) + row * tile->bytesPerRow, tile->width * 4);
+    }
+    return true;
+}
+
+TestImage CropConcurrently(TestImage &source, const RSKCropSpec &spec, const RSKExecutor *executor)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmapWithExecutor(&sourceBitmap, &spec, executor, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+TestImage CropTiled(const TestImage &source, const RSKCropSpec &spec, size_t tileSize, const RSKExecutor *executor = nullptr)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+
+    RSKTiledSource tiledSource = { source.Width(), source.Height(), RSKPixelFormatRGBA8888, ReadTestImage, const_cast<TestImage *>(&source) };
+    RSKTiledDestination tiledDestination = { WriteTestImage, &result };
+    RSKTilingOptions options = { tileSize, 0, executor };
+    EXPECT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &tiledDestination), RSKCropStatusSuccess);
+    return result;
+}
+
+} // namespace
+
+#if RSK_HAS_LIBPNG
+
+// The reference images of the orientations crop the same part of the photo as the reference image of the circle mode,
+// so cropping that reference image with an orientation has to reproduce them.
+
+TEST(RSKCropEngine, MatchesReferenceImageOfUpMirroredOrientation)
+{
+    TestImage source = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeCircle_correctly_crop_the_image_when_all_properties_are_default");
+    TestImage reference = LoadReferenceImage("crop_image_crop_image_with_any_image_orientation_UIImageOrientationUpMirrored");
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, source.Width(), source.Height());
+    spec.imageOrientation = RSKImageOrientationUpMirrored;
+
+    ImageDifference difference = CompareImages(Crop(source, spec), reference);
+    EXPECT_EQ(difference.maximumColorDifference, 0);
+    EXPECT_EQ(difference.maximumAlphaDifference, 0);
+}
+
+TEST(RSKCropEngine, MatchesReferenceImagesOfDownOrientations)
+{
+    // The image rects of these orientations are flipped inside of the photo, which moves them by less than a pixel.
+    TestImage source = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeCircle_correctly_crop_the_image_when_all_properties_are_default");
+
+    for (RSKImageOrientation orientation : { RSKImageOrientationDown, RSKImageOrientationDownMirrored }) {
+        const char *name = orientation == RSKImageOrientationDown ? "Down" : "DownMirrored";
+        TestImage reference = LoadReferenceImage(std::string("crop_image_crop_image_with_any_image_orientation_UIImageOrientation") + name);
+
+        RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, source.Width(), source.Height());
+        spec.imageOrientation = orientation;
+
+        ImageDifference difference = CompareImages(Crop(source, spec), reference);
+        EXPECT_LT(difference.meanColorDifference, 10) << name;
+        EXPECT_EQ(difference.maximumAlphaDifference, 0) << name;
+    }
+}
+
+TEST(RSKCropEngine, MatchesReferenceImageOfCircleModeWhenApplyingMask)
+{
+    TestImage source = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeCircle_correctly_crop_the_image_when_all_properties_are_default");
+    TestImage reference = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeCircle_correctly_crop_the_image_when_applyMaskToCroppedImage_is_YES");
+
+    // The mask path is in the coordinate space of the view, so it is offset from the crop.
+    std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(15, 241, source.Width(), source.Height()));
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, source.Width(), source.Height());
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    ImageDifference difference = CompareImages(Crop(source, spec), reference);
+    EXPECT_LT(difference.meanColorDifference, 1);
+    EXPECT_LT(difference.meanAlphaDifference, 1);
+}
+
+TEST(RSKCropEngine, MatchesReferenceImageOfCustomModeWhenApplyingMask)
+{
+    TestImage source = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeCustom_correctly_crop_the_image_when_all_properties_are_default");
+    TestImage reference = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeCustom_correctly_crop_the_image_when_applyMaskToCroppedImage_is_YES");
+
+    // The reference image is three times the size of the mask of 250 x 250 points.
+    std::vector<RSKPathElement> maskPath = MakeTrianglePath(CGRectMake(62, 208, 250, 250));
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeCustom, source.Width(), source.Height());
+    spec.zoomScale = 250.0 / source.Width();
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    ImageDifference difference = CompareImages(Crop(source, spec), reference);
+    EXPECT_LT(difference.meanColorDifference, 1);
+    EXPECT_LT(difference.meanAlphaDifference, 1);
+}
+
+TEST(RSKCropEngine, MatchesReferenceImageOfSquareModeWhenApplyingMask)
+{
+    TestImage source = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeSquare_correctly_crop_the_image_when_all_properties_are_default");
+    TestImage reference = LoadReferenceImage("crop_image_crop_mode_is_RSKImageCropModeSquare_correctly_crop_the_image_when_applyMaskToCroppedImage_is_YES");
+
+    std::vector<RSKPathElement> maskPath = MakeTrianglePath(CGRectMake(0, 0, source.Width(), source.Height()));
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, source.Width(), source.Height());
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+
+    ImageDifference difference = CompareImages(Crop(source, spec), reference);
+    EXPECT_EQ(difference.maximumColorDifference, 0);
+    EXPECT_EQ(difference.maximumAlphaDifference, 0);
+}
+
+#endif
+
+TEST(RSKCropEngine, CropsImageRect)
+{
+    TestImage source = TestImage::MakePattern(64, 48);
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, 20, 10);
+    spec.imageRect = CGRectMake(5, 7, 20, 10);
+
+    TestImage result = Crop(source, spec);
+    ASSERT_EQ(result.Width(), 20u);
+    ASSERT_EQ(result.Height(), 10u);
+    for (size_t y = 0; y < result.Height(); y++) {
+        for (size_t x = 0; x < result.Width(); x++) {
+            EXPECT_EQ(0, std::memcmp(result.Pixel(x, y), source.Pixel(x + 5, y + 7), 4));
+        }
+    }
+}
+
+TEST(RSKCropEngine, ClipsImageRectToSource)
+{
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 40, 40);
+    spec.imageRect = CGRectMake(-10.5, 20, 40, 40);
+
+    CGSize size = RSKCropEngineGetOutputSize(64, 48, &spec);
+    EXPECT_EQ(size.width, 30);
+    EXPECT_EQ(size.height, 28);
+}
+
+TEST(RSKCropEngine, UsesSizeOfCropRectWhenRotating)
+{
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 64, 48);
+    spec.cropRect = CGRectMake(3, 4, 30, 20);
+    spec.rotationAngle = M_PI_4;
+
+    CGSize size = RSKCropEngineGetOutputSize(64, 48, &spec);
+    EXPECT_EQ(size.width, 30);
+    EXPECT_EQ(size.height, 20);
+}
+
+TEST(RSKCropEngine, RotatesImageClockwise)
+{
+    TestImage source = TestImage::MakePattern(40, 30);
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 30, 40);
+    spec.imageRect = CGRectMake(0, 0, 40, 30);
+    spec.rotationAngle = M_PI_2;
+
+    TestImage result = Crop(source, spec);
+    ASSERT_EQ(result.Width(), 30u);
+    ASSERT_EQ(result.Height(), 40u);
+
+    // The top-left corner of the source ends up in the top-right corner of the result.
+    for (size_t y = 0; y < result.Height(); y++) {
+        for (size_t x = 0; x < result.Width(); x++) {
+            const uint8_t *expected = source.Pixel(y, source.Height() - 1 - x);
+            EXPECT_EQ(0, std::memcmp(result.Pixel(x, y), expected, 4)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(RSKCropEngine, RotatesImageClockwiseWithEveryFilter)
+{
+    TestImage source = TestImage::MakePattern(40, 30);
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 30, 40);
+    spec.imageRect = CGRectMake(0, 0, 40, 30);
+    spec.rotationAngle = M_PI_2;
+    TestImage expected = Crop(source, spec);
+
+    for (RSKResamplingFilter filter : { RSKResamplingFilterNearest, RSKResamplingFilterBicubic, RSKResamplingFilterLanczos3 }) {
+        spec.resamplingFilter = filter;
+        ImageDifference difference = CompareImages(Crop(source, spec), expected);
+        EXPECT_EQ(difference.maximumColorDifference, 0) << filter;
+        EXPECT_EQ(difference.maximumAlphaDifference, 0) << filter;
+    }
+}
+
+TEST(RSKCropEngine, CentersRotatedImageInCropRect)
+{
+    TestImage source = TestImage::MakePattern(50, 50);
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 50, 50);
+    spec.rotationAngle = M_PI_4;
+
+    TestImage result = Crop(source, spec);
+    ASSERT_EQ(result.Width(), 50u);
+
+    // The corners of the crop rect are outside of the rotated image, while its center is covered.
+    EXPECT_EQ(result.Pixel(0, 0)[3], 0);
+    EXPECT_EQ(result.Pixel(49, 49)[3], 0);
+    EXPECT_EQ(result.Pixel(25, 25)[3], 255);
+}
+
+TEST(RSKCropEngine, MatchesSeparateOrientRotateAndDrawSteps)
+{
+    // The crop samples the source once, which has to match fixing the orientation, rotating and drawing one by one.
+    TestImage source = TestImage::MakePattern(37, 23);
+    const CGRect imageRect = CGRectMake(3, 2, 30, 19);
+    const size_t canvasWidth = 40;
+    const size_t canvasHeight = 36;
+
+    for (RSKImageOrientation orientation : { RSKImageOrientationUp, RSKImageOrientationLeft, RSKImageOrientationDownMirrored, RSKImageOrientationRightMirrored }) {
+        for (CGFloat angle : { 0.3, -2.0, M_PI_2 }) {
+            RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, canvasWidth, canvasHeight);
+            spec.imageRect = imageRect;
+            spec.imageOrientation = orientation;
+            spec.rotationAngle = angle;
+            TestImage result = Crop(source, spec);
+
+            RSKBitmap sourceBitmap = source.Bitmap();
+            rsk::BitmapView image = rsk::MakeSubview(rsk::MakeBitmapView(sourceBitmap), 3, 2, 30, 19);
+            bool swapsDimensions = rsk::OrientationSwapsDimensions(orientation);
+            rsk::PixelBuffer orientedImage(swapsDimensions ? 19 : 30, swapsDimensions ? 30 : 19);
+            rsk::OrientBitmap(image, orientation, orientedImage.View());
+
+            CGSize orientedSize = CGSizeMake(orientedImage.View().width, orientedImage.View().height);
+            CGSize rotatedSize = rsk::RotatedSize(orientedSize, angle);
+            rsk::PixelBuffer rotatedImage(static_cast<size_t>(std::ceil(rotatedSize.width - 0.001)), static_cast<size_t>(std::ceil(rotatedSize.height - 0.001)));
+            rsk::RotateBitmap(orientedImage.View(), angle, rotatedSize, rotatedImage.View());
+
+            TestImage expected(canvasWidth, canvasHeight);
+            RSKBitmap expectedBitmap = expected.Bitmap();
+            ptrdiff_t x = static_cast<ptrdiff_t>(std::floor((static_cast<double>(canvasWidth) - rotatedImage.View().width) * 0.5));
+            ptrdiff_t y = static_cast<ptrdiff_t>(std::floor((static_cast<double>(canvasHeight) - rotatedImage.View().height) * 0.5));
+            rsk::DrawBitmap(rotatedImage.View(), x, y, nullptr, rsk::MakeBitmapView(expectedBitmap));
+
+            ImageDifference difference = CompareImages(result, expected);
+            EXPECT_LE(difference.maximumColorDifference, 1) << orientation << ", " << angle;
+            EXPECT_LE(difference.maximumAlphaDifference, 1) << orientation << ", " << angle;
+        }
+    }
+}
+
+TEST(RSKCropEngine, CopiesRightAngleRotationsLikeSamplingThem)
+{
+    // The rotations by right angles copy the pixels of the image rect, which has to match sampling them exactly, also
+    // for angles that are slightly off, like the ones of `atan2`, and with the mask applied.
+    TestImage source = TestImage::MakePattern(37, 23);
+    const CGRect imageRect = CGRectMake(3, 2, 30, 19);
+    const size_t canvasWidth = 40;
+    const size_t canvasHeight = 36;
+    const std::vector<RSKPathElement> ovalPath = MakeOvalPath(CGRectMake(0, 0, canvasWidth, canvasHeight));
+
+    for (int orientation = RSKImageOrientationUp; orientation <= RSKImageOrientationRightMirrored; orientation++) {
+        for (CGFloat angle : { M_PI_2, M_PI, -M_PI_2, M_PI_2 + 1e-9, std::nextafter(M_PI, 0.0) }) {
+            for (bool appliesMask : { false, true }) {
+                RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, canvasWidth, canvasHeight);
+                spec.imageRect = imageRect;
+                spec.imageOrientation = static_cast<RSKImageOrientation>(orientation);
+                spec.rotationAngle = angle;
+                spec.maskPath = { ovalPath.data(), ovalPath.size(), false };
+                spec.applyMaskToCroppedImage = appliesMask;
+                TestImage result = Crop(source, spec);
+
+                RSKBitmap sourceBitmap = source.Bitmap();
+                rsk::BitmapView image = rsk::MakeSubview(rsk::MakeBitmapView(sourceBitmap), 3, 2, 30, 19);
+                bool swapsDimensions = rsk::OrientationSwapsDimensions(spec.imageOrientation);
+                rsk::PixelBuffer orientedImage(swapsDimensions ? 19 : 30, swapsDimensions ? 30 : 19);
+                rsk::OrientBitmap(image, spec.imageOrientation, orientedImage.View());
+
+                CGSize orientedSize = CGSizeMake(orientedImage.View().width, orientedImage.View().height);
+                CGSize rotatedSize = rsk::RotatedSize(orientedSize, angle);
+                rsk::PixelBuffer rotatedImage(static_cast<size_t>(std::ceil(rotatedSize.width - 0.001)), static_cast<size_t>(std::ceil(rotatedSize.height - 0.001)));
+                rsk::RotateBitmap(orientedImage.View(), angle, rotatedSize, rotatedImage.View());
+
+                TestImage expected(canvasWidth, canvasHeight);
+                RSKBitmap expectedBitmap = expected.Bitmap();
+                ptrdiff_t x = static_cast<ptrdiff_t>(std::floor((static_cast<double>(canvasWidth) - rotatedImage.View().width) * 0.5));
+                ptrdiff_t y = static_cast<ptrdiff_t>(std::floor((static_cast<double>(canvasHeight) - rotatedImage.View().height) * 0.5));
+                rsk::DrawBitmap(rotatedImage.View(), x, y, nullptr, rsk::MakeBitmapView(expectedBitmap));
+                if (appliesMask) {
+                    rsk::EllipseCoverageMask mask(CGRectMake(0, 0, canvasWidth, canvasHeight), canvasWidth, canvasHeight);
+                    rsk::MaskBitmap(mask, rsk::MakeBitmapView(expectedBitmap));
+                }
+
+                ImageDifference difference = CompareImages(result, expected);
+                EXPECT_EQ(difference.maximumColorDifference, 0) << orientation << ", " << angle << ", " << appliesMask;
+                EXPECT_EQ(difference.maximumAlphaDifference, 0) << orientation << ", " << angle << ", " << appliesMask;
+            }
+        }
+    }
+}
+
+TEST(RSKCropEngine, ReportsOpaqueResultsOfOpaqueSources)
+{
+    // Every crop that is reported opaque has to be opaque, whatever the rotation, the filter and the scale.
+    TestImage source = TestImage::MakePattern(97, 83);
+    const std::vector<RSKPathElement> ovalPath = MakeOvalPath(CGRectMake(0, 0, 40, 30));
+    for (CGSize canvasSize : { CGSizeMake(40, 30), CGSizeMake(90, 80) }) {
+        for (CGRect imageRect : { CGRectMake(0, 0, 97, 83), CGRectMake(10, 5, 60, 50) }) {
+            for (CGFloat angle : { 0.0, 0.05, 0.4, M_PI_2, M_PI }) {
+                for (int filter = RSKResamplingFilterBilinear; filter <= RSKResamplingFilterLanczos3; filter++) {
+                    for (CGSize outputSize : { CGSizeZero, CGSizeMake(17, 13), CGSizeMake(60, 45) }) {
+                        for (bool appliesMask : { false, true }) {
+                            RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, static_cast<size_t>(canvasSize.width), static_cast<size_t>(canvasSize.height));
+                            spec.imageRect = imageRect;
+                            spec.rotationAngle = angle;
+                            spec.resamplingFilter = static_cast<RSKResamplingFilter>(filter);
+                            spec.outputSize = outputSize;
+                            spec.maskPath = { ovalPath.data(), ovalPath.size(), false };
+                            spec.applyMaskToCroppedImage = appliesMask;
+                            if (!RSKCropEngineIsOutputOpaque(source.Width(), source.Height(), &spec)) {
+                                continue;
+                            }
+                            TestImage result = Crop(source, spec);
+                            size_t translucentCount = 0;
+                            for (size_t y = 0; y < result.Height(); y++) {
+                                for (size_t x = 0; x < result.Width(); x++) {
+                                    translucentCount += result.Pixel(x, y)[3] != 255;
+                                }
+                            }
+                            EXPECT_EQ(translucentCount, 0u) << canvasSize.width << ", " << imageRect.size.width << ", " << angle << ", " << filter << ", " << outputSize.width << ", " << appliesMask;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // A crop inside of the rotated image is opaque, unlike one that exposes its corners or is masked.
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeCircle, 40, 30);
+    spec.imageRect = CGRectMake(0, 0, 97, 83);
+    spec.rotationAngle = 0.4;
+    EXPECT_TRUE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec.outputSize = CGSizeMake(17, 13);
+    EXPECT_TRUE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec.maskPath = { ovalPath.data(), ovalPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+    EXPECT_FALSE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec = MakeCropSpec(RSKCropModeCircle, 90, 80);
+    spec.imageRect = CGRectMake(0, 0, 97, 83);
+    spec.rotationAngle = 0.4;
+    EXPECT_FALSE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+
+    // An image rect that does not fill the crop rect leaves it clear around the image.
+    spec.rotationAngle = M_PI_2;
+    EXPECT_FALSE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec.rotationAngle = M_PI;
+    EXPECT_TRUE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec.imageRect = CGRectMake(0, 0, 80, 70);
+    EXPECT_FALSE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec.rotationAngle = 0;
+    EXPECT_TRUE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+    spec.imageRect = CGRectZero;
+    EXPECT_FALSE(RSKCropEngineIsOutputOpaque(97, 83, &spec));
+}
+
+TEST(RSKCropEngine, CropsTilesAndBandsLikeWholeImage)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(4);
+    ASSERT_NE(pool, nullptr);
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+    const RSKExecutor *tileExecutors[] = { nullptr, &executor };
+
+    TestImage source = TestImage::MakePattern(97, 83);
+    std::vector<RSKPathElement> ovalPath = MakeOvalPath(CGRectMake(10, 20, 60, 50));
+    std::vector<RSKPathElement> trianglePath = MakeTrianglePath(CGRectMake(-5, 0, 80, 60));
+
+    struct TiledCase {
+        RSKCropMode cropMode;
+        RSKImageOrientation orientation;
+        CGFloat angle;
+        RSKResamplingFilter filter;
+        const std::vector<RSKPathElement> *maskPath;
+        CGSize outputSize;
+    };
+    const TiledCase cases[] = {
+        { RSKCropModeSquare, RSKImageOrientationUp, 0, RSKResamplingFilterBilinear, nullptr },
+        { RSKCropModeSquare, RSKImageOrientationRightMirrored, 0, RSKResamplingFilterBilinear, nullptr },
+        { RSKCropModeSquare, RSKImageOrientationLeft, 0.3, RSKResamplingFilterBilinear, nullptr },
+        { RSKCropModeSquare, RSKImageOrientationUp, -2.0, RSKResamplingFilterNearest, nullptr },
+        { RSKCropModeSquare, RSKImageOrientationDown, 1.1, RSKResamplingFilterBicubic, nullptr },
+        { RSKCropModeSquare, RSKImageOrientationUpMirrored, 0.7, RSKResamplingFilterLanczos3, nullptr },
+        { RSKCropModeCircle, RSKImageOrientationUp, 0, RSKResamplingFilterBilinear, &ovalPath },
+        { RSKCropModeCircle, RSKImageOrientationLeftMirrored, -0.4, RSKResamplingFilterBicubic, &ovalPath },
+        { RSKCropModeCustom, RSKImageOrientationUp, 0.2, RSKResamplingFilterBilinear, &trianglePath },
+        { RSKCropModeSquare, RSKImageOrientationUp, 0, RSKResamplingFilterBilinear, nullptr, { 23, 19 } },
+        { RSKCropModeSquare, RSKImageOrientationRight, 0.5, RSKResamplingFilterLanczos3, nullptr, { 50, 41 } },
+        { RSKCropModeCircle, RSKImageOrientationDownMirrored, -0.9, RSKResamplingFilterBicubic, &ovalPath, { 17, 15 } },
+    };
+
+    for (const TiledCase &tiledCase : cases) {
+        RSKCropSpec spec = MakeCropSpec(tiledCase.cropMode, 70, 60);
+        spec.cropRect = CGRectMake(5, 5, 70, 60);
+        spec.imageRect = CGRectMake(9, 4, 80, 75);
+        spec.imageOrientation = tiledCase.orientation;
+        spec.rotationAngle = tiledCase.angle;
+        spec.resamplingFilter = tiledCase.filter;
+        spec.outputSize = tiledCase.outputSize;
+        if (tiledCase.maskPath) {
+            spec.maskPath = { tiledCase.maskPath->data(), tiledCase.maskPath->size(), false };
+            spec.applyMaskToCroppedImage = true;
+        }
+        TestImage expected = Crop(source, spec);
+
+        ImageDifference bandsDifference = CompareImages(CropConcurrently(source, spec, &executor), expected);
+        EXPECT_EQ(bandsDifference.maximumColorDifference, 0) << tiledCase.orientation << ", " << tiledCase.angle;
+        EXPECT_EQ(bandsDifference.maximumAlphaDifference, 0) << tiledCase.orientation << ", " << tiledCase.angle;
+
+        for (size_t tileSize : { 7, 32, 256 }) {
+            for (const RSKExecutor *tileExecutor : tileExecutors) {
+                ImageDifference difference = CompareImages(CropTiled(source, spec, tileSize, tileExecutor), expected);
+                EXPECT_EQ(difference.maximumColorDifference, 0) << tiledCase.orientation << ", " << tiledCase.angle << ", " << tileSize;
+                EXPECT_EQ(difference.maximumAlphaDifference, 0) << tiledCase.orientation << ", " << tiledCase.angle << ", " << tileSize;
+            }
+        }
+    }
+
+    RSKThreadPoolDestroy(pool);
+}
+
+TEST(RSKCropEngine, ScalesResultToOutputSize)
+{
+    TestImage source = TestImage::MakePattern(96, 64);
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 80, 48);
+    spec.imageRect = CGRectMake(8, 8, 80, 48);
+    TestImage canvas = Crop(source, spec);
+
+    // A whole reduction samples every pixel of the result from the middle of its block of the canvas.
+    spec.outputSize = CGSizeMake(20, 12);
+    EXPECT_TRUE(CGSizeEqualToSize(RSKCropEngineGetOutputSize(96, 64, &spec), spec.outputSize));
+    TestImage expected(20, 12);
+    RSKBitmap canvasBitmap = canvas.Bitmap();
+    RSKBitmap expectedBitmap = expected.Bitmap();
+    rsk::BoxReduceBitmap(rsk::MakeBitmapView(canvasBitmap), 4, true, rsk::MakeBitmapView(expectedBitmap));
+    ImageDifference difference = CompareImages(Crop(source, spec), expected);
+    EXPECT_EQ(difference.maximumColorDifference, 0);
+    EXPECT_EQ(difference.maximumAlphaDifference, 0);
+
+    // Any other reduction averages the area of every pixel, give or take the rounding of the samples.
+    spec.outputSize = CGSizeMake(30, 17);
+    TestImage result = Crop(source, spec);
+    ASSERT_EQ(result.Width(), 30u);
+    ASSERT_EQ(result.Height(), 17u);
+    for (size_t y = 0; y < result.Height(); y++) {
+        for (size_t x = 0; x < result.Width(); x++) {
+            const CGFloat middleX = 8 + (x + 0.5) * 80 / 30 - 0.5;
+            const CGFloat middleY = 8 + (y + 0.5) * 48 / 17 - 0.5;
+            EXPECT_NEAR(result.Pixel(x, y)[0], middleX, 1.5) << x << ", " << y;
+            EXPECT_NEAR(result.Pixel(x, y)[1], middleY, 1.5) << x << ", " << y;
+            EXPECT_EQ(result.Pixel(x, y)[3], 255) << x << ", " << y;
+        }
+    }
+}
+
+TEST(RSKCropEngine, CropsBitmapToEverySize)
+{
+    TestImage source = TestImage::MakePattern(97, 83);
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 70, 60);
+    spec.imageRect = CGRectMake(9, 4, 80, 75);
+    spec.rotationAngle = 0.4;
+    spec.outputSize = CGSizeMake(1, 1);
+
+    std::vector<TestImage> results;
+    std::vector<RSKBitmap> bitmaps;
+    for (size_t size : { 64, 32, 16 }) {
+        results.emplace_back(size, size * 6 / 7);
+    }
+    for (TestImage &result : results) {
+        bitmaps.push_back(result.Bitmap());
+    }
+    RSKBitmap sourceBitmap = source.Bitmap();
+    ASSERT_EQ(RSKCropEngineCropBitmapToSizes(&sourceBitmap, &spec, nullptr, bitmaps.data(), bitmaps.size()), RSKCropStatusSuccess);
+
+    for (TestImage &result : results) {
+        spec.outputSize = CGSizeMake(result.Width(), result.Height());
+        EXPECT_EQ(CompareImages(result, Crop(source, spec)).maximumColorDifference, 0) << result.Width();
+    }
+}
+
+TEST(RSKCropEngine, MapsQuarterTurnsToWholePixels)
+{
+    TestImage source = TestImage::MakePattern(97, 83);
+    const CGRect imageRect = CGRectMake(9, 4, 40, 30);
+
+    for (int orientation = RSKImageOrientationUp; orientation <= RSKImageOrientationRightMirrored; orientation++) {
+        for (int quarterTurns = 0; quarterTurns < 4; quarterTurns++) {
+            // The crop rect fits the rotated image exactly, so the whole result is made of moved pixels.
+            const bool swapsDimensions = rsk::OrientationSwapsDimensions(static_cast<RSKImageOrientation>(orientation)) != (quarterTurns % 2 == 1);
+            RSKCropSpec spec = swapsDimensions ? MakeCropSpec(RSKCropModeSquare, 30, 40) : MakeCropSpec(RSKCropModeSquare, 40, 30);
+            spec.imageRect = imageRect;
+            spec.imageOrientation = static_cast<RSKImageOrientation>(orientation);
+            spec.rotationAngle = quarterTurns * M_PI_2;
+
+            rsk::CropPixelMapping mapping;
+            ASSERT_TRUE(rsk::GetCropPixelMapping(source.Width(), source.Height(), spec, mapping)) << orientation << ", " << quarterTurns;
+            EXPECT_EQ(mapping.x, 9u);
+            EXPECT_EQ(mapping.y, 4u);
+            EXPECT_EQ(mapping.width, 40u);
+            EXPECT_EQ(mapping.height, 30u);
+
+            TestImage result = Crop(source, spec);
+            ASSERT_EQ(result.Width(), mapping.swapsAxes ? mapping.height : mapping.width);
+            for (size_t y = 0; y < result.Height(); y++) {
+                for (size_t x = 0; x < result.Width(); x++) {
+                    const size_t a = mapping.swapsAxes ? y : x;
+                    const size_t b = mapping.swapsAxes ? x : y;
+                    const size_t sourceX = mapping.x + (mapping.flipsHorizontally ? mapping.width - 1 - a : a);
+                    const size_t sourceY = mapping.y + (mapping.flipsVertically ? mapping.height - 1 - b : b);
+                    ASSERT_EQ(0, std::memcmp(result.Pixel(x, y), source.Pixel(sourceX, sourceY), 4)) << orientation << ", " << quarterTurns;
+                }
+            }
+        }
+    }
+}
+
+TEST(RSKCropEngine, MapsOnlyCropsThatMoveWholePixels)
+{
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 40, 30);
+    spec.imageRect = CGRectMake(9, 4, 40, 30);
+    rsk::CropPixelMapping mapping;
+    EXPECT_TRUE(rsk::GetCropPixelMapping(97, 83, spec, mapping));
+
+    RSKCropSpec rotatedSpec = spec;
+    rotatedSpec.rotationAngle = 0.4;
+    EXPECT_FALSE(rsk::GetCropPixelMapping(97, 83, rotatedSpec, mapping));
+
+    RSKCropSpec scaledSpec = spec;
+    scaledSpec.outputSize = CGSizeMake(20, 15);
+    EXPECT_FALSE(rsk::GetCropPixelMapping(97, 83, scaledSpec, mapping));
+
+    // The rotated image does not cover the crop rect, so the rest of the result is clear.
+    RSKCropSpec paddedSpec = spec;
+    paddedSpec.rotationAngle = M_PI;
+    paddedSpec.cropRect = CGRectMake(0, 0, 50, 30);
+    EXPECT_FALSE(rsk::GetCropPixelMapping(97, 83, paddedSpec, mapping));
+
+    const std::vector<RSKPathElement> ovalPath = MakeOvalPath(CGRectMake(0, 0, 30, 30));
+    RSKCropSpec maskedSpec = MakeCropSpec(RSKCropModeCircle, 30, 30);
+    maskedSpec.imageRect = CGRectMake(9, 4, 30, 30);
+    maskedSpec.maskPath.elements = ovalPath.data();
+    maskedSpec.maskPath.elementCount = ovalPath.size();
+    maskedSpec.applyMaskToCroppedImage = true;
+    EXPECT_FALSE(rsk::GetCropPixelMapping(97, 83, maskedSpec, mapping));
+}
+
+TEST(RSKCropEngine, ShrinksTilesToFitMemoryBudget)
+{
+    TestImage source = TestImage::MakePattern(300, 300);
+    TestImage result(300, 300);
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 300, 300);
+    spec.rotationAngle = M_PI_4;
+
+    struct Tiles {
+        TestImage *result;
+        size_t maximumTileSize;
+    } tiles = { &result, 0 };
+    RSKTileWriteFunction write = [](void *context, size_t x, size_t y, const RSKBitmap *tile) {
+        Tiles &tiles = *static_cast<Tiles *>(context);
+        tiles.maximumTileSize = std::max({ tiles.maximumTileSize, tile->width, tile->height });
+        return WriteTestImage(tiles.result, x, y, tile);
+    };
+
+    RSKTiledSource tiledSource = { 300, 300, RSKPixelFormatRGBA8888, ReadTestImage, &source };
+    RSKTiledDestination tiledDestination = { write, &tiles };
+    RSKTilingOptions options = { 256, 64 * 1024, nullptr };
+    EXPECT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &tiledDestination), RSKCropStatusSuccess);
+    EXPECT_LE(tiles.maximumTileSize, 64u);
+    EXPECT_EQ(CompareImages(result, Crop(source, spec)).maximumColorDifference, 0);
+
+    options.memoryBudget = 1024;
+    EXPECT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &tiledDestination), RSKCropStatusOutOfMemory);
+}
+
+TEST(RSKCropEngine, StopsTiledCropWhenTileCannotBeReadOrWritten)
+{
+    TestImage source = TestImage::MakePattern(64, 64);
+    TestImage result(64, 64);
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 64, 64);
+    RSKTilingOptions options = { 16, 0, nullptr };
+
+    RSKTiledSource failingSource = { 64, 64, RSKPixelFormatRGBA8888, [](void *, size_t, size_t, const RSKBitmap *) { return false; }, nullptr };
+    RSKTiledDestination destination = { WriteTestImage, &result };
+    EXPECT_EQ(RSKCropEngineCropTiled(&failingSource, &spec, &options, &destination), RSKCropStatusReadFailed);
+
+    RSKTiledSource tiledSource = { 64, 64, RSKPixelFormatRGBA8888, ReadTestImage, &source };
+    RSKTiledDestination failingDestination = { [](void *, size_t, size_t, const RSKBitmap *) { return false; }, nullptr };
+    EXPECT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &failingDestination), RSKCropStatusWriteFailed);
+
+    RSKTiledDestination nullDestination = { nullptr, nullptr };
+    EXPECT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &nullDestination), RSKCropStatusInvalidArgument);
+}
+
+#if defined(__linux__)
+
+namespace {
+
+// Returns the value, in kilobytes, of the `field` of the memory status of the process.
+size_t ProcessMemoryStatus(const std::string &field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size() + 1, field + ":") == 0) {
+            return std::stoul(line.substr(field.size() + 1));
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+TEST(RSKCropEngine, CropsGigapixelSourceWithinMemoryBudget)
+{
+    // The source would take 1.6 GB if it was decoded as a whole. Its pixels are made up as they are read.
+    const size_t kSourceSize = 20000;
+    const size_t kMemoryBudget = 16 * 1024 * 1024;
+    const size_t kResidentMemoryCeiling = 64 * 1024 * 1024;
+
+    RSKTileReadFunction read = [](void *, size_t x, size_t y, const RSKBitmap *destination) {
+        for (size_t row = 0; row < destination->height; row++) {
+            uint8_t *pixel = static_cast<uint8_t *>(destination->data) + row * destination->bytesPerRow;
+            for (size_t column = 0; column < destination->width; column++, pixel += 4) {
+                pixel[0] = static_cast<uint8_t>(x + column);
+                pixel[1] = static_cast<uint8_t>(y + row);
+                pixel[2] = static_cast<uint8_t>((x + column) >> 8);
+                pixel[3] = 255;
+            }
+        }
+        return true;
+    };
+
+    // The image is rotated by a right angle, so every pixel of the result is a pixel of the source.
+    struct Tiles {
+        size_t pixelCount;
+        size_t mismatchCount;
+    } tiles = { 0, 0 };
+    RSKTileWriteFunction write = [](void *context, size_t x, size_t y, const RSKBitmap *tile) {
+        Tiles &tiles = *static_cast<Tiles *>(context);
+        tiles.pixelCount += tile->width * tile->height;
+        for (size_t row = 0; row < tile->height; row += 13) {
+            for (size_t column = 0; column < tile->width; column += 13) {
+                const uint8_t *pixel = static_cast<const uint8_t *>(tile->data) + row * tile->bytesPerRow + column * 4;
+                const size_t sourceX = y + row;
+                const size_t sourceY = kSourceSize - 1 - (x + column);
+                if (pixel[0] != static_cast<uint8_t>(sourceX) || pixel[1] != static_cast<uint8_t>(sourceY) || pixel[3] != 255) {
+                    tiles.mismatchCount++;
+                }
+            }
+        }
+        return true;
+    };
+
+    // Resetting the peak resident memory of the process needs Linux 4.0.
+    std::ofstream("/proc/self/clear_refs") << "5";
+    const size_t residentMemory = ProcessMemoryStatus("VmRSS") * 1024;
+
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, kSourceSize, kSourceSize);
+    spec.rotationAngle = M_PI_2;
+    RSKTiledSource tiledSource = { kSourceSize, kSourceSize, RSKPixelFormatRGBA8888, read, nullptr };
+    RSKTiledDestination tiledDestination = { write, &tiles };
+    RSKTilingOptions options = { 512, kMemoryBudget, nullptr };
+    EXPECT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &tiledDestination), RSKCropStatusSuccess);
+
+    EXPECT_EQ(tiles.pixelCount, kSourceSize * kSourceSize);
+    EXPECT_EQ(tiles.mismatchCount, 0u);
+    EXPECT_LT(ProcessMemoryStatus("VmHWM") * 1024, residentMemory + kResidentMemoryCeiling);
+}
+
+#endif
+
+TEST(RSKCropEngine, RejectsInvalidArguments)
+{
+    TestImage source = TestImage::MakePattern(8, 8);
+    TestImage destination(8, 8);
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap destinationBitmap = destination.Bitmap();
+    RSKCropSpec spec = MakeCropSpec(RSKCropModeSquare, 8, 8);
+
+    EXPECT_EQ(RSKCropEngineCropBitmap(nullptr, &spec, &destinationBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, nullptr, &destinationBitmap), RSKCropStatusInvalidArgument);
+
+    RSKBitmap smallDestination = destinationBitmap;
+    smallDestination.width = 4;
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &smallDestination), RSKCropStatusInvalidArgument);
+
+    RSKBitmap otherFormatDestination = destinationBitmap;
+    otherFormatDestination.pixelFormat = RSKPixelFormatBGRA8888;
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &otherFormatDestination), RSKCropStatusInvalidArgument);
+
+    RSKCropSpec unknownFilterSpec = spec;
+    // Like a C caller does, store a value that is out of the range of the enum without making an enum of it.
+    const int unknownFilter = RSKResamplingFilterLanczos3 + 1;
+    static_assert(sizeof(unknownFilter) == sizeof(unknownFilterSpec.resamplingFilter));
+    std::memcpy(&unknownFilterSpec.resamplingFilter, &unknownFilter, sizeof(unknownFilter));
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &unknownFilterSpec, &destinationBitmap), RSKCropStatusInvalidArgument);
+
+    RSKCropSpec negativeOutputSizeSpec = spec;
+    negativeOutputSizeSpec.outputSize = CGSizeMake(-8, 8);
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &negativeOutputSizeSpec, &destinationBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKCropEngineCropBitmapToSizes(&sourceBitmap, &spec, nullptr, nullptr, 1), RSKCropStatusInvalidArgument);
+
+    const auto expectInvalid = [&](const RSKCropSpec &invalidSpec) {
+        EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &invalidSpec, &destinationBitmap), RSKCropStatusInvalidArgument);
+        EXPECT_TRUE(CGSizeEqualToSize(RSKCropEngineGetOutputSize(8, 8, &invalidSpec), CGSizeZero));
+    };
+    for (CGFloat value : { static_cast<CGFloat>(NAN), static_cast<CGFloat>(-INFINITY), static_cast<CGFloat>(1e15) }) {
+        RSKCropSpec invalidSpec = spec;
+        invalidSpec.cropRect.size.width = value;
+        expectInvalid(invalidSpec);
+        invalidSpec = spec;
+        invalidSpec.imageRect.origin.y = value;
+        expectInvalid(invalidSpec);
+        invalidSpec = spec;
+        invalidSpec.outputSize.height = value;
+        expectInvalid(invalidSpec);
+    }
+    for (CGFloat zoomScale : { static_cast<CGFloat>(NAN), static_cast<CGFloat>(INFINITY), static_cast<CGFloat>(0), static_cast<CGFloat>(-1) }) {
+        RSKCropSpec invalidSpec = spec;
+        invalidSpec.zoomScale = zoomScale;
+        expectInvalid(invalidSpec);
+    }
+
+    spec.imageRect = CGRectMake(100, 100, 8, 8);
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &destinationBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_TRUE(CGSizeEqualToSize(RSKCropEngineGetOutputSize(8, 8, &spec), CGSizeZero));
+}
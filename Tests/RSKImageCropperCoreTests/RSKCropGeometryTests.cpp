@@ -0,0 +1,363 @@
+//
+// RSKCropGeometryTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKCropGeometry.h>
+
+namespace {
+
+// A transcription of `RSKRectNormalize`.
+CGRect ReferenceNormalizeRect(CGRect rect)
+{
+    auto isNearlyCeil = [](CGFloat value) {
+        const CGFloat ceilValue = std::ceil(value);
+        return std::fabs(ceilValue - value) < std::pow(10, 9) * DBL_EPSILON * std::fabs(ceilValue + value) || std::fabs(ceilValue - value) < DBL_MIN;
+    };
+    CGRect normalizedRect;
+    if (isNearlyCeil(rect.origin.x) || isNearlyCeil(rect.origin.y)) {
+        normalizedRect.origin = CGPointMake(std::ceil(rect.origin.x), std::ceil(rect.origin.y));
+    } else {
+        normalizedRect.origin = CGPointMake(std::floor(rect.origin.x), std::floor(rect.origin.y));
+    }
+    if (isNearlyCeil(rect.size.width) || isNearlyCeil(rect.size.height)) {
+        normalizedRect.size = CGSizeMake(std::ceil(rect.size.width), std::ceil(rect.size.height));
+    } else {
+        normalizedRect.size = CGSizeMake(std::floor(rect.size.width), std::floor(rect.size.height));
+    }
+    return normalizedRect;
+}
+
+// A transcription of `-[RSKImageCropViewController cropRect]`, which rotated the image scroll view to find the crop rect.
+CGRect ReferenceCropRect(const RSKCropGeometryInput &input)
+{
+    const CGRect maskRect = input.maskRect;
+    float zoomScale = 1.0 / input.zoomScale;
+
+    // The frame of the rotated image scroll view is the bounding box of its rotated bounds.
+    const CGRect imageScrollViewFrame = CGRectMake(CGRectGetMidX(maskRect) - input.scrollViewSize.width * 0.5, CGRectGetMidY(maskRect) - input.scrollViewSize.height * 0.5, input.scrollViewSize.width, input.scrollViewSize.height);
+    const CGRect rotatedImageScrollViewFrame = CGRectApplyAffineTransform(CGRectMake(-input.scrollViewSize.width * 0.5, -input.scrollViewSize.height * 0.5, input.scrollViewSize.width, input.scrollViewSize.height), CGAffineTransformMakeRotation(input.rotationAngle));
+
+    CGRect imageFrame = CGRectMake(CGRectGetMinX(maskRect) - input.contentOffset.x, CGRectGetMinY(maskRect) - input.contentOffset.y, input.contentSize.width, input.contentSize.height);
+
+    CGFloat tx = CGRectGetMinX(imageFrame) + input.contentOffset.x + CGRectGetWidth(maskRect) * 0.5f;
+    CGFloat ty = CGRectGetMinY(imageFrame) + input.contentOffset.y + CGRectGetHeight(maskRect) * 0.5f;
+
+    CGFloat sx = CGRectGetWidth(rotatedImageScrollViewFrame) / CGRectGetWidth(imageScrollViewFrame);
+    CGFloat sy = CGRectGetHeight(rotatedImageScrollViewFrame) / CGRectGetHeight(imageScrollViewFrame);
+
+    CGAffineTransform t1 = CGAffineTransformMakeTranslation(-tx, -ty);
+    CGAffineTransform t2 = CGAffineTransformMakeRotation(input.rotationAngle);
+    CGAffineTransform t3 = CGAffineTransformMakeScale(sx, sy);
+    CGAffineTransform t4 = CGAffineTransformMakeTranslation(tx, ty);
+    imageFrame = CGRectApplyAffineTransform(imageFrame, CGAffineTransformConcat(CGAffineTransformConcat(CGAffineTransformConcat(t1, t2), t3), t4));
+
+    CGRect cropRect = CGRectMake(0.0, 0.0, CGRectGetWidth(maskRect), CGRectGetHeight(maskRect));
+    cropRect.origin.x = -CGRectGetMinX(imageFrame) + CGRectGetMinX(maskRect);
+    cropRect.origin.y = -CGRectGetMinY(imageFrame) + CGRectGetMinY(maskRect);
+    cropRect = CGRectApplyAffineTransform(cropRect, CGAffineTransformMakeScale(zoomScale, zoomScale));
+    cropRect = ReferenceNormalizeRect(cropRect);
+    return CGRectApplyAffineTransform(cropRect, CGAffineTransformMakeScale(input.imageScale, input.imageScale));
+}
+
+// A transcription of `-[RSKImageCropViewController imageRect]`.
+CGRect ReferenceImageRect(const RSKCropGeometryInput &input)
+{
+    float zoomScale = 1.0 / input.zoomScale;
+
+    CGRect imageRect = CGRectMake(input.contentOffset.x * zoomScale, input.contentOffset.y * zoomScale, input.scrollViewSize.width * zoomScale, input.scrollViewSize.height * zoomScale);
+    imageRect = ReferenceNormalizeRect(imageRect);
+
+    CGSize imageSize = input.imageSize;
+    CGFloat x = CGRectGetMinX(imageRect);
+    CGFloat y = CGRectGetMinY(imageRect);
+    CGFloat width = CGRectGetWidth(imageRect);
+    CGFloat height = CGRectGetHeight(imageRect);
+
+    RSKImageOrientation imageOrientation = input.imageOrientation;
+    if (imageOrientation == RSKImageOrientationRight || imageOrientation == RSKImageOrientationRightMirrored) {
+        imageRect.origin.x = y;
+        imageRect.origin.y = std::floor(imageSize.width - CGRectGetWidth(imageRect) - x);
+        imageRect.size.width = height;
+        imageRect.size.height = width;
+    } else if (imageOrientation == RSKImageOrientationLeft || imageOrientation == RSKImageOrientationLeftMirrored) {
+        imageRect.origin.x = std::floor(imageSize.height - CGRectGetHeight(imageRect) - y);
+        imageRect.origin.y = x;
+        imageRect.size.width = height;
+        imageRect.size.height = width;
+    } else if (imageOrientation == RSKImageOrientationDown || imageOrientation == RSKImageOrientationDownMirrored) {
+        imageRect.origin.x = std::floor(imageSize.width - CGRectGetWidth(imageRect) - x);
+        imageRect.origin.y = std::floor(imageSize.height - CGRectGetHeight(imageRect) - y);
+    }
+    return CGRectApplyAffineTransform(imageRect, CGAffineTransformMakeScale(input.imageScale, input.imageScale));
+}
+
+CGPoint ReferenceRotatePoint(CGPoint point, CGPoint pivot, CGFloat angle)
+{
+    point = CGPointApplyAffineTransform(point, CGAffineTransformMakeTranslation(-pivot.x, -pivot.y));
+    point = CGPointApplyAffineTransform(point, CGAffineTransformMakeRotation(angle));
+    return CGPointApplyAffineTransform(point, CGAffineTransformMakeTranslation(pivot.x, pivot.y));
+}
+
+// A transcription of `RSKLineSegmentIntersection`.
+bool ReferenceIntersectSegments(CGPoint p1, CGPoint p2, CGPoint p3, CGPoint p4, CGPoint &intersection)
+{
+    CGFloat numeratorA = (p4.x - p3.x) * (p1.y - p3.y) - (p4.y - p3.y) * (p1.x - p3.x);
+    CGFloat numeratorB = (p2.x - p1.x) * (p1.y - p3.y) - (p2.y - p1.y) * (p1.x - p3.x);
+    CGFloat denominator = (p4.y - p3.y) * (p2.x - p1.x) - (p4.x - p3.x) * (p2.y - p1.y);
+    if (std::fabs(numeratorA) < DBL_EPSILON && std::fabs(numeratorB) < DBL_EPSILON && std::fabs(denominator) < DBL_EPSILON) {
+        intersection = CGPointMake((p1.x + p2.x) * 0.5, (p1.y + p2.y) * 0.5);
+        return true;
+    }
+    if (std::fabs(denominator) < DBL_EPSILON) {
+        return false;
+    }
+    CGFloat uA = numeratorA / denominator;
+    CGFloat uB = numeratorB / denominator;
+    if (uA < 0 || uA > 1 || uB < 0 || uB > 1) {
+        return false;
+    }
+    intersection = CGPointMake(p1.x + uA * (p2.x - p1.x), p1.y + uA * (p2.y - p1.y));
+    return true;
+}
+
+// A transcription of the square mode of `-[RSKImageCropViewController layoutImageScrollView]`, which searched for the
+// points where the rotated left edge of the mask crosses the mask.
+CGRect ReferenceSquareMovementRect(CGRect initialRect, CGFloat rotationAngle)
+{
+    CGPoint pivot = CGPointMake(CGRectGetMidX(initialRect), CGRectGetMidY(initialRect));
+    CGFloat alpha = std::fabs(rotationAngle);
+    CGPoint start = ReferenceRotatePoint(CGPointMake(CGRectGetMinX(initialRect), CGRectGetMinY(initialRect)), pivot, alpha);
+    CGPoint end = ReferenceRotatePoint(CGPointMake(CGRectGetMinX(initialRect), CGRectGetMaxY(initialRect)), pivot, alpha);
+
+    const CGPoint edges[4][2] = {
+        { { CGRectGetMinX(initialRect), CGRectGetMinY(initialRect) }, { CGRectGetMaxX(initialRect), CGRectGetMinY(initialRect) } },
+        { { CGRectGetMaxX(initialRect), CGRectGetMinY(initialRect) }, { CGRectGetMaxX(initialRect), CGRectGetMaxY(initialRect) } },
+        { { CGRectGetMinX(initialRect), CGRectGetMaxY(initialRect) }, { CGRectGetMaxX(initialRect), CGRectGetMaxY(initialRect) } },
+        { { CGRectGetMinX(initialRect), CGRectGetMinY(initialRect) }, { CGRectGetMinX(initialRect), CGRectGetMaxY(initialRect) } },
+    };
+    CGPoint points[4];
+    size_t pointCount = 0;
+    for (const auto &edge : edges) {
+        if (ReferenceIntersectSegments(edge[0], edge[1], start, end, points[pointCount])) {
+            pointCount++;
+        }
+    }
+    if (pointCount <= 1) {
+        return initialRect;
+    }
+
+    if ((alpha > M_PI_2) && (alpha < M_PI)) {
+        alpha = alpha - M_PI_2;
+    } else if ((alpha > (M_PI + M_PI_2)) && (alpha < (M_PI + M_PI))) {
+        alpha = alpha - (M_PI + M_PI_2);
+    }
+    CGFloat hypotenuse = std::sqrt(std::pow(points[0].x - points[1].x, 2) + std::pow(points[0].y - points[1].y, 2));
+    CGFloat altitude = hypotenuse * std::sin(alpha) * std::cos(alpha);
+
+    CGFloat initialWidth = CGRectGetWidth(initialRect);
+    CGFloat scale = (initialWidth + altitude * 2) / initialWidth;
+    CGAffineTransform transform = CGAffineTransformConcat(CGAffineTransformConcat(CGAffineTransformMakeTranslation(-pivot.x, -pivot.y), CGAffineTransformMakeScale(scale, scale)), CGAffineTransformMakeTranslation(pivot.x, pivot.y));
+    CGRect frame = CGRectApplyAffineTransform(initialRect, transform);
+    frame.origin.x = std::floor(CGRectGetMinX(frame));
+    frame.origin.y = std::floor(CGRectGetMinY(frame));
+    return CGRectIntegral(frame);
+}
+
+// Makes the state of a controller that the user has zoomed, scrolled and rotated.
+RSKCropGeometryInput MakeRandomInput(std::mt19937 &generator)
+{
+    std::uniform_real_distribution<CGFloat> unit(0, 1);
+    auto random = [&](CGFloat minimum, CGFloat maximum) { return minimum + (maximum - minimum) * unit(generator); };
+
+    RSKCropGeometryInput input = {};
+    input.cropMode = static_cast<RSKCropMode>(generator() % 3);
+    const CGFloat maskSize = std::round(random(100, 400));
+    input.maskRect = CGRectMake(std::round(random(0, 100)), std::round(random(0, 300)), maskSize, input.cropMode == RSKCropModeCustom ? std::round(random(100, 400)) : maskSize);
+    input.customMovementRect = input.maskRect;
+    input.rotationAngle = generator() % 4 == 0 ? 0 : random(-2 * M_PI, 2 * M_PI);
+    input.scrollViewSize = RSKCropGeometryGetMovementRect(input.cropMode, input.maskRect, input.customMovementRect, input.rotationAngle).size;
+    input.imageSize = CGSizeMake(std::round(random(100, 4000)), std::round(random(100, 4000)));
+    input.imageScale = 1 + generator() % 3;
+    input.imageOrientation = static_cast<RSKImageOrientation>(generator() % 8);
+    input.zoomScale = random(0.1, 4);
+    input.contentSize = CGSizeMake(input.imageSize.width * input.zoomScale, input.imageSize.height * input.zoomScale);
+    input.contentOffset = CGPointMake(random(-200, input.contentSize.width), random(-200, input.contentSize.height));
+    return input;
+}
+
+// Returns whether `rect` is within one point of `expectedRect`, and counts it in `exactCount` if it is equal.
+::testing::AssertionResult IsNearlyEqualRect(CGRect rect, CGRect expectedRect, CGFloat imageScale, size_t &exactCount)
+{
+    const CGFloat tolerance = imageScale + 1e-6;
+    if (std::fabs(rect.origin.x - expectedRect.origin.x) > tolerance || std::fabs(rect.origin.y - expectedRect.origin.y) > tolerance ||
+        std::fabs(rect.size.width - expectedRect.size.width) > tolerance || std::fabs(rect.size.height - expectedRect.size.height) > tolerance) {
+        return ::testing::AssertionFailure() << "(" << rect.origin.x << ", " << rect.origin.y << ", " << rect.size.width << ", " << rect.size.height << ") != ("
+                                             << expectedRect.origin.x << ", " << expectedRect.origin.y << ", " << expectedRect.size.width << ", " << expectedRect.size.height << ")";
+    }
+    exactCount += CGRectEqualToRect(rect, expectedRect);
+    return ::testing::AssertionSuccess();
+}
+
+} // namespace
+
+TEST(RSKCropGeometry, SolvesUnrotatedCrop)
+{
+    RSKCropGeometryInput input = {};
+    input.cropMode = RSKCropModeSquare;
+    input.maskRect = CGRectMake(20, 40, 300, 300);
+    input.scrollViewSize = CGSizeMake(300, 300);
+    input.contentOffset = CGPointMake(50, 70);
+    input.contentSize = CGSizeMake(1000, 800);
+    input.zoomScale = 2;
+    input.imageSize = CGSizeMake(500, 400);
+    input.imageScale = 2;
+    input.imageOrientation = RSKImageOrientationUp;
+
+    RSKCropGeometry geometry = RSKCropGeometrySolve(&input);
+    EXPECT_TRUE(CGRectEqualToRect(geometry.cropRect, CGRectMake(50, 70, 300, 300)));
+    EXPECT_TRUE(CGRectEqualToRect(geometry.imageRect, CGRectMake(50, 70, 300, 300)));
+    EXPECT_TRUE(CGRectEqualToRect(geometry.movementRect, input.maskRect));
+
+    input.imageOrientation = RSKImageOrientationRight;
+    geometry = RSKCropGeometrySolve(&input);
+    EXPECT_TRUE(CGRectEqualToRect(geometry.imageRect, CGRectMake(70, 2 * (500 - 150 - 25), 300, 300)));
+
+    input.zoomScale = 0;
+    geometry = RSKCropGeometrySolve(&input);
+    EXPECT_TRUE(CGRectEqualToRect(geometry.cropRect, CGRectZero));
+}
+
+TEST(RSKCropGeometry, MatchesCropRectAndImageRectOfScrollView)
+{
+    constexpr size_t kInputCount = 20000;
+    std::mt19937 generator(20260417);
+    size_t exactCropRectCount = 0;
+    size_t exactImageRectCount = 0;
+    for (size_t i = 0; i < kInputCount; i++) {
+        const RSKCropGeometryInput input = MakeRandomInput(generator);
+        const RSKCropGeometry geometry = RSKCropGeometrySolve(&input);
+        ASSERT_TRUE(IsNearlyEqualRect(geometry.cropRect, ReferenceCropRect(input), input.imageScale, exactCropRectCount)) << i;
+        ASSERT_TRUE(IsNearlyEqualRect(geometry.imageRect, ReferenceImageRect(input), input.imageScale, exactImageRectCount)) << i;
+    }
+
+    // The solver does not round the zoom scale to `float` and finds the bounding box without rotating corners, so a
+    // coordinate that is within rounding error of an integer can round the other way.
+    EXPECT_GE(exactCropRectCount, kInputCount * 99 / 100);
+    EXPECT_GE(exactImageRectCount, kInputCount * 99 / 100);
+}
+
+TEST(RSKCropGeometry, FillsMaskWithRotatedMovementRect)
+{
+    const CGRect maskRect = CGRectMake(10, 60, 300, 300);
+    const CGRect customMovementRect = CGRectMake(0, 0, 100, 200);
+    EXPECT_TRUE(CGRectEqualToRect(RSKCropGeometryGetMovementRect(RSKCropModeSquare, maskRect, customMovementRect, 0), maskRect));
+    EXPECT_TRUE(CGRectEqualToRect(RSKCropGeometryGetMovementRect(RSKCropModeCircle, maskRect, customMovementRect, 0.5), maskRect));
+    EXPECT_TRUE(CGRectEqualToRect(RSKCropGeometryGetMovementRect(RSKCropModeCustom, maskRect, customMovementRect, 0.5), customMovementRect));
+
+    for (int step = -720; step <= 720; step++) {
+        const CGFloat rotationAngle = step * M_PI / 360;
+        const CGRect movementRect = RSKCropGeometryGetMovementRect(RSKCropModeSquare, maskRect, customMovementRect, rotationAngle);
+        ASSERT_GE(CGRectGetWidth(movementRect), CGRectGetWidth(maskRect)) << rotationAngle;
+
+        // Every corner of the mask must be within the movement rect rotated around its center, except for the point
+        // lost to rounding the rect to integers.
+        const CGAffineTransform inverseRotation = CGAffineTransformMakeRotation(-rotationAngle);
+        const CGPoint center = CGPointMake(CGRectGetMidX(movementRect), CGRectGetMidY(movementRect));
+        const CGPoint corners[] = {
+            { CGRectGetMinX(maskRect), CGRectGetMinY(maskRect) },
+            { CGRectGetMaxX(maskRect), CGRectGetMinY(maskRect) },
+            { CGRectGetMinX(maskRect), CGRectGetMaxY(maskRect) },
+            { CGRectGetMaxX(maskRect), CGRectGetMaxY(maskRect) },
+        };
+        for (const CGPoint &corner : corners) {
+            CGPoint point = CGPointApplyAffineTransform(CGPointMake(corner.x - center.x, corner.y - center.y), inverseRotation);
+            EXPECT_LE(std::fabs(point.x), CGRectGetWidth(movementRect) * 0.5 + 1) << rotationAngle;
+            EXPECT_LE(std::fabs(point.y), CGRectGetHeight(movementRect) * 0.5 + 1) << rotationAngle;
+        }
+    }
+}
+
+TEST(RSKCropGeometry, GrowsSquareMovementRectLikeIntersectionSearch)
+{
+    // The angles of the controller are in `[-pi, pi]`, which the search handled by folding quadrants.
+    constexpr int kStepCount = 36000;
+    const CGRect maskRects[] = { CGRectMake(0, 0, 100, 100), CGRectMake(20, 180, 335, 335), CGRectMake(7.5, 3.25, 1024, 1024) };
+    for (const CGRect &maskRect : maskRects) {
+        for (int step = -kStepCount; step <= kStepCount; step++) {
+            const CGFloat rotationAngle = step * M_PI / kStepCount;
+            const CGRect movementRect = RSKCropGeometryGetMovementRect(RSKCropModeSquare, maskRect, CGRectNull, rotationAngle);
+            const CGRect expectedMovementRect = ReferenceSquareMovementRect(maskRect, rotationAngle);
+            ASSERT_NEAR(CGRectGetMinX(movementRect), CGRectGetMinX(expectedMovementRect), 1) << rotationAngle;
+            ASSERT_NEAR(CGRectGetMinY(movementRect), CGRectGetMinY(expectedMovementRect), 1) << rotationAngle;
+            ASSERT_NEAR(CGRectGetWidth(movementRect), CGRectGetWidth(expectedMovementRect), 1) << rotationAngle;
+            ASSERT_NEAR(CGRectGetHeight(movementRect), CGRectGetHeight(expectedMovementRect), 1) << rotationAngle;
+        }
+    }
+}
+
+TEST(RSKCropGeometry, GrowsSquareMovementRectForRotationOfTransform)
+{
+    // Like the ticks of a rotation gesture, which rotate the transform of the image scroll view by small steps.
+    const CGRect maskRect = CGRectMake(20, 180, 335, 335);
+    CGAffineTransform transform = CGAffineTransformIdentity;
+    EXPECT_TRUE(CGRectEqualToRect(RSKCropGeometryGetMovementRectForRotation(RSKCropModeSquare, maskRect, CGRectNull, { transform.b, transform.a }), maskRect));
+    for (int tick = 0; tick < 2000; tick++) {
+        transform = CGAffineTransformRotate(transform, 0.0123);
+        const CGFloat rotationAngle = std::atan2(transform.b, transform.a);
+        const CGRect movementRect = RSKCropGeometryGetMovementRectForRotation(RSKCropModeSquare, maskRect, CGRectNull, { transform.b, transform.a });
+        const CGRect expectedMovementRect = RSKCropGeometryGetMovementRect(RSKCropModeSquare, maskRect, CGRectNull, rotationAngle);
+        ASSERT_NEAR(CGRectGetMinX(movementRect), CGRectGetMinX(expectedMovementRect), 1) << rotationAngle;
+        ASSERT_NEAR(CGRectGetMinY(movementRect), CGRectGetMinY(expectedMovementRect), 1) << rotationAngle;
+        ASSERT_NEAR(CGRectGetWidth(movementRect), CGRectGetWidth(expectedMovementRect), 1) << rotationAngle;
+        ASSERT_NEAR(CGRectGetHeight(movementRect), CGRectGetHeight(expectedMovementRect), 1) << rotationAngle;
+    }
+}
+
+TEST(RSKCropGeometry, CoversRotatedRectOfAnyAspectRatio)
+{
+    const CGSize sizes[] = { CGSizeMake(100, 100), CGSizeMake(400, 100), CGSizeMake(90, 160) };
+    const CGFloat tolerance = CGFLOAT_IS_DOUBLE ? 1e-9 : 1e-5;
+    for (const CGSize &size : sizes) {
+        for (int step = -720; step <= 720; step++) {
+            const CGFloat rotationAngle = step * M_PI / 180;
+            const CGFloat scale = RSKCropGeometryGetCoveringScale(size, rotationAngle);
+
+            // Every corner is within the scaled rect rotated by the angle, and at least one of them touches its edges.
+            const CGAffineTransform inverseRotation = CGAffineTransformMakeRotation(-rotationAngle);
+            CGFloat maximumExtent = 0;
+            for (int corner = 0; corner < 4; corner++) {
+                const CGPoint point = CGPointApplyAffineTransform(CGPointMake((corner & 1 ? 0.5 : -0.5) * size.width, (corner & 2 ? 0.5 : -0.5) * size.height), inverseRotation);
+                const CGFloat extent = std::fmax(std::fabs(point.x) / (size.width * 0.5), std::fabs(point.y) / (size.height * 0.5));
+                maximumExtent = std::fmax(maximumExtent, extent);
+            }
+            EXPECT_NEAR(maximumExtent, scale, tolerance) << rotationAngle;
+        }
+    }
+    EXPECT_EQ(RSKCropGeometryGetCoveringScale(CGSizeZero, 1), 1);
+}
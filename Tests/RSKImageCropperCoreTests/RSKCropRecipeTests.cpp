@@ -0,0 +1,343 @@
+//
+// RSKCropRecipeTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKCropRecipe.h>
+
+#include "RSKTestImage.hpp"
+
+using rsk::test::CompareImages;
+using rsk::test::TestImage;
+
+namespace {
+
+// Like `+[UIBezierPath bezierPathWithOvalInRect:]`.
+std::vector<RSKPathElement> MakeOvalPath(CGRect rect)
+{
+    const CGFloat kappa = 0.5522847498;
+    CGFloat minX = CGRectGetMinX(rect), midX = CGRectGetMidX(rect), maxX = CGRectGetMaxX(rect);
+    CGFloat minY = CGRectGetMinY(rect), midY = CGRectGetMidY(rect), maxY = CGRectGetMaxY(rect);
+    CGFloat ox = CGRectGetWidth(rect) * 0.5 * kappa;
+    CGFloat oy = CGRectGetHeight(rect) * 0.5 * kappa;
+
+    return {
+        { RSKPathElementTypeMoveToPoint, { { maxX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { maxX, midY + oy }, { midX + ox, maxY }, { midX, maxY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX - ox, maxY }, { minX, midY + oy }, { minX, midY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { minX, midY - oy }, { midX - ox, minY }, { midX, minY } } },
+        { RSKPathElementTypeAddCurveToPoint, { { midX + ox, minY }, { maxX, midY - oy }, { maxX, midY } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// Returns a recipe of a rotated custom crop of a 97 x 83 source whose numbers need every bit of a double.
+RSKCropRecipe MakeRecipe(const std::vector<RSKPathElement> &maskPath)
+{
+    RSKCropRecipe recipe = {};
+    recipe.sourceSize = CGSizeMake(97, 83);
+    RSKCropSpec &spec = recipe.spec;
+    spec.cropMode = RSKCropModeCustom;
+    spec.cropRect = CGRectMake(1.0 / 3.0, 0.1, 61.7, 52.25);
+    spec.imageRect = CGRectMake(3, 2, 90, 80);
+    spec.rotationAngle = -0.3;
+    spec.zoomScale = 2.0 / 3.0;
+    spec.imageOrientation = RSKImageOrientationLeftMirrored;
+    spec.maskPath = { maskPath.data(), maskPath.size(), true };
+    spec.applyMaskToCroppedImage = true;
+    spec.resamplingFilter = RSKResamplingFilterBicubic;
+    return recipe;
+}
+
+std::vector<uint8_t> Write(const RSKCropRecipe &recipe, RSKCropRecipeFormat format)
+{
+    std::vector<uint8_t> data(RSKCropRecipeWrite(&recipe, format, nullptr, 0));
+    EXPECT_EQ(RSKCropRecipeWrite(&recipe, format, data.data(), data.size()), data.size());
+    return data;
+}
+
+RSKCropStatus Read(const std::string &text, RSKCropRecipe &recipe)
+{
+    static RSKPathElement elements[8];
+    return RSKCropRecipeRead(text.data(), text.size(), elements, 8, &recipe);
+}
+
+bool HaveSameBits(CGFloat value1, CGFloat value2)
+{
+    return std::memcmp(&value1, &value2, sizeof(CGFloat)) == 0;
+}
+
+void ExpectSameRecipes(const RSKCropRecipe &recipe1, const RSKCropRecipe &recipe2)
+{
+    const RSKCropSpec &spec1 = recipe1.spec;
+    const RSKCropSpec &spec2 = recipe2.spec;
+    EXPECT_TRUE(HaveSameBits(recipe1.sourceSize.width, recipe2.sourceSize.width));
+    EXPECT_TRUE(HaveSameBits(recipe1.sourceSize.height, recipe2.sourceSize.height));
+    EXPECT_EQ(spec1.cropMode, spec2.cropMode);
+    EXPECT_EQ(0, std::memcmp(&spec1.cropRect, &spec2.cropRect, sizeof(CGRect)));
+    EXPECT_EQ(0, std::memcmp(&spec1.imageRect, &spec2.imageRect, sizeof(CGRect)));
+    EXPECT_TRUE(HaveSameBits(spec1.rotationAngle, spec2.rotationAngle));
+    EXPECT_TRUE(HaveSameBits(spec1.zoomScale, spec2.zoomScale));
+    EXPECT_EQ(spec1.imageOrientation, spec2.imageOrientation);
+    EXPECT_EQ(spec1.maskPath.usesEvenOddFillRule, spec2.maskPath.usesEvenOddFillRule);
+    EXPECT_EQ(spec1.applyMaskToCroppedImage, spec2.applyMaskToCroppedImage);
+    EXPECT_EQ(spec1.resamplingFilter, spec2.resamplingFilter);
+    EXPECT_EQ(0, std::memcmp(&spec1.outputSize, &spec2.outputSize, sizeof(CGSize)));
+    ASSERT_EQ(spec1.maskPath.elementCount, spec2.maskPath.elementCount);
+    for (size_t index = 0; index < spec1.maskPath.elementCount; index++) {
+        const RSKPathElement &element1 = spec1.maskPath.elements[index];
+        const RSKPathElement &element2 = spec2.maskPath.elements[index];
+        EXPECT_EQ(element1.type, element2.type);
+        const size_t pointCount = element1.type == RSKPathElementTypeCloseSubpath ? 0 : element1.type == RSKPathElementTypeAddCurveToPoint ? 3 : element1.type == RSKPathElementTypeAddQuadCurveToPoint ? 2 : 1;
+        EXPECT_EQ(0, std::memcmp(element1.points, element2.points, pointCount * sizeof(CGPoint))) << index;
+    }
+}
+
+TestImage Crop(TestImage &source, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+} // namespace
+
+TEST(RSKCropRecipe, KeepsEveryBitOfSpecInBothFormats)
+{
+    std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0.1, 0.2, 60.7, 50.3));
+    maskPath.insert(maskPath.end() - 1, { RSKPathElementTypeAddQuadCurveToPoint, { { 1e-300, -7.25e6 }, { 3.5, 1.0 / 7.0 } } });
+    maskPath.insert(maskPath.end() - 1, { RSKPathElementTypeAddLineToPoint, { { -0.0, 2.2250738585072014e-308 } } });
+    RSKCropRecipe recipe = MakeRecipe(maskPath);
+    recipe.spec.outputSize = CGSizeMake(31, 26);
+
+    for (RSKCropRecipeFormat format : { RSKCropRecipeFormatBinary, RSKCropRecipeFormatJSON }) {
+        const std::vector<uint8_t> data = Write(recipe, format);
+        RSKPathElement elements[8];
+        RSKCropRecipe readRecipe = {};
+        ASSERT_EQ(RSKCropRecipeRead(data.data(), data.size(), elements, 8, &readRecipe), RSKCropStatusSuccess) << format;
+        EXPECT_EQ(readRecipe.spec.maskPath.elements, elements);
+        ExpectSameRecipes(readRecipe, recipe);
+    }
+
+    // The binary recipe takes a byte for every enum and element type and 8 for every number.
+    EXPECT_EQ(Write(recipe, RSKCropRecipeFormatBinary).size(), 9u + 14 * 8 + 4 + 8 * 1 + 16 * (1 + 1 + 3 * 4 + 2));
+}
+
+TEST(RSKCropRecipe, WritesReadableJSON)
+{
+    const std::vector<RSKPathElement> maskPath = { { RSKPathElementTypeMoveToPoint, { { 1, 2 } } }, { RSKPathElementTypeCloseSubpath, {} } };
+    RSKCropRecipe recipe = MakeRecipe(maskPath);
+    recipe.spec.cropRect = CGRectMake(0.5, 0, 60, 50);
+    recipe.spec.zoomScale = 0.25;
+    const std::vector<uint8_t> data = Write(recipe, RSKCropRecipeFormatJSON);
+    EXPECT_EQ(std::string(data.begin(), data.end()),
+              "{\"version\":1,\"sourceSize\":[97,83],\"cropMode\":\"custom\",\"cropRect\":[0.5,0,60,50],\"imageRect\":[3,2,90,80],"
+              "\"rotationAngle\":-0.3,\"zoomScale\":0.25,\"imageOrientation\":\"leftMirrored\","
+              "\"maskPath\":{\"usesEvenOddFillRule\":true,\"elements\":[[\"move\",1,2],[\"close\"]]},"
+              "\"applyMaskToCroppedImage\":true,\"resamplingFilter\":\"bicubic\",\"outputSize\":[0,0]}");
+
+    // Like `snprintf`, a buffer that is too small receives what fits and the length tells how much room is needed.
+    std::vector<uint8_t> prefix(10, 0);
+    EXPECT_EQ(RSKCropRecipeWrite(&recipe, RSKCropRecipeFormatJSON, prefix.data(), prefix.size()), data.size());
+    EXPECT_TRUE(std::equal(prefix.begin(), prefix.end(), data.begin()));
+
+    recipe.spec.rotationAngle = NAN;
+    EXPECT_EQ(RSKCropRecipeWrite(&recipe, RSKCropRecipeFormatJSON, nullptr, 0), 0u);
+}
+
+TEST(RSKCropRecipe, ReadsJSONOfLaterVersionsAndDefaults)
+{
+    // Fields that a later version adds are skipped, and fields that are left out are zero.
+    RSKCropRecipe recipe = {};
+    ASSERT_EQ(Read(" {\"future\": {\"a\": [1, \"}\", null, {\"b\": false}]}, \"version\": 1,\n \"cropRect\": [ 1, 2, 3e1, 4 ], \"zoomScale\": 1.5E-1 }\n", recipe), RSKCropStatusSuccess);
+    EXPECT_EQ(recipe.spec.cropMode, RSKCropModeCircle);
+    EXPECT_TRUE(CGRectEqualToRect(recipe.spec.cropRect, CGRectMake(1, 2, 30, 4)));
+    EXPECT_EQ(recipe.spec.zoomScale, static_cast<CGFloat>(0.15));
+    EXPECT_EQ(recipe.spec.maskPath.elementCount, 0u);
+    EXPECT_EQ(recipe.spec.maskPath.elements, nullptr);
+
+    EXPECT_EQ(Read("{\"version\":2,\"cropMode\":\"hexagon\"}", recipe), RSKCropStatusUnsupportedFormat);
+    EXPECT_EQ(Read("{\"cropRect\":[0,0,1,1]}", recipe), RSKCropStatusUnsupportedFormat);
+    EXPECT_EQ(Read("[1]", recipe), RSKCropStatusUnsupportedFormat);
+    EXPECT_EQ(Read("", recipe), RSKCropStatusUnsupportedFormat);
+
+    const char *const malformedRecipes[] = {
+        "{\"version\":1",
+        "{\"version\":1,}",
+        "{\"version\":1} {}",
+        "{\"version\":1,\"cropMode\":\"hexagon\"}",
+        "{\"version\":1,\"cropMode\":1}",
+        "{\"version\":1,\"cropRect\":[0,0,1]}",
+        "{\"version\":1,\"cropRect\":[0,0,1,1,1]}",
+        "{\"version\":1,\"zoomScale\":+1}",
+        "{\"version\":1,\"zoomScale\":1..5}",
+        "{\"version\":1,\"zoomScale\":1e999}",
+        "{\"version\":1,\"applyMaskToCroppedImage\":yes}",
+        "{\"version\":1,\"maskPath\":{\"elements\":[[\"line\",1]]}}",
+        "{\"version\":1,\"maskPath\":{\"elements\":[[\"close\",1]]}}",
+        "{\"version\":1,\"future\":[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]}",
+    };
+    for (const char *malformedRecipe : malformedRecipes) {
+        EXPECT_EQ(Read(malformedRecipe, recipe), RSKCropStatusReadFailed) << malformedRecipe;
+    }
+}
+
+TEST(RSKCropRecipe, RejectsMalformedBinaryRecipes)
+{
+    const std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0, 0, 60, 50));
+    const std::vector<uint8_t> data = Write(MakeRecipe(maskPath), RSKCropRecipeFormatBinary);
+    RSKPathElement elements[8];
+    RSKCropRecipe recipe = {};
+
+    // Every truncation is rejected, without reading beyond the data.
+    for (size_t length = 4; length < data.size(); length++) {
+        const std::vector<uint8_t> truncatedData(data.begin(), data.begin() + length);
+        EXPECT_EQ(RSKCropRecipeRead(truncatedData.data(), truncatedData.size(), elements, 8, &recipe), RSKCropStatusReadFailed) << length;
+    }
+    std::vector<uint8_t> longerData = data;
+    longerData.push_back(0);
+    EXPECT_EQ(RSKCropRecipeRead(longerData.data(), longerData.size(), elements, 8, &recipe), RSKCropStatusReadFailed);
+
+    std::vector<uint8_t> laterData = data;
+    laterData[4] = RSK_CROP_RECIPE_VERSION + 1;
+    EXPECT_EQ(RSKCropRecipeRead(laterData.data(), laterData.size(), elements, 8, &recipe), RSKCropStatusUnsupportedFormat);
+
+    // Bytes 5 to 8 are the crop mode, the orientation, the filter and the flags; the element count follows the numbers.
+    for (size_t offset : { 5, 6, 7, 8, 9 + 14 * 8 + 3, 9 + 14 * 8 + 4 }) {
+        std::vector<uint8_t> invalidData = data;
+        invalidData[offset] = 0xFF;
+        EXPECT_EQ(RSKCropRecipeRead(invalidData.data(), invalidData.size(), elements, 8, &recipe), RSKCropStatusReadFailed) << offset;
+    }
+
+    // A path that does not fit is counted, so it can be read again with enough room.
+    recipe = {};
+    EXPECT_EQ(RSKCropRecipeRead(data.data(), data.size(), elements, 2, &recipe), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(recipe.spec.maskPath.elementCount, maskPath.size());
+    EXPECT_EQ(RSKCropRecipeRead(data.data(), data.size(), elements, recipe.spec.maskPath.elementCount, &recipe), RSKCropStatusSuccess);
+}
+
+TEST(RSKCropRecipe, RejectsNumbersThatCannotBeCropped)
+{
+    const std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0, 0, 60, 50));
+    const std::vector<uint8_t> data = Write(MakeRecipe(maskPath), RSKCropRecipeFormatBinary);
+    RSKPathElement elements[8];
+    RSKCropRecipe recipe = {};
+
+    // The numbers follow the 9 bytes of the header in the order of `MakeRecipe`, and the points of the path follow the
+    // element count and the type of the first element.
+    struct InvalidNumber {
+        size_t offset;
+        double value;
+    };
+    const size_t sourceWidth = 9, cropWidth = 9 + 4 * 8, imageY = 9 + 7 * 8, zoomScale = 9 + 11 * 8, outputHeight = 9 + 13 * 8;
+    const size_t firstPointX = 9 + 14 * 8 + 4 + 1;
+    const InvalidNumber invalidNumbers[] = {
+        { sourceWidth, -1 }, { sourceWidth, 1e15 }, { cropWidth, NAN }, { cropWidth, 1e15 }, { imageY, -INFINITY },
+        { zoomScale, 0 }, { zoomScale, -1 }, { zoomScale, INFINITY }, { outputHeight, -1 }, { outputHeight, NAN },
+        { firstPointX, 1e15 }, { firstPointX, NAN },
+    };
+    for (const InvalidNumber &invalidNumber : invalidNumbers) {
+        std::vector<uint8_t> invalidData = data;
+        uint64_t bits = 0;
+        std::memcpy(&bits, &invalidNumber.value, sizeof(bits));
+        for (size_t i = 0; i < 8; i++) {
+            invalidData[invalidNumber.offset + i] = static_cast<uint8_t>(bits >> (8 * i));
+        }
+        EXPECT_EQ(RSKCropRecipeRead(invalidData.data(), invalidData.size(), elements, 8, &recipe), RSKCropStatusReadFailed)
+            << invalidNumber.offset << ", " << invalidNumber.value;
+    }
+
+    // JSON has no NaN or infinity, and numbers beyond the range of a double are malformed, but a huge number is not.
+    EXPECT_EQ(Read("{\"version\":1,\"zoomScale\":1,\"cropRect\":[0,0,60,50]}", recipe), RSKCropStatusSuccess);
+    const char *const invalidRecipes[] = {
+        "{\"version\":1,\"zoomScale\":1,\"cropRect\":[0,0,1e15,50]}",
+        "{\"version\":1,\"zoomScale\":1,\"imageRect\":[-1e300,0,60,50]}",
+        "{\"version\":1,\"zoomScale\":1,\"sourceSize\":[-1,50]}",
+        "{\"version\":1,\"zoomScale\":1,\"outputSize\":[60,1e15]}",
+        "{\"version\":1,\"zoomScale\":1,\"maskPath\":{\"elements\":[[\"move\",1e15,0]]}}",
+        "{\"version\":1,\"zoomScale\":1,\"cropRect\":[0,0,1e400,50]}",
+        "{\"version\":1,\"zoomScale\":0}",
+        "{\"version\":1,\"zoomScale\":-1}",
+        "{\"version\":1}",
+    };
+    for (const char *invalidRecipe : invalidRecipes) {
+        EXPECT_EQ(Read(invalidRecipe, recipe), RSKCropStatusReadFailed) << invalidRecipe;
+    }
+
+    // A recipe that is rejected when it is read is not written either.
+    RSKCropRecipe unwritableRecipe = MakeRecipe(maskPath);
+    unwritableRecipe.spec.cropRect.size.width = 1e15;
+    EXPECT_EQ(RSKCropRecipeWrite(&unwritableRecipe, RSKCropRecipeFormatBinary, nullptr, 0), 0u);
+    unwritableRecipe = MakeRecipe(maskPath);
+    unwritableRecipe.spec.zoomScale = 0;
+    EXPECT_EQ(RSKCropRecipeWrite(&unwritableRecipe, RSKCropRecipeFormatJSON, nullptr, 0), 0u);
+}
+
+TEST(RSKCropRecipe, ReplaysCropIdentically)
+{
+    TestImage source = TestImage::MakePattern(97, 83);
+    const std::vector<RSKPathElement> maskPath = MakeOvalPath(CGRectMake(0.1, 0.2, 60.7, 50.3));
+    const RSKCropRecipe recipe = MakeRecipe(maskPath);
+    const TestImage expected = Crop(source, recipe.spec);
+
+    for (RSKCropRecipeFormat format : { RSKCropRecipeFormatBinary, RSKCropRecipeFormatJSON }) {
+        const std::vector<uint8_t> data = Write(recipe, format);
+        RSKPathElement elements[8];
+        RSKCropRecipe readRecipe = {};
+        ASSERT_EQ(RSKCropRecipeRead(data.data(), data.size(), elements, 8, &readRecipe), RSKCropStatusSuccess);
+
+        TestImage result(expected.Width(), expected.Height());
+        RSKBitmap sourceBitmap = source.Bitmap();
+        RSKBitmap resultBitmap = result.Bitmap();
+        ASSERT_EQ(RSKCropEngineCropRecipe(&sourceBitmap, &readRecipe, CGSizeZero, nullptr, &resultBitmap), RSKCropStatusSuccess);
+        EXPECT_EQ(0, std::memcmp(result.Pixel(0, 0), expected.Pixel(0, 0), expected.Width() * expected.Height() * 4)) << format;
+
+        // Any output size is sampled straight from the source, like a crop with that output size.
+        RSKCropSpec thumbnailSpec = recipe.spec;
+        thumbnailSpec.outputSize = CGSizeMake(24, 20);
+        const TestImage expectedThumbnail = Crop(source, thumbnailSpec);
+        TestImage thumbnail(24, 20);
+        RSKBitmap thumbnailBitmap = thumbnail.Bitmap();
+        ASSERT_EQ(RSKCropEngineCropRecipe(&sourceBitmap, &readRecipe, CGSizeMake(24, 20), nullptr, &thumbnailBitmap), RSKCropStatusSuccess);
+        EXPECT_EQ(CompareImages(thumbnail, expectedThumbnail).maximumColorDifference, 0);
+        EXPECT_EQ(CompareImages(thumbnail, expectedThumbnail).maximumAlphaDifference, 0);
+    }
+
+    // A rendition of the source with twice as many pixels gets a crop of twice the size.
+    const RSKCropSpec scaledSpec = RSKCropRecipeGetSpec(&recipe, 194, 166, CGSizeZero);
+    const CGSize size = RSKCropEngineGetOutputSize(97, 83, &recipe.spec);
+    const CGSize scaledSize = RSKCropEngineGetOutputSize(194, 166, &scaledSpec);
+    EXPECT_NEAR(scaledSize.width, size.width * 2, 1);
+    EXPECT_NEAR(scaledSize.height, size.height * 2, 1);
+    EXPECT_DOUBLE_EQ(scaledSpec.zoomScale, recipe.spec.zoomScale / 2);
+}
@@ -0,0 +1,453 @@
+//
+// RSKEncodedImageTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKEncodedImage.h>
+
+#if RSK_HAS_LIBJPEG
+#include <jpeglib.h>
+#endif
+#if RSK_HAS_LIBPNG
+#include <png.h>
+#endif
+
+#include "RSKTestImage.hpp"
+
+using rsk::test::CompareImages;
+using rsk::test::ImageDifference;
+using rsk::test::TestImage;
+
+namespace {
+
+// Returns an image of smooth gradients and soft rings, which survives JPEG compression well, with straight `alpha`.
+TestImage MakePhoto(size_t width, size_t height, uint8_t alpha)
+{
+    TestImage image(width, height);
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            uint8_t *pixel = image.Pixel(x, y);
+            const double ring = 0.5 + 0.5 * std::sin(std::hypot(x - width * 0.4, y - height * 0.6) * 0.15);
+            pixel[0] = static_cast<uint8_t>(255.0 * x / width);
+            pixel[1] = static_cast<uint8_t>(255.0 * y / height);
+            pixel[2] = static_cast<uint8_t>(255.0 * ring);
+            pixel[3] = x < width / 2 ? alpha : 255;
+        }
+    }
+    return image;
+}
+
+#if RSK_HAS_LIBPNG
+
+// Returns `image` encoded as a PNG, without its alpha channel unless `hasAlpha` is true.
+std::vector<uint8_t> EncodePNG(TestImage &image, bool interlaced, bool hasAlpha = true)
+{
+    std::vector<uint8_t> data;
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png_create_info_struct(png);
+    png_set_write_fn(png, &data, [](png_structp png, png_bytep bytes, png_size_t count) {
+        std::vector<uint8_t> &data = *static_cast<std::vector<uint8_t> *>(png_get_io_ptr(png));
+        data.insert(data.end(), bytes, bytes + count);
+    }, nullptr);
+    png_set_IHDR(png, info, static_cast<png_uint_32>(image.Width()), static_cast<png_uint_32>(image.Height()), 8, hasAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB,
+                 interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    std::vector<png_bytep> rows(image.Height());
+    for (size_t y = 0; y < image.Height(); y++) {
+        rows[y] = image.Pixel(0, y);
+    }
+    png_set_rows(png, info, rows.data());
+    png_write_png(png, info, hasAlpha ? PNG_TRANSFORM_IDENTITY : PNG_TRANSFORM_STRIP_FILLER_AFTER, nullptr);
+    png_destroy_write_struct(&png, &info);
+    return data;
+}
+
+// Returns the premultiplied pixels of the PNG in `data`, decoded as a whole.
+TestImage DecodePNG(const std::vector<uint8_t> &data)
+{
+    png_image image = {};
+    image.version = PNG_IMAGE_VERSION;
+    EXPECT_TRUE(png_image_begin_read_from_memory(&image, data.data(), data.size()));
+    image.format = PNG_FORMAT_RGBA;
+    TestImage result(image.width, image.height);
+    EXPECT_TRUE(png_image_finish_read(&image, nullptr, result.Pixel(0, 0), 0, nullptr));
+    for (size_t y = 0; y < result.Height(); y++) {
+        for (size_t x = 0; x < result.Width(); x++) {
+            uint8_t *pixel = result.Pixel(x, y);
+            for (size_t c = 0; c < 3; c++) {
+                pixel[c] = static_cast<uint8_t>((pixel[c] * pixel[3] + 127) / 255);
+            }
+        }
+    }
+    return result;
+}
+
+#endif
+
+#if RSK_HAS_LIBJPEG
+
+std::vector<uint8_t> EncodeJPEG(TestImage &image)
+{
+    jpeg_compress_struct info;
+    jpeg_error_mgr error;
+    info.err = jpeg_std_error(&error);
+    jpeg_create_compress(&info);
+    unsigned char *buffer = nullptr;
+    unsigned long length = 0;
+    jpeg_mem_dest(&info, &buffer, &length);
+    info.image_width = static_cast<JDIMENSION>(image.Width());
+    info.image_height = static_cast<JDIMENSION>(image.Height());
+    info.input_components = 4;
+    info.in_color_space = JCS_EXT_RGBA;
+    jpeg_set_defaults(&info);
+    jpeg_set_quality(&info, 90, TRUE);
+    jpeg_start_compress(&info, TRUE);
+    while (info.next_scanline < info.image_height) {
+        JSAMPROW row = image.Pixel(0, info.next_scanline);
+        jpeg_write_scanlines(&info, &row, 1);
+    }
+    jpeg_finish_compress(&info);
+    jpeg_destroy_compress(&info);
+
+    std::vector<uint8_t> data(buffer, buffer + length);
+    free(buffer);
+    return data;
+}
+
+// Returns the pixels of the JPEG in `data`, decoded as a whole. Without `smoothsChroma`, every chroma sample is
+// repeated rather than blended with its neighbors, so the pixels of a block only depend on the blocks of its MCU.
+TestImage DecodeJPEG(const std::vector<uint8_t> &data, bool smoothsChroma = true)
+{
+    jpeg_decompress_struct info;
+    jpeg_error_mgr error;
+    info.err = jpeg_std_error(&error);
+    jpeg_create_decompress(&info);
+    jpeg_mem_src(&info, data.data(), static_cast<unsigned long>(data.size()));
+    jpeg_read_header(&info, TRUE);
+    info.out_color_space = JCS_EXT_RGBA;
+    info.do_fancy_upsampling = smoothsChroma ? TRUE : FALSE;
+    jpeg_start_decompress(&info);
+    TestImage result(info.output_width, info.output_height);
+    while (info.output_scanline < info.output_height) {
+        JSAMPROW row = result.Pixel(0, info.output_scanline);
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+    return result;
+}
+
+#endif
+
+RSKCropSpec MakeCropSpec(CGRect imageRect, RSKImageOrientation imageOrientation)
+{
+    const bool swapsDimensions = imageOrientation == RSKImageOrientationLeft || imageOrientation == RSKImageOrientationRight ||
+                                 imageOrientation == RSKImageOrientationLeftMirrored || imageOrientation == RSKImageOrientationRightMirrored;
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeSquare;
+    spec.imageRect = imageRect;
+    spec.cropRect = swapsDimensions ? CGRectMake(0, 0, imageRect.size.height, imageRect.size.width) : CGRectMake(0, 0, imageRect.size.width, imageRect.size.height);
+    spec.zoomScale = 1;
+    spec.imageOrientation = imageOrientation;
+    return spec;
+}
+
+// The specs that the encoded images are cropped with: an upright part that does not start on a block of a JPEG, a
+// rotated part of an oriented image, and a part that is scaled down by 5.
+std::vector<RSKCropSpec> MakeCropSpecs()
+{
+    RSKCropSpec rotatedSpec = MakeCropSpec(CGRectMake(101, 37, 150, 110), RSKImageOrientationRight);
+    rotatedSpec.applyMaskToCroppedImage = true;
+    rotatedSpec.rotationAngle = 0.3;
+
+    RSKCropSpec scaledSpec = MakeCropSpec(CGRectMake(40, 20, 200, 160), RSKImageOrientationUp);
+    scaledSpec.outputSize = CGSizeMake(40, 32);
+
+    return { MakeCropSpec(CGRectMake(77, 45, 150, 110), RSKImageOrientationUp), rotatedSpec, scaledSpec };
+}
+
+TestImage Crop(TestImage &source, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+TestImage CropEncodedImage(const std::vector<uint8_t> &data, const RSKCropSpec &spec)
+{
+    size_t width = 0, height = 0;
+    EXPECT_EQ(RSKEncodedImageGetSize(data.data(), data.size(), &width, &height), RSKCropStatusSuccess);
+    CGSize size = RSKCropEngineGetOutputSize(width, height, &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(data.data(), data.size(), &spec, nullptr, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+} // namespace
+
+TEST(RSKEncodedImage, RecognizesFormatsBySignature)
+{
+    const uint8_t jpeg[] = { 0xFF, 0xD8, 0xFF, 0xE0 };
+    const uint8_t text[] = { 'G', 'I', 'F', '8', '9', 'a' };
+
+#if RSK_HAS_LIBPNG
+    TestImage image = MakePhoto(16, 16, 255);
+    const std::vector<uint8_t> png = EncodePNG(image, false);
+    EXPECT_EQ(RSKEncodedImageGetFormat(png.data(), png.size()), RSKImageFormatPNG);
+#endif
+    EXPECT_EQ(RSKEncodedImageGetFormat(jpeg, sizeof(jpeg)), RSKImageFormatJPEG);
+    EXPECT_EQ(RSKEncodedImageGetFormat(text, sizeof(text)), RSKImageFormatUnknown);
+    EXPECT_EQ(RSKEncodedImageGetFormat(jpeg, 2), RSKImageFormatUnknown);
+    EXPECT_EQ(RSKEncodedImageGetFormat(nullptr, 0), RSKImageFormatUnknown);
+
+    size_t width = 0, height = 0;
+    EXPECT_EQ(RSKEncodedImageGetSize(text, sizeof(text), &width, &height), RSKCropStatusUnsupportedFormat);
+    EXPECT_FALSE(RSKEncodedImageIsOpaque(text, sizeof(text)));
+}
+
+#if RSK_HAS_LIBJPEG
+
+TEST(RSKEncodedImage, CropsJpegLikeDecodedImage)
+{
+    TestImage photo = MakePhoto(300, 200, 255);
+    const std::vector<uint8_t> data = EncodeJPEG(photo);
+    TestImage decoded = DecodeJPEG(data);
+
+    size_t width = 0, height = 0;
+    ASSERT_EQ(RSKEncodedImageGetSize(data.data(), data.size(), &width, &height), RSKCropStatusSuccess);
+    EXPECT_TRUE(RSKEncodedImageIsOpaque(data.data(), data.size()));
+    EXPECT_EQ(width, 300u);
+    EXPECT_EQ(height, 200u);
+
+    for (const RSKCropSpec &spec : MakeCropSpecs()) {
+        TestImage expected = Crop(decoded, spec);
+        TestImage result = CropEncodedImage(data, spec);
+        ASSERT_EQ(result.Width(), expected.Width());
+        ASSERT_EQ(result.Height(), expected.Height());
+
+        // Only the columns and rows of blocks that are read are decoded, which leaves every decoded pixel as it is. A
+        // scaled crop is decoded at 1/4 of the size instead, which averages the pixels in another way.
+        const ImageDifference difference = CompareImages(result, expected);
+        if (spec.outputSize.width > 0) {
+            EXPECT_LT(difference.meanColorDifference, 3.0);
+            EXPECT_LE(difference.maximumColorDifference, 16);
+        } else {
+            EXPECT_EQ(difference.maximumColorDifference, 0);
+        }
+        EXPECT_EQ(difference.maximumAlphaDifference, 0);
+    }
+}
+
+TEST(RSKEncodedImage, MovesJpegBlocksForQuarterTurns)
+{
+    // The crop starts and ends on the 16 x 16 MCUs of the chroma-subsampled JPEG, and far enough down that more than
+    // 64 KB of its data are read before the rows below the crop are cut off.
+    TestImage photo = MakePhoto(960, 720, 255);
+    const std::vector<uint8_t> data = EncodeJPEG(photo);
+    TestImage decoded = DecodeJPEG(data, false);
+
+    for (int orientation = RSKImageOrientationUp; orientation <= RSKImageOrientationRightMirrored; orientation++) {
+        for (int quarterTurns = 0; quarterTurns < 4; quarterTurns++) {
+            RSKCropSpec spec = MakeCropSpec(CGRectMake(608, 480, 160, 96), static_cast<RSKImageOrientation>(orientation));
+            if (quarterTurns % 2 == 1) {
+                spec.cropRect.size = CGSizeMake(spec.cropRect.size.height, spec.cropRect.size.width);
+            }
+            spec.rotationAngle = quarterTurns * M_PI_2;
+
+            RSKEncodedData result = {};
+            ASSERT_EQ(RSKCropEngineCropEncodedImageToJPEG(data.data(), data.size(), &spec, nullptr, &result), RSKCropStatusSuccess);
+            EXPECT_TRUE(result.isLossless);
+            TestImage resultImage = DecodeJPEG(std::vector<uint8_t>(static_cast<uint8_t *>(result.data), static_cast<uint8_t *>(result.data) + result.length), false);
+            RSKEncodedDataFree(&result);
+
+            TestImage expected = Crop(decoded, spec);
+            ASSERT_EQ(resultImage.Width(), expected.Width());
+            ASSERT_EQ(resultImage.Height(), expected.Height());
+
+            // Moving the blocks keeps their coefficients, but a flipped block rounds differently in the inverse DCT.
+            const ImageDifference difference = CompareImages(resultImage, expected);
+            if (orientation == RSKImageOrientationUp && quarterTurns == 0) {
+                EXPECT_EQ(difference.maximumColorDifference, 0);
+            } else {
+                EXPECT_LT(difference.meanColorDifference, 0.1) << orientation << ", " << quarterTurns;
+                EXPECT_LE(difference.maximumColorDifference, 3) << orientation << ", " << quarterTurns;
+            }
+        }
+    }
+}
+
+TEST(RSKEncodedImage, SnapsJpegCropsToBlocksOrEncodesThemAgain)
+{
+    TestImage photo = MakePhoto(320, 240, 255);
+    const std::vector<uint8_t> data = EncodeJPEG(photo);
+    TestImage decoded = DecodeJPEG(data, false);
+    const auto decodeResult = [](RSKEncodedData &result) {
+        TestImage image = DecodeJPEG(std::vector<uint8_t>(static_cast<uint8_t *>(result.data), static_cast<uint8_t *>(result.data) + result.length), false);
+        RSKEncodedDataFree(&result);
+        return image;
+    };
+
+    // The crop does not start on an MCU, so it is decoded and encoded again.
+    const RSKCropSpec spec = MakeCropSpec(CGRectMake(40, 50, 150, 100), RSKImageOrientationUp);
+    RSKEncodedData result = {};
+    ASSERT_EQ(RSKCropEngineCropEncodedImageToJPEG(data.data(), data.size(), &spec, nullptr, &result), RSKCropStatusSuccess);
+    EXPECT_FALSE(result.isLossless);
+    TestImage encodedAgain = DecodeJPEG(std::vector<uint8_t>(static_cast<uint8_t *>(result.data), static_cast<uint8_t *>(result.data) + result.length));
+    RSKEncodedDataFree(&result);
+    TestImage smoothlyDecoded = DecodeJPEG(data);
+    TestImage expected = Crop(smoothlyDecoded, spec);
+    ASSERT_EQ(encodedAgain.Width(), 150u);
+    ASSERT_EQ(encodedAgain.Height(), 100u);
+    EXPECT_LT(CompareImages(encodedAgain, expected).meanColorDifference, 3.0);
+
+    // Snapped to the MCUs, it grows up and to the left by the offset of its origin in its MCU.
+    RSKJPEGCropOptions options = {};
+    options.snapsToBlocks = true;
+    ASSERT_EQ(RSKCropEngineCropEncodedImageToJPEG(data.data(), data.size(), &spec, &options, &result), RSKCropStatusSuccess);
+    EXPECT_TRUE(result.isLossless);
+    TestImage snapped = decodeResult(result);
+    TestImage expectedSnapped = Crop(decoded, MakeCropSpec(CGRectMake(32, 48, 158, 102), RSKImageOrientationUp));
+    ASSERT_EQ(snapped.Width(), 158u);
+    ASSERT_EQ(snapped.Height(), 102u);
+    EXPECT_EQ(CompareImages(snapped, expectedSnapped).maximumColorDifference, 0);
+
+    // A crop that rotates by another angle cannot be snapped.
+    RSKCropSpec rotatedSpec = MakeCropSpec(CGRectMake(32, 48, 160, 96), RSKImageOrientationUp);
+    rotatedSpec.rotationAngle = 0.3;
+    ASSERT_EQ(RSKCropEngineCropEncodedImageToJPEG(data.data(), data.size(), &rotatedSpec, &options, &result), RSKCropStatusSuccess);
+    EXPECT_FALSE(result.isLossless);
+    RSKEncodedDataFree(&result);
+    EXPECT_EQ(result.data, nullptr);
+
+    options.quality = 101;
+    EXPECT_EQ(RSKCropEngineCropEncodedImageToJPEG(data.data(), data.size(), &spec, &options, &result), RSKCropStatusInvalidArgument);
+#if RSK_HAS_LIBPNG
+    const std::vector<uint8_t> png = EncodePNG(photo, false);
+    EXPECT_EQ(RSKCropEngineCropEncodedImageToJPEG(png.data(), png.size(), &spec, nullptr, &result), RSKCropStatusUnsupportedFormat);
+#endif
+    EXPECT_EQ(RSKCropEngineCropEncodedImageToJPEG(data.data(), 20, &spec, nullptr, &result), RSKCropStatusReadFailed);
+}
+
+TEST(RSKEncodedImage, CropsMappedFile)
+{
+    TestImage photo = MakePhoto(300, 200, 255);
+    const std::vector<uint8_t> data = EncodeJPEG(photo);
+    const std::string path = testing::TempDir() + "RSKEncodedImageTests.jpg";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    const RSKCropSpec spec = MakeCropSpecs()[0];
+    TestImage expected = CropEncodedImage(data, spec);
+    TestImage result(expected.Width(), expected.Height());
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropEncodedFile(path.c_str(), &spec, nullptr, &resultBitmap), RSKCropStatusSuccess);
+    EXPECT_EQ(CompareImages(result, expected).maximumColorDifference, 0);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(RSKCropEngineCropEncodedFile(path.c_str(), &spec, nullptr, &resultBitmap), RSKCropStatusReadFailed);
+}
+
+#endif
+
+#if RSK_WITH_CODECS && RSK_HAS_LIBPNG
+
+TEST(RSKEncodedImage, CropsPngLikeDecodedImage)
+{
+    TestImage photo = MakePhoto(300, 200, 96);
+    for (bool interlaced : { false, true }) {
+        const std::vector<uint8_t> data = EncodePNG(photo, interlaced);
+        TestImage decoded = DecodePNG(data);
+
+        for (const RSKCropSpec &spec : MakeCropSpecs()) {
+            TestImage expected = Crop(decoded, spec);
+            TestImage result = CropEncodedImage(data, spec);
+            ASSERT_EQ(result.Width(), expected.Width());
+            ASSERT_EQ(result.Height(), expected.Height());
+
+            const ImageDifference difference = CompareImages(result, expected);
+            EXPECT_EQ(difference.maximumColorDifference, 0) << "interlaced: " << interlaced;
+            EXPECT_EQ(difference.maximumAlphaDifference, 0) << "interlaced: " << interlaced;
+        }
+    }
+}
+
+TEST(RSKEncodedImage, CropsOpaquePngLikeDecodedImage)
+{
+    // A PNG without alpha is opaque, so its colors are not premultiplied, and one with an alpha channel may not be,
+    // even if all of its pixels are.
+    TestImage photo = MakePhoto(300, 200, 255);
+    const std::vector<uint8_t> data = EncodePNG(photo, false, false);
+    EXPECT_TRUE(RSKEncodedImageIsOpaque(data.data(), data.size()));
+    EXPECT_FALSE(RSKEncodedImageIsOpaque(data.data(), 20));
+    const std::vector<uint8_t> dataWithAlpha = EncodePNG(photo, false);
+    EXPECT_FALSE(RSKEncodedImageIsOpaque(dataWithAlpha.data(), dataWithAlpha.size()));
+
+    for (const RSKCropSpec &spec : MakeCropSpecs()) {
+        const ImageDifference difference = CompareImages(CropEncodedImage(data, spec), CropEncodedImage(dataWithAlpha, spec));
+        EXPECT_EQ(difference.maximumColorDifference, 0);
+        EXPECT_EQ(difference.maximumAlphaDifference, 0);
+    }
+}
+
+TEST(RSKEncodedImage, RejectsCorruptDataAndInvalidDestinations)
+{
+    TestImage photo = MakePhoto(64, 48, 255);
+    const std::vector<uint8_t> data = EncodePNG(photo, false);
+    const RSKCropSpec spec = MakeCropSpec(CGRectMake(8, 8, 32, 32), RSKImageOrientationUp);
+    TestImage result(32, 32);
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(data.data(), data.size(), &spec, nullptr, &resultBitmap), RSKCropStatusSuccess);
+
+    // The data ends in the middle of the pixels.
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(data.data(), data.size() / 2, &spec, nullptr, &resultBitmap), RSKCropStatusReadFailed);
+    // The data ends in the middle of the header.
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(data.data(), 20, &spec, nullptr, &resultBitmap), RSKCropStatusReadFailed);
+
+    TestImage wrongResult(31, 32);
+    RSKBitmap wrongResultBitmap = wrongResult.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(data.data(), data.size(), &spec, nullptr, &wrongResultBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(nullptr, 0, &spec, nullptr, &resultBitmap), RSKCropStatusInvalidArgument);
+    // The decoders only produce 8-bit components.
+    std::vector<uint16_t> deepPixels(32 * 32 * 4);
+    RSKBitmap deepResultBitmap = RSKBitmapMake(deepPixels.data(), 32, 32, 32 * 8, RSKPixelFormatRGBA16);
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(data.data(), data.size(), &spec, nullptr, &deepResultBitmap), RSKCropStatusInvalidArgument);
+
+    const uint8_t text[] = { 'G', 'I', 'F', '8', '9', 'a' };
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(text, sizeof(text), &spec, nullptr, &resultBitmap), RSKCropStatusUnsupportedFormat);
+
+#if RSK_HAS_LIBJPEG
+    const std::vector<uint8_t> jpeg = EncodeJPEG(photo);
+    EXPECT_EQ(RSKCropEngineCropEncodedImage(jpeg.data(), 20, &spec, nullptr, &resultBitmap), RSKCropStatusReadFailed);
+#endif
+}
+
+#endif
@@ -0,0 +1,357 @@
+//
+// RSKGeometryBatchTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RSKGeometryBatch.h"
+#include "RSKGeometryBatch.hpp"
+
+using rsk::AffineTransform;
+using rsk::LineSegmentArray;
+using rsk::PointArray;
+using rsk::RectArray;
+using rsk::SimdInstructionSet;
+
+namespace {
+
+const SimdInstructionSet kInstructionSets[] = {
+    SimdInstructionSet::AVX2,
+    SimdInstructionSet::NEON,
+};
+
+// Not a multiple of any vector width, so every kernel also runs its tail.
+const size_t kCount = 67;
+
+template <typename T>
+struct Points {
+    std::vector<T> x;
+    std::vector<T> y;
+
+    explicit Points(size_t count) : x(count), y(count) {}
+
+    PointArray<T> Array() { return { x.data(), y.data() }; }
+};
+
+template <typename T>
+struct Rects {
+    std::vector<T> x;
+    std::vector<T> y;
+    std::vector<T> width;
+    std::vector<T> height;
+
+    explicit Rects(size_t count) : x(count), y(count), width(count), height(count) {}
+
+    RectArray<T> Array() { return { x.data(), y.data(), width.data(), height.data() }; }
+};
+
+template <typename T>
+struct Segments {
+    Points<T> start;
+    Points<T> end;
+
+    explicit Segments(size_t count) : start(count), end(count) {}
+
+    LineSegmentArray<T> Array() { return { start.Array(), end.Array() }; }
+};
+
+template <typename T = double>
+Points<T> MakePoints(std::mt19937 &generator)
+{
+    std::uniform_real_distribution<double> distribution(-1000, 1000);
+    Points<T> points(kCount);
+    for (size_t i = 0; i < kCount; i++) {
+        points.x[i] = static_cast<T>(distribution(generator));
+        points.y[i] = static_cast<T>(distribution(generator));
+    }
+    return points;
+}
+
+// Returns random rects mixed with flipped, empty, null and nearly integral ones.
+template <typename T = double>
+Rects<T> MakeRects(std::mt19937 &generator)
+{
+    std::uniform_real_distribution<double> distribution(-1000, 1000);
+    Rects<T> rects(kCount);
+    for (size_t i = 0; i < kCount; i++) {
+        rects.x[i] = static_cast<T>(distribution(generator));
+        rects.y[i] = static_cast<T>(distribution(generator));
+        rects.width[i] = static_cast<T>(distribution(generator));
+        rects.height[i] = static_cast<T>(distribution(generator));
+        switch (i % 6) {
+            case 1:
+                rects.width[i] = 0;
+                break;
+            case 2:
+                rects.x[i] = INFINITY;
+                rects.y[i] = INFINITY;
+                rects.width[i] = 0;
+                rects.height[i] = 0;
+                break;
+            case 3:
+                rects.x[i] = std::nextafter(std::round(rects.x[i]), -INFINITY);
+                rects.width[i] = std::round(rects.width[i]) - T(1e-10);
+                break;
+            case 4:
+                rects.height[i] = std::round(rects.height[i]);
+                break;
+        }
+    }
+    return rects;
+}
+
+// Returns random segments mixed with parallel, coincident and touching ones.
+void MakeSegments(std::mt19937 &generator, Segments<double> &segments, Segments<double> &otherSegments)
+{
+    std::uniform_real_distribution<double> distribution(-100, 100);
+    for (size_t i = 0; i < kCount; i++) {
+        segments.start.x[i] = distribution(generator);
+        segments.start.y[i] = distribution(generator);
+        segments.end.x[i] = distribution(generator);
+        segments.end.y[i] = distribution(generator);
+        otherSegments.start.x[i] = distribution(generator);
+        otherSegments.start.y[i] = distribution(generator);
+        otherSegments.end.x[i] = distribution(generator);
+        otherSegments.end.y[i] = distribution(generator);
+        switch (i % 5) {
+            case 1:
+                otherSegments.start.x[i] = segments.start.x[i] + 1;
+                otherSegments.start.y[i] = segments.start.y[i];
+                otherSegments.end.x[i] = segments.end.x[i] + 1;
+                otherSegments.end.y[i] = segments.end.y[i];
+                break;
+            case 2:
+                otherSegments.start.x[i] = segments.start.x[i];
+                otherSegments.start.y[i] = segments.start.y[i];
+                otherSegments.end.x[i] = segments.end.x[i];
+                otherSegments.end.y[i] = segments.end.y[i];
+                break;
+            case 3:
+                otherSegments.start.x[i] = segments.end.x[i];
+                otherSegments.start.y[i] = segments.end.y[i];
+                break;
+        }
+    }
+}
+
+AffineTransform<double> MakeTransform(CGAffineTransform transform)
+{
+    return { transform.a, transform.b, transform.c, transform.d, transform.tx, transform.ty };
+}
+
+void ExpectNearlyEqual(const std::vector<double> &expected, const std::vector<double> &actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_DOUBLE_EQ(expected[i], actual[i]) << "at " << i;
+    }
+}
+
+} // namespace
+
+TEST(RSKGeometryBatch, MatchesScalarKernelsOnEveryInstructionSet)
+{
+    std::mt19937 generator(7);
+    Points<double> points = MakePoints(generator);
+    Rects<double> rects = MakeRects(generator);
+    Segments<double> segments(kCount);
+    Segments<double> otherSegments(kCount);
+    MakeSegments(generator, segments, otherSegments);
+    const AffineTransform<double> transform = MakeTransform(
+        CGAffineTransformTranslate(CGAffineTransformScale(CGAffineTransformMakeRotation(0.7), 1.5, -0.5), 12.25, -3.5));
+    const rsk::GeometryKernels &scalarKernels = rsk::GetGeometryKernels(SimdInstructionSet::Scalar);
+
+    Points<double> expectedPoints(kCount);
+    Rects<double> expectedRects(kCount);
+    Rects<double> expectedNormalizedRects(kCount);
+    Points<double> expectedIntersections(kCount);
+    scalarKernels.transformPoints(points.Array(), kCount, transform, expectedPoints.Array());
+    scalarKernels.transformRects(rects.Array(), kCount, transform, expectedRects.Array());
+    scalarKernels.normalizeRects(rects.Array(), kCount, expectedNormalizedRects.Array());
+    scalarKernels.intersectSegments(segments.Array(), otherSegments.Array(), kCount, expectedIntersections.Array());
+
+    for (SimdInstructionSet instructionSet : kInstructionSets) {
+        if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+            continue;
+        }
+        SCOPED_TRACE(rsk::SimdInstructionSetName(instructionSet));
+        const rsk::GeometryKernels &kernels = rsk::GetGeometryKernels(instructionSet);
+
+        // Every count up to a few vectors, so that each tail length is covered.
+        for (size_t count : { size_t(1), size_t(2), size_t(3), size_t(5), size_t(7), kCount }) {
+            SCOPED_TRACE(count);
+            Points<double> transformedPoints(count);
+            kernels.transformPoints(points.Array(), count, transform, transformedPoints.Array());
+            ExpectNearlyEqual({ expectedPoints.x.begin(), expectedPoints.x.begin() + count }, transformedPoints.x);
+            ExpectNearlyEqual({ expectedPoints.y.begin(), expectedPoints.y.begin() + count }, transformedPoints.y);
+        }
+
+        Rects<double> transformedRects(kCount);
+        kernels.transformRects(rects.Array(), kCount, transform, transformedRects.Array());
+        ExpectNearlyEqual(expectedRects.x, transformedRects.x);
+        ExpectNearlyEqual(expectedRects.y, transformedRects.y);
+        ExpectNearlyEqual(expectedRects.width, transformedRects.width);
+        ExpectNearlyEqual(expectedRects.height, transformedRects.height);
+
+        // Rounding must agree exactly, the inputs are not computed by the kernel.
+        Rects<double> normalizedRects(kCount);
+        kernels.normalizeRects(rects.Array(), kCount, normalizedRects.Array());
+        EXPECT_EQ(expectedNormalizedRects.x, normalizedRects.x);
+        EXPECT_EQ(expectedNormalizedRects.y, normalizedRects.y);
+        EXPECT_EQ(expectedNormalizedRects.width, normalizedRects.width);
+        EXPECT_EQ(expectedNormalizedRects.height, normalizedRects.height);
+
+        Points<double> intersections(kCount);
+        kernels.intersectSegments(segments.Array(), otherSegments.Array(), kCount, intersections.Array());
+        ExpectNearlyEqual(expectedIntersections.x, intersections.x);
+        ExpectNearlyEqual(expectedIntersections.y, intersections.y);
+    }
+}
+
+TEST(RSKGeometryBatch, MatchesSingleElementGeometry)
+{
+    std::mt19937 generator(11);
+    Points<CGFloat> points = MakePoints<CGFloat>(generator);
+    Rects<CGFloat> rects = MakeRects<CGFloat>(generator);
+    const CGAffineTransform transform = CGAffineTransformTranslate(CGAffineTransformMakeRotation(-2.1), 40, 7);
+    const CGFloat tolerance = CGFLOAT_IS_DOUBLE ? 1e-9 : 1e-3;
+
+    Points<CGFloat> transformedPoints(kCount);
+    RSKPointArrayApplyAffineTransform({ points.x.data(), points.y.data() }, kCount, transform,
+                                      { transformedPoints.x.data(), transformedPoints.y.data() });
+    Rects<CGFloat> transformedRects(kCount);
+    RSKRectArrayApplyAffineTransform({ rects.x.data(), rects.y.data(), rects.width.data(), rects.height.data() }, kCount, transform,
+                                     { transformedRects.x.data(), transformedRects.y.data(), transformedRects.width.data(),
+                                       transformedRects.height.data() });
+
+    for (size_t i = 0; i < kCount; i++) {
+        const CGPoint point = CGPointApplyAffineTransform(CGPointMake(points.x[i], points.y[i]), transform);
+        EXPECT_NEAR(point.x, transformedPoints.x[i], tolerance);
+        EXPECT_NEAR(point.y, transformedPoints.y[i], tolerance);
+
+        const CGRect rect = CGRectApplyAffineTransform(CGRectMake(rects.x[i], rects.y[i], rects.width[i], rects.height[i]), transform);
+        EXPECT_EQ(CGRectIsNull(rect), std::isinf(transformedRects.x[i]));
+        if (!CGRectIsNull(rect)) {
+            EXPECT_NEAR(rect.origin.x, transformedRects.x[i], tolerance);
+            EXPECT_NEAR(rect.origin.y, transformedRects.y[i], tolerance);
+            EXPECT_NEAR(rect.size.width, transformedRects.width[i], tolerance);
+            EXPECT_NEAR(rect.size.height, transformedRects.height[i], tolerance);
+        }
+    }
+}
+
+TEST(RSKGeometryBatch, RotatesPointsAroundPivotInPlace)
+{
+    CGFloat x[] = { 3, 1, -4, 0 };
+    CGFloat y[] = { 1, -1, 2, 0 };
+    const CGPoint pivot = CGPointMake(1, 1);
+    RSKPointArrayRotateAroundPoint({ x, y }, 4, pivot, M_PI_2, { x, y });
+
+    const CGFloat expectedX[] = { 1, 3, 0, 2 };
+    const CGFloat expectedY[] = { 3, 1, -4, 0 };
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_NEAR(expectedX[i], x[i], 1e-5);
+        EXPECT_NEAR(expectedY[i], y[i], 1e-5);
+    }
+}
+
+TEST(RSKGeometryBatch, IntersectsLineSegments)
+{
+    // Crossing, parallel, coincident, disjoint and touching at an end.
+    CGFloat startX[] = { 0, 0, 0, 0, 0 };
+    CGFloat startY[] = { 0, 0, 0, 0, 0 };
+    CGFloat endX[] = { 4, 4, 4, 1, 2 };
+    CGFloat endY[] = { 4, 0, 4, 1, 0 };
+    CGFloat otherStartX[] = { 0, 0, 0, 4, 2 };
+    CGFloat otherStartY[] = { 4, 1, 0, 0, 0 };
+    CGFloat otherEndX[] = { 4, 4, 4, 0, 2 };
+    CGFloat otherEndY[] = { 0, 1, 4, 4, 5 };
+    CGFloat x[5];
+    CGFloat y[5];
+    RSKLineSegmentArrayIntersect({ { startX, startY }, { endX, endY } }, { { otherStartX, otherStartY }, { otherEndX, otherEndY } }, 5,
+                                 { x, y });
+
+    EXPECT_DOUBLE_EQ(2, x[0]);
+    EXPECT_DOUBLE_EQ(2, y[0]);
+    EXPECT_TRUE(std::isinf(x[1]) && std::isinf(y[1]));
+    EXPECT_DOUBLE_EQ(2, x[2]);
+    EXPECT_DOUBLE_EQ(2, y[2]);
+    EXPECT_TRUE(std::isinf(x[3]) && std::isinf(y[3]));
+    EXPECT_DOUBLE_EQ(2, x[4]);
+    EXPECT_DOUBLE_EQ(0, y[4]);
+}
+
+TEST(RSKGeometryBatch, NormalizesRectsToleratingRoundingError)
+{
+    CGFloat x[] = { 10.4, 10 - 1e-9, 3, -2.5 };
+    CGFloat y[] = { 5.6, 5, 4 - 1e-13, -0.5 };
+    CGFloat width[] = { 100.9, 99.5, 50 - 1e-13, 7.25 };
+    CGFloat height[] = { 20.2, 20.5, 60.5, 8 };
+    RSKRectArrayNormalize({ x, y, width, height }, 4, { x, y, width, height });
+
+    // Like `RSKRectNormalize`, a coordinate within rounding error of the next integer rounds both coordinates up.
+    const CGFloat expectedX[] = { 10, 10, 3, -3 };
+    const CGFloat expectedY[] = { 5, 5, 4, -1 };
+    const CGFloat expectedWidth[] = { 100, 99, 50, 8 };
+    const CGFloat expectedHeight[] = { 20, 20, 61, 8 };
+    for (size_t i = 0; i < 4; i++) {
+        EXPECT_EQ(expectedX[i], x[i]) << "at " << i;
+        EXPECT_EQ(expectedY[i], y[i]) << "at " << i;
+        EXPECT_EQ(expectedWidth[i], width[i]) << "at " << i;
+        EXPECT_EQ(expectedHeight[i], height[i]) << "at " << i;
+    }
+}
+
+TEST(RSKGeometryBatch, SupportsSinglePrecision)
+{
+    std::mt19937 generator(13);
+    Points<double> points = MakePoints(generator);
+    Points<float> singlePoints(kCount);
+    for (size_t i = 0; i < kCount; i++) {
+        singlePoints.x[i] = static_cast<float>(points.x[i]);
+        singlePoints.y[i] = static_cast<float>(points.y[i]);
+    }
+    const CGAffineTransform transform = CGAffineTransformTranslate(CGAffineTransformMakeRotation(0.3), 5, 5);
+    const AffineTransform<float> singleTransform = {
+        static_cast<float>(transform.a), static_cast<float>(transform.b), static_cast<float>(transform.c),
+        static_cast<float>(transform.d), static_cast<float>(transform.tx), static_cast<float>(transform.ty),
+    };
+
+    Points<double> transformedPoints(kCount);
+    rsk::scalar::TransformPoints(points.Array(), kCount, MakeTransform(transform), transformedPoints.Array());
+    rsk::scalar::TransformPoints(singlePoints.Array(), kCount, singleTransform, singlePoints.Array());
+    for (size_t i = 0; i < kCount; i++) {
+        EXPECT_NEAR(transformedPoints.x[i], singlePoints.x[i], 1e-3);
+        EXPECT_NEAR(transformedPoints.y[i], singlePoints.y[i], 1e-3);
+    }
+
+    // The tolerance of single precision is a few units in the last place, not the one of double precision.
+    EXPECT_TRUE(rsk::IsNearlyCeil(3.0f - std::numeric_limits<float>::epsilon()));
+    EXPECT_FALSE(rsk::IsNearlyCeil(2.999f));
+    EXPECT_TRUE(rsk::IsNearlyCeil(2.999999999999));
+}
@@ -0,0 +1,128 @@
+//
+// RSKImagePyramidTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKImagePyramid.h>
+
+#include "RSKTestImage.hpp"
+
+using rsk::test::CompareImages;
+using rsk::test::ImageDifference;
+using rsk::test::TestImage;
+
+TEST(RSKImagePyramid, CountsLevelsDownToSmallestLevelSize)
+{
+    EXPECT_EQ(RSKImagePyramidGetLevelCount(100, 60, 16), 4u);
+    EXPECT_EQ(RSKImagePyramidGetLevelCount(60, 100, 13), 4u);
+    EXPECT_EQ(RSKImagePyramidGetLevelCount(16, 8, 16), 1u);
+    EXPECT_EQ(RSKImagePyramidGetLevelCount(8000, 6000, 0), 14u);
+    EXPECT_EQ(RSKImagePyramidGetLevelCount(0, 60, 16), 0u);
+
+    CGSize size = RSKImagePyramidGetLevelSize(100, 61, 3);
+    EXPECT_EQ(size.width, 13);
+    EXPECT_EQ(size.height, 8);
+    size = RSKImagePyramidGetLevelSize(100, 61, 200);
+    EXPECT_EQ(size.width, 1);
+    EXPECT_EQ(size.height, 1);
+}
+
+TEST(RSKImagePyramid, SelectsSmallestLevelWithPixelForEveryPixelOfScreen)
+{
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 2), 0u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 1), 0u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 0.75), 0u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 0.5), 1u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 0.26), 1u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 0.25), 2u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 0.001), 3u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(1, 0.001), 0u);
+    EXPECT_EQ(RSKImagePyramidSelectLevel(4, 0), 0u);
+}
+
+TEST(RSKImagePyramid, AveragesBlocksOfSource)
+{
+    TestImage source = TestImage::MakePattern(10, 7);
+    TestImage level(3, 2);
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap levelBitmap = level.Bitmap();
+    ASSERT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 2, nullptr, &levelBitmap), RSKCropStatusSuccess);
+
+    const uint8_t topLeft[] = { 2, 2, 0, 255 };
+    EXPECT_EQ(0, std::memcmp(level.Pixel(0, 0), topLeft, 4));
+
+    // The bottom-right block has 2 x 3 pixels inside of the source.
+    const uint8_t bottomRight[] = { 9, 5, 0, 255 };
+    EXPECT_EQ(0, std::memcmp(level.Pixel(2, 1), bottomRight, 4));
+
+    TestImage copy(10, 7);
+    RSKBitmap copyBitmap = copy.Bitmap();
+    ASSERT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 0, nullptr, &copyBitmap), RSKCropStatusSuccess);
+    EXPECT_EQ(CompareImages(copy, source).maximumColorDifference, 0);
+}
+
+TEST(RSKImagePyramid, MakesLevelConcurrentlyLikeAtOnce)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(4);
+    ASSERT_NE(pool, nullptr);
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+
+    TestImage source = TestImage::MakePattern(301, 257);
+    RSKBitmap sourceBitmap = source.Bitmap();
+    for (size_t level = 1; level < RSKImagePyramidGetLevelCount(301, 257, 1); level++) {
+        CGSize size = RSKImagePyramidGetLevelSize(301, 257, level);
+        TestImage expected(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+        TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+        RSKBitmap expectedBitmap = expected.Bitmap();
+        RSKBitmap resultBitmap = result.Bitmap();
+        ASSERT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, level, nullptr, &expectedBitmap), RSKCropStatusSuccess);
+        ASSERT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, level, &executor, &resultBitmap), RSKCropStatusSuccess);
+
+        ImageDifference difference = CompareImages(result, expected);
+        EXPECT_EQ(difference.maximumColorDifference, 0) << level;
+        EXPECT_EQ(difference.maximumAlphaDifference, 0) << level;
+    }
+
+    RSKThreadPoolDestroy(pool);
+}
+
+TEST(RSKImagePyramid, RejectsInvalidArguments)
+{
+    TestImage source = TestImage::MakePattern(10, 7);
+    TestImage level(5, 4);
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap levelBitmap = level.Bitmap();
+
+    EXPECT_EQ(RSKImagePyramidMakeLevel(nullptr, 1, nullptr, &levelBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 1, nullptr, nullptr), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 2, nullptr, &levelBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 100, nullptr, &levelBitmap), RSKCropStatusInvalidArgument);
+
+    RSKBitmap otherFormatLevel = levelBitmap;
+    otherFormatLevel.pixelFormat = RSKPixelFormatBGRA8888;
+    EXPECT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 1, nullptr, &otherFormatLevel), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKImagePyramidMakeLevel(&sourceBitmap, 1, nullptr, &levelBitmap), RSKCropStatusSuccess);
+}
@@ -0,0 +1,175 @@
+//
+// RSKImageTilesTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKImageTiles.h>
+
+namespace {
+
+RSKTileViewport MakeViewport(CGFloat x, CGFloat y, CGFloat width, CGFloat height, CGFloat zoomScale)
+{
+    RSKTileViewport viewport = {};
+    viewport.contentOffset = CGPointMake(x, y);
+    viewport.boundsSize = CGSizeMake(width, height);
+    viewport.zoomScale = zoomScale;
+    viewport.imageSize = CGSizeMake(4000, 3000);
+    viewport.screenScale = 1;
+    return viewport;
+}
+
+std::vector<RSKTileKey> VisibleTiles(const RSKTileGrid &grid, const RSKTileViewport &viewport)
+{
+    std::vector<RSKTileKey> tiles(RSKTileGridGetVisibleTiles(&grid, &viewport, nullptr, 0));
+    EXPECT_EQ(RSKTileGridGetVisibleTiles(&grid, &viewport, tiles.data(), tiles.size()), tiles.size());
+    return tiles;
+}
+
+// Keeps the tiles that a cache releases, in order.
+struct ReleasedTiles {
+    std::vector<int> tiles;
+
+    static void Release(void *context, void *tile)
+    {
+        static_cast<ReleasedTiles *>(context)->tiles.push_back(*static_cast<int *>(tile));
+    }
+};
+
+} // namespace
+
+TEST(RSKImageTiles, CutsTilesOffAtEdgesOfLevel)
+{
+    RSKTileGrid grid = RSKTileGridMake(1000, 600, 256, 200);
+    EXPECT_EQ(grid.levelCount, 4u);
+
+    CGRect rect = RSKTileGridGetTileRect(&grid, { 0, 3, 2 });
+    EXPECT_TRUE(CGRectEqualToRect(rect, CGRectMake(768, 512, 232, 88)));
+    rect = RSKTileGridGetTileRect(&grid, { 1, 1, 1 });
+    EXPECT_TRUE(CGRectEqualToRect(rect, CGRectMake(256, 256, 244, 44)));
+    rect = RSKTileGridGetTileImageRect(&grid, { 1, 1, 1 });
+    EXPECT_TRUE(CGRectEqualToRect(rect, CGRectMake(512, 512, 488, 88)));
+    EXPECT_TRUE(CGRectIsEmpty(RSKTileGridGetTileRect(&grid, { 0, 4, 0 })));
+
+    EXPECT_EQ(RSKTileGridMake(1000, 600, 0, 200).tileSize, 256u);
+}
+
+TEST(RSKImageTiles, FindsTilesOfVisiblePartAtZoomScale)
+{
+    RSKTileGrid grid = RSKTileGridMake(4000, 3000, 256, 256);
+
+    // Zoomed all the way in, a screen of 400 x 300 points shows 400 x 300 pixels of the image.
+    std::vector<RSKTileKey> tiles = VisibleTiles(grid, MakeViewport(1000, 500, 400, 300, 1));
+    ASSERT_EQ(tiles.size(), 9u);
+    for (const RSKTileKey &tile : tiles) {
+        EXPECT_EQ(tile.level, 0u);
+    }
+    EXPECT_EQ(tiles.front().column, 3u);
+    EXPECT_EQ(tiles.front().row, 1u);
+    EXPECT_EQ(tiles.back().column, 5u);
+    EXPECT_EQ(tiles.back().row, 3u);
+
+    // Zoomed out to fit, the whole image is shown from the level that has about as many pixels as the screen.
+    tiles = VisibleTiles(grid, MakeViewport(0, 0, 400, 300, 0.1));
+    ASSERT_EQ(tiles.size(), 4u);
+    EXPECT_EQ(tiles.front().level, 3u);
+    EXPECT_EQ(tiles.back().column, 1u);
+    EXPECT_EQ(tiles.back().row, 1u);
+
+    // Zoomed out past the image, the tiles stop at its edges.
+    tiles = VisibleTiles(grid, MakeViewport(-100, -100, 400, 300, 0.05));
+    for (const RSKTileKey &tile : tiles) {
+        EXPECT_FALSE(CGRectIsEmpty(RSKTileGridGetTileRect(&grid, tile)));
+    }
+
+    // A screen of 2x pixels needs a level with twice as many pixels.
+    RSKTileViewport retinaViewport = MakeViewport(0, 0, 400, 300, 0.1);
+    retinaViewport.screenScale = 2;
+    EXPECT_EQ(VisibleTiles(grid, retinaViewport).front().level, 2u);
+}
+
+TEST(RSKImageTiles, FindsNoTilesOutsideOfImage)
+{
+    RSKTileGrid grid = RSKTileGridMake(4000, 3000, 256, 256);
+    EXPECT_TRUE(VisibleTiles(grid, MakeViewport(5000, 0, 400, 300, 1)).empty());
+    EXPECT_TRUE(VisibleTiles(grid, MakeViewport(0, 0, 400, 300, 0)).empty());
+
+    // The capacity caps the tiles that are written, but not the count.
+    RSKTileViewport viewport = MakeViewport(0, 0, 1000, 1000, 1);
+    RSKTileKey tiles[2] = {};
+    EXPECT_EQ(RSKTileGridGetVisibleTiles(&grid, &viewport, tiles, 2), 16u);
+    EXPECT_EQ(tiles[1].column, 1u);
+}
+
+TEST(RSKImageTiles, EvictsLeastRecentlyUsedTilesOverBudget)
+{
+    ReleasedTiles released;
+    RSKTileCache *cache = RSKTileCacheCreate(300, ReleasedTiles::Release, &released);
+    ASSERT_NE(cache, nullptr);
+
+    int tiles[] = { 0, 1, 2, 3, 4 };
+    EXPECT_TRUE(RSKTileCacheInsertTile(cache, { 0, 0, 0 }, &tiles[0], 100));
+    EXPECT_TRUE(RSKTileCacheInsertTile(cache, { 0, 1, 0 }, &tiles[1], 100));
+    EXPECT_TRUE(RSKTileCacheInsertTile(cache, { 1, 0, 0 }, &tiles[2], 100));
+    EXPECT_EQ(RSKTileCacheGetByteCount(cache), 300u);
+
+    // Using the first tile makes the second one the least recently used.
+    EXPECT_EQ(RSKTileCacheGetTile(cache, { 0, 0, 0 }), &tiles[0]);
+    EXPECT_TRUE(RSKTileCacheInsertTile(cache, { 0, 0, 1 }, &tiles[3], 100));
+    EXPECT_EQ(released.tiles, std::vector<int>({ 1 }));
+    EXPECT_EQ(RSKTileCacheGetTile(cache, { 0, 1, 0 }), nullptr);
+    EXPECT_EQ(RSKTileCacheGetTileCount(cache), 3u);
+
+    // A tile that does not fit alone evicts everything else but is kept.
+    EXPECT_TRUE(RSKTileCacheInsertTile(cache, { 2, 0, 0 }, &tiles[4], 500));
+    EXPECT_EQ(released.tiles, std::vector<int>({ 1, 2, 0, 3 }));
+    EXPECT_EQ(RSKTileCacheGetTile(cache, { 2, 0, 0 }), &tiles[4]);
+
+    RSKTileCacheTrim(cache, 0);
+    EXPECT_EQ(RSKTileCacheGetTileCount(cache), 0u);
+    EXPECT_EQ(RSKTileCacheGetByteCount(cache), 0u);
+    RSKTileCacheDestroy(cache);
+    EXPECT_EQ(released.tiles, std::vector<int>({ 1, 2, 0, 3, 4 }));
+}
+
+TEST(RSKImageTiles, ReleasesReplacedAndRemainingTiles)
+{
+    ReleasedTiles released;
+    RSKTileCache *cache = RSKTileCacheCreate(1000, ReleasedTiles::Release, &released);
+    ASSERT_NE(cache, nullptr);
+
+    int tiles[] = { 0, 1, 2 };
+    RSKTileCacheInsertTile(cache, { 0, 0, 0 }, &tiles[0], 100);
+    RSKTileCacheInsertTile(cache, { 0, 0, 0 }, &tiles[1], 200);
+    RSKTileCacheInsertTile(cache, { 0, 0, 1 }, &tiles[2], 100);
+    EXPECT_EQ(released.tiles, std::vector<int>({ 0 }));
+    EXPECT_EQ(RSKTileCacheGetByteCount(cache), 300u);
+
+    RSKTileCacheDestroy(cache);
+    std::sort(released.tiles.begin(), released.tiles.end());
+    EXPECT_EQ(released.tiles, std::vector<int>({ 0, 1, 2 }));
+    EXPECT_EQ(RSKTileCacheCreate(1000, nullptr, nullptr), nullptr);
+}
@@ -0,0 +1,416 @@
+//
+// RSKImageTransformsTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RSKImageTransforms.hpp"
+#include "RSKMaskRasterizer.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::test::TestImage;
+
+namespace {
+
+rsk::BitmapView MakeView(TestImage &image)
+{
+    RSKBitmap bitmap = image.Bitmap();
+    return rsk::MakeBitmapView(bitmap);
+}
+
+// A mask with the coverage of a buffer, one byte for every pixel.
+class BufferCoverageMask : public rsk::CoverageMask {
+public:
+    BufferCoverageMask(std::vector<uint8_t> coverage, size_t width, size_t height)
+        : rsk::CoverageMask(width, height), coverage_(std::move(coverage))
+    {
+    }
+
+    void GetRowSpans(size_t y, rsk::CoverageSpans &spans, uint8_t *coverage) override
+    {
+        spans.clear();
+        for (size_t x = 0; x < Width(); x++) {
+            coverage[x] = coverage_[y * Width() + x];
+            if (coverage[x] != 0) {
+                spans.push_back({ x, x + 1, coverage[x] == 255 });
+            }
+        }
+    }
+
+private:
+    std::vector<uint8_t> coverage_;
+};
+
+struct OrientationCase {
+    RSKImageOrientation orientation;
+    // The source pixels that end up in the top-left and in the top-right corners of the upright image, as fractions of
+    // the last column and row of the source.
+    int topLeftX, topLeftY;
+    int topRightX, topRightY;
+};
+
+} // namespace
+
+TEST(RSKImageTransforms, OrientsBitmapForEveryOrientation)
+{
+    const OrientationCase cases[] = {
+        { RSKImageOrientationUp, 0, 0, 1, 0 },
+        { RSKImageOrientationDown, 1, 1, 0, 1 },
+        { RSKImageOrientationLeft, 1, 0, 1, 1 },
+        { RSKImageOrientationRight, 0, 1, 0, 0 },
+        { RSKImageOrientationUpMirrored, 1, 0, 0, 0 },
+        { RSKImageOrientationDownMirrored, 0, 1, 1, 1 },
+        { RSKImageOrientationLeftMirrored, 0, 0, 0, 1 },
+        { RSKImageOrientationRightMirrored, 1, 1, 1, 0 },
+    };
+
+    TestImage source = TestImage::MakePattern(7, 5);
+    const size_t lastX = source.Width() - 1;
+    const size_t lastY = source.Height() - 1;
+
+    for (const OrientationCase &testCase : cases) {
+        bool swapsDimensions = rsk::OrientationSwapsDimensions(testCase.orientation);
+        TestImage result(swapsDimensions ? source.Height() : source.Width(), swapsDimensions ? source.Width() : source.Height());
+        rsk::OrientBitmap(MakeView(source), testCase.orientation, MakeView(result));
+
+        const uint8_t *topLeft = source.Pixel(testCase.topLeftX * lastX, testCase.topLeftY * lastY);
+        const uint8_t *topRight = source.Pixel(testCase.topRightX * lastX, testCase.topRightY * lastY);
+        EXPECT_EQ(0, std::memcmp(result.Pixel(0, 0), topLeft, 4)) << testCase.orientation;
+        EXPECT_EQ(0, std::memcmp(result.Pixel(result.Width() - 1, 0), topRight, 4)) << testCase.orientation;
+    }
+}
+
+TEST(RSKImageTransforms, WarpsBitmapLikeOrientingIt)
+{
+    TestImage source = TestImage::MakePattern(7, 5);
+
+    for (int orientation = RSKImageOrientationUp; orientation <= RSKImageOrientationRightMirrored; orientation++) {
+        RSKImageOrientation imageOrientation = static_cast<RSKImageOrientation>(orientation);
+        bool swapsDimensions = rsk::OrientationSwapsDimensions(imageOrientation);
+        size_t width = swapsDimensions ? source.Height() : source.Width();
+        size_t height = swapsDimensions ? source.Width() : source.Height();
+
+        TestImage expected(width, height);
+        rsk::OrientBitmap(MakeView(source), imageOrientation, MakeView(expected));
+
+        TestImage result(width, height);
+        CGAffineTransform transform = rsk::OrientationTransform(imageOrientation, source.Width(), source.Height());
+        rsk::WarpBitmap(MakeView(source), transform, RSKResamplingFilterBilinear, nullptr, MakeView(result));
+
+        EXPECT_EQ(rsk::test::CompareImages(result, expected).maximumColorDifference, 0) << orientation;
+    }
+}
+
+TEST(RSKImageTransforms, WarpsBitmapWithCoverage)
+{
+    TestImage source = TestImage::MakePattern(4, 4);
+    TestImage destination(6, 6);
+    std::vector<uint8_t> coverage(6 * 6, 255);
+    coverage[2 * 6 + 3] = 0;
+
+    BufferCoverageMask mask(coverage, 6, 6);
+    rsk::WarpBitmap(MakeView(source), CGAffineTransformMakeTranslation(-2, -1), RSKResamplingFilterBilinear, &mask, MakeView(destination));
+
+    EXPECT_EQ(destination.Pixel(1, 1)[3], 0);
+    EXPECT_EQ(destination.Pixel(3, 2)[3], 0);
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(2, 1), source.Pixel(0, 0), 4));
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(5, 4), source.Pixel(3, 3), 4));
+    EXPECT_EQ(destination.Pixel(5, 5)[3], 0);
+}
+
+TEST(RSKImageTransforms, WarpsBitmapInTilesWhenWalkingColumns)
+{
+    // The destination is larger than a tile in both directions and not a multiple of one, so it has partial tiles.
+    TestImage source = TestImage::MakePattern(300, 200);
+    const size_t width = 200;
+    const size_t height = 300;
+    std::vector<uint8_t> coverage(width * height);
+    for (size_t i = 0; i < coverage.size(); i++) {
+        coverage[i] = i % 7 == 0 ? 0 : i % 3 == 0 ? static_cast<uint8_t>(i * 13) : 255;
+    }
+
+    TestImage orientedImage(width, height);
+    rsk::OrientBitmap(MakeView(source), RSKImageOrientationLeftMirrored, MakeView(orientedImage));
+
+    TestImage result(width, height);
+    std::memset(result.Pixel(0, 0), 0x7F, width * height * 4);
+    BufferCoverageMask mask(coverage, width, height);
+    CGAffineTransform transform = rsk::OrientationTransform(RSKImageOrientationLeftMirrored, source.Width(), source.Height());
+    rsk::WarpBitmap(MakeView(source), transform, RSKResamplingFilterBilinear, &mask, MakeView(result));
+
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            const unsigned alpha = coverage[y * width + x];
+            for (size_t c = 0; c < 4; c++) {
+                ASSERT_EQ(result.Pixel(x, y)[c], (orientedImage.Pixel(x, y)[c] * alpha + 127) / 255) << x << ", " << y;
+            }
+        }
+    }
+}
+
+TEST(RSKImageTransforms, MasksBitmapLikeWarpingWithMask)
+{
+    TestImage source = TestImage::MakePattern(60, 40);
+    const size_t width = 50;
+    const size_t height = 45;
+    std::vector<uint8_t> coverage(width * height);
+    for (size_t i = 0; i < coverage.size(); i++) {
+        coverage[i] = i % 5 == 0 ? 0 : i % 3 == 0 ? static_cast<uint8_t>(i * 13) : 255;
+    }
+    BufferCoverageMask mask(coverage, width, height);
+    CGAffineTransform transform = CGAffineTransformConcat(CGAffineTransformMakeRotation(0.3), CGAffineTransformMakeTranslation(4, -2));
+
+    TestImage expected(width, height);
+    std::memset(expected.Pixel(0, 0), 0x7F, width * height * 4);
+    rsk::WarpBitmap(MakeView(source), transform, RSKResamplingFilterBilinear, &mask, MakeView(expected));
+
+    TestImage result(width, height);
+    rsk::WarpBitmap(MakeView(source), transform, RSKResamplingFilterBilinear, nullptr, MakeView(result));
+    rsk::MaskBitmap(mask, MakeView(result));
+
+    EXPECT_EQ(0, std::memcmp(result.Pixel(0, 0), expected.Pixel(0, 0), width * height * 4));
+}
+
+TEST(RSKImageTransforms, WarpsBitmapWithSupersampling)
+{
+    TestImage source = TestImage::MakePattern(8, 8);
+    TestImage destination(4, 4);
+    rsk::WarpBitmapSupersampled(MakeView(source), CGAffineTransformMakeScale(2, 2), RSKResamplingFilterNearest, 2, 2, nullptr, MakeView(destination));
+
+    // Every pixel is the rounded average of the block of 2 x 2 pixels of the source that it covers.
+    for (size_t y = 0; y < destination.Height(); y++) {
+        for (size_t x = 0; x < destination.Width(); x++) {
+            EXPECT_EQ(destination.Pixel(x, y)[0], 2 * x + 1);
+            EXPECT_EQ(destination.Pixel(x, y)[1], 2 * y + 1);
+            EXPECT_EQ(destination.Pixel(x, y)[3], 255);
+        }
+    }
+}
+
+TEST(RSKImageTransforms, ReducesBitmapByBoxAverage)
+{
+    TestImage source = TestImage::MakePattern(5, 3);
+    TestImage destination(3, 2);
+    rsk::BoxReduceBitmap(MakeView(source), 2, false, MakeView(destination));
+
+    const uint8_t topLeft[] = { 1, 1, 0, 255 };
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(0, 0), topLeft, 4));
+    const uint8_t topRight[] = { 2, 0, 0, 128 };
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(2, 0), topRight, 4));
+
+    // Only one pixel of the source is inside of the bottom-right block.
+    const uint8_t bottomRight[] = { 1, 1, 0, 64 };
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(2, 1), bottomRight, 4));
+
+    rsk::BoxReduceBitmap(MakeView(source), 2, true, MakeView(destination));
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(0, 0), topLeft, 4));
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(2, 1), source.Pixel(4, 2), 4));
+}
+
+TEST(RSKImageTransforms, ExtendsBitmapWithEdgePixels)
+{
+    TestImage source = TestImage::MakePattern(3, 2);
+    TestImage destination(6, 5);
+    rsk::ExtendBitmap(MakeView(source), 2, 1, MakeView(destination));
+
+    for (size_t y = 0; y < destination.Height(); y++) {
+        for (size_t x = 0; x < destination.Width(); x++) {
+            const size_t sourceX = std::min<size_t>(std::max<size_t>(x, 2) - 2, 2);
+            const size_t sourceY = std::min<size_t>(std::max<size_t>(y, 1) - 1, 1);
+            EXPECT_EQ(0, std::memcmp(destination.Pixel(x, y), source.Pixel(sourceX, sourceY), 4)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(RSKImageTransforms, ComputesRotatedSize)
+{
+    const CGFloat tolerance = CGFLOAT_IS_DOUBLE ? 1e-9 : 1e-4;
+    CGSize size = rsk::RotatedSize(CGSizeMake(40, 30), M_PI_2);
+    EXPECT_NEAR(size.width, 30, tolerance);
+    EXPECT_NEAR(size.height, 40, tolerance);
+
+    size = rsk::RotatedSize(CGSizeMake(10, 10), M_PI_4);
+    EXPECT_NEAR(size.width, 10 * M_SQRT2, tolerance);
+    EXPECT_NEAR(size.height, 10 * M_SQRT2, tolerance);
+}
+
+TEST(RSKImageTransforms, RotatesBitmapByHalfTurn)
+{
+    TestImage source = TestImage::MakePattern(9, 6);
+    TestImage result(9, 6);
+    rsk::RotateBitmap(MakeView(source), M_PI, CGSizeMake(9, 6), MakeView(result));
+
+    for (size_t y = 0; y < result.Height(); y++) {
+        for (size_t x = 0; x < result.Width(); x++) {
+            EXPECT_EQ(0, std::memcmp(result.Pixel(x, y), source.Pixel(8 - x, 5 - y), 4));
+        }
+    }
+}
+
+TEST(RSKImageTransforms, DrawsBitmapWithCoverage)
+{
+    TestImage source = TestImage::MakePattern(4, 4);
+    TestImage destination(6, 6);
+    std::vector<uint8_t> coverage(6 * 6, 255);
+    coverage[1 * 6 + 2] = 0;
+
+    rsk::DrawBitmap(MakeView(source), 2, 1, coverage.data(), MakeView(destination));
+
+    EXPECT_EQ(destination.Pixel(1, 1)[3], 0);
+    EXPECT_EQ(destination.Pixel(2, 1)[3], 0);
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(3, 1), source.Pixel(1, 0), 4));
+    EXPECT_EQ(0, std::memcmp(destination.Pixel(5, 4), source.Pixel(3, 3), 4));
+    EXPECT_EQ(destination.Pixel(5, 5)[3], 0);
+}
+
+TEST(RSKMaskRasterizer, RasterizesPolygonCoverage)
+{
+    const RSKPathElement elements[] = {
+        { RSKPathElementTypeMoveToPoint, { { 1, 1 } } },
+        { RSKPathElementTypeAddLineToPoint, { { 3.5, 1 } } },
+        { RSKPathElementTypeAddLineToPoint, { { 3.5, 3 } } },
+        { RSKPathElementTypeAddLineToPoint, { { 1, 3 } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+    RSKPath path = { elements, 5, false };
+
+    CGRect bounds = rsk::PathBoundingBox(path);
+    EXPECT_TRUE(CGRectEqualToRect(bounds, CGRectMake(1, 1, 2.5, 2)));
+
+    std::vector<rsk::Contour> contours = rsk::FlattenPath(path, CGAffineTransformIdentity, 0.1);
+    ASSERT_EQ(contours.size(), 1u);
+
+    std::vector<uint8_t> coverage(5 * 4);
+    rsk::RasterizeContours(contours, false, 5, 4, coverage.data());
+
+    EXPECT_EQ(coverage[0 * 5 + 1], 0);
+    EXPECT_EQ(coverage[1 * 5 + 1], 255);
+    EXPECT_EQ(coverage[2 * 5 + 2], 255);
+    EXPECT_EQ(coverage[2 * 5 + 3], 128);
+    EXPECT_EQ(coverage[2 * 5 + 4], 0);
+    EXPECT_EQ(coverage[3 * 5 + 2], 0);
+}
+
+TEST(RSKMaskRasterizer, FlattensCurvesWithinTolerance)
+{
+    const RSKPathElement elements[] = {
+        { RSKPathElementTypeMoveToPoint, { { 0, 0 } } },
+        { RSKPathElementTypeAddQuadCurveToPoint, { { 50, 100 }, { 100, 0 } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+    RSKPath path = { elements, 3, false };
+
+    std::vector<rsk::Contour> contours = rsk::FlattenPath(path, CGAffineTransformIdentity, 0.1);
+    ASSERT_EQ(contours.size(), 1u);
+
+    // The apex of the curve is at (50, 50).
+    double apex = 0;
+    for (const CGPoint &point : contours[0]) {
+        apex = std::max(apex, static_cast<double>(point.y));
+    }
+    EXPECT_NEAR(apex, 50, 0.1);
+}
+
+TEST(RSKMaskRasterizer, ProducesSortedSpansOfPolygonCoverage)
+{
+    // Two squares in one row, the left one with a fractional right edge.
+    std::vector<rsk::Contour> contours = {
+        { { 1, 1 }, { 4.5, 1 }, { 4.5, 5 }, { 1, 5 } },
+        { { 7, 1 }, { 10, 1 }, { 10, 5 }, { 7, 5 } },
+    };
+    const size_t width = 12;
+    const size_t height = 6;
+
+    std::vector<uint8_t> expectedCoverage(width * height);
+    rsk::RasterizeContours(contours, false, width, height, expectedCoverage.data());
+
+    rsk::PolygonCoverageMask mask(contours, false, width, height);
+    rsk::CoverageSpans spans;
+    std::vector<uint8_t> row(width);
+    for (size_t y = 0; y < height; y++) {
+        mask.GetRowSpans(y, spans, row.data());
+
+        std::vector<uint8_t> coverage(width, 0);
+        size_t end = 0;
+        for (const rsk::CoverageSpan &span : spans) {
+            EXPECT_LE(end, span.begin);
+            EXPECT_LT(span.begin, span.end);
+            EXPECT_LE(span.end, width);
+            end = span.end;
+            for (size_t x = span.begin; x < span.end; x++) {
+                coverage[x] = span.isOpaque ? 255 : row[x];
+            }
+        }
+        for (size_t x = 0; x < width; x++) {
+            EXPECT_EQ(coverage[x], expectedCoverage[y * width + x]) << "x = " << x << ", y = " << y;
+        }
+    }
+}
+
+TEST(RSKMaskRasterizer, ComputesEllipseCoverageLikeRasterizingIt)
+{
+    const CGRect rect = CGRectMake(2.5, 3, 40, 25.5);
+    const size_t width = 46;
+    const size_t height = 32;
+
+    // A polygon with many sides is close enough to the ellipse.
+    rsk::Contour contour;
+    for (int i = 0; i < 720; i++) {
+        double angle = 2 * M_PI * i / 720;
+        contour.push_back(CGPointMake(CGRectGetMidX(rect) + rect.size.width / 2 * std::cos(angle),
+                                      CGRectGetMidY(rect) + rect.size.height / 2 * std::sin(angle)));
+    }
+    std::vector<uint8_t> expectedCoverage(width * height);
+    rsk::RasterizeContours({ contour }, false, width, height, expectedCoverage.data());
+
+    rsk::EllipseCoverageMask mask(rect, width, height);
+    rsk::CoverageSpans spans;
+    std::vector<uint8_t> row(width);
+    double totalDifference = 0;
+    for (size_t y = 0; y < height; y++) {
+        mask.GetRowSpans(y, spans, row.data());
+
+        std::vector<uint8_t> coverage(width, 0);
+        for (const rsk::CoverageSpan &span : spans) {
+            for (size_t x = span.begin; x < span.end; x++) {
+                coverage[x] = span.isOpaque ? 255 : row[x];
+            }
+        }
+        for (size_t x = 0; x < width; x++) {
+            int expected = expectedCoverage[y * width + x];
+            // Sampling on a 4 x 4 grid can miss a sliver of the ellipse, so pixels it finds fully inside or outside of
+            // the ellipse are only close.
+            if (expected == 0 || expected == 255) {
+                EXPECT_NEAR(coverage[x], expected, 48) << "x = " << x << ", y = " << y;
+            }
+            totalDifference += std::abs(coverage[x] - expected);
+        }
+    }
+    EXPECT_LT(totalDifference / (width * height), 2.0);
+}
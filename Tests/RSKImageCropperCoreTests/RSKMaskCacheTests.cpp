@@ -0,0 +1,220 @@
+//
+// RSKMaskCacheTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKMaskCache.h>
+
+#include "RSKMaskCache.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::test::CompareImages;
+using rsk::test::TestImage;
+
+namespace {
+
+// The default budget of the shared cache, which the tests restore.
+constexpr size_t kDefaultByteBudget = 4 * 1024 * 1024;
+
+// Returns a spec that crops `width` x `height` pixels masked by `maskPath` out of a larger source, rotated slightly.
+RSKCropSpec MakeMaskedSpec(const std::vector<RSKPathElement> &maskPath, size_t width, size_t height)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCustom;
+    spec.cropRect = CGRectMake(0, 0, width, height);
+    spec.imageRect = CGRectMake(4, 4, width, height);
+    spec.rotationAngle = 0.1;
+    spec.zoomScale = 1;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.applyMaskToCroppedImage = true;
+    return spec;
+}
+
+std::vector<RSKPathElement> MakeTrianglePath(CGRect rect)
+{
+    return {
+        { RSKPathElementTypeMoveToPoint, { { CGRectGetMinX(rect), CGRectGetMaxY(rect) } } },
+        { RSKPathElementTypeAddLineToPoint, { { CGRectGetMaxX(rect), CGRectGetMaxY(rect) } } },
+        { RSKPathElementTypeAddLineToPoint, { { CGRectGetMidX(rect), CGRectGetMinY(rect) } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+TestImage Crop(TestImage &source, const RSKCropSpec &spec)
+{
+    CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    TestImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+// Returns the coverage of every pixel of row `y` of `mask`.
+std::vector<uint8_t> RowCoverage(rsk::CoverageMask &mask, size_t y)
+{
+    rsk::CoverageSpans spans;
+    std::vector<uint8_t> coverage(mask.Width());
+    mask.GetRowSpans(y, spans, coverage.data());
+    std::vector<uint8_t> row(mask.Width());
+    for (const rsk::CoverageSpan &span : spans) {
+        EXPECT_LT(span.begin, span.end);
+        EXPECT_LE(span.end, mask.Width());
+        for (size_t x = span.begin; x < span.end; x++) {
+            row[x] = span.isOpaque ? 255 : coverage[x];
+        }
+    }
+    return row;
+}
+
+} // namespace
+
+TEST(RSKMaskCache, KeepsRowsOfMaskAsSpans)
+{
+    const std::vector<rsk::Contour> contours = { { { 3.3, 40.0 }, { 60.2, 37.5 }, { 31.0, 2.7 } } };
+    rsk::PolygonCoverageMask mask(contours, false, 64, 48);
+    auto rasterizedMask = std::make_shared<const rsk::RasterizedMask>(mask);
+    EXPECT_EQ(rasterizedMask->Width(), 64u);
+    EXPECT_EQ(rasterizedMask->Height(), 48u);
+
+    // Only the edges keep coverage bytes, so a large mask costs much less than a byte for every pixel.
+    const std::vector<rsk::Contour> largeContours = { { { 33.0, 400.0 }, { 602.0, 375.0 }, { 310.0, 27.0 } } };
+    rsk::PolygonCoverageMask largeMask(largeContours, false, 640, 480);
+    EXPECT_LT(rsk::RasterizedMask(largeMask).ByteCount(), 640u * 480u / 8);
+
+    rsk::PolygonCoverageMask expectedMask(contours, false, 64, 48);
+    std::vector<std::vector<uint8_t>> expectedRows;
+    for (size_t y = 0; y < 48; y++) {
+        expectedRows.push_back(RowCoverage(expectedMask, y));
+    }
+
+    // Every part of the mask reads its pixels of the rows.
+    struct Part {
+        size_t x, y, width, height;
+    };
+    const Part parts[] = { { 0, 0, 64, 48 }, { 10, 5, 20, 30 }, { 31, 40, 33, 8 }, { 63, 0, 1, 48 } };
+    for (const Part &part : parts) {
+        rsk::RasterizedCoverageMask partMask(rasterizedMask, part.x, part.y, part.width, part.height);
+        for (size_t y = 0; y < part.height; y++) {
+            const std::vector<uint8_t> row = RowCoverage(partMask, y);
+            const std::vector<uint8_t> expectedRow(expectedRows[part.y + y].begin() + part.x, expectedRows[part.y + y].begin() + part.x + part.width);
+            EXPECT_EQ(row, expectedRow) << part.x << ", " << part.y << ", " << y;
+        }
+    }
+}
+
+TEST(RSKMaskCache, EvictsLeastRecentlyUsedMasksOverBudget)
+{
+    rsk::MaskCache cache(1);
+    const std::vector<RSKPathElement> path = MakeTrianglePath(CGRectMake(0, 0, 40, 30));
+    RSKCropSpec spec = MakeMaskedSpec(path, 40, 30);
+    size_t makeCount = 0;
+    auto make = [&] {
+        makeCount++;
+        rsk::EllipseCoverageMask mask(CGRectMake(0, 0, 40, 30), 40, 30);
+        return std::make_shared<const rsk::RasterizedMask>(mask);
+    };
+    const size_t byteCount = make()->ByteCount();
+    makeCount = 0;
+
+    // A mask over the budget is made but not kept.
+    const rsk::MaskKey key(spec, 40, 30, 40, 30);
+    EXPECT_NE(cache.FindOrMake(key, make), nullptr);
+    EXPECT_NE(cache.FindOrMake(key, make), nullptr);
+    EXPECT_EQ(makeCount, 2u);
+    RSKMaskCacheStats stats = cache.Stats();
+    EXPECT_EQ(stats.missCount, 2u);
+    EXPECT_EQ(stats.maskCount, 0u);
+
+    // Two masks fit, so the third one evicts the one that was used least recently.
+    cache.SetByteBudget(byteCount * 2);
+    const rsk::MaskKey otherKey(spec, 40, 30, 20, 15);
+    spec.zoomScale = 2;
+    const rsk::MaskKey zoomedKey(spec, 40, 30, 40, 30);
+    cache.FindOrMake(key, make);
+    cache.FindOrMake(otherKey, make);
+    cache.FindOrMake(key, make);
+    cache.FindOrMake(zoomedKey, make);
+    EXPECT_EQ(makeCount, 5u);
+    stats = cache.Stats();
+    EXPECT_EQ(stats.hitCount, 1u);
+    EXPECT_EQ(stats.missCount, 5u);
+    EXPECT_EQ(stats.evictionCount, 1u);
+    EXPECT_EQ(stats.maskCount, 2u);
+    EXPECT_EQ(stats.byteCount, byteCount * 2);
+    cache.FindOrMake(key, make);
+    cache.FindOrMake(otherKey, make);
+    EXPECT_EQ(makeCount, 6u);
+
+    // Without a budget nothing is made or kept.
+    cache.SetByteBudget(0);
+    EXPECT_EQ(cache.FindOrMake(key, make), nullptr);
+    EXPECT_EQ(makeCount, 6u);
+    EXPECT_EQ(cache.Stats().byteCount, 0u);
+}
+
+TEST(RSKMaskCache, CropsWithCachedMaskLikeWithoutCache)
+{
+    TestImage source = TestImage::MakePattern(97, 83);
+    const std::vector<RSKPathElement> trianglePath = MakeTrianglePath(CGRectMake(-5, 0, 80, 60));
+    const std::vector<RSKPathElement> copiedPath = trianglePath;
+    RSKCropSpec spec = MakeMaskedSpec(trianglePath, 70, 60);
+    RSKCropSpec scaledSpec = spec;
+    scaledSpec.outputSize = CGSizeMake(35, 30);
+
+    RSKMaskCacheSetByteBudget(0);
+    const TestImage expected = Crop(source, spec);
+    const TestImage scaledExpected = Crop(source, scaledSpec);
+    EXPECT_EQ(RSKMaskCacheGetStats().maskCount, 0u);
+
+    // The second crop finds the mask of the first one, also through a copy of its path.
+    RSKMaskCacheSetByteBudget(kDefaultByteBudget);
+    RSKMaskCacheClear();
+    const RSKMaskCacheStats initialStats = RSKMaskCacheGetStats();
+    EXPECT_EQ(CompareImages(Crop(source, spec), expected).maximumAlphaDifference, 0);
+    spec.maskPath.elements = copiedPath.data();
+    EXPECT_EQ(CompareImages(Crop(source, spec), expected).maximumAlphaDifference, 0);
+    EXPECT_EQ(CompareImages(Crop(source, spec), expected).maximumColorDifference, 0);
+    EXPECT_EQ(CompareImages(Crop(source, scaledSpec), scaledExpected).maximumAlphaDifference, 0);
+    RSKMaskCacheStats stats = RSKMaskCacheGetStats();
+    EXPECT_EQ(stats.missCount - initialStats.missCount, 2u);
+    EXPECT_EQ(stats.hitCount - initialStats.hitCount, 2u);
+    EXPECT_EQ(stats.maskCount, 2u);
+    EXPECT_GT(stats.byteCount, 0u);
+
+    // A crop without a mask does not touch the cache.
+    spec.applyMaskToCroppedImage = false;
+    Crop(source, spec);
+    EXPECT_EQ(RSKMaskCacheGetStats().missCount, stats.missCount);
+
+    RSKMaskCacheClear();
+    stats = RSKMaskCacheGetStats();
+    EXPECT_EQ(stats.maskCount, 0u);
+    EXPECT_EQ(stats.byteCount, 0u);
+}
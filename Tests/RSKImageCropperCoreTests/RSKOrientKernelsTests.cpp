@@ -0,0 +1,148 @@
+//
+// RSKOrientKernelsTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RSKOrientKernels.hpp"
+
+using rsk::ComponentType;
+using rsk::SimdInstructionSet;
+
+namespace {
+
+const SimdInstructionSet kInstructionSets[] = {
+    SimdInstructionSet::Scalar,
+    SimdInstructionSet::SSE41,
+    SimdInstructionSet::AVX2,
+    SimdInstructionSet::NEON,
+};
+
+// Pixels of a bitmap with a few unused bytes at the end of every row, so the kernels have to keep to the rows.
+struct Pixels {
+    std::vector<uint8_t> bytes;
+    rsk::BitmapView view;
+
+    Pixels(size_t width, size_t height, ComponentType componentType)
+    {
+        view.width = width;
+        view.height = height;
+        view.bytesPerRow = width * rsk::BytesPerPixel(componentType) + 12;
+        view.componentType = componentType;
+        bytes.resize(view.bytesPerRow * height);
+        view.data = bytes.data();
+    }
+};
+
+// Returns the source pixel that pixel `x`, `y` of the upright image is read from, like `-[UIImage fixOrientation]`.
+void SourcePixel(RSKImageOrientation orientation, size_t width, size_t height, size_t x, size_t y, size_t &sourceX, size_t &sourceY)
+{
+    switch (orientation) {
+        case RSKImageOrientationUp:
+            sourceX = x, sourceY = y;
+            break;
+        case RSKImageOrientationDown:
+            sourceX = width - 1 - x, sourceY = height - 1 - y;
+            break;
+        case RSKImageOrientationLeft:
+            sourceX = width - 1 - y, sourceY = x;
+            break;
+        case RSKImageOrientationRight:
+            sourceX = y, sourceY = height - 1 - x;
+            break;
+        case RSKImageOrientationUpMirrored:
+            sourceX = width - 1 - x, sourceY = y;
+            break;
+        case RSKImageOrientationDownMirrored:
+            sourceX = x, sourceY = height - 1 - y;
+            break;
+        case RSKImageOrientationLeftMirrored:
+            sourceX = y, sourceY = x;
+            break;
+        case RSKImageOrientationRightMirrored:
+            sourceX = width - 1 - y, sourceY = height - 1 - x;
+            break;
+    }
+}
+
+} // namespace
+
+TEST(RSKOrientKernels, MoveEveryPixelOnEveryInstructionSet)
+{
+    // Sizes smaller than a block, with whole blocks and pixels left over, and larger than a tile.
+    const size_t sizes[][2] = { { 1, 1 }, { 3, 5 }, { 16, 8 }, { 13, 21 }, { 131, 70 } };
+
+    for (SimdInstructionSet instructionSet : kInstructionSets) {
+        if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+            continue;
+        }
+        for (ComponentType componentType : { ComponentType::UInt8, ComponentType::Float16 }) {
+            const rsk::OrientKernels &kernels = rsk::GetOrientKernels(instructionSet, componentType);
+            const size_t bytesPerPixel = rsk::BytesPerPixel(componentType);
+            for (const auto &size : sizes) {
+                Pixels source(size[0], size[1], componentType);
+                for (size_t i = 0; i < source.bytes.size(); i++) {
+                    source.bytes[i] = static_cast<uint8_t>(i * 7 % 251);
+                }
+                for (int orientation = RSKImageOrientationUp; orientation <= RSKImageOrientationRightMirrored; orientation++) {
+                    const bool swapsDimensions = rsk::OrientationSwapsDimensions(static_cast<RSKImageOrientation>(orientation));
+                    Pixels destination(swapsDimensions ? size[1] : size[0], swapsDimensions ? size[0] : size[1], componentType);
+                    rsk::OrientPixels(source.view, static_cast<RSKImageOrientation>(orientation), kernels, destination.view);
+
+                    for (size_t y = 0; y < destination.view.height; y++) {
+                        for (size_t x = 0; x < destination.view.width; x++) {
+                            size_t sourceX = 0, sourceY = 0;
+                            SourcePixel(static_cast<RSKImageOrientation>(orientation), size[0], size[1], x, y, sourceX, sourceY);
+                            ASSERT_EQ(0, std::memcmp(destination.view.Pixel(x, y), source.view.Pixel(sourceX, sourceY), bytesPerPixel))
+                                << rsk::SimdInstructionSetName(instructionSet) << ", " << size[0] << " x " << size[1] << ", " << orientation << ", " << x << ", " << y;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(RSKOrientKernels, ReverseRowsOfEveryLength)
+{
+    for (SimdInstructionSet instructionSet : kInstructionSets) {
+        if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+            continue;
+        }
+        const rsk::OrientKernels &kernels = rsk::GetOrientKernels(instructionSet, ComponentType::UInt8);
+        for (size_t count = 0; count <= 19; count++) {
+            std::vector<uint32_t> row(count), reversedRow(count + 1, 0xdeadbeef);
+            for (size_t i = 0; i < count; i++) {
+                row[i] = static_cast<uint32_t>(i + 1);
+            }
+            kernels.reverseRow(reinterpret_cast<const uint8_t *>(row.data()), count, reinterpret_cast<uint8_t *>(reversedRow.data()));
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(reversedRow[i], count - i) << rsk::SimdInstructionSetName(instructionSet) << ", " << count;
+            }
+            EXPECT_EQ(reversedRow[count], 0xdeadbeef) << rsk::SimdInstructionSetName(instructionSet) << ", " << count;
+        }
+    }
+}
@@ -0,0 +1,293 @@
+//
+// RSKPixelComponentsTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKCropEngine.h>
+
+#include "RSKPixelComponents.hpp"
+#include "RSKTestImage.hpp"
+
+using rsk::FloatToHalf;
+using rsk::HalfToFloat;
+using rsk::test::CompareImages;
+using rsk::test::ImageDifference;
+using rsk::test::TestImage;
+
+namespace {
+
+// A tightly packed image of 16-bit or half float components.
+class DeepImage {
+public:
+    DeepImage(size_t width, size_t height, RSKPixelFormat pixelFormat)
+        : width_(width), height_(height), pixelFormat_(pixelFormat), components_(width * height * 4)
+    {
+    }
+
+    size_t Width() const { return width_; }
+    size_t Height() const { return height_; }
+    uint16_t *Pixel(size_t x, size_t y) { return &components_[(y * width_ + x) * 4]; }
+    const uint16_t *Pixel(size_t x, size_t y) const { return &components_[(y * width_ + x) * 4]; }
+
+    RSKBitmap Bitmap() { return RSKBitmapMake(components_.data(), width_, height_, width_ * 8, pixelFormat_); }
+
+    // Fills every pixel with `pixel`.
+    void Fill(const uint16_t pixel[4])
+    {
+        for (size_t i = 0; i < components_.size(); i += 4) {
+            std::memcpy(&components_[i], pixel, 4 * sizeof(uint16_t));
+        }
+    }
+
+private:
+    size_t width_;
+    size_t height_;
+    RSKPixelFormat pixelFormat_;
+    std::vector<uint16_t> components_;
+};
+
+// Returns a diamond inside of a square of `size` x `size` pixels, whose edges cover the pixels that they cross partly.
+std::vector<RSKPathElement> MakeDiamondPath(size_t size)
+{
+    const CGFloat middle = size * 0.5;
+    const CGFloat inset = 1.5;
+    return {
+        { RSKPathElementTypeMoveToPoint, { { middle, inset } } },
+        { RSKPathElementTypeAddLineToPoint, { { size - inset, middle } } },
+        { RSKPathElementTypeAddLineToPoint, { { middle, size - inset } } },
+        { RSKPathElementTypeAddLineToPoint, { { inset, middle } } },
+        { RSKPathElementTypeCloseSubpath, {} },
+    };
+}
+
+// Returns a spec that rotates, masks with `maskPath` and scales a square source of `size` x `size` pixels, which
+// filters every pixel of the result. The center of the result is covered by the source.
+RSKCropSpec MakeFilteringSpec(size_t size, const std::vector<RSKPathElement> &maskPath, RSKResamplingFilter filter)
+{
+    RSKCropSpec spec = {};
+    spec.cropMode = RSKCropModeCustom;
+    spec.maskPath = { maskPath.data(), maskPath.size(), false };
+    spec.cropRect = CGRectMake(0, 0, size, size);
+    spec.imageRect = CGRectMake(0, 0, size, size);
+    spec.zoomScale = 1;
+    spec.rotationAngle = 0.3;
+    spec.imageOrientation = RSKImageOrientationUp;
+    spec.applyMaskToCroppedImage = true;
+    spec.resamplingFilter = filter;
+    spec.outputSize = CGSizeMake(size * 2 / 3, size * 2 / 3);
+    return spec;
+}
+
+DeepImage ConvertToDeepImage(TestImage &image, RSKPixelFormat pixelFormat)
+{
+    DeepImage result(image.Width(), image.Height(), pixelFormat);
+    RSKBitmap imageBitmap = image.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineConvertBitmap(&imageBitmap, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+TestImage ConvertToTestImage(DeepImage &image)
+{
+    TestImage result(image.Width(), image.Height());
+    RSKBitmap imageBitmap = image.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineConvertBitmap(&imageBitmap, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+DeepImage Crop(DeepImage &source, const RSKCropSpec &spec, RSKPixelFormat pixelFormat)
+{
+    const CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+    DeepImage result(static_cast<size_t>(size.width), static_cast<size_t>(size.height), pixelFormat);
+    RSKBitmap sourceBitmap = source.Bitmap();
+    RSKBitmap resultBitmap = result.Bitmap();
+    EXPECT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &resultBitmap), RSKCropStatusSuccess);
+    return result;
+}
+
+bool ReadDeepImage(void *context, size_t x, size_t y, const RSKBitmap *destination)
+{
+    const DeepImage &image = *static_cast<const DeepImage *>(context);
+    for (size_t row = 0; row < destination->height; row++) {
+        std::memcpy(static_cast<uint8_t *>(destination->data) + row * destination->bytesPerRow, image.Pixel(x, y + row), destination->width * 8);
+    }
+    return true;
+}
+
+bool WriteDeepImage(void *context, size_t x, size_t y, const RSKBitmap *tile)
+{
+    DeepImage &image = *static_cast<DeepImage *>(context);
+    for (size_t row = 0; row < tile->height; row++) {
+        std::memcpy(image.Pixel(x, y + row), static_cast<const uint8_t *>(tile->data) + row * tile->bytesPerRow, tile->width * 8);
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(RSKPixelComponents, ConvertsEveryHalfFloatToFloatAndBack)
+{
+    for (uint32_t half = 0; half <= 0xFFFF; half++) {
+        const float value = HalfToFloat(static_cast<uint16_t>(half));
+        if (std::isnan(value)) {
+            EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(value)))) << half;
+            continue;
+        }
+        EXPECT_EQ(FloatToHalf(value), half) << half;
+    }
+
+    EXPECT_EQ(HalfToFloat(0x3C00), 1.0f);
+    EXPECT_EQ(HalfToFloat(0xC000), -2.0f);
+    EXPECT_EQ(HalfToFloat(0x7BFF), 65504.0f);
+    EXPECT_EQ(HalfToFloat(0x0001), std::ldexp(1.0f, -24));
+}
+
+TEST(RSKPixelComponents, RoundsFloatsToNearestHalfFloat)
+{
+    // Ties round to the even half float.
+    EXPECT_EQ(FloatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);
+    EXPECT_EQ(FloatToHalf(1.0f + 3 * std::ldexp(1.0f, -11)), 0x3C02);
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -25)), 0x0000);
+    EXPECT_EQ(FloatToHalf(3 * std::ldexp(1.0f, -25)), 0x0002);
+
+    // Values past the largest half float are infinite.
+    EXPECT_EQ(FloatToHalf(65519.0f), 0x7BFF);
+    EXPECT_EQ(FloatToHalf(65520.0f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(-1e9f), 0xFC00);
+}
+
+TEST(RSKPixelComponents, ConvertsBetweenPixelFormats)
+{
+    TestImage source = TestImage::MakePattern(20, 10);
+    RSKBitmap sourceBitmap = source.Bitmap();
+
+    // The 8-bit formats only swap the colors.
+    TestImage swapped(20, 10);
+    RSKBitmap swappedBitmap = swapped.Bitmap();
+    swappedBitmap.pixelFormat = RSKPixelFormatBGRA8888;
+    ASSERT_EQ(RSKCropEngineConvertBitmap(&sourceBitmap, &swappedBitmap), RSKCropStatusSuccess);
+    EXPECT_EQ(swapped.Pixel(7, 3)[0], source.Pixel(7, 3)[2]);
+    EXPECT_EQ(swapped.Pixel(7, 3)[2], source.Pixel(7, 3)[0]);
+    EXPECT_EQ(swapped.Pixel(7, 3)[3], 255);
+
+    // 8-bit components are exactly the ones of 16 bits divided by 257, and of half floats times 255.
+    DeepImage deep = ConvertToDeepImage(source, RSKPixelFormatRGBA16);
+    DeepImage half = ConvertToDeepImage(source, RSKPixelFormatRGBAHalf);
+    for (size_t c = 0; c < 4; c++) {
+        EXPECT_EQ(deep.Pixel(7, 3)[c], source.Pixel(7, 3)[c] * 257) << c;
+        EXPECT_NEAR(HalfToFloat(half.Pixel(7, 3)[c]) * 255.0f, source.Pixel(7, 3)[c], 0.1) << c;
+    }
+    for (DeepImage *image : { &deep, &half }) {
+        ImageDifference difference = CompareImages(ConvertToTestImage(*image), source);
+        EXPECT_EQ(difference.maximumColorDifference, 0);
+        EXPECT_EQ(difference.maximumAlphaDifference, 0);
+    }
+
+    TestImage wrongSize(20, 11);
+    RSKBitmap wrongSizeBitmap = wrongSize.Bitmap();
+    EXPECT_EQ(RSKCropEngineConvertBitmap(&sourceBitmap, &wrongSizeBitmap), RSKCropStatusInvalidArgument);
+    EXPECT_EQ(RSKCropEngineConvertBitmap(&sourceBitmap, nullptr), RSKCropStatusInvalidArgument);
+}
+
+TEST(RSKPixelComponents, CropsEveryPixelFormatLikeEightBitComponents)
+{
+    TestImage source = TestImage::MakePattern(120, 120);
+    const std::vector<RSKPathElement> maskPath = MakeDiamondPath(source.Width());
+
+    for (RSKResamplingFilter filter : { RSKResamplingFilterNearest, RSKResamplingFilterBilinear, RSKResamplingFilterBicubic, RSKResamplingFilterLanczos3 }) {
+        const RSKCropSpec spec = MakeFilteringSpec(source.Width(), maskPath, filter);
+        const CGSize size = RSKCropEngineGetOutputSize(source.Width(), source.Height(), &spec);
+        TestImage expected(static_cast<size_t>(size.width), static_cast<size_t>(size.height));
+        RSKBitmap sourceBitmap = source.Bitmap();
+        RSKBitmap expectedBitmap = expected.Bitmap();
+        ASSERT_EQ(RSKCropEngineCropBitmap(&sourceBitmap, &spec, &expectedBitmap), RSKCropStatusSuccess);
+        ASSERT_EQ(expected.Pixel(expected.Width() / 2, expected.Height() / 2)[3], 255);
+
+        // The wider components only round differently.
+        for (RSKPixelFormat pixelFormat : { RSKPixelFormatRGBA16, RSKPixelFormatRGBAHalf }) {
+            DeepImage deepSource = ConvertToDeepImage(source, pixelFormat);
+            DeepImage result = Crop(deepSource, spec, pixelFormat);
+            ImageDifference difference = CompareImages(ConvertToTestImage(result), expected);
+            EXPECT_LE(difference.maximumColorDifference, 1) << filter << ", " << pixelFormat;
+            EXPECT_LE(difference.maximumAlphaDifference, 1) << filter << ", " << pixelFormat;
+
+            // The tiles of a tiled crop hold the wider pixels too.
+            DeepImage tiledResult(result.Width(), result.Height(), pixelFormat);
+            RSKTiledSource tiledSource = { deepSource.Width(), deepSource.Height(), pixelFormat, ReadDeepImage, &deepSource };
+            RSKTiledDestination tiledDestination = { WriteDeepImage, &tiledResult };
+            RSKTilingOptions options = { 16, 0, nullptr };
+            ASSERT_EQ(RSKCropEngineCropTiled(&tiledSource, &spec, &options, &tiledDestination), RSKCropStatusSuccess);
+            RSKBitmap resultBitmap = result.Bitmap();
+            RSKBitmap tiledResultBitmap = tiledResult.Bitmap();
+            EXPECT_EQ(std::memcmp(resultBitmap.data, tiledResultBitmap.data, result.Width() * result.Height() * 8), 0) << filter << ", " << pixelFormat;
+        }
+    }
+}
+
+TEST(RSKPixelComponents, KeepsPrecisionOf16BitComponents)
+{
+    // None of the components is a multiple of 257, so none of them survives a round trip through 8 bits.
+    const uint16_t pixel[4] = { 1000, 40001, 65000, 65535 };
+    DeepImage source(48, 48, RSKPixelFormatRGBA16);
+    source.Fill(pixel);
+    const std::vector<RSKPathElement> maskPath = MakeDiamondPath(source.Width());
+
+    for (RSKResamplingFilter filter : { RSKResamplingFilterBilinear, RSKResamplingFilterLanczos3 }) {
+        DeepImage result = Crop(source, MakeFilteringSpec(source.Width(), maskPath, filter), RSKPixelFormatRGBA16);
+        const uint16_t *center = result.Pixel(result.Width() / 2, result.Height() / 2);
+        for (size_t c = 0; c < 4; c++) {
+            EXPECT_NEAR(center[c], pixel[c], 1) << filter << ", " << c;
+        }
+    }
+}
+
+TEST(RSKPixelComponents, KeepsExtendedRangeOfHalfFloats)
+{
+    // Colors of an extended-range image go past alpha and below zero.
+    const uint16_t pixel[4] = { FloatToHalf(1.5f), FloatToHalf(-0.25f), FloatToHalf(0.5f), FloatToHalf(1.0f) };
+    DeepImage source(48, 48, RSKPixelFormatRGBAHalf);
+    source.Fill(pixel);
+    const std::vector<RSKPathElement> maskPath = MakeDiamondPath(source.Width());
+
+    for (RSKResamplingFilter filter : { RSKResamplingFilterBilinear, RSKResamplingFilterBicubic }) {
+        DeepImage result = Crop(source, MakeFilteringSpec(source.Width(), maskPath, filter), RSKPixelFormatRGBAHalf);
+        const uint16_t *center = result.Pixel(result.Width() / 2, result.Height() / 2);
+        for (size_t c = 0; c < 4; c++) {
+            EXPECT_NEAR(HalfToFloat(center[c]), HalfToFloat(pixel[c]), 1e-3) << filter << ", " << c;
+        }
+
+        // 8-bit components clamp them.
+        TestImage converted = ConvertToTestImage(result);
+        const uint8_t *convertedCenter = converted.Pixel(result.Width() / 2, result.Height() / 2);
+        EXPECT_EQ(convertedCenter[0], 255);
+        EXPECT_EQ(convertedCenter[1], 0);
+        EXPECT_EQ(convertedCenter[2], 128);
+        EXPECT_EQ(convertedCenter[3], 255);
+    }
+}
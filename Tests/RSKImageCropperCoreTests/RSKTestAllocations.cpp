@@ -0,0 +1,122 @@
+//
+// RSKTestAllocations.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKTestAllocations.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// The bytes that `operator new` allocated while `gCountsAllocations` is set.
+std::atomic<bool> gCountsAllocations { false };
+std::atomic<size_t> gAllocatedBytes { 0 };
+
+// The size from which on allocations fail.
+std::atomic<size_t> gMinimumFailingSize { SIZE_MAX };
+
+} // namespace
+
+namespace rsk {
+namespace test {
+
+AllocationCounter::AllocationCounter()
+{
+    gAllocatedBytes = 0;
+    gCountsAllocations = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    gCountsAllocations = false;
+}
+
+size_t AllocationCounter::AllocatedBytes() const
+{
+    return gAllocatedBytes;
+}
+
+AllocationFailure::AllocationFailure(size_t minimumSize)
+{
+    gMinimumFailingSize = minimumSize;
+}
+
+AllocationFailure::~AllocationFailure()
+{
+    gMinimumFailingSize = SIZE_MAX;
+}
+
+} // namespace test
+} // namespace rsk
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    if (size >= gMinimumFailingSize) {
+        return nullptr;
+    }
+    if (gCountsAllocations) {
+        gAllocatedBytes += size;
+    }
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(std::size_t size)
+{
+    if (void *pointer = operator new(size, std::nothrow)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
@@ -0,0 +1,62 @@
+//
+// RSKTestAllocations.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKTestAllocations_hpp
+#define RSKTestAllocations_hpp
+
+#include <cstddef>
+
+namespace rsk {
+namespace test {
+
+// The crop engine allocates its memory with `new`, which the test executable replaces to watch the allocations. The
+// replacements behave like the global operators unless a test creates one of the objects below.
+
+// Counts the bytes that are allocated with `new` during its lifetime.
+class AllocationCounter {
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter &) = delete;
+    AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+    size_t AllocatedBytes() const;
+};
+
+// Makes every allocation with `new` of at least `minimumSize` bytes fail during its lifetime, like on a device that is
+// out of memory.
+class AllocationFailure {
+public:
+    explicit AllocationFailure(size_t minimumSize);
+    ~AllocationFailure();
+
+    AllocationFailure(const AllocationFailure &) = delete;
+    AllocationFailure &operator=(const AllocationFailure &) = delete;
+};
+
+} // namespace test
+} // namespace rsk
+
+#endif /* RSKTestAllocations_hpp */
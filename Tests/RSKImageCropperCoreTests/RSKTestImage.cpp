@@ -0,0 +1,129 @@
+//
+// RSKTestImage.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "RSKTestImage.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#if RSK_HAS_LIBPNG
+#include <png.h>
+#endif
+
+namespace rsk {
+namespace test {
+
+TestImage::TestImage(size_t width, size_t height)
+    : width_(width), height_(height), pixels_(width * height * 4)
+{
+}
+
+#if RSK_HAS_LIBPNG
+
+TestImage TestImage::LoadPNG(const std::string &path)
+{
+    png_image image = {};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, path.c_str())) {
+        return TestImage();
+    }
+    image.format = PNG_FORMAT_RGBA;
+
+    TestImage result(image.width, image.height);
+    if (!png_image_finish_read(&image, nullptr, result.pixels_.data(), 0, nullptr)) {
+        png_image_free(&image);
+        return TestImage();
+    }
+
+    // PNG stores straight alpha, the crop core works with premultiplied alpha.
+    for (size_t i = 0; i < result.pixels_.size(); i += 4) {
+        unsigned alpha = result.pixels_[i + 3];
+        for (size_t c = 0; c < 3; c++) {
+            result.pixels_[i + c] = static_cast<uint8_t>((result.pixels_[i + c] * alpha + 127) / 255);
+        }
+    }
+
+    return result;
+}
+
+#endif
+
+TestImage TestImage::MakePattern(size_t width, size_t height)
+{
+    TestImage image(width, height);
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            uint8_t *pixel = image.Pixel(x, y);
+            pixel[0] = static_cast<uint8_t>(x);
+            pixel[1] = static_cast<uint8_t>(y);
+            pixel[2] = static_cast<uint8_t>((x >> 8) | ((y >> 8) << 4));
+            pixel[3] = 255;
+        }
+    }
+    return image;
+}
+
+RSKBitmap TestImage::Bitmap()
+{
+    return RSKBitmapMake(pixels_.data(), width_, height_, width_ * 4, RSKPixelFormatRGBA8888);
+}
+
+ImageDifference CompareImages(const TestImage &image1, const TestImage &image2)
+{
+    ImageDifference difference;
+    size_t pixelCount = image1.Width() * image1.Height();
+    if (pixelCount == 0) {
+        return difference;
+    }
+
+    double colorSum = 0;
+    double alphaSum = 0;
+    for (size_t y = 0; y < image1.Height(); y++) {
+        for (size_t x = 0; x < image1.Width(); x++) {
+            const uint8_t *pixel1 = image1.Pixel(x, y);
+            const uint8_t *pixel2 = image2.Pixel(x, y);
+            int color = 0;
+            for (size_t c = 0; c < 3; c++) {
+                color = std::max(color, std::abs(pixel1[c] - pixel2[c]));
+            }
+            int alpha = std::abs(pixel1[3] - pixel2[3]);
+            colorSum += color;
+            alphaSum += alpha;
+            difference.maximumColorDifference = std::max(difference.maximumColorDifference, color);
+            difference.maximumAlphaDifference = std::max(difference.maximumAlphaDifference, alpha);
+        }
+    }
+    difference.meanColorDifference = colorSum / pixelCount;
+    difference.meanAlphaDifference = alphaSum / pixelCount;
+
+    return difference;
+}
+
+std::string ReferenceImagePath(const std::string &spec, const std::string &name)
+{
+    return std::string(RSK_REFERENCE_IMAGES_DIR) + "/" + spec + "/" + name + ".png";
+}
+
+} // namespace test
+} // namespace rsk
@@ -0,0 +1,84 @@
+//
+// RSKTestImage.hpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifndef RSKTestImage_hpp
+#define RSKTestImage_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <RSKImageCropperCore/RSKBitmap.h>
+
+namespace rsk {
+namespace test {
+
+// A tightly packed, premultiplied RGBA image.
+class TestImage {
+public:
+    TestImage() = default;
+    TestImage(size_t width, size_t height);
+
+#if RSK_HAS_LIBPNG
+    // Returns the image stored in the PNG file at `path`, or an empty image if the file cannot be read.
+    static TestImage LoadPNG(const std::string &path);
+#endif
+
+    // Returns an opaque image whose pixels all differ from each other, so any misplaced pixel is detected.
+    static TestImage MakePattern(size_t width, size_t height);
+
+    size_t Width() const { return width_; }
+    size_t Height() const { return height_; }
+    bool IsEmpty() const { return pixels_.empty(); }
+
+    uint8_t *Pixel(size_t x, size_t y) { return &pixels_[(y * width_ + x) * 4]; }
+    const uint8_t *Pixel(size_t x, size_t y) const { return &pixels_[(y * width_ + x) * 4]; }
+
+    RSKBitmap Bitmap();
+
+private:
+    size_t width_ = 0;
+    size_t height_ = 0;
+    std::vector<uint8_t> pixels_;
+};
+
+// Differences between two images of the same size.
+struct ImageDifference {
+    double meanColorDifference = 0;
+    int maximumColorDifference = 0;
+    double meanAlphaDifference = 0;
+    int maximumAlphaDifference = 0;
+};
+
+// Returns the differences between `image1` and `image2`.
+ImageDifference CompareImages(const TestImage &image1, const TestImage &image2);
+
+// Returns the path of the reference image `name` of the snapshot tests of `spec`.
+std::string ReferenceImagePath(const std::string &spec, const std::string &name);
+
+} // namespace test
+} // namespace rsk
+
+#endif /* RSKTestImage_hpp */
@@ -0,0 +1,133 @@
+//
+// RSKThreadPoolTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <RSKImageCropperCore/RSKThreadPool.h>
+
+#include "RSKThreadPool.hpp"
+
+namespace {
+
+struct Counters {
+    std::unique_ptr<std::atomic<int>[]> calls;
+};
+
+} // namespace
+
+TEST(RSKThreadPool, CallsWorkOnceForEveryIndex)
+{
+    rsk::ThreadPool pool(4);
+    EXPECT_EQ(pool.ThreadCount(), 4u);
+
+    for (size_t count : { 0, 1, 3, 1000 }) {
+        Counters counters;
+        counters.calls.reset(new std::atomic<int>[count + 1]());
+        pool.ParallelFor(count, &counters, [](void *context, size_t index) {
+            static_cast<Counters *>(context)->calls[index]++;
+        });
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(counters.calls[i], 1) << count << ", " << i;
+        }
+    }
+}
+
+TEST(RSKThreadPool, StealsIndicesOfBusyThread)
+{
+    // The calling thread starts with the first quarter of the indices and is stuck on the first one until every other
+    // index has run, which only happens if the other threads steal the rest of its share.
+    struct Loop {
+        std::atomic<size_t> finishedCount{ 0 };
+        bool didFinishOthers = false;
+    } loop;
+    const size_t count = 400;
+
+    rsk::ThreadPool pool(4);
+    pool.ParallelFor(count, &loop, [](void *context, size_t index) {
+        Loop &loop = *static_cast<Loop *>(context);
+        if (index == 0) {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (loop.finishedCount < count - 1 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            loop.didFinishOthers = loop.finishedCount == count - 1;
+            return;
+        }
+        loop.finishedCount++;
+    });
+
+    EXPECT_TRUE(loop.didFinishOthers);
+}
+
+TEST(RSKThreadPool, RunsNestedLoopOnCallingThread)
+{
+    struct Loop {
+        rsk::ThreadPool *pool;
+        std::atomic<size_t> callCount{ 0 };
+    } loop;
+
+    rsk::ThreadPool pool(3);
+    loop.pool = &pool;
+    pool.ParallelFor(8, &loop, [](void *context, size_t) {
+        Loop &loop = *static_cast<Loop *>(context);
+        const std::thread::id threadID = std::this_thread::get_id();
+        struct NestedLoop {
+            std::thread::id threadID;
+            std::atomic<size_t> *callCount;
+            bool ranOnCallingThread = true;
+        } nestedLoop = { threadID, &loop.callCount };
+        loop.pool->ParallelFor(8, &nestedLoop, [](void *context, size_t) {
+            NestedLoop &nestedLoop = *static_cast<NestedLoop *>(context);
+            nestedLoop.ranOnCallingThread &= std::this_thread::get_id() == nestedLoop.threadID;
+            (*nestedLoop.callCount)++;
+        });
+        EXPECT_TRUE(nestedLoop.ranOnCallingThread);
+    });
+
+    EXPECT_EQ(loop.callCount, 64u);
+}
+
+TEST(RSKThreadPool, RunsLoopsThroughExecutor)
+{
+    RSKThreadPool *pool = RSKThreadPoolCreate(0);
+    ASSERT_NE(pool, nullptr);
+
+    RSKExecutor executor = RSKThreadPoolGetExecutor(pool);
+    EXPECT_EQ(executor.concurrency, std::max<size_t>(std::thread::hardware_concurrency(), 1));
+
+    std::atomic<size_t> sum{ 0 };
+    executor.parallelFor(executor.context, 100, &sum, [](void *context, size_t index) {
+        *static_cast<std::atomic<size_t> *>(context) += index;
+    });
+    EXPECT_EQ(sum, 4950u);
+
+    RSKThreadPoolDestroy(pool);
+}
@@ -0,0 +1,201 @@
+//
+// RSKWarpKernelsTests.cpp
+//
+// Copyright © 2026-present Ruslan Skorb. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "RSKTestImage.hpp"
+#include "RSKWarpKernels.hpp"
+
+using rsk::SimdInstructionSet;
+using rsk::test::CompareImages;
+using rsk::test::ImageDifference;
+using rsk::test::TestImage;
+
+namespace {
+
+const RSKResamplingFilter kFilters[] = {
+    RSKResamplingFilterNearest,
+    RSKResamplingFilterBilinear,
+    RSKResamplingFilterBicubic,
+    RSKResamplingFilterLanczos3,
+};
+
+const SimdInstructionSet kInstructionSets[] = {
+    SimdInstructionSet::SSE41,
+    SimdInstructionSet::AVX2,
+    SimdInstructionSet::NEON,
+};
+
+// Returns a premultiplied image with sharp edges in color and alpha, which makes the separable filters overshoot.
+TestImage MakeNoise(size_t width, size_t height)
+{
+    TestImage image(width, height);
+    uint32_t state = 12345;
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            uint8_t *pixel = image.Pixel(x, y);
+            state = state * 1664525u + 1013904223u;
+            const unsigned alpha = (state >> 24) & 1 ? 255 : (state >> 16) & 0xff;
+            for (size_t c = 0; c < 3; c++) {
+                state = state * 1664525u + 1013904223u;
+                pixel[c] = static_cast<uint8_t>(((state >> 24) * alpha + 127) / 255);
+            }
+            pixel[3] = static_cast<uint8_t>(alpha);
+        }
+    }
+    return image;
+}
+
+// Warps every row of `destination` with `kernel`, mapping the centers of its pixels into `source` with `transform`.
+void Warp(rsk::WarpRowKernel kernel, TestImage &source, CGAffineTransform transform, TestImage &destination)
+{
+    RSKBitmap sourceBitmap = source.Bitmap();
+    rsk::BitmapView sourceView = rsk::MakeBitmapView(sourceBitmap);
+    for (size_t y = 0; y < destination.Height(); y++) {
+        CGPoint start = CGPointApplyAffineTransform(CGPointMake(0.5, y + 0.5), transform);
+        kernel(sourceView, start.x - 0.5, start.y - 0.5, transform.a, transform.b, destination.Width(), destination.Pixel(0, y));
+    }
+}
+
+// Transforms that rotate, scale and move the source partly out of the destination, so every kernel also samples the
+// edges and the outside of the source.
+std::vector<CGAffineTransform> MakeTransforms()
+{
+    CGAffineTransform rotation = CGAffineTransformMakeTranslation(-30, -25);
+    rotation = CGAffineTransformConcat(rotation, CGAffineTransformMakeRotation(-0.3));
+    rotation = CGAffineTransformConcat(rotation, CGAffineTransformMakeTranslation(26.5, 20.5));
+
+    CGAffineTransform scale = CGAffineTransformConcat(CGAffineTransformMakeScale(0.7, 1.3), CGAffineTransformMakeTranslation(-3.25, -7.75));
+
+    return { rotation, scale, CGAffineTransformMakeRotation(M_PI_2 + 0.01) };
+}
+
+} // namespace
+
+TEST(RSKWarpKernels, MatchScalarKernelsOnEveryInstructionSet)
+{
+    TestImage source = MakeNoise(53, 41);
+    std::vector<CGAffineTransform> transforms = MakeTransforms();
+
+    for (SimdInstructionSet instructionSet : kInstructionSets) {
+        if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+            continue;
+        }
+        for (RSKResamplingFilter filter : kFilters) {
+            for (size_t i = 0; i < transforms.size(); i++) {
+                // An odd width also covers the remainders of the kernels that work on several pixels at a time.
+                TestImage expected(61, 47);
+                TestImage result(61, 47);
+                Warp(rsk::GetWarpRowKernel(filter, SimdInstructionSet::Scalar), source, transforms[i], expected);
+                Warp(rsk::GetWarpRowKernel(filter, instructionSet), source, transforms[i], result);
+
+                ImageDifference difference = CompareImages(result, expected);
+                EXPECT_LE(difference.maximumColorDifference, 1) << rsk::SimdInstructionSetName(instructionSet) << ", " << filter << ", " << i;
+                EXPECT_LE(difference.maximumAlphaDifference, 1) << rsk::SimdInstructionSetName(instructionSet) << ", " << filter << ", " << i;
+            }
+        }
+    }
+}
+
+TEST(RSKWarpKernels, ReproduceSourceAtWholePixelOffsets)
+{
+    TestImage source = MakeNoise(20, 16);
+
+    for (SimdInstructionSet instructionSet : { SimdInstructionSet::Scalar, SimdInstructionSet::SSE41, SimdInstructionSet::AVX2, SimdInstructionSet::NEON }) {
+        if (!rsk::IsSimdInstructionSetSupported(instructionSet)) {
+            continue;
+        }
+        for (RSKResamplingFilter filter : kFilters) {
+            TestImage result(14, 10);
+            Warp(rsk::GetWarpRowKernel(filter, instructionSet), source, CGAffineTransformMakeTranslation(3, 4), result);
+
+            for (size_t y = 0; y < result.Height(); y++) {
+                for (size_t x = 0; x < result.Width(); x++) {
+                    ASSERT_EQ(0, std::memcmp(result.Pixel(x, y), source.Pixel(x + 3, y + 4), 4))
+                        << rsk::SimdInstructionSetName(instructionSet) << ", " << filter << ", " << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+TEST(RSKWarpKernels, KeepsPixelsPremultiplied)
+{
+    TestImage source = MakeNoise(40, 40);
+
+    for (RSKResamplingFilter filter : kFilters) {
+        TestImage result(40, 40);
+        Warp(rsk::GetWarpRowKernel(filter, rsk::BestSimdInstructionSet()), source, MakeTransforms()[0], result);
+
+        for (size_t y = 0; y < result.Height(); y++) {
+            for (size_t x = 0; x < result.Width(); x++) {
+                const uint8_t *pixel = result.Pixel(x, y);
+                ASSERT_LE(std::max({ pixel[0], pixel[1], pixel[2] }), pixel[3]) << filter << ", " << x << ", " << y;
+            }
+        }
+    }
+}
+
+TEST(RSKWarpKernels, SamplesOutsideOfSourceAreTransparent)
+{
+    TestImage source = MakeNoise(8, 8);
+
+    for (RSKResamplingFilter filter : kFilters) {
+        TestImage result(4, 4);
+        Warp(rsk::GetWarpRowKernel(filter, rsk::BestSimdInstructionSet()), source, CGAffineTransformMakeTranslation(-20, 30), result);
+        EXPECT_EQ(CompareImages(result, TestImage(4, 4)).maximumAlphaDifference, 0) << filter;
+    }
+}
+
+TEST(RSKWarpKernels, FilterWeightsAreNormalized)
+{
+    for (float t : { 0.0f, 0.1f, 0.25f, 0.5f, 0.75f, 0.99f }) {
+        float bicubic[rsk::kBicubicTapCount];
+        rsk::BicubicWeights(t, bicubic);
+        float lanczos3[rsk::kLanczos3TapCount];
+        rsk::Lanczos3Weights(t, lanczos3);
+
+        float bicubicSum = 0;
+        for (float weight : bicubic) {
+            bicubicSum += weight;
+        }
+        float lanczos3Sum = 0;
+        for (float weight : lanczos3) {
+            lanczos3Sum += weight;
+        }
+        EXPECT_NEAR(bicubicSum, 1.0f, 1e-5f) << t;
+        EXPECT_NEAR(lanczos3Sum, 1.0f, 1e-5f) << t;
+    }
+
+    // Halfway between two pixels both filters are symmetric.
+    float lanczos3[rsk::kLanczos3TapCount];
+    rsk::Lanczos3Weights(0.5f, lanczos3);
+    EXPECT_NEAR(lanczos3[2], lanczos3[3], 1e-6f);
+    EXPECT_NEAR(lanczos3[1], lanczos3[4], 1e-6f);
+    EXPECT_NEAR(lanczos3[0], lanczos3[5], 1e-6f);
+}